@@ -0,0 +1,50 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+//! \ingroup sampleafvaudio
+
+#include "samplesreceivegraph.h"
+#include "blackcore/application.h"
+
+#include <stdlib.h>
+#include <QCoreApplication>
+#include <QString>
+#include <QTextStream>
+#include <QtGlobal>
+
+using namespace BlackSample;
+
+//! main
+int main(int argc, char *argv[])
+{
+    QCoreApplication qa(argc, argv);
+    BlackCore::CApplication a;
+    Q_UNUSED(a);
+    Q_UNUSED(qa);
+
+    QTextStream streamIn(stdin);
+    QTextStream streamOut(stdout);
+
+    bool run = true;
+    while (run)
+    {
+        streamOut << "Run samples:" << Qt::endl;
+        streamOut << "1 .. Receive graph (render time per block, xruns)" << Qt::endl;
+        streamOut << "2 .. Decoder pool (16 concurrent streams)" << Qt::endl;
+        streamOut << "x .. exit" << Qt::endl;
+        QString i = streamIn.readLine().toLower().trimmed();
+
+        if (i.startsWith("1")) { CSamplesReceiveGraph::samples(streamOut, streamIn); }
+        else if (i.startsWith("2")) { CSamplesReceiveGraph::decoderPool(streamOut, streamIn); }
+        else if (i.startsWith("x")) { run = false; streamOut << "terminating" << Qt::endl; }
+
+        streamOut << Qt::endl;
+    }
+    return EXIT_SUCCESS;
+}
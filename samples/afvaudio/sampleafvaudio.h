@@ -0,0 +1,21 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#ifndef BLACKSAMPLE_AFVAUDIO_H
+#define BLACKSAMPLE_AFVAUDIO_H
+
+// just a dummy header, documentation will go here
+
+/*!
+ * \defgroup sampleafvaudio Sample AFV audio
+ * \ingroup samples
+ * \brief Benchmarks of the AFV audio processing, without audio devices or network
+ *        - receive graph
+ */
+
+#endif
@@ -0,0 +1,23 @@
+load(common_pre)
+
+QT       += core dbus network multimedia
+
+TARGET = sampleafvaudio
+TEMPLATE = app
+
+CONFIG   += console
+CONFIG   -= app_bundle
+CONFIG   += blackconfig blackmisc blacksound blackcore
+
+DEPENDPATH += . $$SourceRoot/src
+INCLUDEPATH += . $$SourceRoot/src
+
+HEADERS += *.h
+SOURCES += *.cpp
+
+DESTDIR = $$DestRoot/bin
+
+target.path = $$PREFIX/bin
+INSTALLS += target
+
+load(common_post)
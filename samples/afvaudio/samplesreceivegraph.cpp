@@ -0,0 +1,291 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+//! \ingroup sampleafvaudio
+
+#include "samplesreceivegraph.h"
+#include "blackcore/afv/audio/soundcardsampleprovider.h"
+#include "blackcore/afv/dto.h"
+#include "blacksound/codecs/opusencoder.h"
+#include "blacksound/codecs/opusdecoderpool.h"
+#include "blacksound/sampleprovider/bufferedwaveprovider.h"
+#include "blacksound/dsp/dspkernels.h"
+
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <QVector>
+#include <QtMath>
+#include <algorithm>
+#include <memory>
+
+using namespace BlackCore::Afv;
+using namespace BlackCore::Afv::Audio;
+using namespace BlackSound::Codecs;
+using namespace BlackSound::Dsp;
+using namespace BlackSound::SampleProvider;
+
+namespace BlackSample
+{
+    namespace
+    {
+        constexpr int SampleRate = 48000;
+        constexpr int FrameSize  = 960; //!< 20ms, as sent by the AFV clients
+
+        //! One second of a voice like signal as OPUS packets, the fundamental frequency differs per callsign
+        QVector<QByteArray> syntheticTransmission(int callsignIndex)
+        {
+            COpusEncoder encoder(SampleRate, 1, OPUS_APPLICATION_VOIP);
+            encoder.setBitRate(16 * 1024);
+            QRandomGenerator random(static_cast<quint32>(callsignIndex + 1));
+
+            const double fundamental = 100.0 + 15.0 * callsignIndex;
+            QVector<QByteArray> packets;
+            QVector<qint16> frame(FrameSize);
+            int n = 0;
+            for (int p = 0; p < SampleRate / FrameSize; p++)
+            {
+                for (int i = 0; i < FrameSize; i++, n++)
+                {
+                    const double t = static_cast<double>(n) / SampleRate;
+                    const double envelope = 0.5 + 0.5 * qSin(2 * M_PI * 3.0 * t); // syllables
+                    double value = 0.0;
+                    for (int harmonic = 1; harmonic <= 5; harmonic++)
+                    {
+                        value += qSin(2 * M_PI * fundamental * harmonic * t) / harmonic;
+                    }
+                    value = envelope * 0.3 * value + 0.02 * (2.0 * random.generateDouble() - 1.0);
+                    frame[i] = static_cast<qint16>(qBound(-1.0, value, 1.0) * 32767);
+                }
+                int encodedLength = 0;
+                packets.push_back(encoder.encode(frame, frame.size(), &encodedLength));
+            }
+            return packets;
+        }
+
+        //! Print time statistics in microseconds
+        void printStatistics(QTextStream &streamOut, const QString &title, QVector<qint64> timesNs)
+        {
+            if (timesNs.isEmpty()) { return; }
+            std::sort(timesNs.begin(), timesNs.end());
+            const int n = timesNs.size();
+            qint64 sumNs = 0;
+            for (qint64 t : timesNs) { sumNs += t; }
+            streamOut << title << ": mean " << (sumNs / n / 1000) << "us, median " << (timesNs.at(n / 2) / 1000)
+                      << "us, 99% " << (timesNs.at(qMin(n - 1, n * 99 / 100)) / 1000) << "us, max " << (timesNs.back() / 1000) << "us" << Qt::endl;
+        }
+
+        //! Decode the streams packet by packet, as the decode stage does every 20ms, times per run of all streams
+        QVector<qint64> decodeStreams(COpusDecoderPool &pool, const QVector<QVector<QByteArray>> &transmissions, int seconds)
+        {
+            QAudioFormat format;
+            format.setSampleRate(SampleRate);
+            format.setChannelCount(1);
+            format.setSampleSize(16);
+            format.setSampleType(QAudioFormat::SignedInt);
+            format.setByteOrder(QAudioFormat::LittleEndian);
+            format.setCodec("audio/pcm");
+
+            const int streams = transmissions.size();
+            std::vector<std::unique_ptr<CBufferedWaveProvider>> buffers;
+            QVector<COpusDecoder *> decoders(streams, nullptr);
+            for (int s = 0; s < streams; s++) { buffers.emplace_back(new CBufferedWaveProvider(format)); }
+            QVector<float> played(FrameSize, 0.0f);
+
+            const int runs = seconds * SampleRate / FrameSize;
+            QVector<qint64> runTimesNs;
+            runTimesNs.reserve(runs);
+            QElapsedTimer timer;
+            for (int run = 0; run < runs; run++)
+            {
+                // a transmission starts and ends per stream, decoders are released and acquired again as in the callsign providers
+                for (int s = 0; s < streams; s++)
+                {
+                    const int packet = (run + s) % transmissions.at(s).size();
+                    if (packet == 0)
+                    {
+                        pool.release(decoders[s]);
+                        decoders[s] = pool.acquire();
+                    }
+                }
+
+                timer.start();
+                pool.run(streams, [&](int s)
+                {
+                    // directly into the ring buffer, as done by the jitter buffer for frames not stretched
+                    const QByteArray &audio = transmissions.at(s).at((run + s) % transmissions.at(s).size());
+                    CBufferedWaveProvider &buffer = *buffers[static_cast<size_t>(s)];
+                    int writable = 0;
+                    float *samples = buffer.writableSamples(writable);
+                    if (writable >= COpusDecoder::MaxFrameSamples)
+                    {
+                        buffer.commitSamples(decoders[s]->decode(audio, samples, writable));
+                    }
+                    else
+                    {
+                        float frame[COpusDecoder::MaxFrameSamples];
+                        buffer.addSamples(frame, decoders[s]->decode(audio, frame, COpusDecoder::MaxFrameSamples));
+                    }
+                });
+                runTimesNs.push_back(timer.nsecsElapsed());
+
+                // the soundcard reads what has been decoded
+                for (const auto &buffer : buffers) { buffer->readSamples(played.data(), FrameSize); }
+            }
+            for (COpusDecoder *decoder : qAsConst(decoders)) { pool.release(decoder); }
+            return runTimesNs;
+        }
+    }
+
+    void CSamplesReceiveGraph::samples(QTextStream &streamOut, QTextStream &streamIn)
+    {
+        streamOut << "Seconds to render (enter for 60): ";
+        streamOut.flush();
+        int seconds = streamIn.readLine().trimmed().toInt();
+        if (seconds < 1) { seconds = 60; }
+
+        streamOut << "Callsigns per transceiver (enter for 10): ";
+        streamOut.flush();
+        int callsigns = streamIn.readLine().trimmed().toInt();
+        if (callsigns < 1) { callsigns = 10; }
+
+        streamOut << "Block size in samples (enter for " << FrameSize << ", max. " << ISampleProvider::MaxBlockSize << "): ";
+        streamOut.flush();
+        int blockSize = streamIn.readLine().trimmed().toInt();
+        if (blockSize < 1 || blockSize > ISampleProvider::MaxBlockSize) { blockSize = FrameSize; }
+
+        // graph as used by the AFV client: 2 transceivers (COM1/COM2), each with its voice inputs
+        const QVector<quint16> transceiverIds({ 0, 1 });
+        const QVector<quint32> frequencies({ 122800000, 121500000 });
+        CSoundcardSampleProvider soundcard(SampleRate, transceiverIds, callsigns);
+        QVector<TransceiverDto> transceivers;
+        for (int t = 0; t < transceiverIds.size(); t++)
+        {
+            TransceiverDto transceiver;
+            transceiver.id = transceiverIds.at(t);
+            transceiver.frequencyHz = frequencies.at(t);
+            transceivers.push_back(transceiver);
+        }
+        soundcard.updateRadioTransceivers(transceivers);
+
+        streamOut << "Encoding transmissions of " << callsigns << " callsigns" << Qt::endl;
+        QVector<QVector<QByteArray>> transmissions;
+        for (int c = 0; c < callsigns; c++) { transmissions.push_back(syntheticTransmission(c)); }
+
+        // blocks are rendered between the packets, as the device reads them while packets arrive
+        const int totalSamples = seconds * SampleRate;
+        const qint64 blockBudgetNs = static_cast<qint64>(blockSize) * 1000000000 / SampleRate;
+        QVector<float> block(blockSize, 0.0f);
+        QVector<qint64> blockTimesNs;
+        QVector<qint64> packetTimesNs;
+        blockTimesNs.reserve(totalSamples / blockSize + 1);
+        packetTimesNs.reserve(totalSamples / FrameSize * callsigns * transceiverIds.size() + 1);
+
+        QElapsedTimer timer;
+        QElapsedTimer total;
+        total.start();
+        int xruns = 0;
+        uint sequence = 0;
+        int packetSamples = 0;
+        for (int rendered = 0; rendered < totalSamples; rendered += blockSize)
+        {
+            while (packetSamples <= rendered)
+            {
+                const int packet = (packetSamples / FrameSize) % transmissions.front().size();
+                for (int t = 0; t < transceiverIds.size(); t++)
+                {
+                    RxTransceiverDto rx;
+                    rx.id = transceiverIds.at(t);
+                    rx.frequency = frequencies.at(t);
+                    rx.distanceRatio = 0.5f;
+                    for (int c = 0; c < callsigns; c++)
+                    {
+                        IAudioDto dto;
+                        dto.callsign = QStringLiteral("CS%1-%2").arg(t).arg(c);
+                        dto.sequenceCounter = sequence;
+                        dto.audio = transmissions.at(c).at(packet);
+                        dto.lastPacket = false;
+
+                        timer.start();
+                        soundcard.addOpusSamples(dto, { rx });
+                        soundcard.decodePackets();
+                        packetTimesNs.push_back(timer.nsecsElapsed());
+                    }
+                }
+                sequence++;
+                packetSamples += FrameSize;
+            }
+
+            timer.start();
+            soundcard.readSamples(block.data(), blockSize);
+            const qint64 ns = timer.nsecsElapsed();
+            blockTimesNs.push_back(ns);
+            if (ns > blockBudgetNs) { xruns++; }
+        }
+        const qint64 totalMs = total.elapsed();
+
+        qint64 renderNs = 0;
+        for (qint64 ns : qAsConst(blockTimesNs)) { renderNs += ns; }
+        streamOut << Qt::endl;
+        streamOut << seconds << "s audio, " << transceiverIds.size() << " transceivers x " << callsigns << " callsigns, " << blockTimesNs.size() << " blocks of " << blockSize << " samples in " << totalMs << "ms" << Qt::endl;
+        printStatistics(streamOut, "render block ", blockTimesNs);
+        printStatistics(streamOut, "decode packet", packetTimesNs);
+        int underflows = 0;
+        int latePackets = 0;
+        int droppedPackets = 0;
+        int stretchedFrames = 0;
+        int latencyMs = 0;
+        const QVector<CallsignReceiveStatistics> callsignStatistics = soundcard.getCallsignStatistics();
+        for (const CallsignReceiveStatistics &statistics : callsignStatistics)
+        {
+            underflows += statistics.underflows;
+            latePackets += statistics.latePackets;
+            droppedPackets += statistics.droppedPackets;
+            stretchedFrames += statistics.stretchedFrames;
+            latencyMs = qMax(latencyMs, statistics.latencyMs);
+        }
+        streamOut << "callsign underflows: " << underflows << ", late packets: " << latePackets << ", dropped packets: " << droppedPackets
+                  << ", stretched frames: " << stretchedFrames << ", max. latency: " << latencyMs << "ms" << Qt::endl;
+        streamOut << "DSP kernels: " << CDspKernels::instructionSetToString(CDspKernels::instructionSet()) << Qt::endl;
+        streamOut << "block budget " << (blockBudgetNs / 1000) << "us, xruns: " << xruns << ", rendering load: "
+                  << QString::number(100.0 * renderNs / (static_cast<double>(seconds) * 1000000000), 'f', 2) << "% of real time" << Qt::endl;
+    }
+
+    void CSamplesReceiveGraph::decoderPool(QTextStream &streamOut, QTextStream &streamIn)
+    {
+        streamOut << "Seconds to decode (enter for 60): ";
+        streamOut.flush();
+        int seconds = streamIn.readLine().trimmed().toInt();
+        if (seconds < 1) { seconds = 60; }
+
+        constexpr int Streams = 16;
+        streamOut << "Encoding transmissions of " << Streams << " streams" << Qt::endl;
+        QVector<QVector<QByteArray>> transmissions;
+        for (int s = 0; s < Streams; s++) { transmissions.push_back(syntheticTransmission(s)); }
+
+        const qint64 budgetNs = static_cast<qint64>(FrameSize) * 1000000000 / SampleRate;
+        COpusDecoderPool sequential(SampleRate, 1, 0);
+        COpusDecoderPool parallel(SampleRate, 1);
+        for (COpusDecoderPool *pool : { &sequential, &parallel })
+        {
+            QElapsedTimer total;
+            total.start();
+            const QVector<qint64> runTimesNs = decodeStreams(*pool, transmissions, seconds);
+            const qint64 totalMs = total.elapsed();
+
+            qint64 decodeNs = 0;
+            for (qint64 ns : runTimesNs) { decodeNs += ns; }
+            streamOut << Qt::endl;
+            streamOut << seconds << "s audio, " << Streams << " streams, " << pool->getWorkerThreadCount() << " worker threads, in " << totalMs << "ms" << Qt::endl;
+            printStatistics(streamOut, "decode 20ms of all streams", runTimesNs);
+            streamOut << "decoders created: " << pool->getDecoderCount() << ", decoding load: "
+                      << QString::number(100.0 * decodeNs / (runTimesNs.size() * static_cast<double>(budgetNs)), 'f', 2) << "% of real time" << Qt::endl;
+        }
+    }
+} // namespace
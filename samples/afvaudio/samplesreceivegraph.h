@@ -0,0 +1,35 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+//! \ingroup sampleafvaudio
+
+#ifndef BLACKSAMPLE_SAMPLESRECEIVEGRAPH_H
+#define BLACKSAMPLE_SAMPLESRECEIVEGRAPH_H
+
+class QTextStream;
+
+namespace BlackSample
+{
+    //! Benchmark of the AFV receive graph
+    //! \details Renders synthetic OPUS encoded transmissions through the sample providers of the AFV client as fast as
+    //!          possible, block by block like the audio device would read them. Reports the processing time per block and
+    //!          the blocks which took longer than their duration (xruns with a real device).
+    //!          The decoder pool benchmark decodes concurrent streams sequentially and on the worker threads.
+    class CSamplesReceiveGraph
+    {
+    public:
+        //! Run the benchmark
+        static void samples(QTextStream &streamOut, QTextStream &streamIn);
+
+        //! Decode 16 concurrent streams with the decoder pool
+        static void decoderPool(QTextStream &streamOut, QTextStream &streamIn);
+    };
+} // namespace
+
+#endif
@@ -13,6 +13,9 @@
 #include "blackcore/db/databasereader.h"
 #include "blackmisc/simulation/aircraftmodellist.h"
 #include "blackmisc/simulation/distributorlist.h"
+#include "blackmisc/simulation/interpolationbatch.h"
+#include "blackmisc/simulation/interpolatormulti.h"
+#include "blackmisc/simulation/remoteaircraftproviderdummy.h"
 #include "blackmisc/aviation/aircrafticaocodelist.h"
 #include "blackmisc/aviation/aircraftsituation.h"
 #include "blackmisc/aviation/aircraftsituationlist.h"
@@ -20,9 +23,12 @@
 #include "blackmisc/aviation/atcstation.h"
 #include "blackmisc/aviation/atcstationlist.h"
 #include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/heading.h"
 #include "blackmisc/aviation/liverylist.h"
 #include "blackmisc/geo/coordinategeodetic.h"
 #include "blackmisc/math/mathutils.h"
+#include "blackmisc/pq/angle.h"
+#include "blackmisc/pq/speed.h"
 #include "blackmisc/pq/units.h"
 #include "blackmisc/test/testing.h"
 #include "blackmisc/swiftdirectories.h"
@@ -35,15 +41,19 @@
 #include <QRegExp>
 #include <QRegularExpression>
 #include <QRegularExpressionMatch>
+#include <QSharedPointer>
 #include <QString>
 #include <QStringList>
 #include <QStringBuilder>
 #include <QTextStream>
 #include <QElapsedTimer>
+#include <QThread>
 #include <QVector>
 #include <Qt>
 #include <algorithm>
+#include <atomic>
 #include <iterator>
+#include <thread>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Aviation;
@@ -668,6 +678,180 @@ namespace BlackSample
         return EXIT_SUCCESS;
     }
 
+    int CSamplesPerformance::remoteAircraftProviderContention(QTextStream &out, int numberOfAircraft, int seconds)
+    {
+        // one writer thread storing situations/parts as the FSD client does, one reader at 60Hz reading like the interpolators
+        CRemoteAircraftProviderDummy provider;
+        const QList<CCallsign> aircraftCallsigns = callsigns(numberOfAircraft).toQList();
+        for (const CCallsign &cs : aircraftCallsigns)
+        {
+            CSimulatedAircraft aircraft;
+            aircraft.setCallsign(cs);
+            provider.addNewAircraftInRange(aircraft);
+        }
+        provider.publishRemoteAircraftSnapshot();
+
+        constexpr int BatchMs = 20;     // FSD lines are parsed in batches
+        constexpr int FrameMs = 16;     // ~60Hz
+        const int writesPerBatch = qMax(1, numberOfAircraft * BatchMs / 1000); // 1 situation per aircraft and second
+
+        for (int mode = 0; mode < 2; mode++)
+        {
+            const bool useSnapshot = (mode == 1);
+            std::atomic_bool stop { false };
+            std::atomic<qint64> writes { 0 };
+            std::thread writer([&]
+            {
+                int next = 0;
+                while (!stop)
+                {
+                    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+                    for (int w = 0; w < writesPerBatch; w++)
+                    {
+                        const CCallsign &cs = aircraftCallsigns.at(next++ % aircraftCallsigns.size());
+                        CAircraftSituation situation(cs, CCoordinateGeodetic(48.0 + (next % 100) * 0.001, 11.0, 5000.0));
+                        situation.setMSecsSinceEpoch(now);
+                        provider.storeAircraftSituation(situation, false);
+                        provider.storeAircraftParts(cs, CAircraftParts(), false);
+                        writes++;
+                    }
+                    provider.publishRemoteAircraftSnapshot(); // end of batch
+                    QThread::msleep(BatchMs);
+                }
+            });
+
+            qint64 frames = 0;
+            qint64 sumFrameNs = 0;
+            qint64 maxFrameNs = 0;
+            QElapsedTimer total;
+            total.start();
+            while (total.elapsed() < seconds * 1000)
+            {
+                QElapsedTimer frame;
+                frame.start();
+                int inRange = 0;
+                if (useSnapshot)
+                {
+                    const CRemoteAircraftSnapshotPtr snapshot = provider.getRemoteAircraftSnapshot();
+                    for (const CCallsign &cs : aircraftCallsigns)
+                    {
+                        if (snapshot->situationsLastModified(cs) < 0) { continue; }
+                        if (snapshot->remoteAircraftParts(cs).isEmpty()) { continue; }
+                        if (snapshot->isAircraftInRange(cs)) { inRange++; }
+                    }
+                }
+                else
+                {
+                    for (const CCallsign &cs : aircraftCallsigns)
+                    {
+                        if (provider.situationsLastModified(cs) < 0) { continue; }
+                        if (provider.remoteAircraftParts(cs).isEmpty()) { continue; }
+                        if (provider.isAircraftInRange(cs)) { inRange++; }
+                    }
+                }
+                Q_UNUSED(inRange);
+                const qint64 ns = frame.nsecsElapsed();
+                sumFrameNs += ns;
+                maxFrameNs = qMax(maxFrameNs, ns);
+                frames++;
+                const qint64 restMs = FrameMs - frame.elapsed();
+                if (restMs > 0) { QThread::msleep(static_cast<unsigned long>(restMs)); }
+            }
+            stop = true;
+            writer.join();
+
+            out << (useSnapshot ? "Snapshot reads: " : "Locked reads:   ") << numberOfAircraft << " aircraft, "
+                << frames << " frames, avg " << (sumFrameNs / qMax<qint64>(1, frames) / 1000) << "us/frame, max "
+                << (maxFrameNs / 1000) << "us/frame, " << writes << " writes" << Qt::endl;
+        }
+
+        out << Qt::endl;
+        return EXIT_SUCCESS;
+    }
+
+    int CSamplesPerformance::interpolationBatch(QTextStream &out, int numberOfAircraft, int frames)
+    {
+        // situations every 5secs, interpolated at ~60Hz as the simulator drivers do
+        CRemoteAircraftProviderDummy provider;
+        const QVector<CCallsign> aircraftCallsigns = callsigns(numberOfAircraft).toQList().toVector();
+        const qint64 baseTime = QDateTime::currentMSecsSinceEpoch();
+        constexpr qint64 OffsetMs = 6000;
+        constexpr int FrameMs = 16;
+        for (int a = 0; a < aircraftCallsigns.size(); a++)
+        {
+            const CCallsign &cs = aircraftCallsigns[a];
+            CSimulatedAircraft aircraft;
+            aircraft.setCallsign(cs);
+            provider.addNewAircraftInRange(aircraft);
+            for (int t = 0; t < IRemoteAircraftProvider::MaxSituationsPerCallsign; t++)
+            {
+                const CCoordinateGeodetic position(48.0 + a * 0.001 + t * 0.01, 11.0 + t * 0.01, 5000.0 + t * 100.0);
+                CAircraftSituation situation(cs, position, CHeading(90.0, CHeading::True, CAngleUnit::deg()),
+                                             CAngle(2.0, CAngleUnit::deg()), CAngle(0.0, CAngleUnit::deg()), CSpeed(250.0, CSpeedUnit::kts()));
+                situation.setMSecsSinceEpoch(baseTime + t * 5000);
+                situation.setTimeOffsetMs(OffsetMs);
+                provider.insertNewSituation(situation);
+            }
+        }
+
+        QVector<QSharedPointer<CInterpolatorMulti>> interpolators;
+        QVector<QSharedPointer<CInterpolatorMulti>> batchInterpolators;
+        QVector<CInterpolationAndRenderingSetupPerCallsign> setups;
+        const CInterpolationAndRenderingSetupGlobal globalSetup;
+        for (const CCallsign &cs : aircraftCallsigns)
+        {
+            interpolators.push_back(QSharedPointer<CInterpolatorMulti>::create(cs, nullptr, nullptr, &provider));
+            batchInterpolators.push_back(QSharedPointer<CInterpolatorMulti>::create(cs, nullptr, nullptr, &provider));
+            setups.push_back(CInterpolationAndRenderingSetupPerCallsign(cs, globalSetup));
+        }
+
+        const qint64 startTime = baseTime + OffsetMs + 5000;
+        QElapsedTimer timer;
+
+        // per aircraft loop, full result
+        int validLoop = 0;
+        qint64 maxLoopNs = 0;
+        timer.start();
+        for (int f = 0; f < frames; f++)
+        {
+            QElapsedTimer frame;
+            frame.start();
+            const qint64 currentTime = startTime + f * FrameMs;
+            for (int a = 0; a < aircraftCallsigns.size(); a++)
+            {
+                const CInterpolationResult result = interpolators[a]->getInterpolation(currentTime, setups[a], a);
+                if (result.getInterpolationStatus().hasValidSituation()) { validLoop++; }
+            }
+            maxLoopNs = qMax(maxLoopNs, frame.nsecsElapsed());
+        }
+        const qint64 loopNs = timer.nsecsElapsed();
+
+        // batch as in the simulator drivers, results re-used for all frames
+        int validBatch = 0;
+        qint64 maxBatchNs = 0;
+        CInterpolationBatch batch;
+        QVector<CCompactInterpolationResult> results;
+        timer.start();
+        for (int f = 0; f < frames; f++)
+        {
+            QElapsedTimer frame;
+            frame.start();
+            const qint64 currentTime = startTime + f * FrameMs;
+            batch.clear();
+            for (int a = 0; a < aircraftCallsigns.size(); a++) { batch.add(batchInterpolators[a].data(), setups[a]); }
+            validBatch += batch.interpolate(currentTime, provider.getRemoteAircraftSnapshot(), results);
+            maxBatchNs = qMax(maxBatchNs, frame.nsecsElapsed());
+        }
+        const qint64 batchNs = timer.nsecsElapsed();
+
+        out << "Per aircraft: " << numberOfAircraft << " aircraft, " << frames << " frames, avg " << (loopNs / frames / 1000) << "us/frame, max "
+            << (maxLoopNs / 1000) << "us/frame, " << validLoop << " valid" << Qt::endl;
+        out << "Batch:        " << numberOfAircraft << " aircraft, " << frames << " frames, avg " << (batchNs / frames / 1000) << "us/frame, max "
+            << (maxBatchNs / 1000) << "us/frame, " << validBatch << " valid" << Qt::endl;
+        out << "Ratio: " << (static_cast<double>(loopNs) / qMax<qint64>(1, batchNs)) << Qt::endl << Qt::endl;
+        return EXIT_SUCCESS;
+    }
+
     CAircraftSituationList CSamplesPerformance::createSituations(qint64 baseTimeEpoch, int numberOfCallsigns, int numberOfTimes)
     {
         CAircraftSituationList situations;
@@ -53,6 +53,12 @@ namespace BlackSample
         //! Callsign based hash/map comparison
         static int sampleQMapVsQHashByCallsign(QTextStream &out);
 
+        //! Remote aircraft provider, 60Hz reader while a writer stores situations (locks vs. snapshot)
+        static int remoteAircraftProviderContention(QTextStream &out, int numberOfAircraft, int seconds);
+
+        //! Interpolation of many aircraft, per aircraft loop vs. batch
+        static int interpolationBatch(QTextStream &out, int numberOfAircraft, int frames);
+
     private:
         static const qint64 DeltaTime = 10;
 
@@ -13,7 +13,11 @@
 #include "samplesfsx.h"
 #include "samplesp3d.h"
 #include "samplesfsuipc.h"
+#include "samplesinterpolationrecorder.h"
+#include "samplesmatchingreplay.h"
+#include "samplesmodelcache.h"
 #include "samplesmodelmapping.h"
+#include "samplesmodelmemory.h"
 #include "samplesvpilotrules.h"
 #include "blackcore/application.h"
 #include "blackmisc/directoryutils.h"
@@ -51,16 +55,24 @@ int main(int argc, char *argv[])
         streamOut << "4 .. vPilot rules"  << Qt::endl;
         streamOut << "5 .. P3D cfg files" << Qt::endl;
         streamOut << "6 .. FSUIPC read"   << Qt::endl;
+        streamOut << "7 .. Interpolation recorder dump to log files" << Qt::endl;
+        streamOut << "8 .. Matching replay (time to first render)" << Qt::endl;
+        streamOut << "9 .. Model cache load (JSON vs binary)" << Qt::endl;
+        streamOut << "10 .. Model set memory (plain vs interned)" << Qt::endl;
         streamOut << "x .. exit" << Qt::endl;
         QString i = streamIn.readLine().toLower().trimmed();
 
         t.start();
-        if (i.startsWith("1")) { CSamplesFsCommon::samples(streamOut, streamIn); }
+        if (i.startsWith("10")) { CSamplesModelMemory::samples(streamOut, streamIn); }
+        else if (i.startsWith("1")) { CSamplesFsCommon::samples(streamOut, streamIn); }
         else if (i.startsWith("2")) { CSamplesFsx::samplesMisc(streamOut); }
         else if (i.startsWith("3")) { CSamplesModelMapping::samples(streamOut, streamIn); }
         else if (i.startsWith("4")) { CSamplesVPilotRules::samples(streamOut, streamIn); }
         else if (i.startsWith("5")) { CSamplesP3D::samplesMisc(streamOut); }
         else if (i.startsWith("6")) { CSamplesFsuipc::samplesFsuipc(streamOut); }
+        else if (i.startsWith("7")) { CSamplesInterpolationRecorder::samples(streamOut, streamIn); }
+        else if (i.startsWith("8")) { CSamplesMatchingReplay::samples(streamOut, streamIn); }
+        else if (i.startsWith("9")) { CSamplesModelCache::samples(streamOut, streamIn); }
         else if (i.startsWith("x")) { run = false; streamOut << "terminating" << Qt::endl; }
 
         streamOut << Qt::endl;
@@ -0,0 +1,47 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+//! \ingroup sampleblackmiscsim
+
+#include "samplesinterpolationrecorder.h"
+#include "blackmisc/simulation/interpolationlogger.h"
+#include "blackmisc/statusmessagelist.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QTextStream>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Simulation;
+
+namespace BlackSample
+{
+    void CSamplesInterpolationRecorder::samples(QTextStream &streamOut, QTextStream &streamIn)
+    {
+        // default is the latest dump in the log directory
+        const QDir logDir(CInterpolationLogger::getLogDirectory());
+        const QStringList dumps = logDir.entryList({ CInterpolationLogger::filePatternRecorderDump() }, QDir::Files, QDir::Time);
+        const QString latest = dumps.isEmpty() ? QString() : logDir.absoluteFilePath(dumps.first());
+
+        streamOut << "Recorder dump file (enter for '" << latest << "'): ";
+        streamOut.flush();
+        QString file = streamIn.readLine().trimmed();
+        if (file.isEmpty()) { file = latest; }
+        if (file.isEmpty() || !QFileInfo::exists(file))
+        {
+            streamOut << "No dump file" << Qt::endl;
+            return;
+        }
+
+        const CStatusMessageList msgs = CInterpolationLogger::convertRecorderDump(file);
+        for (const CStatusMessage &msg : msgs)
+        {
+            streamOut << msg.getMessage() << Qt::endl;
+        }
+    }
+} // namespace
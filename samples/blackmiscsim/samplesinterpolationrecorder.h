@@ -0,0 +1,28 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+//! \ingroup sampleblackmiscsim
+
+#ifndef BLACKSAMPLE_SAMPLESINTERPOLATIONRECORDER_H
+#define BLACKSAMPLE_SAMPLESINTERPOLATIONRECORDER_H
+
+class QTextStream;
+
+namespace BlackSample
+{
+    //! Converts interpolation recorder dumps into the interpolation log files
+    class CSamplesInterpolationRecorder
+    {
+    public:
+        //! Run the converter
+        static void samples(QTextStream &streamOut, QTextStream &streamIn);
+    };
+} // namespace
+
+#endif
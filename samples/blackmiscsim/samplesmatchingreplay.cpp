@@ -0,0 +1,172 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+//! \ingroup sampleblackmiscsim
+
+#include "samplesmatchingreplay.h"
+#include "blackcore/aircraftmatcher.h"
+#include "blackcore/aircraftmatchingservice.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/simulatedaircraftlist.h"
+#include "blackmisc/simulation/simulatorinfo.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/airlineicaocode.h"
+#include "blackmisc/aviation/livery.h"
+#include "blackmisc/fileutils.h"
+#include "blackmisc/json.h"
+#include "blackmisc/jsonexception.h"
+
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFileInfo>
+#include <QHash>
+#include <QTextStream>
+#include <QTimer>
+#include <algorithm>
+#include <limits>
+
+using namespace BlackCore;
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation;
+
+namespace BlackSample
+{
+    namespace
+    {
+        //! Read a JSON file
+        template <class List>
+        List readJsonFile(const QString &file, QTextStream &streamOut)
+        {
+            List list;
+            if (file.isEmpty() || !QFileInfo::exists(file)) { return list; }
+            try
+            {
+                list.convertFromJson(Json::jsonObjectFromString(CFileUtils::readFileToString(file)));
+            }
+            catch (const CJsonException &ex)
+            {
+                streamOut << ex.toString("JSON") << Qt::endl;
+            }
+            return list;
+        }
+
+        //! Synthetic models and aircraft if nothing was recorded
+        CAircraftModel syntheticModel(int i)
+        {
+            static const QStringList designators({ "A319", "A320", "A321", "B737", "B738", "B744", "C172", "CRJ9", "E190", "DH8D" });
+            static const QStringList combinedTypes({ "L2J", "L2J", "L2J", "L2J", "L2J", "L4J", "L1P", "L2J", "L2J", "L2T" });
+            static const QStringList airlines({ "DLH", "BAW", "AFR", "KLM", "UAL", "DAL", "EZY", "RYR" });
+            const QString &designator = designators.at(i % designators.size());
+            const QString &airline = airlines.at((i / designators.size()) % airlines.size());
+            const CAircraftIcaoCode icao(designator, combinedTypes.at(i % designators.size()));
+            const CLivery livery(airline + ".STD", CAirlineIcaoCode(airline), "");
+            return CAircraftModel(QStringLiteral("%1 %2 %3").arg(airline, designator).arg(i), CAircraftModel::TypeOwnSimulatorModel, icao, livery);
+        }
+    }
+
+    void CSamplesMatchingReplay::samples(QTextStream &streamOut, QTextStream &streamIn)
+    {
+        streamOut << "Model set JSON file (enter for 5000 synthetic models): ";
+        streamOut.flush();
+        CAircraftModelList modelSet = readJsonFile<CAircraftModelList>(streamIn.readLine().trimmed(), streamOut);
+        if (modelSet.isEmpty())
+        {
+            for (int i = 0; i < 5000; i++) { modelSet.push_back(syntheticModel(i)); }
+        }
+
+        streamOut << "Recorded aircraft JSON file (enter for a burst of 300 synthetic aircraft): ";
+        streamOut.flush();
+        CSimulatedAircraftList aircraft = readJsonFile<CSimulatedAircraftList>(streamIn.readLine().trimmed(), streamOut);
+        if (aircraft.isEmpty())
+        {
+            for (int i = 0; i < 300; i++)
+            {
+                CAircraftModel model = syntheticModel(i * 7 + 3);
+                model.setModelString({}); // like from network, no exact model string match
+                CSimulatedAircraft a(model);
+                a.setCallsign(CCallsign(QStringLiteral("SIM%1").arg(i)));
+                aircraft.push_back(a);
+            }
+        }
+
+        // arrival times as recorded by the situation timestamps, relative to the first aircraft
+        qint64 first = std::numeric_limits<qint64>::max();
+        for (const CSimulatedAircraft &a : aircraft)
+        {
+            if (a.getSituation().getMSecsSinceEpoch() > 0) { first = qMin(first, a.getSituation().getMSecsSinceEpoch()); }
+        }
+        QHash<QString, qint64> arrivalMs; // by callsign
+        for (const CSimulatedAircraft &a : aircraft)
+        {
+            const qint64 ts = a.getSituation().getMSecsSinceEpoch();
+            arrivalMs.insert(a.getCallsignAsString(), ts > 0 ? ts - first : 0);
+        }
+
+        CAircraftMatcher matcher;
+        matcher.setModelSet(modelSet, CSimulatorInfo::FSX, true);
+        streamOut << "Replaying " << aircraft.size() << " aircraft with " << modelSet.size() << " models" << Qt::endl;
+
+        // synchronous: each aircraft is matched on arrival, one after the other
+        QVector<qint64> syncTimes;
+        {
+            QVector<CSimulatedAircraft> ordered;
+            for (const CSimulatedAircraft &a : aircraft) { ordered.push_back(a); }
+            std::stable_sort(ordered.begin(), ordered.end(), [&](const CSimulatedAircraft & a, const CSimulatedAircraft & b) { return arrivalMs.value(a.getCallsignAsString()) < arrivalMs.value(b.getCallsignAsString()); });
+            QElapsedTimer timer;
+            timer.start();
+            qint64 busyUntil = 0;
+            for (const CSimulatedAircraft &a : ordered)
+            {
+                const qint64 arrival = arrivalMs.value(a.getCallsignAsString());
+                timer.restart();
+                matcher.getClosestMatch(a, MatchingLogNothing, nullptr, true);
+                busyUntil = qMax(busyUntil, arrival) + timer.elapsed();
+                syncTimes.push_back(busyUntil - arrival);
+            }
+        }
+
+        // matching service
+        QVector<qint64> serviceTimes;
+        CAircraftMatchingService service(&matcher);
+        QEventLoop loop;
+        QElapsedTimer clock;
+        int pending = aircraft.size();
+        QObject::connect(&service, &CAircraftMatchingService::aircraftMatched, &loop, [&](const CSimulatedAircraft & a, const CAircraftModel & model, const CStatusMessageList &, qint64)
+        {
+            const qint64 ttfr = clock.elapsed() - arrivalMs.value(a.getCallsignAsString());
+            serviceTimes.push_back(ttfr);
+            streamOut << a.getCallsignAsString() << ": " << model.getModelString() << " " << ttfr << "ms" << Qt::endl;
+            if (--pending < 1) { loop.quit(); }
+        });
+
+        clock.start();
+        for (const CSimulatedAircraft &a : aircraft)
+        {
+            QTimer::singleShot(static_cast<int>(arrivalMs.value(a.getCallsignAsString())), &service, [ =, &service ]
+            {
+                service.enqueue(a, MatchingLogNothing, true);
+            });
+        }
+        if (pending > 0) { loop.exec(); }
+        service.gracefulShutdown();
+
+        streamOut << Qt::endl << "Time to first render" << Qt::endl;
+        printStatistics(streamOut, "synchronous", syncTimes);
+        printStatistics(streamOut, "service    ", serviceTimes);
+    }
+
+    void CSamplesMatchingReplay::printStatistics(QTextStream &streamOut, const QString &title, QVector<qint64> timesMs)
+    {
+        if (timesMs.isEmpty()) { return; }
+        std::sort(timesMs.begin(), timesMs.end());
+        const int n = timesMs.size();
+        streamOut << title << ": min " << timesMs.front() << "ms, median " << timesMs.at(n / 2) << "ms, 95% " << timesMs.at(qMin(n - 1, n * 95 / 100)) << "ms, max " << timesMs.back() << "ms" << Qt::endl;
+    }
+} // namespace
@@ -0,0 +1,38 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+//! \ingroup sampleblackmiscsim
+
+#ifndef BLACKSAMPLE_SAMPLESMATCHINGREPLAY_H
+#define BLACKSAMPLE_SAMPLESMATCHINGREPLAY_H
+
+#include <QString>
+#include <QtGlobal>
+#include <QVector>
+
+class QTextStream;
+
+namespace BlackSample
+{
+    //! Replays recorded remote aircraft arrivals through the matching service
+    //! \details Reports the time from arrival until the matched model is available ("time to first render")
+    //!          per aircraft, compared with matching each aircraft synchronously on arrival.
+    class CSamplesMatchingReplay
+    {
+    public:
+        //! Run the replay
+        static void samples(QTextStream &streamOut, QTextStream &streamIn);
+
+    private:
+        //! Min, median, 95th percentile and max
+        static void printStatistics(QTextStream &streamOut, const QString &title, QVector<qint64> timesMs);
+    };
+} // namespace
+
+#endif
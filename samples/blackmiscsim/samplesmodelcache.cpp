@@ -0,0 +1,103 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+//! \ingroup sampleblackmiscsim
+
+#include "samplesmodelcache.h"
+#include "sampleutils.h"
+#include "blackmisc/simulation/data/modelbinarycache.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/fileutils.h"
+#include "blackmisc/json.h"
+#include "blackmisc/stringutils.h"
+#include "blackmisc/jsonexception.h"
+#include "blackmisc/variant.h"
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <algorithm>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Simulation;
+using namespace BlackMisc::Simulation::Data;
+
+namespace BlackSample
+{
+    void CSamplesModelCache::samples(QTextStream &streamOut, QTextStream &streamIn)
+    {
+        streamOut << "Model set JSON file (enter for 30000 synthetic models): ";
+        streamOut.flush();
+        const QString file = streamIn.readLine().trimmed();
+        CAircraftModelList models;
+        if (!file.isEmpty() && QFileInfo::exists(file))
+        {
+            try
+            {
+                models.convertFromJson(Json::jsonObjectFromString(CFileUtils::readFileToString(file)));
+            }
+            catch (const CJsonException &ex)
+            {
+                streamOut << ex.toString("JSON") << Qt::endl;
+            }
+        }
+        if (models.isEmpty()) { models = CSampleUtils::syntheticModels(30000); }
+
+        QTemporaryDir dir;
+        if (!dir.isValid()) { streamOut << "No temporary directory" << Qt::endl; return; }
+        const QString jsonFile = dir.filePath("modelcache.json");
+        const QString binaryFile = CModelBinaryCache::binaryFileName(jsonFile);
+        const qint64 ts = QDateTime::currentMSecsSinceEpoch();
+
+        // JSON as written by the data cache
+        QElapsedTimer timer;
+        timer.start();
+        CFileUtils::writeByteArrayToFile(QJsonDocument(CVariant::from(models).toMemoizedJson()).toJson(), jsonFile);
+        const qint64 jsonWriteMs = timer.elapsed();
+
+        timer.restart();
+        CModelBinaryCache::write(models, ts, binaryFile);
+        const qint64 binaryWriteMs = timer.elapsed();
+
+        streamOut << models.size() << " models" << Qt::endl;
+        streamOut << "JSON:   " << QFileInfo(jsonFile).size() << " bytes, written in " << jsonWriteMs << "ms" << Qt::endl;
+        streamOut << "binary: " << QFileInfo(binaryFile).size() << " bytes, written in " << binaryWriteMs << "ms" << Qt::endl;
+
+        // JSON load as in the data cache: read, parse, convert
+        timer.restart();
+        QFile json(jsonFile);
+        json.open(QFile::ReadOnly | QFile::Text);
+        const QJsonDocument doc = QJsonDocument::fromJson(json.readAll());
+        const qint64 parseMs = timer.elapsed();
+        CVariant variant;
+        variant.convertFromMemoizedJson(doc.object(), false);
+        const CAircraftModelList jsonModels = variant.value<CAircraftModelList>();
+        const qint64 jsonLoadMs = timer.elapsed();
+        streamOut << "JSON load:   " << jsonLoadMs << "ms (parsing " << parseMs << "ms), " << jsonModels.size() << " models" << Qt::endl;
+
+        // binary: mapping is what happens at startup, the models are created on first use
+        timer.restart();
+        CModelBinaryCache binary;
+        const bool opened = binary.open(binaryFile);
+        const qint64 openMs = timer.elapsed();
+        int stringLength = 0;
+        for (int i = 0; i < binary.size(); i++) { stringLength += binary.getModelString(i).length(); }
+        const qint64 stringsMs = timer.elapsed() - openMs;
+        const CAircraftModelList binaryModels = binary.toList();
+        const qint64 binaryLoadMs = timer.elapsed();
+        streamOut << "binary load: " << binaryLoadMs << "ms (open " << openMs << "ms, all model strings " << stringsMs << "ms), " << binaryModels.size() << " models" << (opened ? "" : " FAILED") << Qt::endl;
+
+        const bool equal = jsonModels.size() == binaryModels.size() && std::equal(jsonModels.begin(), jsonModels.end(), binaryModels.begin());
+        streamOut << "Same models: " << boolToYesNo(equal) << " (" << stringLength << " model string characters)" << Qt::endl;
+    }
+} // namespace
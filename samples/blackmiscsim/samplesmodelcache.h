@@ -0,0 +1,30 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+//! \ingroup sampleblackmiscsim
+
+#ifndef BLACKSAMPLE_SAMPLESMODELCACHE_H
+#define BLACKSAMPLE_SAMPLESMODELCACHE_H
+
+class QTextStream;
+
+namespace BlackSample
+{
+    //! Startup benchmark of the model cache formats
+    //! \details Loads the same models from the JSON format of the data cache and from the binary model cache,
+    //!          reporting file size and load times.
+    class CSamplesModelCache
+    {
+    public:
+        //! Run the benchmark
+        static void samples(QTextStream &streamOut, QTextStream &streamIn);
+    };
+} // namespace
+
+#endif
@@ -0,0 +1,151 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+//! \ingroup sampleblackmiscsim
+
+#include "samplesmodelmemory.h"
+#include "sampleutils.h"
+#include "blackmisc/simulation/aircraftmodelinterner.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/fileutils.h"
+#include "blackmisc/json.h"
+#include "blackmisc/jsonexception.h"
+#include "blackmisc/processinfo.h"
+#include "blackmisc/stringutils.h"
+
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QSet>
+#include <QTextStream>
+#include <algorithm>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Simulation;
+
+namespace BlackSample
+{
+    namespace
+    {
+        //! Bytes of the string data, data shared with a string already counted is not counted again
+        class CStringBytes
+        {
+        public:
+            //! Count the strings of the models
+            void add(const CAircraftModelList &models)
+            {
+                for (const CAircraftModel &model : models)
+                {
+                    this->add(model.getModelString());
+                    this->add(model.getDescription());
+                    this->add(model.getName());
+                    this->add(model.getFileName());
+                    this->add(model.getIconFile());
+                    this->add(model.getAircraftIcaoCode().getDesignator());
+                    this->add(model.getAircraftIcaoCode().getManufacturer());
+                    this->add(model.getAircraftIcaoCode().getModelDescription());
+                    this->add(model.getAircraftIcaoCode().getCombinedType());
+                    this->add(model.getLivery().getCombinedCode());
+                    this->add(model.getLivery().getDescription());
+                    this->add(model.getAirlineIcaoCode().getDesignator());
+                    this->add(model.getAirlineIcaoCode().getName());
+                    this->add(model.getAirlineIcaoCode().getTelephonyDesignator());
+                    this->add(model.getDistributor().getDbKey());
+                    this->add(model.getDistributor().getDescription());
+                }
+            }
+
+            //! Bytes counted
+            qint64 bytes() const { return m_bytes; }
+
+        private:
+            void add(const QString &string)
+            {
+                if (string.isEmpty() || m_data.contains(string.constData())) { return; }
+                m_data.insert(string.constData());
+                m_bytes += string.capacity() * static_cast<qint64>(sizeof(QChar));
+            }
+
+            QSet<const QChar *> m_data;
+            qint64 m_bytes = 0;
+        };
+
+        //! Resident memory in kB
+        qint64 residentKb()
+        {
+            const qint64 rss = CProcessInfo::currentProcessResidentMemory();
+            return rss < 0 ? -1 : rss / 1024;
+        }
+    }
+
+    void CSamplesModelMemory::samples(QTextStream &streamOut, QTextStream &streamIn)
+    {
+        streamOut << "Model set JSON file (enter for 30000 synthetic models): ";
+        streamOut.flush();
+        const QString file = streamIn.readLine().trimmed();
+        QJsonObject json;
+        if (!file.isEmpty() && QFileInfo::exists(file))
+        {
+            json = Json::jsonObjectFromString(CFileUtils::readFileToString(file));
+        }
+        if (json.isEmpty()) { json = CSampleUtils::syntheticModels(30000).toJson(); }
+
+        // each model is converted separately, as the models are received from the cache or DBus
+        const QJsonArray array = json.value("containerbase").toArray();
+        streamOut << array.size() << " models" << Qt::endl;
+
+        try
+        {
+            QElapsedTimer timer;
+            const qint64 rss0 = residentKb();
+
+            timer.start();
+            CAircraftModelList models;
+            for (const QJsonValue &value : array)
+            {
+                CAircraftModel model;
+                model.convertFromJson(value.toObject());
+                models.push_back(model);
+            }
+            const qint64 plainMs = timer.elapsed();
+            const qint64 rss1 = residentKb();
+
+            timer.restart();
+            CAircraftModelInterner interner;
+            CAircraftModelList internedModels;
+            for (const QJsonValue &value : array)
+            {
+                CAircraftModel model;
+                model.convertFromJson(value.toObject());
+                interner.intern(model);
+                internedModels.push_back(model);
+            }
+            const qint64 internedMs = timer.elapsed();
+            const qint64 rss2 = residentKb();
+
+            CStringBytes plainBytes;
+            plainBytes.add(models);
+            CStringBytes internedBytes;
+            internedBytes.add(internedModels);
+
+            streamOut << "plain:    " << (rss1 - rss0) << "kB resident, " << plainBytes.bytes() / 1024 << "kB string data, loaded in " << plainMs << "ms" << Qt::endl;
+            streamOut << "interned: " << (rss2 - rss1) << "kB resident, " << internedBytes.bytes() / 1024 << "kB string data, loaded in " << internedMs << "ms" << Qt::endl;
+            streamOut << "distinct: " << interner.getInfoString() << Qt::endl;
+
+            const bool equal = models.size() == internedModels.size() && std::equal(models.begin(), models.end(), internedModels.begin());
+            streamOut << "Same models: " << boolToYesNo(equal) << Qt::endl;
+            if (rss0 < 0) { streamOut << "Resident memory not available on this platform" << Qt::endl; }
+        }
+        catch (const CJsonException &ex)
+        {
+            streamOut << ex.toString("JSON") << Qt::endl;
+        }
+    }
+} // namespace
@@ -0,0 +1,30 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+//! \ingroup sampleblackmiscsim
+
+#ifndef BLACKSAMPLE_SAMPLESMODELMEMORY_H
+#define BLACKSAMPLE_SAMPLESMODELMEMORY_H
+
+class QTextStream;
+
+namespace BlackSample
+{
+    //! Memory benchmark of a loaded model set
+    //! \details Loads the same models twice from JSON, once as they are and once interned with
+    //!          BlackMisc::Simulation::CAircraftModelInterner, reporting the resident memory used by each copy.
+    class CSamplesModelMemory
+    {
+    public:
+        //! Run the benchmark
+        static void samples(QTextStream &streamOut, QTextStream &streamIn);
+    };
+} // namespace
+
+#endif
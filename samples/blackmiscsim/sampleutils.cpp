@@ -7,12 +7,22 @@
  */
 
 #include "sampleutils.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/distributor.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/airlineicaocode.h"
+#include "blackmisc/aviation/livery.h"
+
+#include <QDateTime>
 
 #include <QString>
 #include <QStringList>
 #include <QTextStream>
 #include <QtGlobal>
 
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation;
+
 namespace BlackMisc
 {
     QString CSampleUtils::selectDirectory(const QStringList &directoryOptions, QTextStream &streamOut, QTextStream &streamIn)
@@ -45,4 +55,27 @@ namespace BlackMisc
         while (true);
         return selectedDir;
     }
+
+    Simulation::CAircraftModelList CSampleUtils::syntheticModels(int count)
+    {
+        static const QStringList designators({ "A319", "A320", "A321", "B737", "B738", "B744", "C172", "CRJ9", "E190", "DH8D" });
+        static const QStringList airlines({ "DLH", "BAW", "AFR", "KLM", "UAL", "DAL", "EZY", "RYR", "SWR", "AUA", "SAS", "TAP" });
+        static const QStringList distributors({ "FSX", "WOAI", "FAIB", "IVAO", "XCSL", "BB" });
+        CAircraftModelList models;
+        for (int i = 0; i < count; i++)
+        {
+            const QString &designator = designators.at(i % designators.size());
+            const QString &airline = airlines.at((i / designators.size()) % airlines.size());
+            const CAircraftIcaoCode icao(designator, "L2J", "Manufacturer", designator + " model", "M", false, false, false, 0);
+            const CLivery livery(airline + ".STD", CAirlineIcaoCode(airline), airline + " standard livery");
+            CAircraftModel model(QStringLiteral("%1 %2 %3").arg(airline, designator).arg(i), CAircraftModel::TypeOwnSimulatorModel, icao, livery);
+            model.setDistributor(CDistributor(distributors.at(i % distributors.size())));
+            model.setFileName(QStringLiteral("C:/Simulator/SimObjects/Airplanes/%1 %2/aircraft.cfg").arg(airline, designator));
+            model.setDescription(QStringLiteral("%1 %2 in %1 colors").arg(airline, designator));
+            model.setSimulator(CSimulatorInfo::FSX);
+            model.setFileTimestamp(QDateTime::currentMSecsSinceEpoch());
+            models.push_back(model);
+        }
+        return models;
+    }
 }
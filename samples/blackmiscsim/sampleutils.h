@@ -17,6 +17,8 @@ class QTextStream;
 
 namespace BlackMisc
 {
+    namespace Simulation { class CAircraftModelList; }
+
     //! Utils for sample programms
     class CSampleUtils
     {
@@ -24,6 +26,9 @@ namespace BlackMisc
         //! Select directory among given ones
         static QString selectDirectory(const QStringList &directoryOptions, QTextStream &streamOut, QTextStream &streamIn);
 
+        //! Synthetic model set, with few distinct ICAO codes, liveries and distributors like a real set
+        static Simulation::CAircraftModelList syntheticModels(int count);
+
     private:
         CSampleUtils() = delete;
     };
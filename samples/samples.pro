@@ -11,6 +11,7 @@ SUBDIRS += sampleblackmiscsim
 SUBDIRS += samplehotkey
 SUBDIRS += sampleweatherdata
 SUBDIRS += samplefsd
+SUBDIRS += sampleafvaudio
 # SUBDIRS += afvclient
 
 samplecliclient.file = cliclient/samplecliclient.pro
@@ -21,6 +22,7 @@ sampleblackmiscsim.file = blackmiscsim/sampleblackmiscsim.pro
 samplehotkey.file = hotkey/samplehotkey.pro
 sampleweatherdata.file = weatherdata/sampleweatherdata.pro
 samplefsd.file = fsd/samplefsd.pro
+sampleafvaudio.file = afvaudio/sampleafvaudio.pro
 # afvclient.file = afvclient/afvclient.pro
 
 load(common_post)
@@ -35,10 +35,11 @@ namespace BlackCore
                 ISampleProvider(parent),
                 m_audioFormat(audioFormat),
                 m_receiver(receiver),
-                m_decoder(audioFormat.sampleRate(), 1)
+                m_jitterBuffer(audioFormat.sampleRate())
             {
                 Q_ASSERT(audioFormat.channelCount() == 1);
                 Q_ASSERT(receiver);
+                Q_ASSERT(receiver->decoderPool());
 
                 const QString on = QStringLiteral("%1").arg(classNameShort(this));
                 this->setObjectName(on);
@@ -71,44 +72,60 @@ namespace BlackCore
                 m_timer = new QTimer(this);
                 m_timer->setObjectName(this->objectName() +  ":m_timer");
 
-                m_timer->setInterval(100);
+                // also detects the end of a transmission and underflows, this is not done when reading samples
+                m_timer->setInterval(20);
                 connect(m_timer, &QTimer::timeout, this, &CCallsignSampleProvider::timerElapsed);
             }
 
-            int CCallsignSampleProvider::readSamples(QVector<float> &samples, qint64 count)
+            int CCallsignSampleProvider::readSamples(float *samples, int count)
             {
-                const int noOfSamples = m_mixer->readSamples(samples, count);
+                // soundcard thread: only the buffered audio is read, decoding and idle detection are done by the decode stage
+                return m_mixer->readSamples(samples, count);
+            }
 
-                if (m_inUse && m_lastPacketLatch && m_audioInput->getBufferedBytes() == 0)
+            void CCallsignSampleProvider::timerElapsed()
+            {
+                // missing packets are concealed when the buffer runs low, also if no further packets arrive
+                this->decodePackets();
+                this->checkBuffer();
+                if (m_inUse && m_audioInput->getBufferedSamples() == 0 && m_lastSamplesAddedUtc.msecsTo(QDateTime::currentDateTimeUtc()) > m_idleTimeoutMs)
                 {
                     idle();
-                    m_lastPacketLatch = false;
                 }
+            }
 
-                if (m_inUse && !m_underflow && m_audioInput->getBufferedBytes() == 0)
+            void CCallsignSampleProvider::checkBuffer()
+            {
+                if (!m_inUse) { return; }
+                if (m_lastPacketLatch && m_packets.isEmpty() && m_audioInput->getBufferedSamples() == 0)
                 {
-                    if (verbose()) { CLogMessage(this).debug(u"[%1] [Delay++]") << m_callsign; }
-                    CallsignDelayCache::instance().underflow(m_callsign);
-                    m_underflow = true;
+                    idle();
+                    m_lastPacketLatch = false;
+                    return;
                 }
 
-                return noOfSamples;
-            }
+                // the soundcard counts the reads running out of audio
+                const quint32 underruns = m_audioInput->getUnderruns();
+                if (underruns == m_underruns) { return; }
+                m_underruns = underruns;
+                if (m_lastPacketLatch) { return; } // end of transmission
 
-            void CCallsignSampleProvider::timerElapsed()
-            {
-                if (m_inUse && m_audioInput->getBufferedBytes() == 0 && m_lastSamplesAddedUtc.msecsTo(QDateTime::currentDateTimeUtc()) > m_idleTimeoutMs)
+                m_statUnderflows++;
+                if (!m_underflow)
                 {
-                    idle();
+                    if (verbose()) { CLogMessage(this).debug(u"[%1] [Delay++]") << m_callsign; }
+                    CallsignDelayCache::instance().underflow(m_callsign);
+                    m_underflow = true;
                 }
             }
 
             void CCallsignSampleProvider::active(const QString &callsign, const QString &aircraftType)
             {
-                m_callsign = callsign;
+                this->setCallsign(callsign);
                 CallsignDelayCache::instance().initialise(callsign);
                 m_aircraftType = aircraftType;
-                m_decoder.resetState();
+                this->acquireDecoder();
+                this->resetReceiveState();
                 m_inUse = true;
                 setEffects();
                 m_underflow = false;
@@ -117,40 +134,44 @@ namespace BlackCore
                 if (verbose()) { CLogMessage(this).debug(u"[%1] [Delay %2ms]") << m_callsign << delayMs; }
                 if (delayMs > 0)
                 {
+                    // initial level of the jitter buffer
                     const int phaseDelayLength = (m_audioFormat.sampleRate() / 1000) * delayMs;
-                    const QVector<float> phaseDelay(phaseDelayLength * 2, 0);
-                    m_audioInput->addSamples(phaseDelay);
+                    m_audioInput->addSilence(phaseDelayLength);
                 }
+                emit this->inUseChanged();
             }
 
             void CCallsignSampleProvider::activeSilent(const QString &callsign, const QString &aircraftType)
             {
-                m_callsign = callsign;
+                this->setCallsign(callsign);
                 CallsignDelayCache::instance().initialise(callsign);
                 m_aircraftType = aircraftType;
-                m_decoder.resetState();
+                this->acquireDecoder();
+                this->resetReceiveState();
                 m_inUse = true;
                 setEffects(true);
                 m_underflow = true;
+                emit this->inUseChanged();
             }
 
             void CCallsignSampleProvider::clear()
             {
                 idle();
+                m_packets.clear();
                 m_audioInput->clearBuffer();
             }
 
             void CCallsignSampleProvider::addOpusSamples(const IAudioDto &audioDto, float distanceRatio)
             {
-                m_distanceRatio = distanceRatio;
-                setEffects();
-
-                const QVector<qint16> audio = decodeOpus(audioDto.audio);
-                m_audioInput->addSamples(BlackSound::convertFromShortToFloat(audio));
-                m_lastPacketLatch = audioDto.lastPacket;
-                if (audioDto.lastPacket && !m_underflow) { CallsignDelayCache::instance().success(m_callsign); }
-                m_lastSamplesAddedUtc = QDateTime::currentDateTimeUtc();
-                if (!m_timer->isActive()) { m_timer->start(); }
+                m_statPackets++;
+
+                QueuedPacket packet;
+                packet.audio = audioDto.audio;
+                packet.sequenceCounter = audioDto.sequenceCounter;
+                packet.arrivalMs = QDateTime::currentMSecsSinceEpoch();
+                packet.lastPacket = audioDto.lastPacket;
+                packet.distanceRatio = distanceRatio;
+                if (!m_packets.tryPush(std::move(packet))) { m_statDroppedPackets++; }
             }
 
             void CCallsignSampleProvider::addSilentSamples(const IAudioDto &audioDto)
@@ -165,20 +186,106 @@ namespace BlackCore
                 if (!m_timer->isActive()) { m_timer->start(); }
             }
 
+            void CCallsignSampleProvider::decodePackets()
+            {
+                this->decodedPackets(this->decodeQueuedPackets());
+            }
+
+            CCallsignSampleProvider::DecodeResult CCallsignSampleProvider::decodeQueuedPackets()
+            {
+                DecodeResult result;
+                QueuedPacket packet;
+                while (m_packets.tryPop(packet))
+                {
+                    m_distanceRatio = packet.distanceRatio;
+                    m_jitterBuffer.insert(packet.sequenceCounter, packet.audio, packet.lastPacket, packet.arrivalMs);
+                    result.received = true;
+                }
+
+                // idle, packets of a callsign not (yet) active are discarded
+                if (!m_decoder) { return result; }
+
+                const quint32 dropped = m_audioInput->getDroppedSamples();
+                result.lastPacketPlayed = m_jitterBuffer.playout(*m_decoder, *m_audioInput, QDateTime::currentMSecsSinceEpoch());
+                if (m_audioInput->getDroppedSamples() != dropped) { m_statDroppedPackets++; }
+                return result;
+            }
+
+            void CCallsignSampleProvider::decodedPackets(const DecodeResult &result)
+            {
+                if (result.lastPacketPlayed)
+                {
+                    m_lastPacketLatch = true;
+                    if (!m_underflow) { CallsignDelayCache::instance().success(m_callsign); }
+                }
+                if (!result.received) { return; }
+
+                setEffects();
+                m_lastSamplesAddedUtc = QDateTime::currentDateTimeUtc();
+                if (!m_timer->isActive()) { m_timer->start(); }
+            }
+
+            CallsignReceiveStatistics CCallsignSampleProvider::getStatistics() const
+            {
+                CallsignReceiveStatistics statistics;
+                {
+                    QMutexLocker lock(&m_mutexCallsign);
+                    statistics.callsign     = m_callsign;
+                }
+                statistics.transceiverId    = m_receiver->getId();
+                statistics.bufferedMs       = m_audioInput->getBufferedSamples() / qMax(1, m_audioFormat.sampleRate() / 1000);
+                statistics.targetDelayMs    = m_jitterBuffer.getTargetDelayMs();
+                statistics.jitterMs         = m_jitterBuffer.getJitterMs();
+                statistics.latencyMs        = m_jitterBuffer.getLatencyMs();
+                statistics.queuedPackets    = m_packets.size();
+                statistics.packets          = m_statPackets;
+                statistics.latePackets      = m_jitterBuffer.getLatePackets();
+                statistics.duplicatePackets = m_jitterBuffer.getDuplicatePackets();
+                statistics.droppedPackets   = m_statDroppedPackets;
+                statistics.recoveredFrames  = m_jitterBuffer.getRecoveredFrames();
+                statistics.concealedFrames  = m_jitterBuffer.getConcealedFrames();
+                statistics.stretchedFrames  = m_jitterBuffer.getStretchedFrames();
+                statistics.underflows       = m_statUnderflows;
+                return statistics;
+            }
+
+            void CCallsignSampleProvider::acquireDecoder()
+            {
+                if (m_decoder)
+                {
+                    m_decoder->resetState();
+                    return;
+                }
+                m_decoder = m_receiver->decoderPool()->acquire();
+            }
+
             void CCallsignSampleProvider::idle()
             {
                 m_timer->stop();
+                m_receiver->decoderPool()->release(m_decoder);
+                m_decoder = nullptr;
+                const bool changed = m_inUse;
                 m_inUse = false;
                 setEffects();
-                m_callsign.clear();
+                this->setCallsign({});
                 m_aircraftType.clear();
+                if (changed) { emit this->inUseChanged(); }
+            }
+
+            void CCallsignSampleProvider::setCallsign(const QString &callsign)
+            {
+                QMutexLocker lock(&m_mutexCallsign);
+                m_callsign = callsign;
             }
 
-            QVector<qint16> CCallsignSampleProvider::decodeOpus(const QByteArray &opusData)
+            void CCallsignSampleProvider::resetReceiveState()
             {
-                int decodedLength = 0;
-                const QVector<qint16> decoded = m_decoder.decode(opusData, opusData.size(), &decodedLength);
-                return decoded;
+                m_jitterBuffer.reset(CallsignDelayCache::instance().get(m_callsign));
+                m_lastPacketLatch = false;
+                m_underruns = m_audioInput->getUnderruns();
+                m_statPackets = 0;
+                m_statDroppedPackets = 0;
+                m_statUnderflows = 0;
             }
 
             void CCallsignSampleProvider::setEffects(bool noEffects)
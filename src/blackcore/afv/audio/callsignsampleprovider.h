@@ -12,6 +12,7 @@
 #define BLACKCORE_AFV_AUDIO_CALLSIGNSAMPLEPROVIDER_H
 
 #include "blackcore/afv/dto.h"
+#include "blackcore/afv/audio/jitterbuffer.h"
 #include "blacksound/sampleprovider/pinknoisegenerator.h"
 #include "blacksound/sampleprovider/bufferedwaveprovider.h"
 #include "blacksound/sampleprovider/mixingsampleprovider.h"
@@ -20,12 +21,15 @@
 #include "blacksound/sampleprovider/simplecompressoreffect.h"
 #include "blacksound/sampleprovider/resourcesoundsampleprovider.h"
 #include "blacksound/codecs/opusdecoder.h"
+#include "blackmisc/spscqueue.h"
 
 #include <QAudioFormat>
 #include <QSoundEffect>
 #include <QSharedPointer>
 #include <QTimer>
+#include <QMutex>
 #include <QDateTime>
+#include <atomic>
 
 namespace BlackCore
 {
@@ -35,6 +39,26 @@ namespace BlackCore
         {
             class CReceiverSampleProvider;
 
+            //! Receive statistics of a callsign
+            struct CallsignReceiveStatistics
+            {
+                QString callsign;          //!< callsign
+                quint16 transceiverId = 0; //!< receiving transceiver
+                int bufferedMs       = 0;  //!< decoded audio waiting for the soundcard (jitter buffer depth)
+                int targetDelayMs    = 0;  //!< depth the jitter buffer adapts to
+                int jitterMs         = 0;  //!< arrival jitter
+                int latencyMs        = 0;  //!< average time from receiving a packet to playing it
+                int queuedPackets    = 0;  //!< packets waiting for the decode stage
+                int packets          = 0;  //!< packets received
+                int latePackets      = 0;  //!< packets arriving after their playout, dropped
+                int duplicatePackets = 0;  //!< packets received twice, dropped
+                int droppedPackets   = 0;  //!< packets dropped as the queue or buffer was full
+                int recoveredFrames  = 0;  //!< missing packets recovered from FEC data
+                int concealedFrames  = 0;  //!< missing packets concealed
+                int stretchedFrames  = 0;  //!< frames shortened or lengthened to adapt the delay
+                int underflows       = 0;  //!< soundcard ran out of audio while receiving
+            };
+
             //! Callsign provider
             class CCallsignSampleProvider : public BlackSound::SampleProvider::ISampleProvider
             {
@@ -44,8 +68,8 @@ namespace BlackCore
                 //! Ctor
                 CCallsignSampleProvider(const QAudioFormat &audioFormat, const BlackCore::Afv::Audio::CReceiverSampleProvider *receiver, QObject *parent = nullptr);
 
-                //! Read samples
-                int readSamples(QVector<float> &samples, qint64 count) override;
+                //! \copydoc BlackSound::SampleProvider::ISampleProvider::readSamples
+                virtual int readSamples(float *samples, int count) override;
 
                 //! The callsign
                 const QString &callsign() const { return m_callsign; }
@@ -63,24 +87,68 @@ namespace BlackCore
                 void clear();
 
                 //! Add samples
+                //! \remark only queues the Opus packet, decoded by decodePackets
                 //! @{
                 void addOpusSamples(const IAudioDto &audioDto, float distanceRatio);
                 void addSilentSamples(const IAudioDto &audioDto);
                 //! @}
 
+                //! Result of decoding the queued packets
+                struct DecodeResult
+                {
+                    bool received = false;         //!< packets have been queued
+                    bool lastPacketPlayed = false; //!< last packet of the transmission decoded
+                };
+
+                //! Decode stage, decodes the queued packets into the buffer read by the soundcard
+                //! \remark same as decodedPackets(decodeQueuedPackets())
+                void decodePackets();
+
+                //! Decode the queued packets, without touching the state shared with other callsigns
+                //! \remark can run on a thread pool thread of COpusDecoderPool::run, in parallel for different callsigns
+                DecodeResult decodeQueuedPackets();
+
+                //! Update the idle detection and effects after decodeQueuedPackets, on the thread owning the provider
+                void decodedPackets(const DecodeResult &result);
+
                 //! Callsign in use
+                //! \threadsafe
                 bool inUse() const { return m_inUse; }
 
+                //! Receive statistics since the callsign became active
+                //! \threadsafe
+                CallsignReceiveStatistics getStatistics() const;
+
                 //! Bypass effects
                 void setBypassEffects(bool bypassEffects);
 
+                //! Equalizer of the voice
+                BlackSound::SampleProvider::CEqualizerSampleProvider *voiceEqualizer() const { return m_voiceEqualizer; }
+
                 //! Info
                 QString toQString() const;
 
+            signals:
+                //! Callsign became active or idle
+                void inUseChanged();
+
             private:
+                //! Opus packet waiting for the decode stage
+                struct QueuedPacket
+                {
+                    QByteArray audio;
+                    uint   sequenceCounter = 0;
+                    qint64 arrivalMs       = 0;
+                    bool   lastPacket      = false;
+                    float  distanceRatio   = 1.0f;
+                };
+
                 void timerElapsed();
+                void checkBuffer();
+                void resetReceiveState();
+                void acquireDecoder();
                 void idle();
-                QVector<qint16> decodeOpus(const QByteArray &opusData);
+                void setCallsign(const QString &callsign); //!< written on the AFV thread, read by getStatistics
                 void setEffects(bool noEffects = false);
 
                 QAudioFormat m_audioFormat;
@@ -90,10 +158,12 @@ namespace BlackCore
                 const double m_acBusGainMin        = 0.0028; //0.002;
                 const int m_frameCount    = 960;
                 const int m_idleTimeoutMs = 500;
+                static constexpr int MaxQueuedPackets = 64; //!< 1.28s of 20ms packets
 
                 QString m_callsign;
+                mutable QMutex m_mutexCallsign; //!< m_callsign read by getStatistics from other threads
                 QString m_aircraftType;
-                bool m_inUse = false;
+                std::atomic_bool m_inUse { false }; //!< read by the soundcard
 
                 bool m_bypassEffects  = false;
                 float m_distanceRatio = 1.0;
@@ -108,10 +178,17 @@ namespace BlackCore
                 BlackSound::SampleProvider::CBufferedWaveProvider        *m_audioInput             = nullptr;
                 QTimer *m_timer = nullptr;
 
-                BlackSound::Codecs::COpusDecoder m_decoder;
+                BlackSound::Codecs::COpusDecoder *m_decoder = nullptr; //!< from the receiver's pool while in use
+                BlackMisc::CSpscQueue<QueuedPacket> m_packets { MaxQueuedPackets }; //!< network -> decode stage
+                CJitterBuffer m_jitterBuffer; //!< decode stage -> m_audioInput
                 bool m_lastPacketLatch = false;
                 QDateTime m_lastSamplesAddedUtc;
                 bool m_underflow = false;
+                quint32 m_underruns = 0; //!< underruns of m_audioInput already checked
+
+                std::atomic_int m_statPackets        { 0 };
+                std::atomic_int m_statDroppedPackets { 0 };
+                std::atomic_int m_statUnderflows     { 0 };
             };
         } // ns
     } // ns
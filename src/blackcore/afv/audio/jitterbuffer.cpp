@@ -0,0 +1,226 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "jitterbuffer.h"
+#include "blacksound/dsp/timestretch.h"
+
+#include <QtGlobal>
+#include <algorithm>
+
+using namespace BlackSound::Codecs;
+using namespace BlackSound::Dsp;
+using namespace BlackSound::SampleProvider;
+
+namespace BlackCore
+{
+    namespace Afv
+    {
+        namespace Audio
+        {
+            CJitterBuffer::CJitterBuffer(int sampleRate) :
+                m_sampleRate(sampleRate),
+                m_stretchMin(sampleRate * 25 / 10000),  // 2.5ms
+                m_stretchMax(sampleRate * 5 / 1000),    // 5ms, a pitch period of low voices
+                m_stretchOverlap(sampleRate * 25 / 10000),
+                m_window(WindowFrames),
+                m_decoded(COpusDecoder::MaxFrameSamples, 0.0f),
+                m_stretched(COpusDecoder::MaxFrameSamples + sampleRate * 5 / 1000, 0.0f),
+                m_transits(TransitHistory, 0),
+                m_frameSamples(sampleRate * FrameMs / 1000)
+            { }
+
+            void CJitterBuffer::reset(int initialDelayMs)
+            {
+                for (Packet &packet : m_window) { packet = Packet(); }
+                m_started = false;
+                m_hasPlayed = false;
+                m_transitCount = 0;
+                m_frameSamples = m_sampleRate * FrameMs / 1000;
+                m_averageBufferedSamples = 0.0;
+                m_targetDelayMs = qBound(MinDelayMs, initialDelayMs, MaxDelayMs);
+                m_jitterMs = 0;
+                m_latencyMs = 0;
+                m_latePackets = 0;
+                m_duplicatePackets = 0;
+                m_recoveredFrames = 0;
+                m_concealedFrames = 0;
+                m_stretchedFrames = 0;
+            }
+
+            bool CJitterBuffer::insert(uint sequenceCounter, const QByteArray &audio, bool lastPacket, qint64 arrivalMs)
+            {
+                if (!m_started)
+                {
+                    // the tail of the transmission played already
+                    if (m_hasPlayed && distance(m_nextSequence, sequenceCounter) < 0)
+                    {
+                        m_latePackets++;
+                        return false;
+                    }
+                    this->start(sequenceCounter);
+                }
+
+                const int ahead = distance(m_nextSequence, sequenceCounter);
+                if (ahead < 0)
+                {
+                    m_latePackets++;
+                    return false;
+                }
+                if (ahead >= WindowFrames)
+                {
+                    // gap longer than the window, e.g. a new transmission without a last packet before
+                    this->start(sequenceCounter);
+                }
+
+                Packet &packet = this->slot(sequenceCounter);
+                if (packet.valid && packet.sequenceCounter == sequenceCounter)
+                {
+                    m_duplicatePackets++;
+                    return false;
+                }
+
+                packet.audio = audio;
+                packet.sequenceCounter = sequenceCounter;
+                packet.arrivalMs = arrivalMs;
+                packet.lastPacket = lastPacket;
+                packet.valid = true;
+                if (distance(m_highestSequence, sequenceCounter) > 0) { m_highestSequence = sequenceCounter; }
+                this->updateDelay(sequenceCounter, arrivalMs);
+                return true;
+            }
+
+            bool CJitterBuffer::playout(COpusDecoder &decoder, CBufferedWaveProvider &output, qint64 nowMs)
+            {
+                while (m_started)
+                {
+                    const int bufferedSamples = output.getBufferedSamples();
+                    Packet &packet = this->slot(m_nextSequence);
+                    if (packet.valid && packet.sequenceCounter == m_nextSequence)
+                    {
+                        // time in the queues plus the audio played before this frame
+                        const int latencyMs = static_cast<int>(nowMs - packet.arrivalMs) + bufferedSamples * 1000 / m_sampleRate;
+                        m_latencyMs = m_latencyMs == 0 ? latencyMs : (m_latencyMs * 7 + latencyMs) / 8;
+
+                        const bool lastPacket = packet.lastPacket;
+                        this->decodeFrame(decoder, packet.audio, output, bufferedSamples, lastPacket);
+                        packet = Packet();
+                        m_nextSequence++;
+                        m_hasPlayed = true;
+                        if (lastPacket)
+                        {
+                            m_started = false;
+                            return true;
+                        }
+                        continue;
+                    }
+
+                    // wait for the missing packet as long as the audio buffered lasts for another decode run
+                    if (distance(m_nextSequence, m_highestSequence) <= 0) { break; }
+                    if (bufferedSamples > 2 * m_frameSamples) { break; }
+
+                    const uint following = m_nextSequence + 1;
+                    int samples = 0;
+                    if (this->contains(following))
+                    {
+                        samples = decoder.decodeFec(this->slot(following).audio, m_decoded.data(), m_frameSamples);
+                        m_recoveredFrames++;
+                    }
+                    else
+                    {
+                        samples = decoder.decodeLost(m_decoded.data(), m_frameSamples);
+                        m_concealedFrames++;
+                    }
+                    output.addSamples(m_decoded.constData(), samples);
+                    packet = Packet();
+                    m_nextSequence++;
+                }
+                return false;
+            }
+
+            bool CJitterBuffer::contains(uint sequenceCounter) const
+            {
+                const Packet &packet = m_window.at(static_cast<int>(sequenceCounter % WindowFrames));
+                return packet.valid && packet.sequenceCounter == sequenceCounter;
+            }
+
+            void CJitterBuffer::start(uint sequenceCounter)
+            {
+                for (Packet &packet : m_window) { packet = Packet(); }
+                m_started = true;
+                m_nextSequence = sequenceCounter;
+                m_highestSequence = sequenceCounter;
+                m_firstSequence = sequenceCounter;
+                m_transitCount = 0;
+            }
+
+            void CJitterBuffer::updateDelay(uint sequenceCounter, qint64 arrivalMs)
+            {
+                // the sender sends a packet every FrameMs, so the variation of arrival minus send time is the jitter
+                const qint64 sentMs = static_cast<qint64>(distance(m_firstSequence, sequenceCounter)) * FrameMs;
+                m_transits[m_transitCount % TransitHistory] = arrivalMs - sentMs;
+                m_transitCount++;
+
+                const int transits = qMin(m_transitCount, TransitHistory);
+                const auto minMax = std::minmax_element(m_transits.cbegin(), m_transits.cbegin() + transits);
+                const int jitterMs = static_cast<int>(*minMax.second - *minMax.first);
+                m_jitterMs = jitterMs;
+
+                // a few packets are not enough for an estimate, the initial delay is kept until then
+                if (transits < 10) { return; }
+                m_targetDelayMs = qBound(MinDelayMs, jitterMs + FrameMs, MaxDelayMs);
+            }
+
+            void CJitterBuffer::decodeFrame(COpusDecoder &decoder, const QByteArray &audio, CBufferedWaveProvider &output, int bufferedSamples, bool lastPacket)
+            {
+                // the level is measured after the soundcard read a varying part of a frame, so its average is compared
+                m_averageBufferedSamples = 0.9 * m_averageBufferedSamples + 0.1 * bufferedSamples;
+                const int targetSamples = m_targetDelayMs * m_sampleRate / 1000;
+                const int hysteresis = m_frameSamples / 2;
+                const bool shrink = !lastPacket && m_averageBufferedSamples > targetSamples + hysteresis && bufferedSamples > targetSamples;
+                const bool grow = !lastPacket && m_averageBufferedSamples < targetSamples - hysteresis && bufferedSamples < targetSamples;
+
+                if (!shrink && !grow)
+                {
+                    // directly into the audio buffer, if the free space does not wrap around within a frame
+                    int writable = 0;
+                    float *samples = output.writableSamples(writable);
+                    if (writable >= COpusDecoder::MaxFrameSamples)
+                    {
+                        const int decoded = decoder.decode(audio, samples, writable);
+                        output.commitSamples(decoded);
+                        if (decoded > 0) { m_frameSamples = decoded; }
+                        return;
+                    }
+                }
+
+                const int decoded = decoder.decode(audio, m_decoded.data(), m_decoded.size());
+                if (decoded < 1) { return; }
+                m_frameSamples = decoded;
+
+                int stretched = decoded;
+                if (shrink)
+                {
+                    stretched = CTimeStretch::shrink(m_decoded.constData(), decoded, m_stretched.data(), m_stretchMin, m_stretchMax, m_stretchOverlap);
+                }
+                else if (grow)
+                {
+                    stretched = CTimeStretch::grow(m_decoded.constData(), decoded, m_stretched.data(), m_stretchMin, m_stretchMax, m_stretchOverlap);
+                }
+
+                if (stretched == decoded)
+                {
+                    output.addSamples(m_decoded.constData(), decoded);
+                    return;
+                }
+                m_stretchedFrames++;
+                m_averageBufferedSamples += stretched - decoded;
+                output.addSamples(m_stretched.constData(), stretched);
+            }
+        } // ns
+    } // ns
+} // ns
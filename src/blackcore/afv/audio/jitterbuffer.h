@@ -0,0 +1,143 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKCORE_AFV_AUDIO_JITTERBUFFER_H
+#define BLACKCORE_AFV_AUDIO_JITTERBUFFER_H
+
+#include "blackcore/blackcoreexport.h"
+#include "blacksound/codecs/opusdecoder.h"
+#include "blacksound/sampleprovider/bufferedwaveprovider.h"
+
+#include <QByteArray>
+#include <QVector>
+#include <atomic>
+
+namespace BlackCore
+{
+    namespace Afv
+    {
+        namespace Audio
+        {
+            //! Adaptive jitter buffer for the OPUS packets of one transmission
+            //! \details Packets are reordered by the AFV sequence counter, duplicates and packets arriving after their
+            //!          playout are dropped. Missing packets are recovered from the FEC data of the following packet or
+            //!          concealed by the decoder. The delay follows the arrival jitter, decoded frames are shortened or
+            //!          lengthened by a few milliseconds to reach it.
+            //! \remark the audio buffer is the playout buffer, its level is the delay of the next decoded frame
+            class BLACKCORE_EXPORT CJitterBuffer
+            {
+            public:
+                //! Duration of an AFV packet
+                static constexpr int FrameMs = 20;
+
+                //! Packets kept for reordering
+                static constexpr int WindowFrames = 16;
+
+                //! Delay limits
+                //! @{
+                static constexpr int MinDelayMs = 40;
+                static constexpr int MaxDelayMs = 300;
+                //! @}
+
+                //! Ctor
+                CJitterBuffer(int sampleRate);
+
+                //! Start again, e.g. for a new transmission
+                void reset(int initialDelayMs);
+
+                //! Add a received packet
+                //! \return false if late or a duplicate
+                bool insert(uint sequenceCounter, const QByteArray &audio, bool lastPacket, qint64 arrivalMs);
+
+                //! Decode the packets due into the audio buffer, conceal missing ones once the buffer runs low
+                //! \return true if the last packet of the transmission has been decoded
+                bool playout(BlackSound::Codecs::COpusDecoder &decoder, BlackSound::SampleProvider::CBufferedWaveProvider &output, qint64 nowMs);
+
+                //! Delay the buffer aims for
+                int getTargetDelayMs() const { return m_targetDelayMs; }
+
+                //! Arrival jitter of the recent packets (max. minus min. transit time)
+                int getJitterMs() const { return m_jitterMs; }
+
+                //! Average time from receiving a packet to playing it
+                int getLatencyMs() const { return m_latencyMs; }
+
+                //! Counters since reset
+                //! @{
+                int getLatePackets() const { return m_latePackets; }
+                int getDuplicatePackets() const { return m_duplicatePackets; }
+                int getRecoveredFrames() const { return m_recoveredFrames; }
+                int getConcealedFrames() const { return m_concealedFrames; }
+                int getStretchedFrames() const { return m_stretchedFrames; }
+                //! @}
+
+            private:
+                //! Packet waiting for playout
+                struct Packet
+                {
+                    QByteArray audio;
+                    uint   sequenceCounter = 0;
+                    qint64 arrivalMs  = 0;
+                    bool   lastPacket = false;
+                    bool   valid      = false;
+                };
+
+                //! Slot of a sequence counter
+                Packet &slot(uint sequenceCounter) { return m_window[static_cast<int>(sequenceCounter % WindowFrames)]; }
+
+                //! Has packet for the sequence counter?
+                bool contains(uint sequenceCounter) const;
+
+                //! Start with the given packet
+                void start(uint sequenceCounter);
+
+                //! Update jitter and target delay
+                void updateDelay(uint sequenceCounter, qint64 arrivalMs);
+
+                //! Decode a packet into the audio buffer, shortened or lengthened towards the target delay
+                void decodeFrame(BlackSound::Codecs::COpusDecoder &decoder, const QByteArray &audio, BlackSound::SampleProvider::CBufferedWaveProvider &output, int bufferedSamples, bool lastPacket);
+
+                //! Signed distance of sequence counters, handles the wrap around
+                static int distance(uint from, uint to) { return static_cast<int>(to - from); }
+
+                static constexpr int TransitHistory = 100; //!< packets, 2s
+
+                const int m_sampleRate;
+                const int m_stretchMin;     //!< samples added/removed at least when stretching
+                const int m_stretchMax;     //!< samples added/removed at most when stretching
+                const int m_stretchOverlap; //!< samples of the stretch cross fade
+                QVector<Packet> m_window;
+                QVector<float>  m_decoded;   //!< decoded frame
+                QVector<float>  m_stretched; //!< stretched frame
+                QVector<qint64> m_transits;  //!< arrival time minus send time of the recent packets
+
+                bool m_started    = false;
+                bool m_hasPlayed  = false;
+                uint m_nextSequence    = 0; //!< next packet played
+                uint m_highestSequence = 0; //!< newest packet received
+                uint m_firstSequence   = 0; //!< reference of the transit times
+                int  m_transitCount    = 0;
+                int  m_frameSamples    = 0; //!< samples of the last decoded frame, used for concealment
+                double m_averageBufferedSamples = 0.0;
+
+                std::atomic_int m_targetDelayMs    { MinDelayMs };
+                std::atomic_int m_jitterMs         { 0 };
+                std::atomic_int m_latencyMs        { 0 };
+                std::atomic_int m_latePackets      { 0 };
+                std::atomic_int m_duplicatePackets { 0 };
+                std::atomic_int m_recoveredFrames  { 0 };
+                std::atomic_int m_concealedFrames  { 0 };
+                std::atomic_int m_stretchedFrames  { 0 };
+            };
+        } // ns
+    } // ns
+} // ns
+
+#endif // guard
@@ -8,18 +8,21 @@
 
 #include "output.h"
 #include "blacksound/audioutilities.h"
+#include "blacksound/dsp/dspkernels.h"
 #include "blackmisc/metadatautils.h"
 #include "blackmisc/logmessage.h"
 #include "blackmisc/verify.h"
 
 #include <QDebug>
 #include <QStringBuilder>
+#include <algorithm>
 #include <cmath>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Audio;
 using namespace BlackSound;
 using namespace BlackSound::SampleProvider;
+using namespace BlackSound::Dsp;
 
 namespace BlackCore
 {
@@ -29,7 +32,8 @@ namespace BlackCore
         {
             CAudioOutputBuffer::CAudioOutputBuffer(ISampleProvider *sampleProvider, QObject *parent) :
                 QIODevice(parent),
-                m_sampleProvider(sampleProvider)
+                m_sampleProvider(sampleProvider),
+                m_buffer(ISampleProvider::MaxBlockSize, 0.0f)
             {
                 Q_ASSERT_X(sampleProvider, Q_FUNC_INFO, "need sample provide");
                 const QString on = QStringLiteral("%1 for %2").arg(classNameShort(this), sampleProvider->objectName());
@@ -41,16 +45,40 @@ namespace BlackCore
                 const int sampleBytes  = m_outputFormat.sampleSize() / 8;
                 const int channelCount = m_outputFormat.channelCount();
                 const qint64 count     = maxlen / (sampleBytes * channelCount);
-                QVector<float> buffer;
-                m_sampleProvider->readSamples(buffer, count);
 
-                for (float sample : as_const(buffer))
+                // read in blocks the providers can handle, written directly to the device data
+                float *buffer = m_buffer.data();
+                float *output = reinterpret_cast<float *>(data);
+                for (qint64 offset = 0; offset < count;)
                 {
-                    const float absSample = qAbs(sample);
-                    if (absSample > m_maxSampleOutput) { m_maxSampleOutput = absSample; }
+                    const int blockSize = static_cast<int>(qMin<qint64>(count - offset, ISampleProvider::MaxBlockSize));
+                    m_sampleProvider->readSamples(buffer, blockSize);
+
+                    for (int n = 0; n < blockSize; n++)
+                    {
+                        const float absSample = qAbs(buffer[n]);
+                        if (absSample > m_maxSampleOutput) { m_maxSampleOutput = absSample; }
+                    }
+
+                    // the peak above is measured before, so overdriving is still visible
+                    CDspKernels::clip(buffer, blockSize, 1.0f);
+
+                    if (channelCount == 2)
+                    {
+                        for (int n = 0; n < blockSize; n++)
+                        {
+                            output[2 * (offset + n)]     = buffer[n];
+                            output[2 * (offset + n) + 1] = buffer[n];
+                        }
+                    }
+                    else
+                    {
+                        std::copy(buffer, buffer + blockSize, output + offset);
+                    }
+                    offset += blockSize;
                 }
 
-                m_sampleCount += buffer.size();
+                m_sampleCount += static_cast<int>(count);
                 if (m_sampleCount >= SampleCountPerEvent)
                 {
                     OutputVolumeStreamArgs outputVolumeStreamArgs;
@@ -66,13 +94,7 @@ namespace BlackCore
                     m_maxSampleOutput = 0;
                 }
 
-                if (channelCount == 2)
-                {
-                    buffer = convertFromMonoToStereo(buffer);
-                }
-
-                memcpy(data, buffer.constData(), static_cast<size_t>(maxlen));
-                return maxlen;
+                return count * sampleBytes * channelCount;
             }
 
             qint64 CAudioOutputBuffer::writeData(const char *data, qint64 len)
@@ -56,6 +56,7 @@ namespace BlackCore
 
             private:
                 BlackSound::SampleProvider::ISampleProvider *m_sampleProvider = nullptr; //!< related provider
+                QVector<float> m_buffer; //!< block read from the provider
 
                 static constexpr int SampleCountPerEvent = 4800;
                 QAudioFormat m_outputFormat;
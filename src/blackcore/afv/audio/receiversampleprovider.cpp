@@ -13,6 +13,7 @@
 #include "blackmisc/metadatautils.h"
 #include "blacksound/sampleprovider/resourcesoundsampleprovider.h"
 #include "blacksound/sampleprovider/samples.h"
+#include "blacksound/dsp/dspkernels.h"
 
 #include <QDebug>
 #include <QStringBuilder>
@@ -21,6 +22,8 @@ using namespace BlackMisc;
 using namespace BlackMisc::Audio;
 using namespace BlackMisc::Aviation;
 using namespace BlackSound::SampleProvider;
+using namespace BlackSound::Codecs;
+using namespace BlackSound::Dsp;
 
 namespace BlackCore
 {
@@ -34,17 +37,22 @@ namespace BlackCore
                 return cats;
             }
 
-            CReceiverSampleProvider::CReceiverSampleProvider(const QAudioFormat &audioFormat, quint16 id, int voiceInputNumber, QObject *parent) :
+            CReceiverSampleProvider::CReceiverSampleProvider(const QAudioFormat &audioFormat, quint16 id, int voiceInputNumber, COpusDecoderPool *decoderPool, QObject *parent) :
                 ISampleProvider(parent),
-                m_id(id)
+                m_id(id),
+                m_decoderPool(decoderPool),
+                m_clickBuffer(MaxBlockSize, 0.0f),
+                m_voiceEqualizerLanes(voiceInputNumber, MaxBlockSize)
             {
                 const QString on = QStringLiteral("%1 id: %2").arg(classNameShort(this)).arg(id);
                 this->setObjectName(on);
 
                 m_mixer = new CMixingSampleProvider(this);
+                m_voiceEqualizers.reserve(voiceInputNumber);
                 for (int i = 0; i < voiceInputNumber; i++)
                 {
                     const auto voiceInput = new CCallsignSampleProvider(audioFormat, this, m_mixer);
+                    connect(voiceInput, &CCallsignSampleProvider::inUseChanged, this, &CReceiverSampleProvider::updateReceivingCallsigns);
                     m_voiceInputs.push_back(voiceInput);
                     m_mixer->addMixerInput(voiceInput);
                 }
@@ -52,6 +60,7 @@ namespace BlackCore
                 m_blockTone = new CSinusGenerator(180, this);
                 m_mixer->addMixerInput(m_blockTone);
                 m_volume = new CVolumeSampleProvider(m_mixer);
+                m_click = new CResourceSoundSampleProvider(Samples::instance().click(), this);
             }
 
             void CReceiverSampleProvider::setBypassEffects(bool value)
@@ -95,9 +104,9 @@ namespace BlackCore
                 }
             }
 
-            int CReceiverSampleProvider::readSamples(QVector<float> &samples, qint64 count)
+            int CReceiverSampleProvider::readSamples(float *samples, int count)
             {
-                int numberOfInUseInputs = activeCallsigns();
+                const int numberOfInUseInputs = activeCallsigns();
                 if (numberOfInUseInputs > 1 && m_doBlockWhenAppropriate)
                 {
                     m_blockTone->setFrequency(180.0);
@@ -108,34 +117,33 @@ namespace BlackCore
                     m_blockTone->setGain(0.0);
                 }
 
-                if (m_doClickWhenAppropriate && numberOfInUseInputs == 0)
+                if (numberOfInUseInputs == 0 && m_doClickWhenAppropriate.exchange(false))
                 {
-                    CResourceSoundSampleProvider *resourceSound = new CResourceSoundSampleProvider(Samples::instance().click(), m_mixer);
-                    m_mixer->addMixerInput(resourceSound);
-                    m_doClickWhenAppropriate = false;
+                    // the same click provider is used again, no allocation when reading samples
+                    m_click->restart();
+                    m_clickPlaying = true;
                     // CLogMessage(this).debug(u"AFV Click...");
                 }
 
-                //! \todo KB 2020-04 not entirely correct, as it can be the number is the same, but changed callsign
-                if (numberOfInUseInputs != m_lastNumberOfInUseInputs)
+                // the voice equalizers of all callsigns are filtered at once, the mixer then reads the filtered blocks
+                m_voiceEqualizers.clear(); // keeps the capacity
+                for (CCallsignSampleProvider *voiceInput : qAsConst(m_voiceInputs))
                 {
-                    QStringList receivingCallsigns;
-                    for (const CCallsignSampleProvider *voiceInput : m_voiceInputs)
-                    {
-                        const QString callsign = voiceInput->callsign();
-                        if (!callsign.isEmpty())
-                        {
-                            receivingCallsigns.push_back(callsign);
-                        }
-                    }
+                    if (voiceInput->inUse()) { m_voiceEqualizers.push_back(voiceInput->voiceEqualizer()); }
+                }
+                if (m_voiceEqualizers.size() > 1) { CEqualizerSampleProvider::prefetch(m_voiceEqualizers, count, m_voiceEqualizerLanes); }
 
-                    m_receivingCallsignsString = receivingCallsigns.join(',');
-                    m_receivingCallsigns = CCallsignSet(receivingCallsigns);
-                    const TransceiverReceivingCallsignsChangedArgs args = { m_id, receivingCallsigns };
-                    emit receivingCallsignsChanged(args);
+                int samplesRead = m_volume->readSamples(samples, count);
+
+                if (m_clickPlaying)
+                {
+                    float *clickBuffer = m_clickBuffer.data();
+                    const int clickRead = m_click->readSamples(clickBuffer, count);
+                    CDspKernels::mix(samples, clickBuffer, clickRead);
+                    samplesRead = qMax(samplesRead, clickRead);
+                    m_clickPlaying = !m_click->isFinished();
                 }
-                m_lastNumberOfInUseInputs = numberOfInUseInputs;
-                return m_volume->readSamples(samples, count);
+                return samplesRead;
             }
 
             void CReceiverSampleProvider::addOpusSamples(const IAudioDto &audioDto, uint frequency, float distanceRatio)
@@ -205,6 +213,57 @@ namespace BlackCore
                 }
             }
 
+            void CReceiverSampleProvider::appendVoiceInputsInUse(QVector<CCallsignSampleProvider *> &voiceInputs) const
+            {
+                for (CCallsignSampleProvider *voiceInput : m_voiceInputs)
+                {
+                    if (voiceInput->inUse()) { voiceInputs.push_back(voiceInput); }
+                }
+            }
+
+            QVector<CallsignReceiveStatistics> CReceiverSampleProvider::getCallsignStatistics() const
+            {
+                QVector<CallsignReceiveStatistics> statistics;
+                for (const CCallsignSampleProvider *voiceInput : m_voiceInputs)
+                {
+                    if (voiceInput->inUse()) { statistics.push_back(voiceInput->getStatistics()); }
+                }
+                return statistics;
+            }
+
+            QString CReceiverSampleProvider::getReceivingCallsignsString() const
+            {
+                QMutexLocker lock(&m_mutexReceivingCallsigns);
+                return m_receivingCallsignsString;
+            }
+
+            CCallsignSet CReceiverSampleProvider::getReceivingCallsigns() const
+            {
+                QMutexLocker lock(&m_mutexReceivingCallsigns);
+                return m_receivingCallsigns;
+            }
+
+            void CReceiverSampleProvider::updateReceivingCallsigns()
+            {
+                QStringList receivingCallsigns;
+                for (const CCallsignSampleProvider *voiceInput : qAsConst(m_voiceInputs))
+                {
+                    const QString callsign = voiceInput->callsign();
+                    if (!callsign.isEmpty())
+                    {
+                        receivingCallsigns.push_back(callsign);
+                    }
+                }
+
+                {
+                    QMutexLocker lock(&m_mutexReceivingCallsigns);
+                    m_receivingCallsignsString = receivingCallsigns.join(',');
+                    m_receivingCallsigns = CCallsignSet(receivingCallsigns);
+                }
+                const TransceiverReceivingCallsignsChangedArgs args = { m_id, receivingCallsigns };
+                emit receivingCallsignsChanged(args);
+            }
+
             uint CReceiverSampleProvider::getFrequencyHz() const
             {
                 return m_frequencyHz;
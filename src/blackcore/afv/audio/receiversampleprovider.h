@@ -14,14 +14,19 @@
 #include "blackcore/afv/audio/callsignsampleprovider.h"
 #include "blacksound/sampleprovider/sampleprovider.h"
 #include "blacksound/sampleprovider/mixingsampleprovider.h"
+#include "blacksound/sampleprovider/resourcesoundsampleprovider.h"
 #include "blacksound/sampleprovider/sinusgenerator.h"
 #include "blacksound/sampleprovider/volumesampleprovider.h"
+#include "blacksound/dsp/biquadcascade.h"
+#include "blacksound/codecs/opusdecoderpool.h"
 
 #include "blackmisc/logcategories.h"
 #include "blackmisc/aviation/callsignset.h"
 #include "blackmisc/audio/audiosettings.h"
 
 #include <QtGlobal>
+#include <QMutex>
+#include <atomic>
 
 namespace BlackCore
 {
@@ -46,7 +51,8 @@ namespace BlackCore
                 static const QStringList &getLogCategories();
 
                 //! Ctor
-                CReceiverSampleProvider(const QAudioFormat &audioFormat, quint16 id, int voiceInputNumber, QObject *parent = nullptr);
+                //! \param decoderPool decoders of the callsigns, must outlive the callsigns in use
+                CReceiverSampleProvider(const QAudioFormat &audioFormat, quint16 id, int voiceInputNumber, BlackSound::Codecs::COpusDecoderPool *decoderPool, QObject *parent = nullptr);
 
                 //! Bypass effects
                 void setBypassEffects(bool value);
@@ -67,7 +73,8 @@ namespace BlackCore
                 //! @}
 
                 //! \copydoc BlackSound::SampleProvider::ISampleProvider::readSamples
-                virtual int readSamples(QVector<float> &samples, qint64 count) override;
+                //! \remark lock and allocation free, the callsigns are updated by the decode stage
+                virtual int readSamples(float *samples, int count) override;
 
                 //! Add samples
                 //! @{
@@ -75,16 +82,27 @@ namespace BlackCore
                 void addSilentSamples(const IAudioDto &audioDto, uint frequency, float distanceRatio);
                 //! @}
 
+                //! Append the callsigns in use, whose queued packets are decoded
+                void appendVoiceInputsInUse(QVector<CCallsignSampleProvider *> &voiceInputs) const;
+
+                //! Decoders of the callsigns
+                BlackSound::Codecs::COpusDecoderPool *decoderPool() const { return m_decoderPool; }
+
+                //! Receive statistics of the callsigns in use
+                QVector<CallsignReceiveStatistics> getCallsignStatistics() const;
+
                 //! ID
                 quint16 getId() const { return m_id; }
 
                 //! Receiving callsigns as string
                 //! \remark those callsigns are transmitting and "I do receive them"
-                const QString &getReceivingCallsignsString() const { return m_receivingCallsignsString; }
+                //! \threadsafe
+                QString getReceivingCallsignsString() const;
 
                 //! Receiving callsigns
                 //! \remark those callsigns are transmitting and "I do receive them"
-                const BlackMisc::Aviation::CCallsignSet &getReceivingCallsigns() { return m_receivingCallsigns; }
+                //! \threadsafe
+                BlackMisc::Aviation::CCallsignSet getReceivingCallsigns() const;
 
                 //! Get frequency in Hz
                 uint getFrequencyHz() const;
@@ -98,26 +116,35 @@ namespace BlackCore
                 void receivingCallsignsChanged(const TransceiverReceivingCallsignsChangedArgs &args);
 
             private:
+                //! Callsigns in use have changed
+                void updateReceivingCallsigns();
+
                 uint m_frequencyHz = 122800000;
                 bool m_mute        = false;
                 const double m_clickGain     = 1.0;
                 const double m_blockToneGain = 0.10;
 
                 quint16 m_id;
+                BlackSound::Codecs::COpusDecoderPool *m_decoderPool = nullptr;
                 BlackMisc::CSettingReadOnly<BlackMisc::Audio::TSettings> m_audioSettings { this };
 
                 BlackSound::SampleProvider::CVolumeSampleProvider *m_volume    = nullptr;
                 BlackSound::SampleProvider::CMixingSampleProvider *m_mixer     = nullptr;
                 BlackSound::SampleProvider::CSinusGenerator       *m_blockTone = nullptr;
+                BlackSound::SampleProvider::CResourceSoundSampleProvider *m_click = nullptr; //!< played again for each click
+                QVector<float> m_clickBuffer;
                 QVector<CCallsignSampleProvider *> m_voiceInputs;
+                QVector<BlackSound::SampleProvider::CEqualizerSampleProvider *> m_voiceEqualizers; //!< equalizers of the callsigns in use, filtered together
+                BlackSound::Dsp::CBiQuadCascadeLanes m_voiceEqualizerLanes;
                 qint64 m_lastLogMessage = -1;
 
                 QString m_receivingCallsignsString;
                 BlackMisc::Aviation::CCallsignSet m_receivingCallsigns;
+                mutable QMutex m_mutexReceivingCallsigns; //!< never locked by the soundcard thread
 
-                bool m_doClickWhenAppropriate  = false;
-                bool m_doBlockWhenAppropriate  = false;
-                int  m_lastNumberOfInUseInputs = 0;
+                std::atomic_bool m_doClickWhenAppropriate { false };
+                std::atomic_bool m_doBlockWhenAppropriate { false };
+                bool m_clickPlaying = false;
             };
         } // ns
     } // ns
@@ -10,6 +10,9 @@
 #include "blackmisc/metadatautils.h"
 #include "blackconfig/buildconfig.h"
 
+#include <QVarLengthArray>
+#include <algorithm>
+
 using namespace BlackConfig;
 using namespace BlackMisc;
 using namespace BlackSound::SampleProvider;
@@ -20,9 +23,9 @@ namespace BlackCore
     {
         namespace Audio
         {
-            CSoundcardSampleProvider::CSoundcardSampleProvider(int sampleRate, const QVector<quint16> &transceiverIDs, QObject *parent) :
+            CSoundcardSampleProvider::CSoundcardSampleProvider(int sampleRate, const QVector<quint16> &transceiverIDs, int voiceInputNumber, QObject *parent) :
                 ISampleProvider(parent),
-                m_mixer(new CMixingSampleProvider())
+                m_decoderPool(sampleRate, 1)
             {
                 const QString on = QStringLiteral("%1 sample rate: %2, transceivers: %3").arg(classNameShort(this)).arg(sampleRate).arg(transceiverIDs.size());
                 this->setObjectName(on);
@@ -37,15 +40,18 @@ namespace BlackCore
                 m_mixer = new CMixingSampleProvider(this);
                 m_receiverIDs = transceiverIDs;
 
-                constexpr int voiceInputNumber = 4; // number of CallsignSampleProviders
                 for (quint16 transceiverID : transceiverIDs)
                 {
-                    CReceiverSampleProvider *transceiverInput = new CReceiverSampleProvider(m_waveFormat, transceiverID, voiceInputNumber, m_mixer);
+                    CReceiverSampleProvider *transceiverInput = new CReceiverSampleProvider(m_waveFormat, transceiverID, voiceInputNumber, &m_decoderPool, m_mixer);
                     connect(transceiverInput, &CReceiverSampleProvider::receivingCallsignsChanged, this, &CSoundcardSampleProvider::receivingCallsignsChanged);
                     m_receiverInputs.push_back(transceiverInput);
                     m_receiverIDs.push_back(transceiverID);
                     m_mixer->addMixerInput(transceiverInput);
                 }
+
+                const int voiceInputs = transceiverIDs.size() * voiceInputNumber;
+                m_decoding.reserve(voiceInputs);
+                m_decodeResults.reserve(voiceInputs);
             }
 
             void CSoundcardSampleProvider::setBypassEffects(bool value)
@@ -91,69 +97,89 @@ namespace BlackCore
                 }
             }
 
-            int CSoundcardSampleProvider::readSamples(QVector<float> &samples, qint64 count)
+            int CSoundcardSampleProvider::readSamples(float *samples, int count)
             {
                 return m_mixer->readSamples(samples, count);
             }
 
             void CSoundcardSampleProvider::addOpusSamples(const IAudioDto &audioDto, const QVector<RxTransceiverDto> &rxTransceivers)
             {
-                QVector<RxTransceiverDto> rxTransceiversFilteredAndSorted = rxTransceivers;
-
-                rxTransceiversFilteredAndSorted.erase(std::remove_if(rxTransceiversFilteredAndSorted.begin(), rxTransceiversFilteredAndSorted.end(), [this](const RxTransceiverDto & r)
+                // strongest transceiver first, sorted on the stack as this is called for every packet
+                QVarLengthArray<const RxTransceiverDto *, 8> rxTransceiversFilteredAndSorted;
+                for (const RxTransceiverDto &rxTransceiver : rxTransceivers)
                 {
-                    return !m_receiverIDs.contains(r.id);
-                }),
-                rxTransceiversFilteredAndSorted.end());
+                    if (m_receiverIDs.contains(rxTransceiver.id)) { rxTransceiversFilteredAndSorted.push_back(&rxTransceiver); }
+                }
 
-                std::sort(rxTransceiversFilteredAndSorted.begin(), rxTransceiversFilteredAndSorted.end(), [](const RxTransceiverDto & a, const RxTransceiverDto & b) -> bool
+                std::stable_sort(rxTransceiversFilteredAndSorted.begin(), rxTransceiversFilteredAndSorted.end(), [](const RxTransceiverDto * a, const RxTransceiverDto * b) -> bool
                 {
-                    return a.distanceRatio > b.distanceRatio;
+                    return a->distanceRatio > b->distanceRatio;
                 });
 
-                if (rxTransceiversFilteredAndSorted.size() > 0)
+                bool audioPlayed = false;
+                QVarLengthArray<quint16, 8> handledTransceiverIDs;
+                for (const RxTransceiverDto *rxTransceiver : qAsConst(rxTransceiversFilteredAndSorted))
                 {
-                    bool audioPlayed = false;
-                    QVector<quint16> handledTransceiverIDs;
-                    for (int i = 0; i < rxTransceiversFilteredAndSorted.size(); i++)
+                    if (std::find(handledTransceiverIDs.cbegin(), handledTransceiverIDs.cend(), rxTransceiver->id) != handledTransceiverIDs.cend()) { continue; }
+                    handledTransceiverIDs.push_back(rxTransceiver->id);
+
+                    auto it = std::find_if(m_receiverInputs.begin(), m_receiverInputs.end(), [rxTransceiver](const CReceiverSampleProvider * p)
                     {
-                        const RxTransceiverDto rxTransceiver = rxTransceiversFilteredAndSorted[i];
-                        if (!handledTransceiverIDs.contains(rxTransceiver.id))
-                        {
-                            handledTransceiverIDs.push_back(rxTransceiver.id);
+                        return p->getId() == rxTransceiver->id;
+                    });
+                    if (it == m_receiverInputs.end()) { continue; }
 
-                            CReceiverSampleProvider *receiverInput = nullptr;
-                            auto it = std::find_if(m_receiverInputs.begin(), m_receiverInputs.end(), [rxTransceiver](const CReceiverSampleProvider * p)
-                            {
-                                return p->getId() == rxTransceiver.id;
-                            });
+                    CReceiverSampleProvider *receiverInput = *it;
+                    if (receiverInput->getMute()) { continue; }
 
-                            if (it != m_receiverInputs.end())
-                            {
-                                receiverInput = *it;
-                            }
+                    if (!audioPlayed)
+                    {
+                        receiverInput->addOpusSamples(audioDto, rxTransceiver->frequency, rxTransceiver->distanceRatio);
+                        audioPlayed = true;
+                    }
+                    else
+                    {
+                        receiverInput->addSilentSamples(audioDto, rxTransceiver->frequency, rxTransceiver->distanceRatio);
+                    }
 
-                            if (!receiverInput) { continue; }
-                            if (receiverInput->getMute()) { continue; }
+                    // debug ONLY
+                    if (CBuildConfig::isLocalDeveloperDebugBuild())
+                    {
+                        receiverInput->logVoiceInputs(QStringLiteral("Transceiver %1 ").arg(rxTransceiver->id), 1500);
+                    }
+                } // each transceiver
+            }
 
-                            if (!audioPlayed)
-                            {
-                                receiverInput->addOpusSamples(audioDto, rxTransceiver.frequency, rxTransceiver.distanceRatio);
-                                audioPlayed = true;
-                            }
-                            else
-                            {
-                                receiverInput->addSilentSamples(audioDto, rxTransceiver.frequency, rxTransceiver.distanceRatio);
-                            }
+            void CSoundcardSampleProvider::decodePackets()
+            {
+                m_decoding.clear();
+                for (const CReceiverSampleProvider *receiverInput : qAsConst(m_receiverInputs))
+                {
+                    receiverInput->appendVoiceInputsInUse(m_decoding);
+                }
+                if (m_decoding.isEmpty()) { return; }
 
-                            // debug ONLY
-                            if (CBuildConfig::isLocalDeveloperDebugBuild())
-                            {
-                                receiverInput->logVoiceInputs(QStringLiteral("Transceiver %1 ").arg(rxTransceiver.id), 1500);
-                            }
-                        }
-                    } // each transceiver
-                } // filtered rx transceivers
+                // decoding only touches the callsign's own queue, jitter buffer and decoder, so callsigns run in parallel,
+                // idle detection and effects are QObject state and updated here afterwards
+                m_decodeResults.resize(m_decoding.size());
+                m_decoderPool.run(m_decoding.size(), [this](int i)
+                {
+                    m_decodeResults[i] = m_decoding[i]->decodeQueuedPackets();
+                });
+                for (int i = 0; i < m_decoding.size(); i++)
+                {
+                    m_decoding[i]->decodedPackets(m_decodeResults[i]);
+                }
+            }
+
+            QVector<CallsignReceiveStatistics> CSoundcardSampleProvider::getCallsignStatistics() const
+            {
+                QVector<CallsignReceiveStatistics> statistics;
+                for (const CReceiverSampleProvider *receiverInput : m_receiverInputs)
+                {
+                    statistics += receiverInput->getCallsignStatistics();
+                }
+                return statistics;
             }
 
             void CSoundcardSampleProvider::updateRadioTransceivers(const QVector<TransceiverDto> &radioTransceivers)
@@ -31,8 +31,16 @@ namespace BlackCore
                 Q_OBJECT
 
             public:
+                //! Number of callsigns received at the same time per transceiver
+                static constexpr int DefaultVoiceInputNumber = 4;
+
                 //! Ctor
-                CSoundcardSampleProvider(int sampleRate, const QVector<quint16> &transceiverIDs, QObject *parent = nullptr);
+                CSoundcardSampleProvider(int sampleRate, const QVector<quint16> &transceiverIDs, QObject *parent = nullptr) :
+                    CSoundcardSampleProvider(sampleRate, transceiverIDs, DefaultVoiceInputNumber, parent)
+                {}
+
+                //! Ctor with number of callsigns per transceiver
+                CSoundcardSampleProvider(int sampleRate, const QVector<quint16> &transceiverIDs, int voiceInputNumber, QObject *parent = nullptr);
 
                 //! Wave format
                 const QAudioFormat &waveFormat() const { return m_waveFormat; }
@@ -44,11 +52,23 @@ namespace BlackCore
                 void pttUpdate(bool active, const QVector<TxTransceiverDto> &txTransceivers);
 
                 //! \copydoc BlackSound::SampleProvider::ISampleProvider::readSamples
-                virtual int readSamples(QVector<float> &samples, qint64 count) override;
+                virtual int readSamples(float *samples, int count) override;
 
                 //! Add OPUS samples
+                //! \remark the packets are queued, call decodePackets afterwards
                 void addOpusSamples(const IAudioDto &audioDto, const QVector<RxTransceiverDto> &rxTransceivers);
 
+                //! Decode stage, decodes the queued packets of all receivers
+                //! \remark runs with the network updates, never called by the soundcard
+                //! \remark the callsigns are decoded in parallel by the decoder pool if several are in use
+                void decodePackets();
+
+                //! Decoders of all callsigns
+                const BlackSound::Codecs::COpusDecoderPool &decoderPool() const { return m_decoderPool; }
+
+                //! Receive statistics of all callsigns in use
+                QVector<CallsignReceiveStatistics> getCallsignStatistics() const;
+
                 //! Update all tranceivers
                 void updateRadioTransceivers(const QVector<TransceiverDto> &radioTransceivers);
 
@@ -67,6 +87,9 @@ namespace BlackCore
                 BlackSound::SampleProvider::CMixingSampleProvider *m_mixer = nullptr;
                 QVector<CReceiverSampleProvider *> m_receiverInputs;
                 QVector<quint16> m_receiverIDs;
+                BlackSound::Codecs::COpusDecoderPool m_decoderPool; //!< shared by the callsigns of all receivers
+                QVector<CCallsignSampleProvider *> m_decoding; //!< callsigns of the current decode run
+                QVector<CCallsignSampleProvider::DecodeResult> m_decodeResults;
             };
 
         } // ns
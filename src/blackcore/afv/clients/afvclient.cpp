@@ -862,13 +862,14 @@ namespace BlackCore
                     audioData.audio      = QByteArray(args.audio.data(), args.audio.size());
                     audioData.callsign   = QStringLiteral("loopback");
                     audioData.lastPacket = false;
-                    audioData.sequenceCounter = 0;
+                    audioData.sequenceCounter = args.sequenceCounter;
 
                     const RxTransceiverDto com1 = { 0, transceivers.size() > 0 ?  transceivers[0].frequencyHz : UniCom, 1.0 };
                     const RxTransceiverDto com2 = { 1, transceivers.size() > 1 ?  transceivers[1].frequencyHz : UniCom, 1.0 };
 
                     QMutexLocker lock(&m_mutexSampleProviders);
                     m_soundcardSampleProvider->addOpusSamples(audioData, { com1, com2 });
+                    m_soundcardSampleProvider->decodePackets();
                     return;
                 }
 
@@ -915,6 +916,7 @@ namespace BlackCore
 
                 QMutexLocker lock(&m_mutexSampleProviders);
                 m_soundcardSampleProvider->addOpusSamples(audioData, QVector<RxTransceiverDto>(dto.transceivers.begin(), dto.transceivers.end()));
+                m_soundcardSampleProvider->decodePackets();
             }
 
             void CAfvClient::inputVolumeStream(const InputVolumeStreamArgs &args)
@@ -975,6 +977,13 @@ namespace BlackCore
                 return coms;
             }
 
+            QVector<CallsignReceiveStatistics> CAfvClient::getCallsignReceiveStatistics() const
+            {
+                QMutexLocker lock(&m_mutexSampleProviders);
+                if (!m_soundcardSampleProvider) { return {}; }
+                return m_soundcardSampleProvider->getCallsignStatistics();
+            }
+
             bool CAfvClient::updateVoiceServerUrl(const QString &url)
             {
                 QMutexLocker lock(&m_mutexConnection);
@@ -279,6 +279,10 @@ namespace BlackCore
                 QStringList getReceivingCallsignsStringCom1Com2() const;
                 //! @}
 
+                //! Receive statistics of the callsigns currently received, e.g. jitter buffer depth and late packets
+                //! \threadsafe
+                QVector<Audio::CallsignReceiveStatistics> getCallsignReceiveStatistics() const;
+
                 //! Update the voice server URL
                 bool updateVoiceServerUrl(const QString &url);
 
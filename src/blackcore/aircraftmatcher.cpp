@@ -8,8 +8,11 @@
 
 #include "blackcore/aircraftmatcher.h"
 #include "blackcore/application.h"
+#include "blackcore/matchingscriptengine.h"
 #include "blackcore/webdataservices.h"
 #include "blackmisc/simulation/simulatedaircraft.h"
+#include "blackmisc/simulation/aircraftmodelinterner.h"
+#include "blackmisc/simulation/aircraftmodelscoring.h"
 #include "blackmisc/simulation/matchingscript.h"
 #include "blackmisc/simulation/matchingutils.h"
 #include "blackmisc/aviation/aircrafticaocode.h"
@@ -19,6 +22,7 @@
 #include "blackmisc/fileutils.h"
 #include "blackmisc/logcategories.h"
 #include "blackmisc/logmessage.h"
+#include "blackmisc/range.h"
 #include "blackmisc/statusmessagelist.h"
 #include "blackmisc/swiftdirectories.h"
 #include "blackmisc/directoryutils.h"
@@ -30,6 +34,7 @@
 #include <QPair>
 #include <QStringBuilder>
 #include <QJSEngine>
+#include <QElapsedTimer>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Aviation;
@@ -44,7 +49,7 @@ namespace BlackCore
         return cats;
     }
 
-    CAircraftMatcher::CAircraftMatcher(const CAircraftMatcherSetup &setup, QObject *parent) : QObject(parent), m_setup(setup)
+    CAircraftMatcher::CAircraftMatcher(const CAircraftMatcherSetup &setup, QObject *parent) : QObject(parent), m_setup(setup), m_setupHash(qHash(setup))
     {
         if (sApp && sApp->hasWebDataServices())
         {
@@ -66,6 +71,8 @@ namespace BlackCore
     {
         if (m_setup == setup) { return false; }
         m_setup = setup;
+        m_setupHash = qHash(setup);
+        m_resultCache->clear();
         emit this->setupChanged();
         return true;
     }
@@ -251,10 +258,29 @@ namespace BlackCore
         return CAircraftMatcher::failoverValidAirlineIcaoDesignator(callsign, primaryIcao, secondaryIcao, airlineFromCallsign, airlineName, airlineTelephony, true, log);
     }
 
+    CAircraftMatcher::MatchingSnapshot CAircraftMatcher::getMatchingSnapshot() const
+    {
+        MatchingSnapshot snapshot;
+        snapshot.setup = m_setup;
+        snapshot.defaultModel = m_defaultModel;
+        snapshot.modelSetIndex = m_modelSetIndex;
+        snapshot.categoryMatcher = m_categoryMatcher;
+        snapshot.resultCache = m_resultCache;
+        snapshot.setupHash = m_setupHash;
+        snapshot.modelSetRevision = m_modelSetRevision;
+        return snapshot;
+    }
+
     CAircraftModel CAircraftMatcher::getClosestMatch(const CSimulatedAircraft &remoteAircraft, MatchingLog whatToLog, CStatusMessageList *log, bool useMatchingScript) const
     {
-        CAircraftModelList modelSet(m_modelSet); // Models for this matching
-        const CAircraftMatcherSetup setup = m_setup;
+        return CAircraftMatcher::getClosestMatch(this->getMatchingSnapshot(), remoteAircraft, whatToLog, log, useMatchingScript);
+    }
+
+    CAircraftModel CAircraftMatcher::getClosestMatch(const MatchingSnapshot &snapshot, const CSimulatedAircraft &remoteAircraft, MatchingLog whatToLog, CStatusMessageList *log, bool useMatchingScript)
+    {
+        const std::shared_ptr<const CAircraftModelSetIndex> index = snapshot.modelSetIndex; // Models for this matching
+        ModelIds modelSetIds = index->allIds();
+        const CAircraftMatcherSetup &setup = snapshot.setup;
 
         static const QString format("hh:mm:ss.zzz");
         static const QString m1("--- Start matching: UTC %1 ---");
@@ -278,7 +304,7 @@ namespace BlackCore
 
         CMatchingUtils::addLogDetailsToList(log, remoteAircraft, m1.arg(startTime.toString(format)));
         CMatchingUtils::addLogDetailsToList(log, remoteAircraft, m2.arg(remoteAircraft.getCallsignAsString(), removeSurroundingApostrophes(remoteAircraft.getModel().toQString())));
-        CMatchingUtils::addLogDetailsToList(log, remoteAircraft, m3.arg(modelSet.size()).arg(modelSet.coverageSummaryForModel(remoteAircraft.getModel())));
+        if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, m3.arg(index->size()).arg(index->getModels().coverageSummaryForModel(remoteAircraft.getModel()))); }
         CMatchingUtils::addLogDetailsToList(log, remoteAircraft, m4.arg(setup.toQString(true)));
 
         // Before I really search I check some special conditions
@@ -297,10 +323,10 @@ namespace BlackCore
             matchedModel = remoteAircraft.getModel();
             resolvedInPrephase = true;
         }
-        else if (modelSet.isEmpty())
+        else if (index->isEmpty())
         {
             CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("No models for matching, using default"), getLogCategories(), CStatusMessage::SeverityError);
-            matchedModel = this->getDefaultModel();
+            matchedModel = snapshot.defaultModel;
             resolvedInPrephase = true;
         }
         else if (remoteAircraft.hasModelString())
@@ -308,7 +334,7 @@ namespace BlackCore
             // try to find in installed models by model string
             if (setup.getMatchingMode().testFlag(CAircraftMatcherSetup::ByModelString))
             {
-                matchedModel = matchByExactModelString(remoteAircraft, modelSet, whatToLog, log);
+                matchedModel = matchByExactModelString(remoteAircraft, *index, whatToLog, log);
                 if (matchedModel.hasModelString())
                 {
                     CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Exact match by model string '" % matchedModel.getModelStringAndDbKey() % "'", getLogCategories(), CStatusMessage::SeverityError);
@@ -324,73 +350,104 @@ namespace BlackCore
         if (!resolvedInPrephase)
         {
             // sanity
-            const int noString = modelSet.removeAllWithoutModelString();
+            const int s0 = modelSetIds.size();
+            modelSetIds = index->findWithModelString(modelSetIds);
+            const int noString = s0 - modelSetIds.size();
             static const QString noModelStr("Excluded %1 models without model string");
             if (noString > 0 && log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, noModelStr.arg(noString)); }
 
             // exclusion
             if (setup.getMatchingMode().testFlag(CAircraftMatcherSetup::ExcludeNoDbData))
             {
-                const int noDbKey = modelSet.removeObjectsWithoutDbKey();
+                const int s1 = modelSetIds.size();
+                modelSetIds = index->findWithDbKey(modelSetIds);
+                const int noDbKey = s1 - modelSetIds.size();
                 static const QString excludedStr("Excluded %1 models without DB key");
                 if (noDbKey > 0 && log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, excludedStr.arg(noDbKey)); }
             }
 
             if (setup.getMatchingMode().testFlag(CAircraftMatcherSetup::ExcludeNoExcluded))
             {
-                const int excluded = modelSet.removeIfExcluded();
+                const int s2 = modelSetIds.size();
+                modelSetIds = index->findNotExcluded(modelSetIds);
+                const int excluded = s2 - modelSetIds.size();
                 static const QString excludedStr("Excluded %1 models marked 'Excluded'");
                 if (excluded > 0 && log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, excludedStr.arg(excluded)); }
             }
 
             // Reduce by ICAO if the flag is set
             static const QString msInfo("Using '%1' with model set with %2 models");
-            CMatchingUtils::addLogDetailsToList(log, remoteAircraft, msInfo.arg(setup.getMatchingAlgorithmAsString()).arg(modelSet.size()), getLogCategories());
+            CMatchingUtils::addLogDetailsToList(log, remoteAircraft, msInfo.arg(setup.getMatchingAlgorithmAsString()).arg(modelSetIds.size()), getLogCategories());
             CAircraftModelList candidates;
             int maxScore = -1;
 
-            switch (setup.getMatchingAlgorithm())
+            // same input, setup and model set yield the same candidates
+            // the reduce steps are not repeated, so the log only states the result came from the cache
+            CMatchingResultCache::Entry cached;
+            const bool cacheHit = snapshot.resultCache && snapshot.resultCache->find(remoteAircraft.getModel(), snapshot.setupHash, snapshot.modelSetRevision, cached);
+            if (cacheHit)
             {
-            case CAircraftMatcherSetup::MatchingStepwiseReduce:
-                candidates = CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(modelSet, setup, m_categoryMatcher, remoteAircraft, whatToLog, log);
-                break;
-            case CAircraftMatcherSetup::MatchingScoreBased:
-                candidates = CAircraftMatcher::getClosestMatchScoreImplementation(modelSet, setup, remoteAircraft, maxScore, whatToLog, log);
-                break;
-            case CAircraftMatcherSetup::MatchingStepwiseReducePlusScoreBased:
-            default:
-                candidates = CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(modelSet, setup, m_categoryMatcher, remoteAircraft, whatToLog, log);
-                candidates = CAircraftMatcher::getClosestMatchScoreImplementation(candidates, setup, remoteAircraft, maxScore, whatToLog, log);
-                break;
-            }
-
-            if (candidates.isEmpty())
-            {
-                matchedModel = CAircraftMatcher::getCombinedTypeDefaultModel(modelSet, remoteAircraft, this->getDefaultModel(), whatToLog, log);
+                if (setup.getPickStrategy() == CAircraftMatcherSetup::PickRandom && cached.candidates.size() > 1)
+                {
+                    matchedModel = cached.candidates.randomElement<CAircraftModel>();
+                }
+                else
+                {
+                    matchedModel = cached.model;
+                }
+                if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("Cached result of an identical request: '%1' (%2 candidates)").arg(matchedModel.getModelStringAndDbKey()).arg(cached.candidates.size())); }
             }
             else
             {
-                CAircraftMatcherSetup::PickSimilarStrategy usedStrategy = setup.getPickStrategy();
-                switch (usedStrategy)
+                // the reduce steps work on ids, models are only copied for the (remaining) candidates
+                switch (setup.getMatchingAlgorithm())
                 {
-                case CAircraftMatcherSetup::PickRandom:
-                    matchedModel = candidates.randomElement<CAircraftModel>();
+                case CAircraftMatcherSetup::MatchingStepwiseReduce:
+                    candidates = index->toModels(CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(*index, modelSetIds, setup, snapshot.categoryMatcher, remoteAircraft, whatToLog, log));
                     break;
-                case CAircraftMatcherSetup::PickByOrder:
-                    if (!candidates.needsOrder())
+                case CAircraftMatcherSetup::MatchingScoreBased:
+                    candidates = CAircraftMatcher::getClosestMatchScoreImplementation(index->toModels(modelSetIds), setup, remoteAircraft, maxScore, whatToLog, log);
+                    break;
+                case CAircraftMatcherSetup::MatchingStepwiseReducePlusScoreBased:
+                default:
+                    candidates = index->toModels(CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(*index, modelSetIds, setup, snapshot.categoryMatcher, remoteAircraft, whatToLog, log));
+                    candidates = CAircraftMatcher::getClosestMatchScoreImplementation(candidates, setup, remoteAircraft, maxScore, whatToLog, log);
+                    break;
+                }
+
+                if (candidates.isEmpty())
+                {
+                    matchedModel = CAircraftMatcher::getCombinedTypeDefaultModel(*index, modelSetIds, remoteAircraft, snapshot.defaultModel, whatToLog, log);
+                }
+                else
+                {
+                    CAircraftMatcherSetup::PickSimilarStrategy usedStrategy = setup.getPickStrategy();
+                    switch (usedStrategy)
                     {
-                        matchedModel = candidates.minOrderOrDefault();
+                    case CAircraftMatcherSetup::PickRandom:
+                        matchedModel = candidates.randomElement<CAircraftModel>();
+                        break;
+                    case CAircraftMatcherSetup::PickByOrder:
+                        if (!candidates.needsOrder())
+                        {
+                            matchedModel = candidates.minOrderOrDefault();
+                            break;
+                        }
+                        Q_FALLTHROUGH();
+                    case CAircraftMatcherSetup::PickFirst: // fallthru intentionally
+                    default:
+                        usedStrategy = CAircraftMatcherSetup::PickFirst; // re-assigned if fall-through
+                        matchedModel = candidates.front();
                         break;
                     }
-                    Q_FALLTHROUGH();
-                case CAircraftMatcherSetup::PickFirst: // fallthru intentionally
-                default:
-                    usedStrategy = CAircraftMatcherSetup::PickFirst; // re-assigned if fall-through
-                    matchedModel = candidates.front();
-                    break;
+
+                    if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("Picking among %1 by strategy '%2'").arg(candidates.size()).arg(CAircraftMatcherSetup::strategyToString(usedStrategy))); }
                 }
 
-                if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("Picking among %1 by strategy '%2'").arg(candidates.size()).arg(CAircraftMatcherSetup::strategyToString(usedStrategy))); }
+                if (snapshot.resultCache && matchedModel.hasModelString())
+                {
+                    snapshot.resultCache->insert(remoteAircraft.getModel(), snapshot.setupHash, snapshot.modelSetRevision, matchedModel, candidates);
+                }
             }
         }
 
@@ -403,7 +460,7 @@ namespace BlackCore
         if (useMatchingScript && setup.doRunMsMatchingStageScript())
         {
             CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("Matching script: Matching stage script used"));
-            const MatchingScriptReturnValues rv = CAircraftMatcher::matchingStageScript(remoteAircraft.getModel(), matchedModel, setup, modelSet, log);
+            const MatchingScriptReturnValues rv = CAircraftMatcher::matchingStageScript(remoteAircraft.getModel(), matchedModel, setup, index->toModels(modelSetIds), log);
             CAircraftModel matchedModelMs = matchedModel;
 
             if (rv.runScriptAndModified())
@@ -420,7 +477,7 @@ namespace BlackCore
                 CSimulatedAircraft rerunAircraft(remoteAircraft);
                 rerunAircraft.setModel(matchedModelMs);
                 CStatusMessageList log2ndRun;
-                matchedModelMs = CAircraftMatcher::getClosestMatch(rerunAircraft, whatToLog, log ? &log2ndRun : nullptr, false);
+                matchedModelMs = CAircraftMatcher::getClosestMatch(snapshot, rerunAircraft, whatToLog, log ? &log2ndRun : nullptr, false);
                 if (log) { log->push_back(log2ndRun); }
 
                 // the script can fuckup the model, leading to an empty model string or such
@@ -448,7 +505,7 @@ namespace BlackCore
         if (!matchedModel.hasModelString())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("All matching yielded no result, VERY odd...")); }
-            CAircraftModel defaultModel = this->getDefaultModel();
+            CAircraftModel defaultModel = snapshot.defaultModel;
             if (defaultModel.hasModelString())
             {
                 matchedModel = defaultModel;
@@ -508,7 +565,7 @@ namespace BlackCore
     {
         if (!setup.doRunMsReverseLookupScript()) { return MatchingScriptReturnValues(inModel); }
         if (!sApp || sApp->isShuttingDown() || !sApp->hasWebDataServices()) { return inModel; }
-        const QString js = CFileUtils::readFileToString(setup.getMsReverseLookupFile());
+        const QString js = CMatchingScriptEngine::threadEngine().scriptForFile(ReverseLookup, setup.getMsReverseLookupFile());
         const MatchingScriptReturnValues rv = CAircraftMatcher::matchingScript(js, inModel, inModel, setup, modelSet, ReverseLookup, log);
         return rv;
     }
@@ -517,7 +574,7 @@ namespace BlackCore
     {
         if (!setup.doRunMsMatchingStageScript()) { return MatchingScriptReturnValues(inModel); }
         if (!sApp || sApp->isShuttingDown() || !sApp->hasWebDataServices()) { return inModel; }
-        const QString js = CFileUtils::readFileToString(setup.getMsMatchingStageFile());
+        const QString js = CMatchingScriptEngine::threadEngine().scriptForFile(MatchingStage, setup.getMsMatchingStageFile());
         const MatchingScriptReturnValues rv = CAircraftMatcher::matchingScript(js, inModel, matchedModel, setup, modelSet, MatchingStage, log);
         return rv;
     }
@@ -526,6 +583,7 @@ namespace BlackCore
     {
         MatchingScriptReturnValues rv(inModel);
         QString logMessage;
+        QString timingMessage;
         const CCallsign callsign = inModel.getCallsign();
 
         if (js.isEmpty() && log) { CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("Matching script is empty")); }
@@ -547,48 +605,46 @@ namespace BlackCore
                 CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("Matching script models: %1").arg(modelSet.coverageSummary()));
             }
 
-            QJSEngine engine;
-            // engine.installExtensions(QJSEngine::ConsoleExtension);
-
-            // Meta objects to create new JS objects, here causing JSValue can't be reassigned to another engine.
-            // static const QJSValue jsInOutMetaObject = engine.newQMetaObject(&MSInOutValues::staticMetaObject);
-            // engine.globalObject().setProperty("SwiftInOutObject", jsInOutMetaObject); // JS: new SwiftInOutObject();
-            // static const QJSValue jsSetMetaObject = engine.newQMetaObject(&MSModelSet::staticMetaObject);
-            // engine.globalObject().setProperty("SwiftModelSet", jsSetMetaObject); // JS: new SwiftModelSet
-            // static const QJSValue jsWebServicesMetaObject = engine.newQMetaObject(&MSWebServices::staticMetaObject);
-            // engine.globalObject().setProperty("SwiftWebServices", jsWebServicesMetaObject); // JS: new SwiftWebServices
+            // pooled engine of this thread, script only compiled if changed
+            QElapsedTimer timer;
+            timer.start();
+            CMatchingScriptEngine &msEngine = CMatchingScriptEngine::threadEngine();
+            QJSEngine &engine = msEngine.engine();
+            bool compiled = false;
+            QJSValue msFunction = msEngine.scriptFunction(script, js, msReverse ? logFileR : logFileM, compiled);
+            const qint64 compileNs = timer.nsecsElapsed();
 
             // init models and set
-            MSInOutValues inObject(inModel);
-            MSInOutValues matchedObject(matchedModel); // same as inModel for reverse lookup
-            matchedObject.evaluateChanges(inModel.getAircraftIcaoCode(), inModel.getAirlineIcaoCode());
-            MSInOutValues outObject(matchedModel);     // set default values for out object
-            MSModelSet modelSetObject(modelSet);       // as passed
-            modelSetObject.initByAircraftAndAirline(inModel.getAircraftIcaoCode(), inModel.getAirlineIcaoCode());
-            MSWebServices webServices; // web services encapsulated
+            // created with JavaScript ownership, the engine deletes them
+            timer.start();
+            MSInOutValues *inObject = new MSInOutValues(inModel);
+            MSInOutValues *matchedObject = new MSInOutValues(matchedModel); // same as inModel for reverse lookup
+            matchedObject->evaluateChanges(inModel.getAircraftIcaoCode(), inModel.getAirlineIcaoCode());
+            MSInOutValues *outObject = new MSInOutValues(matchedModel);     // set default values for out object
+            MSModelSet *modelSetObject = new MSModelSet(modelSet);          // as passed
+            modelSetObject->initByAircraftAndAirline(inModel.getAircraftIcaoCode(), inModel.getAirlineIcaoCode());
 
             // object as from network
-            const QJSValue jsInObject = engine.newQObject(&inObject);
-            engine.globalObject().setProperty("inObject", jsInObject);
+            engine.globalObject().setProperty("inObject", engine.newQObject(inObject));
 
             // object that will be returned
-            const QJSValue jsOutObject = engine.newQObject(&outObject);
-            engine.globalObject().setProperty("outObject", jsOutObject);
+            engine.globalObject().setProperty("outObject", engine.newQObject(outObject));
 
             // object as matched so far, same as inObject in reverse lookup
-            const QJSValue jsMatchedObject = engine.newQObject(&matchedObject);
-            engine.globalObject().setProperty("matchedObject", jsMatchedObject);
+            engine.globalObject().setProperty("matchedObject", engine.newQObject(matchedObject));
 
             // wrapper for model set
-            const QJSValue jsModelSetObject = engine.newQObject(&modelSetObject);
-            engine.globalObject().setProperty("modelSet", jsModelSetObject);
+            engine.globalObject().setProperty("modelSet", engine.newQObject(modelSetObject));
+            const qint64 setupNs = timer.nsecsElapsed();
 
-            // wrapper for web services
-            const QJSValue jsWebServices = engine.newQObject(&webServices);
-            engine.globalObject().setProperty("webServices", jsWebServices);
-
-            QJSValue ms = engine.evaluate(js, msReverse ? logFileR : logFileM);
-            ms = ms.call();
+            timer.start();
+            QJSValue ms = msFunction.isError() ? msFunction : msFunction.call();
+            const qint64 runNs = timer.nsecsElapsed();
+            if (log)
+            {
+                static const QString tm("Matching script timing: compile %1ms%2, setup %3ms, run %4ms");
+                timingMessage = tm.arg(compileNs / 1.0e6, 0, 'f', 2).arg(compiled ? QString() : QStringLiteral(" (cached)")).arg(setupNs / 1.0e6, 0, 'f', 2).arg(runNs / 1.0e6, 0, 'f', 2);
+            }
             if (ms.isError())
             {
                 const QString msg = QStringLiteral("Matching script error: %1 '%2'").arg(ms.property("lineNumber").toInt()).arg(ms.toString());
@@ -692,6 +748,7 @@ namespace BlackCore
         }
 
         // log message
+        if (log && !timingMessage.isEmpty()) { CCallsign::addLogDetailsToList(log, callsign, timingMessage); }
         if (log && !logMessage.isEmpty()) { CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("Matching script log: '%1'").arg(logMessage)); }
 
         // end
@@ -1257,11 +1314,17 @@ namespace BlackCore
         const int r1 = modelsCleaned.removeAllWithoutModelString();
         const int r2 = modelsCleaned.removeIfExcluded();
 
-        // sane simulator and model count? (minor risk of not updating when a model was changed)
-        if (!forced && m_simulator == simulator && m_modelSet.size() == modelsCleaned.size())
+        // same simulator, only the changes are applied
+        // disabled models are not part of the set, so they are no change
+        CModelSetChanges changes;
+        if (!forced && m_simulator == simulator)
         {
-            return m_modelSet.size();
+            CAircraftModelList modelsEnabled(modelsCleaned);
+            modelsEnabled.removeModelsWithString(m_disabledModels, Qt::CaseInsensitive);
+            changes = CModelSetChanges::diff(m_modelSet, modelsEnabled);
+            if (changes.isEmpty()) { return m_modelSet.size(); }
         }
+        const bool incremental = !forced && m_simulator == simulator && !changes.isReplacement();
 
         QString warnings;
         if ((r1 + r2) > 0)
@@ -1286,42 +1349,136 @@ namespace BlackCore
         {
             CLogMessage(this).validationWarning(warnings);
         }
+        else if (incremental)
+        {
+            CLogMessage(this).validationInfo(u"Changed models in matcher (%1), simulator '%2'") << changes.toQString() << simulator.toQString();
+        }
         else
         {
             CLogMessage(this).validationInfo(u"Set %1 models in matcher, simulator '%2'") << modelsCleaned.size() << simulator.toQString();
         }
 
-        // set values
+        if (incremental)
+        {
+            this->applyModelSetChanges(changes);
+            m_modelSetInfo = QStringLiteral("Set: '%1' entries: %2").arg(simulator.toQString()).arg(m_modelSet.size());
+            return models.size();
+        }
+
+        // set values, models received via DBus or JSON do not share their ICAO codes, liveries and distributors
+        CAircraftModelInterner::internModels(modelsCleaned);
         m_modelSet  = modelsCleaned;
+        this->updateModelSetIndex();
         m_simulator = simulator;
         m_modelSetInfo = QStringLiteral("Set: '%1' entries: %2").arg(simulator.toQString()).arg(modelsCleaned.size());
         return models.size();
     }
 
-    void CAircraftMatcher::disableModelsForMatching(const CAircraftModelList &removedModels, bool incremental)
+    int CAircraftMatcher::applyModelSetChanges(const CModelSetChanges &changes)
     {
-        if (incremental)
+        if (changes.isEmpty()) { return m_modelSet.size(); }
+        if (changes.isReplacement()) { return this->setModelSet(changes.getAdded(), m_simulator, true); }
+
+        // same filtering as in setModelSet
+        QSet<QString> disabled;
+        for (const CAircraftModel &model : m_disabledModels) { disabled.insert(model.getModelString().toUpper()); }
+        const auto isUsable = [&disabled](const CAircraftModel & model)
+        {
+            return model.hasModelString() && model.getModelMode() != CAircraftModel::Exclude && !disabled.contains(model.getModelString().toUpper());
+        };
+
+        // like in setModelSet, the models share their ICAO codes, liveries and distributors
+        CAircraftModelList updated = changes.getUpdated();
+        CAircraftModelList added = changes.getAdded();
+        CAircraftModelInterner::internModels(updated);
+        CAircraftModelInterner::internModels(added);
+
+        CModelSetChanges usedChanges;
+        for (const QString &modelString : changes.getRemoved()) { usedChanges.removeModel(modelString); }
+        for (const CAircraftModel &model : as_const(updated))
         {
-            m_modelSet.removeModelsWithString(removedModels, Qt::CaseInsensitive);
-            m_disabledModels.push_back(removedModels);
+            if (isUsable(model)) { usedChanges.updateModel(model); }
+            else if (model.hasModelString()) { usedChanges.removeModel(model.getModelString()); }
         }
-        else
+        for (const CAircraftModel &model : as_const(added))
+        {
+            if (!isUsable(model)) { continue; }
+            usedChanges.removeModel(model.getModelString()); // no duplicates if already in the set
+            usedChanges.addModel(model);
+        }
+
+        this->applyChangesToModelSet(usedChanges);
+        return m_modelSet.size();
+    }
+
+    void CAircraftMatcher::disableModelsForMatching(const CAircraftModelList &removedModels, bool incremental)
+    {
+        if (!incremental)
         {
             this->restoreDisabledModels();
-            m_disabledModels = removedModels;
-            m_modelSet.removeModelsWithString(removedModels, Qt::CaseInsensitive);
+            m_disabledModels.clear();
         }
+
+        CModelSetChanges changes;
+        for (const CAircraftModel &model : removedModels) { changes.removeModel(model.getModelString()); }
+        m_disabledModels.push_back(removedModels);
+        this->applyChangesToModelSet(changes);
     }
 
     void CAircraftMatcher::restoreDisabledModels()
     {
-        m_modelSet.replaceOrAddModelsWithString(m_disabledModels, Qt::CaseInsensitive);
+        // like replaceOrAddModelsWithString: existing models are removed, all are appended
+        CModelSetChanges changes;
+        for (const CAircraftModel &model : m_disabledModels)
+        {
+            changes.removeModel(model.getModelString());
+            changes.addModel(model);
+        }
+        this->applyChangesToModelSet(changes);
+    }
+
+    void CAircraftMatcher::updateModelSetIndex()
+    {
+        m_modelSetIndex = std::make_shared<const CAircraftModelSetIndex>(m_modelSet);
+
+        // results of snapshots taken before are still inserted, but with the old revision they are never found
+        m_modelSetRevision++;
+        m_resultCache->clear();
+    }
+
+    void CAircraftMatcher::applyChangesToModelSet(const CModelSetChanges &changes)
+    {
+        if (changes.isEmpty()) { return; }
+        changes.applyTo(m_modelSet);
+        m_modelSetIndex = std::make_shared<const CAircraftModelSetIndex>(m_modelSetIndex->withChanges(changes));
+        m_modelSetInfo = QStringLiteral("Set: '%1' entries: %2").arg(m_simulator.toQString()).arg(m_modelSet.size());
+
+        // any cached result can be affected, a changed or added model can be a better match
+        m_modelSetRevision++;
+        m_resultCache->clear();
     }
 
     void CAircraftMatcher::setDefaultModel(const CAircraftModel &defaultModel)
     {
         m_defaultModel = defaultModel;
         m_defaultModel.setModelType(CAircraftModel::TypeModelMatchingDefaultModel);
+
+        // the default model can be a cached result
+        m_modelSetRevision++;
+        m_resultCache->clear();
+    }
+
+    CMatchingStatistics CAircraftMatcher::getCurrentStatistics() const
+    {
+        CMatchingStatistics statistics = m_statistics;
+        m_resultCache->addToStatistics(statistics, {}, m_modelSetInfo);
+        return statistics;
+    }
+
+    void CAircraftMatcher::clearMatchingStatistics()
+    {
+        m_statistics.clear();
+        m_resultCache->clearStatistics();
     }
 
     void CAircraftMatcher::evaluateStatisticsEntry(const QString &sessionId, const CCallsign &callsign, const QString &aircraftIcao, const QString &airlineIcao, const QString &livery)
@@ -1392,10 +1549,9 @@ namespace BlackCore
         return CFileUtils::writeStringToFile(json, CFileUtils::appendFilePathsAndFixUnc(CSwiftDirectories::logDirectory(), QStringLiteral("removed models %1.json").arg(ts)));
     }
 
-    CAircraftModelList CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(const CAircraftModelList &modelSet, const CAircraftMatcherSetup &setup, const CCategoryMatcher &categoryMatcher, const CSimulatedAircraft &remoteAircraft, MatchingLog whatToLog, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(const CAircraftModelSetIndex &index, const ModelIds &modelSetIds, const CAircraftMatcherSetup &setup, const CCategoryMatcher &categoryMatcher, const CSimulatedAircraft &remoteAircraft, MatchingLog whatToLog, CStatusMessageList *log)
     {
-        CAircraftModelList matchedModels(modelSet);
-        CAircraftModel matchedModel(remoteAircraft.getModel());
+        ModelIds matchedIds(modelSetIds);
         Q_UNUSED(whatToLog)
 
         const CAircraftMatcherSetup::MatchingMode mode = setup.getMatchingMode();
@@ -1406,7 +1562,7 @@ namespace BlackCore
             // by livery, then by ICAO
             if (mode.testFlag(CAircraftMatcherSetup::ByLivery))
             {
-                matchedModels = ifPossibleReduceByLiveryAndAircraftIcaoCode(remoteAircraft, matchedModels, reduced, log);
+                matchedIds = ifPossibleReduceByLiveryAndAircraftIcaoCode(remoteAircraft, index, matchedIds, reduced, log);
                 if (reduced) { break; } // almost perfect, we stop here (we have ICAO + livery match)
             }
             else if (reduceLog)
@@ -1418,7 +1574,7 @@ namespace BlackCore
             {
                 // by airline/aircraft or by aircraft/airline depending on setup
                 // family is also considered
-                matchedModels = ifPossibleReduceByIcaoData(remoteAircraft, matchedModels, setup, reduced, log);
+                matchedIds = ifPossibleReduceByIcaoData(remoteAircraft, index, matchedIds, setup, reduced, log);
             }
             else if (reduceLog)
             {
@@ -1428,7 +1584,7 @@ namespace BlackCore
                 if (mode.testFlag(CAircraftMatcherSetup::ByFamily))
                 {
                     QString usedFamily;
-                    matchedModels = ifPossibleReduceByFamily(remoteAircraft, UsePseudoFamily, matchedModels, reduced, usedFamily, log);
+                    matchedIds = ifPossibleReduceByFamily(remoteAircraft, UsePseudoFamily, index, matchedIds, reduced, usedFamily, log);
                     if (reduced) { break; }
                 }
                 else if (reduceLog)
@@ -1439,7 +1595,9 @@ namespace BlackCore
 
             if (setup.useCategoryMatching())
             {
-                matchedModels = categoryMatcher.reduceByCategories(matchedModels, modelSet, setup, remoteAircraft, reduced, whatToLog, log);
+                // category matcher works on lists, only materialized when used
+                const CAircraftModelList categoryModels = categoryMatcher.reduceByCategories(index.toModels(matchedIds), index.toModels(modelSetIds), setup, remoteAircraft, reduced, whatToLog, log);
+                matchedIds = index.toIds(categoryModels);
                 // ?? break here ??
             }
             else if (reduceLog)
@@ -1448,9 +1606,9 @@ namespace BlackCore
             }
 
             // if not yet reduced, reduce to VTOL
-            if (!reduced && remoteAircraft.isVtol() && matchedModels.containsVtol() && mode.testFlag(CAircraftMatcherSetup::ByVtol))
+            if (!reduced && remoteAircraft.isVtol() && index.containsVtol(matchedIds) && mode.testFlag(CAircraftMatcherSetup::ByVtol))
             {
-                matchedModels = matchedModels.findByVtolFlag(true);
+                matchedIds = index.findByVtolFlag(matchedIds, true);
                 CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("Aircraft is VTOL, reduced to VTOL"), getLogCategories());
             }
 
@@ -1458,20 +1616,20 @@ namespace BlackCore
             bool milFlagReduced = false;
             if (mode.testFlag(CAircraftMatcherSetup::ByMilitary) && remoteAircraft.isMilitary())
             {
-                matchedModels = ifPossibleReduceByMilitaryFlag(remoteAircraft, matchedModels, reduced, reduceLog);
+                matchedIds = ifPossibleReduceByMilitaryFlag(remoteAircraft, index, matchedIds, reduced, reduceLog);
                 milFlagReduced = true;
             }
 
             if (!milFlagReduced && mode.testFlag(CAircraftMatcherSetup::ByCivilian) && !remoteAircraft.isMilitary())
             {
-                matchedModels = ifPossibleReduceByMilitaryFlag(remoteAircraft, matchedModels, reduced, reduceLog);
+                matchedIds = ifPossibleReduceByMilitaryFlag(remoteAircraft, index, matchedIds, reduced, reduceLog);
                 milFlagReduced = true;
             }
 
             // combined code
             if (mode.testFlag(CAircraftMatcherSetup::ByCombinedType))
             {
-                matchedModels = ifPossibleReduceByCombinedType(remoteAircraft, matchedModels, setup, reduced, reduceLog);
+                matchedIds = ifPossibleReduceByCombinedType(remoteAircraft, index, matchedIds, setup, reduced, reduceLog);
                 if (reduced) { break; }
             }
             else if (log)
@@ -1482,12 +1640,12 @@ namespace BlackCore
         while (false);
 
         // here we have a list of possible models, we reduce/refine further
-        if (matchedModels.size() > 1 && mode.testFlag(CAircraftMatcherSetup::ByManufacturer))
+        if (matchedIds.size() > 1 && mode.testFlag(CAircraftMatcherSetup::ByManufacturer))
         {
-            matchedModels = ifPossibleReduceByManufacturer(remoteAircraft, matchedModels, QStringLiteral("2nd trial to reduce by manufacturer. "), reduced, reduceLog);
+            matchedIds = ifPossibleReduceByManufacturer(remoteAircraft, index, matchedIds, QStringLiteral("2nd trial to reduce by manufacturer. "), reduced, reduceLog);
         }
 
-        return matchedModels;
+        return matchedIds;
     }
 
     CAircraftModelList CAircraftMatcher::getClosestMatchScoreImplementation(const CAircraftModelList &modelSet, const CAircraftMatcherSetup &setup, const CSimulatedAircraft &remoteAircraft, int &maxScore, MatchingLog whatToLog, CStatusMessageList *log)
@@ -1497,21 +1655,33 @@ namespace BlackCore
         const bool preferColorLiveries = mode.testFlag(CAircraftMatcherSetup::ScorePreferColorLiveries);
         CStatusMessageList *scoreLog = log && whatToLog.testFlag(MatchingLogScoring) ? log : nullptr;
 
-        // VTOL
-        ScoredModels map;
-        map = modelSet.scoreFull(remoteAircraft.getModel(), preferColorLiveries, noZeroScores, scoreLog);
+        if (scoreLog)
+        {
+            // detailed log of all scores
+            ScoredModels map;
+            map = modelSet.scoreFull(remoteAircraft.getModel(), preferColorLiveries, noZeroScores, scoreLog);
+            if (map.isEmpty()) { return CAircraftModelList(); }
+
+            maxScore = map.lastKey();
+            const CAircraftModelList maxScoreAircraft(map.values(maxScore));
+            CMatchingUtils::addLogDetailsToList(scoreLog, remoteAircraft, QStringLiteral("Scores: %1").arg(scoresToString(map)), getLogCategories());
+            CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("Scoring with score %1 out of %2 models yielded %3 models").arg(maxScore).arg(map.size()).arg(maxScoreAircraft.size()), getLogCategories());
+            return maxScoreAircraft;
+        }
 
-        CAircraftModel matchedModel;
-        if (map.isEmpty()) { return CAircraftModelList(); }
+        // parallel, only the best scores are kept
+        const CAircraftModelScores scores = CAircraftModelScoring::scoreTopK(modelSet, remoteAircraft.getModel(), preferColorLiveries, noZeroScores);
+        if (scores.isEmpty()) { return CAircraftModelList(); }
 
-        maxScore = map.lastKey();
-        const CAircraftModelList maxScoreAircraft(map.values(maxScore));
-        CMatchingUtils::addLogDetailsToList(scoreLog, remoteAircraft, QStringLiteral("Scores: %1").arg(scoresToString(map)), getLogCategories());
-        CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("Scoring with score %1 out of %2 models yielded %3 models").arg(maxScore).arg(map.size()).arg(maxScoreAircraft.size()), getLogCategories());
+        // same order as QMap::values of the score map, last scored model first
+        maxScore = scores.maxScore;
+        CAircraftModelList maxScoreAircraft;
+        for (auto it = scores.maxScoreIds.crbegin(); it != scores.maxScoreIds.crend(); ++it) { maxScoreAircraft.push_back(modelSet[*it]); }
+        if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("Scoring with score %1 out of %2 models (%3 skipped) yielded %4 models").arg(maxScore).arg(scores.scored).arg(scores.pruned).arg(maxScoreAircraft.size()), getLogCategories()); }
         return maxScoreAircraft;
     }
 
-    CAircraftModel CAircraftMatcher::getCombinedTypeDefaultModel(const CAircraftModelList &modelSet, const CSimulatedAircraft &remoteAircraft, const CAircraftModel &defaultModel, MatchingLog whatToLog, CStatusMessageList *log)
+    CAircraftModel CAircraftMatcher::getCombinedTypeDefaultModel(const CAircraftModelSetIndex &index, const ModelIds &modelSetIds, const CSimulatedAircraft &remoteAircraft, const CAircraftModel &defaultModel, MatchingLog whatToLog, CStatusMessageList *log)
     {
         const QString combinedType = remoteAircraft.getAircraftIcaoCombinedType();
         CStatusMessageList *combinedLog = log && whatToLog.testFlag(MatchingLogCombinedDefaultType) ? log : nullptr;
@@ -1521,34 +1691,35 @@ namespace BlackCore
             CMatchingUtils::addLogDetailsToList(combinedLog, remoteAircraft, QStringLiteral("No combined type, using default"), getLogCategories(), CStatusMessage::SeverityInfo);
             return defaultModel;
         }
-        if (modelSet.isEmpty())
+        if (modelSetIds.isEmpty())
         {
             CMatchingUtils::addLogDetailsToList(combinedLog, remoteAircraft, QStringLiteral("No models, using default"), getLogCategories(), CStatusMessage::SeverityError);
             return defaultModel;
         }
 
         CMatchingUtils::addLogDetailsToList(combinedLog, remoteAircraft, u"Searching by combined type with color livery '" % combinedType % "'", getLogCategories());
-        CAircraftModelList matchedModels = modelSet.findByCombinedTypeWithColorLivery(combinedType);
-        if (!matchedModels.isEmpty())
+        const ModelIds byCombinedType = index.findByCombinedType(modelSetIds, combinedType);
+        ModelIds matchedIds = index.findColorLiveries(byCombinedType);
+        if (!matchedIds.isEmpty())
         {
-            CMatchingUtils::addLogDetailsToList(combinedLog, remoteAircraft, u"Found " % QString::number(matchedModels.size()) % u" by combined type w/color livery '" % combinedType % "'", getLogCategories());
+            CMatchingUtils::addLogDetailsToList(combinedLog, remoteAircraft, u"Found " % QString::number(matchedIds.size()) % u" by combined type w/color livery '" % combinedType % "'", getLogCategories());
         }
         else
         {
             CMatchingUtils::addLogDetailsToList(combinedLog, remoteAircraft, u"Searching by combined type '" % combinedType % "'", getLogCategories());
-            matchedModels = matchedModels.findByCombinedType(combinedType);
-            if (!matchedModels.isEmpty())
+            matchedIds = byCombinedType;
+            if (!matchedIds.isEmpty())
             {
-                CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found " % QString::number(matchedModels.size()) % u" by combined '" % combinedType % "'", getLogCategories());
+                CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found " % QString::number(matchedIds.size()) % u" by combined '" % combinedType % "'", getLogCategories());
             }
         }
 
         // return
-        if (matchedModels.isEmpty()) { return defaultModel; }
-        return matchedModels.front();
+        if (matchedIds.isEmpty()) { return defaultModel; }
+        return index.getModel(matchedIds.front());
     }
 
-    CAircraftModel CAircraftMatcher::matchByExactModelString(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &models, MatchingLog whatToLog, CStatusMessageList *log)
+    CAircraftModel CAircraftMatcher::matchByExactModelString(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, MatchingLog whatToLog, CStatusMessageList *log)
     {
         CStatusMessageList *msLog = log && whatToLog.testFlag(MatchingLogModelstring) ? log : nullptr;
         if (remoteAircraft.getModelString().isEmpty())
@@ -1557,7 +1728,8 @@ namespace BlackCore
             return CAircraftModel();
         }
 
-        CAircraftModel model = models.findFirstByModelStringAliasOrDefault(remoteAircraft.getModelString());
+        const int id = index.findFirstByModelStringOrAlias(remoteAircraft.getModelString());
+        CAircraftModel model = id >= 0 ? index.getModel(id) : CAircraftModel();
         if (msLog)
         {
             if (model.hasModelString())
@@ -1574,37 +1746,38 @@ namespace BlackCore
         return model;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByLiveryAndAircraftIcaoCode(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, bool &reduced, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::ifPossibleReduceByLiveryAndAircraftIcaoCode(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inIds, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         if (!remoteAircraft.getLivery().hasCombinedCode())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("No livery code, no reduction possible"), getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
-        const CAircraftModelList byLivery(
-            inList.findByAircraftDesignatorAndLiveryCombinedCode(
-                remoteAircraft.getLivery().getCombinedCode(),
-                remoteAircraft.getAircraftIcaoCodeDesignator()
+        const ModelIds byLivery(
+            index.findByAircraftDesignatorAndLiveryCombinedCode(
+                inIds,
+                remoteAircraft.getAircraftIcaoCodeDesignator(),
+                remoteAircraft.getLivery().getCombinedCode()
             ));
 
         if (byLivery.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Not found by livery code " % remoteAircraft.getLivery().getCombinedCode(), getLogCategories()); }
-            return inList;
+            return inIds;
         }
         reduced = true;
         return byLivery;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByIcaoData(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const CAircraftMatcherSetup &setup, bool &reduced, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::ifPossibleReduceByIcaoData(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inIds, const CAircraftMatcherSetup &setup, bool &reduced, CStatusMessageList *log)
     {
         const CAircraftMatcherSetup::MatchingMode mode = setup.getMatchingMode();
-        if (inList.isEmpty())
+        if (inIds.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("Empty list, skipping step"), getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
         reduced = false;
@@ -1612,17 +1785,17 @@ namespace BlackCore
         {
             bool r1 = false;
             bool r2 = false;
-            CAircraftModelList models = ifPossibleReduceByAirline(remoteAircraft, inList, setup, QStringLiteral("Reduce by airline first."), r1, log);
-            models = ifPossibleReduceByAircraftOrFamily(remoteAircraft, UsePseudoFamily, models, setup, QStringLiteral("Reduce by aircraft ICAO second."), r2, log);
+            ModelIds ids = ifPossibleReduceByAirline(remoteAircraft, index, inIds, setup, QStringLiteral("Reduce by airline first."), r1, log);
+            ids = ifPossibleReduceByAircraftOrFamily(remoteAircraft, UsePseudoFamily, index, ids, setup, QStringLiteral("Reduce by aircraft ICAO second."), r2, log);
             reduced = r1 || r2;
-            if (reduced) { return models; }
+            if (reduced) { return ids; }
         }
         else if (mode.testFlag(CAircraftMatcherSetup::ByIcaoData))
         {
             bool r1 = false;
             bool r2 = false;
-            CAircraftModelList models = ifPossibleReduceByAircraftOrFamily(remoteAircraft, UsePseudoFamily, inList, setup, QStringLiteral("Reduce by aircraft ICAO first."), r1, log);
-            models = ifPossibleReduceByAirline(remoteAircraft, models, setup, QStringLiteral("Reduce aircraft ICAO by airline second."), r2, log);
+            ModelIds ids = ifPossibleReduceByAircraftOrFamily(remoteAircraft, UsePseudoFamily, index, inIds, setup, QStringLiteral("Reduce by aircraft ICAO first."), r1, log);
+            ids = ifPossibleReduceByAirline(remoteAircraft, index, ids, setup, QStringLiteral("Reduce aircraft ICAO by airline second."), r2, log);
 
             // not finding anything so far means we have no valid aircraft/airline ICAO combination
             // but it can happen we found B738, and for DLH there is no B738 but B737, so we search again
@@ -1636,13 +1809,13 @@ namespace BlackCore
 
                 bool r3 = false;
                 QString usedFamily;
-                CAircraftModelList models2nd = ifPossibleReduceByFamily(remoteAircraft, UsePseudoFamily, inList, r3, usedFamily, log);
-                models2nd = ifPossibleReduceByAirline(remoteAircraft, models2nd, setup, "Reduce family by airline second.", r3, log);
+                ModelIds ids2nd = ifPossibleReduceByFamily(remoteAircraft, UsePseudoFamily, index, inIds, r3, usedFamily, log);
+                ids2nd = ifPossibleReduceByAirline(remoteAircraft, index, ids2nd, setup, "Reduce family by airline second.", r3, log);
                 if (r3)
                 {
                     // we found family / airline combination
-                    if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found " % QString::number(models2nd.sizeInt()) % " aircraft family/airline '" % usedFamily % u"' combination", getLogCategories()); }
-                    return models2nd;
+                    if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found " % QString::number(ids2nd.size()) % " aircraft family/airline '" % usedFamily % u"' combination", getLogCategories()); }
+                    return ids2nd;
                 }
             }
 
@@ -1650,109 +1823,108 @@ namespace BlackCore
             if (reduced)
             {
                 if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Reduced by aircraft ICAO: " % boolToYesNo(r1) % u" airline: " % boolToYesNo(r2), getLogCategories()); }
-                return models;
+                return ids;
             }
         }
 
         if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("No reduction by ICAO data"), getLogCategories()); }
-        return inList;
+        return inIds;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByFamily(const CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const CAircraftModelList &inList, bool &reduced, QString &usedFamily, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::ifPossibleReduceByFamily(const CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const CAircraftModelSetIndex &index, const ModelIds &inIds, bool &reduced, QString &usedFamily, CStatusMessageList *log)
     {
         reduced = false;
         usedFamily = remoteAircraft.getAircraftIcaoCode().getFamily();
         if (!usedFamily.isEmpty())
         {
-            CAircraftModelList matchedModels = ifPossibleReduceByFamily(remoteAircraft, usedFamily, allowPseudoFamily, inList, QStringLiteral("real family from ICAO"), reduced, log);
-            if (reduced) { return matchedModels; }
+            const ModelIds matchedIds = ifPossibleReduceByFamily(remoteAircraft, usedFamily, allowPseudoFamily, index, inIds, QStringLiteral("real family from ICAO"), reduced, log);
+            if (reduced) { return matchedIds; }
         }
 
         // scenario: the ICAO actually is the family
         usedFamily = remoteAircraft.getAircraftIcaoCodeDesignator();
-        return ifPossibleReduceByFamily(remoteAircraft, usedFamily, allowPseudoFamily, inList, QStringLiteral("ICAO treated as family"), reduced, log);
+        return ifPossibleReduceByFamily(remoteAircraft, usedFamily, allowPseudoFamily, index, inIds, QStringLiteral("ICAO treated as family"), reduced, log);
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByFamily(const CSimulatedAircraft &remoteAircraft, const QString &family, bool allowPseudoFamily, const CAircraftModelList &inList, const QString &hint, bool &reduced, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::ifPossibleReduceByFamily(const CSimulatedAircraft &remoteAircraft, const QString &family, bool allowPseudoFamily, const CAircraftModelSetIndex &index, const ModelIds &inIds, const QString &hint, bool &reduced, CStatusMessageList *log)
     {
         // Use an algorithm to find the best match
         reduced = false;
         if (family.isEmpty() && !allowPseudoFamily)
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"No family, skipping step (" % hint % u")", getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
-        if (inList.isEmpty())
+        if (inIds.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"No models for family match (" % hint % u")", getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
-        CAircraftModelList foundByFamily(inList.findByFamily(family));
+        const ModelIds foundByFamily = CAircraftModelSetIndex::intersect(inIds, index.findByFamily(family));
         if (foundByFamily.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Not found by family '" % family % u"' (" % hint % ")"); }
-            if (!allowPseudoFamily) { return inList; }
+            if (!allowPseudoFamily) { return inIds; }
             // fallthru
         }
         else
         {
-            if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by family '" % family % u"' (" % hint % u") size " % QString::number(foundByFamily.sizeInt()), getLogCategories()); }
+            if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by family '" % family % u"' (" % hint % u") size " % QString::number(foundByFamily.size()), getLogCategories()); }
         }
 
-        CAircraftModelList foundByCM;
+        ModelIds foundByCM;
         if (allowPseudoFamily)
         {
-            foundByCM = inList.findByCombinedAndManufacturer(remoteAircraft.getAircraftIcaoCode());
-            const QString pseudo = remoteAircraft.getAircraftIcaoCode().getCombinedType() % "/" % remoteAircraft.getAircraftIcaoCode().getManufacturer();
+            const CAircraftIcaoCode &icao = remoteAircraft.getAircraftIcaoCode();
+            foundByCM = index.findByCombinedAndManufacturer(inIds, icao.getCombinedType(), icao.getManufacturer());
+            const QString pseudo = icao.getCombinedType() % "/" % icao.getManufacturer();
             if (foundByCM.isEmpty())
             {
                 if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Not found by pseudo family '" % pseudo % u"' (" % hint % ")"); }
             }
             else
             {
-                if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by pseudo family '" % pseudo % u"' (" % hint % u") size " % QString::number(foundByCM.sizeInt()), getLogCategories()); }
+                if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by pseudo family '" % pseudo % u"' (" % hint % u") size " % QString::number(foundByCM.size()), getLogCategories()); }
             }
         }
 
-        if (foundByCM.isEmpty() && foundByFamily.isEmpty()) { return inList; }
+        if (foundByCM.isEmpty() && foundByFamily.isEmpty()) { return inIds; }
         reduced = true;
 
-        // avoid dpulicates, then add
-        if (!foundByFamily.isEmpty()) { foundByCM.removeModelsWithString(foundByFamily.getModelStringList(), Qt::CaseInsensitive); }
-        foundByFamily.push_back(foundByCM);
-
-        if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by family (totally) '" % family % u"' (" % hint % u") size " % QString::number(foundByFamily.sizeInt()), getLogCategories()); }
-        return foundByFamily;
+        // avoid duplicates, then add
+        const ModelIds found = CAircraftModelSetIndex::appendMissing(foundByFamily, foundByCM);
+        if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by family (totally) '" % family % u"' (" % hint % u") size " % QString::number(found.size()), getLogCategories()); }
+        return found;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByManufacturer(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const QString &info, bool &reduced, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::ifPossibleReduceByManufacturer(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inIds, const QString &info, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
-        if (inList.isEmpty())
+        if (inIds.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Empty input list, cannot reduce", getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
         const QString m = remoteAircraft.getAircraftIcaoCode().getManufacturer();
         if (m.isEmpty())
         {
-            if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" No manufacturer, cannot reduce " % QString::number(inList.size()) %  u" entries", getLogCategories()); }
-            return inList;
+            if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" No manufacturer, cannot reduce " % QString::number(inIds.size()) %  u" entries", getLogCategories()); }
+            return inIds;
         }
 
-        const CAircraftModelList outList(inList.findByManufacturer(m));
-        if (outList.isEmpty())
+        const ModelIds outIds = CAircraftModelSetIndex::intersect(inIds, index.findByManufacturer(m));
+        if (outIds.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Not found '" % m % u"', cannot reduce", getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
-        if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Reduced by '" % m % u"' results: " % QString::number(outList.size()), getLogCategories()); }
+        if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Reduced by '" % m % u"' results: " % QString::number(outIds.size()), getLogCategories()); }
         reduced = true;
-        return outList;
+        return outIds;
     }
 
     CAircraftIcaoCodeList CAircraftMatcher::ifPossibleReduceAircraftIcaoByManufacturer(const CAircraftIcaoCode &icaoCode, const CAircraftIcaoCodeList &inList, const QString &info, bool &reduced, const CCallsign &logCallsign, CStatusMessageList *log)
@@ -1783,87 +1955,87 @@ namespace BlackCore
         return outList;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByAircraft(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const QString &info, bool &reduced, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::ifPossibleReduceByAircraft(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inIds, const QString &info, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
-        if (inList.isEmpty())
+        if (inIds.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % " Empty input list, cannot reduce", getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
         if (!remoteAircraft.hasAircraftDesignator())
         {
-            if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % " No aircraft designator, cannot reduce " % QString::number(inList.size()) %  " entries", getLogCategories()); }
-            return inList;
+            if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % " No aircraft designator, cannot reduce " % QString::number(inIds.size()) %  " entries", getLogCategories()); }
+            return inIds;
         }
 
-        const CAircraftModelList outList(inList.findByIcaoDesignators(remoteAircraft.getAircraftIcaoCode(), CAirlineIcaoCode::null()));
-        if (outList.isEmpty())
+        const ModelIds outIds = CAircraftModelSetIndex::intersect(inIds, index.findByAircraftDesignator(remoteAircraft.getAircraftIcaoCodeDesignator()));
+        if (outIds.isEmpty())
         {
-            if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Cannot reduce by '" % remoteAircraft.getAircraftIcaoCodeDesignator() % u"' results: " % QString::number(outList.size()), getLogCategories()); }
-            return inList;
+            if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Cannot reduce by '" % remoteAircraft.getAircraftIcaoCodeDesignator() % u"' results: " % QString::number(outIds.size()), getLogCategories()); }
+            return inIds;
         }
 
-        if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Reduced by '" % remoteAircraft.getAircraftIcaoCodeDesignator() % u"' to " % QString::number(outList.size()), getLogCategories()); }
+        if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Reduced by '" % remoteAircraft.getAircraftIcaoCodeDesignator() % u"' to " % QString::number(outIds.size()), getLogCategories()); }
         reduced = true;
-        return outList;
+        return outIds;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByAircraftOrFamily(const CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const CAircraftModelList &inList,  const CAircraftMatcherSetup &setup, const QString &info, bool &reduced, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::ifPossibleReduceByAircraftOrFamily(const CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const CAircraftModelSetIndex &index, const ModelIds &inIds, const CAircraftMatcherSetup &setup, const QString &info, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
-        const CAircraftModelList outList = ifPossibleReduceByAircraft(remoteAircraft, inList, info, reduced, log);
-        if (reduced || !setup.getMatchingMode().testFlag(CAircraftMatcherSetup::ByFamily)) { return outList; }
+        const ModelIds outIds = ifPossibleReduceByAircraft(remoteAircraft, index, inIds, info, reduced, log);
+        if (reduced || !setup.getMatchingMode().testFlag(CAircraftMatcherSetup::ByFamily)) { return outIds; }
         QString family;
-        return ifPossibleReduceByFamily(remoteAircraft, allowPseudoFamily, inList, reduced, family, log);
+        return ifPossibleReduceByFamily(remoteAircraft, allowPseudoFamily, index, inIds, reduced, family, log);
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByAirline(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const CAircraftMatcherSetup &setup, const QString &info, bool &reduced, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::ifPossibleReduceByAirline(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inIds, const CAircraftMatcherSetup &setup, const QString &info, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
-        if (inList.isEmpty())
+        if (inIds.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Empty input list, cannot reduce", getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
         if (!remoteAircraft.hasAirlineDesignator())
         {
-            if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" No airline designator, cannot reduce " % QString::number(inList.size()) %  u" entries", getLogCategories()); }
-            return inList;
+            if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" No airline designator, cannot reduce " % QString::number(inIds.size()) %  u" entries", getLogCategories()); }
+            return inIds;
         }
 
         CAircraftMatcherSetup::MatchingMode mode = setup.getMatchingMode();
-        CAircraftModelList outList(inList.findByIcaoDesignators(CAircraftIcaoCode::null(), remoteAircraft.getAirlineIcaoCode()));
+        ModelIds outIds = CAircraftModelSetIndex::intersect(inIds, index.findByAirlineDesignator(remoteAircraft.getAirlineIcaoCodeDesignator()));
         if (
             mode.testFlag(CAircraftMatcherSetup::ByAirlineGroupSameAsAirline) ||
-            (outList.isEmpty() || mode.testFlag(CAircraftMatcherSetup::ByAirlineGroupIfNoAirline)))
+            (outIds.isEmpty() || mode.testFlag(CAircraftMatcherSetup::ByAirlineGroupIfNoAirline)))
         {
             if (remoteAircraft.getAirlineIcaoCode().hasGroupMembership())
             {
-                const CAircraftModelList groupModels = inList.findByAirlineGroup(remoteAircraft.getAirlineIcaoCode());
-                outList.replaceOrAddModelsWithString(groupModels, Qt::CaseInsensitive);
+                const ModelIds groupIds = CAircraftModelSetIndex::intersect(inIds, index.findByAirlineGroup(remoteAircraft.getAirlineIcaoCode().getGroupId()));
+                outIds = CAircraftModelSetIndex::replaceOrAdd(outIds, groupIds);
                 if (log)
                 {
                     CMatchingUtils::addLogDetailsToList(log, remoteAircraft,
-                                                        groupModels.isEmpty() ?
+                                                        groupIds.isEmpty() ?
                                                         QStringLiteral("No group models found by using airline group '%1'").arg(remoteAircraft.getAirlineIcaoCode().getGroupDesignator()) :
-                                                        QStringLiteral("Added %1 model(s) by using airline group '%2', all members: '%3'").arg(groupModels.sizeInt()).arg(remoteAircraft.getAirlineIcaoCode().getGroupDesignator(), joinStringSet(groupModels.getAirlineVDesignators(), ", ")),
+                                                        QStringLiteral("Added %1 model(s) by using airline group '%2', all members: '%3'").arg(groupIds.size()).arg(remoteAircraft.getAirlineIcaoCode().getGroupDesignator(), joinStringSet(index.toModels(groupIds).getAirlineVDesignators(), ", ")),
                                                         getLogCategories());
                 }
             } // group membership
         }
 
-        if (outList.isEmpty())
+        if (outIds.isEmpty())
         {
-            if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Cannot reduce by '" % remoteAircraft.getAirlineIcaoCodeDesignator() % u"' results: " % QString::number(outList.size()), getLogCategories()); }
-            return inList;
+            if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Cannot reduce by '" % remoteAircraft.getAirlineIcaoCodeDesignator() % u"' results: " % QString::number(outIds.size()), getLogCategories()); }
+            return inIds;
         }
 
-        if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Reduced by '" % remoteAircraft.getAirlineIcaoCodeDesignator() % u"' to " % QString::number(outList.size()), getLogCategories()); }
+        if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Reduced by '" % remoteAircraft.getAirlineIcaoCodeDesignator() % u"' to " % QString::number(outIds.size()), getLogCategories()); }
         reduced = true;
-        return outList;
+        return outIds;
     }
 
     CAircraftModelList CAircraftMatcher::ifPossibleReduceModelsByAirlineNameTelephonyDesignator(const CCallsign &cs, const QString &airlineName, const QString &telephony, const CAircraftModelList &inList, const QString &info, bool &reduced, CStatusMessageList *log)
@@ -1920,60 +2092,60 @@ namespace BlackCore
         **/
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByCombinedType(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const CAircraftMatcherSetup &setup, bool &reduced, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::ifPossibleReduceByCombinedType(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inIds, const CAircraftMatcherSetup &setup, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         if (!remoteAircraft.getAircraftIcaoCode().hasValidCombinedType())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("No valid combined code"), getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
         const QString cc = remoteAircraft.getAircraftIcaoCode().getCombinedType();
-        CAircraftModelList modelsByCombinedCode(inList.findByCombinedType(cc));
-        if (modelsByCombinedCode.isEmpty())
+        ModelIds idsByCombinedCode = index.findByCombinedType(inIds, cc);
+        if (idsByCombinedCode.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Not found by combined code " % cc, getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
-        if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by combined code " % cc % u", possible " % QString::number(modelsByCombinedCode.size()), getLogCategories()); }
-        if (modelsByCombinedCode.size() > 1)
+        if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by combined code " % cc % u", possible " % QString::number(idsByCombinedCode.size()), getLogCategories()); }
+        if (idsByCombinedCode.size() > 1)
         {
-            modelsByCombinedCode = ifPossibleReduceByAirline(remoteAircraft, modelsByCombinedCode, setup, QStringLiteral("Combined code airline reduction. "), reduced, log);
-            modelsByCombinedCode = ifPossibleReduceByManufacturer(remoteAircraft, modelsByCombinedCode, QStringLiteral("Combined code manufacturer reduction. "), reduced, log);
+            idsByCombinedCode = ifPossibleReduceByAirline(remoteAircraft, index, idsByCombinedCode, setup, QStringLiteral("Combined code airline reduction. "), reduced, log);
+            idsByCombinedCode = ifPossibleReduceByManufacturer(remoteAircraft, index, idsByCombinedCode, QStringLiteral("Combined code manufacturer reduction. "), reduced, log);
             reduced = true;
         }
-        return modelsByCombinedCode;
+        return idsByCombinedCode;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByMilitaryFlag(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, bool &reduced, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::ifPossibleReduceByMilitaryFlag(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inIds, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         const bool military = remoteAircraft.getModel().isMilitary();
-        const CAircraftModelList byMilitaryFlag(inList.findByMilitaryFlag(military));
+        const ModelIds byMilitaryFlag = index.findByMilitaryFlag(inIds, military);
         const QString mil(military ? "military" : "civilian");
         if (byMilitaryFlag.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Models not found by " % mil, getLogCategories()); }
-            return inList;
+            return inIds;
         }
 
         if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Models reduced to " % mil % u" aircraft, size " % QString::number(byMilitaryFlag.size()), getLogCategories()); }
         return byMilitaryFlag;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByVTOLFlag(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, bool &reduced, CStatusMessageList *log)
+    CAircraftMatcher::ModelIds CAircraftMatcher::ifPossibleReduceByVTOLFlag(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inIds, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
-        if (!inList.containsVtol())
+        if (!index.containsVtol(inIds))
         {
             CMatchingUtils::addLogDetailsToList(log, remoteAircraft, "Cannot reduce to VTOL aircraft", getLogCategories());
-            return inList;
+            return inIds;
         }
-        CAircraftModelList vtolModels = inList.findByVtolFlag(true);
-        if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Models reduced to " % QString::number(vtolModels.size()) % u" VTOL aircraft", getLogCategories()); }
-        return vtolModels;
+        const ModelIds vtolIds = index.findByVtolFlag(inIds, true);
+        if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Models reduced to " % QString::number(vtolIds.size()) % u" VTOL aircraft", getLogCategories()); }
+        return vtolIds;
     }
 
     QString CAircraftMatcher::scoresToString(const ScoredModels &scores, int lastElements)
@@ -16,8 +16,11 @@
 #include "blackmisc/simulation/aircraftmodelsetprovider.h"
 #include "blackmisc/simulation/aircraftmatchersetup.h"
 #include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/aircraftmodelsetindex.h"
 #include "blackmisc/simulation/matchingscriptmisc.h"
+#include "blackmisc/simulation/matchingresultcache.h"
 #include "blackmisc/simulation/matchingstatistics.h"
+#include "blackmisc/simulation/modelsetchanges.h"
 #include "blackmisc/simulation/matchinglog.h"
 #include "blackmisc/simulation/categorymatcher.h"
 #include "blackmisc/statusmessage.h"
@@ -29,6 +32,7 @@
 #include <QString>
 #include <QPair>
 #include <QSet>
+#include <memory>
 
 namespace BlackMisc
 {
@@ -76,6 +80,22 @@ namespace BlackCore
         //! Get the setup
         BlackMisc::Simulation::CAircraftMatcherSetup getSetup() const { return m_setup; }
 
+        //! Everything needed for matching, immutable once taken
+        struct MatchingSnapshot
+        {
+            BlackMisc::Simulation::CAircraftMatcherSetup setup;           //!< setup
+            BlackMisc::Simulation::CAircraftModel        defaultModel;    //!< default model
+            std::shared_ptr<const BlackMisc::Simulation::CAircraftModelSetIndex> modelSetIndex; //!< indexed model set
+            BlackMisc::Simulation::CCategoryMatcher      categoryMatcher; //!< category matcher
+            std::shared_ptr<BlackMisc::Simulation::CMatchingResultCache> resultCache; //!< shared result cache, thread safe
+            uint setupHash = 0;         //!< hash of the setup, part of the cache key
+            int  modelSetRevision = 0;  //!< revision of the model set, part of the cache key
+        };
+
+        //! Snapshot of the current setup, model set and default model
+        //! \remark cheap, the model set index is shared
+        MatchingSnapshot getMatchingSnapshot() const;
+
         //! Get the closest matching aircraft model from set.
         //! Result depends on setup.
         //! \sa BlackMisc::Simulation::CAircraftMatcherSetup
@@ -86,6 +106,15 @@ namespace BlackCore
             BlackMisc::CStatusMessageList *log,
             bool useMatchingScript) const;
 
+        //! Get the closest matching aircraft model from the snapshot
+        //! \threadsafe can be used in any thread, the snapshot is not modified
+        static BlackMisc::Simulation::CAircraftModel getClosestMatch(
+            const MatchingSnapshot &snapshot,
+            const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft,
+            BlackMisc::Simulation::MatchingLog whatToLog,
+            BlackMisc::CStatusMessageList *log,
+            bool useMatchingScript);
+
         //! Return an valid airline ICAO code
         //! \threadsafe
         static BlackMisc::Aviation::CAirlineIcaoCode failoverValidAirlineIcaoDesignator(
@@ -275,8 +304,13 @@ namespace BlackCore
 
         //! Set the models we want to use
         //! \note uses a set from "somewhere else" so it can also be used with arbitrary sets for testing
+        //! \remark for the same simulator only the changes are applied unless forced
         int setModelSet(const BlackMisc::Simulation::CAircraftModelList &models, const BlackMisc::Simulation::CSimulatorInfo &simulator, bool forced);
 
+        //! Apply changes of the model set, the index is updated for the changed models only
+        //! \remark models without model string, excluded or disabled models are not added
+        int applyModelSetChanges(const BlackMisc::Simulation::CModelSetChanges &changes);
+
         //! Remove a model for matching
         //! \remark effective until new set is set
         void disableModelsForMatching(const BlackMisc::Simulation::CAircraftModelList &removedModels, bool incremental);
@@ -293,11 +327,17 @@ namespace BlackCore
         //! Set default model, can be set by driver specific for simulator
         void setDefaultModel(const BlackMisc::Simulation::CAircraftModel &defaultModel);
 
-        //! The current statistics
-        const BlackMisc::Simulation::CMatchingStatistics &getCurrentStatistics() const { return m_statistics; }
+        //! The current statistics, including the hits and misses of the result cache
+        BlackMisc::Simulation::CMatchingStatistics getCurrentStatistics() const;
 
         //! Clear the statistics
-        void clearMatchingStatistics() { m_statistics.clear(); }
+        void clearMatchingStatistics();
+
+        //! The result cache
+        const BlackMisc::Simulation::CMatchingResultCache &getResultCache() const { return *m_resultCache; }
+
+        //! Revision of the model set, increased whenever the model set changes
+        int getModelSetRevision() const { return m_modelSetRevision; }
 
         //! Evaluate if a statistics entry makes sense and add it
         void evaluateStatisticsEntry(const QString &sessionId, const BlackMisc::Aviation::CCallsign &callsign, const QString &aircraftIcao, const QString &airlineIcao, const QString &livery);
@@ -313,9 +353,20 @@ namespace BlackCore
         //! Save the disabled models if any
         bool saveDisabledForMatchingModels();
 
+        //! Model ids in the indexed model set
+        using ModelIds = BlackMisc::Simulation::CAircraftModelSetIndex::Ids;
+
+        //! Rebuild the index after the model set has been changed
+        //! \remark also invalidates the result cache
+        void updateModelSetIndex();
+
+        //! Apply the changes to the model set and its index
+        //! \remark also invalidates the result cache
+        void applyChangesToModelSet(const BlackMisc::Simulation::CModelSetChanges &changes);
+
         //! The search based implementation
-        static BlackMisc::Simulation::CAircraftModelList getClosestMatchStepwiseReduceImplementation(
-            const BlackMisc::Simulation::CAircraftModelList &modelSet, const BlackMisc::Simulation::CAircraftMatcherSetup &setup,
+        static ModelIds getClosestMatchStepwiseReduceImplementation(
+            const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &modelSetIds, const BlackMisc::Simulation::CAircraftMatcherSetup &setup,
             const BlackMisc::Simulation::CCategoryMatcher &categoryMatcher, const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft,
             BlackMisc::Simulation::MatchingLog whatToLog, BlackMisc::CStatusMessageList *log = nullptr);
 
@@ -325,32 +376,32 @@ namespace BlackCore
         //! Get combined type default model, i.e. get a default model under consideration of the combined code such as "L2J"
         //! \see BlackMisc::Simulation::CSimulatedAircraft::getAircraftIcaoCombinedType
         //! \remark in any case a (default) model is returned
-        static BlackMisc::Simulation::CAircraftModel getCombinedTypeDefaultModel(const BlackMisc::Simulation::CAircraftModelList &modelSet, const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModel &defaultModel, BlackMisc::Simulation::MatchingLog whatToLog, BlackMisc::CStatusMessageList *log = nullptr);
+        static BlackMisc::Simulation::CAircraftModel getCombinedTypeDefaultModel(const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &modelSetIds, const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModel &defaultModel, BlackMisc::Simulation::MatchingLog whatToLog, BlackMisc::CStatusMessageList *log = nullptr);
 
         //! Search in models by key (aka model string)
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModel matchByExactModelString(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &models, BlackMisc::Simulation::MatchingLog whatToLog, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModel matchByExactModelString(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, BlackMisc::Simulation::MatchingLog whatToLog, BlackMisc::CStatusMessageList *log);
 
         //! Installed models by ICAO data
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByIcaoData(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &models, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static ModelIds ifPossibleReduceByIcaoData(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &inIds, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Find model by aircraft family
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelList &inList, bool &reduced, QString &usedFamily, BlackMisc::CStatusMessageList *log);
+        static ModelIds ifPossibleReduceByFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &inIds, bool &reduced, QString &usedFamily, BlackMisc::CStatusMessageList *log);
 
         //! Find model by aircraft family
         //! \remark pseudo family searches for same combined type and manufacturer
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const QString &family, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelList &inList, const QString &hint, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static ModelIds ifPossibleReduceByFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const QString &family, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &inIds, const QString &hint, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Search for exact livery and aircraft ICAO code
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByLiveryAndAircraftIcaoCode(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static ModelIds ifPossibleReduceByLiveryAndAircraftIcaoCode(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &inIds, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Reduce by manufacturer
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByManufacturer(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static ModelIds ifPossibleReduceByManufacturer(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &inIds, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Reduce by manufacturer
         //! \threadsafe
@@ -358,15 +409,15 @@ namespace BlackCore
 
         //! Reduce by aircraft ICAO
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByAircraft(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static ModelIds ifPossibleReduceByAircraft(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &inIds, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Reduce by aircraft ICAO or family
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByAircraftOrFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelList &inList, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static ModelIds ifPossibleReduceByAircraftOrFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &inIds, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Reduce by airline ICAO
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByAirline(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static ModelIds ifPossibleReduceByAirline(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &inIds, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Reduce by airline name/telephone designator
         //! \threadsafe
@@ -374,15 +425,15 @@ namespace BlackCore
 
         //! Installed models by combined code (ie L2J, L1P, ...)
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByCombinedType(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static ModelIds ifPossibleReduceByCombinedType(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &inIds, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! By military flag
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByMilitaryFlag(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static ModelIds ifPossibleReduceByMilitaryFlag(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &inIds, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! By VTOL flag
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByVTOLFlag(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static ModelIds ifPossibleReduceByVTOLFlag(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const ModelIds &inIds, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Scores to string for debugging
         //! \threadsafe
@@ -402,11 +453,15 @@ namespace BlackCore
         BlackMisc::Simulation::CAircraftMatcherSetup m_setup;           //!< setup
         BlackMisc::Simulation::CAircraftModel        m_defaultModel;    //!< model to be used as default model
         BlackMisc::Simulation::CAircraftModelList    m_modelSet;        //!< models used for model matching
+        std::shared_ptr<const BlackMisc::Simulation::CAircraftModelSetIndex> m_modelSetIndex { std::make_shared<const BlackMisc::Simulation::CAircraftModelSetIndex>() }; //!< indexed m_modelSet, replaced (not modified) when the set changes
         BlackMisc::Simulation::CAircraftModelList    m_disabledModels;  //!< disabled models for matching
         BlackMisc::Simulation::CSimulatorInfo        m_simulator;       //!< simulator (optional)
         BlackMisc::Simulation::CMatchingStatistics   m_statistics;      //!< matching statistics
         BlackMisc::Simulation::CCategoryMatcher      m_categoryMatcher; //!< the category matcher
         QString                                      m_modelSetInfo;    //!< info string
+        std::shared_ptr<BlackMisc::Simulation::CMatchingResultCache> m_resultCache { std::make_shared<BlackMisc::Simulation::CMatchingResultCache>() }; //!< shared with the snapshots
+        uint m_setupHash = 0;        //!< hash of m_setup
+        int  m_modelSetRevision = 0; //!< increased when m_modelSet changes
     };
 } // namespace
 
@@ -0,0 +1,231 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackcore/aircraftmatchingservice.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/airlineicaocode.h"
+#include "blackmisc/aviation/livery.h"
+#include "blackmisc/simulation/aircraftmatchersetup.h"
+#include "blackmisc/simulation/matchingutils.h"
+#include "blackmisc/logcategories.h"
+#include "blackmisc/range.h"
+
+#include <QHash>
+#include <QThread>
+#include <QTimer>
+#include <QStringBuilder>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation;
+
+namespace BlackCore
+{
+    const QStringList &CAircraftMatchingService::getLogCategories()
+    {
+        static const QStringList cats { CLogCategories::matching() };
+        return cats;
+    }
+
+    CAircraftMatchingService::CAircraftMatchingService(const CAircraftMatcher *matcher, QObject *parent) :
+        QObject(parent), m_matcher(matcher)
+    {
+        Q_ASSERT_X(matcher, Q_FUNC_INFO, "Need matcher");
+        this->setObjectName("CAircraftMatchingService");
+
+        // one core is left for the simulator and the UI
+        this->setMaxWorkers(QThread::idealThreadCount() - 1);
+        m_clock.start();
+    }
+
+    CAircraftMatchingService::~CAircraftMatchingService()
+    {
+        this->gracefulShutdown();
+    }
+
+    void CAircraftMatchingService::enqueue(const CSimulatedAircraft &remoteAircraft, MatchingLog whatToLog, bool useMatchingScript)
+    {
+        if (m_shutdown) { return; }
+        this->dequeue(remoteAircraft.getCallsign());
+
+        MatchingRequest request;
+        request.aircraft = remoteAircraft;
+        request.whatToLog = whatToLog;
+        request.useMatchingScript = useMatchingScript;
+        request.queuedMs = m_clock.elapsed();
+        request.token = m_nextToken++;
+        m_tokens.insert(remoteAircraft.getCallsign(), request.token);
+        m_queue.push_back(request);
+
+        // collect all aircraft arriving in this event loop cycle, then start
+        if (m_startScheduled) { return; }
+        m_startScheduled = true;
+        QPointer<CAircraftMatchingService> myself(this);
+        QTimer::singleShot(0, this, [ = ]
+        {
+            if (!myself) { return; }
+            m_startScheduled = false;
+            this->startBatches();
+        });
+    }
+
+    bool CAircraftMatchingService::dequeue(const CCallsign &callsign)
+    {
+        // without token a result still in work is dropped
+        if (m_tokens.remove(callsign) < 1) { return false; }
+        for (auto it = m_queue.begin(); it != m_queue.end(); ++it)
+        {
+            if (it->aircraft.getCallsign() != callsign) { continue; }
+            m_queue.erase(it);
+            break;
+        }
+        return true;
+    }
+
+    void CAircraftMatchingService::setMaxWorkers(int workers)
+    {
+        m_maxWorkers = qBound(1, workers, 4);
+        if (m_workers.size() < m_maxWorkers)
+        {
+            m_workers.resize(m_maxWorkers);
+            m_busy.resize(m_maxWorkers);
+        }
+    }
+
+    void CAircraftMatchingService::gracefulShutdown()
+    {
+        m_shutdown = true;
+        m_queue.clear();
+        m_tokens.clear();
+        for (const QPointer<CContinuousWorker> &worker : as_const(m_workers))
+        {
+            if (worker) { worker->quitAndWait(); }
+        }
+        m_workers.clear();
+        m_busy.clear();
+    }
+
+    void CAircraftMatchingService::startBatches()
+    {
+        if (m_shutdown) { return; }
+        for (int w = 0; w < m_maxWorkers && !m_queue.isEmpty(); w++)
+        {
+            if (m_busy[w]) { continue; }
+            CContinuousWorker *worker = this->worker(w);
+            if (!worker) { continue; }
+
+            QVector<MatchingRequest> batch;
+            while (!m_queue.isEmpty() && batch.size() < MaxBatchSize) { batch.push_back(m_queue.takeFirst()); }
+
+            // the snapshot is taken in the matcher's thread, the worker only reads it
+            const CAircraftMatcher::MatchingSnapshot snapshot = m_matcher->getMatchingSnapshot();
+            m_busy[w] = true;
+            m_inWork += batch.size();
+
+            QPointer<CAircraftMatchingService> myself(this);
+            QTimer::singleShot(0, worker, [ = ]
+            {
+                const QVector<MatchingResult> results = CAircraftMatchingService::matchBatch(snapshot, batch);
+                if (!myself) { return; }
+                QTimer::singleShot(0, myself, [ = ]
+                {
+                    if (!myself) { return; }
+                    myself->onBatchMatched(w, results);
+                });
+            });
+        }
+    }
+
+    void CAircraftMatchingService::onBatchMatched(int worker, const QVector<MatchingResult> &results)
+    {
+        if (worker < m_busy.size()) { m_busy[worker] = false; }
+        m_inWork -= results.size();
+        const qint64 now = m_clock.elapsed();
+        for (const MatchingResult &result : results)
+        {
+            // removed or queued again while in work
+            const CCallsign callsign = result.request.aircraft.getCallsign();
+            const auto token = m_tokens.constFind(callsign);
+            if (token == m_tokens.constEnd() || token.value() != result.request.token)
+            {
+                m_dropped++;
+                continue;
+            }
+            m_tokens.erase(token);
+            if (result.deduplicated) { m_deduplicated++; }
+            emit this->aircraftMatched(result.request.aircraft, result.model, result.messages, now - result.request.queuedMs);
+        }
+
+        if (m_queue.isEmpty())
+        {
+            if (m_inWork < 1) { emit this->allAircraftMatched(); }
+            return;
+        }
+        this->startBatches();
+    }
+
+    CContinuousWorker *CAircraftMatchingService::worker(int index)
+    {
+        if (index < 0 || index >= m_workers.size()) { return nullptr; }
+        if (m_workers[index]) { return m_workers[index]; }
+
+        // workers keep running, so the thread's matching script engine is re-used
+        CContinuousWorker *worker = new CContinuousWorker(this, QStringLiteral("CAircraftMatchingService %1").arg(index));
+        worker->start(QThread::LowPriority);
+        m_workers[index] = worker;
+        return worker;
+    }
+
+    QVector<CAircraftMatchingService::MatchingResult> CAircraftMatchingService::matchBatch(const CAircraftMatcher::MatchingSnapshot &snapshot, const QVector<MatchingRequest> &batch)
+    {
+        QVector<MatchingResult> results;
+        results.reserve(batch.size());
+        QHash<QString, CAircraftModel> matched; // by deduplication key
+
+        // random picks and matching scripts can yield different models for the same request
+        const bool randomPick = snapshot.setup.getPickStrategy() == CAircraftMatcherSetup::PickRandom;
+        const bool runsScript = snapshot.setup.doRunMsReverseLookupScript() || snapshot.setup.doRunMsMatchingStageScript();
+        for (const MatchingRequest &request : batch)
+        {
+            MatchingResult result;
+            result.request = request;
+            CStatusMessageList *log = request.whatToLog == MatchingLogNothing ? nullptr : &result.messages;
+
+            const bool deduplicate = !randomPick && !(runsScript && request.useMatchingScript);
+            const QString key = deduplicate ? CAircraftMatchingService::deduplicationKey(request) : QString();
+            const auto it = deduplicate ? matched.constFind(key) : matched.constEnd();
+            if (it != matched.constEnd())
+            {
+                // the messages of the matched aircraft belong to its callsign, this callsign gets its own line
+                result.model = it.value();
+                CMatchingUtils::addLogDetailsToList(log, request.aircraft, QStringLiteral("Same model as '%1' matched in this batch: '%2'").arg(it.value().getCallsign().asString(), it.value().getModelStringAndDbKey()), CAircraftMatchingService::getLogCategories());
+                result.model.setCallsign(request.aircraft.getCallsign());
+                result.deduplicated = true;
+            }
+            else
+            {
+                result.model = CAircraftMatcher::getClosestMatch(snapshot, request.aircraft, request.whatToLog, log, request.useMatchingScript);
+                if (deduplicate) { matched.insert(key, result.model); }
+            }
+            results.push_back(result);
+        }
+        return results;
+    }
+
+    QString CAircraftMatchingService::deduplicationKey(const MatchingRequest &request)
+    {
+        const CAircraftModel &model = request.aircraft.getModel();
+        return model.getAircraftIcaoCode().getDesignator() % u'|' %
+               model.getAircraftIcaoCode().getCombinedType() % u'|' %
+               model.getAirlineIcaoCode().getVDesignator() % u'|' %
+               model.getLivery().getCombinedCode() % u'|' %
+               model.getModelString() % u'|' %
+               QString::number(model.getModelType()) % u'|' %
+               QString::number(request.useMatchingScript);
+    }
+} // namespace
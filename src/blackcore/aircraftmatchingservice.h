@@ -0,0 +1,150 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKCORE_AIRCRAFTMATCHINGSERVICE_H
+#define BLACKCORE_AIRCRAFTMATCHINGSERVICE_H
+
+#include "blackcore/aircraftmatcher.h"
+#include "blackcore/blackcoreexport.h"
+#include "blackmisc/simulation/simulatedaircraft.h"
+#include "blackmisc/simulation/aircraftmodel.h"
+#include "blackmisc/simulation/matchinglog.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/statusmessagelist.h"
+#include "blackmisc/worker.h"
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QList>
+#include <QVector>
+#include <QElapsedTimer>
+
+namespace BlackCore
+{
+    //! Matching of remote aircraft in background threads
+    //! \details Remote aircraft are queued and matched in batches by a small pool of worker threads.
+    //!          Each batch is matched against an immutable CAircraftMatcher::MatchingSnapshot taken when
+    //!          the batch is started, DB data are read by the (thread safe) web data services.
+    //!          Aircraft with the same ICAO codes, livery and model string are only matched once per batch,
+    //!          unless models are picked randomly or a matching script runs. The results are delivered in the thread of the
+    //!          service by CAircraftMatchingService::aircraftMatched.
+    //!          Each request gets a token, only the result of the latest request of a callsign is delivered.
+    //!          Results of removed or re-queued aircraft are dropped.
+    class BLACKCORE_EXPORT CAircraftMatchingService : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        //! Max. number of aircraft in one batch
+        static constexpr int MaxBatchSize = 20;
+
+        //! Log categories
+        static const QStringList &getLogCategories();
+
+        //! Ctor
+        //! \param matcher matcher providing the snapshots, has to live in the thread of the service
+        //! \param parent QObject parent
+        CAircraftMatchingService(const CAircraftMatcher *matcher, QObject *parent = nullptr);
+
+        //! Dtor
+        virtual ~CAircraftMatchingService() override;
+
+        //! Queue aircraft for matching, an aircraft with the same callsign still queued is replaced
+        void enqueue(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, BlackMisc::Simulation::MatchingLog whatToLog, bool useMatchingScript = true);
+
+        //! Remove an aircraft, if it is already in work its result is dropped
+        //! \return true if the aircraft was queued or in work
+        bool dequeue(const BlackMisc::Aviation::CCallsign &callsign);
+
+        //! Number of aircraft waiting for a worker
+        int getQueuedCount() const { return m_queue.size(); }
+
+        //! Number of aircraft matched in the moment
+        int getInWorkCount() const { return m_inWork; }
+
+        //! Number of aircraft which got the model of an aircraft matched before in the same batch
+        int getDeduplicatedCount() const { return m_deduplicated; }
+
+        //! Number of results dropped as the aircraft was removed or queued again
+        int getDroppedCount() const { return m_dropped; }
+
+        //! Max. number of worker threads
+        int getMaxWorkers() const { return m_maxWorkers; }
+
+        //! Set the max. number of worker threads, only affects workers not yet started
+        void setMaxWorkers(int workers);
+
+        //! Stop the workers
+        void gracefulShutdown();
+
+    signals:
+        //! Aircraft has been matched
+        //! \param remoteAircraft aircraft as queued
+        //! \param matchedModel the matched model
+        //! \param matchingMessages messages if requested
+        //! \param queuedMs time between queueing and delivering the result
+        void aircraftMatched(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModel &matchedModel, const BlackMisc::CStatusMessageList &matchingMessages, qint64 queuedMs);
+
+        //! Nothing queued or in work
+        void allAircraftMatched();
+
+    private:
+        //! A queued aircraft
+        struct MatchingRequest
+        {
+            BlackMisc::Simulation::CSimulatedAircraft aircraft; //!< remote aircraft
+            BlackMisc::Simulation::MatchingLog whatToLog = BlackMisc::Simulation::MatchingLogNothing; //!< log
+            bool    useMatchingScript = true; //!< run matching script
+            qint64  queuedMs = 0; //!< queue time, ms since service start
+            quint64 token = 0;    //!< unique per request, see m_tokens
+        };
+
+        //! Result of a request
+        struct MatchingResult
+        {
+            MatchingRequest request;                      //!< the request
+            BlackMisc::Simulation::CAircraftModel model;  //!< matched model
+            BlackMisc::CStatusMessageList messages;       //!< matching messages
+            bool deduplicated = false;                    //!< model of an aircraft matched before in the batch
+        };
+
+        //! Start batches for the queued aircraft
+        void startBatches();
+
+        //! Batch has been matched by the worker
+        void onBatchMatched(int worker, const QVector<MatchingResult> &results);
+
+        //! Worker for index, started if needed
+        BlackMisc::CContinuousWorker *worker(int index);
+
+        //! Match a batch (in worker thread)
+        static QVector<MatchingResult> matchBatch(const CAircraftMatcher::MatchingSnapshot &snapshot, const QVector<MatchingRequest> &batch);
+
+        //! Requests with the same key yield the same model
+        static QString deduplicationKey(const MatchingRequest &request);
+
+        const CAircraftMatcher *m_matcher = nullptr;
+        QList<MatchingRequest> m_queue;                                //!< waiting for a worker
+        QVector<QPointer<BlackMisc::CContinuousWorker>> m_workers;     //!< worker threads, started on demand
+        QVector<bool> m_busy;                                          //!< worker busy?
+        QHash<BlackMisc::Aviation::CCallsign, quint64> m_tokens;       //!< token of the latest request, queued or in work
+        quint64 m_nextToken = 1;
+        int  m_deduplicated = 0;
+        int  m_dropped = 0;
+        int  m_maxWorkers = 2;
+        int  m_inWork = 0;
+        bool m_startScheduled = false;
+        bool m_shutdown = false;
+        QElapsedTimer m_clock;                                         //!< time base for queue times
+    };
+} // namespace
+
+#endif // guard
@@ -183,6 +183,24 @@ namespace BlackCore
             return m_airspace->remoteAircraftSituationsCount(callsign);
         }
 
+        int CContextNetwork::remoteAircraftSituationHistoryId(const CCallsign &callsign) const
+        {
+            if (!this->canUseAirspaceMonitor()) { return -1; }
+            return m_airspace->remoteAircraftSituationHistoryId(callsign);
+        }
+
+        bool CContextNetwork::remoteAircraftSituationHistory(int callsignId, CCompactSituationHistory &history) const
+        {
+            if (!this->canUseAirspaceMonitor()) { return false; }
+            return m_airspace->remoteAircraftSituationHistory(callsignId, history);
+        }
+
+        CRemoteAircraftSnapshotPtr CContextNetwork::getRemoteAircraftSnapshot() const
+        {
+            if (!this->canUseAirspaceMonitor()) { return CRemoteAircraftSnapshot::empty(); }
+            return m_airspace->getRemoteAircraftSnapshot();
+        }
+
         bool CContextNetwork::isRemoteAircraftSupportingParts(const CCallsign &callsign) const
         {
             if (!this->canUseAirspaceMonitor()) { return false; }
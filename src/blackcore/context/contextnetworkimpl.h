@@ -103,6 +103,9 @@ namespace BlackCore
             virtual BlackMisc::Aviation::CAircraftSituationList latestRemoteAircraftSituations() const override;
             virtual BlackMisc::Aviation::CAircraftSituationList latestOnGroundProviderElevations() const override;
             virtual int remoteAircraftSituationsCount(const BlackMisc::Aviation::CCallsign &callsign) const override;
+            virtual int remoteAircraftSituationHistoryId(const BlackMisc::Aviation::CCallsign &callsign) const override;
+            virtual bool remoteAircraftSituationHistory(int callsignId, BlackMisc::Simulation::CCompactSituationHistory &history) const override;
+            virtual BlackMisc::Simulation::CRemoteAircraftSnapshotPtr getRemoteAircraftSnapshot() const override;
             virtual BlackMisc::Aviation::CAircraftPartsList remoteAircraftParts(const BlackMisc::Aviation::CCallsign &callsign) const override;
             virtual int remoteAircraftPartsCount(const BlackMisc::Aviation::CCallsign &callsign) const override;
             virtual BlackMisc::Aviation::CCallsignSet remoteAircraftSupportingParts() const override;
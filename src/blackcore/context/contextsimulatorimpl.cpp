@@ -22,6 +22,7 @@
 #include "blackmisc/simulation/xplane/xplaneutil.h"
 #include "blackmisc/simulation/fscommon/fscommonutil.h"
 #include "blackmisc/simulation/matchingutils.h"
+#include "blackmisc/simulation/modelsetchanges.h"
 #include "blackmisc/aviation/callsign.h"
 #include "blackmisc/pq/units.h"
 #include "blackmisc/mixin/mixincompare.h"
@@ -78,7 +79,9 @@ namespace BlackCore
 
             connect(&m_weatherManager,  &CWeatherManager::weatherGridReceived, this, &CContextSimulator::onWeatherGridReceived, Qt::QueuedConnection);
             connect(&m_aircraftMatcher, &CAircraftMatcher::setupChanged,       this, &CContextSimulator::matchingSetupChanged);
+            connect(&m_matchingService, &CAircraftMatchingService::aircraftMatched, this, &CContextSimulator::onAircraftMatched);
             connect(&CCentralMultiSimulatorModelSetCachesProvider::modelCachesInstance(), &CCentralMultiSimulatorModelSetCachesProvider::cacheChanged, this, &CContextSimulator::modelSetChanged);
+            connect(&CCentralMultiSimulatorModelSetCachesProvider::modelCachesInstance(), &CCentralMultiSimulatorModelSetCachesProvider::cacheChanged, this, &CContextSimulator::onModelSetCacheChanged, Qt::QueuedConnection);
 
             // deferred init of last model set, if no other data are set in meantime
             const QPointer<CContextSimulator> myself(this);
@@ -142,6 +145,7 @@ namespace BlackCore
                 m_validator->deleteLater();
                 m_validator = nullptr;
             }
+            m_matchingService.gracefulShutdown();
             this->stopSimulatorListeners();
             this->disconnect();
             this->unloadSimulatorPlugin();
@@ -268,6 +272,7 @@ namespace BlackCore
             if (this->isSimulatorAvailable()) { return; } // if a plugin is loaded, do ignore this
             m_modelSetSimulator.set(simulator);
             const CAircraftModelList models = this->getModelSet(); // cache synced
+            m_modelSetChangesRevision = CCentralMultiSimulatorModelSetCachesProvider::modelCachesInstance().getChangesRevision(simulator);
             m_aircraftMatcher.setModelSet(models, simulator, false);
         }
 
@@ -510,6 +515,7 @@ namespace BlackCore
 
             m_modelSetSimulator.set(simInfo);
             const CAircraftModelList modelSetModels = this->getModelSet(); // synced
+            m_modelSetChangesRevision = CCentralMultiSimulatorModelSetCachesProvider::modelCachesInstance().getChangesRevision(simInfo);
             m_aircraftMatcher.setModelSet(modelSetModels, simInfo, true);
             m_aircraftMatcher.setDefaultModel(simulator->getDefaultModel());
 
@@ -684,11 +690,23 @@ namespace BlackCore
             // here we find the best simulator model for a resolved model
             // in the first step we already tried to find accurate ICAO codes etc.
             // coming from CAirspaceMonitor::sendReadyForModelMatching
-            MatchingLog whatToLog = m_logMatchingMessages;
-            CStatusMessageList matchingMessages;
-            CStatusMessageList *pMatchingMessages = m_logMatchingMessages > 0 ? &matchingMessages : nullptr;
-            CAircraftModel aircraftModel = m_aircraftMatcher.getClosestMatch(remoteAircraft, whatToLog, pMatchingMessages, true);
+            // matching is done in the background, result see onAircraftMatched
+            m_matchingService.enqueue(remoteAircraft, m_logMatchingMessages, true);
+        }
+
+        void CContextSimulator::onAircraftMatched(const CSimulatedAircraft &remoteAircraft, const CAircraftModel &matchedModel, const CStatusMessageList &matchingMessages, qint64 queuedMs)
+        {
+            if (!this->isSimulatorPluginAvailable()) { return; }
+
+            // removed while being matched?
+            const CCallsign callsign = remoteAircraft.getCallsign();
+            if (!this->isAircraftInRange(callsign)) { return; }
+
+            CAircraftModel aircraftModel(matchedModel);
             Q_ASSERT_X(remoteAircraft.getCallsign() == aircraftModel.getCallsign(), Q_FUNC_INFO, "Mismatching callsigns");
+            CStatusMessageList messages(matchingMessages);
+            CStatusMessageList *pMatchingMessages = m_logMatchingMessages > 0 ? &messages : nullptr;
+            if (pMatchingMessages) { CCallsign::addLogDetailsToList(pMatchingMessages, callsign, QStringLiteral("Matched in background, %1ms after queueing").arg(queuedMs)); }
 
             // decide CG
             const CLength cgModel = aircraftModel.getCG();
@@ -738,7 +756,7 @@ namespace BlackCore
             CCallsign::addLogDetailsToList(pMatchingMessages, callsign, QStringLiteral("Logically added remote aircraft: %1").arg(aircraftAfterModelApplied.toQString()));
 
             this->clearMatchingMessages(callsign);
-            this->addMatchingMessages(callsign, matchingMessages);
+            this->addMatchingMessages(callsign, messages);
 
             // done
             emit this->modelMatchingCompleted(aircraftAfterModelApplied);
@@ -746,6 +764,7 @@ namespace BlackCore
 
         void CContextSimulator::xCtxRemovedRemoteAircraft(const CCallsign &callsign)
         {
+            m_matchingService.dequeue(callsign);
             if (!this->isSimulatorAvailable()) { return; }
             m_simulatorPlugin.second->logicallyRemoveRemoteAircraft(callsign);
             m_failoverAddingCounts.remove(callsign);
@@ -877,6 +896,28 @@ namespace BlackCore
             emit this->addingRemoteModelFailed(remoteAircraft, disabled, failover, message);
         }
 
+        void CContextSimulator::onModelSetCacheChanged(const CSimulatorInfo &simulator)
+        {
+            // only a set already used for matching
+            if (!simulator.isSingleSimulator() || !m_aircraftMatcher.hasModels()) { return; }
+            if (simulator != this->getModelSetLoaderSimulator()) { return; }
+
+            CModelSetChanges changes;
+            const CCentralMultiSimulatorModelSetCachesProvider &caches = CCentralMultiSimulatorModelSetCachesProvider::modelCachesInstance();
+            if (m_modelSetChangesRevision >= 0 && caches.getChangesSince(m_modelSetChangesRevision, simulator, changes))
+            {
+                if (changes.isEmpty()) { return; }
+                m_aircraftMatcher.applyModelSetChanges(changes);
+                m_modelSetChangesRevision = changes.getRevision();
+                return;
+            }
+
+            // no recorded changes, the matcher diffs the sets
+            const CAircraftModelList models = this->getModelSet(); // synced
+            m_modelSetChangesRevision = caches.getChangesRevision(simulator);
+            m_aircraftMatcher.setModelSet(models, simulator, false);
+        }
+
         void CContextSimulator::onWeatherGridReceived(const CWeatherGrid &weatherGrid, const CIdentifier &identifier)
         {
             if (!sApp || sApp->isShuttingDown()) { return; }
@@ -1305,6 +1346,7 @@ namespace BlackCore
             const CSimulatorInfo simulator(m_modelSetSimulator.get());
             CCentralMultiSimulatorModelSetCachesProvider::modelCachesInstance().synchronizeCache(simulator);
             const CAircraftModelList models(this->getModelSet()); //synced
+            m_modelSetChangesRevision = CCentralMultiSimulatorModelSetCachesProvider::modelCachesInstance().getChangesRevision(simulator);
             CLogMessage(this).info(u"Init aircraft matcher with %1 models from set for '%2'") << models.size() << simulator.toQString();
             m_aircraftMatcher.setModelSet(models, simulator, false);
         }
@@ -16,6 +16,7 @@
 #include "blackcore/simulator.h"
 #include "blackcore/corefacadeconfig.h"
 #include "blackcore/aircraftmatcher.h"
+#include "blackcore/aircraftmatchingservice.h"
 #include "blackcore/blackcoreexport.h"
 #include "blackcore/weathermanager.h"
 #include "blackmisc/network/connectionstatus.h"
@@ -233,9 +234,15 @@ namespace BlackCore
             //! Simulator model has been changed
             void onOwnSimulatorModelChanged(const BlackMisc::Simulation::CAircraftModel &model);
 
+            //! Remote aircraft has been matched by the matching service
+            void onAircraftMatched(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModel &matchedModel, const BlackMisc::CStatusMessageList &matchingMessages, qint64 queuedMs);
+
             //! Failed adding remote aircraft
             void onAddingRemoteAircraftFailed(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, bool disabled, bool requestFailover, const BlackMisc::CStatusMessage &message);
 
+            //! Model set cache changed, the changes are applied to the matcher
+            void onModelSetCacheChanged(const BlackMisc::Simulation::CSimulatorInfo &simulator);
+
             //! Weather request was received
             void onWeatherGridReceived(const BlackMisc::Weather::CWeatherGrid &weatherGrid, const BlackMisc::CIdentifier &identifier);
 
@@ -285,10 +292,12 @@ namespace BlackCore
             BlackMisc::CRegularThread m_listenersThread;   //!< waiting for plugin
             CWeatherManager  m_weatherManager  { this };   //!< weather management
             CAircraftMatcher m_aircraftMatcher { this };   //!< model matcher
+            CAircraftMatchingService m_matchingService { &m_aircraftMatcher, this }; //!< matching in background threads
 
             bool m_wasSimulating          = false;
             bool m_initallyAddAircraft    = false;
             bool m_isWeatherActivated     = false; // used to activate after plugin is loaded
+            int  m_modelSetChangesRevision = -1;   //!< revision of the model set cache used by the matcher, -1 if unknown
             BlackMisc::Simulation::MatchingLog m_logMatchingMessages = BlackMisc::Simulation::MatchingLogSimplified;
 
             QString m_networkSessionId; //!< Network session of CServer::getServerSessionId, if not connected empty (for statistics, ..)
@@ -22,6 +22,7 @@
 #include "blackcore/fsd/ping.h"
 #include "blackcore/fsd/pong.h"
 #include "blackcore/fsd/killrequest.h"
+#include "blackcore/fsd/lineparser.h"
 #include "blackcore/fsd/textmessage.h"
 #include "blackcore/fsd/clientquery.h"
 #include "blackcore/fsd/clientresponse.h"
@@ -35,6 +36,7 @@
 #include "blackcore/fsd/planeinforequestfsinn.h"
 #include "blackcore/fsd/planeinformationfsinn.h"
 #include "blackcore/fsd/revbclientparts.h"
+#include "blackcore/fsd/sendqueue.h"
 
 #include "blackmisc/aviation/flightplan.h"
 #include "blackmisc/network/rawfsdmessage.h"
@@ -104,7 +106,7 @@ namespace BlackCore
               CRemoteAircraftAware(remoteAircraftProvider),
               m_tokenBucket(10, 5000, 1)
         {
-            initializeMessageTypes();
+            m_receiveClock.start();
             connect(&m_socket, &QTcpSocket::readyRead, this, &CFSDClient::readDataFromSocket,  Qt::QueuedConnection);
             connect(&m_socket, &QTcpSocket::connected, this, &CFSDClient::handleSocketConnected);
             connect(&m_socket, qOverload<QAbstractSocket::SocketError>(&QTcpSocket::error), this, &CFSDClient::printSocketError,  Qt::QueuedConnection);
@@ -751,33 +753,59 @@ namespace BlackCore
             emitRawFsdMessage(message.trimmed(), true);
         }
 
-        void CFSDClient::sendQueuedMessage()
+        void CFSDClient::sendMessageStrings(const QStringList &messages)
         {
-            if (m_queuedFsdMessages.isEmpty()) { return; }
-            const int s = m_queuedFsdMessages.size();
-            this->sendMessageString(m_queuedFsdMessages.dequeue());
+            if (messages.isEmpty()) { return; }
+            if (messages.size() == 1) { this->sendMessageString(messages.front()); return; }
+
+            // one encoded write for all messages of this cycle
+            const QByteArray bufferEncoded = m_fsdTextCodec->fromUnicode(messages.join(QString()));
+            if (m_printToConsole) { qDebug() << "FSD Sent=>" << bufferEncoded; }
+            if (!m_unitTestMode)  { m_socket.write(bufferEncoded); }
 
-            // send up to 6 at once
-            if (s > 5)  { this->sendMessageString(m_queuedFsdMessages.dequeue()); }
-            if (s > 10) { this->sendMessageString(m_queuedFsdMessages.dequeue()); }
-            if (s > 20) { this->sendMessageString(m_queuedFsdMessages.dequeue()); }
-            if (s > 30) { this->sendMessageString(m_queuedFsdMessages.dequeue()); }
+            for (const QString &message : messages)
+            {
+                emitRawFsdMessage(message.trimmed(), true);
+            }
+        }
+
+        void CFSDClient::sendQueuedMessage()
+        {
+            if (m_sendQueue.isEmpty()) { return; }
+            const int s = m_sendQueue.size();
 
             // overload
             // no idea, if we ever get here
-            if (s > 50)
+            if (s > CFsdSendQueue::OverloadSize)
             {
                 const StatusSeverity severity = s > 75 ? SeverityWarning : SeverityInfo;
                 CLogMessage(this).log(severity, u"Too many queued messages (%1), bulk send!") << s;
-                int sendNo = 10;
-                if (s > 75)  { sendNo = 20; }
-                if (s > 100) { sendNo = 30; }
-
-                for (int i = 0; i < sendNo; i++)
-                {
-                    this->sendMessageString(m_queuedFsdMessages.dequeue());
-                }
             }
+
+            this->sendMessageStrings(m_sendQueue.take(CFsdSendQueue::messagesPerSendCycle(s)));
+
+            if (m_clearSendStatistics.exchange(false)) { m_sendQueue.clearStatistics(); }
+            QWriteLocker l(&m_lockStatistics);
+            m_sendStatistics = m_sendQueue.getStatistics();
+        }
+
+        CFsdSendQueue::Priority CFSDClient::sendPriority(const PilotDataUpdate &)        { return CFsdSendQueue::PriorityHigh; }
+        CFsdSendQueue::Priority CFSDClient::sendPriority(const InterimPilotDataUpdate &) { return CFsdSendQueue::PriorityHigh; }
+        CFsdSendQueue::Priority CFSDClient::sendPriority(const AtcDataUpdate &)          { return CFsdSendQueue::PriorityHigh; }
+        CFsdSendQueue::Priority CFSDClient::sendPriority(const PlaneInfoRequest &)       { return CFsdSendQueue::PriorityLow; }
+        CFsdSendQueue::Priority CFSDClient::sendPriority(const PlaneInfoRequestFsinn &)  { return CFsdSendQueue::PriorityLow; }
+
+        CFsdSendQueue::Priority CFSDClient::sendPriority(const ClientQuery &query)
+        {
+            // our own incremental aircraft config is broadcasted, it must neither be delayed nor coalesced
+            if (query.m_queryType == ClientQueryType::AircraftConfig && query.receiver().startsWith('@')) { return CFsdSendQueue::PriorityNormal; }
+            return CFsdSendQueue::PriorityLow;
+        }
+
+        CFsdSendQueue::Statistics CFSDClient::getSendStatistics() const
+        {
+            QReadLocker l(&m_lockStatistics);
+            return m_sendStatistics;
         }
 
         void CFSDClient::sendFsdMessage(const QString &message)
@@ -949,41 +977,6 @@ namespace BlackCore
             m_sentAircraftConfig = currentParts;
         }
 
-        void CFSDClient::initializeMessageTypes()
-        {
-            m_messageTypeMapping["#AA"] = MessageType::AddAtc;
-            m_messageTypeMapping["#AP"] = MessageType::AddPilot;
-            m_messageTypeMapping["%"]   = MessageType::AtcDataUpdate;
-            m_messageTypeMapping["$ZC"] = MessageType::AuthChallenge;
-            m_messageTypeMapping["$ZR"] = MessageType::AuthResponse;
-            m_messageTypeMapping["$ID"] = MessageType::ClientIdentification;
-            m_messageTypeMapping["$CQ"] = MessageType::ClientQuery;
-            m_messageTypeMapping["$CR"] = MessageType::ClientResponse;
-            m_messageTypeMapping["#DA"] = MessageType::DeleteATC;
-            m_messageTypeMapping["#DP"] = MessageType::DeletePilot;
-            m_messageTypeMapping["$FP"] = MessageType::FlightPlan;
-            m_messageTypeMapping["#PC"] = MessageType::ProController;
-            m_messageTypeMapping["$DI"] = MessageType::FsdIdentification;
-            m_messageTypeMapping["$!!"] = MessageType::KillRequest;
-            m_messageTypeMapping["@"]   = MessageType::PilotDataUpdate;
-            m_messageTypeMapping["$PI"] = MessageType::Ping;
-            m_messageTypeMapping["$PO"] = MessageType::Pong;
-            m_messageTypeMapping["$ER"] = MessageType::ServerError;
-            m_messageTypeMapping["#DL"] = MessageType::ServerHeartbeat;
-            m_messageTypeMapping["#TM"] = MessageType::TextMessage;
-            m_messageTypeMapping["#SB"] = MessageType::PilotClientCom;
-
-            // IVAO only
-            // Ref: https://github.com/DemonRem/X-IvAP/blob/1b0a14880532a0f5c8fe84be44e462c6892a5596/src/XIvAp/FSDprotocol.h
-            m_messageTypeMapping["!R"]  = MessageType::RegistrationInfo;
-            m_messageTypeMapping["-MD"] = MessageType::RevBClientParts;
-            m_messageTypeMapping["-PD"] = MessageType::RevBPilotDescription; // not handled, to avoid error messages
-
-            // IVAO parts
-            // https://discordapp.com/channels/539048679160676382/695961646992195644/707915838845485187
-            // https://dev.swift-project.org/w/knowhow/simandinterpolation/ivaoparts/
-        }
-
         void CFSDClient::handleAtcDataUpdate(const QStringList &tokens)
         {
             const AtcDataUpdate atcDataUpdate = AtcDataUpdate::fromTokens(tokens);
@@ -1691,7 +1684,8 @@ namespace BlackCore
             m_pendingAtisQueries.clear();
             m_lastPositionUpdate.clear();
             m_lastOffsetTimes.clear();
-            m_queuedFsdMessages.clear();
+            m_sendQueue.clear();
+            m_receiveQueue.clear();
             m_sentAircraftConfig = CAircraftParts::null();
             m_loginSince = -1;
         }
@@ -1857,6 +1851,9 @@ namespace BlackCore
             QWriteLocker l(&m_lockStatistics);
             m_callStatistics.clear();
             m_callByTime.clear();
+            m_receiveStatistics = ReceiveStatistics();
+            m_sendStatistics = CFsdSendQueue::Statistics();
+            m_clearSendStatistics = true; // queue statistics are reset in the FSD thread
         }
 
         QString CFSDClient::getNetworkStatisticsAsText(bool reset, const QString &separator)
@@ -1864,14 +1861,18 @@ namespace BlackCore
             QVector<std::pair<int, QString>> transformed;
             QMap <QString, int> callStatistics;
             QVector <QPair<qint64, QString>> callByTime;
+            ReceiveStatistics receiveStatistics;
+            CFsdSendQueue::Statistics sendStatistics;
 
             {
                 QReadLocker l(&m_lockStatistics);
-                callStatistics = m_callStatistics;
-                callByTime     = m_callByTime;
+                callStatistics    = m_callStatistics;
+                callByTime        = m_callByTime;
+                receiveStatistics = m_receiveStatistics;
+                sendStatistics    = m_sendStatistics;
             }
 
-            if (callStatistics.isEmpty()) { return QString(); }
+            if (callStatistics.isEmpty() && receiveStatistics.parsedLines < 1 && sendStatistics.sent < 1) { return QString(); }
             for (const auto pair : makePairsRange(as_const(callStatistics)))
             {
                 // key is pair.first, value is pair.second
@@ -1905,6 +1906,20 @@ namespace BlackCore
                 }
             }
 
+            if (receiveStatistics.parsedLines > 0)
+            {
+                stats += (stats.isEmpty() ? QString() : separator) % QStringLiteral("receive queue: %1 lines, depth %2 (max %3), time in buffer avg %4us max %5us, deferred %6").arg(
+                             QString::number(receiveStatistics.parsedLines), QString::number(receiveStatistics.queueDepth), QString::number(receiveStatistics.maxQueueDepth),
+                             QString::number(receiveStatistics.averageTimeInBufferUs()), QString::number(receiveStatistics.maxTimeInBufferUs), QString::number(receiveStatistics.deferredParses));
+            }
+
+            if (sendStatistics.sent > 0)
+            {
+                stats += (stats.isEmpty() ? QString() : separator) % QStringLiteral("send queue: %1 messages in %2 writes, coalesced %3, max size %4, latency avg %5ms max %6ms").arg(
+                             QString::number(sendStatistics.sent), QString::number(sendStatistics.writes), QString::number(sendStatistics.coalesced),
+                             QString::number(sendStatistics.maxQueueSize), QString::number(sendStatistics.averageLatencyMs()), QString::number(sendStatistics.maxLatencyMs));
+            }
+
             if (reset) { this->clearStatistics(); }
             return stats;
         }
@@ -1915,42 +1930,77 @@ namespace BlackCore
             quitAndWait();
         }
 
-        void CFSDClient::readDataFromSocketMaxLines(int maxLines)
+        void CFSDClient::readDataFromSocket()
         {
-            if (m_socket.bytesAvailable() < 1) { return; }
-
-            int lines = 0;
-
-            // reads at least one line if available
+            // reading from the socket is cheap, so we move everything which is available into our queues
+            // and parse within a time budget afterwards
+            const qint64 nowUs = m_receiveClock.nsecsElapsed() / 1000;
             while (m_socket.canReadLine())
             {
                 const QByteArray dataEncoded = m_socket.readLine();
                 if (dataEncoded.isEmpty()) { continue; }
-                const QString data = m_fsdTextCodec->toUnicode(dataEncoded);
-                this->parseMessage(data);
-                lines++;
+                m_receiveQueue.enqueue(dataEncoded, nowUs);
+            }
+            this->parseReceivedLines();
+        }
 
-                static constexpr int MaxLines = 75 - 1;
-                if (maxLines < 0) { maxLines = MaxLines; }
+        void CFSDClient::parseReceivedLines()
+        {
+            const int queueDepth = m_receiveQueue.size();
+            if (queueDepth < 1) { return; }
 
-                if (lines > maxLines)
-                {
-                    static constexpr int DelayMs  = 10;
-                    const int newMax = qRound(1.2 * lines); // 20% more
+            QElapsedTimer budget;
+            budget.start();
+            int lines = 0;
+            qint64 sumTimeInBufferUs = 0;
+            qint64 maxTimeInBufferUs = 0;
 
-                    CLogMessage(this).debug(u"ReadDataFromSocket has too many lines (>%1), will read again in %2ms") << MaxLines << DelayMs;
-                    QPointer<CFSDClient> myself(this);
-                    QTimer::singleShot(DelayMs, this, [ = ]
-                    {
-                        if (!sApp || sApp->isShuttingDown()) { return; }
-                        if (myself) { myself->readDataFromSocketMaxLines(newMax); }
-                    });
-                    break;
-                }
+            // reads at least one line
+            CFsdReceiveQueue::ReceivedLine line;
+            while (m_receiveQueue.dequeue(line))
+            {
+                const qint64 timeInBufferUs = m_receiveClock.nsecsElapsed() / 1000 - line.receivedUs;
+                sumTimeInBufferUs += timeInBufferUs;
+                maxTimeInBufferUs = qMax(maxTimeInBufferUs, timeInBufferUs);
+
+                this->parseMessage(line.data);
+                lines++;
 
+                if (budget.nsecsElapsed() > c_parseBudgetUsec * 1000) { break; }
+            }
+
+            const int remaining = m_receiveQueue.size();
+            {
+                QWriteLocker l(&m_lockStatistics);
+                m_receiveStatistics.queueDepth = remaining;
+                m_receiveStatistics.maxQueueDepth = qMax(m_receiveStatistics.maxQueueDepth, queueDepth);
+                m_receiveStatistics.parsedLines += lines;
+                m_receiveStatistics.sumTimeInBufferUs += sumTimeInBufferUs;
+                m_receiveStatistics.maxTimeInBufferUs = qMax(m_receiveStatistics.maxTimeInBufferUs, maxTimeInBufferUs);
+                if (remaining > 0) { m_receiveStatistics.deferredParses++; }
+            }
+
+            // budget exceeded, continue in the next event loop cycle so timers and sending are not starved
+            if (remaining > 0 && !m_parseReceivedLinesScheduled)
+            {
+                m_parseReceivedLinesScheduled = true;
+                QPointer<CFSDClient> myself(this);
+                QTimer::singleShot(0, this, [ = ]
+                {
+                    if (!sApp || sApp->isShuttingDown()) { return; }
+                    if (!myself) { return; }
+                    myself->m_parseReceivedLinesScheduled = false;
+                    myself->parseReceivedLines();
+                });
             }
         }
 
+        CFSDClient::ReceiveStatistics CFSDClient::getReceiveStatistics() const
+        {
+            QReadLocker l(&m_lockStatistics);
+            return m_receiveStatistics;
+        }
+
         QString CFSDClient::socketErrorString(QAbstractSocket::SocketError error) const
         {
             QString e = CFSDClient::socketErrorToQString(error);
@@ -1969,21 +2019,22 @@ namespace BlackCore
 
         void CFSDClient::parseMessage(const QString &lineRaw)
         {
-            MessageType messageType = MessageType::Unknown;
-            QString cmd;
-            const QString line = lineRaw.trimmed();
+            // UNIT tests and debugging, normally we parse the raw bytes from the socket
+            const QByteArray lineEncoded = m_fsdTextCodec ? m_fsdTextCodec->fromUnicode(lineRaw) : lineRaw.toUtf8();
+            this->parseMessage(lineEncoded);
+        }
 
-            if (m_printToConsole) { qDebug() << "FSD Recv=>" << line; }
-            emitRawFsdMessage(line, false);
+        void CFSDClient::parseMessage(const QByteArray &lineEncoded)
+        {
+            const CFsdLineParser::Line parsed = CFsdLineParser::parse(lineEncoded);
+            const MessageType messageType = parsed.type;
 
-            for (const QString &str : makeKeysRange(as_const(m_messageTypeMapping)))
+            // the full line is only decoded if really needed
+            if (m_printToConsole || m_unitTestMode || m_rawFsdMessagesEnabled)
             {
-                if (line.startsWith(str))
-                {
-                    cmd = str;
-                    messageType = m_messageTypeMapping.value(str, MessageType::Unknown);
-                    break;
-                }
+                const QString line = parsed.line.toQString(m_fsdTextCodec);
+                if (m_printToConsole) { qDebug() << "FSD Recv=>" << line; }
+                emitRawFsdMessage(line, false);
             }
 
             // statistics
@@ -1994,26 +2045,15 @@ namespace BlackCore
 
             if (messageType != MessageType::Unknown)
             {
-                // Cutoff the cmd from the beginning
-                const QString payload = line.mid(cmd.size()).trimmed();
-
                 // We expected a payload, but there is nothing
-                if (payload.length() == 0) { return; }
+                if (parsed.payload.isEmpty()) { return; }
+
+                // ignored ones, no need to decode anything
+                if (CFsdLineParser::isIgnoredMessageType(messageType)) { return; }
 
-                const QStringList tokens = payload.split(':');
+                const QStringList tokens = CFsdLineParser::tokenize(parsed.payload, m_fsdTextCodec);
                 switch (messageType)
                 {
-                // ignored ones
-                case MessageType::AddAtc:
-                case MessageType::AddPilot:
-                case MessageType::ServerHeartbeat:
-                case MessageType::ProController:
-                case MessageType::ClientIdentification:
-                case MessageType::RegistrationInfo:
-                case MessageType::RevBPilotDescription:
-
-                    break;
-
                 // handled ones
                 case MessageType::AtcDataUpdate:     handleAtcDataUpdate(tokens);     break;
                 case MessageType::AuthChallenge:     handleAuthChallenge(tokens);     break;
@@ -2033,9 +2073,6 @@ namespace BlackCore
                 case MessageType::PilotClientCom:    handleCustomPilotPacket(tokens); break;
                 case MessageType::RevBClientParts:   handleRevBClientPartsPacket(tokens); break;
 
-
-
-
                 // normally we should not get here
                 default:
                 case MessageType::Unknown:
@@ -2045,7 +2082,7 @@ namespace BlackCore
             }
             else
             {
-                handleUnknownPacket(line);
+                handleUnknownPacket(parsed.line.toQString(m_fsdTextCodec));
             }
         }
 
@@ -2090,7 +2127,7 @@ namespace BlackCore
             m_positionUpdateTimer.start(c_updatePostionIntervalMsec);
             m_scheduledConfigUpdate.start(c_processingIntervalMsec);
             m_fsdSendMessageTimer.start(c_sendFsdMsgIntervalMsec);
-            m_queuedFsdMessages.clear(); // clear everything before the timer is started
+            m_sendQueue.clear(); // clear everything before the timer is started
 
             // interim positions
             if (this->isInterimPositionSendingEnabledForServer()) { m_interimPositionUpdateTimer.start(c_updateInterimPostionIntervalMsec); }
@@ -2215,15 +2252,7 @@ namespace BlackCore
 
         const QString &CFSDClient::messageTypeToString(MessageType mt) const
         {
-            QHash<QString, MessageType>::const_iterator i = m_messageTypeMapping.constBegin();
-            while (i != m_messageTypeMapping.constEnd())
-            {
-                if (i.value() == mt) { return i.key(); }
-                ++i;
-            }
-
-            static const QString empty;
-            return empty;
+            return CFsdLineParser::prefix(mt);
         }
 
         void CFSDClient::handleIllegalFsdState(const QString &message)
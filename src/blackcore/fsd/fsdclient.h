@@ -15,6 +15,8 @@
 #include "blackcore/vatsim/vatsimsettings.h"
 #include "blackcore/fsd/enums.h"
 #include "blackcore/fsd/messagebase.h"
+#include "blackcore/fsd/sendqueue.h"
+#include "blackcore/fsd/receivequeue.h"
 
 #include "blackmisc/simulation/ownaircraftprovider.h"
 #include "blackmisc/simulation/remoteaircraftprovider.h"
@@ -46,6 +48,7 @@
 #include <QTextCodec>
 #include <QReadWriteLock>
 #include <QQueue>
+#include <QElapsedTimer>
 
 #include <atomic>
 
@@ -61,6 +64,13 @@ namespace BlackCore
 {
     namespace Fsd
     {
+        class AtcDataUpdate;
+        class ClientQuery;
+        class InterimPilotDataUpdate;
+        class PilotDataUpdate;
+        class PlaneInfoRequest;
+        class PlaneInfoRequestFsinn;
+
         //! Message groups
         enum class TextMessageGroups
         {
@@ -200,6 +210,28 @@ namespace BlackCore
             //! Text statistics
             QString getNetworkStatisticsAsText(bool reset, const QString &separator = "\n");
 
+            //! Statistics of received lines waiting to be parsed
+            struct ReceiveStatistics
+            {
+                int queueDepth = 0;             //!< lines still waiting after the last parse cycle
+                int maxQueueDepth = 0;          //!< max. lines waiting at the start of a parse cycle
+                int deferredParses = 0;         //!< parse cycles which ran out of time budget
+                qint64 parsedLines = 0;         //!< parsed lines
+                qint64 sumTimeInBufferUs = 0;   //!< sum of times between reading from socket and parsing
+                qint64 maxTimeInBufferUs = 0;   //!< max. time between reading from socket and parsing
+
+                //! Average time between reading from socket and parsing
+                qint64 averageTimeInBufferUs() const { return parsedLines > 0 ? sumTimeInBufferUs / parsedLines : 0; }
+            };
+
+            //! Receive statistics
+            //! \threadsafe
+            ReceiveStatistics getReceiveStatistics() const;
+
+            //! Send queue statistics
+            //! \threadsafe
+            CFsdSendQueue::Statistics getSendStatistics() const;
+
             //! Debugging and UNIT tests
             void printToConsole(bool on)  { m_printToConsole = on; }
 
@@ -275,6 +307,7 @@ namespace BlackCore
             void sendAircraftConfiguration(const QString &receiver, const QString &aircraftConfigJson);
             //
             void sendMessageString(const QString &message);
+            void sendMessageStrings(const QStringList &messages);
             void sendQueuedMessage();
             //! @}
 
@@ -294,9 +327,21 @@ namespace BlackCore
                     this->sendDirectMessage(message);
                     return;
                 }
-                m_queuedFsdMessages.enqueue(messageToFSDString(message));
+                m_sendQueue.enqueue(messageToFSDString(message), sendPriority(message));
             }
 
+            //! Send priority of a message, positions first, queries last
+            //! @{
+            template <class T>
+            static CFsdSendQueue::Priority sendPriority(const T &) { return CFsdSendQueue::PriorityNormal; }
+            static CFsdSendQueue::Priority sendPriority(const PilotDataUpdate &);
+            static CFsdSendQueue::Priority sendPriority(const InterimPilotDataUpdate &);
+            static CFsdSendQueue::Priority sendPriority(const AtcDataUpdate &);
+            static CFsdSendQueue::Priority sendPriority(const ClientQuery &query);
+            static CFsdSendQueue::Priority sendPriority(const PlaneInfoRequest &);
+            static CFsdSendQueue::Priority sendPriority(const PlaneInfoRequestFsinn &);
+            //! @}
+
             //! Message send to FSD
             template <class T>
             void sendDirectMessage(const T &message)
@@ -344,16 +389,22 @@ namespace BlackCore
             void sendClientIdentification(const QString &fsdChallenge);
             void sendIncrementalAircraftConfig();
 
-            void readDataFromSocket() { this->readDataFromSocketMaxLines(); }
-            void readDataFromSocketMaxLines(int maxLines = -1);
+            //! Read all available lines from socket and parse them
+            void readDataFromSocket();
+
+            //! Parse the received lines within the time budget, positions first
+            void parseReceivedLines();
+
+            //! Parse a FSD line
+            //! \remark QString version is used for UNIT tests, the socket passes the raw bytes
+            //! @{
             void parseMessage(const QString &lineRaw);
+            void parseMessage(const QByteArray &lineEncoded);
+            //! @}
 
             QString socketErrorString(QAbstractSocket::SocketError error) const;
             static QString socketErrorToQString(QAbstractSocket::SocketError error);
 
-            //! Init. the message types
-            void initializeMessageTypes();
-
             // Type to string
             const QString &messageTypeToString(MessageType mt) const;
 
@@ -466,9 +517,6 @@ namespace BlackCore
             qint64       m_loginSince = -1; //!< when login was triggered
             static constexpr qint64 PendingConnectionTimeoutMs = 7500;
 
-            // Parser
-            QHash<QString, MessageType> m_messageTypeMapping;
-
             QTcpSocket m_socket { this }; //!< used TCP socket, parent needed as it runs in worker thread
 
             std::atomic_bool m_unitTestMode   { false };
@@ -554,7 +602,14 @@ namespace BlackCore
             mutable QReadWriteLock m_lockUserClientBuffered { QReadWriteLock::Recursive }; //!< for user, client and buffered data
             QString getOwnCallsignAsString() const { QReadLocker l(&m_lockUserClientBuffered); return m_ownCallsign.asString(); }
 
-            QQueue<QString> m_queuedFsdMessages;
+            CFsdSendQueue             m_sendQueue;                      //!< outbound messages
+            CFsdSendQueue::Statistics m_sendStatistics;                 //!< copy of the queue statistics, guarded by m_lockStatistics
+            std::atomic_bool          m_clearSendStatistics { false };  //!< reset queue statistics in FSD thread
+
+            CFsdReceiveQueue     m_receiveQueue;             //!< lines read from socket, but not yet parsed
+            QElapsedTimer        m_receiveClock;             //!< time base of the received lines
+            ReceiveStatistics    m_receiveStatistics;        //!< guarded by m_lockStatistics
+            bool m_parseReceivedLinesScheduled = false;      //!< parsing continues in next event loop cycle
 
             //! An illegal FSD state has been detected
             void handleIllegalFsdState(const QString &message);
@@ -564,6 +619,7 @@ namespace BlackCore
             static int constexpr c_updatePostionIntervalMsec        = 5000; //!< interval for the position update timer (send our position to network)
             static int constexpr c_updateInterimPostionIntervalMsec = 1000; //!< interval for iterim position updates (send our position as interim position)
             static int constexpr c_sendFsdMsgIntervalMsec           = 10;   //!< interval for FSD send messages
+            static int constexpr c_parseBudgetUsec                  = 4000; //!< max. time spent parsing received lines per event loop cycle
         };
     } // ns
 } // ns
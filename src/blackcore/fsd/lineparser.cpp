@@ -0,0 +1,222 @@
+/* Copyright (C) 2019
+ * swift project community / contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "lineparser.h"
+
+#include <QTextCodec>
+#include <array>
+#include <cstring>
+
+namespace BlackCore
+{
+    namespace Fsd
+    {
+        namespace
+        {
+            bool isSpace(char c)
+            {
+                return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+            }
+
+            //! PDUs by their first byte
+            using PduDispatch = std::array<QVector<CFsdLineParser::Pdu>, 256>;
+
+            //! PDUs by their first byte, so only the PDUs starting with the same byte are compared
+            const PduDispatch &pduDispatch()
+            {
+                static const PduDispatch dispatch = []
+                {
+                    PduDispatch d;
+                    for (const CFsdLineParser::Pdu &pdu : CFsdLineParser::pdus())
+                    {
+                        d[static_cast<unsigned char>(pdu.prefix[0])].push_back(pdu);
+                    }
+                    return d;
+                }();
+                return dispatch;
+            }
+        }
+
+        bool RawLineView::isAscii() const
+        {
+            for (int i = 0; i < size; ++i)
+            {
+                if (static_cast<unsigned char>(data[i]) >= 0x80) { return false; }
+            }
+            return true;
+        }
+
+        QString RawLineView::toQString(QTextCodec *codec) const
+        {
+            if (this->isEmpty()) { return {}; }
+            if (!codec || this->isAscii()) { return QString::fromLatin1(data, size); }
+            return codec->toUnicode(data, size);
+        }
+
+        CFsdLineParser::Line CFsdLineParser::parse(const QByteArray &lineEncoded)
+        {
+            Line result;
+            result.line = trimmed(RawLineView { lineEncoded.constData(), lineEncoded.size() });
+
+            int prefixLength = 0;
+            result.type = messageType(result.line.data, result.line.size, prefixLength);
+            if (result.type == MessageType::Unknown) { return result; }
+
+            result.payload = trimmed(RawLineView { result.line.data + prefixLength, result.line.size - prefixLength });
+            return result;
+        }
+
+        const QVector<CFsdLineParser::Pdu> &CFsdLineParser::pdus()
+        {
+            static const QVector<Pdu> pdus
+            {
+                { "#AA", MessageType::AddAtc },
+                { "#AP", MessageType::AddPilot },
+                { "%",   MessageType::AtcDataUpdate },
+                { "$ZC", MessageType::AuthChallenge },
+                { "$ZR", MessageType::AuthResponse },
+                { "$ID", MessageType::ClientIdentification },
+                { "$CQ", MessageType::ClientQuery },
+                { "$CR", MessageType::ClientResponse },
+                { "#DA", MessageType::DeleteATC },
+                { "#DP", MessageType::DeletePilot },
+                { "$FP", MessageType::FlightPlan },
+                { "#PC", MessageType::ProController },
+                { "$DI", MessageType::FsdIdentification },
+                { "$!!", MessageType::KillRequest },
+                { "@",   MessageType::PilotDataUpdate },
+                { "$PI", MessageType::Ping },
+                { "$PO", MessageType::Pong },
+                { "$ER", MessageType::ServerError },
+                { "#DL", MessageType::ServerHeartbeat },
+                { "#TM", MessageType::TextMessage },
+                { "#SB", MessageType::PilotClientCom },
+
+                // IVAO only
+                // Ref: https://github.com/DemonRem/X-IvAP/blob/1b0a14880532a0f5c8fe84be44e462c6892a5596/src/XIvAp/FSDprotocol.h
+                { "!R",  MessageType::RegistrationInfo },
+                { "-MD", MessageType::RevBClientParts },
+                { "-PD", MessageType::RevBPilotDescription }, // not handled, to avoid error messages
+
+                // IVAO parts
+                // https://discordapp.com/channels/539048679160676382/695961646992195644/707915838845485187
+                // https://dev.swift-project.org/w/knowhow/simandinterpolation/ivaoparts/
+            };
+            return pdus;
+        }
+
+        const QString &CFsdLineParser::prefix(MessageType type)
+        {
+            static const QVector<QString> prefixes = []
+            {
+                QVector<QString> p;
+                for (const Pdu &pdu : pdus())
+                {
+                    const int index = static_cast<int>(pdu.type);
+                    if (p.size() <= index) { p.resize(index + 1); }
+                    p[index] = QString::fromLatin1(pdu.prefix);
+                }
+                return p;
+            }();
+
+            static const QString empty;
+            const int index = static_cast<int>(type);
+            return index < prefixes.size() ? prefixes[index] : empty;
+        }
+
+        MessageType CFsdLineParser::messageType(const char *data, int size, int &prefixLength)
+        {
+            prefixLength = 0;
+            if (!data || size < 1) { return MessageType::Unknown; }
+
+            // dispatch on the first byte, then check the remaining 1-2 bytes
+            // this replaces the linear "startsWith" scan over all known PDUs
+            for (const Pdu &pdu : pduDispatch()[static_cast<unsigned char>(data[0])])
+            {
+                const int length = static_cast<int>(qstrlen(pdu.prefix));
+                if (size < length || std::memcmp(data, pdu.prefix, static_cast<size_t>(length)) != 0) { continue; }
+                prefixLength = length;
+                return pdu.type;
+            }
+            return MessageType::Unknown;
+        }
+
+        QStringList CFsdLineParser::tokenize(const RawLineView &payload, QTextCodec *codec)
+        {
+            QStringList tokens;
+            if (!payload.data) { return tokens; }
+            tokens.reserve(tokenCount(payload));
+
+            // ':' is never part of a multi byte sequence in the ASCII compatible codecs used with FSD,
+            // so we can split before decoding
+            const char *begin = payload.data;
+            const char *const end = payload.data + payload.size;
+            for (const char *p = begin; p <= end; ++p)
+            {
+                if (p == end || *p == ':')
+                {
+                    tokens.push_back(RawLineView { begin, static_cast<int>(p - begin) }.toQString(codec));
+                    begin = p + 1;
+                }
+            }
+            return tokens;
+        }
+
+        int CFsdLineParser::tokenCount(const RawLineView &payload)
+        {
+            int count = 1;
+            for (int i = 0; i < payload.size; ++i)
+            {
+                if (payload.data[i] == ':') { count++; }
+            }
+            return count;
+        }
+
+        RawLineView CFsdLineParser::sender(const Line &line)
+        {
+            if (line.type == MessageType::Unknown || !line.payload.data) { return {}; }
+            int token = line.type == MessageType::PilotDataUpdate ? 1 : 0;
+            const char *begin = line.payload.data;
+            const char *const end = line.payload.data + line.payload.size;
+            for (const char *p = begin; p <= end; ++p)
+            {
+                if (p != end && *p != ':') { continue; }
+                if (token-- == 0) { return RawLineView { begin, static_cast<int>(p - begin) }; }
+                begin = p + 1;
+            }
+            return {};
+        }
+
+        RawLineView CFsdLineParser::trimmed(const RawLineView &view)
+        {
+            if (!view.data) { return view; }
+            int begin = 0;
+            int end = view.size;
+            while (begin < end && isSpace(view.data[begin])) { begin++; }
+            while (end > begin && isSpace(view.data[end - 1])) { end--; }
+            return RawLineView { view.data + begin, end - begin };
+        }
+
+        bool CFsdLineParser::isIgnoredMessageType(MessageType type)
+        {
+            switch (type)
+            {
+            case MessageType::AddAtc:
+            case MessageType::AddPilot:
+            case MessageType::ServerHeartbeat:
+            case MessageType::ProController:
+            case MessageType::ClientIdentification:
+            case MessageType::RegistrationInfo:
+            case MessageType::RevBPilotDescription:
+                return true;
+            default: break;
+            }
+            return false;
+        }
+    } // ns
+} // ns
@@ -0,0 +1,104 @@
+/* Copyright (C) 2019
+ * swift project community / contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKCORE_FSD_LINEPARSER_H
+#define BLACKCORE_FSD_LINEPARSER_H
+
+#include "blackcore/blackcoreexport.h"
+#include "blackcore/fsd/messagebase.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class QTextCodec;
+
+namespace BlackCore
+{
+    namespace Fsd
+    {
+        //! Non owning view of a byte range in a raw (still encoded) FSD line
+        struct RawLineView
+        {
+            const char *data = nullptr; //!< first byte
+            int size = 0;               //!< number of bytes
+
+            //! Empty?
+            bool isEmpty() const { return size < 1; }
+
+            //! Only 7bit ASCII characters?
+            bool isAscii() const;
+
+            //! Decode to QString, pure ASCII ranges bypass the codec
+            QString toQString(QTextCodec *codec) const;
+        };
+
+        //! Byte level FSD line parser
+        //! \remark works on the raw QByteArray as read from the socket, only the tokens are decoded
+        class BLACKCORE_EXPORT CFsdLineParser
+        {
+        public:
+            //! Parsed line
+            struct Line
+            {
+                MessageType type = MessageType::Unknown; //!< message type
+                RawLineView line;                        //!< trimmed line
+                RawLineView payload;                     //!< trimmed line without PDU prefix
+            };
+
+            //! Parse the PDU prefix of a raw line
+            //! \remark the returned views point into lineEncoded, which has to outlive them
+            static Line parse(const QByteArray &lineEncoded);
+
+            //! Views into a temporary would dangle
+            static Line parse(QByteArray &&) = delete;
+
+            //! PDU prefix of a message type
+            struct Pdu
+            {
+                const char *prefix; //!< e.g. "#AA"
+                MessageType type;   //!< message type
+            };
+
+            //! All known PDUs, the prefix dispatch of messageType and the prefix strings are derived from it
+            static const QVector<Pdu> &pdus();
+
+            //! PDU prefix of a message type
+            //! \remark empty for MessageType::Unknown
+            static const QString &prefix(MessageType type);
+
+            //! Message type from the first 1-3 bytes of a trimmed line
+            //! \param data trimmed line
+            //! \param size number of bytes
+            //! \param prefixLength length of the matched PDU prefix, 0 if unknown
+            static MessageType messageType(const char *data, int size, int &prefixLength);
+
+            //! Split the payload at ':' and decode the tokens
+            //! \remark ASCII tokens (the vast majority) are converted directly, only non ASCII tokens go through the codec
+            static QStringList tokenize(const RawLineView &payload, QTextCodec *codec);
+
+            //! Number of ':' separated tokens in the payload
+            static int tokenCount(const RawLineView &payload);
+
+            //! Callsign of the client which sent the line, without decoding
+            //! \remark 2nd token for pilot positions ("@N:CALLSIGN:..."), 1st token for all other PDUs
+            static RawLineView sender(const Line &line);
+
+            //! Trim whitespace (incl. CR/LF) on both sides
+            static RawLineView trimmed(const RawLineView &view);
+
+            //! Message types which are not handled by swift and can be dropped before decoding
+            static bool isIgnoredMessageType(MessageType type);
+        };
+    } // ns
+} // ns
+
+#endif // guard
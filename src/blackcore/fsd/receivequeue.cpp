@@ -0,0 +1,73 @@
+/* Copyright (C) 2019
+ * swift project community / contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "receivequeue.h"
+#include "lineparser.h"
+
+namespace BlackCore
+{
+    namespace Fsd
+    {
+        void CFsdReceiveQueue::enqueue(const QByteArray &line, qint64 receivedUs)
+        {
+            if (line.isEmpty()) { return; }
+
+            const CFsdLineParser::Line parsed = CFsdLineParser::parse(line);
+            const bool isPosition = parsed.type == MessageType::PilotDataUpdate;
+            const bool isDelete = parsed.type == MessageType::DeletePilot || parsed.type == MessageType::DeleteATC;
+            const RawLineView senderView = CFsdLineParser::sender(parsed);
+            const QByteArray sender(senderView.data, senderView.size);
+
+            // keep the order of the client's lines: a delete waits for the client's other lines,
+            // and positions following that delete wait for it
+            const bool priority = (isPosition && !m_deferredPerSender.contains(sender)) ||
+                                  (isDelete && !m_linesPerSender.contains(sender));
+            if (priority)
+            {
+                m_priorityLines.enqueue(QueuedLine { ReceivedLine { line, receivedUs }, QByteArray(), false });
+                return;
+            }
+
+            const bool deferred = isPosition || isDelete;
+            m_linesPerSender[sender]++;
+            if (deferred) { m_deferredPerSender[sender]++; }
+            m_lines.enqueue(QueuedLine { ReceivedLine { line, receivedUs }, sender, deferred });
+        }
+
+        bool CFsdReceiveQueue::dequeue(ReceivedLine &line)
+        {
+            if (!m_priorityLines.isEmpty())
+            {
+                line = m_priorityLines.dequeue().line;
+                return true;
+            }
+            if (m_lines.isEmpty()) { return false; }
+
+            const QueuedLine queued = m_lines.dequeue();
+            decrement(m_linesPerSender, queued.sender);
+            if (queued.deferred) { decrement(m_deferredPerSender, queued.sender); }
+            line = queued.line;
+            return true;
+        }
+
+        void CFsdReceiveQueue::clear()
+        {
+            m_priorityLines.clear();
+            m_lines.clear();
+            m_linesPerSender.clear();
+            m_deferredPerSender.clear();
+        }
+
+        void CFsdReceiveQueue::decrement(QHash<QByteArray, int> &counters, const QByteArray &sender)
+        {
+            const auto it = counters.find(sender);
+            if (it == counters.end()) { return; }
+            if (--it.value() < 1) { counters.erase(it); }
+        }
+    } // ns
+} // ns
@@ -0,0 +1,75 @@
+/* Copyright (C) 2019
+ * swift project community / contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKCORE_FSD_RECEIVEQUEUE_H
+#define BLACKCORE_FSD_RECEIVEQUEUE_H
+
+#include "blackcore/blackcoreexport.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QQueue>
+
+namespace BlackCore
+{
+    namespace Fsd
+    {
+        //! Lines read from the FSD socket and waiting to be parsed, positions first
+        //! \details Pilot positions and deletes are parsed before all other lines. A delete never overtakes an earlier
+        //!          line of the same client, and a position never overtakes an earlier delete of the same client.
+        //!          In these cases the line is queued with the other lines, as are further positions of that client.
+        //! \remark not threadsafe, used in the FSD client thread only
+        class BLACKCORE_EXPORT CFsdReceiveQueue
+        {
+        public:
+            //! Line read from socket, but not yet parsed
+            struct ReceivedLine
+            {
+                QByteArray data;        //!< raw line
+                qint64 receivedUs = 0;  //!< read from socket
+            };
+
+            //! Add a raw line
+            void enqueue(const QByteArray &line, qint64 receivedUs);
+
+            //! Take the next line to parse
+            //! \return false if empty
+            bool dequeue(ReceivedLine &line);
+
+            //! Number of queued lines
+            int size() const { return m_priorityLines.size() + m_lines.size(); }
+
+            //! Empty?
+            bool isEmpty() const { return m_priorityLines.isEmpty() && m_lines.isEmpty(); }
+
+            //! Clear all queued lines
+            void clear();
+
+        private:
+            //! Queued line
+            struct QueuedLine
+            {
+                ReceivedLine line;
+                QByteArray sender;      //!< only for lines in m_lines
+                bool deferred = false;  //!< position or delete in m_lines
+            };
+
+            //! Decrement a counter, remove it when 0
+            static void decrement(QHash<QByteArray, int> &counters, const QByteArray &sender);
+
+            QQueue<QueuedLine> m_priorityLines;         //!< positions and deletes, parsed first
+            QQueue<QueuedLine> m_lines;                 //!< all other lines
+            QHash<QByteArray, int> m_linesPerSender;    //!< lines per sender in m_lines
+            QHash<QByteArray, int> m_deferredPerSender; //!< positions and deletes per sender in m_lines
+        };
+    } // ns
+} // ns
+
+#endif // guard
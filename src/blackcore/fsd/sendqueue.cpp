@@ -0,0 +1,92 @@
+/* Copyright (C) 2019
+ * swift project community / contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "sendqueue.h"
+
+namespace BlackCore
+{
+    namespace Fsd
+    {
+        CFsdSendQueue::CFsdSendQueue()
+        {
+            m_clock.start();
+        }
+
+        bool CFsdSendQueue::enqueue(const QString &message, Priority priority)
+        {
+            if (message.isEmpty()) { return false; }
+            if (priority < PriorityHigh || priority >= PriorityCount) { priority = PriorityNormal; }
+            if (priority == PriorityLow)
+            {
+                if (m_queuedLowPriority.contains(message))
+                {
+                    m_statistics.coalesced++;
+                    return false;
+                }
+                m_queuedLowPriority.insert(message);
+            }
+
+            m_queues[priority].enqueue(QueuedMessage { message, m_clock.elapsed() });
+            m_size++;
+            if (m_size > m_statistics.maxQueueSize) { m_statistics.maxQueueSize = m_size; }
+            return true;
+        }
+
+        QStringList CFsdSendQueue::take(int max)
+        {
+            QStringList messages;
+            if (max < 1 || m_size < 1) { return messages; }
+            messages.reserve(qMin(max, m_size));
+
+            const qint64 nowMs = m_clock.elapsed();
+            for (int p = PriorityHigh; p < PriorityCount && messages.size() < max; p++)
+            {
+                QQueue<QueuedMessage> &queue = m_queues[p];
+                while (!queue.isEmpty() && messages.size() < max)
+                {
+                    const QueuedMessage queued = queue.dequeue();
+                    if (p == PriorityLow) { m_queuedLowPriority.remove(queued.message); }
+
+                    const qint64 latencyMs = nowMs - queued.enqueuedMs;
+                    m_statistics.sumLatencyMs += latencyMs;
+                    if (latencyMs > m_statistics.maxLatencyMs) { m_statistics.maxLatencyMs = latencyMs; }
+                    messages.push_back(queued.message);
+                }
+            }
+
+            m_size -= messages.size();
+            m_statistics.sent += messages.size();
+            if (!messages.isEmpty()) { m_statistics.writes++; }
+            return messages;
+        }
+
+        int CFsdSendQueue::messagesPerSendCycle(int queued)
+        {
+            // send up to 6 at once
+            int sendNo = 1;
+            if (queued > 5)  { sendNo++; }
+            if (queued > 10) { sendNo++; }
+            if (queued > 20) { sendNo++; }
+            if (queued > 30) { sendNo++; }
+            if (queued > OverloadSize)
+            {
+                sendNo += 10;
+                if (queued > 75)  { sendNo += 10; }
+                if (queued > 100) { sendNo += 10; }
+            }
+            return sendNo;
+        }
+
+        void CFsdSendQueue::clear()
+        {
+            for (QQueue<QueuedMessage> &queue : m_queues) { queue.clear(); }
+            m_queuedLowPriority.clear();
+            m_size = 0;
+        }
+    } // ns
+} // ns
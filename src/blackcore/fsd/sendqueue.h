@@ -0,0 +1,105 @@
+/* Copyright (C) 2019
+ * swift project community / contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKCORE_FSD_SENDQUEUE_H
+#define BLACKCORE_FSD_SENDQUEUE_H
+
+#include "blackcore/blackcoreexport.h"
+
+#include <QElapsedTimer>
+#include <QQueue>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <array>
+
+namespace BlackCore
+{
+    namespace Fsd
+    {
+        //! Outbound FSD message queue with priorities and coalescing of duplicate queries
+        //! \remark not threadsafe, used in the FSD client thread only
+        class BLACKCORE_EXPORT CFsdSendQueue
+        {
+        public:
+            //! Send priority
+            enum Priority
+            {
+                PriorityHigh,   //!< own position updates
+                PriorityNormal, //!< login/logoff, text messages, responses, ...
+                PriorityLow,    //!< queries to other clients, can be coalesced
+                PriorityCount   //!< number of priorities
+            };
+
+            //! Queue statistics
+            struct Statistics
+            {
+                qint64 sent = 0;            //!< sent messages
+                qint64 coalesced = 0;       //!< dropped duplicates
+                qint64 writes = 0;          //!< socket writes
+                qint64 sumLatencyMs = 0;    //!< sum of times in queue
+                qint64 maxLatencyMs = 0;    //!< max. time in queue
+                int maxQueueSize = 0;       //!< max. queued messages
+
+                //! Average time in queue
+                qint64 averageLatencyMs() const { return sent > 0 ? sumLatencyMs / sent : 0; }
+            };
+
+            //! Ctor
+            CFsdSendQueue();
+
+            //! Enqueue a formatted message
+            //! \remark low priority messages identical to a still queued one are dropped
+            //! \return false if the message was coalesced
+            bool enqueue(const QString &message, Priority priority);
+
+            //! Take up to max messages, high priority first, FIFO within a priority
+            QStringList take(int max);
+
+            //! Messages sent per send cycle for the given number of queued messages
+            //! \remark 1 normally, up to 6 with a backlog and up to 36 when overloaded
+            static int messagesPerSendCycle(int queued);
+
+            //! Max. queued messages before the queue is considered overloaded
+            static constexpr int OverloadSize = 50;
+
+            //! Number of queued messages
+            int size() const { return m_size; }
+
+            //! Empty?
+            bool isEmpty() const { return m_size < 1; }
+
+            //! Clear all queued messages
+            void clear();
+
+            //! Statistics
+            const Statistics &getStatistics() const { return m_statistics; }
+
+            //! Reset statistics
+            void clearStatistics() { m_statistics = Statistics(); }
+
+        private:
+            //! Queued message
+            struct QueuedMessage
+            {
+                QString message;        //!< formatted message
+                qint64 enqueuedMs = 0;  //!< see m_clock
+            };
+
+            std::array<QQueue<QueuedMessage>, PriorityCount> m_queues;
+            QSet<QString>  m_queuedLowPriority; //!< for coalescing
+            QElapsedTimer  m_clock;
+            Statistics     m_statistics;
+            int            m_size = 0;
+        };
+    } // ns
+} // ns
+
+#endif // guard
@@ -0,0 +1,66 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackcore/matchingscriptengine.h"
+#include "blackcore/webdataservicesms.h"
+#include "blackmisc/fileutils.h"
+
+#include <QFileInfo>
+#include <QThreadStorage>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Simulation;
+
+namespace BlackCore
+{
+    CMatchingScriptEngine &CMatchingScriptEngine::threadEngine()
+    {
+        static QThreadStorage<CMatchingScriptEngine *> engines;
+        if (!engines.hasLocalData()) { engines.setLocalData(new CMatchingScriptEngine()); }
+        return *engines.localData();
+    }
+
+    CMatchingScriptEngine::CMatchingScriptEngine()
+    {
+        // wrapper for web services, same for all runs
+        // child of the engine, so not deleted by the garbage collector
+        MSWebServices *webServices = new MSWebServices();
+        webServices->setParent(&m_engine);
+        m_engine.globalObject().setProperty("webServices", m_engine.newQObject(webServices));
+    }
+
+    const QString &CMatchingScriptEngine::scriptForFile(MatchingScript ms, const QString &fileName)
+    {
+        CompiledScript &cs = this->compiledScript(ms);
+        const QFileInfo fi(fileName);
+        const QDateTime modified = fi.exists() ? fi.lastModified() : QDateTime();
+        const qint64 size = fi.exists() ? fi.size() : -1;
+        if (cs.fileName != fileName || cs.fileModified != modified || cs.fileSize != size)
+        {
+            cs.fileName = fileName;
+            cs.fileModified = modified;
+            cs.fileSize = size;
+            cs.fileScript = CFileUtils::readFileToString(fileName);
+        }
+        return cs.fileScript;
+    }
+
+    QJSValue CMatchingScriptEngine::scriptFunction(MatchingScript ms, const QString &js, const QString &fileName, bool &compiled)
+    {
+        CompiledScript &cs = this->compiledScript(ms);
+        compiled = false;
+        if (!cs.function.isUndefined() && cs.source == js) { return cs.function; }
+
+        // the script evaluates to the function which is called for each aircraft
+        cs.source = js;
+        cs.function = m_engine.evaluate(js, fileName);
+        compiled = true;
+        m_compilations++;
+        return cs.function;
+    }
+} // namespace
@@ -0,0 +1,78 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKCORE_MATCHINGSCRIPTENGINE_H
+#define BLACKCORE_MATCHINGSCRIPTENGINE_H
+
+#include "blackcore/blackcoreexport.h"
+#include "blackmisc/simulation/matchingscriptmisc.h"
+
+#include <QDateTime>
+#include <QJSEngine>
+#include <QJSValue>
+#include <QString>
+
+namespace BlackCore
+{
+    //! JavaScript engine for the matching scripts, one engine per thread
+    //! \details Creating a QJSEngine and evaluating the script text is expensive compared to running
+    //!          the script. The engine of a thread is kept, and each script is compiled once into a
+    //!          callable function. A script is only re-read/re-compiled if the script file (name,
+    //!          modification time, size) or the script text changes.
+    //! \remark the objects of one run are created with JavaScript ownership and collected by the engine
+    class BLACKCORE_EXPORT CMatchingScriptEngine
+    {
+    public:
+        //! Engine of the current thread, created on first use
+        static CMatchingScriptEngine &threadEngine();
+
+        //! Script text of the file, the file is only read again if it has changed
+        const QString &scriptForFile(BlackMisc::Simulation::MatchingScript ms, const QString &fileName);
+
+        //! Compiled script function for the script text
+        //! \param ms script type, each type has its own compiled function
+        //! \param js script text
+        //! \param fileName used for error messages
+        //! \param compiled set to true if the script had to be compiled
+        //! \return function, or error value if compilation failed
+        QJSValue scriptFunction(BlackMisc::Simulation::MatchingScript ms, const QString &js, const QString &fileName, bool &compiled);
+
+        //! The JavaScript engine
+        QJSEngine &engine() { return m_engine; }
+
+        //! Number of compilations in this thread
+        int getCompilationCount() const { return m_compilations; }
+
+    private:
+        //! Ctor
+        CMatchingScriptEngine();
+
+        //! Cached script of one type
+        struct CompiledScript
+        {
+            QString   fileName;     //!< script file
+            QDateTime fileModified; //!< file timestamp when read
+            qint64    fileSize = -1; //!< file size when read
+            QString   fileScript;   //!< script text of the file
+            QString   source;       //!< compiled script text
+            QJSValue  function;     //!< compiled function
+        };
+
+        //! Cache for the script type
+        CompiledScript &compiledScript(BlackMisc::Simulation::MatchingScript ms) { return ms == BlackMisc::Simulation::ReverseLookup ? m_reverseLookup : m_matchingStage; }
+
+        QJSEngine      m_engine;
+        CompiledScript m_reverseLookup;
+        CompiledScript m_matchingStage;
+        int            m_compilations = 0;
+    };
+} // namespace
+
+#endif // guard
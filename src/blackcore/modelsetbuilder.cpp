@@ -27,9 +27,13 @@ namespace BlackCore
         // void
     }
 
-    CAircraftModelList CModelSetBuilder::buildModelSet(const CSimulatorInfo &simulator, const CAircraftModelList &models, const CAircraftModelList &currentSet, Builder options, const CDistributorList &distributors) const
+    CAircraftModelList CModelSetBuilder::buildModelSet(const CSimulatorInfo &simulator, const CAircraftModelList &models, const CAircraftModelList &currentSet, Builder options, const CDistributorList &distributors, CModelSetChanges *changes) const
     {
-        if (models.isEmpty()) { return CAircraftModelList(); }
+        if (models.isEmpty())
+        {
+            if (changes) { *changes = CModelSetChanges::diff(currentSet, CAircraftModelList()); }
+            return CAircraftModelList();
+        }
         CAircraftModelList modelSet;
 
         // Select by distributor:
@@ -90,6 +94,7 @@ namespace BlackCore
         }
 
         // result
+        if (changes) { *changes = CModelSetChanges::diff(currentSet, modelSet); }
         return modelSet;
     }
 } // ns
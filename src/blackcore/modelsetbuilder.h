@@ -14,6 +14,7 @@
 #include "blackcore/blackcoreexport.h"
 #include "blackmisc/simulation/aircraftmodellist.h"
 #include "blackmisc/simulation/distributorlist.h"
+#include "blackmisc/simulation/modelsetchanges.h"
 #include "blackmisc/simulation/simulatorinfo.h"
 
 #include <QFlags>
@@ -47,11 +48,13 @@ namespace BlackCore
         CModelSetBuilder(QObject *parent = nullptr);
 
         //! Build a model set
+        //! \param changes if not nullptr, receives the changes from currentSet to the new set
         BlackMisc::Simulation::CAircraftModelList buildModelSet(
             const BlackMisc::Simulation::CSimulatorInfo &simulator,
             const BlackMisc::Simulation::CAircraftModelList &models,
             const BlackMisc::Simulation::CAircraftModelList &currentSet, Builder options,
-            const BlackMisc::Simulation::CDistributorList &distributors = {}) const;
+            const BlackMisc::Simulation::CDistributorList &distributors = {},
+            BlackMisc::Simulation::CModelSetChanges *changes = nullptr) const;
     };
 } // ns
 
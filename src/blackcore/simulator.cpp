@@ -482,6 +482,31 @@ namespace BlackCore
                 CLogMessage(this).info(u"Started writing interpolation log");
                 return true;
             }
+            if (part2 == "rec")
+            {
+                // binary flight recorder, cheap enough to be left on
+                if (!parser.hasPart(3)) { return false; }
+                const QString part3 = parser.part(3).toLower();
+                if (part3 == "off" || part3 == "false")
+                {
+                    m_interpolationLogger.recorder().setEnabled(false);
+                    CLogMessage(this).info(u"Disabled interpolation recorder");
+                    return true;
+                }
+                bool ok = true;
+                const int sampleInterval = (part3 == "on" || part3 == "true") ? 1 : part3.toInt(&ok);
+                if (!ok || sampleInterval < 1) { return false; }
+                m_interpolationLogger.recorder().setSampleInterval(sampleInterval);
+                m_interpolationLogger.recorder().setEnabled(true);
+                CLogMessage(this).info(u"Enabled interpolation recorder, every %1 step(s)") << sampleInterval;
+                return true;
+            }
+            if (part2 == "dump")
+            {
+                m_interpolationLogger.writeRecorderDumpInBackground();
+                CLogMessage(this).info(u"Started writing interpolation recorder dump");
+                return true;
+            }
             if (part2 == "show")
             {
                 const QDir dir(CInterpolationLogger::getLogDirectory());
@@ -658,6 +683,8 @@ namespace BlackCore
         CSimpleCommandParser::registerCommand({".drv logint write", "write interpolator log to file"});
         CSimpleCommandParser::registerCommand({".drv logint clear", "clear current log"});
         CSimpleCommandParser::registerCommand({".drv logint max number", "max. number of entries logged"});
+        CSimpleCommandParser::registerCommand({".drv logint rec on|off|n", "interpolation recorder, n records every n-th step"});
+        CSimpleCommandParser::registerCommand({".drv logint dump", "write interpolation recorder dump to file"});
         CSimpleCommandParser::registerCommand({".drv pos callsign", "show position for callsign"});
         CSimpleCommandParser::registerCommand({".drv spline|linear callsign", "set spline/linear interpolator for one/all callsign(s)"});
         CSimpleCommandParser::registerCommand({".drv aircraft readd callsign", "add again (re-add) a given callsign"});
@@ -24,6 +24,7 @@
 #include "blackmisc/simulation/aircraftmodellist.h"
 #include "blackmisc/simulation/distributorlist.h"
 #include "blackmisc/simulation/distributorlistpreferences.h"
+#include "blackmisc/simulation/modelsetchanges.h"
 #include "blackmisc/mixin/mixincompare.h"
 #include "blackmisc/icons.h"
 #include "blackmisc/logmessage.h"
@@ -112,6 +113,7 @@ namespace BlackGui
         void CDbOwnModelSetComponent::setModelSet(const CAircraftModelList &models, const CSimulatorInfo &simulator)
         {
             Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "Need single simulator");
+            const bool sameSimulator = this->getModelSetSimulator() == simulator;
             this->setSimulator(simulator);
             if (models.isEmpty())
             {
@@ -127,6 +129,17 @@ namespace BlackGui
                 this->showMappingComponentOverlayHtmlMessage(m, 5000);
             }
             cleanModelList.resetOrder();
+
+            // same set edited, only update the changed models
+            if (sameSimulator && !ui->tvp_OwnModelSet->isEmpty())
+            {
+                const CModelSetChanges changes = CModelSetChanges::diff(ui->tvp_OwnModelSet->container(), cleanModelList);
+                if (!changes.isReplacement())
+                {
+                    ui->tvp_OwnModelSet->applyModelSetChanges(changes);
+                    return;
+                }
+            }
             ui->tvp_OwnModelSet->updateContainerMaybeAsync(cleanModelList);
         }
 
@@ -239,7 +252,7 @@ namespace BlackGui
                 if (!ownModelSet.isEmpty())
                 {
                     const CSimulatorInfo sim = this->getSelectedSimulator();
-                    const CStatusMessage m   = this->setCachedModels(ownModelSet, sim);
+                    const CStatusMessage m   = this->saveModelSet(ownModelSet, sim);
                     CLogMessage::preformatted(m);
                     if (m.isSuccess())
                     {
@@ -414,6 +427,8 @@ namespace BlackGui
                 const QDialog::DialogCode rc = static_cast<QDialog::DialogCode>(m_modelSetFormDialog->exec());
                 if (rc == QDialog::Accepted)
                 {
+                    m_builtSetChanges = m_modelSetFormDialog->getModelSetChanges();
+                    m_builtSetSimulator = m_modelSetFormDialog->getSimulatorInfo();
                     this->setModelSet(m_modelSetFormDialog->getModelSet(), m_modelSetFormDialog->getSimulatorInfo());
                 }
             }
@@ -487,13 +502,14 @@ namespace BlackGui
 
         void CDbOwnModelSetComponent::updateDistributorOrder(const CSimulatorInfo &simulator)
         {
-            CAircraftModelList modelSet = this->getCachedModels(simulator);
-            if (modelSet.isEmpty()) { return; }
+            const CAircraftModelList cachedSet = this->getCachedModels(simulator);
+            if (cachedSet.isEmpty()) { return; }
             const CDistributorListPreferences preferences = m_distributorPreferences.getThreadLocal();
             const CDistributorList distributors = preferences.getDistributors(simulator);
             if (distributors.isEmpty()) { return; }
+            CAircraftModelList modelSet(cachedSet);
             modelSet.updateDistributorOrder(distributors);
-            this->setCachedModels(modelSet, simulator);
+            this->applyModelSetChanges(CModelSetChanges::diff(cachedSet, modelSet), simulator);
 
             // display?
             const CSimulatorInfo currentSimulator(this->getModelSetSimulator());
@@ -503,6 +519,22 @@ namespace BlackGui
             }
         }
 
+        CStatusMessage CDbOwnModelSetComponent::saveModelSet(const CAircraftModelList &modelSet, const CSimulatorInfo &simulator)
+        {
+            const CAircraftModelList cachedSet = this->getCachedModels(simulator);
+            CModelSetChanges changes;
+            if (!m_builtSetChanges.isEmpty() && m_builtSetSimulator == simulator)
+            {
+                // built from the saved set and not edited since
+                CAircraftModelList builtSet(cachedSet);
+                m_builtSetChanges.applyTo(builtSet);
+                if (builtSet == modelSet) { changes = m_builtSetChanges; }
+            }
+            if (changes.isEmpty()) { changes = CModelSetChanges::diff(cachedSet, modelSet); }
+            m_builtSetChanges = CModelSetChanges();
+            return this->applyModelSetChanges(changes, simulator);
+        }
+
         bool CDbOwnModelSetComponent::runsInDialog()
         {
             return CGuiUtility::findParentDialog(this, 5);
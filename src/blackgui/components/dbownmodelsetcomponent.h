@@ -19,6 +19,7 @@
 #include "blackmisc/simulation/settings/simulatorsettings.h"
 #include "blackmisc/simulation/aircraftmodelinterfaces.h"
 #include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/modelsetchanges.h"
 #include "blackmisc/simulation/simulatorinfo.h"
 #include "blackmisc/statusmessage.h"
 
@@ -179,6 +180,10 @@ namespace BlackGui
             //! Update distributor order
             void updateDistributorOrder(const BlackMisc::Simulation::CSimulatorInfo &simulator);
 
+            //! Save the set as model set cache, only the changes are recorded in the journal
+            //! \remark the changes of the last built set are used if the set is still the built one
+            BlackMisc::CStatusMessage saveModelSet(const BlackMisc::Simulation::CAircraftModelList &modelSet, const BlackMisc::Simulation::CSimulatorInfo &simulator);
+
             //! Is that component running in a dialog
             bool runsInDialog();
 
@@ -190,6 +195,8 @@ namespace BlackGui
             QScopedPointer<Views::CAircraftModelStatisticsDialog>   m_modelStatisticsDialog;
 
             BlackMisc::Simulation::CSimulatorInfo m_simulator; //!< currently set simulator
+            BlackMisc::Simulation::CModelSetChanges m_builtSetChanges; //!< changes of the last built set, until saved
+            BlackMisc::Simulation::CSimulatorInfo m_builtSetSimulator; //!< simulator of the last built set
             BlackMisc::CSettingReadOnly<BlackMisc::Simulation::Settings::TDistributorListPreferences> m_distributorPreferences { this, &CDbOwnModelSetComponent::distributorPreferencesChanged }; //!< distributor preferences
             BlackMisc::CSettingReadOnly<BlackMisc::Simulation::Settings::TModel> m_modelSettings { this }; //!< settings for models
             BlackMisc::Simulation::Settings::CMultiSimulatorSettings m_simulatorSettings         { this }; //!< for directories
@@ -85,7 +85,7 @@ namespace BlackGui
             }
             else if (sender == ui->pb_Ok)
             {
-                m_modelSet = this->buildSet(m_simulatorInfo, m_modelSet);
+                m_modelSet = this->buildSet(m_simulatorInfo, m_modelSet, &m_modelSetChanges);
                 this->accept();
             }
         }
@@ -136,7 +136,7 @@ namespace BlackGui
             this->setWindowTitle("Create model set for " + m_simulatorInfo.toQString(true));
         }
 
-        CAircraftModelList CDbOwnModelSetFormDialog::buildSet(const CSimulatorInfo &simulator, const CAircraftModelList &currentSet)
+        CAircraftModelList CDbOwnModelSetFormDialog::buildSet(const CSimulatorInfo &simulator, const CAircraftModelList &currentSet, CModelSetChanges *changes)
         {
             Q_ASSERT_X(this->getMappingComponent(), Q_FUNC_INFO, "missing mapping component");
             const bool givenDistributorsOnly  = !ui->form_OwnModelSet->optionUseAllDistributors();
@@ -153,6 +153,7 @@ namespace BlackGui
             if (givenDistributorsOnly && distributors.isEmpty())
             {
                 // nothing to do, keep current set
+                if (changes) { *changes = CModelSetChanges(); }
                 return currentSet;
             }
 
@@ -163,7 +164,7 @@ namespace BlackGui
             if (incremnental) { options |= CModelSetBuilder::Incremental; }
             if (sortByDistributor) { options |= CModelSetBuilder::SortByDistributors; }
             if (consolidateWithDb) { options |= CModelSetBuilder::ConsolidateWithDb; }
-            return builder.buildModelSet(simulator, models, currentSet, options, distributors);
+            return builder.buildModelSet(simulator, models, currentSet, options, distributors, changes);
         }
     } // ns
 } // ns
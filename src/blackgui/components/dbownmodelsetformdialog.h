@@ -13,6 +13,7 @@
 
 #include "blackgui/components/dbmappingcomponentaware.h"
 #include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/modelsetchanges.h"
 #include "blackmisc/simulation/simulatorinfo.h"
 
 #include <QDialog>
@@ -50,6 +51,9 @@ namespace BlackGui
             //! Init last set
             void setModelSet(const BlackMisc::Simulation::CAircraftModelList &models) { m_modelSet = models; }
 
+            //! Changes of the last build set against the set it was built from
+            const BlackMisc::Simulation::CModelSetChanges &getModelSetChanges() const { return m_modelSetChanges; }
+
             //! Simulator info
             const BlackMisc::Simulation::CSimulatorInfo &getSimulatorInfo() const { return m_simulatorInfo; }
 
@@ -66,6 +70,7 @@ namespace BlackGui
         private:
             QScopedPointer<Ui::CDbOwnModelSetFormDialog> ui;
             BlackMisc::Simulation::CAircraftModelList m_modelSet;
+            BlackMisc::Simulation::CModelSetChanges   m_modelSetChanges;
             BlackMisc::Simulation::CSimulatorInfo     m_simulatorInfo;
 
             //! Button clicked
@@ -81,7 +86,8 @@ namespace BlackGui
             void setSimulator(const BlackMisc::Simulation::CSimulatorInfo &simulator);
 
             //! Build the set
-            BlackMisc::Simulation::CAircraftModelList buildSet(const BlackMisc::Simulation::CSimulatorInfo &simulator, const BlackMisc::Simulation::CAircraftModelList &currentSet = {});
+            //! \param changes optional, changes against currentSet
+            BlackMisc::Simulation::CAircraftModelList buildSet(const BlackMisc::Simulation::CSimulatorInfo &simulator, const BlackMisc::Simulation::CAircraftModelList &currentSet = {}, BlackMisc::Simulation::CModelSetChanges *changes = nullptr);
         };
     } // ns
 } // ns
@@ -16,10 +16,15 @@
 #include "blackmisc/orderable.h"
 #include "blackmisc/simulation/aircraftmodel.h"
 #include "blackmisc/simulation/distributor.h"
+#include "blackmisc/simulation/modelsetchanges.h"
 #include "blackmisc/timestampbased.h"
 
+#include <QHash>
+#include <QList>
 #include <QtDebug>
 #include <QtGlobal>
+#include <algorithm>
+#include <functional>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Simulation;
@@ -203,6 +208,52 @@ namespace BlackGui
             this->updateContainerMaybeAsync(currentModels);
         }
 
+        void CAircraftModelListModel::applyModelSetChanges(const CModelSetChanges &changes)
+        {
+            if (changes.isEmpty()) { return; }
+            if (changes.isReplacement() || this->hasFilter() || changes.size() * 8 > m_container.sizeInt())
+            {
+                CAircraftModelList models(m_container);
+                changes.applyTo(models);
+                this->updateContainerMaybeAsync(models);
+                return;
+            }
+
+            // rows can be sorted differently than the set, so rows are found by model string
+            QHash<QString, int> rows;
+            rows.reserve(m_container.sizeInt());
+            for (int row = m_container.sizeInt() - 1; row >= 0; row--)
+            {
+                rows.insert(m_container[row].getModelString().toUpper(), row);
+            }
+
+            CAircraftModelList added;
+            for (const CAircraftModel &model : changes.getUpdated())
+            {
+                const int row = rows.value(model.getModelString().toUpper(), -1);
+                if (row >= 0) { this->update(row, model); }
+                else { added.push_back(model); }
+            }
+
+            QList<int> removedRows;
+            for (const QString &modelString : changes.getRemoved())
+            {
+                const int row = rows.value(modelString.toUpper(), -1);
+                if (row >= 0) { removedRows.push_back(row); }
+            }
+            std::sort(removedRows.begin(), removedRows.end(), std::greater<int>());
+            for (int row : removedRows)
+            {
+                this->beginRemoveRows(QModelIndex(), row, row);
+                m_container.erase(m_container.begin() + row);
+                this->endRemoveRows();
+            }
+
+            added.push_back(changes.getAdded());
+            if (!added.isEmpty()) { this->push_back(added); }
+            else { this->emitModelDataChanged(); }
+        }
+
         QVariant CAircraftModelListModel::data(const QModelIndex &index, int role) const
         {
             if (role == Qt::BackgroundRole)
@@ -22,7 +22,7 @@
 
 class QModelIndex;
 
-namespace BlackMisc { namespace Simulation { class CAircraftModel; } }
+namespace BlackMisc { namespace Simulation { class CAircraftModel; class CModelSetChanges; } }
 namespace BlackGui
 {
     namespace Models
@@ -86,6 +86,10 @@ namespace BlackGui
             //! Replace models with same model string, or just add
             void replaceOrAddByModelString(const BlackMisc::Simulation::CAircraftModelList &models);
 
+            //! Apply changes of a model set, only the changed rows are updated
+            //! \remark large changes, a replacement, or a filtered model result in a full update
+            void applyModelSetChanges(const BlackMisc::Simulation::CModelSetChanges &changes);
+
             //! \copydoc QAbstractItemModel::data
             virtual QVariant data(const QModelIndex &index, int role) const override;
 
@@ -17,6 +17,7 @@
 #include "blackgui/shortcut.h"
 #include "blackmisc/simulation/aircraftmodel.h"
 #include "blackmisc/simulation/distributorlist.h"
+#include "blackmisc/simulation/modelsetchanges.h"
 #include "blackmisc/simulation/simulatorinfolist.h"
 #include "blackmisc/aviation/aircrafticaocode.h"
 #include "blackmisc/aviation/aircrafticaocodelist.h"
@@ -167,6 +168,11 @@ namespace BlackGui
             return c;
         }
 
+        void CAircraftModelView::applyModelSetChanges(const CModelSetChanges &changes)
+        {
+            this->derivedModel()->applyModelSetChanges(changes);
+        }
+
         void CAircraftModelView::setHighlightModelStrings(const QStringList &highlightModels)
         {
             this->derivedModel()->setHighlightModelStrings(highlightModels);
@@ -38,7 +38,7 @@ namespace BlackMisc
         class CLivery;
     }
 }
-namespace BlackMisc { namespace Simulation { class CAircraftModel; } }
+namespace BlackMisc { namespace Simulation { class CAircraftModel; class CModelSetChanges; } }
 namespace BlackGui
 {
     namespace Filters { class CAircraftModelFilterDialog; }
@@ -94,6 +94,9 @@ namespace BlackGui
             //! Replace models with sme model string, otherwise add
             int replaceOrAddModelsWithString(const BlackMisc::Simulation::CAircraftModelList &models, Qt::CaseSensitivity sensitivity  = Qt::CaseInsensitive);
 
+            //! \copydoc BlackGui::Models::CAircraftModelListModel::applyModelSetChanges
+            void applyModelSetChanges(const BlackMisc::Simulation::CModelSetChanges &changes);
+
             //! \copydoc BlackGui::Models::CAircraftModelListModel::setHighlightModels
             void setHighlightModels(const BlackMisc::Simulation::CAircraftModelList &highlightModels);
 
@@ -129,7 +129,7 @@ namespace BlackMisc
         {
             if (this->isDbEqual(otherCode))
             {
-                addLogDetailsToList(log, *this, QString("Equal DB code: 100"));
+                if (log) { addLogDetailsToList(log, *this, QString("Equal DB code: 100")); }
                 return 100;
             }
 
@@ -149,7 +149,7 @@ namespace BlackMisc
                 else if (this->getRank() < 10) { score += (10 - this->getRank()); }
                 if (score > scoreOld)
                 {
-                    addLogDetailsToList(log, *this, QStringLiteral("Added rank: %1").arg(score));
+                    if (log) { addLogDetailsToList(log, *this, QStringLiteral("Added rank: %1").arg(score)); }
                 }
             }
             else
@@ -157,12 +157,12 @@ namespace BlackMisc
                 if (this->hasFamily() && this->getFamily() == otherCode.getFamily())
                 {
                     score += 40;
-                    addLogDetailsToList(log, *this, QStringLiteral("Added family: %1").arg(score));
+                    if (log) { addLogDetailsToList(log, *this, QStringLiteral("Added family: %1").arg(score)); }
                 }
                 else if (this->hasValidCombinedType() && otherCode.getCombinedType() == this->getCombinedType())
                 {
                     score += 30;
-                    addLogDetailsToList(log, *this, QStringLiteral("Added combined code: %1").arg(score));
+                    if (log) { addLogDetailsToList(log, *this, QStringLiteral("Added combined code: %1").arg(score)); }
                 }
                 else if (this->hasValidCombinedType())
                 {
@@ -205,7 +205,7 @@ namespace BlackMisc
                     {
                         score += 4;
                     }
-                    addLogDetailsToList(log, *this, QStringLiteral("Added combined code parts: %1").arg(score));
+                    if (log) { addLogDetailsToList(log, *this, QStringLiteral("Added combined code parts: %1").arg(score)); }
                 }
             }
 
@@ -215,11 +215,11 @@ namespace BlackMisc
                 if (this->matchesManufacturer(otherCode.getManufacturer()))
                 {
                     score += 10;
-                    addLogDetailsToList(log, *this, QStringLiteral("Matches manufacturer '%1': %2").arg(this->getManufacturer()).arg(score));
+                    if (log) { addLogDetailsToList(log, *this, QStringLiteral("Matches manufacturer '%1': %2").arg(this->getManufacturer()).arg(score)); }
                 }
                 else if (this->getManufacturer().contains(otherCode.getManufacturer(), Qt::CaseInsensitive))
                 {
-                    addLogDetailsToList(log, *this, QStringLiteral("Contains manufacturer '%1': %2").arg(this->getManufacturer()).arg(score));
+                    if (log) { addLogDetailsToList(log, *this, QStringLiteral("Contains manufacturer '%1': %2").arg(this->getManufacturer()).arg(score)); }
                     score += 5;
                 }
             }
@@ -228,17 +228,37 @@ namespace BlackMisc
             if (this->hasCategory() && otherCode.hasCategory() && this->getCategory() == otherCode.getCategory())
             {
                 score += 8;
-                addLogDetailsToList(log, *this, QStringLiteral("Matches military flag '%1': %2").arg(boolToYesNo(this->isMilitary())).arg(score));
+                if (log) { addLogDetailsToList(log, *this, QStringLiteral("Matches military flag '%1': %2").arg(boolToYesNo(this->isMilitary())).arg(score)); }
             }
             else if (this->isMilitary() == otherCode.isMilitary())
             {
                 score += 8;
-                addLogDetailsToList(log, *this, QStringLiteral("Matches military flag '%1': %2").arg(boolToYesNo(this->isMilitary())).arg(score));
+                if (log) { addLogDetailsToList(log, *this, QStringLiteral("Matches military flag '%1': %2").arg(boolToYesNo(this->isMilitary())).arg(score)); }
             }
             // 0..85
             return score;
         }
 
+        int CAircraftIcaoCode::calculateScoreUpperBound(const CAircraftIcaoCode &otherCode) const
+        {
+            // same branches as calculateScore, max. values
+            if (this->isDbEqual(otherCode)) { return 100; }
+
+            int score = 30; // combined code or combined code parts
+            if (this->hasValidDesignator() && this->getDesignator() == otherCode.getDesignator())
+            {
+                score = 50;
+                if (this->getRank() == 0) { score += 15; }
+                else if (this->getRank() == 1) { score += 12; }
+                else if (this->getRank() < 10) { score += (10 - this->getRank()); }
+            }
+            else if (this->hasFamily() && this->getFamily() == otherCode.getFamily())
+            {
+                score = 40;
+            }
+            return score + 10 + 8; // manufacturer, military/category
+        }
+
         void CAircraftIcaoCode::guessModelParameters(CLength &guessedCGOut, CSpeed &guessedVRotateOut) const
         {
             // we do not override values
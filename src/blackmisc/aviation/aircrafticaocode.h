@@ -316,6 +316,9 @@ namespace BlackMisc
             //! \remark normally used with a selected set of ICAO codes or combined types
             int calculateScore(const CAircraftIcaoCode &otherCode, CStatusMessageList *log = nullptr) const;
 
+            //! Cheap upper bound of calculateScore, no string formatting or color calculations
+            int calculateScoreUpperBound(const CAircraftIcaoCode &otherCode) const;
+
             //! Guess aircraft model parameters
             //! \remark values will not be overridden, pass null values to obtain guessed values
             void guessModelParameters(PhysicalQuantities::CLength &guessedCGOut, PhysicalQuantities::CSpeed &guessedVRotateOut) const;
@@ -452,7 +452,7 @@ namespace BlackMisc
         {
             if (this->isDbEqual(otherLivery))
             {
-                addLogDetailsToList(log, *this, QStringLiteral("Equal DB code: 100"));
+                if (log) { addLogDetailsToList(log, *this, QStringLiteral("Equal DB code: 100")); }
                 return 100;
             }
 
@@ -468,7 +468,7 @@ namespace BlackMisc
                 // 2 color liveries 25..85
                 score = 25;
                 score += 60 * colorMultiplier;
-                addLogDetailsToList(log, *this, QStringLiteral("2 color liveries, color multiplier %1: %2").arg(colorMultiplier).arg(score));
+                if (log) { addLogDetailsToList(log, *this, QStringLiteral("2 color liveries, color multiplier %1: %2").arg(colorMultiplier).arg(score)); }
             }
             else if (this->isAirlineLivery() && otherLivery.isAirlineLivery())
             {
@@ -479,10 +479,10 @@ namespace BlackMisc
                 // same ICAO at least means 30, max 50
                 score = qRound(0.5 * this->getAirlineIcaoCode().calculateScore(otherLivery.getAirlineIcaoCode(), log));
                 score += 25 * colorMultiplier;
-                addLogDetailsToList(log, *this, QStringLiteral("2 airline liveries, color multiplier %1: %2").arg(colorMultiplier).arg(score));
+                if (log) { addLogDetailsToList(log, *this, QStringLiteral("2 airline liveries, color multiplier %1: %2").arg(colorMultiplier).arg(score)); }
                 if (this->isMilitary() == otherLivery.isMilitary())
                 {
-                    addLogDetailsToList(log, *this, QStringLiteral("Mil.flag '%1' matches: %2").arg(boolToYesNo(this->isMilitary())).arg(score));
+                    if (log) { addLogDetailsToList(log, *this, QStringLiteral("Mil.flag '%1' matches: %2").arg(boolToYesNo(this->isMilitary())).arg(score)); }
                     score += 10;
                 }
             }
@@ -493,11 +493,24 @@ namespace BlackMisc
                 // 25 is weaker as same ICAO code / 2 from above
                 score = preferColorLiveries ? 25 : 0;
                 score += 25 * colorMultiplier; // needs to be the same as in 2 airlines
-                addLogDetailsToList(log, *this, QStringLiteral("Color/airline mixed, color multiplier %1: %2").arg(colorMultiplier).arg(score));
+                if (log) { addLogDetailsToList(log, *this, QStringLiteral("Color/airline mixed, color multiplier %1: %2").arg(colorMultiplier).arg(score)); }
             }
             return score;
         }
 
+        int CLivery::calculateScoreUpperBound(const CLivery &otherLivery, bool preferColorLiveries) const
+        {
+            // same branches as calculateScore, max. values (color multiplier 1)
+            if (this->isDbEqual(otherLivery)) { return 100; }
+            if (this->isColorLivery() && otherLivery.isColorLivery()) { return 85; }
+            if (this->isAirlineLivery() && otherLivery.isAirlineLivery()) { return 85; } // airline ICAO max. 100 without DB equality
+            if ((this->isColorLivery() && otherLivery.isAirlineLivery()) || (otherLivery.isColorLivery() && this->isAirlineLivery()))
+            {
+                return preferColorLiveries ? 50 : 25;
+            }
+            return 0;
+        }
+
         bool CLivery::isNull() const
         {
             return m_airline.isNull() && m_combinedCode.isEmpty() && m_description.isEmpty();
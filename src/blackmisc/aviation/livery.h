@@ -191,6 +191,9 @@ namespace BlackMisc
             //! \remark normally used with liveries preselect by airline ICAO code
             int calculateScore(const CLivery &otherLivery, bool preferColorLiveries = false, CStatusMessageList *log = nullptr) const;
 
+            //! Cheap upper bound of calculateScore, no airline scoring or color distance
+            int calculateScoreUpperBound(const CLivery &otherLivery, bool preferColorLiveries = false) const;
+
             //! Null livery?
             bool isNull() const;
 
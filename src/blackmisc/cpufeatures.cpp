@@ -0,0 +1,78 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/cpufeatures.h"
+
+#if defined(BLACK_KERNELS_X86) && defined(Q_CC_MSVC)
+#   include <intrin.h>
+#endif
+
+namespace BlackMisc
+{
+    namespace
+    {
+#if defined(BLACK_KERNELS_X86)
+        //! CPU and OS support
+        CCpuFeatures::InstructionSet detectInstructionSet()
+        {
+#if defined(Q_CC_MSVC)
+            int info[4] = { 0, 0, 0, 0 };
+            __cpuid(info, 0);
+            const int maxLeaf = info[0];
+            __cpuid(info, 1);
+            const bool sse2 = (info[3] & (1 << 26)) != 0;
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            const bool avx = osxsave && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6) == 0x6; // YMM state saved by the OS
+            bool avx2 = false;
+            if (avx && maxLeaf >= 7)
+            {
+                __cpuidex(info, 7, 0);
+                avx2 = (info[1] & (1 << 5)) != 0;
+            }
+            if (avx2) { return CCpuFeatures::AVX2; }
+            if (avx)  { return CCpuFeatures::AVX; }
+            if (sse2) { return CCpuFeatures::SSE2; }
+#else
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) { return CCpuFeatures::AVX2; }
+            if (__builtin_cpu_supports("avx"))  { return CCpuFeatures::AVX; }
+            if (__builtin_cpu_supports("sse2")) { return CCpuFeatures::SSE2; }
+#endif
+            return CCpuFeatures::Scalar;
+        }
+#else
+        //! No SIMD kernels for this architecture
+        CCpuFeatures::InstructionSet detectInstructionSet()
+        {
+            return CCpuFeatures::Scalar;
+        }
+#endif
+    }
+
+    CCpuFeatures::InstructionSet CCpuFeatures::detectedInstructionSet()
+    {
+        static const InstructionSet detected = detectInstructionSet();
+        return detected;
+    }
+
+    const QString &CCpuFeatures::instructionSetToString(InstructionSet set)
+    {
+        static const QString scalar("scalar");
+        static const QString sse2("SSE2");
+        static const QString avx("AVX");
+        static const QString avx2("AVX2");
+        switch (set)
+        {
+        case SSE2: return sse2;
+        case AVX: return avx;
+        case AVX2: return avx2;
+        default: break;
+        }
+        return scalar;
+    }
+} // ns
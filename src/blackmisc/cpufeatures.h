@@ -0,0 +1,90 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_CPUFEATURES_H
+#define BLACKMISC_CPUFEATURES_H
+
+#include "blackmisc/blackmiscexport.h"
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+
+//! \cond PRIVATE
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#   define BLACK_KERNELS_X86
+#   include <immintrin.h>
+#endif
+
+// GCC/clang compile the SIMD functions for their target only, the rest of the library stays generic
+// MSVC allows the intrinsics without any flags
+#if defined(BLACK_KERNELS_X86) && (defined(Q_CC_GNU) || defined(Q_CC_CLANG))
+#   define BLACK_TARGET_SSE2 __attribute__((target("sse2")))
+#   define BLACK_TARGET_AVX  __attribute__((target("avx")))
+#   define BLACK_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#   define BLACK_TARGET_SSE2
+#   define BLACK_TARGET_AVX
+#   define BLACK_TARGET_AVX2
+#endif
+//! \endcond
+
+namespace BlackMisc
+{
+    //! SIMD instruction sets supported by CPU and OS, for kernels dispatching at runtime
+    //! \remark SIMD functions are marked BLACK_TARGET_SSE2/BLACK_TARGET_AVX/BLACK_TARGET_AVX2 and only
+    //!         compiled if BLACK_KERNELS_X86 is defined
+    class BLACKMISC_EXPORT CCpuFeatures
+    {
+    public:
+        //! Instruction sets, each one implies the ones before
+        enum InstructionSet
+        {
+            Scalar,
+            SSE2,
+            AVX,
+            AVX2
+        };
+
+        //! No objects, just static
+        CCpuFeatures() = delete;
+
+        //! Best instruction set supported by CPU and OS
+        //! \remark detected once
+        static InstructionSet detectedInstructionSet();
+
+        //! Is instruction set supported?
+        static bool isSupported(InstructionSet set) { return set <= detectedInstructionSet(); }
+
+        //! Instruction set as string
+        static const QString &instructionSetToString(InstructionSet set);
+    };
+
+    //! Instruction set used by a family of kernels, selectable for UNIT tests and benchmarks
+    //! \threadsafe
+    template <class InstructionSet>
+    class CKernelInstructionSet
+    {
+    public:
+        //! Ctor
+        explicit CKernelInstructionSet(InstructionSet set) : m_set(static_cast<int>(set)) {}
+
+        //! Selected set
+        InstructionSet get() const { return static_cast<InstructionSet>(m_set.load(std::memory_order_relaxed)); }
+
+        //! Select set
+        void set(InstructionSet set) { m_set.store(static_cast<int>(set), std::memory_order_relaxed); }
+
+    private:
+        std::atomic_int m_set;
+    };
+} // ns
+
+#endif // guard
@@ -13,12 +13,15 @@
 
 #if defined(Q_OS_MACOS)
 #include <libproc.h>
+#include <mach/mach.h>
 #elif defined(Q_OS_WIN)
 #ifndef NOMINMAX
 #define NOMINMAX
 #endif
 #include <windows.h>
 #include <psapi.h>
+#elif defined(Q_OS_LINUX)
+#include <unistd.h>
 #endif
 
 namespace BlackMisc
@@ -61,4 +64,38 @@ namespace BlackMisc
     }
 #endif
 
+#if defined(Q_OS_LINUX)
+    qint64 CProcessInfo::currentProcessResidentMemory()
+    {
+        // second field are the resident pages
+        QFile statm(QStringLiteral("/proc/self/statm"));
+        if (!statm.open(QFile::ReadOnly)) { return -1; }
+        const QList<QByteArray> fields = statm.readAll().split(' ');
+        if (fields.size() < 2) { return -1; }
+        bool ok = false;
+        const qint64 pages = fields.at(1).toLongLong(&ok);
+        return ok ? pages * sysconf(_SC_PAGESIZE) : -1;
+    }
+#elif defined(Q_OS_MACOS)
+    qint64 CProcessInfo::currentProcessResidentMemory()
+    {
+        mach_task_basic_info info;
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) { return -1; }
+        return static_cast<qint64>(info.resident_size);
+    }
+#elif defined(Q_OS_WIN)
+    qint64 CProcessInfo::currentProcessResidentMemory()
+    {
+        PROCESS_MEMORY_COUNTERS counters;
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) { return -1; }
+        return static_cast<qint64>(counters.WorkingSetSize);
+    }
+#else
+    qint64 CProcessInfo::currentProcessResidentMemory()
+    {
+        return -1;
+    }
+#endif
+
 }
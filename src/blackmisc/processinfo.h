@@ -47,6 +47,9 @@ namespace BlackMisc
         //! Get the process name.
         const QString &processName() const { return m_name; }
 
+        //! Resident memory (working set) of the current process in bytes, -1 if not available
+        static qint64 currentProcessResidentMemory();
+
         //! \copydoc BlackMisc::Mixin::String::toQString
         QString convertToQString(bool i18n = false) const;
 
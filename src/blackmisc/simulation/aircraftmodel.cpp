@@ -816,10 +816,17 @@ namespace BlackMisc
         {
             const int icaoScore = this->getAircraftIcaoCode().calculateScore(compareModel.getAircraftIcaoCode(), log);
             const int liveryScore = this->getLivery().calculateScore(compareModel.getLivery(), preferColorLiveries, log);
-            CCallsign::addLogDetailsToList(log, this->getCallsign(), QStringLiteral("ICAO score: %1 | livery score: %2").arg(icaoScore).arg(liveryScore));
+            if (log) { CCallsign::addLogDetailsToList(log, this->getCallsign(), QStringLiteral("ICAO score: %1 | livery score: %2").arg(icaoScore).arg(liveryScore)); }
             return qRound(0.5 * (icaoScore + liveryScore));
         }
 
+        int CAircraftModel::calculateScoreUpperBound(const CAircraftModel &compareModel, bool preferColorLiveries) const
+        {
+            const int icaoBound = this->getAircraftIcaoCode().calculateScoreUpperBound(compareModel.getAircraftIcaoCode());
+            const int liveryBound = this->getLivery().calculateScoreUpperBound(compareModel.getLivery(), preferColorLiveries);
+            return qRound(0.5 * (icaoBound + liveryBound));
+        }
+
         CStatusMessageList CAircraftModel::validate(bool withNestedObjects) const
         {
             static const CLogCategoryList cats(CLogCategoryList(this).withValidation());
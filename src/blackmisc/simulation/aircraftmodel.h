@@ -411,6 +411,9 @@ namespace BlackMisc
             //! Calculate score
             int calculateScore(const CAircraftModel &compareModel, bool preferColorLiveries, CStatusMessageList *log = nullptr) const;
 
+            //! Upper bound of calculateScore, used to skip models which cannot beat an already found score
+            int calculateScoreUpperBound(const CAircraftModel &compareModel, bool preferColorLiveries) const;
+
             //! Validate
             CStatusMessageList validate(bool withNestedObjects) const;
 
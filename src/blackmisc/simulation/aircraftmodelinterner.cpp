@@ -0,0 +1,93 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/aircraftmodelinterner.h"
+
+using namespace BlackMisc::Aviation;
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        void CAircraftModelInterner::intern(CAircraftModel &model)
+        {
+            // equality of some members is case insensitive, but the interned object must be identical
+            const CAirlineIcaoCode airline = internIn(m_airlineIcaoCodes, model.getAirlineIcaoCode(), [](const CAirlineIcaoCode & a1, const CAirlineIcaoCode & a2)
+            {
+                return a1 == a2;
+            });
+
+            CLivery livery(model.getLivery());
+            livery.setAirlineIcaoCode(CAirlineIcaoCode()); // setAirlineIcaoCode ignores an equal airline
+            livery.setAirlineIcaoCode(airline);
+            livery = internIn(m_liveries, livery, [](const CLivery & l1, const CLivery & l2)
+            {
+                return l1 == l2 && l1.getCombinedCode() == l2.getCombinedCode();
+            });
+
+            const CAircraftIcaoCode aircraft = internIn(m_aircraftIcaoCodes, model.getAircraftIcaoCode(), [](const CAircraftIcaoCode & a1, const CAircraftIcaoCode & a2)
+            {
+                return a1 == a2;
+            });
+
+            const CDistributor distributor = internIn(m_distributors, model.getDistributor(), [](const CDistributor & d1, const CDistributor & d2)
+            {
+                return d1 == d2 && d1.getDbKey() == d2.getDbKey() && d1.getAlias1() == d2.getAlias1() && d1.getAlias2() == d2.getAlias2();
+            });
+
+            model.setLivery(livery);
+            model.setAircraftIcaoCodes(aircraft, livery.getAirlineIcaoCode()); // airline of the livery is already interned
+            model.setDistributor(distributor);
+
+            // often the same for all models of a package
+            model.setDescription(this->internString(model.getDescription()));
+            model.setName(this->internString(model.getName()));
+            model.setFileName(this->internString(model.getFileName()));
+            model.setIconFile(this->internString(model.getIconFile()));
+        }
+
+        void CAircraftModelInterner::intern(CAircraftModelList &models)
+        {
+            for (CAircraftModel &model : models) { this->intern(model); }
+        }
+
+        void CAircraftModelInterner::internModels(CAircraftModelList &models)
+        {
+            CAircraftModelInterner interner;
+            interner.intern(models);
+        }
+
+        QString CAircraftModelInterner::getInfoString() const
+        {
+            static const QString info("aircraft ICAO: %1 airline ICAO: %2 liveries: %3 distributors: %4 strings: %5");
+            return info.arg(this->getAircraftIcaoCodesCount()).arg(this->getAirlineIcaoCodesCount()).arg(this->getLiveriesCount()).arg(this->getDistributorsCount()).arg(this->getStringsCount());
+        }
+
+        template <class T, class Identical>
+        T CAircraftModelInterner::internIn(Table<T> &table, const T &value, Identical identical)
+        {
+            QVector<T> &bucket = table.buckets[qHash(value)];
+            for (const T &interned : bucket)
+            {
+                if (identical(interned, value)) { return interned; }
+            }
+            bucket.push_back(value);
+            table.count++;
+            return value;
+        }
+
+        QString CAircraftModelInterner::internString(const QString &string)
+        {
+            if (string.isEmpty()) { return string; }
+            const auto it = m_strings.constFind(string);
+            if (it != m_strings.constEnd()) { return *it; }
+            m_strings.insert(string);
+            return string;
+        }
+    } // namespace
+} // namespace
@@ -0,0 +1,83 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_AIRCRAFTMODELINTERNER_H
+#define BLACKMISC_SIMULATION_AIRCRAFTMODELINTERNER_H
+
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/distributor.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/airlineicaocode.h"
+#include "blackmisc/aviation/livery.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        //! Lets models share their ICAO codes, liveries, distributors and strings
+        //! \details Models of a set mostly use the same few hundred ICAO codes, liveries and distributors, but every model
+        //!          loaded from JSON, DBus or the model loaders has its own copies. The interner keeps one instance of each
+        //!          distinct object in a table and assigns it to all models using an identical object, so all models share
+        //!          the (implicitly shared) string data of that instance. The getters of the models are not affected.
+        //! \remark the tables are only needed while interning, the shared data stays with the models
+        class BLACKMISC_EXPORT CAircraftModelInterner
+        {
+        public:
+            //! Intern the shared data of the model
+            void intern(CAircraftModel &model);
+
+            //! Intern the shared data of all models
+            void intern(CAircraftModelList &models);
+
+            //! Intern all models of the list
+            static void internModels(CAircraftModelList &models);
+
+            //! \name Number of distinct objects
+            //! @{
+            int getAircraftIcaoCodesCount() const { return m_aircraftIcaoCodes.count; }
+            int getAirlineIcaoCodesCount() const { return m_airlineIcaoCodes.count; }
+            int getLiveriesCount() const { return m_liveries.count; }
+            int getDistributorsCount() const { return m_distributors.count; }
+            int getStringsCount() const { return m_strings.size(); }
+            //! @}
+
+            //! Info string
+            QString getInfoString() const;
+
+        private:
+            //! Distinct objects by hash
+            template <class T> struct Table
+            {
+                QHash<uint, QVector<T>> buckets;
+                int count = 0;
+            };
+
+            //! Identical object from the table, added if not yet there
+            template <class T, class Identical> static T internIn(Table<T> &table, const T &value, Identical identical);
+
+            //! Shared string
+            QString internString(const QString &string);
+
+            Table<Aviation::CAircraftIcaoCode> m_aircraftIcaoCodes;
+            Table<Aviation::CAirlineIcaoCode>  m_airlineIcaoCodes;
+            Table<Aviation::CLivery>           m_liveries;
+            Table<CDistributor>                m_distributors;
+            QSet<QString>                      m_strings;
+        };
+    } // namespace
+} // namespace
+
+#endif // guard
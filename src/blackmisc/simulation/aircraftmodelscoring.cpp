@@ -0,0 +1,144 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/aircraftmodelscoring.h"
+#include "blackmisc/threadutils.h"
+
+#include <QThread>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        namespace
+        {
+            //! Better score, same score: lower id
+            bool isBetter(const CScoredModelId &a, const CScoredModelId &b)
+            {
+                return a.score > b.score || (a.score == b.score && a.id < b.id);
+            }
+
+            //! Result of one chunk
+            struct ChunkResult
+            {
+                int maxScore = -1;
+                QVector<int> maxScoreIds;
+                std::vector<CScoredModelId> heap; //!< top K, worst on top
+                int scored = 0;
+                int pruned = 0;
+            };
+
+            //! Score a chunk of models
+            void scoreChunk(const CAircraftModelList &models, int begin, int end, const CAircraftModel &remoteModel,
+                            bool preferColorLiveries, bool ignoreZeroScores, int topK, bool prune,
+                            std::atomic_int &bestScore, ChunkResult &result)
+            {
+                for (int id = begin; id < end; id++)
+                {
+                    const CAircraftModel &model = models[id];
+                    if (prune)
+                    {
+                        // needed if it can tie the best score or can get into the top K of this chunk
+                        const int upperBound = model.calculateScoreUpperBound(remoteModel, preferColorLiveries);
+                        const bool mayBeBest = upperBound >= bestScore.load(std::memory_order_relaxed);
+                        const bool mayBeTopK = topK > 0 && (static_cast<int>(result.heap.size()) < topK || upperBound > result.heap.front().score);
+                        if (!mayBeBest && !mayBeTopK)
+                        {
+                            result.pruned++;
+                            continue;
+                        }
+                    }
+
+                    const int score = model.calculateScore(remoteModel, preferColorLiveries);
+                    if (ignoreZeroScores && score < 1) { continue; }
+                    result.scored++;
+
+                    if (score > result.maxScore)
+                    {
+                        result.maxScore = score;
+                        result.maxScoreIds.clear();
+                        int best = bestScore.load(std::memory_order_relaxed);
+                        while (score > best && !bestScore.compare_exchange_weak(best, score, std::memory_order_relaxed)) {}
+                    }
+                    if (score == result.maxScore) { result.maxScoreIds.push_back(id); }
+
+                    if (topK < 1) { continue; }
+                    const CScoredModelId scoredId { id, score };
+                    if (static_cast<int>(result.heap.size()) < topK)
+                    {
+                        result.heap.push_back(scoredId);
+                        std::push_heap(result.heap.begin(), result.heap.end(), isBetter);
+                    }
+                    else if (isBetter(scoredId, result.heap.front()))
+                    {
+                        std::pop_heap(result.heap.begin(), result.heap.end(), isBetter);
+                        result.heap.back() = scoredId;
+                        std::push_heap(result.heap.begin(), result.heap.end(), isBetter);
+                    }
+                }
+            }
+        }
+
+        CAircraftModelScores CAircraftModelScoring::scoreTopK(const CAircraftModelList &models, const CAircraftModel &remoteModel, bool preferColorLiveries, bool ignoreZeroScores, int topK, int maxThreads)
+        {
+            return scoreTopKImpl(models, remoteModel, preferColorLiveries, ignoreZeroScores, topK, maxThreads, true);
+        }
+
+        CAircraftModelScores CAircraftModelScoring::scoreTopKNoPruning(const CAircraftModelList &models, const CAircraftModel &remoteModel, bool preferColorLiveries, bool ignoreZeroScores, int topK, int maxThreads)
+        {
+            return scoreTopKImpl(models, remoteModel, preferColorLiveries, ignoreZeroScores, topK, maxThreads, false);
+        }
+
+        CAircraftModelScores CAircraftModelScoring::scoreTopKImpl(const CAircraftModelList &models, const CAircraftModel &remoteModel, bool preferColorLiveries, bool ignoreZeroScores, int topK, int maxThreads, bool prune)
+        {
+            CAircraftModelScores scores;
+            const int size = models.sizeInt();
+            if (size < 1) { return scores; }
+
+            if (maxThreads < 1) { maxThreads = qMax(1, QThread::idealThreadCount()); }
+            const int chunks = qBound(1, size / MinChunkSize, maxThreads);
+            const int chunkSize = (size + chunks - 1) / chunks;
+
+            std::atomic_int bestScore { ignoreZeroScores ? 1 : 0 };
+            std::vector<ChunkResult> results(static_cast<std::size_t>(chunks));
+            CThreadUtils::parallelFor(chunks, chunks, [&](int c)
+            {
+                const int begin = c * chunkSize;
+                const int end = qMin(size, begin + chunkSize);
+                scoreChunk(models, begin, end, remoteModel, preferColorLiveries, ignoreZeroScores, topK, prune, bestScore, results[static_cast<std::size_t>(c)]);
+            });
+
+            // merge, chunks are in id order
+            std::vector<CScoredModelId> all;
+            for (const ChunkResult &result : results)
+            {
+                scores.scored += result.scored;
+                scores.pruned += result.pruned;
+                all.insert(all.end(), result.heap.cbegin(), result.heap.cend());
+                if (result.maxScore < 0) { continue; }
+                if (result.maxScore > scores.maxScore)
+                {
+                    scores.maxScore = result.maxScore;
+                    scores.maxScoreIds = result.maxScoreIds;
+                }
+                else if (result.maxScore == scores.maxScore)
+                {
+                    scores.maxScoreIds += result.maxScoreIds;
+                }
+            }
+
+            std::sort(all.begin(), all.end(), isBetter);
+            if (static_cast<int>(all.size()) > topK) { all.resize(static_cast<std::size_t>(topK)); }
+            scores.topK = QVector<CScoredModelId>(all.cbegin(), all.cend());
+            return scores;
+        }
+    } // namespace
+} // namespace
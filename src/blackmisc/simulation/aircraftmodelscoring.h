@@ -0,0 +1,75 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_AIRCRAFTMODELSCORING_H
+#define BLACKMISC_SIMULATION_AIRCRAFTMODELSCORING_H
+
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QVector>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        //! Score of a model, id is the index in the scored list
+        struct BLACKMISC_EXPORT CScoredModelId
+        {
+            int id = -1;    //!< model index
+            int score = -1; //!< score
+        };
+
+        //! Result of CAircraftModelScoring::scoreTopK
+        struct BLACKMISC_EXPORT CAircraftModelScores
+        {
+            int maxScore = -1;               //!< best score, -1 if nothing was scored
+            QVector<int> maxScoreIds;        //!< all models with the best score, ascending ids
+            QVector<CScoredModelId> topK;    //!< best K scores, highest score first (same score: lower id first)
+            int scored = 0;                  //!< models scored
+            int pruned = 0;                  //!< models skipped, as they could not beat the best score
+
+            //! Nothing scored
+            bool isEmpty() const { return maxScoreIds.isEmpty(); }
+        };
+
+        //! Scoring of (large) model sets for the score based matching
+        //! \details Same scores as CAircraftModelList::scoreFull, but
+        //!          - the models are scored in parallel chunks,
+        //!          - only the best score(s) are kept, not a map of all model copies,
+        //!          - models whose CAircraftModel::calculateScoreUpperBound cannot reach the best score are skipped.
+        //! \remark no logging, use CAircraftModelList::scoreFull for a detailed log
+        class BLACKMISC_EXPORT CAircraftModelScoring
+        {
+        public:
+            //! Min. models per thread
+            static constexpr int MinChunkSize = 1024;
+
+            //! Score the models
+            //! \param models the models, ids are the indexes in this list
+            //! \param remoteModel model to be matched
+            //! \param preferColorLiveries see CAircraftModel::calculateScore
+            //! \param ignoreZeroScores models with score 0 are not considered
+            //! \param topK number of best scores kept in CAircraftModelScores::topK, 0 for only the best score
+            //! \param maxThreads threads used (calling thread and global QThreadPool), -1 ideal thread count, 1 runs in the calling thread
+            //! \threadsafe
+            static CAircraftModelScores scoreTopK(const CAircraftModelList &models, const CAircraftModel &remoteModel, bool preferColorLiveries, bool ignoreZeroScores = true, int topK = 0, int maxThreads = -1);
+
+            //! Same as scoreTopK, but without skipping models (reference for testing)
+            static CAircraftModelScores scoreTopKNoPruning(const CAircraftModelList &models, const CAircraftModel &remoteModel, bool preferColorLiveries, bool ignoreZeroScores = true, int topK = 0, int maxThreads = -1);
+
+        private:
+            //! Implementation
+            static CAircraftModelScores scoreTopKImpl(const CAircraftModelList &models, const CAircraftModel &remoteModel, bool preferColorLiveries, bool ignoreZeroScores, int topK, int maxThreads, bool prune);
+        };
+    } // namespace
+} // namespace
+
+#endif // guard
@@ -0,0 +1,457 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/aircraftmodelsetindex.h"
+#include "blackmisc/simulation/modelsetchanges.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/airlineicaocode.h"
+#include "blackmisc/aviation/livery.h"
+
+#include <algorithm>
+#include <numeric>
+
+using namespace BlackMisc::Aviation;
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        namespace
+        {
+            //! Upper case model string and alias of the model, without duplicates
+            QStringList modelStringKeys(const CAircraftModel &model)
+            {
+                QStringList keys;
+                if (model.hasModelString()) { keys.push_back(model.getModelString().toUpper()); }
+                if (!model.getModelStringAlias().isEmpty())
+                {
+                    const QString alias = model.getModelStringAlias().toUpper();
+                    if (!keys.contains(alias)) { keys.push_back(alias); }
+                }
+                return keys;
+            }
+
+            //! Keep the lowest id for key
+            void insertFirst(QHash<QString, int> &index, const QString &key, int id)
+            {
+                const auto it = index.find(key);
+                if (it == index.end()) { index.insert(key, id); }
+                else if (it.value() > id) { it.value() = id; }
+            }
+
+            //! Insert into sorted id list
+            template <class K>
+            void insertSorted(QHash<K, CAircraftModelSetIndex::Ids> &index, const K &key, int id)
+            {
+                CAircraftModelSetIndex::Ids &ids = index[key];
+                if (ids.isEmpty() || ids.back() < id) { ids.push_back(id); return; } // ascending ids, as in the ctor
+                const auto it = std::lower_bound(ids.begin(), ids.end(), id);
+                if (it == ids.end() || *it != id) { ids.insert(it, id); }
+            }
+
+            //! Remove from sorted id list, empty lists are removed
+            template <class K>
+            void eraseSorted(QHash<K, CAircraftModelSetIndex::Ids> &index, const K &key, int id)
+            {
+                const auto it = index.find(key);
+                if (it == index.end()) { return; }
+                CAircraftModelSetIndex::Ids &ids = it.value();
+                const auto idIt = std::lower_bound(ids.begin(), ids.end(), id);
+                if (idIt != ids.end() && *idIt == id) { ids.erase(idIt); }
+                if (ids.isEmpty()) { index.erase(it); }
+            }
+
+            //! Map the ids of all lists, mapping keeps the order
+            template <class K>
+            void remap(QHash<K, CAircraftModelSetIndex::Ids> &index, const QVector<int> &newIds)
+            {
+                for (CAircraftModelSetIndex::Ids &ids : index)
+                {
+                    for (int &id : ids) { id = newIds.at(id); }
+                }
+            }
+
+            //! Flags of the remaining ids
+            QBitArray compact(const QBitArray &flags, const QVector<int> &newIds, int newSize)
+            {
+                QBitArray compacted(newSize);
+                for (int id = 0; id < newIds.size(); id++)
+                {
+                    if (newIds.at(id) >= 0) { compacted.setBit(newIds.at(id), flags.testBit(id)); }
+                }
+                return compacted;
+            }
+        }
+
+        CAircraftModelSetIndex::CAircraftModelSetIndex(const CAircraftModelList &models) : m_models(models)
+        {
+            const int size = m_models.sizeInt();
+            m_military.resize(size);
+            m_vtol.resize(size);
+            m_colorLivery.resize(size);
+            m_modelString.resize(size);
+            m_dbKey.resize(size);
+            m_excluded.resize(size);
+
+            // ids are added in ascending order, so all index lists are sorted
+            for (int id = 0; id < size; id++)
+            {
+                this->indexModel(id);
+            }
+        }
+
+        CAircraftModelSetIndex CAircraftModelSetIndex::withChanges(const CModelSetChanges &changes) const
+        {
+            if (changes.isEmpty()) { return *this; }
+            if (!changes.isReplacement() && changes.size() * RebuildFraction <= this->size() && !this->hasDuplicateModelStrings())
+            {
+                CAircraftModelSetIndex index(*this);
+                if (index.applyChanges(changes)) { return index; }
+            }
+
+            CAircraftModelList models(m_models);
+            changes.applyTo(models);
+            return CAircraftModelSetIndex(models);
+        }
+
+        CAircraftModelSetIndex::Ids CAircraftModelSetIndex::allIds() const
+        {
+            Ids ids(this->size());
+            std::iota(ids.begin(), ids.end(), 0);
+            return ids;
+        }
+
+        CAircraftModelList CAircraftModelSetIndex::toModels(const Ids &ids) const
+        {
+            // whole set, no copy of the models
+            if (ids.size() == this->size() && std::is_sorted(ids.cbegin(), ids.cend())) { return m_models; }
+
+            CAircraftModelList models;
+            for (int id : ids) { models.push_back(m_models[id]); }
+            return models;
+        }
+
+        CAircraftModelSetIndex::Ids CAircraftModelSetIndex::toIds(const CAircraftModelList &models) const
+        {
+            Ids ids;
+            ids.reserve(models.sizeInt());
+            for (const CAircraftModel &model : models)
+            {
+                const int id = m_byModelString.value(model.getModelString().toUpper(), -1);
+                if (id >= 0) { ids.push_back(id); }
+            }
+            return ids;
+        }
+
+        int CAircraftModelSetIndex::findFirstByModelStringOrAlias(const QString &modelString) const
+        {
+            if (modelString.isEmpty()) { return -1; }
+            return m_byModelStringOrAlias.value(modelString.toUpper(), -1);
+        }
+
+        const CAircraftModelSetIndex::Ids &CAircraftModelSetIndex::findByAircraftDesignator(const QString &designator) const
+        {
+            return lookup(m_byAircraftDesignator, designator);
+        }
+
+        const CAircraftModelSetIndex::Ids &CAircraftModelSetIndex::findByAirlineDesignator(const QString &designator) const
+        {
+            return lookup(m_byAirlineDesignator, designator);
+        }
+
+        const CAircraftModelSetIndex::Ids &CAircraftModelSetIndex::findByAirlineGroup(int groupId) const
+        {
+            static const Ids empty;
+            if (groupId < 0) { return empty; }
+            const auto it = m_byAirlineGroup.constFind(groupId);
+            return it == m_byAirlineGroup.constEnd() ? empty : it.value();
+        }
+
+        const CAircraftModelSetIndex::Ids &CAircraftModelSetIndex::findByFamily(const QString &family) const
+        {
+            static const Ids empty;
+            if (family.isEmpty()) { return empty; }
+            return lookup(m_byFamily, family.toUpper().trimmed());
+        }
+
+        const CAircraftModelSetIndex::Ids &CAircraftModelSetIndex::findByManufacturer(const QString &manufacturer) const
+        {
+            static const Ids empty;
+            if (manufacturer.isEmpty()) { return empty; }
+            return lookup(m_byManufacturer, manufacturer.toUpper().trimmed());
+        }
+
+        CAircraftModelSetIndex::Ids CAircraftModelSetIndex::findByCombinedType(const Ids &ids, const QString &combinedType) const
+        {
+            if (combinedType.length() != 3) { return {}; }
+            const QString cc(combinedType.toUpper().trimmed().replace(' ', '*').replace('-', '*'));
+            if (!cc.contains('*')) { return intersect(ids, lookup(m_byCombinedType, cc)); }
+
+            // wildcards, no index
+            Ids found;
+            for (int id : ids)
+            {
+                if (m_models[id].getAircraftIcaoCode().matchesCombinedType(cc)) { found.push_back(id); }
+            }
+            return found;
+        }
+
+        CAircraftModelSetIndex::Ids CAircraftModelSetIndex::findByCombinedAndManufacturer(const Ids &ids, const QString &combinedType, const QString &manufacturer) const
+        {
+            if (manufacturer.isEmpty()) { return this->findByCombinedType(ids, combinedType); }
+            if (combinedType.isEmpty()) { return intersect(ids, this->findByManufacturer(manufacturer)); }
+
+            Ids found;
+            for (int id : this->findByCombinedType(ids, combinedType))
+            {
+                if (m_models[id].getAircraftIcaoCode().matchesManufacturer(manufacturer)) { found.push_back(id); }
+            }
+            return found;
+        }
+
+        CAircraftModelSetIndex::Ids CAircraftModelSetIndex::findByAircraftDesignatorAndLiveryCombinedCode(const Ids &ids, const QString &aircraftDesignator, const QString &combinedCode) const
+        {
+            if (aircraftDesignator.isEmpty()) { return {}; }
+            Ids found;
+            for (int id : intersect(ids, lookup(m_byAircraftDesignator, aircraftDesignator.trimmed().toUpper())))
+            {
+                if (m_models[id].getLivery().matchesCombinedCode(combinedCode)) { found.push_back(id); }
+            }
+            return found;
+        }
+
+        bool CAircraftModelSetIndex::containsVtol(const Ids &ids) const
+        {
+            return std::any_of(ids.cbegin(), ids.cend(), [this](int id) { return m_vtol.testBit(id); });
+        }
+
+        CAircraftModelSetIndex::Ids CAircraftModelSetIndex::intersect(const Ids &ids, const Ids &sortedIds)
+        {
+            if (ids.isEmpty() || sortedIds.isEmpty()) { return {}; }
+            Ids result;
+            for (int id : ids)
+            {
+                if (std::binary_search(sortedIds.cbegin(), sortedIds.cend(), id)) { result.push_back(id); }
+            }
+            return result;
+        }
+
+        CAircraftModelSetIndex::Ids CAircraftModelSetIndex::appendMissing(const Ids &ids, const Ids &ids2)
+        {
+            Ids sorted(ids);
+            std::sort(sorted.begin(), sorted.end());
+            Ids result(ids);
+            for (int id : ids2)
+            {
+                if (!std::binary_search(sorted.cbegin(), sorted.cend(), id)) { result.push_back(id); }
+            }
+            return result;
+        }
+
+        CAircraftModelSetIndex::Ids CAircraftModelSetIndex::replaceOrAdd(const Ids &ids, const Ids &ids2)
+        {
+            if (ids2.isEmpty()) { return ids; }
+            Ids sorted(ids2);
+            std::sort(sorted.begin(), sorted.end());
+            Ids result;
+            for (int id : ids)
+            {
+                if (!std::binary_search(sorted.cbegin(), sorted.cend(), id)) { result.push_back(id); }
+            }
+            result += ids2;
+            return result;
+        }
+
+        bool CAircraftModelSetIndex::applyChanges(const CModelSetChanges &changes)
+        {
+            // same order as CModelSetChanges::applyTo: remove, update in place, append
+            QSet<QString> dirtyKeys;
+            Ids removedIds;
+            for (const QString &modelString : changes.getRemoved())
+            {
+                const int id = m_byModelString.value(modelString.toUpper(), -1);
+                if (id < 0) { continue; } // not in set
+                this->unindexModel(id, dirtyKeys);
+                removedIds.push_back(id);
+            }
+            if (!removedIds.isEmpty())
+            {
+                std::sort(removedIds.begin(), removedIds.end());
+                this->removeIds(removedIds);
+            }
+
+            for (const CAircraftModel &model : changes.getUpdated())
+            {
+                const int id = m_byModelString.value(model.getModelString().toUpper(), -1);
+                if (id < 0) { return false; }
+                this->unindexModel(id, dirtyKeys);
+                m_models[id] = model;
+                this->indexModel(id);
+            }
+
+            for (const CAircraftModel &model : changes.getAdded())
+            {
+                if (model.hasModelString() && m_byModelString.contains(model.getModelString().toUpper())) { return false; }
+                const int id = m_models.sizeInt();
+                m_models.push_back(model);
+                const int size = id + 1;
+                m_military.resize(size);
+                m_vtol.resize(size);
+                m_colorLivery.resize(size);
+                m_modelString.resize(size);
+                m_dbKey.resize(size);
+                m_excluded.resize(size);
+                this->indexModel(id);
+            }
+
+            if (!dirtyKeys.isEmpty()) { this->rescanKeys(dirtyKeys); }
+            return true;
+        }
+
+        void CAircraftModelSetIndex::indexModel(int id)
+        {
+            const CAircraftModel &model = m_models[id];
+            const CAircraftIcaoCode &aircraftIcao = model.getAircraftIcaoCode();
+            const CAirlineIcaoCode &airlineIcao = model.getAirlineIcaoCode();
+
+            if (model.hasModelString()) { insertFirst(m_byModelString, model.getModelString().toUpper(), id); }
+            for (const QString &key : modelStringKeys(model))
+            {
+                insertFirst(m_byModelStringOrAlias, key, id);
+                m_keyCounts[key]++;
+            }
+
+            insertSorted(m_byAircraftDesignator, aircraftIcao.getDesignator(), id);
+            insertSorted(m_byAirlineDesignator, airlineIcao.getDesignator(), id);
+            insertSorted(m_byManufacturer, aircraftIcao.getManufacturer(), id);
+            insertSorted(m_byCombinedType, aircraftIcao.getCombinedType(), id);
+            if (aircraftIcao.hasFamily()) { insertSorted(m_byFamily, aircraftIcao.getFamily(), id); }
+            if (airlineIcao.getGroupId() >= 0) { insertSorted(m_byAirlineGroup, airlineIcao.getGroupId(), id); }
+
+            m_military.setBit(id, model.isMilitary());
+            m_vtol.setBit(id, model.isVtol());
+            m_colorLivery.setBit(id, model.getLivery().isColorLivery());
+            m_modelString.setBit(id, model.hasModelString());
+            m_dbKey.setBit(id, model.hasValidDbKey());
+            m_excluded.setBit(id, model.getModelMode() == CAircraftModel::Exclude);
+        }
+
+        void CAircraftModelSetIndex::unindexModel(int id, QSet<QString> &dirtyKeys)
+        {
+            const CAircraftModel &model = m_models[id];
+            const CAircraftIcaoCode &aircraftIcao = model.getAircraftIcaoCode();
+            const CAirlineIcaoCode &airlineIcao = model.getAirlineIcaoCode();
+
+            for (const QString &key : modelStringKeys(model))
+            {
+                const int count = --m_keyCounts[key];
+                if (count < 1)
+                {
+                    // no other model uses the key
+                    m_keyCounts.remove(key);
+                    m_byModelString.remove(key);
+                    m_byModelStringOrAlias.remove(key);
+                    continue;
+                }
+                // another model might be the first one now
+                if (m_byModelString.value(key, -1) == id)
+                {
+                    m_byModelString.remove(key);
+                    dirtyKeys.insert(key);
+                }
+                if (m_byModelStringOrAlias.value(key, -1) == id)
+                {
+                    m_byModelStringOrAlias.remove(key);
+                    dirtyKeys.insert(key);
+                }
+            }
+
+            eraseSorted(m_byAircraftDesignator, aircraftIcao.getDesignator(), id);
+            eraseSorted(m_byAirlineDesignator, airlineIcao.getDesignator(), id);
+            eraseSorted(m_byManufacturer, aircraftIcao.getManufacturer(), id);
+            eraseSorted(m_byCombinedType, aircraftIcao.getCombinedType(), id);
+            if (aircraftIcao.hasFamily()) { eraseSorted(m_byFamily, aircraftIcao.getFamily(), id); }
+            if (airlineIcao.getGroupId() >= 0) { eraseSorted(m_byAirlineGroup, airlineIcao.getGroupId(), id); }
+        }
+
+        void CAircraftModelSetIndex::removeIds(const Ids &sortedIds)
+        {
+            const int oldSize = this->size();
+            QVector<int> newIds(oldSize);
+            int newSize = 0;
+            for (int id = 0, r = 0; id < oldSize; id++)
+            {
+                if (r < sortedIds.size() && sortedIds.at(r) == id) { newIds[id] = -1; r++; }
+                else { newIds[id] = newSize++; }
+            }
+
+            for (auto it = sortedIds.crbegin(); it != sortedIds.crend(); ++it)
+            {
+                m_models.erase(m_models.begin() + *it);
+            }
+
+            for (int &id : m_byModelString) { id = newIds.at(id); }
+            for (int &id : m_byModelStringOrAlias) { id = newIds.at(id); }
+            remap(m_byAircraftDesignator, newIds);
+            remap(m_byAirlineDesignator, newIds);
+            remap(m_byFamily, newIds);
+            remap(m_byManufacturer, newIds);
+            remap(m_byCombinedType, newIds);
+            remap(m_byAirlineGroup, newIds);
+
+            m_military = compact(m_military, newIds, newSize);
+            m_vtol = compact(m_vtol, newIds, newSize);
+            m_colorLivery = compact(m_colorLivery, newIds, newSize);
+            m_modelString = compact(m_modelString, newIds, newSize);
+            m_dbKey = compact(m_dbKey, newIds, newSize);
+            m_excluded = compact(m_excluded, newIds, newSize);
+        }
+
+        void CAircraftModelSetIndex::rescanKeys(const QSet<QString> &keys)
+        {
+            for (const QString &key : keys)
+            {
+                m_byModelString.remove(key);
+                m_byModelStringOrAlias.remove(key);
+            }
+
+            for (int id = 0; id < this->size(); id++)
+            {
+                const CAircraftModel &model = m_models[id];
+                for (const QString &key : modelStringKeys(model))
+                {
+                    if (!keys.contains(key)) { continue; }
+                    if (model.hasModelString() && key == model.getModelString().toUpper()) { insertFirst(m_byModelString, key, id); }
+                    insertFirst(m_byModelStringOrAlias, key, id);
+                }
+            }
+        }
+
+        bool CAircraftModelSetIndex::hasDuplicateModelStrings() const
+        {
+            return m_byModelString.size() != m_modelString.count(true);
+        }
+
+        CAircraftModelSetIndex::Ids CAircraftModelSetIndex::filter(const Ids &ids, const QBitArray &flags, bool value)
+        {
+            Ids result;
+            for (int id : ids)
+            {
+                if (flags.testBit(id) == value) { result.push_back(id); }
+            }
+            return result;
+        }
+
+        const CAircraftModelSetIndex::Ids &CAircraftModelSetIndex::lookup(const QHash<QString, Ids> &index, const QString &key)
+        {
+            static const Ids empty;
+            const auto it = index.constFind(key);
+            return it == index.constEnd() ? empty : it.value();
+        }
+    } // namespace
+} // namespace
@@ -0,0 +1,189 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_AIRCRAFTMODELSETINDEX_H
+#define BLACKMISC_SIMULATION_AIRCRAFTMODELSETINDEX_H
+
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QBitArray>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        class CModelSetChanges;
+
+        //! Immutable, pre-indexed model set for model matching
+        //! \details Models are addressed by their position in the set (id). Lookups return ascending id lists,
+        //!          reduction steps work on id lists, so no models are copied until the final candidates are needed.
+        //! \remark results are the same (and in the same order) as the corresponding CAircraftModelList::findBy... functions
+        class BLACKMISC_EXPORT CAircraftModelSetIndex
+        {
+        public:
+            //! Model ids (positions in the set)
+            using Ids = QVector<int>;
+
+            //! Default ctor, empty set
+            CAircraftModelSetIndex() {}
+
+            //! Ctor, builds the indexes
+            explicit CAircraftModelSetIndex(const CAircraftModelList &models);
+
+            //! Index of the set with the changes applied
+            //! \details The indexes are updated for the changed models only, unless the changes are a replacement,
+            //!          affect a large part of the set, or the set has duplicate model strings.
+            //! \remark same result as CAircraftModelSetIndex(models) with the changes applied to the models
+            CAircraftModelSetIndex withChanges(const CModelSetChanges &changes) const;
+
+            //! The models
+            const CAircraftModelList &getModels() const { return m_models; }
+
+            //! Model by id
+            const CAircraftModel &getModel(int id) const { return m_models[id]; }
+
+            //! Number of models
+            int size() const { return m_models.sizeInt(); }
+
+            //! Empty?
+            bool isEmpty() const { return m_models.isEmpty(); }
+
+            //! All ids
+            Ids allIds() const;
+
+            //! Models for ids, in the order of the ids
+            CAircraftModelList toModels(const Ids &ids) const;
+
+            //! Ids of models (by model string), unknown models are ignored
+            Ids toIds(const CAircraftModelList &models) const;
+
+            //! First model (in set order) with the given model string or alias (case insensitive)
+            //! \return id or -1
+            int findFirstByModelStringOrAlias(const QString &modelString) const;
+
+            //! \name Index lookups
+            //! @{
+
+            //! Models with aircraft ICAO designator, like CAircraftModelList::findByIcaoDesignators without airline
+            const Ids &findByAircraftDesignator(const QString &designator) const;
+
+            //! Models with airline ICAO designator, like CAircraftModelList::findByIcaoDesignators without aircraft
+            const Ids &findByAirlineDesignator(const QString &designator) const;
+
+            //! Models whose airline is member of the group, like CAircraftModelList::findByAirlineGroup
+            const Ids &findByAirlineGroup(int groupId) const;
+
+            //! Models of the aircraft family, like CAircraftModelList::findByFamily
+            const Ids &findByFamily(const QString &family) const;
+
+            //! Models by manufacturer, like CAircraftModelList::findByManufacturer
+            const Ids &findByManufacturer(const QString &manufacturer) const;
+            //! @}
+
+            //! \name Reductions of id lists
+            //! \remark result keeps the order of the input ids
+            //! @{
+
+            //! Like CAircraftModelList::findByCombinedType
+            Ids findByCombinedType(const Ids &ids, const QString &combinedType) const;
+
+            //! Like CAircraftModelList::findByCombinedAndManufacturer
+            Ids findByCombinedAndManufacturer(const Ids &ids, const QString &combinedType, const QString &manufacturer) const;
+
+            //! Like CAircraftModelList::findByAircraftDesignatorAndLiveryCombinedCode
+            Ids findByAircraftDesignatorAndLiveryCombinedCode(const Ids &ids, const QString &aircraftDesignator, const QString &combinedCode) const;
+
+            //! Like CAircraftModelList::findByMilitaryFlag
+            Ids findByMilitaryFlag(const Ids &ids, bool military) const { return filter(ids, m_military, military); }
+
+            //! Like CAircraftModelList::findByVtolFlag
+            Ids findByVtolFlag(const Ids &ids, bool vtol) const { return filter(ids, m_vtol, vtol); }
+
+            //! Like CAircraftModelList::findColorLiveries
+            Ids findColorLiveries(const Ids &ids) const { return filter(ids, m_colorLivery, true); }
+
+            //! Models with model string
+            Ids findWithModelString(const Ids &ids) const { return filter(ids, m_modelString, true); }
+
+            //! Models with DB key
+            Ids findWithDbKey(const Ids &ids) const { return filter(ids, m_dbKey, true); }
+
+            //! Models not marked as excluded
+            Ids findNotExcluded(const Ids &ids) const { return filter(ids, m_excluded, false); }
+
+            //! Any VTOL model?
+            bool containsVtol(const Ids &ids) const;
+            //! @}
+
+            //! Ids which are also in sortedIds, order of ids is kept
+            static Ids intersect(const Ids &ids, const Ids &sortedIds);
+
+            //! ids followed by ids2 not already in ids
+            static Ids appendMissing(const Ids &ids, const Ids &ids2);
+
+            //! ids without ids2, followed by ids2 (like CAircraftModelList::replaceOrAddModelsWithString)
+            static Ids replaceOrAdd(const Ids &ids, const Ids &ids2);
+
+        private:
+            //! Above changes per model the index is rebuilt
+            static constexpr int RebuildFraction = 8;
+
+            //! Apply the changes to the models and indexes
+            //! \return false if the index needs to be rebuilt
+            bool applyChanges(const CModelSetChanges &changes);
+
+            //! Add model to the indexes
+            void indexModel(int id);
+
+            //! Remove model from the indexes
+            //! \remark model string keys needing a rescan are added to dirtyKeys
+            void unindexModel(int id, QSet<QString> &dirtyKeys);
+
+            //! Remove the (already unindexed) models, the remaining models get new ids
+            void removeIds(const Ids &sortedIds);
+
+            //! Find the first models for the model string keys again
+            void rescanKeys(const QSet<QString> &keys);
+
+            //! Several models with the same model string?
+            bool hasDuplicateModelStrings() const;
+
+            //! Ids where the flag has the given value
+            static Ids filter(const Ids &ids, const QBitArray &flags, bool value);
+
+            //! Lookup in index, empty ids if not found
+            static const Ids &lookup(const QHash<QString, Ids> &index, const QString &key);
+
+            CAircraftModelList   m_models;
+            QHash<QString, int>  m_byModelString;        //!< upper case model string, first id
+            QHash<QString, int>  m_byModelStringOrAlias; //!< upper case model string or alias, first id
+            QHash<QString, int>  m_keyCounts;            //!< number of models using the upper case model string or alias
+            QHash<QString, Ids>  m_byAircraftDesignator;
+            QHash<QString, Ids>  m_byAirlineDesignator;
+            QHash<QString, Ids>  m_byFamily;
+            QHash<QString, Ids>  m_byManufacturer;
+            QHash<QString, Ids>  m_byCombinedType;
+            QHash<int, Ids>      m_byAirlineGroup;
+            QBitArray            m_military;
+            QBitArray            m_vtol;
+            QBitArray            m_colorLivery;
+            QBitArray            m_modelString;
+            QBitArray            m_dbKey;
+            QBitArray            m_excluded;
+        };
+    } // namespace
+} // namespace
+
+#endif // guard
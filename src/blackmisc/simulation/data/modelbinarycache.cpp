@@ -0,0 +1,434 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/data/modelbinarycache.h"
+#include "blackmisc/simulation/distributor.h"
+#include "blackmisc/simulation/simulatorinfo.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/livery.h"
+#include "blackmisc/pq/length.h"
+#include "blackmisc/atomicfile.h"
+#include "blackmisc/logcategories.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutexLocker>
+#include <cstring>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::PhysicalQuantities;
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        namespace Data
+        {
+            namespace
+            {
+                //! Number of tables
+                constexpr int TableCount = 6;
+
+                //! File header, values in the byte order of the writing machine
+                struct FileHeader
+                {
+                    char    magic[4];                  //!< "SWMC"
+                    quint32 version;                   //!< CModelBinaryCache::Version
+                    quint32 byteOrder;                 //!< 0x01020304 as written
+                    quint32 recordSize;                //!< size of a model record
+                    qint64  cacheTimestamp;            //!< timestamp of the data cache value
+                    quint32 modelCount;                //!< number of records
+                    quint32 reserved;                  //!< 0
+                    quint64 tableOffsets[TableCount];  //!< strings, ICAO codes, liveries, distributors, callsigns, CGs
+                    quint64 recordsOffset;             //!< first record
+                };
+
+                constexpr char    Magic[4] = { 'S', 'W', 'M', 'C' };
+                constexpr quint32 ByteOrder = 0x01020304;
+
+                //! QDataStream version for the objects
+                constexpr int StreamVersion = QDataStream::Qt_5_12;
+
+                //! Pad to a multiple of 8
+                void align(QByteArray &out)
+                {
+                    while (out.size() % 8 != 0) { out.append('\0'); }
+                }
+
+                //! Collects distinct entries of a table
+                class CTableWriter
+                {
+                public:
+                    //! Add entry, returns index
+                    quint32 add(const QByteArray &entry)
+                    {
+                        const auto it = m_index.constFind(entry);
+                        if (it != m_index.constEnd()) { return it.value(); }
+                        const quint32 index = static_cast<quint32>(m_entries.size());
+                        m_entries.push_back(entry);
+                        m_index.insert(entry, index);
+                        return index;
+                    }
+
+                    //! Add serialized object
+                    template <class T> quint32 addObject(const T &object)
+                    {
+                        QByteArray bytes;
+                        QDataStream stream(&bytes, QIODevice::WriteOnly);
+                        stream.setVersion(StreamVersion);
+                        object.marshalToDataStream(stream);
+                        return this->add(bytes);
+                    }
+
+                    //! Append table: count, count + 1 offsets, data
+                    void write(QByteArray &out) const
+                    {
+                        const quint32 count = static_cast<quint32>(m_entries.size());
+                        QVector<quint32> offsets;
+                        offsets.reserve(m_entries.size() + 1);
+                        quint32 offset = 0;
+                        for (const QByteArray &entry : m_entries)
+                        {
+                            offsets.push_back(offset);
+                            offset += static_cast<quint32>(entry.size());
+                        }
+                        offsets.push_back(offset);
+
+                        out.append(reinterpret_cast<const char *>(&count), sizeof(count));
+                        out.append(reinterpret_cast<const char *>(&offset), sizeof(offset)); // data size
+                        out.append(reinterpret_cast<const char *>(offsets.constData()), offsets.size() * static_cast<int>(sizeof(quint32)));
+                        for (const QByteArray &entry : m_entries) { out.append(entry); }
+                        align(out);
+                    }
+
+                private:
+                    QVector<QByteArray> m_entries;
+                    QHash<QByteArray, quint32> m_index;
+                };
+
+                //! Read a value from unaligned memory
+                template <class T> T readAt(const uchar *data)
+                {
+                    T value;
+                    std::memcpy(&value, data, sizeof(T));
+                    return value;
+                }
+            }
+
+            struct CModelBinaryCache::ModelRecord
+            {
+                quint32 modelString;
+                quint32 modelStringAlias;
+                quint32 name;
+                quint32 description;
+                quint32 fileName;
+                quint32 iconFile;
+                quint32 supportedParts;
+                quint32 aircraftIcao;
+                quint32 livery;
+                quint32 distributor;
+                quint32 callsign;
+                quint32 cg;
+                qint32  dbKey;
+                qint32  order;
+                qint32  simulator;
+                qint32  modelType;
+                qint32  modelMode;
+                qint32  reserved;
+                qint64  timestamp;
+                qint64  fileTimestamp;
+            };
+
+            struct CModelBinaryCache::DecodedTables
+            {
+                QVector<QString> strings;
+                QVector<CAircraftIcaoCode> aircraftIcaoCodes;
+                QVector<CLivery> liveries;
+                QVector<CDistributor> distributors;
+                QVector<CCallsign> callsigns;
+                QVector<CLength> cgs;
+            };
+
+            CModelBinaryCache::~CModelBinaryCache()
+            {
+                if (m_data && m_file.isOpen()) { m_file.unmap(const_cast<uchar *>(m_data)); }
+            }
+
+            QString CModelBinaryCache::binaryFileName(const QString &jsonFileName)
+            {
+                if (jsonFileName.isEmpty()) { return {}; }
+                const QFileInfo fi(jsonFileName);
+                return QDir(fi.absolutePath()).filePath(fi.completeBaseName() + QStringLiteral(".bin"));
+            }
+
+            QByteArray CModelBinaryCache::toBinary(const CAircraftModelList &models, qint64 cacheTimestamp)
+            {
+                static_assert(sizeof(ModelRecord) == 88, "Record size is part of the format");
+                CTableWriter strings;
+                CTableWriter aircraftIcaoCodes;
+                CTableWriter liveries;
+                CTableWriter distributors;
+                CTableWriter callsigns;
+                CTableWriter cgs;
+
+                QVector<ModelRecord> records;
+                records.reserve(models.size());
+                for (const CAircraftModel &model : models)
+                {
+                    ModelRecord r;
+                    std::memset(&r, 0, sizeof(r));
+                    r.modelString = strings.add(model.getModelString().toUtf8());
+                    r.modelStringAlias = strings.add(model.getModelStringAlias().toUtf8());
+                    r.name = strings.add(model.getName().toUtf8());
+                    r.description = strings.add(model.getDescription().toUtf8());
+                    r.fileName = strings.add(model.getFileName().toUtf8());
+                    r.iconFile = strings.add(model.getIconFile().toUtf8());
+                    r.supportedParts = strings.add(model.getSupportedParts().toUtf8());
+                    r.aircraftIcao = aircraftIcaoCodes.addObject(model.getAircraftIcaoCode());
+                    r.livery = liveries.addObject(model.getLivery());
+                    r.distributor = distributors.addObject(model.getDistributor());
+                    r.callsign = callsigns.addObject(model.getCallsign());
+                    r.cg = cgs.addObject(model.getCG());
+                    r.dbKey = model.getDbKey();
+                    r.order = model.getOrder();
+                    r.simulator = static_cast<qint32>(model.getSimulator().getSimulator());
+                    r.modelType = static_cast<qint32>(model.getModelType());
+                    r.modelMode = static_cast<qint32>(model.getModelMode());
+                    r.timestamp = model.getMSecsSinceEpoch();
+                    r.fileTimestamp = model.hasValidFileTimestamp() ? model.getFileTimestamp().toMSecsSinceEpoch() : -1;
+                    records.push_back(r);
+                }
+
+                FileHeader header;
+                std::memset(&header, 0, sizeof(header));
+                std::memcpy(header.magic, Magic, sizeof(Magic));
+                header.version = Version;
+                header.byteOrder = ByteOrder;
+                header.recordSize = sizeof(ModelRecord);
+                header.cacheTimestamp = cacheTimestamp;
+                header.modelCount = static_cast<quint32>(records.size());
+
+                QByteArray out(sizeof(FileHeader), '\0');
+                align(out);
+                const CTableWriter *tables[TableCount] = { &strings, &aircraftIcaoCodes, &liveries, &distributors, &callsigns, &cgs };
+                for (int t = 0; t < TableCount; t++)
+                {
+                    header.tableOffsets[t] = static_cast<quint64>(out.size());
+                    tables[t]->write(out);
+                }
+                header.recordsOffset = static_cast<quint64>(out.size());
+                out.append(reinterpret_cast<const char *>(records.constData()), records.size() * static_cast<int>(sizeof(ModelRecord)));
+                std::memcpy(out.data(), &header, sizeof(header));
+                return out;
+            }
+
+            CStatusMessage CModelBinaryCache::write(const CAircraftModelList &models, qint64 cacheTimestamp, const QString &fileName)
+            {
+                static const CLogCategoryList cats({ CLogCategories::modelCache() });
+                if (fileName.isEmpty()) { return CStatusMessage(cats).error(u"No binary model cache file"); }
+                if (!QDir().mkpath(QFileInfo(fileName).absolutePath()))
+                {
+                    return CStatusMessage(cats).error(u"Failed to create directory for '%1'") << fileName;
+                }
+
+                const QByteArray data = CModelBinaryCache::toBinary(models, cacheTimestamp);
+                CAtomicFile file(fileName);
+                if (!file.open(QFile::WriteOnly))
+                {
+                    return CStatusMessage(cats).error(u"Failed to open %1: %2") << fileName << file.errorString();
+                }
+                if (file.write(data) != data.size() || !file.checkedClose())
+                {
+                    return CStatusMessage(cats).error(u"Failed to write to %1: %2") << fileName << file.errorString();
+                }
+                return CStatusMessage(cats).info(u"Written %1 models (%2 bytes) to '%3'") << models.size() << data.size() << fileName;
+            }
+
+            bool CModelBinaryCache::open(const QString &fileName)
+            {
+                if (m_data) { return false; }
+                m_file.setFileName(fileName);
+                m_fileName = fileName;
+                if (!m_file.open(QFile::ReadOnly)) { return false; }
+                const qint64 size = m_file.size();
+                const uchar *data = size > 0 ? m_file.map(0, size) : nullptr;
+                if (!data)
+                {
+                    m_file.close();
+                    return false;
+                }
+                if (!this->init(data, size))
+                {
+                    m_file.unmap(const_cast<uchar *>(data));
+                    m_file.close();
+                    return false;
+                }
+                m_data = data;
+                m_size = size;
+                return true;
+            }
+
+            bool CModelBinaryCache::init(const uchar *data, qint64 size)
+            {
+                if (size < static_cast<qint64>(sizeof(FileHeader))) { return false; }
+                const FileHeader header = readAt<FileHeader>(data);
+                if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0) { return false; }
+                if (header.version != Version || header.byteOrder != ByteOrder) { return false; }
+                if (header.recordSize != sizeof(ModelRecord)) { return false; }
+
+                const quint64 recordsEnd = header.recordsOffset + static_cast<quint64>(header.modelCount) * sizeof(ModelRecord);
+                if (header.recordsOffset > static_cast<quint64>(size) || recordsEnd > static_cast<quint64>(size)) { return false; }
+
+                // the data are only used when they are all valid
+                m_data = data;
+                m_size = size;
+                ObjectTable *tables[TableCount] = { &m_strings, &m_aircraftIcaoCodes, &m_liveries, &m_distributors, &m_callsigns, &m_cgs };
+                bool ok = true;
+                for (int t = 0; t < TableCount && ok; t++) { ok = this->initTable(*tables[t], header.tableOffsets[t]); }
+                m_data = nullptr;
+                m_size = 0;
+                if (!ok) { return false; }
+
+                m_records = data + header.recordsOffset;
+                m_modelCount = static_cast<int>(header.modelCount);
+                m_cacheTimestamp = header.cacheTimestamp;
+                return true;
+            }
+
+            bool CModelBinaryCache::initTable(ObjectTable &table, quint64 offset) const
+            {
+                const quint64 size = static_cast<quint64>(m_size);
+                if (offset + 2 * sizeof(quint32) > size) { return false; }
+                table.count = readAt<quint32>(m_data + offset);
+                table.size = readAt<quint32>(m_data + offset + sizeof(quint32));
+                const quint64 offsetsStart = offset + 2 * sizeof(quint32);
+                const quint64 dataStart = offsetsStart + (static_cast<quint64>(table.count) + 1) * sizeof(quint32);
+                if (dataStart + table.size > size) { return false; }
+                table.offsets = m_data + offsetsStart;
+                table.data = m_data + dataStart;
+                return true;
+            }
+
+            CModelBinaryCache::ModelRecord CModelBinaryCache::record(int index) const
+            {
+                return readAt<ModelRecord>(m_records + static_cast<qint64>(index) * static_cast<qint64>(sizeof(ModelRecord)));
+            }
+
+            QByteArray CModelBinaryCache::object(const ObjectTable &table, quint32 index) const
+            {
+                if (index >= table.count) { return {}; }
+                const quint32 begin = readAt<quint32>(table.offsets + index * sizeof(quint32));
+                const quint32 end = readAt<quint32>(table.offsets + (index + 1) * sizeof(quint32));
+                if (begin > end || end > table.size) { return {}; }
+
+                // no copy, only valid as long as the file is mapped
+                return QByteArray::fromRawData(reinterpret_cast<const char *>(table.data + begin), static_cast<int>(end - begin));
+            }
+
+            QString CModelBinaryCache::string(quint32 index) const
+            {
+                const QByteArray utf8 = this->object(m_strings, index);
+                return QString::fromUtf8(utf8.constData(), utf8.size());
+            }
+
+            template <class T> T CModelBinaryCache::value(const ObjectTable &table, quint32 index) const
+            {
+                T v;
+                const QByteArray bytes = this->object(table, index);
+                if (bytes.isEmpty()) { return v; }
+                QDataStream stream(bytes);
+                stream.setVersion(StreamVersion);
+                v.unmarshalFromDataStream(stream);
+                return v;
+            }
+
+            template <class T> QVector<T> CModelBinaryCache::values(const ObjectTable &table) const
+            {
+                QVector<T> values;
+                values.reserve(static_cast<int>(table.count));
+                for (quint32 i = 0; i < table.count; i++) { values.push_back(this->value<T>(table, i)); }
+                return values;
+            }
+
+            QString CModelBinaryCache::getModelString(int index) const
+            {
+                if (!m_data || index < 0 || index >= m_modelCount) { return {}; }
+                return this->string(this->record(index).modelString);
+            }
+
+            CAircraftModel CModelBinaryCache::at(int index) const
+            {
+                if (!m_data || index < 0 || index >= m_modelCount) { return {}; }
+                return this->create(this->record(index), nullptr);
+            }
+
+            CAircraftModel CModelBinaryCache::create(const ModelRecord &r, const DecodedTables *decoded) const
+            {
+                // with decoded tables the models share the strings and objects
+                const auto str = [&](quint32 i) { return decoded ? decoded->strings.value(static_cast<int>(i)) : this->string(i); };
+
+                CAircraftModel model;
+                model.setModelString(str(r.modelString));
+                model.setModelStringAlias(str(r.modelStringAlias));
+                model.setName(str(r.name));
+                model.setDescription(str(r.description));
+                model.setFileName(str(r.fileName));
+                model.setIconFile(str(r.iconFile));
+                model.setSupportedParts(str(r.supportedParts));
+                if (decoded)
+                {
+                    model.setAircraftIcaoCode(decoded->aircraftIcaoCodes.value(static_cast<int>(r.aircraftIcao)));
+                    model.setLivery(decoded->liveries.value(static_cast<int>(r.livery)));
+                    model.setDistributor(decoded->distributors.value(static_cast<int>(r.distributor)));
+                    model.setCallsign(decoded->callsigns.value(static_cast<int>(r.callsign)));
+                    model.setCG(decoded->cgs.value(static_cast<int>(r.cg), CLength::null()));
+                }
+                else
+                {
+                    model.setAircraftIcaoCode(this->value<CAircraftIcaoCode>(m_aircraftIcaoCodes, r.aircraftIcao));
+                    model.setLivery(this->value<CLivery>(m_liveries, r.livery));
+                    model.setDistributor(this->value<CDistributor>(m_distributors, r.distributor));
+                    model.setCallsign(this->value<CCallsign>(m_callsigns, r.callsign));
+                    model.setCG(this->value<CLength>(m_cgs, r.cg));
+                }
+                model.setDbKey(r.dbKey);
+                model.setOrder(r.order);
+                model.setSimulator(CSimulatorInfo(static_cast<int>(r.simulator)));
+                model.setModelType(static_cast<CAircraftModel::ModelType>(r.modelType));
+                model.setModelMode(static_cast<CAircraftModel::ModelMode>(r.modelMode));
+                model.setMSecsSinceEpoch(r.timestamp);
+                model.setFileTimestamp(r.fileTimestamp);
+                return model;
+            }
+
+            CAircraftModelList CModelBinaryCache::toList() const
+            {
+                QMutexLocker lock(&m_listMutex);
+                if (m_listCreated || !m_data) { return m_list; }
+
+                DecodedTables decoded;
+                decoded.strings.reserve(static_cast<int>(m_strings.count));
+                for (quint32 i = 0; i < m_strings.count; i++) { decoded.strings.push_back(this->string(i)); }
+                decoded.aircraftIcaoCodes = this->values<CAircraftIcaoCode>(m_aircraftIcaoCodes);
+                decoded.liveries = this->values<CLivery>(m_liveries);
+                decoded.distributors = this->values<CDistributor>(m_distributors);
+                decoded.callsigns = this->values<CCallsign>(m_callsigns);
+                decoded.cgs = this->values<CLength>(m_cgs);
+
+                CAircraftModelList models;
+                for (int i = 0; i < m_modelCount; i++) { models.push_back(this->create(this->record(i), &decoded)); }
+                m_list = models;
+                m_listCreated = true;
+                return m_list;
+            }
+        } // ns
+    } // ns
+} // ns
@@ -0,0 +1,157 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_DATA_MODELBINARYCACHE_H
+#define BLACKMISC_SIMULATION_DATA_MODELBINARYCACHE_H
+
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/aircraftmodel.h"
+#include "blackmisc/statusmessage.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        namespace Data
+        {
+            //! Binary, memory mapped file of a model cache
+            //! \details Written next to the JSON file of the data cache, which stays the exchange and export format.
+            //!          Strings are stored once in a string table, aircraft ICAO codes, liveries, distributors,
+            //!          callsigns and CGs once in object tables, and every model as a fixed size record referring
+            //!          to those tables. The file is memory mapped, the size and model strings are read without
+            //!          creating models. All models are created at once by CModelBinaryCache::toList.
+            //!          The timestamp of the data cache value is stored, so an outdated file can be detected.
+            class BLACKMISC_EXPORT CModelBinaryCache
+            {
+            public:
+                //! Format version, files with other versions are ignored
+                static constexpr quint32 Version = 1;
+
+                //! Ctor, not yet opened
+                CModelBinaryCache() {}
+
+                //! Dtor
+                ~CModelBinaryCache();
+
+                //! Not copyable
+                //! @{
+                CModelBinaryCache(const CModelBinaryCache &) = delete;
+                CModelBinaryCache &operator =(const CModelBinaryCache &) = delete;
+                //! @}
+
+                //! Binary file for the JSON file of the data cache
+                static QString binaryFileName(const QString &jsonFileName);
+
+                //! Write models
+                //! \param models the models
+                //! \param cacheTimestamp timestamp of the data cache value
+                //! \param fileName binary file
+                static CStatusMessage write(const CAircraftModelList &models, qint64 cacheTimestamp, const QString &fileName);
+
+                //! Models in the binary format
+                static QByteArray toBinary(const CAircraftModelList &models, qint64 cacheTimestamp);
+
+                //! Open and map the file
+                //! \remark fails for missing files, other versions and corrupt files
+                bool open(const QString &fileName);
+
+                //! Opened?
+                bool isOpen() const { return m_data != nullptr; }
+
+                //! Number of models
+                int size() const { return m_modelCount; }
+
+                //! Timestamp of the data cache value
+                qint64 getCacheTimestamp() const { return m_cacheTimestamp; }
+
+                //! File name
+                const QString &getFileName() const { return m_fileName; }
+
+                //! Model string of model at index, without creating the model
+                QString getModelString(int index) const;
+
+                //! Model at index
+                CAircraftModel at(int index) const;
+
+                //! All models
+                //! \remark all models are created on the first call and shared afterwards
+                //! \threadsafe
+                CAircraftModelList toList() const;
+
+            private:
+                //! Fixed size record of one model, indexes into the string and object tables
+                struct ModelRecord;
+
+                //! Object table
+                struct ObjectTable
+                {
+                    const uchar *offsets = nullptr; //!< count + 1 offsets into data
+                    const uchar *data = nullptr;    //!< serialized objects
+                    quint32 count = 0;              //!< number of objects
+                    quint32 size = 0;               //!< size of data
+                };
+
+                //! All objects of the tables, used when all models are created
+                struct DecodedTables;
+
+                //! Init from mapped data
+                bool init(const uchar *data, qint64 size);
+
+                //! Init table at offset
+                bool initTable(ObjectTable &table, quint64 offset) const;
+
+                //! Read a record
+                ModelRecord record(int index) const;
+
+                //! Serialized object (or UTF-8 string) from a table
+                QByteArray object(const ObjectTable &table, quint32 index) const;
+
+                //! String from the string table
+                QString string(quint32 index) const;
+
+                //! Deserialized object
+                template <class T> T value(const ObjectTable &table, quint32 index) const;
+
+                //! All objects of a table
+                template <class T> QVector<T> values(const ObjectTable &table) const;
+
+                //! Create model, with the decoded tables if available
+                CAircraftModel create(const ModelRecord &record, const DecodedTables *decoded) const;
+
+                QFile m_file;
+                QString m_fileName;
+                const uchar *m_data = nullptr;      //!< mapped file
+                qint64 m_size = 0;                  //!< mapped size
+                int m_modelCount = 0;
+                qint64 m_cacheTimestamp = -1;
+                const uchar *m_records = nullptr;   //!< model records
+                ObjectTable m_strings;              //!< UTF-8 strings
+                ObjectTable m_aircraftIcaoCodes;    //!< aircraft ICAO codes
+                ObjectTable m_liveries;             //!< liveries
+                ObjectTable m_distributors;         //!< distributors
+                ObjectTable m_callsigns;            //!< callsigns
+                ObjectTable m_cgs;                  //!< centers of gravity
+                mutable QMutex m_listMutex;
+                mutable CAircraftModelList m_list;  //!< all models, once created
+                mutable bool m_listCreated = false;
+            };
+        } // ns
+    } // ns
+} // ns
+
+#endif // guard
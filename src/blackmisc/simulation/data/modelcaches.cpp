@@ -7,9 +7,12 @@
  */
 
 #include "blackmisc/simulation/data/modelcaches.h"
+#include "blackmisc/simulation/aircraftmodelinterner.h"
 #include "blackmisc/cachesettingsutils.h"
 #include "blackmisc/logmessage.h"
 #include "blackmisc/verify.h"
+#include <QFileInfo>
+#include <QMutexLocker>
 #include <QtGlobal>
 
 using namespace BlackMisc;
@@ -28,11 +31,70 @@ namespace BlackMisc
             int IMultiSimulatorModelCaches::updateModelsForSimulator(const CAircraftModelList &models, const CSimulatorInfo &simulator)
             {
                 if (models.isEmpty()) { return 0; }
-                CAircraftModelList allModels(this->getSynchronizedCachedModels(simulator));
-                const int c = allModels.replaceOrAddModelsWithString(models, Qt::CaseInsensitive);
-                if (c < 1) { return 0; }
-                this->setCachedModels(allModels, simulator);
-                return allModels.size();
+
+                // like replaceOrAddModelsWithString, existing models are removed and all are appended
+                CModelSetChanges changes;
+                for (const CAircraftModel &model : models)
+                {
+                    changes.removeModel(model.getModelString());
+                    changes.addModel(model);
+                }
+                const CStatusMessage msg = this->applyModelSetChanges(changes, simulator);
+                if (msg.isFailure()) { return 0; }
+                return this->getCachedModelsCount(simulator);
+            }
+
+            CStatusMessage IMultiSimulatorModelCaches::applyModelSetChanges(const CModelSetChanges &changes, const CSimulatorInfo &simulator)
+            {
+                Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
+                if (changes.isEmpty()) { return CStatusMessage(this).info(u"No changes for %1") << simulator.toQString(true); }
+
+                CAircraftModelList models(this->getSynchronizedCachedModels(simulator));
+                const qint64 tsBefore = this->cacheTimestampMSecs(simulator);
+                changes.applyTo(models);
+                const CStatusMessage msg = this->setCachedModels(models, simulator);
+                if (msg.isFailure()) { return msg; }
+
+                const qint64 ts = this->cacheTimestampMSecs(simulator);
+                QMutexLocker lock(&m_journalMutex);
+                Journal &j = this->journal(simulator, tsBefore);
+                j.changes.record(changes);
+                j.cacheTimestamp = ts;
+                return msg;
+            }
+
+            bool IMultiSimulatorModelCaches::getChangesSince(int revision, const CSimulatorInfo &simulator, CModelSetChanges &changes) const
+            {
+                Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
+                const qint64 ts = this->cacheTimestampMSecs(simulator);
+                QMutexLocker lock(&m_journalMutex);
+                return this->journal(simulator, ts).changes.changesSince(revision, changes);
+            }
+
+            int IMultiSimulatorModelCaches::getChangesRevision(const CSimulatorInfo &simulator) const
+            {
+                Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
+                const qint64 ts = this->cacheTimestampMSecs(simulator);
+                QMutexLocker lock(&m_journalMutex);
+                return this->journal(simulator, ts).changes.getRevision();
+            }
+
+            IMultiSimulatorModelCaches::Journal &IMultiSimulatorModelCaches::journal(const CSimulatorInfo &simulator, qint64 cacheTimestamp) const
+            {
+                Journal &j = m_journals[simulator.getSimulator()];
+                if (j.cacheTimestamp != cacheTimestamp)
+                {
+                    // changed by setCachedModels or in another process
+                    j.changes.reset();
+                    j.cacheTimestamp = cacheTimestamp;
+                }
+                return j;
+            }
+
+            qint64 IMultiSimulatorModelCaches::cacheTimestampMSecs(const CSimulatorInfo &simulator) const
+            {
+                const QDateTime ts = this->getCacheTimestamp(simulator);
+                return ts.isValid() ? ts.toMSecsSinceEpoch() : -1;
             }
 
             QString IMultiSimulatorModelCaches::getInfoString() const
@@ -79,8 +141,82 @@ namespace BlackMisc
                 emit this->cacheChanged(simulator);
             }
 
+            void IMultiSimulatorModelCaches::changedElsewhere(const CSimulatorInfo &simulator)
+            {
+                const qint64 ts = this->cacheTimestampMSecs(simulator);
+                bool outdated = false;
+                {
+                    QMutexLocker lock(&m_binaryMutex);
+                    const auto binary = m_binaryCaches.value(simulator.getSimulator());
+                    if (binary && binary->getCacheTimestamp() != ts)
+                    {
+                        m_binaryCaches.remove(simulator.getSimulator());
+                        outdated = true;
+                    }
+                }
+
+                // synchronized again with the data cache value
+                if (outdated) { this->markCacheAsAlreadySynchronized(simulator, false); }
+                this->emitCacheChanged(simulator);
+            }
+
+            bool IMultiSimulatorModelCaches::loadBinaryCache(const CSimulatorInfo &simulator)
+            {
+                Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
+                const QString fileName = CModelBinaryCache::binaryFileName(this->getFilename(simulator));
+                if (fileName.isEmpty() || !QFileInfo::exists(fileName)) { return false; }
+
+                // timestamp on disk, the value itself is not loaded
+                const QDateTime ts = this->getCacheTimestamp(simulator);
+                if (!ts.isValid()) { return false; }
+
+                auto binary = std::make_shared<CModelBinaryCache>();
+                if (!binary->open(fileName))
+                {
+                    CLogMessage(this).warning(u"Cannot use binary model cache '%1', using JSON cache") << fileName;
+                    return false;
+                }
+                if (binary->getCacheTimestamp() != ts.toMSecsSinceEpoch())
+                {
+                    CLogMessage(this).info(u"Binary model cache '%1' is outdated, using JSON cache") << fileName;
+                    return false;
+                }
+
+                CLogMessage(this).info(u"Using binary model cache '%1' with %2 models for %3") << fileName << binary->size() << simulator.toQString(true);
+                QMutexLocker lock(&m_binaryMutex);
+                m_binaryCaches.insert(simulator.getSimulator(), binary);
+                return true;
+            }
+
+            std::shared_ptr<const CModelBinaryCache> IMultiSimulatorModelCaches::getBinaryCache(const CSimulatorInfo &simulator) const
+            {
+                std::shared_ptr<const CModelBinaryCache> binary;
+                {
+                    QMutexLocker lock(&m_binaryMutex);
+                    binary = m_binaryCaches.value(simulator.getSimulator());
+                }
+
+                // outdated once the data cache value has been changed, e.g. by another process
+                if (binary && binary->getCacheTimestamp() != this->cacheTimestampMSecs(simulator)) { return nullptr; }
+                return binary;
+            }
+
+            void IMultiSimulatorModelCaches::writeBinaryCache(const CAircraftModelList &models, qint64 cacheTimestamp, const CSimulatorInfo &simulator)
+            {
+                {
+                    // the data cache has the current value now
+                    QMutexLocker lock(&m_binaryMutex);
+                    m_binaryCaches.remove(simulator.getSimulator());
+                }
+                const QString fileName = CModelBinaryCache::binaryFileName(this->getFilename(simulator));
+                const CStatusMessage msg = CModelBinaryCache::write(models, cacheTimestamp, fileName);
+                if (msg.isFailure()) { CLogMessage::preformatted(msg); }
+            }
+
             int IMultiSimulatorModelCaches::getCachedModelsCount(const CSimulatorInfo &simulator) const
             {
+                // count without creating the models
+                if (const auto binary = this->getBinaryCache(simulator)) { return binary->size(); }
                 return this->getCachedModels(simulator).size();
             }
 
@@ -201,6 +337,7 @@ namespace BlackMisc
             CAircraftModelList CModelCaches::getCachedModels(const CSimulatorInfo &simulator) const
             {
                 Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
+                if (const auto binary = this->getBinaryCache(simulator)) { return binary->toList(); }
                 switch (simulator.getSimulator())
                 {
                 case CSimulatorInfo::FS9:    return m_modelCacheFs9.get();
@@ -220,18 +357,21 @@ namespace BlackMisc
                 CStatusMessage msg;
                 CAircraftModelList setModels(models);
                 setModels.setModelType(CAircraftModel::TypeOwnSimulatorModel); // unify type
+                CAircraftModelInterner::internModels(setModels); // share ICAO codes, liveries and distributors
 
+                const qint64 ts = QDateTime::currentMSecsSinceEpoch();
                 switch (simulator.getSimulator())
                 {
-                case CSimulatorInfo::FS9:    msg = m_modelCacheFs9.set(setModels); break;
-                case CSimulatorInfo::FSX:    msg = m_modelCacheFsx.set(setModels); break;
-                case CSimulatorInfo::P3D:    msg = m_modelCacheP3D.set(setModels); break;
-                case CSimulatorInfo::XPLANE: msg = m_modelCacheXP.set(setModels); break;
-                case CSimulatorInfo::FG:     msg = m_modelCacheFG.set(setModels); break;
+                case CSimulatorInfo::FS9:    msg = m_modelCacheFs9.set(setModels, ts); break;
+                case CSimulatorInfo::FSX:    msg = m_modelCacheFsx.set(setModels, ts); break;
+                case CSimulatorInfo::P3D:    msg = m_modelCacheP3D.set(setModels, ts); break;
+                case CSimulatorInfo::XPLANE: msg = m_modelCacheXP.set(setModels, ts); break;
+                case CSimulatorInfo::FG:     msg = m_modelCacheFG.set(setModels, ts); break;
                 default:
                     Q_ASSERT_X(false, Q_FUNC_INFO, "wrong simulator");
                     return CStatusMessage();
                 }
+                if (!msg.isFailure()) { this->writeBinaryCache(setModels, ts, simulator); }
                 this->emitCacheChanged(simulator); // set
                 return msg;
             }
@@ -295,18 +435,24 @@ namespace BlackMisc
             {
                 Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
                 if (!ts.isValid()) { return CStatusMessage(this).error(u"Invalid timestamp for '%1'") << simulator.toQString() ; }
+
+                // the models might be from the binary file, the data cache value is possibly not loaded yet
+                const CAircraftModelList models = this->getCachedModels(simulator);
+                const qint64 tsMs = ts.toMSecsSinceEpoch();
+                CStatusMessage msg;
                 switch (simulator.getSimulator())
                 {
-                case CSimulatorInfo::FS9:    return m_modelCacheFs9.set(m_modelCacheFs9.get(), ts.toMSecsSinceEpoch());
-                case CSimulatorInfo::FSX:    return m_modelCacheFsx.set(m_modelCacheFsx.get(), ts.toMSecsSinceEpoch());
-                case CSimulatorInfo::P3D:    return m_modelCacheP3D.set(m_modelCacheP3D.get(), ts.toMSecsSinceEpoch());
-                case CSimulatorInfo::XPLANE: return m_modelCacheXP.set(m_modelCacheXP.get(), ts.toMSecsSinceEpoch());
-                case CSimulatorInfo::FG:     return m_modelCacheFG.set(m_modelCacheFG.get(), ts.toMSecsSinceEpoch());
+                case CSimulatorInfo::FS9:    msg = m_modelCacheFs9.set(models, tsMs); break;
+                case CSimulatorInfo::FSX:    msg = m_modelCacheFsx.set(models, tsMs); break;
+                case CSimulatorInfo::P3D:    msg = m_modelCacheP3D.set(models, tsMs); break;
+                case CSimulatorInfo::XPLANE: msg = m_modelCacheXP.set(models, tsMs);  break;
+                case CSimulatorInfo::FG:     msg = m_modelCacheFG.set(models, tsMs);  break;
                 default:
                     Q_ASSERT_X(false, Q_FUNC_INFO, "Wrong simulator");
-                    break;
+                    return CStatusMessage();
                 }
-                return CStatusMessage();
+                if (!msg.isFailure()) { this->writeBinaryCache(models, tsMs, simulator); }
+                return msg;
             }
 
             void CModelCaches::synchronizeCache(const CSimulatorInfo &simulator)
@@ -358,6 +504,13 @@ namespace BlackMisc
                 Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
 
                 if (this->isCacheAlreadySynchronized(simulator)) { return; }
+                if (this->admitCacheImpl(simulator) && this->isCacheAlreadySynchronized(simulator))
+                {
+                    // binary file in use, the data cache value is loaded in the background
+                    this->emitCacheChanged(simulator); // sync
+                    return;
+                }
+
                 switch (simulator.getSimulator())
                 {
                 case CSimulatorInfo::FS9:    m_modelCacheFs9.synchronize(); break;
@@ -378,6 +531,8 @@ namespace BlackMisc
                 Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
 
                 if (this->isCacheAlreadySynchronized(simulator)) { return false; }
+
+                // also if the binary file is used, so the value is loaded if changed elsewhere and the binary file is outdated
                 switch (simulator.getSimulator())
                 {
                 case CSimulatorInfo::FS9:    m_modelCacheFs9.admit(); break;
@@ -389,6 +544,7 @@ namespace BlackMisc
                     Q_ASSERT_X(false, Q_FUNC_INFO, "wrong simulator");
                     break;
                 }
+                if (this->loadBinaryCache(simulator)) { this->markCacheAsAlreadySynchronized(simulator, true); }
                 return true;
             }
 
@@ -420,6 +576,7 @@ namespace BlackMisc
             CAircraftModelList CModelSetCaches::getCachedModels(const CSimulatorInfo &simulator) const
             {
                 Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
+                if (const auto binary = this->getBinaryCache(simulator)) { return binary->toList(); }
                 switch (simulator.getSimulator())
                 {
                 case CSimulatorInfo::FS9:    return m_modelCacheFs9.get();
@@ -455,19 +612,22 @@ namespace BlackMisc
                 {
                     orderedModels.sortAscendingByOrder();
                 }
+                CAircraftModelInterner::internModels(orderedModels); // share ICAO codes, liveries and distributors
 
                 CStatusMessage msg;
+                const qint64 ts = QDateTime::currentMSecsSinceEpoch();
                 switch (simulator.getSimulator())
                 {
-                case CSimulatorInfo::FS9:    msg = m_modelCacheFs9.set(orderedModels); break;
-                case CSimulatorInfo::FSX:    msg = m_modelCacheFsx.set(orderedModels); break;
-                case CSimulatorInfo::P3D:    msg = m_modelCacheP3D.set(orderedModels); break;
-                case CSimulatorInfo::XPLANE: msg = m_modelCacheXP.set(orderedModels);  break;
-                case CSimulatorInfo::FG:     msg = m_modelCacheFG.set(orderedModels);  break;
+                case CSimulatorInfo::FS9:    msg = m_modelCacheFs9.set(orderedModels, ts); break;
+                case CSimulatorInfo::FSX:    msg = m_modelCacheFsx.set(orderedModels, ts); break;
+                case CSimulatorInfo::P3D:    msg = m_modelCacheP3D.set(orderedModels, ts); break;
+                case CSimulatorInfo::XPLANE: msg = m_modelCacheXP.set(orderedModels, ts);  break;
+                case CSimulatorInfo::FG:     msg = m_modelCacheFG.set(orderedModels, ts);  break;
                 default:
                     Q_ASSERT_X(false, Q_FUNC_INFO, "wrong simulator");
                     return CStatusMessage();
                 }
+                if (!msg.isFailure()) { this->writeBinaryCache(orderedModels, ts, simulator); }
                 this->emitCacheChanged(simulator); // set
                 return msg;
             }
@@ -492,18 +652,24 @@ namespace BlackMisc
             {
                 Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
                 if (!ts.isValid()) { return CStatusMessage(this).error(u"Invalid timestamp for '%1'") << simulator.toQString() ; }
+
+                // the models might be from the binary file, the data cache value is possibly not loaded yet
+                const CAircraftModelList models = this->getCachedModels(simulator);
+                const qint64 tsMs = ts.toMSecsSinceEpoch();
+                CStatusMessage msg;
                 switch (simulator.getSimulator())
                 {
-                case CSimulatorInfo::FS9:    return m_modelCacheFs9.set(m_modelCacheFs9.get(), ts.toMSecsSinceEpoch());
-                case CSimulatorInfo::FSX:    return m_modelCacheFsx.set(m_modelCacheFsx.get(), ts.toMSecsSinceEpoch());
-                case CSimulatorInfo::P3D:    return m_modelCacheP3D.set(m_modelCacheP3D.get(), ts.toMSecsSinceEpoch());
-                case CSimulatorInfo::XPLANE: return m_modelCacheXP.set(m_modelCacheXP.get(), ts.toMSecsSinceEpoch());
-                case CSimulatorInfo::FG:     return m_modelCacheFG.set(m_modelCacheFG.get(), ts.toMSecsSinceEpoch());
+                case CSimulatorInfo::FS9:    msg = m_modelCacheFs9.set(models, tsMs); break;
+                case CSimulatorInfo::FSX:    msg = m_modelCacheFsx.set(models, tsMs); break;
+                case CSimulatorInfo::P3D:    msg = m_modelCacheP3D.set(models, tsMs); break;
+                case CSimulatorInfo::XPLANE: msg = m_modelCacheXP.set(models, tsMs);  break;
+                case CSimulatorInfo::FG:     msg = m_modelCacheFG.set(models, tsMs);  break;
                 default:
                     Q_ASSERT_X(false, Q_FUNC_INFO, "Wrong simulator");
-                    break;
+                    return CStatusMessage();
                 }
-                return CStatusMessage();
+                if (!msg.isFailure()) { this->writeBinaryCache(models, tsMs, simulator); }
+                return msg;
             }
 
             void CModelSetCaches::synchronizeCache(const CSimulatorInfo &simulator)
@@ -555,6 +721,13 @@ namespace BlackMisc
                 Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
 
                 if (this->isCacheAlreadySynchronized(simulator)) { return; }
+                if (this->admitCacheImpl(simulator) && this->isCacheAlreadySynchronized(simulator))
+                {
+                    // binary file in use, the data cache value is loaded in the background
+                    this->emitCacheChanged(simulator); // sync
+                    return;
+                }
+
                 switch (simulator.getSimulator())
                 {
                 case CSimulatorInfo::FS9:    m_modelCacheFs9.synchronize(); break;
@@ -575,6 +748,8 @@ namespace BlackMisc
                 Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
 
                 if (this->isCacheAlreadySynchronized(simulator)) { return false; }
+
+                // also if the binary file is used, so the value is loaded if changed elsewhere and the binary file is outdated
                 switch (simulator.getSimulator())
                 {
                 case CSimulatorInfo::FS9:    m_modelCacheFs9.admit(); break;
@@ -586,6 +761,7 @@ namespace BlackMisc
                     Q_ASSERT_X(false, Q_FUNC_INFO, "Wrong simulator");
                     break;
                 }
+                if (this->loadBinaryCache(simulator)) { this->markCacheAsAlreadySynchronized(simulator, true); }
                 return true;
             }
         } // ns
@@ -11,8 +11,10 @@
 #ifndef BLACKMISC_SIMULATION_DATA_MODELCACHES
 #define BLACKMISC_SIMULATION_DATA_MODELCACHES
 
+#include "blackmisc/simulation/data/modelbinarycache.h"
 #include "blackmisc/simulation/aircraftmodelinterfaces.h"
 #include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/modelsetchanges.h"
 #include "blackmisc/simulation/simulatorinfo.h"
 #include "blackmisc/applicationinfo.h"
 #include "blackmisc/statusmessage.h"
@@ -21,8 +23,11 @@
 #include "blackmisc/blackmiscexport.h"
 
 #include <QDateTime>
+#include <QHash>
+#include <QMutex>
 #include <QObject>
 #include <atomic>
+#include <memory>
 
 namespace BlackMisc
 {
@@ -235,6 +240,26 @@ namespace BlackMisc
                 //! \threadsafe
                 virtual CStatusMessage clearCachedModels(const CSimulatorInfo &simulator);
 
+                //! \name Journal of the changes, consumers can apply the changes instead of reloading all models
+                //! \remark only changes made with applyModelSetChanges are recorded, any other change of the cache
+                //!          requires a reload of the models
+                //! @{
+
+                //! Apply changes to the cached models and record them
+                //! \remark listeners of cacheChanged need a queued connection to see the recorded changes
+                //! \threadsafe
+                virtual CStatusMessage applyModelSetChanges(const CModelSetChanges &changes, const CSimulatorInfo &simulator);
+
+                //! Changes since revision
+                //! \return false if not available, the models need to be reloaded
+                //! \threadsafe
+                virtual bool getChangesSince(int revision, const CSimulatorInfo &simulator, CModelSetChanges &changes) const;
+
+                //! Current revision of the cached models
+                //! \threadsafe
+                virtual int getChangesRevision(const CSimulatorInfo &simulator) const;
+                //! @}
+
                 //! Synchronize for given simulator
                 //! \threadsafe
                 virtual void synchronizeCache(const CSimulatorInfo &simulator) = 0;
@@ -285,11 +310,27 @@ namespace BlackMisc
 
                 //! Cache has been changed. This will only detect changes elsewhere, owned caches will not signal local changes
                 //! @{
-                void changedFsx() { this->emitCacheChanged(CSimulatorInfo::fsx()); }
-                void changedFs9() { this->emitCacheChanged(CSimulatorInfo::fs9()); }
-                void changedP3D() { this->emitCacheChanged(CSimulatorInfo::p3d()); }
-                void changedXP()  { this->emitCacheChanged(CSimulatorInfo::xplane()); }
-                void changedFG()  { this->emitCacheChanged(CSimulatorInfo::fg()); }
+                void changedFsx() { this->changedElsewhere(CSimulatorInfo::fsx()); }
+                void changedFs9() { this->changedElsewhere(CSimulatorInfo::fs9()); }
+                void changedP3D() { this->changedElsewhere(CSimulatorInfo::p3d()); }
+                void changedXP()  { this->changedElsewhere(CSimulatorInfo::xplane()); }
+                void changedFG()  { this->changedElsewhere(CSimulatorInfo::fg()); }
+                //! @}
+
+                //! \name Binary model cache files, used instead of parsing the JSON files of the data cache
+                //! @{
+
+                //! Use the binary file if it has the timestamp of the data cache value
+                //! \threadsafe
+                bool loadBinaryCache(const CSimulatorInfo &simulator);
+
+                //! The binary file in use, nullptr if none or outdated
+                //! \threadsafe
+                std::shared_ptr<const CModelBinaryCache> getBinaryCache(const CSimulatorInfo &simulator) const;
+
+                //! Write the binary file for the models just set, a loaded binary file is no longer used
+                //! \threadsafe
+                void writeBinaryCache(const CAircraftModelList &models, qint64 cacheTimestamp, const CSimulatorInfo &simulator);
                 //! @}
 
                 //! Is the cache already synchronized?
@@ -299,6 +340,9 @@ namespace BlackMisc
                 //! Emit cacheChanged() utility function (allows breakpoint)
                 void emitCacheChanged(const CSimulatorInfo &simulator);
 
+                //! Changed by another process, an outdated binary file is no longer used
+                void changedElsewhere(const CSimulatorInfo &simulator);
+
                 //! Cache synchronized flag
                 //! @{
                 std::atomic_bool m_syncFsx { false };
@@ -307,6 +351,26 @@ namespace BlackMisc
                 std::atomic_bool m_syncFG  { false };
                 std::atomic_bool m_syncXPlane { false };
                 //! @}
+
+            private:
+                //! Changes of one simulator cache
+                struct Journal
+                {
+                    CModelSetJournal changes;
+                    qint64 cacheTimestamp = -1; //!< timestamp of the cache after the last recorded change
+                };
+
+                //! Journal of simulator, reset if the cache was changed without recording the changes
+                //! \remark m_journalMutex must be locked
+                Journal &journal(const CSimulatorInfo &simulator, qint64 cacheTimestamp) const;
+
+                //! Cache timestamp in ms, -1 if not available
+                qint64 cacheTimestampMSecs(const CSimulatorInfo &simulator) const;
+
+                mutable QMutex m_binaryMutex;
+                QHash<int, std::shared_ptr<const CModelBinaryCache>> m_binaryCaches; //!< binary files in use, by simulator
+                mutable QMutex m_journalMutex;
+                mutable QHash<int, Journal> m_journals; //!< by simulator
             };
 
             //! Bundle of caches for all simulators
@@ -406,6 +470,9 @@ namespace BlackMisc
                 virtual QString getFilename(const CSimulatorInfo &simulator) const override { return instanceCaches().getFilename(simulator); }
                 virtual bool isSaved(const CSimulatorInfo &simulator) const override { return instanceCaches().isSaved(simulator); }
                 virtual QString getDescription() const override { return instanceCaches().getDescription(); }
+                virtual CStatusMessage applyModelSetChanges(const CModelSetChanges &changes, const CSimulatorInfo &simulator) override { return instanceCaches().applyModelSetChanges(changes, simulator); }
+                virtual bool getChangesSince(int revision, const CSimulatorInfo &simulator, CModelSetChanges &changes) const override { return instanceCaches().getChangesSince(revision, simulator, changes); }
+                virtual int getChangesRevision(const CSimulatorInfo &simulator) const override { return instanceCaches().getChangesRevision(simulator); }
                 //! @}
 
             protected:
@@ -517,6 +584,7 @@ namespace BlackMisc
                 int getCachedModelsCount(const CSimulatorInfo &simulator) const { return CCentralMultiSimulatorModelSetCachesProvider::modelCachesInstance().getCachedModelsCount(simulator); }
                 QString getCacheCountAndTimestamp(const CSimulatorInfo &simulator) const { return CCentralMultiSimulatorModelCachesProvider::modelCachesInstance().getCacheCountAndTimestamp(simulator); }
                 CStatusMessage setCachedModels(const CAircraftModelList &models, const CSimulatorInfo &simulator) { return CCentralMultiSimulatorModelSetCachesProvider::modelCachesInstance().setCachedModels(models, simulator); }
+                CStatusMessage applyModelSetChanges(const CModelSetChanges &changes, const CSimulatorInfo &simulator) { return CCentralMultiSimulatorModelSetCachesProvider::modelCachesInstance().applyModelSetChanges(changes, simulator); }
                 CStatusMessage clearCachedModels(const CSimulatorInfo &simulator) { return CCentralMultiSimulatorModelCachesProvider::modelCachesInstance().clearCachedModels(simulator); }
                 QDateTime getCacheTimestamp(const CSimulatorInfo &simulator) const { return CCentralMultiSimulatorModelSetCachesProvider::modelCachesInstance().getCacheTimestamp(simulator); }
                 CStatusMessage setCacheTimestamp(const QDateTime &ts, const CSimulatorInfo &simulator) { return CCentralMultiSimulatorModelSetCachesProvider::modelCachesInstance().setCacheTimestamp(ts, simulator); }
@@ -0,0 +1,103 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/filemanifest.h"
+#include "blackmisc/datacache.h"
+#include "blackmisc/fileutils.h"
+#include "blackmisc/logcategories.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <algorithm>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        namespace
+        {
+            //! QDataStream version
+            constexpr int StreamVersion = QDataStream::Qt_5_12;
+
+            //! Categories of the messages
+            const CLogCategoryList &categories()
+            {
+                static const CLogCategoryList cats({ CLogCategories::modelLoader() });
+                return cats;
+            }
+        }
+
+        QString CFileManifestBase::manifestFileName(const QString &name)
+        {
+            return CFileUtils::appendFilePaths(CDataCache::persistentStore(), QStringLiteral("modelmanifest"), name);
+        }
+
+        QString CFileManifestBase::key(const QString &fileName)
+        {
+            return QDir::fromNativeSeparators(fileName).toLower();
+        }
+
+        qint32 CFileManifestBase::readHeader(QFile &file, QDataStream &stream) const
+        {
+            if (!file.open(QFile::ReadOnly)) { return -1; }
+            stream.setDevice(&file);
+            stream.setVersion(StreamVersion);
+
+            quint32 magic = 0;
+            quint32 version = 0;
+            qint32 count = 0;
+            stream >> magic >> version >> count;
+            if (stream.status() != QDataStream::Ok || magic != m_magic || version != m_version) { return -1; }
+            return count < 0 ? -1 : count;
+        }
+
+        CStatusMessage CFileManifestBase::writeHeader(const QString &fileName, CAtomicFile &file, QDataStream &stream, int count) const
+        {
+            if (!QDir().mkpath(QFileInfo(fileName).absolutePath()))
+            {
+                return CStatusMessage(categories()).error(u"Failed to create directory for '%1'") << fileName;
+            }
+            if (!file.open(QFile::WriteOnly))
+            {
+                return CStatusMessage(categories()).error(u"Failed to open %1: %2") << fileName << file.errorString();
+            }
+
+            stream.setDevice(&file);
+            stream.setVersion(StreamVersion);
+            stream << m_magic << m_version << static_cast<qint32>(count);
+            return {};
+        }
+
+        CStatusMessage CFileManifestBase::finishWriting(const QString &fileName, CAtomicFile &file, const QDataStream &stream, int count)
+        {
+            if (stream.status() != QDataStream::Ok || !file.checkedClose())
+            {
+                return CStatusMessage(categories()).error(u"Failed to write to %1: %2") << fileName << file.errorString();
+            }
+            return CStatusMessage(categories()).info(u"Written manifest of %1 files to '%2'") << count << fileName;
+        }
+
+        QStringList CFileManifestBase::directoryKeys(const QStringList &directories)
+        {
+            QStringList keys;
+            for (const QString &directory : directories)
+            {
+                if (directory.isEmpty()) { continue; }
+                QString k = key(QDir::cleanPath(directory));
+                if (!k.endsWith('/')) { k += '/'; }
+                keys.push_back(k);
+            }
+            return keys;
+        }
+
+        bool CFileManifestBase::isInDirectories(const QString &key, const QStringList &directoryKeys)
+        {
+            return std::any_of(directoryKeys.cbegin(), directoryKeys.cend(), [&key](const QString & directory) { return key.startsWith(directory); });
+        }
+    } // namespace
+} // namespace
@@ -0,0 +1,165 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_FILEMANIFEST_H
+#define BLACKMISC_SIMULATION_FILEMANIFEST_H
+
+#include "blackmisc/atomicfile.h"
+#include "blackmisc/statusmessage.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QtGlobal>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        //! Non template part of CFileManifest
+        class BLACKMISC_EXPORT CFileManifestBase
+        {
+        public:
+            //! Manifest file in the "modelmanifest" directory of the persistent store
+            static QString manifestFileName(const QString &name);
+
+            //! Key of a file name
+            //! \remark native separators and case do not matter, the same key is used for all lookups
+            static QString key(const QString &fileName);
+
+        protected:
+            //! Ctor
+            CFileManifestBase(quint32 magic, quint32 version) : m_magic(magic), m_version(version) {}
+
+            //! Open the file and read the header
+            //! \return number of entries, -1 for a missing or invalid file
+            qint32 readHeader(QFile &file, QDataStream &stream) const;
+
+            //! Create the directory, open the file and write the header
+            //! \return error, or an empty message
+            CStatusMessage writeHeader(const QString &fileName, CAtomicFile &file, QDataStream &stream, int count) const;
+
+            //! Close the file after the entries have been written
+            static CStatusMessage finishWriting(const QString &fileName, CAtomicFile &file, const QDataStream &stream, int count);
+
+            //! Keys of directories, ending with '/'
+            static QStringList directoryKeys(const QStringList &directories);
+
+            //! Key of a file inside one of the directories?
+            static bool isInDirectories(const QString &key, const QStringList &directoryKeys);
+
+        private:
+            quint32 m_magic = 0;   //!< identifies the file
+            quint32 m_version = 0; //!< files with other versions are ignored
+        };
+
+        //! Per file results of a model loader scan, so a re-scan only reads the files which changed
+        //! \remark Entry is written with its QDataStream operators
+        template <class Entry>
+        class CFileManifest : public CFileManifestBase
+        {
+        public:
+            //! Load from file
+            //! \remark a missing or invalid file results in an empty manifest
+            bool load(const QString &fileName)
+            {
+                m_entries.clear();
+                m_fileNames.clear();
+
+                QFile file(fileName);
+                QDataStream stream;
+                const qint32 count = this->readHeader(file, stream);
+                if (count < 0) { return false; }
+
+                QHash<QString, Entry> entries;
+                QHash<QString, QString> fileNames;
+                entries.reserve(qMin(count, 1 << 16)); // count is untrusted
+                for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++)
+                {
+                    QString name;
+                    Entry entry;
+                    stream >> name >> entry;
+                    const QString k = key(name);
+                    entries.insert(k, entry);
+                    fileNames.insert(k, name);
+                }
+                if (stream.status() != QDataStream::Ok) { return false; }
+
+                m_entries = entries;
+                m_fileNames = fileNames;
+                return true;
+            }
+
+            //! Save to file
+            CStatusMessage save(const QString &fileName) const
+            {
+                CAtomicFile file(fileName);
+                QDataStream stream;
+                const CStatusMessage error = this->writeHeader(fileName, file, stream, m_entries.size());
+                if (!error.isEmpty()) { return error; }
+                for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it)
+                {
+                    stream << m_fileNames.value(it.key()) << it.value();
+                }
+                return finishWriting(fileName, file, stream, m_entries.size());
+            }
+
+            //! Entry for file, nullptr if not in the manifest
+            const Entry *find(const QString &fileName) const
+            {
+                const auto it = m_entries.constFind(key(fileName));
+                return it == m_entries.cend() ? nullptr : &it.value();
+            }
+
+            //! Add or replace entry
+            void insert(const QString &fileName, const Entry &entry)
+            {
+                const QString k = key(fileName);
+                m_entries.insert(k, entry);
+                m_fileNames.insert(k, fileName);
+            }
+
+            //! Remove the entries of files in one of the directories
+            //! \remark used before the results of a scan of these directories are inserted
+            void removeInDirectories(const QStringList &directories)
+            {
+                const QStringList keys = directoryKeys(directories);
+                for (auto it = m_entries.begin(); it != m_entries.end();)
+                {
+                    if (isInDirectories(it.key(), keys))
+                    {
+                        m_fileNames.remove(it.key());
+                        it = m_entries.erase(it);
+                    }
+                    else { ++it; }
+                }
+            }
+
+            //! Number of files
+            int size() const { return m_entries.size(); }
+
+            //! Empty?
+            bool isEmpty() const { return m_entries.isEmpty(); }
+
+        protected:
+            //! Ctor
+            CFileManifest(quint32 magic, quint32 version) : CFileManifestBase(magic, version) {}
+
+        private:
+            QHash<QString, Entry> m_entries;     //!< by key
+            QHash<QString, QString> m_fileNames; //!< key to file name as given
+        };
+    } // namespace
+} // namespace
+
+#endif // guard
@@ -0,0 +1,55 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/fscommon/aircraftcfgmanifest.h"
+
+#include <QCryptographicHash>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        namespace FsCommon
+        {
+            QDataStream &operator <<(QDataStream &stream, const CAircraftCfgManifestEntry &entry)
+            {
+                return stream << entry.lastModified << entry.size << entry.hash << entry.entries;
+            }
+
+            QDataStream &operator >>(QDataStream &stream, CAircraftCfgManifestEntry &entry)
+            {
+                return stream >> entry.lastModified >> entry.size >> entry.hash >> entry.entries;
+            }
+
+            CAircraftCfgManifest::CAircraftCfgManifest() : CFileManifest(0x53574346, Version) // "SWCF"
+            { }
+
+            QString CAircraftCfgManifest::manifestFileName(const CSimulatorInfo &simulator)
+            {
+                return CFileManifestBase::manifestFileName(QStringLiteral("aircraftcfg%1.manifest").arg(simulator.toQString().toLower().remove(' ')));
+            }
+
+            QByteArray CAircraftCfgManifest::contentHash(const QByteArray &content)
+            {
+                return QCryptographicHash::hash(content, QCryptographicHash::Md5);
+            }
+
+            const CAircraftCfgManifest::Entry *CAircraftCfgManifest::findUnchanged(const QString &fileName, qint64 lastModified, qint64 size) const
+            {
+                const Entry *entry = this->find(fileName);
+                return entry && entry->lastModified == lastModified && entry->size == size ? entry : nullptr;
+            }
+
+            const CAircraftCfgManifest::Entry *CAircraftCfgManifest::findSameContent(const QString &fileName, const QByteArray &hash) const
+            {
+                const Entry *entry = this->find(fileName);
+                return entry && !hash.isEmpty() && entry->hash == hash ? entry : nullptr;
+            }
+        } // ns
+    } // ns
+} // ns
@@ -0,0 +1,77 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_FSCOMMON_AIRCRAFTCFGMANIFEST_H
+#define BLACKMISC_SIMULATION_FSCOMMON_AIRCRAFTCFGMANIFEST_H
+
+#include "blackmisc/simulation/fscommon/aircraftcfgentrieslist.h"
+#include "blackmisc/simulation/filemanifest.h"
+#include "blackmisc/simulation/simulatorinfo.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QString>
+#include <QtGlobal>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        namespace FsCommon
+        {
+            //! Parsing result of one aircraft.cfg/sim.cfg file
+            struct CAircraftCfgManifestEntry
+            {
+                qint64 lastModified = -1;        //!< modification time, ms since epoch
+                qint64 size = -1;                //!< file size
+                QByteArray hash;                 //!< content hash
+                CAircraftCfgEntriesList entries; //!< parsed entries
+            };
+
+            //! Stream operators of the manifest entry
+            //! @{
+            BLACKMISC_EXPORT QDataStream &operator <<(QDataStream &stream, const CAircraftCfgManifestEntry &entry);
+            BLACKMISC_EXPORT QDataStream &operator >>(QDataStream &stream, CAircraftCfgManifestEntry &entry);
+            //! @}
+
+            //! Parsing results of aircraft.cfg/sim.cfg files of the last scan
+            //! \details Allows a re-scan to only parse files which changed. A file is unchanged if
+            //!          modification time and size are the same, or if the content hash is the same.
+            class BLACKMISC_EXPORT CAircraftCfgManifest : public CFileManifest<CAircraftCfgManifestEntry>
+            {
+            public:
+                //! Format version, files with other versions are ignored
+                static constexpr quint32 Version = 1;
+
+                //! Parsing result of one file
+                using Entry = CAircraftCfgManifestEntry;
+
+                //! Ctor
+                CAircraftCfgManifest();
+
+                //! Manifest file of a simulator
+                static QString manifestFileName(const CSimulatorInfo &simulator);
+
+                //! Hash of the file content
+                static QByteArray contentHash(const QByteArray &content);
+
+                //! Entry for file if unchanged, same modification time and size
+                //! \remark no need to read the file
+                const Entry *findUnchanged(const QString &fileName, qint64 lastModified, qint64 size) const;
+
+                //! Entry for file if the content is the same, e.g. file touched or copied
+                const Entry *findSameContent(const QString &fileName, const QByteArray &hash) const;
+            };
+        } // ns
+    } // ns
+} // ns
+
+#endif // guard
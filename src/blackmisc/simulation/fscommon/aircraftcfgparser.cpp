@@ -8,16 +8,19 @@
 
 #include "blackmisc/simulation/fscommon/aircraftcfgentries.h"
 #include "blackmisc/simulation/fscommon/aircraftcfgparser.h"
+#include "blackmisc/simulation/fscommon/aircraftcfgmanifest.h"
 #include "blackmisc/simulation/fscommon/fsdirectories.h"
 #include "blackmisc/fileutils.h"
 #include "blackmisc/logmessage.h"
 #include "blackmisc/statusmessagelist.h"
 #include "blackmisc/worker.h"
 #include "blackmisc/stringutils.h"
+#include "blackmisc/threadutils.h"
 #include "blackconfig/buildconfig.h"
 
 #include <QDateTime>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
 #include <QFileInfoList>
@@ -25,12 +28,19 @@
 #include <QIODevice>
 #include <QList>
 #include <QMetaType>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QSettings>
 #include <QTextStream>
+#include <QThread>
+#include <QWaitCondition>
 #include <Qt>
 #include <QtGlobal>
+#include <algorithm>
 #include <atomic>
 #include <tuple>
+#include <utility>
+#include <vector>
 #include <QStringView>
 
 using namespace BlackConfig;
@@ -131,30 +141,136 @@ namespace BlackMisc
                 return !m_parserWorker || m_parserWorker->isFinished();
             }
 
+            struct CAircraftCfgParser::ParsingState
+            {
+                QStringList excludeDirectories;              //!< excluded directory patterns
+                const CAircraftCfgManifest *manifest = nullptr; //!< result of the last scan
+                QMutex mutex;                                //!< protects the members below
+                QWaitCondition wakeUp;                       //!< directories queued or all finished
+                QStringList directories;                     //!< directories still to be parsed
+                int busy = 0;                                //!< threads parsing a directory
+                std::vector<std::pair<QString, CAircraftCfgManifest::Entry>> files; //!< results by file
+                CStatusMessageList messages;                 //!< messages of all threads
+                int directoriesParsed = 0;                   //!< number of directories
+                int unchanged = 0;                           //!< files taken from the manifest
+                int reparsed = 0;                            //!< files parsed
+
+                //! Queue directories
+                void addDirectories(const QStringList &dirs)
+                {
+                    if (dirs.isEmpty()) { return; }
+                    QMutexLocker lock(&mutex);
+                    directories.append(dirs);
+                    wakeUp.wakeAll();
+                }
+
+                //! Add the result of a file
+                void addFile(const QString &fileName, const CAircraftCfgManifest::Entry &entry, bool parsed)
+                {
+                    QMutexLocker lock(&mutex);
+                    files.emplace_back(fileName, entry);
+                    if (parsed) { reparsed++; }
+                    else { unchanged++; }
+                }
+
+                //! Add a message
+                void addMessage(const CStatusMessage &message)
+                {
+                    QMutexLocker lock(&mutex);
+                    messages.push_back(message);
+                }
+            };
+
             CAircraftCfgEntriesList CAircraftCfgParser::performParsing(const QStringList &directories, const QStringList &excludeDirectories, CStatusMessageList &messages)
             {
+                //
+                // function has to be threadsafe
+                //
+
+                QElapsedTimer time;
+                time.start();
+
+                const QString manifestFile = CAircraftCfgManifest::manifestFileName(this->getSimulator());
+                CAircraftCfgManifest manifest;
+                manifest.load(manifestFile);
+
+                ParsingState state;
+                state.excludeDirectories = excludeDirectories;
+                state.manifest = &manifest;
+                state.directories = directories;
+
+                // the directory trees differ a lot in size, so the threads take the directories
+                // from one queue instead of splitting the trees upfront
+                const int threads = qBound(1, QThread::idealThreadCount(), MaxParsingThreads);
+                CThreadUtils::parallelFor(threads, threads, [this, &state](int) { this->parsingWorker(state); });
+
+                messages.push_back(state.messages);
+                if (m_cancelLoading) { return CAircraftCfgEntriesList(); }
+
+                // same order independent of the threads
+                std::sort(state.files.begin(), state.files.end(), [](const auto & a, const auto & b)
+                {
+                    return QString::compare(a.first, b.first, Qt::CaseInsensitive) < 0;
+                });
+
                 CAircraftCfgEntriesList entries;
-                for (const QString &dir : directories)
+                manifest.removeInDirectories(directories);
+                for (const auto &file : state.files)
                 {
-                    entries.push_back(this->performParsing(dir, excludeDirectories, messages));
+                    entries.push_back(file.second.entries);
+                    manifest.insert(file.first, file.second);
                 }
+
+                const CStatusMessage saved = manifest.save(manifestFile);
+                if (saved.isFailure()) { messages.push_back(saved); }
+
+                const QString summary = QStringLiteral("%1 unchanged, %2 reparsed (%3 directories, %4ms)").arg(state.unchanged).arg(state.reparsed).arg(state.directoriesParsed).arg(time.elapsed());
+                messages.push_back(CStatusMessage(this).info(u"Parsed aircraft config files: %1") << summary);
+                emit this->loadingProgress(this->getSimulator(), summary, -1);
                 return entries;
             }
 
-            CAircraftCfgEntriesList CAircraftCfgParser::performParsing(const QString &directory, const QStringList &excludeDirectories, CStatusMessageList &messages)
+            void CAircraftCfgParser::parsingWorker(ParsingState &state)
+            {
+                QMutexLocker lock(&state.mutex);
+                while (true)
+                {
+                    while (state.directories.isEmpty() && state.busy > 0 && !m_cancelLoading)
+                    {
+                        state.wakeUp.wait(&state.mutex);
+                    }
+                    if (state.directories.isEmpty() || m_cancelLoading)
+                    {
+                        // all done, release the waiting threads
+                        state.wakeUp.wakeAll();
+                        return;
+                    }
+
+                    // depth first keeps the queue short
+                    const QString directory = state.directories.takeLast();
+                    state.busy++;
+                    lock.unlock();
+                    this->parseDirectory(directory, state);
+                    lock.relock();
+                    state.busy--;
+                    state.directoriesParsed++;
+                }
+            }
+
+            void CAircraftCfgParser::parseDirectory(const QString &directory, ParsingState &state)
             {
                 //
                 // function has to be threadsafe
                 //
 
-                if (m_cancelLoading) { return CAircraftCfgEntriesList(); }
+                if (m_cancelLoading) { return; }
 
                 // excluded?
-                if (CFileUtils::isExcludedDirectory(directory, excludeDirectories) || isExcludedSubDirectory(directory))
+                if (CFileUtils::isExcludedDirectory(directory, state.excludeDirectories) || isExcludedSubDirectory(directory))
                 {
                     const CStatusMessage m = CStatusMessage(this).info(u"Skipping directory '%1' (excluded)") << directory;
-                    messages.push_back(m);
-                    return CAircraftCfgEntriesList();
+                    state.addMessage(m);
+                    return;
                 }
 
                 // set directory with name filters, get aircraft.cfg and sub directories
@@ -163,17 +279,26 @@ namespace BlackMisc
                 dir.setNameFilters(fileNameFilters());
                 if (!dir.exists())
                 {
-                    return CAircraftCfgEntriesList(); // can happen if there are shortcuts or linked dirs not available
+                    return; // can happen if there are shortcuts or linked dirs not available
                 }
 
                 const QString currentDir = dir.absolutePath();
-                CAircraftCfgEntriesList result;
                 emit this->loadingProgress(this->getSimulator(), QStringLiteral("Parsing '%1'").arg(currentDir), -1);
 
-                // Dirs last is crucial, since I will break recursion on "aircraft.cfg" level
-                // with T514 this behaviour has been changed
+                // with T514 the recursion does not stop on "aircraft.cfg" level anymore
                 const QFileInfoList files = dir.entryInfoList(QDir::Files | QDir::AllDirs | QDir::NoDotAndDotDot, QDir::DirsLast);
 
+                // queue the sub directories first, so idle threads can start on them
+                QStringList subDirectories;
+                for (const QFileInfo &fileInfo : files)
+                {
+                    if (!fileInfo.isDir()) { continue; }
+                    const QString nextDir = fileInfo.absoluteFilePath();
+                    if (currentDir.startsWith(nextDir, Qt::CaseInsensitive)) { continue; } // do not go up
+                    subDirectories.push_back(nextDir);
+                }
+                state.addDirectories(subDirectories);
+
                 // the sim.cfg/aircraft.cfg file should have an *.air file sibling
                 // if not we assume these files can be ignored
                 const QDir dirForAir(directory, CFsDirectories::airFileFilter(), QDir::Name, QDir::Files | QDir::NoDotAndDotDot);
@@ -183,59 +308,68 @@ namespace BlackMisc
                 if (CBuildConfig::buildWordSize() != 32 && !hasAirFiles)
                 {
                     const CStatusMessage m = CStatusMessage(this).warning(u"No \"air\" files in '%1'") << currentDir;
-                    messages.push_back(m);
+                    state.addMessage(m);
+
+                    // Enforce air files only for 64 bit P3D
+                    return;
                 }
 
-                for (const auto &fileInfo : files)
+                for (const QFileInfo &fileInfo : files)
                 {
-                    if (m_cancelLoading) { return CAircraftCfgEntriesList(); }
-                    if (fileInfo.isDir())
-                    {
-                        const QString nextDir = fileInfo.absoluteFilePath();
-                        if (currentDir.startsWith(nextDir, Qt::CaseInsensitive)) { continue; } // do not go up
-                        if (dir == currentDir) { continue; } // do not recursively call same directory
+                    if (m_cancelLoading) { return; }
+                    if (fileInfo.isDir()) { continue; }
 
-                        const CAircraftCfgEntriesList subList(performParsing(nextDir, excludeDirectories, messages));
-                        if (messages.isSuccess())
-                        {
-                            result.push_back(subList);
-                        }
-                        else
-                        {
-                            const CStatusMessage m = CStatusMessage(this).warning(u"Parsing failed for '%1'") << nextDir;
-                            messages.push_back(m);
-                        }
-                    }
-                    else
-                    {
-                        // Enforce air files only for 64 bit P3D
-                        if (CBuildConfig::buildWordSize() != 32 && !hasAirFiles) { continue; }
-
-                        // due to the filter we expect only "aircraft.cfg"/"sim.cfg" here
-                        // remark: in a 1st version I have used QSettings to parse to file as ini file
-                        // unfortunately some files are malformed which could end up in wrong data
-
-                        const QString fileName = fileInfo.absoluteFilePath(); // full path and name
-                        bool fileOk = false;
-                        CStatusMessageList fileMsgs;
-                        const CAircraftCfgEntriesList fileResults = CAircraftCfgParser::performParsingOfSingleFile(fileName, fileOk, fileMsgs);
-                        if (!fileOk)
-                        {
-                            const CStatusMessage m = CStatusMessage(this).warning(u"Parsing of '%1' failed") << fileName;
-                            messages.push_back(fileMsgs);
-                            continue;
-                        }
+                    // due to the filter we expect only "aircraft.cfg"/"sim.cfg" here
+                    this->parseFile(fileInfo, state);
+                }
+            }
 
-                        result.push_back(fileResults);
+            void CAircraftCfgParser::parseFile(const QFileInfo &fileInfo, ParsingState &state)
+            {
+                const QString fileName = fileInfo.absoluteFilePath(); // full path and name
+                const qint64 lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+                const qint64 size = fileInfo.size();
 
-                        // With T514 we do not skip not anymore
-                        // return result; // do not go any deeper in file tree, we found aircraft.cfg
-                    }
+                // same time and size, no need to read the file
+                const CAircraftCfgManifest::Entry *unchanged = state.manifest->findUnchanged(fileName, lastModified, size);
+                if (unchanged)
+                {
+                    state.addFile(fileName, *unchanged, false);
+                    return;
                 }
 
-                // all files finished,
-                // normally reached when no aircraft.cfg is found
-                return result;
+                const QString fnFixed = CFileUtils::fixWindowsUncPath(fileName);
+                QFile file(fnFixed);
+                if (!file.open(QFile::ReadOnly))
+                {
+                    const CStatusMessage m = CStatusMessage(this).warning(u"Unable to read file '%1'") << fnFixed;
+                    state.addMessage(m);
+                    return;
+                }
+
+                CAircraftCfgManifest::Entry entry;
+                const QByteArray content = file.readAll();
+                file.close();
+                entry.lastModified = lastModified;
+                entry.size = size;
+                entry.hash = CAircraftCfgManifest::contentHash(content);
+                const QDateTime timestamp = fileTimestamp(fileInfo);
+
+                // touched, but same content
+                const CAircraftCfgManifest::Entry *sameContent = state.manifest->findSameContent(fileName, entry.hash);
+                if (sameContent)
+                {
+                    entry.entries = sameContent->entries;
+                    for (CAircraftCfgEntries &e : entry.entries) { e.setUtcTimestamp(timestamp); }
+                    state.addFile(fileName, entry, false);
+                    return;
+                }
+
+                // remark: in a 1st version I have used QSettings to parse to file as ini file
+                // unfortunately some files are malformed which could end up in wrong data
+                CStatusMessageList fileMsgs;
+                entry.entries = CAircraftCfgParser::parseContent(fileName, content, timestamp, fileMsgs);
+                state.addFile(fileName, entry, true);
             }
 
             CAircraftCfgEntriesList CAircraftCfgParser::performParsingOfSingleFile(const QString &fileName, bool &ok, CStatusMessageList &msgs)
@@ -247,14 +381,33 @@ namespace BlackMisc
                 ok = false;
                 const QString fnFixed = CFileUtils::fixWindowsUncPath(fileName);
                 QFile file(fnFixed); // includes path
-                if (!file.open(QFile::ReadOnly | QFile::Text))
+                if (!file.open(QFile::ReadOnly))
                 {
                     const CStatusMessage m = CStatusMessage(static_cast<CAircraftCfgParser *>(nullptr)).warning(u"Unable to read file '%1'") << fnFixed;
                     msgs.push_back(m);
                     return CAircraftCfgEntriesList();
                 }
+                const QByteArray content = file.readAll();
+                file.close();
+
+                ok = true;
+                return CAircraftCfgParser::parseContent(fileName, content, fileTimestamp(QFileInfo(fnFixed)), msgs);
+            }
+
+            QDateTime CAircraftCfgParser::fileTimestamp(const QFileInfo &fileInfo)
+            {
+                QDateTime timestamp(fileInfo.lastModified());
+                if (!timestamp.isValid() || fileInfo.birthTime() > timestamp)
+                {
+                    timestamp = fileInfo.birthTime();
+                }
+                Q_ASSERT_X(timestamp.isValid(), Q_FUNC_INFO, "Missing file timestamp");
+                return timestamp;
+            }
 
-                QTextStream in(&file);
+            CAircraftCfgEntriesList CAircraftCfgParser::parseContent(const QString &fileName, const QByteArray &content, const QDateTime &timestamp, CStatusMessageList &msgs)
+            {
+                QTextStream in(content);
                 QList<CAircraftCfgEntries> tempEntries;
 
                 // parse through the file
@@ -377,17 +530,8 @@ namespace BlackMisc
                     case Unknown: break;
                     }
                 } // all lines
-                file.close();
 
                 // store all entries
-                const QFileInfo fileInfo(fnFixed);
-                QDateTime fileTimestamp(fileInfo.lastModified());
-                if (!fileTimestamp.isValid() || fileInfo.birthTime() > fileTimestamp)
-                {
-                    fileTimestamp = fileInfo.birthTime();
-                }
-                Q_ASSERT_X(fileTimestamp.isValid(), Q_FUNC_INFO, "Missing file timestamp");
-
                 CAircraftCfgEntriesList result;
                 for (const CAircraftCfgEntries &e : as_const(tempEntries))
                 {
@@ -400,11 +544,10 @@ namespace BlackMisc
                     CAircraftCfgEntries newEntries(e);
                     newEntries.setAtcModel(atcModel);
                     newEntries.setAtcType(atcType);
-                    newEntries.setUtcTimestamp(fileTimestamp);
+                    newEntries.setUtcTimestamp(timestamp);
                     result.push_back(newEntries);
                 }
-                ok = true;
-                return result; // do not go any deeper in file tree, we found aircraft.cfg
+                return result;
             }
 
             QString CAircraftCfgParser::fixedStringContent(const QSettings &settings, const QString &key)
@@ -17,6 +17,7 @@
 #include "blackmisc/simulation/fscommon/aircraftcfgentrieslist.h"
 #include "blackmisc/simulation/simulatorinfo.h"
 
+#include <QByteArray>
 #include <QObject>
 #include <QPointer>
 #include <QString>
@@ -24,6 +25,8 @@
 #include <QVariant>
 #include <memory>
 
+class QDateTime;
+class QFileInfo;
 class QSettings;
 
 namespace BlackMisc
@@ -74,17 +77,37 @@ namespace BlackMisc
                     Unknown
                 };
 
+                //! Shared state of the parsing threads
+                struct ParsingState;
+
+                //! Max. number of threads walking the directories and parsing the files
+                static constexpr int MaxParsingThreads = 8;
+
                 //! Perform the parsing for all directories
+                //! \remark directories are walked and files parsed by several threads,
+                //!         files unchanged since the last scan are taken from the manifest
                 //! \threadsafe
                 CAircraftCfgEntriesList performParsing(
                     const QStringList &directories, const QStringList &excludeDirectories,
                     BlackMisc::CStatusMessageList &messages);
 
-                //! Perform the parsing for one directory
+                //! Take directories from the shared queue until all are parsed
                 //! \threadsafe
-                CAircraftCfgEntriesList performParsing(
-                    const QString &directory, const QStringList &excludeDirectories,
-                    BlackMisc::CStatusMessageList &messages);
+                void parsingWorker(ParsingState &state);
+
+                //! Parse the files of one directory, queue the sub directories
+                //! \threadsafe
+                void parseDirectory(const QString &directory, ParsingState &state);
+
+                //! Parse one file unless unchanged
+                //! \threadsafe
+                void parseFile(const QFileInfo &fileInfo, ParsingState &state);
+
+                //! Parse the content of a file
+                static CAircraftCfgEntriesList parseContent(const QString &fileName, const QByteArray &content, const QDateTime &timestamp, CStatusMessageList &msgs);
+
+                //! Timestamp of a file, modification or creation time, whichever is later
+                static QDateTime fileTimestamp(const QFileInfo &fileInfo);
 
                 //! Fix the content read
                 static QString fixedStringContent(const QVariant &qv);
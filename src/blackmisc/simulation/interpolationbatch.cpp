@@ -0,0 +1,52 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/interpolationbatch.h"
+#include "blackmisc/simulation/interpolatormulti.h"
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        int CInterpolationBatch::add(CInterpolatorMulti *interpolator, const CInterpolationAndRenderingSetupPerCallsign &setup)
+        {
+            Q_ASSERT_X(interpolator, Q_FUNC_INFO, "Missing interpolator");
+            m_interpolators.push_back(interpolator);
+            m_setups.push_back(setup);
+            return m_interpolators.size() - 1;
+        }
+
+        void CInterpolationBatch::clear()
+        {
+            m_interpolators.clear();
+            m_setups.clear();
+        }
+
+        int CInterpolationBatch::interpolate(qint64 currentTimeSinceEpoc, const CRemoteAircraftSnapshotPtr &snapshot, QVector<CCompactInterpolationResult> &results)
+        {
+            const int size = m_interpolators.size();
+            results.resize(size);
+
+            // interpolants of all aircraft, then their positions by one kernel call
+            m_lanes.clear();
+            for (int i = 0; i < size; i++)
+            {
+                m_interpolators[i]->prepareInterpolationCompact(currentTimeSinceEpoc, m_setups[i], i, snapshot, m_lanes);
+            }
+            m_lanes.evaluate();
+
+            int valid = 0;
+            for (int i = 0; i < size; i++)
+            {
+                results[i] = m_interpolators[i]->finishInterpolationCompact(m_setups[i].getInterpolatorMode(), m_lanes);
+                if (results[i].hasValidSituation()) { valid++; }
+            }
+            return valid;
+        }
+    } // namespace
+} // namespace
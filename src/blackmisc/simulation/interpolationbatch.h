@@ -0,0 +1,76 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_INTERPOLATIONBATCH_H
+#define BLACKMISC_SIMULATION_INTERPOLATIONBATCH_H
+
+#include "blackmisc/simulation/interpolationkernels.h"
+#include "blackmisc/simulation/interpolationrenderingsetup.h"
+#include "blackmisc/simulation/interpolator.h"
+#include "blackmisc/simulation/remoteaircraftsnapshot.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QVector>
+#include <QtGlobal>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        class CInterpolatorMulti;
+
+        //! Interpolates many remote aircraft in one call
+        //! \remark all aircraft share one remote aircraft snapshot, the results are written to a plain array
+        //!         of CCompactInterpolationResult, so no CInterpolationResult is created per aircraft
+        //! \remark the positions of all aircraft are interpolated by one call of the SIMD kernels, see CInterpolationLanes
+        //! \remark interpolators are owned by the caller (i.e. the simulator's aircraft objects),
+        //!         the aircraft are added for every frame, so removed aircraft cannot be left over
+        class BLACKMISC_EXPORT CInterpolationBatch
+        {
+        public:
+            //! Ctor
+            CInterpolationBatch() = default;
+
+            //! Add aircraft for the next CInterpolationBatch::interpolate
+            //! \remark interpolator is not owned and has to outlive the interpolation
+            //! \return index of the aircraft's result
+            int add(CInterpolatorMulti *interpolator, const CInterpolationAndRenderingSetupPerCallsign &setup);
+
+            //! Remove all aircraft, the allocated memory is kept for the next frame
+            void clear();
+
+            //! Number of aircraft
+            int size() const { return m_interpolators.size(); }
+
+            //! No aircraft?
+            bool isEmpty() const { return m_interpolators.isEmpty(); }
+
+            //! Interpolator of the aircraft at index, e.g. for the last interpolated situation
+            CInterpolatorMulti *interpolator(int index) const { return m_interpolators[index]; }
+
+            //! Setup of the aircraft at index
+            const CInterpolationAndRenderingSetupPerCallsign &setup(int index) const { return m_setups[index]; }
+
+            //! Interpolate all aircraft
+            //! \param currentTimeSinceEpoc
+            //! \param snapshot provider data shared by all aircraft, if null the current snapshot is fetched by each interpolator
+            //! \param results one result per aircraft in the order they were added, the memory is re-used
+            //! \return number of valid situations
+            int interpolate(qint64 currentTimeSinceEpoc, const CRemoteAircraftSnapshotPtr &snapshot, QVector<CCompactInterpolationResult> &results);
+
+        private:
+            QVector<CInterpolatorMulti *> m_interpolators; //!< not owned
+            QVector<CInterpolationAndRenderingSetupPerCallsign> m_setups; //!< setup per aircraft
+            CInterpolationLanes m_lanes; //!< kernel values of all aircraft, memory re-used
+        };
+    } // namespace
+} // namespace
+
+#endif // guard
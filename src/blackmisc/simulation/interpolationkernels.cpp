@@ -0,0 +1,380 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/interpolationkernels.h"
+#include "blackmisc/cpufeatures.h"
+
+#include <QtGlobal>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        namespace
+        {
+            //! \private Linear, reference
+            void linearScalar(const double *y0, const double *y1, const double *fraction, double *out, int from, int n)
+            {
+                for (int i = from; i < n; i++)
+                {
+                    out[i] = (y1[i] - y0[i]) * fraction[i] + y0[i];
+                }
+            }
+
+            //! \private Hermite, reference
+            void hermiteScalar(const double *x, const double *x0, const double *x1,
+                               const double *y0, const double *y1, const double *k0, const double *k1,
+                               double *out, int from, int n)
+            {
+                for (int i = from; i < n; i++)
+                {
+                    const double h  = x1[i] - x0[i];
+                    const double dy = y1[i] - y0[i];
+                    const double t  = (x[i] - x0[i]) / h;
+                    const double a  =  k0[i] * h - dy;
+                    const double b  = -k1[i] * h + dy;
+                    out[i] = (1 - t) * y0[i] + t * y1[i] + t * (1 - t) * (a * (1 - t) + b * t);
+                }
+            }
+
+            //! \private Derivatives, reference, the 3x3 tridiagonal solver (Thomas algorithm) unrolled
+            void splineDerivatives3Scalar(const double *t0, const double *t1, const double *t2,
+                                          const double *y0, const double *y1, const double *y2,
+                                          double *k0, double *k1, double *k2, int from, int n)
+            {
+                for (int i = from; i < n; i++)
+                {
+                    const double h0 = t1[i] - t0[i];
+                    const double h1 = t2[i] - t1[i];
+                    const double a00 = 2.0 / h0;
+                    const double a01 = 1.0 / h0;
+                    const double a10 = 1.0 / h0;
+                    const double a11 = 2.0 / h0 + 2.0 / h1;
+                    const double a12 = 1.0 / h1;
+                    const double a21 = 1.0 / h1;
+                    const double a22 = 2.0 / h1;
+                    const double b0  = 3.0 * (y1[i] - y0[i]) / (h0 * h0);
+                    const double b2  = 3.0 * (y2[i] - y1[i]) / (h1 * h1);
+                    const double b1  = b0 + b2;
+
+                    // forward sweep
+                    const double c0 = a01 / a00;
+                    double d0 = b0 / a00;
+                    const double denom1 = a11 - a10 * c0;
+                    const double c1 = a12 / denom1;
+                    double d1 = (b1 - a10 * d0) / denom1;
+                    const double denom2 = a22 - a21 * c1;
+                    const double d2 = (b2 - a21 * d1) / denom2;
+
+                    // back substitution
+                    d1 -= c1 * d2;
+                    d0 -= c0 * d1;
+
+                    k0[i] = d0;
+                    k1[i] = d1;
+                    k2[i] = d2;
+                }
+            }
+
+#if defined(BLACK_KERNELS_X86)
+            BLACK_TARGET_SSE2 void linearSse2(const double *y0, const double *y1, const double *fraction, double *out, int n)
+            {
+                int i = 0;
+                for (; i + 2 <= n; i += 2)
+                {
+                    const __m128d v0 = _mm_loadu_pd(y0 + i);
+                    const __m128d v1 = _mm_loadu_pd(y1 + i);
+                    const __m128d f  = _mm_loadu_pd(fraction + i);
+                    _mm_storeu_pd(out + i, _mm_add_pd(_mm_mul_pd(_mm_sub_pd(v1, v0), f), v0));
+                }
+                linearScalar(y0, y1, fraction, out, i, n);
+            }
+
+            BLACK_TARGET_AVX2 void linearAvx2(const double *y0, const double *y1, const double *fraction, double *out, int n)
+            {
+                int i = 0;
+                for (; i + 4 <= n; i += 4)
+                {
+                    const __m256d v0 = _mm256_loadu_pd(y0 + i);
+                    const __m256d v1 = _mm256_loadu_pd(y1 + i);
+                    const __m256d f  = _mm256_loadu_pd(fraction + i);
+                    _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(v1, v0), f), v0));
+                }
+                linearScalar(y0, y1, fraction, out, i, n);
+            }
+
+            BLACK_TARGET_SSE2 void hermiteSse2(const double *x, const double *x0, const double *x1,
+                                               const double *y0, const double *y1, const double *k0, const double *k1,
+                                               double *out, int n)
+            {
+                const __m128d one = _mm_set1_pd(1.0);
+                int i = 0;
+                for (; i + 2 <= n; i += 2)
+                {
+                    const __m128d vx0 = _mm_loadu_pd(x0 + i);
+                    const __m128d vy0 = _mm_loadu_pd(y0 + i);
+                    const __m128d vy1 = _mm_loadu_pd(y1 + i);
+                    const __m128d h   = _mm_sub_pd(_mm_loadu_pd(x1 + i), vx0);
+                    const __m128d dy  = _mm_sub_pd(vy1, vy0);
+                    const __m128d t   = _mm_div_pd(_mm_sub_pd(_mm_loadu_pd(x + i), vx0), h);
+                    const __m128d mt  = _mm_sub_pd(one, t);
+                    const __m128d a   = _mm_sub_pd(_mm_mul_pd(_mm_loadu_pd(k0 + i), h), dy);
+                    const __m128d b   = _mm_sub_pd(dy, _mm_mul_pd(_mm_loadu_pd(k1 + i), h));
+                    const __m128d lin = _mm_add_pd(_mm_mul_pd(mt, vy0), _mm_mul_pd(t, vy1));
+                    const __m128d cub = _mm_mul_pd(_mm_mul_pd(t, mt), _mm_add_pd(_mm_mul_pd(a, mt), _mm_mul_pd(b, t)));
+                    _mm_storeu_pd(out + i, _mm_add_pd(lin, cub));
+                }
+                hermiteScalar(x, x0, x1, y0, y1, k0, k1, out, i, n);
+            }
+
+            BLACK_TARGET_AVX2 void hermiteAvx2(const double *x, const double *x0, const double *x1,
+                                               const double *y0, const double *y1, const double *k0, const double *k1,
+                                               double *out, int n)
+            {
+                const __m256d one = _mm256_set1_pd(1.0);
+                int i = 0;
+                for (; i + 4 <= n; i += 4)
+                {
+                    const __m256d vx0 = _mm256_loadu_pd(x0 + i);
+                    const __m256d vy0 = _mm256_loadu_pd(y0 + i);
+                    const __m256d vy1 = _mm256_loadu_pd(y1 + i);
+                    const __m256d h   = _mm256_sub_pd(_mm256_loadu_pd(x1 + i), vx0);
+                    const __m256d dy  = _mm256_sub_pd(vy1, vy0);
+                    const __m256d t   = _mm256_div_pd(_mm256_sub_pd(_mm256_loadu_pd(x + i), vx0), h);
+                    const __m256d mt  = _mm256_sub_pd(one, t);
+                    const __m256d a   = _mm256_sub_pd(_mm256_mul_pd(_mm256_loadu_pd(k0 + i), h), dy);
+                    const __m256d b   = _mm256_sub_pd(dy, _mm256_mul_pd(_mm256_loadu_pd(k1 + i), h));
+                    const __m256d lin = _mm256_add_pd(_mm256_mul_pd(mt, vy0), _mm256_mul_pd(t, vy1));
+                    const __m256d cub = _mm256_mul_pd(_mm256_mul_pd(t, mt), _mm256_add_pd(_mm256_mul_pd(a, mt), _mm256_mul_pd(b, t)));
+                    _mm256_storeu_pd(out + i, _mm256_add_pd(lin, cub));
+                }
+                hermiteScalar(x, x0, x1, y0, y1, k0, k1, out, i, n);
+            }
+
+            BLACK_TARGET_SSE2 void splineDerivatives3Sse2(const double *t0, const double *t1, const double *t2,
+                    const double *y0, const double *y1, const double *y2,
+                    double *k0, double *k1, double *k2, int n)
+            {
+                const __m128d one   = _mm_set1_pd(1.0);
+                const __m128d two   = _mm_set1_pd(2.0);
+                const __m128d three = _mm_set1_pd(3.0);
+                int i = 0;
+                for (; i + 2 <= n; i += 2)
+                {
+                    const __m128d vt1 = _mm_loadu_pd(t1 + i);
+                    const __m128d vy1 = _mm_loadu_pd(y1 + i);
+                    const __m128d h0  = _mm_sub_pd(vt1, _mm_loadu_pd(t0 + i));
+                    const __m128d h1  = _mm_sub_pd(_mm_loadu_pd(t2 + i), vt1);
+                    const __m128d a00 = _mm_div_pd(two, h0);
+                    const __m128d a01 = _mm_div_pd(one, h0); // also a10
+                    const __m128d a11 = _mm_add_pd(a00, _mm_div_pd(two, h1));
+                    const __m128d a12 = _mm_div_pd(one, h1); // also a21
+                    const __m128d a22 = _mm_div_pd(two, h1);
+                    const __m128d b0  = _mm_div_pd(_mm_mul_pd(three, _mm_sub_pd(vy1, _mm_loadu_pd(y0 + i))), _mm_mul_pd(h0, h0));
+                    const __m128d b2  = _mm_div_pd(_mm_mul_pd(three, _mm_sub_pd(_mm_loadu_pd(y2 + i), vy1)), _mm_mul_pd(h1, h1));
+                    const __m128d b1  = _mm_add_pd(b0, b2);
+
+                    const __m128d c0 = _mm_div_pd(a01, a00);
+                    __m128d d0 = _mm_div_pd(b0, a00);
+                    const __m128d denom1 = _mm_sub_pd(a11, _mm_mul_pd(a01, c0));
+                    const __m128d c1 = _mm_div_pd(a12, denom1);
+                    __m128d d1 = _mm_div_pd(_mm_sub_pd(b1, _mm_mul_pd(a01, d0)), denom1);
+                    const __m128d denom2 = _mm_sub_pd(a22, _mm_mul_pd(a12, c1));
+                    const __m128d d2 = _mm_div_pd(_mm_sub_pd(b2, _mm_mul_pd(a12, d1)), denom2);
+
+                    d1 = _mm_sub_pd(d1, _mm_mul_pd(c1, d2));
+                    d0 = _mm_sub_pd(d0, _mm_mul_pd(c0, d1));
+
+                    _mm_storeu_pd(k0 + i, d0);
+                    _mm_storeu_pd(k1 + i, d1);
+                    _mm_storeu_pd(k2 + i, d2);
+                }
+                splineDerivatives3Scalar(t0, t1, t2, y0, y1, y2, k0, k1, k2, i, n);
+            }
+
+            BLACK_TARGET_AVX2 void splineDerivatives3Avx2(const double *t0, const double *t1, const double *t2,
+                    const double *y0, const double *y1, const double *y2,
+                    double *k0, double *k1, double *k2, int n)
+            {
+                const __m256d one   = _mm256_set1_pd(1.0);
+                const __m256d two   = _mm256_set1_pd(2.0);
+                const __m256d three = _mm256_set1_pd(3.0);
+                int i = 0;
+                for (; i + 4 <= n; i += 4)
+                {
+                    const __m256d vt1 = _mm256_loadu_pd(t1 + i);
+                    const __m256d vy1 = _mm256_loadu_pd(y1 + i);
+                    const __m256d h0  = _mm256_sub_pd(vt1, _mm256_loadu_pd(t0 + i));
+                    const __m256d h1  = _mm256_sub_pd(_mm256_loadu_pd(t2 + i), vt1);
+                    const __m256d a00 = _mm256_div_pd(two, h0);
+                    const __m256d a01 = _mm256_div_pd(one, h0); // also a10
+                    const __m256d a11 = _mm256_add_pd(a00, _mm256_div_pd(two, h1));
+                    const __m256d a12 = _mm256_div_pd(one, h1); // also a21
+                    const __m256d a22 = _mm256_div_pd(two, h1);
+                    const __m256d b0  = _mm256_div_pd(_mm256_mul_pd(three, _mm256_sub_pd(vy1, _mm256_loadu_pd(y0 + i))), _mm256_mul_pd(h0, h0));
+                    const __m256d b2  = _mm256_div_pd(_mm256_mul_pd(three, _mm256_sub_pd(_mm256_loadu_pd(y2 + i), vy1)), _mm256_mul_pd(h1, h1));
+                    const __m256d b1  = _mm256_add_pd(b0, b2);
+
+                    const __m256d c0 = _mm256_div_pd(a01, a00);
+                    __m256d d0 = _mm256_div_pd(b0, a00);
+                    const __m256d denom1 = _mm256_sub_pd(a11, _mm256_mul_pd(a01, c0));
+                    const __m256d c1 = _mm256_div_pd(a12, denom1);
+                    __m256d d1 = _mm256_div_pd(_mm256_sub_pd(b1, _mm256_mul_pd(a01, d0)), denom1);
+                    const __m256d denom2 = _mm256_sub_pd(a22, _mm256_mul_pd(a12, c1));
+                    const __m256d d2 = _mm256_div_pd(_mm256_sub_pd(b2, _mm256_mul_pd(a12, d1)), denom2);
+
+                    d1 = _mm256_sub_pd(d1, _mm256_mul_pd(c1, d2));
+                    d0 = _mm256_sub_pd(d0, _mm256_mul_pd(c0, d1));
+
+                    _mm256_storeu_pd(k0 + i, d0);
+                    _mm256_storeu_pd(k1 + i, d1);
+                    _mm256_storeu_pd(k2 + i, d2);
+                }
+                splineDerivatives3Scalar(t0, t1, t2, y0, y1, y2, k0, k1, k2, i, n);
+            }
+
+#endif
+
+            //! \private Selected instruction set
+            CKernelInstructionSet<CInterpolationKernels::InstructionSet> &selectedInstructionSet()
+            {
+                static CKernelInstructionSet<CInterpolationKernels::InstructionSet> set(CInterpolationKernels::detectedInstructionSet());
+                return set;
+            }
+        }
+
+        CInterpolationKernels::InstructionSet CInterpolationKernels::detectedInstructionSet()
+        {
+            static const InstructionSet detected = CCpuFeatures::isSupported(CCpuFeatures::AVX2) ? AVX2 :
+                                                   CCpuFeatures::isSupported(CCpuFeatures::SSE2) ? SSE2 : Scalar;
+            return detected;
+        }
+
+        CInterpolationKernels::InstructionSet CInterpolationKernels::instructionSet()
+        {
+            return selectedInstructionSet().get();
+        }
+
+        bool CInterpolationKernels::setInstructionSet(InstructionSet set)
+        {
+            if (!isSupported(set)) { return false; }
+            selectedInstructionSet().set(set);
+            return true;
+        }
+
+        const QString &CInterpolationKernels::instructionSetToString(InstructionSet set)
+        {
+            static const QString scalar("scalar");
+            static const QString sse2("SSE2");
+            static const QString avx2("AVX2");
+            switch (set)
+            {
+            case SSE2: return sse2;
+            case AVX2: return avx2;
+            default: break;
+            }
+            return scalar;
+        }
+
+        void CInterpolationKernels::linear(const double *y0, const double *y1, const double *fraction, double *out, int n)
+        {
+#if defined(BLACK_KERNELS_X86)
+            switch (instructionSet())
+            {
+            case AVX2: linearAvx2(y0, y1, fraction, out, n); return;
+            case SSE2: linearSse2(y0, y1, fraction, out, n); return;
+            default: break;
+            }
+#endif
+            linearScalar(y0, y1, fraction, out, 0, n);
+        }
+
+        void CInterpolationKernels::hermite(const double *x, const double *x0, const double *x1,
+                                            const double *y0, const double *y1, const double *k0, const double *k1,
+                                            double *out, int n)
+        {
+#if defined(BLACK_KERNELS_X86)
+            switch (instructionSet())
+            {
+            case AVX2: hermiteAvx2(x, x0, x1, y0, y1, k0, k1, out, n); return;
+            case SSE2: hermiteSse2(x, x0, x1, y0, y1, k0, k1, out, n); return;
+            default: break;
+            }
+#endif
+            hermiteScalar(x, x0, x1, y0, y1, k0, k1, out, 0, n);
+        }
+
+        void CInterpolationKernels::splineDerivatives3(const double *t0, const double *t1, const double *t2,
+                const double *y0, const double *y1, const double *y2,
+                double *k0, double *k1, double *k2, int n)
+        {
+#if defined(BLACK_KERNELS_X86)
+            switch (instructionSet())
+            {
+            case AVX2: splineDerivatives3Avx2(t0, t1, t2, y0, y1, y2, k0, k1, k2, n); return;
+            case SSE2: splineDerivatives3Sse2(t0, t1, t2, y0, y1, y2, k0, k1, k2, n); return;
+            default: break;
+            }
+#endif
+            splineDerivatives3Scalar(t0, t1, t2, y0, y1, y2, k0, k1, k2, 0, n);
+        }
+
+        void CInterpolationLanes::clear()
+        {
+            for (QVector<double> *lanes : { &m_linearY0, &m_linearY1, &m_linearFraction, &m_linearOut,
+                                            &m_hermiteX, &m_hermiteX0, &m_hermiteX1, &m_hermiteY0, &m_hermiteY1, &m_hermiteK0, &m_hermiteK1, &m_hermiteOut })
+            {
+                lanes->clear();
+            }
+        }
+
+        int CInterpolationLanes::addLinear(const double *y0, const double *y1, double fraction, int channels)
+        {
+            const int index = m_linearY0.size();
+            for (int c = 0; c < channels; c++)
+            {
+                m_linearY0.push_back(y0[c]);
+                m_linearY1.push_back(y1[c]);
+                m_linearFraction.push_back(fraction);
+            }
+            return index;
+        }
+
+        int CInterpolationLanes::addHermite(double x, double x0, double x1, const double *y0, const double *y1, const double *k0, const double *k1, int channels)
+        {
+            const int index = m_hermiteX.size();
+            for (int c = 0; c < channels; c++)
+            {
+                m_hermiteX.push_back(x);
+                m_hermiteX0.push_back(x0);
+                m_hermiteX1.push_back(x1);
+                m_hermiteY0.push_back(y0[c]);
+                m_hermiteY1.push_back(y1[c]);
+                m_hermiteK0.push_back(k0[c]);
+                m_hermiteK1.push_back(k1[c]);
+            }
+            return index;
+        }
+
+        void CInterpolationLanes::evaluate()
+        {
+            m_linearOut.resize(m_linearY0.size());
+            m_hermiteOut.resize(m_hermiteX.size());
+            if (!m_linearOut.isEmpty())
+            {
+                CInterpolationKernels::linear(m_linearY0.constData(), m_linearY1.constData(), m_linearFraction.constData(), m_linearOut.data(), m_linearOut.size());
+            }
+            if (!m_hermiteOut.isEmpty())
+            {
+                CInterpolationKernels::hermite(m_hermiteX.constData(), m_hermiteX0.constData(), m_hermiteX1.constData(),
+                                               m_hermiteY0.constData(), m_hermiteY1.constData(), m_hermiteK0.constData(), m_hermiteK1.constData(),
+                                               m_hermiteOut.data(), m_hermiteOut.size());
+            }
+        }
+    } // namespace
+} // namespace
@@ -0,0 +1,105 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_INTERPOLATIONKERNELS_H
+#define BLACKMISC_SIMULATION_INTERPOLATIONKERNELS_H
+
+#include "blackmisc/blackmiscexport.h"
+
+#include <QString>
+#include <QVector>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        //! Interpolation kernels working on plain arrays, one index per aircraft (or per channel)
+        //! \remark the instruction set is chosen at runtime, the scalar code is the reference and the fallback
+        //! \remark used by CInterpolationLanes with the channels (x, y, z, altitude, ground factor) of many aircraft
+        //! \remark FMA is not used to stay close to the scalar results
+        class BLACKMISC_EXPORT CInterpolationKernels
+        {
+        public:
+            //! Instruction sets
+            enum InstructionSet
+            {
+                Scalar,
+                SSE2, //!< 2 doubles per register
+                AVX2  //!< 4 doubles per register
+            };
+
+            //! No objects, just static
+            CInterpolationKernels() = delete;
+
+            //! Best instruction set supported by CPU and OS
+            static InstructionSet detectedInstructionSet();
+
+            //! Instruction set used by the kernels
+            static InstructionSet instructionSet();
+
+            //! Use given instruction set, mainly for UNIT tests and benchmarks
+            //! \return false if not supported
+            static bool setInstructionSet(InstructionSet set);
+
+            //! Is instruction set supported?
+            static bool isSupported(InstructionSet set) { return set <= detectedInstructionSet(); }
+
+            //! Instruction set as string
+            static const QString &instructionSetToString(InstructionSet set);
+
+            //! Linear interpolation out = (y1 - y0) * fraction + y0
+            static void linear(const double *y0, const double *y1, const double *fraction, double *out, int n);
+
+            //! Cubic Hermite interpolation in interval [x0, x1] with slopes k0, k1
+            static void hermite(const double *x, const double *x0, const double *x1,
+                                const double *y0, const double *y1, const double *k0, const double *k1,
+                                double *out, int n);
+
+            //! Spline derivatives (slopes) for 3 points t0 < t1 < t2
+            //! \remark closed form of the 3x3 tridiagonal system
+            static void splineDerivatives3(const double *t0, const double *t1, const double *t2,
+                                           const double *y0, const double *y1, const double *y2,
+                                           double *k0, double *k1, double *k2, int n);
+        };
+
+        //! Kernel values of many aircraft, evaluated with one kernel call per frame
+        //! \remark the channels of one aircraft are adjacent, so a register holds the channels of several aircraft
+        //! \remark the channels of a single aircraft do not fill the registers, they are interpolated by scalar code
+        class BLACKMISC_EXPORT CInterpolationLanes
+        {
+        public:
+            //! Remove all lanes, the memory is kept for the next frame
+            void clear();
+
+            //! Add lanes for the linear interpolation, all channels use the same fraction
+            //! \return index of the first lane, used with linearValues
+            int addLinear(const double *y0, const double *y1, double fraction, int channels);
+
+            //! Add lanes for the cubic Hermite interpolation, all channels use the same interval [x0, x1]
+            //! \return index of the first lane, used with hermiteValues
+            int addHermite(double x, double x0, double x1, const double *y0, const double *y1, const double *k0, const double *k1, int channels);
+
+            //! Evaluate all lanes
+            void evaluate();
+
+            //! Evaluated linear values starting at index
+            const double *linearValues(int index) const { return m_linearOut.constData() + index; }
+
+            //! Evaluated cubic Hermite values starting at index
+            const double *hermiteValues(int index) const { return m_hermiteOut.constData() + index; }
+
+        private:
+            QVector<double> m_linearY0, m_linearY1, m_linearFraction, m_linearOut;
+            QVector<double> m_hermiteX, m_hermiteX0, m_hermiteX1, m_hermiteY0, m_hermiteY1, m_hermiteK0, m_hermiteK1, m_hermiteOut;
+        };
+    } // namespace
+} // namespace
+
+#endif // guard
@@ -19,9 +19,13 @@
 #include "blackmisc/swiftdirectories.h"
 #include "blackmisc/directoryutils.h"
 #include "blackmisc/stringutils.h"
+#include "blackmisc/range.h"
 #include "blackconfig/buildconfig.h"
 #include <QDateTime>
+#include <QHash>
+#include <QPointer>
 #include <QStringBuilder>
+#include <QTimer>
 
 using namespace BlackConfig;
 using namespace BlackMisc;
@@ -71,6 +75,103 @@ namespace BlackMisc
             return worker;
         }
 
+        CWorker *CInterpolationLogger::writeRecorderDumpInBackground()
+        {
+            // records first, so all their callsign ids are interned
+            const QVector<CInterpolationRecord> records = m_recorder.records();
+            const QStringList callsigns = m_recorder.callsigns();
+
+            CWorker *worker = CWorker::fromTask(this, "WriteInterpolationRecorderDump", [records, callsigns]()
+            {
+                QString file = filePatternRecorderDump();
+                file.remove('*');
+                const QString ts = QDateTime::currentDateTimeUtc().toString("yyyyMMddhhmmss");
+                const QString fn = CFileUtils::appendFilePaths(CSwiftDirectories::logDirectory(), QStringLiteral("%1 %2").arg(ts, file));
+                const bool s = CInterpolationRecorder::writeDump(fn, records, callsigns);
+                CLogMessage::preformatted(CInterpolationLogger::logStatusFileWriting(s, fn));
+            });
+            return worker;
+        }
+
+        void CInterpolationLogger::triggerRecorderDump(const QString &reason)
+        {
+            QPointer<CInterpolationLogger> myself(this);
+            QMetaObject::invokeMethod(this, [ = ]
+            {
+                if (!myself) { return; }
+                CLogMessage(this).info(u"Interpolation anomaly %1, dumping recorder") << reason;
+
+                // some seconds after the anomaly are also of interest
+                QTimer::singleShot(2500, this, [ = ]
+                {
+                    if (!myself) { return; }
+                    myself->writeRecorderDumpInBackground();
+                });
+            }, Qt::QueuedConnection);
+        }
+
+        CStatusMessageList CInterpolationLogger::convertRecorderDump(const QString &dumpFile)
+        {
+            QVector<CInterpolationRecord> records;
+            QStringList callsigns;
+            QString error;
+            if (!CInterpolationRecorder::readDump(dumpFile, records, callsigns, &error))
+            {
+                return CStatusMessage(static_cast<CInterpolationLogger *>(nullptr)).error(u"%1") << error;
+            }
+
+            QList<SituationLog> situationLogs;
+            QList<PartsLog> partsLogs;
+            QHash<int, CAircraftParts> lastParts; // parts used with the situations
+            for (const CInterpolationRecord &record : as_const(records))
+            {
+                const CCallsign callsign(record.callsignId >= 0 && record.callsignId < callsigns.size() ? callsigns[record.callsignId] : QString());
+                if (record.recordType == CInterpolationRecord::PartsRecord)
+                {
+                    PartsLog log;
+                    log.callsign = callsign;
+                    log.tsCurrent = record.tsCurrent;
+                    log.empty = record.testFlag(CInterpolationRecord::EmptyParts);
+                    log.noNetworkParts = record.noNetworkData;
+                    log.parts = log.empty ? CAircraftParts() : record.toParts();
+                    lastParts.insert(record.callsignId, log.parts);
+                    partsLogs.push_back(log);
+                    continue;
+                }
+
+                SituationLog log;
+                log.callsign = callsign;
+                log.interpolator = QChar::fromLatin1(record.interpolator);
+                log.tsCurrent = record.tsCurrent;
+                log.tsInterpolated = record.tsInterpolated;
+                log.groundFactor = record.groundFactor;
+                log.simTimeFraction = record.simTimeFraction;
+                log.deltaSampleTimesMs = record.deltaSampleTimesMs;
+                log.useParts = record.testFlag(CInterpolationRecord::UseParts);
+                log.vtolAircraft = record.testFlag(CInterpolationRecord::VtolAircraft);
+                log.interpolantRecalc = record.testFlag(CInterpolationRecord::InterpolantRecalculated);
+                log.noNetworkSituations = record.noNetworkData;
+                log.noInvalidSituations = record.noInvalidSituations;
+                log.altCorrection = CAircraftSituation::altitudeCorrectionToString(static_cast<CAircraftSituation::AltitudeCorrection>(record.altCorrection));
+                log.parts = lastParts.value(record.callsignId);
+                if (record.testFlag(CInterpolationRecord::JumpDetected)) { log.elevationInfo = QStringLiteral("anomaly: jump"); }
+                if (record.oldest.isValid()) { log.interpolationSituations.push_back(record.oldest.toSituation(callsign)); }
+                if (record.newest.isValid()) { log.interpolationSituations.push_back(record.newest.toSituation(callsign)); }
+                if (record.cgFt == record.cgFt) { log.cgAboveGround = CLength(record.cgFt, CLengthUnit::ft()); }
+                if (record.sceneryOffsetFt == record.sceneryOffsetFt) { log.sceneryOffset = CLength(record.sceneryOffsetFt, CLengthUnit::ft()); }
+
+                CAircraftSituation situation = record.current.toSituation(callsign);
+                situation.setPitch(CAngle(record.pitchDeg, CAngleUnit::deg()));
+                situation.setBank(CAngle(record.bankDeg, CAngleUnit::deg()));
+                situation.setHeading(CHeading(record.headingDeg, CHeading::True, CAngleUnit::deg()));
+                situation.setGroundSpeed(CSpeed(record.groundSpeedKts, CSpeedUnit::kts()));
+                if (!log.cgAboveGround.isNull()) { situation.setCG(log.cgAboveGround); }
+                log.situationCurrent = situation;
+                situationLogs.push_back(log);
+            }
+            return CInterpolationLogger::writeLogFiles(situationLogs, partsLogs);
+        }
+
         QStringList CInterpolationLogger::getLatestLogFiles()
         {
             QStringList files({ "", "" });
@@ -285,6 +386,11 @@ namespace BlackMisc
             return p;
         }
 
+        const QString &CInterpolationLogger::filePatternRecorderDump()
+        {
+            return CInterpolationRecorder::filePatternDump();
+        }
+
         const QStringList &CInterpolationLogger::filePatterns()
         {
             static const QStringList l({ filePatternInterpolationLog(), filePatternPartsLog() });
@@ -12,6 +12,7 @@
 #define BLACKMISC_SIMULATION_INTERPOLATIONLOGGER_H
 
 #include "interpolationrenderingsetup.h"
+#include "blackmisc/simulation/interpolationrecorder.h"
 #include "blackmisc/simulation/remoteaircraftprovider.h"
 #include "blackmisc/aviation/aircraftsituationlist.h"
 #include "blackmisc/aviation/aircraftpartslist.h"
@@ -113,6 +114,23 @@ namespace BlackMisc
             //! Clear log file
             void clearLog();
 
+            //! The binary flight recorder
+            CInterpolationRecorder &recorder() { return m_recorder; }
+
+            //! The binary flight recorder
+            const CInterpolationRecorder &recorder() const { return m_recorder; }
+
+            //! Write the recorder's binary dump in background
+            CWorker *writeRecorderDumpInBackground();
+
+            //! Dump the recorder some seconds after an anomaly, so the dump contains what happened afterwards
+            //! \threadsafe
+            void triggerRecorderDump(const QString &reason);
+
+            //! Convert a binary recorder dump into the text/HTML/KML log files
+            //! \remark offline, no logger instance needed
+            static CStatusMessageList convertRecorderDump(const QString &dumpFile);
+
             //! Latest log files: 0: Interpolation / 1: Parts
             static QStringList getLatestLogFiles();
 
@@ -186,6 +204,9 @@ namespace BlackMisc
             //! File pattern for parts log
             static const QString &filePatternPartsLog();
 
+            //! File pattern for the binary recorder dump
+            static const QString &filePatternRecorderDump();
+
             //! All log.file patterns
             static const QStringList &filePatterns();
 
@@ -225,6 +246,7 @@ namespace BlackMisc
             int m_maxSituations = 2500;              //!< max.number of situations
             QList<PartsLog> m_partsLogs;             //!< logs of parts
             QList<SituationLog> m_situationLogs;     //!< logs of interpolation
+            CInterpolationRecorder m_recorder;       //!< binary flight recorder
         };
     } // namespace
 } // namespace
@@ -0,0 +1,289 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/interpolationrecorder.h"
+#include "blackmisc/simulation/interpolator.h"
+#include "blackmisc/aviation/aircraftparts.h"
+#include "blackmisc/aviation/aircraftenginelist.h"
+#include "blackmisc/aviation/aircraftlights.h"
+#include "blackmisc/aviation/altitude.h"
+#include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/pq/units.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QReadLocker>
+#include <QThread>
+#include <QWriteLocker>
+#include <cstring>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Geo;
+using namespace BlackMisc::PhysicalQuantities;
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        namespace
+        {
+            //! Dump file header
+            constexpr char DumpMagic[8] = { 'S', 'W', 'I', 'F', 'T', 'I', 'R', 'D' };
+            constexpr quint32 DumpVersion = 1;
+
+            //! Capacity as power of 2
+            std::size_t roundUpPowerOf2(int capacity)
+            {
+                std::size_t size = 1;
+                while (size < static_cast<std::size_t>(qMax(1, capacity))) { size <<= 1; }
+                return size;
+            }
+        }
+
+        void CInterpolationRecordSituation::setSituation(const CAircraftSituation &situation)
+        {
+            timestampMs = situation.getMSecsSinceEpoch();
+            timeOffsetMs = situation.getTimeOffsetMs();
+            latitudeDeg = situation.latitude().value(CAngleUnit::deg());
+            longitudeDeg = situation.longitude().value(CAngleUnit::deg());
+            altitudeFt = situation.getAltitude().value(CLengthUnit::ft());
+            groundElevationFt = situation.hasGroundElevation() ? situation.getGroundElevation().value(CLengthUnit::ft()) : std::numeric_limits<double>::quiet_NaN();
+            onGround = static_cast<qint8>(situation.getOnGround());
+            onGroundDetails = static_cast<qint8>(situation.getOnGroundDetails());
+            elevationInfo = static_cast<qint8>(situation.getGroundElevationInfo());
+        }
+
+        CAircraftSituation CInterpolationRecordSituation::toSituation(const CCallsign &callsign) const
+        {
+            if (!this->isValid()) { return CAircraftSituation::null(); }
+            CAircraftSituation situation(callsign, CCoordinateGeodetic(latitudeDeg, longitudeDeg, altitudeFt));
+            situation.setMSecsSinceEpoch(timestampMs);
+            situation.setTimeOffsetMs(timeOffsetMs);
+            situation.setOnGround(static_cast<CAircraftSituation::IsOnGround>(onGround), static_cast<CAircraftSituation::OnGroundDetails>(onGroundDetails));
+            if (groundElevationFt == groundElevationFt) // NaN check
+            {
+                situation.setGroundElevation(CAltitude(groundElevationFt, CAltitude::MeanSeaLevel, CLengthUnit::ft()), static_cast<CAircraftSituation::GndElevationInfo>(elevationInfo));
+            }
+            return situation;
+        }
+
+        void CInterpolationRecord::setParts(const CAircraftParts &parts)
+        {
+            // same flags as the compact interpolation result
+            CCompactInterpolationResult compact;
+            compact.setParts(parts);
+            partsFlags = compact.parts;
+            flapsPercent = compact.flapsPercent;
+        }
+
+        CAircraftParts CInterpolationRecord::toParts() const
+        {
+            CCompactInterpolationResult compact;
+            compact.parts = partsFlags;
+            const CAircraftLights lights(
+                compact.testParts(CCompactInterpolationResult::StrobeLights), compact.testParts(CCompactInterpolationResult::LandingLights),
+                compact.testParts(CCompactInterpolationResult::TaxiLights), compact.testParts(CCompactInterpolationResult::BeaconLights),
+                compact.testParts(CCompactInterpolationResult::NavLights), compact.testParts(CCompactInterpolationResult::LogoLights),
+                compact.testParts(CCompactInterpolationResult::RecognitionLights), compact.testParts(CCompactInterpolationResult::CabinLights));
+            const CAircraftEngineList engines({ compact.testParts(CCompactInterpolationResult::AnyEngineOn) });
+            return CAircraftParts(lights, compact.testParts(CCompactInterpolationResult::GearDown), flapsPercent,
+                                  compact.testParts(CCompactInterpolationResult::SpoilersOut), engines,
+                                  compact.testParts(CCompactInterpolationResult::PartsOnGround), current.timestampMs);
+        }
+
+        CInterpolationRecordRing::CInterpolationRecordRing(int capacity) :
+            m_slots(roundUpPowerOf2(capacity)), m_mask(static_cast<quint64>(m_slots.size() - 1))
+        { }
+
+        void CInterpolationRecordRing::append(const CInterpolationRecord &record)
+        {
+            const quint64 index = m_head.fetch_add(1, std::memory_order_relaxed);
+            Slot &slot = m_slots[static_cast<std::size_t>(index & m_mask)];
+
+            // claim the slot, writers one lap apart can hit the same slot:
+            // wait for an older writer, drop the record if a newer one already took the slot
+            quint64 sequence = slot.sequence.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                if (sequence == Slot::Writing)
+                {
+                    QThread::yieldCurrentThread();
+                    sequence = slot.sequence.load(std::memory_order_relaxed);
+                    continue;
+                }
+                if (sequence > index + 1) { return; }
+                if (slot.sequence.compare_exchange_weak(sequence, Slot::Writing, std::memory_order_acquire, std::memory_order_relaxed)) { break; }
+            }
+
+            // readers skip the slot while it is written
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.record = record;
+            slot.sequence.store(index + 1, std::memory_order_release);
+        }
+
+        QVector<CInterpolationRecord> CInterpolationRecordRing::records() const
+        {
+            const quint64 head = m_head.load(std::memory_order_acquire);
+            const quint64 size = static_cast<quint64>(m_slots.size());
+            const quint64 first = head > size ? head - size : 0;
+
+            QVector<CInterpolationRecord> records;
+            records.reserve(static_cast<int>(head - first));
+            for (quint64 i = first; i < head; i++)
+            {
+                const Slot &slot = m_slots[static_cast<std::size_t>(i & m_mask)];
+                const quint64 before = slot.sequence.load(std::memory_order_acquire);
+                if (before != i + 1) { continue; } // being written or already overwritten
+                const CInterpolationRecord record = slot.record;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) != before) { continue; }
+                records.push_back(record);
+            }
+            return records;
+        }
+
+        void CInterpolationRecordRing::clear()
+        {
+            for (Slot &slot : m_slots) { slot.sequence.store(0, std::memory_order_relaxed); }
+            m_head.store(0, std::memory_order_release);
+        }
+
+        CInterpolationRecorder::CInterpolationRecorder(int globalCapacity, int perCallsignCapacity) :
+            m_global(globalCapacity), m_perCallsignCapacity(perCallsignCapacity)
+        { }
+
+        int CInterpolationRecorder::callsignId(const CCallsign &callsign)
+        {
+            {
+                QReadLocker l(&m_lock);
+                const auto it = m_callsignIds.constFind(callsign);
+                if (it != m_callsignIds.constEnd()) { return it.value(); }
+            }
+
+            QWriteLocker l(&m_lock);
+            const auto it = m_callsignIds.constFind(callsign);
+            if (it != m_callsignIds.constEnd()) { return it.value(); }
+            const int id = m_callsigns.size();
+            m_callsignIds.insert(callsign, id);
+            m_callsigns.push_back(callsign.asString());
+            m_rings.push_back(std::make_shared<CInterpolationRecordRing>(m_perCallsignCapacity));
+            return id;
+        }
+
+        CCallsign CInterpolationRecorder::callsign(int callsignId) const
+        {
+            QReadLocker l(&m_lock);
+            if (callsignId < 0 || callsignId >= m_callsigns.size()) { return {}; }
+            return CCallsign(m_callsigns[callsignId]);
+        }
+
+        QStringList CInterpolationRecorder::callsigns() const
+        {
+            QReadLocker l(&m_lock);
+            return m_callsigns;
+        }
+
+        std::shared_ptr<CInterpolationRecordRing> CInterpolationRecorder::callsignRing(const CCallsign &callsign)
+        {
+            const int id = this->callsignId(callsign);
+            QReadLocker l(&m_lock);
+            return m_rings[id];
+        }
+
+        bool CInterpolationRecorder::record(CInterpolationRecordRing *callsignRing, const CInterpolationRecord &record)
+        {
+            if (callsignRing) { callsignRing->append(record); }
+            m_global.append(record);
+            if (!record.isAnomaly()) { return false; }
+
+            // only one dump per cool down period
+            qint64 last = m_lastAnomalyDumpMs.load(std::memory_order_relaxed);
+            if (last >= 0 && record.tsCurrent - last < m_anomalyDumpCooldownMs.load(std::memory_order_relaxed)) { return false; }
+            return m_lastAnomalyDumpMs.compare_exchange_strong(last, record.tsCurrent);
+        }
+
+        QVector<CInterpolationRecord> CInterpolationRecorder::records(const CCallsign &callsign)
+        {
+            return this->callsignRing(callsign)->records();
+        }
+
+        bool CInterpolationRecorder::writeDump(const QString &fileName) const
+        {
+            // records first, so all their callsign ids are interned
+            const QVector<CInterpolationRecord> records = this->records();
+            return CInterpolationRecorder::writeDump(fileName, records, this->callsigns());
+        }
+
+        bool CInterpolationRecorder::writeDump(const QString &fileName, const QVector<CInterpolationRecord> &records, const QStringList &callsigns)
+        {
+            QFile file(fileName);
+            if (!file.open(QIODevice::WriteOnly)) { return false; }
+            QDataStream stream(&file);
+            stream.writeRawData(DumpMagic, sizeof(DumpMagic));
+            stream << DumpVersion << static_cast<quint32>(sizeof(CInterpolationRecord)) << QDateTime::currentMSecsSinceEpoch() << callsigns << static_cast<quint32>(records.size());
+
+            // records as they are, the dump is converted on the same platform
+            const int bytes = records.size() * static_cast<int>(sizeof(CInterpolationRecord));
+            if (stream.writeRawData(reinterpret_cast<const char *>(records.constData()), bytes) != bytes) { return false; }
+            return stream.status() == QDataStream::Ok;
+        }
+
+        bool CInterpolationRecorder::readDump(const QString &fileName, QVector<CInterpolationRecord> &records, QStringList &callsigns, QString *errorMessage)
+        {
+            const auto error = [errorMessage](const QString & message)
+            {
+                if (errorMessage) { *errorMessage = message; }
+                return false;
+            };
+
+            QFile file(fileName);
+            if (!file.open(QIODevice::ReadOnly)) { return error(QStringLiteral("Cannot open '%1'").arg(fileName)); }
+            QDataStream stream(&file);
+
+            char magic[sizeof(DumpMagic)];
+            if (stream.readRawData(magic, sizeof(magic)) != static_cast<int>(sizeof(magic)) || std::memcmp(magic, DumpMagic, sizeof(magic)) != 0)
+            {
+                return error(QStringLiteral("'%1' is no interpolation recorder dump").arg(fileName));
+            }
+
+            quint32 version = 0;
+            quint32 recordSize = 0;
+            qint64 created = -1;
+            quint32 count = 0;
+            stream >> version >> recordSize >> created >> callsigns >> count;
+            if (stream.status() != QDataStream::Ok) { return error(QStringLiteral("Corrupt header in '%1'").arg(fileName)); }
+            if (version != DumpVersion || recordSize != sizeof(CInterpolationRecord))
+            {
+                return error(QStringLiteral("Unsupported dump version %1 record size %2").arg(version).arg(recordSize));
+            }
+
+            // count is untrusted, the records have to be in the file
+            const qint64 remaining = file.size() - file.pos();
+            if (remaining < 0 || static_cast<qint64>(count) > remaining / static_cast<qint64>(sizeof(CInterpolationRecord)))
+            {
+                return error(QStringLiteral("Truncated dump '%1', %2 records announced").arg(fileName).arg(count));
+            }
+
+            records.resize(static_cast<int>(count));
+            const int bytes = records.size() * static_cast<int>(sizeof(CInterpolationRecord));
+            if (stream.readRawData(reinterpret_cast<char *>(records.data()), bytes) != bytes)
+            {
+                records.clear();
+                return error(QStringLiteral("Truncated dump '%1'").arg(fileName));
+            }
+            return true;
+        }
+
+        const QString &CInterpolationRecorder::filePatternDump()
+        {
+            static const QString p("*interpolation.swiftird");
+            return p;
+        }
+    } // namespace
+} // namespace
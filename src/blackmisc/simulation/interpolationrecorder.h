@@ -0,0 +1,276 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_INTERPOLATIONRECORDER_H
+#define BLACKMISC_SIMULATION_INTERPOLATIONRECORDER_H
+
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QtGlobal>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace BlackMisc
+{
+    namespace Aviation { class CAircraftParts; }
+    namespace Simulation
+    {
+        //! Situation as stored in an interpolation record
+        struct BLACKMISC_EXPORT CInterpolationRecordSituation
+        {
+            qint64 timestampMs = -1;  //!< ms since epoch
+            qint64 timeOffsetMs = 0;  //!< time offset
+            double latitudeDeg = 0.0; //!< latitude
+            double longitudeDeg = 0.0; //!< longitude
+            double altitudeFt = 0.0;  //!< altitude
+            double groundElevationFt = std::numeric_limits<double>::quiet_NaN(); //!< ground elevation, NaN if not available
+            qint8 onGround = Aviation::CAircraftSituation::OnGroundSituationUnknown; //!< Aviation::CAircraftSituation::IsOnGround
+            qint8 onGroundDetails = Aviation::CAircraftSituation::NotSetGroundDetails; //!< Aviation::CAircraftSituation::OnGroundDetails
+            qint8 elevationInfo = Aviation::CAircraftSituation::NoElevationInfo; //!< Aviation::CAircraftSituation::GndElevationInfo
+
+            //! Valid situation?
+            bool isValid() const { return timestampMs >= 0; }
+
+            //! Set from situation
+            void setSituation(const Aviation::CAircraftSituation &situation);
+
+            //! Back to a situation (for the log files)
+            Aviation::CAircraftSituation toSituation(const Aviation::CCallsign &callsign) const;
+        };
+
+        //! One interpolation step (situation or parts) as fixed size binary record
+        //! \remark trivially copyable, written as it is to the binary dump
+        struct BLACKMISC_EXPORT CInterpolationRecord
+        {
+            //! Record type
+            enum RecordType
+            {
+                SituationRecord,
+                PartsRecord
+            };
+
+            //! Flags
+            enum Flag
+            {
+                InterpolantRecalculated = 1 << 0, //!< interpolant recalculated
+                UseParts                = 1 << 1, //!< supporting aircraft parts
+                VtolAircraft            = 1 << 2, //!< VTOL aircraft
+                EmptyParts              = 1 << 3, //!< empty parts
+                JumpDetected            = 1 << 4, //!< anomaly: interpolated position jumped
+                AltitudeCorrected       = 1 << 5  //!< anomaly: altitude corrected (underflow or dragged to ground) above the threshold
+            };
+
+            //! Flags marking an anomaly
+            static constexpr int AnomalyFlags = JumpDetected | AltitudeCorrected;
+
+            qint64 tsCurrent = -1;             //!< current timestamp
+            qint64 tsInterpolated = -1;        //!< timestamp interpolated
+            double groundFactor = -1.0;        //!< current ground factor
+            double simTimeFraction = -1.0;     //!< time fraction, expected 0..1
+            double deltaSampleTimesMs = -1.0;  //!< delta time between samples (i.e. 2 situations)
+            double pitchDeg = 0.0;             //!< interpolated pitch
+            double bankDeg = 0.0;              //!< interpolated bank
+            double headingDeg = 0.0;           //!< interpolated heading
+            double groundSpeedKts = 0.0;       //!< interpolated ground speed
+            double cgFt = std::numeric_limits<double>::quiet_NaN();            //!< CG, NaN if not available
+            double sceneryOffsetFt = std::numeric_limits<double>::quiet_NaN(); //!< scenery offset, NaN if not available
+            CInterpolationRecordSituation current; //!< interpolated situation
+            CInterpolationRecordSituation oldest;  //!< oldest interpolation situation
+            CInterpolationRecordSituation newest;  //!< latest interpolation situation
+            qint32 callsignId = -1;            //!< see CInterpolationRecorder::callsignId
+            qint32 noNetworkData = 0;          //!< available network situations or parts
+            qint32 noInvalidSituations = 0;    //!< invalid situations
+            quint16 flags = 0;                 //!< Flag values
+            quint16 partsFlags = 0;            //!< CCompactInterpolationResult::PartsFlag values
+            quint8 recordType = SituationRecord; //!< RecordType
+            quint8 flapsPercent = 0;           //!< flaps 0..100
+            qint8 altCorrection = Aviation::CAircraftSituation::NoCorrection; //!< Aviation::CAircraftSituation::AltitudeCorrection
+            char interpolator = ' ';           //!< 's' spline, 'l' linear
+
+            //! Flag set?
+            bool testFlag(Flag flag) const { return (flags & flag) != 0; }
+
+            //! Set or clear flag
+            void setFlag(Flag flag, bool set) { flags = static_cast<quint16>(set ? (flags | flag) : (flags & ~flag)); }
+
+            //! Any anomaly?
+            bool isAnomaly() const { return (flags & AnomalyFlags) != 0; }
+
+            //! Set parts values
+            void setParts(const Aviation::CAircraftParts &parts);
+
+            //! Back to parts (for the log files)
+            //! \remark reduced parts, engines are restored as one engine on/off
+            Aviation::CAircraftParts toParts() const;
+        };
+
+        static_assert(std::is_trivially_copyable<CInterpolationRecord>::value, "Needs to be trivially copyable");
+
+        //! Fixed size ring buffer of interpolation records
+        //! \remark any number of writers, a writer claims its slot by its sequence number, so writers one lap
+        //!         apart never write the same slot concurrently (the older record is dropped if it comes last)
+        //! \remark readers are lock free and get a consistent copy of each record (sequence check)
+        class BLACKMISC_EXPORT CInterpolationRecordRing
+        {
+        public:
+            //! Ctor, capacity rounded up to a power of 2
+            explicit CInterpolationRecordRing(int capacity);
+
+            //! Capacity
+            int capacity() const { return static_cast<int>(m_slots.size()); }
+
+            //! Number of records ever written
+            qint64 written() const { return static_cast<qint64>(m_head.load(std::memory_order_relaxed)); }
+
+            //! Append record, overwrites the oldest record if full
+            //! \threadsafe
+            void append(const CInterpolationRecord &record);
+
+            //! Copy of the records, oldest first
+            //! \remark records being written while copying are skipped
+            //! \threadsafe
+            QVector<CInterpolationRecord> records() const;
+
+            //! Remove all records
+            //! \remark not to be called while writing
+            void clear();
+
+        private:
+            //! One record with its sequence number
+            struct Slot
+            {
+                static constexpr quint64 Writing = std::numeric_limits<quint64>::max(); //!< slot claimed by a writer
+
+                std::atomic<quint64> sequence { 0 }; //!< 0 empty, Writing being written, otherwise index + 1
+                CInterpolationRecord record;         //!< the record
+            };
+
+            std::vector<Slot> m_slots;
+            quint64 m_mask = 0;
+            std::atomic<quint64> m_head { 0 };
+        };
+
+        //! Flight recorder for the interpolators
+        //! \remark fixed memory binary ring buffers per callsign and one global ring buffer (all callsigns)
+        //! \remark records only cost a copy of plain values, the (sampled) recording can be left enabled in production
+        //! \remark on demand or on anomalies the global ring is dumped to a binary file, converted offline to the
+        //!         CInterpolationLogger text/HTML format
+        class BLACKMISC_EXPORT CInterpolationRecorder
+        {
+        public:
+            //! Ctor
+            CInterpolationRecorder(int globalCapacity = 8192, int perCallsignCapacity = 256);
+
+            //! Enabled?
+            bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+            //! Enable/disable
+            void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+
+            //! Record only every n-th interpolation step of an aircraft, anomalies are always recorded
+            //! \remark jumps are only detected on the sampled steps, altitude corrections on every step
+            void setSampleInterval(int interval) { m_sampleInterval.store(qMax(1, interval), std::memory_order_relaxed); }
+
+            //! Sample interval
+            int getSampleInterval() const { return m_sampleInterval.load(std::memory_order_relaxed); }
+
+            //! Record the given step?
+            bool isSampled(int stepCounter) const { return this->isEnabled() && (stepCounter % this->getSampleInterval()) == 0; }
+
+            //! Jump threshold, distance between two interpolated positions
+            void setJumpThresholdM(double meters) { m_jumpThresholdM.store(meters, std::memory_order_relaxed); }
+
+            //! Jump threshold
+            double getJumpThresholdM() const { return m_jumpThresholdM.load(std::memory_order_relaxed); }
+
+            //! Altitude correction threshold, smaller corrections are no anomaly
+            void setAltitudeCorrectionThresholdFt(double feet) { m_altitudeCorrectionThresholdFt.store(feet, std::memory_order_relaxed); }
+
+            //! Altitude correction threshold
+            double getAltitudeCorrectionThresholdFt() const { return m_altitudeCorrectionThresholdFt.load(std::memory_order_relaxed); }
+
+            //! Min. time between 2 anomaly triggered dumps
+            void setAnomalyDumpCooldownMs(qint64 ms) { m_anomalyDumpCooldownMs.store(ms, std::memory_order_relaxed); }
+
+            //! Interned callsign id
+            //! \threadsafe
+            int callsignId(const Aviation::CCallsign &callsign);
+
+            //! Callsign for interned id
+            //! \threadsafe
+            Aviation::CCallsign callsign(int callsignId) const;
+
+            //! All interned callsigns, index is the id
+            //! \threadsafe
+            QStringList callsigns() const;
+
+            //! Ring buffer of the callsign
+            //! \remark kept by the interpolator, appending needs no lookup
+            //! \threadsafe
+            std::shared_ptr<CInterpolationRecordRing> callsignRing(const Aviation::CCallsign &callsign);
+
+            //! Global ring buffer
+            const CInterpolationRecordRing &globalRing() const { return m_global; }
+
+            //! Record into the callsign's ring buffer (optional) and the global ring buffer
+            //! \return true if an anomaly dump should be triggered (anomaly and cool down passed)
+            //! \threadsafe
+            bool record(CInterpolationRecordRing *callsignRing, const CInterpolationRecord &record);
+
+            //! Records of all callsigns, oldest first
+            //! \threadsafe
+            QVector<CInterpolationRecord> records() const { return m_global.records(); }
+
+            //! Records of one callsign, oldest first
+            //! \threadsafe
+            QVector<CInterpolationRecord> records(const Aviation::CCallsign &callsign);
+
+            //! Write the global ring buffer to a binary dump file
+            //! \threadsafe
+            bool writeDump(const QString &fileName) const;
+
+            //! Write records to a binary dump file
+            static bool writeDump(const QString &fileName, const QVector<CInterpolationRecord> &records, const QStringList &callsigns);
+
+            //! Read a binary dump file
+            static bool readDump(const QString &fileName, QVector<CInterpolationRecord> &records, QStringList &callsigns, QString *errorMessage = nullptr);
+
+            //! File pattern for dump files
+            static const QString &filePatternDump();
+
+        private:
+            CInterpolationRecordRing m_global;
+            const int m_perCallsignCapacity;
+            std::atomic_bool m_enabled { false };
+            std::atomic_int m_sampleInterval { 1 };
+            std::atomic<qint64> m_lastAnomalyDumpMs { -1 };
+            std::atomic<double> m_jumpThresholdM { 250.0 };
+            std::atomic<double> m_altitudeCorrectionThresholdFt { 50.0 };
+            std::atomic<qint64> m_anomalyDumpCooldownMs { 30 * 1000 };
+
+            mutable QReadWriteLock m_lock; //!< callsign ids and rings
+            QHash<Aviation::CCallsign, int> m_callsignIds;
+            QStringList m_callsigns;
+            QVector<std::shared_ptr<CInterpolationRecordRing>> m_rings; //!< index is callsign id
+        };
+    } // namespace
+} // namespace
+
+#endif // guard
@@ -93,7 +93,7 @@ namespace BlackMisc
         CAircraftSituationList CInterpolator<Derived>::remoteAircraftSituationsAndChange(const CInterpolationAndRenderingSetupPerCallsign &setup)
         {
             // const bool vtol = setup.isForcingFullInterpolation() || m_model.isVtol();
-            CAircraftSituationList validSituations = this->remoteAircraftSituations(m_callsign);
+            CAircraftSituationList validSituations = m_currentSnapshot->remoteAircraftSituations(m_callsign);
 
             // get the changes, we need the second value as we want to look in the past
             // the first value is already based on the latest situation
@@ -241,43 +241,139 @@ namespace BlackMisc
             return result;
         }
 
+        template<typename Derived>
+        CCompactInterpolationResult CInterpolator<Derived>::getInterpolationCompact(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber, const CRemoteAircraftSnapshotPtr &snapshot)
+        {
+            this->beginCompactStep(currentTimeSinceEpoc, setup, aircraftNumber, snapshot, nullptr);
+            return this->finishCompactStep(nullptr);
+        }
+
+        template<typename Derived>
+        void CInterpolator<Derived>::prepareInterpolationCompact(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber, const CRemoteAircraftSnapshotPtr &snapshot, CInterpolationLanes &lanes)
+        {
+            this->beginCompactStep(currentTimeSinceEpoc, setup, aircraftNumber, snapshot, &lanes);
+        }
+
+        template<typename Derived>
+        CCompactInterpolationResult CInterpolator<Derived>::finishInterpolationCompact(const CInterpolationLanes &lanes)
+        {
+            return this->finishCompactStep(&lanes);
+        }
+
+        template<typename Derived>
+        void CInterpolator<Derived>::beginCompactStep(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber, const CRemoteAircraftSnapshotPtr &snapshot, CInterpolationLanes *lanes)
+        {
+            if (aircraftNumber < 0) { aircraftNumber = 0; }
+            const bool init = this->initIniterpolationStepData(currentTimeSinceEpoc, setup, aircraftNumber, snapshot);
+            m_step.initialized = m_unitTest || init; // failure in real scenarios, unit tests move on
+            m_step.timestampMs = currentTimeSinceEpoc;
+            m_step.aircraftNumber = aircraftNumber;
+            if (m_step.initialized) { this->beginInterpolatedSituation(lanes); }
+        }
+
+        template<typename Derived>
+        CCompactInterpolationResult CInterpolator<Derived>::finishCompactStep(const CInterpolationLanes *lanes)
+        {
+            CCompactInterpolationResult result;
+            result.timestampMs = m_step.timestampMs;
+            bool validParts = false;
+            if (m_step.initialized)
+            {
+                // both are also kept as m_lastSituation/m_lastParts
+                const CAircraftSituation interpolatedSituation = this->finishInterpolatedSituation(lanes);
+                const CAircraftParts interpolatedParts = this->getInterpolatedOrGuessedParts(m_step.aircraftNumber);
+                result.setSituation(interpolatedSituation);
+                validParts = !interpolatedParts.isNull() && (m_currentPartsStatus.isSupportingParts() || interpolatedParts.getPartsDetails() == CAircraftParts::GuessedParts);
+                if (validParts) { result.setParts(interpolatedParts); }
+            }
+
+            result.setStatus(m_currentInterpolationStatus, m_currentPartsStatus, validParts);
+            return result;
+        }
+
         template <typename Derived>
         CAircraftSituation CInterpolator<Derived>::getInterpolatedSituation()
+        {
+            this->beginInterpolatedSituation(nullptr);
+            return this->finishInterpolatedSituation(nullptr);
+        }
+
+        template <typename Derived>
+        void CInterpolator<Derived>::beginInterpolatedSituation(CInterpolationLanes *lanes)
         {
             Q_ASSERT_X(!m_currentInterpolationStatus.isInterpolated(), Q_FUNC_INFO, "Expect reset status");
-            if (m_currentSituations.isEmpty())
+            SituationStep &step = m_step;
+            step.log = SituationLog();
+            step.record = CInterpolationRecord();
+            step.lane = -1;
+            step.noSituations = m_currentSituations.isEmpty();
+            step.validInterpolant = false;
+            step.interpolateGndFlag = false;
+            step.recording = false;
+            step.sampled = false;
+            if (step.noSituations)
             {
                 m_lastSituation = CAircraftSituation::null();
-                return CAircraftSituation::null();
+                return;
             }
 
             // interpolant as function of derived class
             // CInterpolatorLinear::Interpolant or CInterpolatorSpline::Interpolant
-            SituationLog log;
-            const auto interpolant = derived()->getInterpolant(log);
-            const bool isValidInterpolant = interpolant.isValid();
+            const auto &interpolant = derived()->getInterpolant(step.log);
+            step.validInterpolant = interpolant.isValid();
+            step.situation = m_lastSituation;
+            step.recording = this->doRecording();
+            step.sampled = step.recording && m_logger->recorder().isSampled(m_interpolatedSituationsCounter);
+            if (!step.validInterpolant) { return; }
+
+            const CInterpolatorPbh pbh = interpolant.pbh();
+            if (step.recording)
+            {
+                step.record.oldest.setSituation(pbh.getOldSituation());
+                step.record.newest.setSituation(pbh.getNewSituation());
+            }
 
-            CAircraftSituation currentSituation = m_lastSituation;
+            // init interpolated situation
+            step.situation = this->initInterpolatedSituation(pbh.getOldSituation(), pbh.getNewSituation());
+
+            // Pitch bank heading first, so follow up steps could use those values
+            step.situation.setHeading(pbh.getHeading());
+            step.situation.setPitch(pbh.getPitch());
+            step.situation.setBank(pbh.getBank());
+            step.situation.setGroundSpeed(pbh.getGroundSpeed());
+            step.interpolateGndFlag = pbh.getNewSituation().hasGroundDetailsForGndInterpolation() && pbh.getOldSituation().hasGroundDetailsForGndInterpolation();
+
+            // position and altitude of many aircraft are interpolated at once
+            if (lanes) { step.lane = interpolant.addLanes(*lanes); }
+        }
+
+        template <typename Derived>
+        CAircraftSituation CInterpolator<Derived>::finishInterpolatedSituation(const CInterpolationLanes *lanes)
+        {
+            SituationStep &step = m_step;
+            if (step.noSituations) { return CAircraftSituation::null(); }
+
+            const auto &interpolant = derived()->getCurrentInterpolant();
+            const bool isValidInterpolant = step.validInterpolant;
+            const bool interpolateGndFlag = step.interpolateGndFlag;
+            const bool recording = step.recording;
+            SituationLog &log = step.log;
+            CInterpolationRecord &record = step.record;
+
+            CAircraftSituation currentSituation = step.situation;
             CAircraftSituation::AltitudeCorrection altCorrection = CAircraftSituation::NoCorrection;
+            double altCorrectionFt = 0.0;
 
             bool isValidInterpolation = false;
             do
             {
                 if (!isValidInterpolant) { break; }
-                const CInterpolatorPbh pbh = interpolant.pbh();
-
-                // init interpolated situation
-                currentSituation = this->initInterpolatedSituation(pbh.getOldSituation(), pbh.getNewSituation());
-
-                // Pitch bank heading first, so follow up steps could use those values
-                currentSituation.setHeading(pbh.getHeading());
-                currentSituation.setPitch(pbh.getPitch());
-                currentSituation.setBank(pbh.getBank());
-                currentSituation.setGroundSpeed(pbh.getGroundSpeed());
+                const CInterpolatorPbh &pbh = interpolant.pbh();
 
                 // use derived interpolant function
-                const bool interpolateGndFlag = pbh.getNewSituation().hasGroundDetailsForGndInterpolation() && pbh.getOldSituation().hasGroundDetailsForGndInterpolation();
-                currentSituation = interpolant.interpolatePositionAndAltitude(currentSituation, interpolateGndFlag);
+                currentSituation = (lanes && step.lane >= 0) ?
+                                   interpolant.interpolatePositionAndAltitude(currentSituation, interpolateGndFlag, *lanes, step.lane) :
+                                   interpolant.interpolatePositionAndAltitude(currentSituation, interpolateGndFlag);
                 if (currentSituation.isNull()) { break; }
 
                 // if we get here and the vector is invalid it means we haven't handled it correctly in one of the interpolators
@@ -314,7 +410,12 @@ namespace BlackMisc
                 if (!interpolateGndFlag && currentSituation.getOnGroundDetails() != CAircraftSituation::OnGroundByGuessing)
                 {
                     // just in case
+                    const double altitudeFt = recording ? currentSituation.getAltitude().value(CLengthUnit::ft()) : 0.0;
                     altCorrection = currentSituation.correctAltitude(true); // we have CG set
+                    if (recording && CAircraftSituation::isCorrectedAltitude(altCorrection))
+                    {
+                        altCorrectionFt = qAbs(currentSituation.getAltitude().value(CLengthUnit::ft()) - altitudeFt);
+                    }
                 }
 
                 // correct pitch on ground
@@ -375,6 +476,11 @@ namespace BlackMisc
             if (valid)
             {
                 Q_ASSERT_X(currentSituation.hasMSLGeodeticHeight(), Q_FUNC_INFO, "No MSL altitude");
+                if (step.sampled && !m_lastSituation.isNull())
+                {
+                    const double jumpM = m_lastSituation.calculateGreatCircleDistance(currentSituation).value(CLengthUnit::m());
+                    record.setFlag(CInterpolationRecord::JumpDetected, jumpM > m_logger->recorder().getJumpThresholdM());
+                }
                 m_lastSituation = currentSituation;
                 m_currentInterpolationStatus.setInterpolatedAndCheckSituation(valid, currentSituation);
             }
@@ -401,12 +507,15 @@ namespace BlackMisc
                 log.sceneryOffset = m_currentSceneryOffset;
                 log.noInvalidSituations = m_invalidSituations;
                 log.noNetworkSituations = m_currentSituations.sizeInt();
-                log.useParts = this->isRemoteAircraftSupportingParts(m_callsign);
+                log.useParts = m_currentSnapshot->isSupportingParts(m_callsign);
                 m_logger->logInterpolation(log);
 
                 // if (log.interpolantRecalc) { CLogMessage(this).debug(u"Recalc %1") << log.callsign.asString(); }
             }
 
+            // flight recorder
+            if (recording) { this->recordSituation(record, log, currentSituation, altCorrection, altCorrectionFt, step.sampled); }
+
             // bye
             return currentSituation;
         }
@@ -417,13 +526,14 @@ namespace BlackMisc
             // (!) this code is used by linear and spline interpolator
 
             // Parts are supposed to be in correct order, latest first
-            const CAircraftPartsList validParts = this->remoteAircraftParts(m_callsign);
+            const CAircraftPartsList validParts = m_currentSnapshot->remoteAircraftParts(m_callsign);
 
             // log for empty parts aircraft parts
             if (validParts.isEmpty())
             {
                 static const CAircraftParts emptyParts;
                 this->logParts(emptyParts, validParts.size(), true);
+                this->recordParts(emptyParts, validParts.size(), true);
                 return emptyParts;
             }
 
@@ -443,6 +553,7 @@ namespace BlackMisc
             while (false);
 
             this->logParts(currentParts, validParts.size(), false);
+            this->recordParts(currentParts, validParts.size(), false);
             return currentParts;
         }
 
@@ -480,6 +591,7 @@ namespace BlackMisc
                 {
                     parts = guessParts(m_lastSituation, m_pastSituationsChange, m_model);
                     this->logParts(parts, 0, false);
+                    this->recordParts(parts, 0, false);
                 }
                 else
                 {
@@ -520,6 +632,12 @@ namespace BlackMisc
             return this->hasAttachedLogger() &&  m_currentSetup.logInterpolation();
         }
 
+        template<typename Derived>
+        bool CInterpolator<Derived>::doRecording() const
+        {
+            return this->hasAttachedLogger() && m_logger->recorder().isEnabled();
+        }
+
         template<typename Derived>
         CAircraftParts CInterpolator<Derived>::guessParts(const CAircraftSituation &situation, const CAircraftSituationChange &change, const CAircraftModel &model)
         {
@@ -663,6 +781,67 @@ namespace BlackMisc
             m_logger->logParts(logInfo);
         }
 
+        template<typename Derived>
+        void CInterpolator<Derived>::recordSituation(CInterpolationRecord &record, const SituationLog &log, const CAircraftSituation &situation, CAircraftSituation::AltitudeCorrection altCorrection, double altCorrectionFt, bool sampled)
+        {
+            record.setFlag(CInterpolationRecord::AltitudeCorrected, altCorrectionFt > m_logger->recorder().getAltitudeCorrectionThresholdFt());
+            if (!record.isAnomaly() && !sampled) { return; }
+
+            record.recordType = CInterpolationRecord::SituationRecord;
+            record.interpolator = log.interpolator.toLatin1();
+            record.tsCurrent = m_currentTimeMsSinceEpoch;
+            record.tsInterpolated = log.tsInterpolated;
+            record.simTimeFraction = log.simTimeFraction;
+            record.deltaSampleTimesMs = log.deltaSampleTimesMs;
+            record.groundFactor = situation.getOnGroundFactor();
+            record.pitchDeg = situation.getPitch().value(CAngleUnit::deg());
+            record.bankDeg = situation.getBank().value(CAngleUnit::deg());
+            record.headingDeg = situation.getHeading().value(CAngleUnit::deg());
+            record.groundSpeedKts = situation.getGroundSpeed().value(CSpeedUnit::kts());
+            if (!situation.getCG().isNull()) { record.cgFt = situation.getCG().value(CLengthUnit::ft()); }
+            if (!m_currentSceneryOffset.isNull()) { record.sceneryOffsetFt = m_currentSceneryOffset.value(CLengthUnit::ft()); }
+            record.current.setSituation(situation);
+            record.noNetworkData = m_currentSituations.sizeInt();
+            record.noInvalidSituations = m_invalidSituations;
+            record.altCorrection = static_cast<qint8>(altCorrection);
+            record.setFlag(CInterpolationRecord::InterpolantRecalculated, log.interpolantRecalc);
+            record.setFlag(CInterpolationRecord::UseParts, m_currentSnapshot->isSupportingParts(m_callsign));
+            record.setFlag(CInterpolationRecord::VtolAircraft, m_model.isVtol());
+            this->appendRecord(record);
+        }
+
+        template<typename Derived>
+        void CInterpolator<Derived>::recordParts(const CAircraftParts &parts, int partsNo, bool empty)
+        {
+            if (!this->doRecording()) { return; }
+            if (!m_logger->recorder().isSampled(m_interpolatedSituationsCounter)) { return; }
+
+            CInterpolationRecord record;
+            record.recordType = CInterpolationRecord::PartsRecord;
+            record.tsCurrent = m_currentTimeMsSinceEpoch;
+            record.noNetworkData = partsNo;
+            record.setFlag(CInterpolationRecord::EmptyParts, empty);
+            record.setParts(parts);
+            this->appendRecord(record);
+        }
+
+        template<typename Derived>
+        void CInterpolator<Derived>::appendRecord(CInterpolationRecord &record)
+        {
+            CInterpolationRecorder &recorder = m_logger->recorder();
+            if (!m_recorderRing)
+            {
+                // once per interpolator, afterwards no lookup
+                m_recorderCallsignId = recorder.callsignId(m_callsign);
+                m_recorderRing = recorder.callsignRing(m_callsign);
+            }
+            record.callsignId = m_recorderCallsignId;
+            if (recorder.record(m_recorderRing.get(), record))
+            {
+                m_logger->triggerRecorderDump(QStringLiteral("%1 at %2").arg(m_callsign.asString(), CInterpolationLogger::msSinceEpochToTime(record.tsCurrent)));
+            }
+        }
+
         template<typename Derived>
         QString CInterpolator<Derived>::getInterpolatorInfo() const
         {
@@ -693,6 +872,8 @@ namespace BlackMisc
             m_currentTimeMsSinceEpoch = -1;
             m_situationsLastModified = -1;
             m_situationsLastModifiedUsed = -1;
+            m_situationHistoryId = -1;
+            m_situationHistoryRevision = -1;
             m_currentInterpolationStatus.reset();
             m_currentPartsStatus.reset();
             m_interpolatedSituationsCounter = 0;
@@ -702,13 +883,23 @@ namespace BlackMisc
         }
 
         template<typename Derived>
-        bool CInterpolator<Derived>::initIniterpolationStepData(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber)
+        bool CInterpolator<Derived>::initIniterpolationStepData(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber, const CRemoteAircraftSnapshotPtr &snapshot)
         {
             Q_ASSERT_X(!m_callsign.isEmpty(), Q_FUNC_INFO, "Missing callsign");
 
-            const qint64 lastModifed  = this->situationsLastModified(m_callsign);
+            // one lock free snapshot for the whole step, the provider's locks are not touched at frame rate
+            m_currentSnapshot = snapshot ? snapshot : this->getRemoteAircraftSnapshot();
             const bool slowUpdateStep = (((m_interpolatedSituationsCounter + aircraftNumber) % 25) == 0); // flag when parts are updated, which need not to be updated every time
-            const bool changedSituations = lastModifed > m_situationsLastModified;
+
+            // changes detected by the revision of the compact history, the interned id avoids hashing the callsign every step
+            const CCompactSituationHistory *history = m_currentSnapshot->situationHistory(m_situationHistoryId);
+            if (!history)
+            {
+                m_situationHistoryId = m_currentSnapshot->situationHistoryId(m_callsign);
+                history = m_currentSnapshot->situationHistory(m_situationHistoryId);
+            }
+            const qint64 revision = history ? history->revision : -1;
+            const bool changedSituations = revision != m_situationHistoryRevision;
 
             m_currentTimeMsSinceEpoch = currentTimeSinceEpoc;
             m_currentInterpolationStatus.reset();
@@ -717,7 +908,8 @@ namespace BlackMisc
 
             if (changedSituations)
             {
-                m_situationsLastModified = lastModifed;
+                m_situationHistoryRevision = revision;
+                m_situationsLastModified = m_currentSnapshot->situationsLastModified(m_callsign);
                 m_currentSituations = this->remoteAircraftSituationsAndChange(setup); // only update when needed
             }
 
@@ -731,7 +923,7 @@ namespace BlackMisc
             m_currentInterpolationStatus.setSituationsCount(situationsSize);
             if (m_currentSituations.isEmpty())
             {
-                const bool inRange = this->isAircraftInRange(m_callsign);
+                const bool inRange = m_currentSnapshot->isAircraftInRange(m_callsign);
                 m_lastSituation = CAircraftSituation::null(); // no interpolation possible for that step
                 static const QString extraNoSituations("No situations, but remote aircraft '%1'");
                 static const QString extraNoRemoteAircraft("Unknown remote aircraft: '%1'");
@@ -830,6 +1022,49 @@ namespace BlackMisc
             m_partsStatus.reset();
         }
 
+        void CCompactInterpolationResult::setSituation(const CAircraftSituation &situation)
+        {
+            if (situation.isNull()) { return; }
+            latitudeDeg    = situation.latitude().value(CAngleUnit::deg());
+            longitudeDeg   = situation.longitude().value(CAngleUnit::deg());
+            altitudeFt     = situation.getAltitude().value(CLengthUnit::ft());
+            pitchDeg       = situation.getPitch().value(CAngleUnit::deg());
+            bankDeg        = situation.getBank().value(CAngleUnit::deg());
+            headingDeg     = situation.getHeading().value(CAngleUnit::deg());
+            groundSpeedKts = situation.getGroundSpeed().value(CSpeedUnit::kts());
+            onGroundFactor = situation.getOnGroundFactor();
+            this->setStatusFlag(OnGround, situation.getOnGround() == CAircraftSituation::OnGround);
+        }
+
+        void CCompactInterpolationResult::setParts(const CAircraftParts &parts)
+        {
+            const CAircraftLights lights = parts.getLights();
+            flapsPercent = static_cast<quint8>(qBound(0, parts.getFlapsPercent(), 100));
+            this->setPartsFlag(GearDown, parts.isFixedGearDown());
+            this->setPartsFlag(SpoilersOut, parts.isSpoilersOut());
+            this->setPartsFlag(PartsOnGround, parts.isOnGround());
+            this->setPartsFlag(AnyEngineOn, parts.isAnyEngineOn());
+            this->setPartsFlag(LandingLights, lights.isLandingOn());
+            this->setPartsFlag(TaxiLights, lights.isTaxiOn());
+            this->setPartsFlag(BeaconLights, lights.isBeaconOn());
+            this->setPartsFlag(StrobeLights, lights.isStrobeOn());
+            this->setPartsFlag(NavLights, lights.isNavOn());
+            this->setPartsFlag(LogoLights, lights.isLogoOn());
+            this->setPartsFlag(RecognitionLights, lights.isRecognitionOn());
+            this->setPartsFlag(CabinLights, lights.isCabinOn());
+        }
+
+        void CCompactInterpolationResult::setStatus(const CInterpolationStatus &interpolation, const CPartsStatus &partsStatus, bool validParts)
+        {
+            this->setStatusFlag(Interpolated, interpolation.isInterpolated());
+            this->setStatusFlag(ValidSituation, interpolation.hasValidSituation());
+            this->setStatusFlag(SameSituation, interpolation.isSameSituation());
+            this->setStatusFlag(SupportingParts, partsStatus.isSupportingParts());
+            this->setStatusFlag(ReusedParts, partsStatus.isReusedParts());
+            this->setStatusFlag(SameParts, partsStatus.isSameParts());
+            this->setStatusFlag(ValidParts, validParts);
+        }
+
         void CInterpolationStatus::setExtraInfo(const QString &info)
         {
             m_extraInfo = info;
@@ -852,13 +1087,23 @@ namespace BlackMisc
             return m_isInterpolated && m_isValidSituation;
         }
 
+        double CInterpolationStatus::getInterpolantCacheHitRate() const
+        {
+            const qint64 total = m_interpolantCacheHits + m_interpolantCacheMisses;
+            if (total < 1) { return -1.0; }
+            return static_cast<double>(m_interpolantCacheHits) / total;
+        }
+
         void CInterpolationStatus::reset()
         {
             m_extraInfo.clear();
             m_isValidSituation = false;
             m_isInterpolated   = false;
             m_isSameSituation  = false;
+            m_interpolantCacheHit = false;
             m_situations = -1;
+            m_interpolantCacheHits = 0;
+            m_interpolantCacheMisses = 0;
         }
 
         QString CInterpolationStatus::toQString() const
@@ -867,6 +1112,8 @@ namespace BlackMisc
                    QStringLiteral(" | situations: ") % QString::number(m_situations) %
                    QStringLiteral(" | situation valid: ") % boolToYesNo(m_isValidSituation) %
                    QStringLiteral(" | same: ") % boolToYesNo(m_isSameSituation) %
+                   QStringLiteral(" | cache hit: ") % boolToYesNo(m_interpolantCacheHit) %
+                   QStringLiteral(" hits/misses: ") % QString::number(m_interpolantCacheHits) % QStringLiteral("/") % QString::number(m_interpolantCacheMisses) %
                    (
                        m_extraInfo.isEmpty() ? QString() : QStringLiteral(" info: ") % m_extraInfo
                    );
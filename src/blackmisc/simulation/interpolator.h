@@ -12,6 +12,8 @@
 #define BLACKMISC_SIMULATION_INTERPOLATOR_H
 
 #include "interpolationrenderingsetup.h"
+#include "interpolationkernels.h"
+#include "interpolationlogger.h"
 #include "blackmisc/simulation/remoteaircraftprovider.h"
 #include "blackmisc/simulation/interpolationsetupprovider.h"
 #include "blackmisc/simulation/simulationenvironmentprovider.h"
@@ -27,6 +29,8 @@
 #include <QString>
 #include <QtGlobal>
 #include <QTimer>
+#include <memory>
+#include <type_traits>
 
 namespace BlackMisc
 {
@@ -38,6 +42,7 @@ namespace BlackMisc
     namespace Simulation
     {
         class CInterpolationLogger;
+        class CInterpolationRecordRing;
         class CInterpolatorLinear;
         class CInterpolatorSpline;
 
@@ -75,6 +80,24 @@ namespace BlackMisc
             //! Is that a valid position?
             void checkIfValidSituation(const Aviation::CAircraftSituation &situation);
 
+            //! Interpolant (i.e. spline coefficients) re-used in this step?
+            bool isInterpolantCacheHit() const { return m_interpolantCacheHit; }
+
+            //! Interpolant re-used in this step?
+            void setInterpolantCacheHit(bool hit) { m_interpolantCacheHit = hit; }
+
+            //! Set the interpolator's accumulated interpolant cache counters
+            void setInterpolantCacheCounters(qint64 hits, qint64 misses) { m_interpolantCacheHits = hits; m_interpolantCacheMisses = misses; }
+
+            //! Accumulated interpolant cache hits
+            qint64 getInterpolantCacheHits() const { return m_interpolantCacheHits; }
+
+            //! Accumulated interpolant cache misses, i.e. recalculated interpolants
+            qint64 getInterpolantCacheMisses() const { return m_interpolantCacheMisses; }
+
+            //! Interpolant cache hit rate 0..1, -1 if not available
+            double getInterpolantCacheHitRate() const;
+
             //! Reset to default values
             void reset();
 
@@ -85,7 +108,10 @@ namespace BlackMisc
             bool m_isInterpolated = false;   //!< position is interpolated (means enough values, etc.)
             bool m_isValidSituation = false; //!< is valid situation
             bool m_isSameSituation = false;  //!< interpolation between 2 same situations
+            bool m_interpolantCacheHit = false; //!< interpolant re-used
             int  m_situations = -1;          //!< number of situations used for interpolation
+            qint64 m_interpolantCacheHits = 0;   //!< accumulated hits of the interpolator
+            qint64 m_interpolantCacheMisses = 0; //!< accumulated misses of the interpolator
             QString m_extraInfo;             //!< optional details
         };
 
@@ -183,6 +209,101 @@ namespace BlackMisc
             CPartsStatus                 m_partsStatus;           //!< parts status
         };
 
+        //! Compact, trivially copyable interpolation result for the simulator's per frame update
+        //! \remark no situation/parts objects and no strings, the values in the units the simulators need
+        //! \remark the full situation, parts and status are available from the interpolator if needed (GUI, logging, last sent)
+        //! \sa CInterpolationResult
+        struct BLACKMISC_EXPORT CCompactInterpolationResult
+        {
+            //! Status flags
+            enum StatusFlag
+            {
+                Interpolated    = 1 << 0, //!< CInterpolationStatus::isInterpolated
+                ValidSituation  = 1 << 1, //!< CInterpolationStatus::hasValidSituation
+                SameSituation   = 1 << 2, //!< CInterpolationStatus::isSameSituation
+                OnGround        = 1 << 3, //!< situation is on ground
+                SupportingParts = 1 << 4, //!< CPartsStatus::isSupportingParts
+                ReusedParts     = 1 << 5, //!< CPartsStatus::isReusedParts
+                SameParts       = 1 << 6, //!< CPartsStatus::isSameParts
+                ValidParts      = 1 << 7  //!< parts supported or guessed, values can be sent to simulator
+            };
+
+            //! Parts flags
+            enum PartsFlag
+            {
+                GearDown          = 1 << 0,  //!< Aviation::CAircraftParts::isFixedGearDown
+                SpoilersOut       = 1 << 1,  //!< spoilers out
+                PartsOnGround     = 1 << 2,  //!< parts on ground flag
+                AnyEngineOn       = 1 << 3,  //!< any engine on
+                LandingLights     = 1 << 4,  //!< landing lights
+                TaxiLights        = 1 << 5,  //!< taxi lights
+                BeaconLights      = 1 << 6,  //!< beacon lights
+                StrobeLights      = 1 << 7,  //!< strobe lights
+                NavLights         = 1 << 8,  //!< nav lights
+                LogoLights        = 1 << 9,  //!< logo lights
+                RecognitionLights = 1 << 10, //!< recognition lights
+                CabinLights       = 1 << 11  //!< cabin lights
+            };
+
+            double latitudeDeg = 0.0;     //!< latitude
+            double longitudeDeg = 0.0;    //!< longitude
+            double altitudeFt = 0.0;      //!< altitude
+            double pitchDeg = 0.0;        //!< pitch
+            double bankDeg = 0.0;         //!< bank (roll)
+            double headingDeg = 0.0;      //!< heading
+            double groundSpeedKts = 0.0;  //!< ground speed
+            double onGroundFactor = -1.0; //!< on ground factor 0..1, -1 if not available
+            qint64 timestampMs = -1;      //!< interpolation time, ms since epoch
+            quint16 status = 0;           //!< StatusFlag values
+            quint16 parts = 0;            //!< PartsFlag values
+            quint8 flapsPercent = 0;      //!< flaps 0..100
+
+            //! Status flag set?
+            bool testStatus(StatusFlag flag) const { return (status & flag) != 0; }
+
+            //! Parts flag set?
+            bool testParts(PartsFlag flag) const { return (parts & flag) != 0; }
+
+            //! \copydoc CInterpolationStatus::hasValidSituation
+            bool hasValidSituation() const { return this->testStatus(ValidSituation); }
+
+            //! \copydoc CInterpolationStatus::isInterpolated
+            bool isInterpolated() const { return this->testStatus(Interpolated); }
+
+            //! Situation on ground?
+            bool isOnGround() const { return this->testStatus(OnGround); }
+
+            //! \copydoc CPartsStatus::isSupportingParts
+            bool isSupportingParts() const { return this->testStatus(SupportingParts); }
+
+            //! \copydoc CPartsStatus::isReusedParts
+            bool isReusedParts() const { return this->testStatus(ReusedParts); }
+
+            //! Parts values can be sent, i.e. supported or guessed parts
+            bool hasValidParts() const { return this->testStatus(ValidParts); }
+
+            //! Flaps 0..1
+            double getFlapsRatio() const { return flapsPercent / 100.0; }
+
+            //! Set situation values
+            void setSituation(const Aviation::CAircraftSituation &situation);
+
+            //! Set parts values
+            //! \remark lights as received (CAircraftParts::getLights), like the X-Plane and FlightGear drivers sent them before
+            void setParts(const Aviation::CAircraftParts &parts);
+
+            //! Set status values
+            void setStatus(const CInterpolationStatus &interpolation, const CPartsStatus &partsStatus, bool validParts);
+
+            //! Set or clear flag
+            void setStatusFlag(StatusFlag flag, bool set) { status = static_cast<quint16>(set ? (status | flag) : (status & ~flag)); }
+
+            //! Set or clear flag
+            void setPartsFlag(PartsFlag flag, bool set) { parts = static_cast<quint16>(set ? (parts | flag) : (parts & ~flag)); }
+        };
+
+        static_assert(std::is_trivially_copyable<CCompactInterpolationResult>::value, "Needs to be trivially copyable");
+
         //! Interpolator, calculation inbetween positions
         template <typename Derived>
         class CInterpolator :
@@ -197,9 +318,31 @@ namespace BlackMisc
             //! Latest interpolation result
             const Aviation::CAircraftSituation &getLastInterpolatedSituation() const { return m_lastSituation; }
 
+            //! Latest interpolated or guessed parts
+            const Aviation::CAircraftParts &getLastInterpolatedParts() const { return m_lastParts; }
+
+            //! Status of the latest interpolation
+            const CInterpolationStatus &getLastInterpolationStatus() const { return m_currentInterpolationStatus; }
+
             //! Parts and situation interpolated
             CInterpolationResult getInterpolation(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber = -1);
 
+            //! Parts and situation interpolated into a compact result
+            //! \remark no CInterpolationResult is created, meant for the simulators' per frame update
+            //! \remark situation and parts of the result are available by getLastInterpolatedSituation/getLastInterpolatedParts
+            //! \remark the simulators fetch one snapshot per frame and pass it for all aircraft, if null the current snapshot is fetched
+            CCompactInterpolationResult getInterpolationCompact(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber = -1,
+                    const CRemoteAircraftSnapshotPtr &snapshot = {});
+
+            //! Compact interpolation in 2 steps, so the positions of many aircraft are interpolated by one kernel call
+            //! \remark 1st step, the interpolant is added to the lanes, then CInterpolationLanes::evaluate and finishInterpolationCompact
+            //! \remark used by CInterpolationBatch, a single aircraft is interpolated by getInterpolationCompact
+            void prepareInterpolationCompact(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber,
+                                             const CRemoteAircraftSnapshotPtr &snapshot, CInterpolationLanes &lanes);
+
+            //! 2nd step of the compact interpolation, the lanes are evaluated
+            CCompactInterpolationResult finishInterpolationCompact(const CInterpolationLanes &lanes);
+
             //! Takes input between 0 and 1 and returns output between 0 and 1 smoothed with an S-shaped curve.
             //!
             //! Useful for making interpolation seem smoother, efficiently as it just uses simple arithmetic.
@@ -255,7 +398,9 @@ namespace BlackMisc
             //! \param currentTimeSinceEpoc
             //! \param setup
             //! \param aircraftNumber passing the aircraft number allows to equally distribute among the steps and not to do it always together for all aircraft
-            bool initIniterpolationStepData(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber);
+            //! \param snapshot provider data shared with other interpolators, if null the current snapshot is fetched
+            bool initIniterpolationStepData(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber,
+                                            const CRemoteAircraftSnapshotPtr &snapshot = {});
 
             //! Init the interpolated situation
             Aviation::CAircraftSituation initInterpolatedSituation(const Aviation::CAircraftSituation &oldSituation, const Aviation::CAircraftSituation &newSituation) const;
@@ -263,6 +408,13 @@ namespace BlackMisc
             //! Current interpolated situation
             Aviation::CAircraftSituation getInterpolatedSituation();
 
+            //! 1st step of the interpolated situation: interpolant and PBH
+            //! \param lanes position and altitude are added to the lanes, if null they are interpolated by finishInterpolatedSituation
+            void beginInterpolatedSituation(CInterpolationLanes *lanes);
+
+            //! 2nd step of the interpolated situation: position and altitude, ground and corrections
+            Aviation::CAircraftSituation finishInterpolatedSituation(const CInterpolationLanes *lanes);
+
             //! Parts before given offset time
             Aviation::CAircraftParts getInterpolatedParts();
 
@@ -275,6 +427,9 @@ namespace BlackMisc
             //! Do logging
             bool doLogging() const;
 
+            //! Do recording with the CInterpolationRecorder of the logger
+            bool doRecording() const;
+
             //! Decides threshold when situation is considered on ground
             //! \sa BlackMisc::Aviation::CAircraftSituation::setOnGroundFromGroundFactorFromInterpolation
             static double groundInterpolationFactor();
@@ -286,6 +441,7 @@ namespace BlackMisc
             qint64 m_currentTimeMsSinceEpoch = -1;                      //!< current time
             qint64 m_lastInvalidLogTs = -1;                             //!< last invalid situation timestamp
             Aviation::CAircraftSituationList m_currentSituations;       //!< current situations obtained by remoteAircraftSituationsAndChange
+            CRemoteAircraftSnapshotPtr m_currentSnapshot = CRemoteAircraftSnapshot::empty(); //!< provider data for the current step
             Aviation::CAircraftSituationChange m_pastSituationsChange;  //!< situations change of provider (i.e. network) situations
             CInterpolationAndRenderingSetupPerCallsign m_currentSetup;  //!< used setup
             CInterpolationStatus m_currentInterpolationStatus;          //!< this step's situation status
@@ -302,6 +458,8 @@ namespace BlackMisc
 
             qint64 m_situationsLastModified     { -1 }; //!< when situations were last modified
             qint64 m_situationsLastModifiedUsed { -1 }; //!< interpolant based on situations last updated
+            qint64 m_situationHistoryRevision   { -1 }; //!< revision of the compact situation history m_currentSituations are based on
+            int m_situationHistoryId            { -1 }; //!< interned id of the compact situation history
             int m_interpolatedSituationsCounter {  0 }; //!< counter for each interpolated situations: used for statistics, every n-th interpolation ....
 
             bool m_unitTest = false; //!< mark as unit test
@@ -311,7 +469,27 @@ namespace BlackMisc
                                                const CInterpolationAndRenderingSetupPerCallsign &setup = CInterpolationAndRenderingSetupPerCallsign::null());
 
         private:
+            //! State of the current step between its begin and finish
+            struct SituationStep
+            {
+                SituationLog log;                       //!< log, also used by the recorder
+                CInterpolationRecord record;            //!< flight recorder
+                Aviation::CAircraftSituation situation; //!< situation with PBH, before position and altitude
+                qint64 timestampMs = -1;                //!< current time
+                int aircraftNumber = 0;                 //!< number to distribute the steps among the aircraft
+                int lane = -1;                          //!< first lane in CInterpolationLanes, -1 if not added
+                bool initialized = false;               //!< step data initialized
+                bool noSituations = false;              //!< nothing to interpolate
+                bool validInterpolant = false;          //!< valid interpolant
+                bool interpolateGndFlag = false;        //!< ground factor is interpolated
+                bool recording = false;                 //!< recorded with the CInterpolationRecorder (anomalies)
+                bool sampled = false;                   //!< recorded regardless of anomalies
+            };
+
+            SituationStep m_step; //!< current step
             CInterpolationLogger *m_logger = nullptr; //!< optional interpolation logger
+            std::shared_ptr<CInterpolationRecordRing> m_recorderRing; //!< ring buffer of this callsign in the recorder
+            int m_recorderCallsignId = -1; //!< interned callsign in the recorder
             QTimer m_initTimer; //!< timer to init model, will be deleted when interpolator is deleted and cancel the call
 
             //! Guessed parts
@@ -320,6 +498,16 @@ namespace BlackMisc
             //! Log parts
             void logParts(const Aviation::CAircraftParts &parts, int partsNo, bool empty) const;
 
+            //! Record situation, if sampled or an anomaly
+            //! \param altCorrectionFt amount of the altitude correction
+            void recordSituation(CInterpolationRecord &record, const SituationLog &log, const Aviation::CAircraftSituation &situation, Aviation::CAircraftSituation::AltitudeCorrection altCorrection, double altCorrectionFt, bool sampled);
+
+            //! Record parts, if sampled
+            void recordParts(const Aviation::CAircraftParts &parts, int partsNo, bool empty);
+
+            //! Append to the recorder, triggers a dump on anomalies
+            void appendRecord(CInterpolationRecord &record);
+
             //! Get situations and calculate change, also correct altitudes if applicable
             //! \remark calculates offset (scenery) and situations change
             Aviation::CAircraftSituationList remoteAircraftSituationsAndChange(const CInterpolationAndRenderingSetupPerCallsign &setup);
@@ -340,6 +528,14 @@ namespace BlackMisc
             //! Return NULL parts and log
             const BlackMisc::Aviation::CAircraftParts &logAndReturnNullParts(const QString &info, bool log);
 
+            //! Steps of the compact interpolation
+            //! \param lanes if null, the position is interpolated without lanes
+            //! @{
+            void beginCompactStep(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber,
+                                  const CRemoteAircraftSnapshotPtr &snapshot, CInterpolationLanes *lanes);
+            CCompactInterpolationResult finishCompactStep(const CInterpolationLanes *lanes);
+            //! @}
+
             //! Derived class
             //! @{
             Derived *derived() { return static_cast<Derived *>(this); }
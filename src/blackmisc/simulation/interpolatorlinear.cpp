@@ -8,6 +8,7 @@
 
 #include "interpolatorlinear.h"
 #include "interpolatorfunctions.h"
+#include "interpolationkernels.h"
 #include "blackmisc/aviation/aircraftsituationlist.h"
 #include "blackmisc/aviation/altitude.h"
 #include "blackmisc/geo/coordinategeodetic.h"
@@ -58,6 +59,34 @@ namespace BlackMisc
         { }
 
         CAircraftSituation CInterpolatorLinear::CInterpolant::interpolatePositionAndAltitude(const CAircraftSituation &situation, bool interpolateGndFactor) const
+        {
+            // pos = (posB - posA) * t + posA, Alt = (AltB - AltA) * t + AltA
+            std::array<double, Channels> oldValues;
+            std::array<double, Channels> newValues;
+            this->channelValues(oldValues, newValues);
+            const double tf = clampValidTimeFraction(m_simulationTimeFraction);
+            std::array<double, Channels> values;
+            for (size_t c = 0; c < values.size(); c++)
+            {
+                values[c] = (newValues[c] - oldValues[c]) * tf + oldValues[c];
+            }
+            return this->situationFromValues(situation, interpolateGndFactor, values.data());
+        }
+
+        int CInterpolatorLinear::CInterpolant::addLanes(CInterpolationLanes &lanes) const
+        {
+            std::array<double, Channels> oldValues;
+            std::array<double, Channels> newValues;
+            this->channelValues(oldValues, newValues);
+            return lanes.addLinear(oldValues.data(), newValues.data(), clampValidTimeFraction(m_simulationTimeFraction), Channels);
+        }
+
+        CAircraftSituation CInterpolatorLinear::CInterpolant::interpolatePositionAndAltitude(const CAircraftSituation &situation, bool interpolateGndFactor, const CInterpolationLanes &lanes, int index) const
+        {
+            return this->situationFromValues(situation, interpolateGndFactor, lanes.linearValues(index));
+        }
+
+        void CInterpolatorLinear::CInterpolant::channelValues(std::array<double, Channels> &oldValues, std::array<double, Channels> &newValues) const
         {
             const std::array<double, 3> oldVec(m_oldSituation.getPosition().normalVectorDouble());
             const std::array<double, 3> newVec(m_newSituation.getPosition().normalVectorDouble());
@@ -69,27 +98,27 @@ namespace BlackMisc
                 BLACK_VERIFY_X(isAcceptableTimeFraction(m_simulationTimeFraction), Q_FUNC_INFO, "Invalid fraction");
             }
 
-            // Interpolate position: pos = (posB - posA) * t + posA
+            // avoid underflow below ground elevation by using getCorrectedAltitude
+            const CAltitude oldAlt(m_oldSituation.getCorrectedAltitude());
+            const CAltitude newAlt(m_newSituation.getCorrectedAltitude());
+            Q_ASSERT_X(oldAlt.getReferenceDatum() == CAltitude::MeanSeaLevel && oldAlt.getReferenceDatum() == newAlt.getReferenceDatum(), Q_FUNC_INFO, "mismatch in reference"); // otherwise no calculation is possible
+
+            static const CLengthUnit altUnit = CAltitude::defaultUnit();
+            oldValues = {{ oldVec[0], oldVec[1], oldVec[2], oldAlt.value(altUnit) }};
+            newValues = {{ newVec[0], newVec[1], newVec[2], newAlt.value(altUnit) }};
+        }
+
+        CAircraftSituation CInterpolatorLinear::CInterpolant::situationFromValues(const CAircraftSituation &situation, bool interpolateGndFactor, const double *values) const
+        {
             CCoordinateGeodetic newPosition;
-            const double tf = clampValidTimeFraction(m_simulationTimeFraction);
-            newPosition.setNormalVector((newVec[0] - oldVec[0]) * tf + oldVec[0],
-                                        (newVec[1] - oldVec[1]) * tf + oldVec[1],
-                                        (newVec[2] - oldVec[2]) * tf + oldVec[2]);
+            newPosition.setNormalVector(values[0], values[1], values[2]);
 
             if (CBuildConfig::isLocalDeveloperDebugBuild())
             {
                 BLACK_VERIFY_X(newPosition.isValidVectorRange(), Q_FUNC_INFO, "Invalid vector");
             }
 
-            // Interpolate altitude: Alt = (AltB - AltA) * t + AltA
-            // avoid underflow below ground elevation by using getCorrectedAltitude
-            const CAltitude oldAlt(m_oldSituation.getCorrectedAltitude());
-            const CAltitude newAlt(m_newSituation.getCorrectedAltitude());
-            Q_ASSERT_X(oldAlt.getReferenceDatum() == CAltitude::MeanSeaLevel && oldAlt.getReferenceDatum() == newAlt.getReferenceDatum(), Q_FUNC_INFO, "mismatch in reference"); // otherwise no calculation is possible
-            const CAltitude altitude((newAlt - oldAlt)
-                                     * tf
-                                     + oldAlt,
-                                     oldAlt.getReferenceDatum());
+            const CAltitude altitude(values[3], CAltitude::MeanSeaLevel, CAltitude::defaultUnit());
 
             CAircraftSituation newSituation(situation);
             newSituation.setPosition(newPosition);
@@ -104,6 +133,7 @@ namespace BlackMisc
                 {
                     if (CAircraftSituation::isGfEqualAirborne(oldGroundFactor, newGroundFactor)) { newSituation.setOnGround(false); break; }
                     if (CAircraftSituation::isGfEqualOnGround(oldGroundFactor, newGroundFactor)) { newSituation.setOnGround(true);  break; }
+                    const double tf = clampValidTimeFraction(m_simulationTimeFraction);
                     const double groundFactor = (newGroundFactor - oldGroundFactor) * tf + oldGroundFactor;
                     newSituation.setOnGroundFactor(groundFactor);
                     newSituation.setOnGroundFromGroundFactorFromInterpolation(groundInterpolationFactor());
@@ -216,17 +246,18 @@ namespace BlackMisc
             currentSituation.setMSecsSinceEpoch(interpolatedTime);
             m_currentInterpolationStatus.setInterpolatedAndCheckSituation(true, currentSituation);
 
+            // plain values, also used by the interpolation recorder
+            log.tsCurrent = m_currentTimeMsSinceEpoch;
+            log.deltaSampleTimesMs = sampleDeltaTimeMs;
+            log.simTimeFraction = simulationTimeFraction;
+            log.tsInterpolated = interpolatedTime;
+            log.interpolantRecalc = recalculate;
+
             if (this->doLogging())
             {
-                log.tsCurrent = m_currentTimeMsSinceEpoch;
-                log.deltaSampleTimesMs = sampleDeltaTimeMs;
-                log.simTimeFraction = simulationTimeFraction;
-                log.deltaSampleTimesMs = sampleDeltaTimeMs;
-                log.tsInterpolated = interpolatedTime;
                 log.interpolationSituations.clear();
                 log.interpolationSituations.push_back(oldSituation); // oldest at front
                 log.interpolationSituations.push_back(newSituation); // latest at back
-                log.interpolantRecalc = recalculate;
             }
 
             m_interpolant = { oldSituation, newSituation, simulationTimeFraction, interpolatedTime };
@@ -18,6 +18,7 @@
 #include "blackmisc/blackmiscexport.h"
 #include <QString>
 #include <QtGlobal>
+#include <array>
 
 class QObject;
 
@@ -53,6 +54,13 @@ namespace BlackMisc
                 //! Perform the interpolation
                 Aviation::CAircraftSituation interpolatePositionAndAltitude(const Aviation::CAircraftSituation &situation, bool interpolateGndFactor) const;
 
+                //! Add position and altitude to the lanes interpolated for many aircraft at once
+                //! \return index of the first lane
+                int addLanes(CInterpolationLanes &lanes) const;
+
+                //! Perform the interpolation with the values evaluated by the lanes
+                Aviation::CAircraftSituation interpolatePositionAndAltitude(const Aviation::CAircraftSituation &situation, bool interpolateGndFactor, const CInterpolationLanes &lanes, int index) const;
+
                 //! Old situation
                 const Aviation::CAircraftSituation &getOldSituation() const { return m_oldSituation; }
 
@@ -60,6 +68,15 @@ namespace BlackMisc
                 const Aviation::CAircraftSituation &getNewSituation() const { return m_newSituation; }
 
             private:
+                //! Channels: normal vector x, y, z and altitude
+                static constexpr int Channels = 4;
+
+                //! Old and new values of the channels
+                void channelValues(std::array<double, Channels> &oldValues, std::array<double, Channels> &newValues) const;
+
+                //! Situation with the interpolated channel values
+                Aviation::CAircraftSituation situationFromValues(const Aviation::CAircraftSituation &situation, bool interpolateGndFactor, const double *values) const;
+
                 Aviation::CAircraftSituation m_oldSituation;
                 Aviation::CAircraftSituation m_newSituation;
                 double m_simulationTimeFraction = 0.0; //!< 0..1
@@ -68,6 +85,9 @@ namespace BlackMisc
             //! Get the interpolant for the given time point
             CInterpolant getInterpolant(SituationLog &log);
 
+            //! Interpolant of the current step, as returned by getInterpolant
+            const CInterpolant &getCurrentInterpolant() const { return m_interpolant; }
+
         private:
             CInterpolant m_interpolant; //!< current interpolant
         };
@@ -33,6 +33,40 @@ namespace BlackMisc
             return CInterpolationResult();
         }
 
+        CCompactInterpolationResult CInterpolatorMulti::getInterpolationCompact(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber, const CRemoteAircraftSnapshotPtr &snapshot)
+        {
+            switch (setup.getInterpolatorMode())
+            {
+            case CInterpolationAndRenderingSetupBase::Linear: return m_linear.getInterpolationCompact(currentTimeSinceEpoc, setup, aircraftNumber, snapshot);
+            case CInterpolationAndRenderingSetupBase::Spline: return m_spline.getInterpolationCompact(currentTimeSinceEpoc, setup, aircraftNumber, snapshot);
+            default: break;
+            }
+
+            return CCompactInterpolationResult();
+        }
+
+        void CInterpolatorMulti::prepareInterpolationCompact(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber, const CRemoteAircraftSnapshotPtr &snapshot, CInterpolationLanes &lanes)
+        {
+            switch (setup.getInterpolatorMode())
+            {
+            case CInterpolationAndRenderingSetupBase::Linear: m_linear.prepareInterpolationCompact(currentTimeSinceEpoc, setup, aircraftNumber, snapshot, lanes); break;
+            case CInterpolationAndRenderingSetupBase::Spline: m_spline.prepareInterpolationCompact(currentTimeSinceEpoc, setup, aircraftNumber, snapshot, lanes); break;
+            default: break;
+            }
+        }
+
+        CCompactInterpolationResult CInterpolatorMulti::finishInterpolationCompact(CInterpolationAndRenderingSetupBase::InterpolatorMode mode, const CInterpolationLanes &lanes)
+        {
+            switch (mode)
+            {
+            case CInterpolationAndRenderingSetupBase::Linear: return m_linear.finishInterpolationCompact(lanes);
+            case CInterpolationAndRenderingSetupBase::Spline: return m_spline.finishInterpolationCompact(lanes);
+            default: break;
+            }
+
+            return CCompactInterpolationResult();
+        }
+
         const CAircraftSituation &CInterpolatorMulti::getLastInterpolatedSituation(CInterpolationAndRenderingSetupBase::InterpolatorMode mode) const
         {
             switch (mode)
@@ -44,6 +78,29 @@ namespace BlackMisc
             return CAircraftSituation::null();
         }
 
+        const CAircraftParts &CInterpolatorMulti::getLastInterpolatedParts(CInterpolationAndRenderingSetupBase::InterpolatorMode mode) const
+        {
+            switch (mode)
+            {
+            case CInterpolationAndRenderingSetupBase::Linear: return m_linear.getLastInterpolatedParts();
+            case CInterpolationAndRenderingSetupBase::Spline: return m_spline.getLastInterpolatedParts();
+            default: break;
+            }
+            return CAircraftParts::null();
+        }
+
+        const CInterpolationStatus &CInterpolatorMulti::getLastInterpolationStatus(CInterpolationAndRenderingSetupBase::InterpolatorMode mode) const
+        {
+            switch (mode)
+            {
+            case CInterpolationAndRenderingSetupBase::Linear: return m_linear.getLastInterpolationStatus();
+            case CInterpolationAndRenderingSetupBase::Spline: return m_spline.getLastInterpolationStatus();
+            default: break;
+            }
+            static const CInterpolationStatus empty;
+            return empty;
+        }
+
         void CInterpolatorMulti::attachLogger(CInterpolationLogger *logger)
         {
             m_linear.attachLogger(logger);
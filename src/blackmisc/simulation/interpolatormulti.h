@@ -31,9 +31,26 @@ namespace BlackMisc
             //! \copydoc CInterpolator::getInterpolation
             CInterpolationResult getInterpolation(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber);
 
+            //! \copydoc CInterpolator::getInterpolationCompact
+            CCompactInterpolationResult getInterpolationCompact(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber,
+                    const CRemoteAircraftSnapshotPtr &snapshot = {});
+
+            //! \copydoc CInterpolator::prepareInterpolationCompact
+            void prepareInterpolationCompact(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber,
+                                             const CRemoteAircraftSnapshotPtr &snapshot, CInterpolationLanes &lanes);
+
+            //! \copydoc CInterpolator::finishInterpolationCompact
+            CCompactInterpolationResult finishInterpolationCompact(CInterpolationAndRenderingSetupBase::InterpolatorMode mode, const CInterpolationLanes &lanes);
+
             //! \copydoc CInterpolator::getLastInterpolatedSituation
             const Aviation::CAircraftSituation &getLastInterpolatedSituation(CInterpolationAndRenderingSetupBase::InterpolatorMode mode) const;
 
+            //! \copydoc CInterpolator::getLastInterpolatedParts
+            const Aviation::CAircraftParts &getLastInterpolatedParts(CInterpolationAndRenderingSetupBase::InterpolatorMode mode) const;
+
+            //! \copydoc CInterpolator::getLastInterpolationStatus
+            const CInterpolationStatus &getLastInterpolationStatus(CInterpolationAndRenderingSetupBase::InterpolatorMode mode) const;
+
             //! \copydoc CInterpolator::getInterpolationMessages
             const CStatusMessageList &getInterpolationMessages(CInterpolationAndRenderingSetupBase::InterpolatorMode mode) const;
 
@@ -13,6 +13,8 @@
 #include "blackmisc/verify.h"
 #include "blackconfig/buildconfig.h"
 
+#include <limits>
+
 using namespace BlackConfig;
 using namespace BlackMisc::Aviation;
 using namespace BlackMisc::Geo;
@@ -107,8 +109,30 @@ namespace BlackMisc
 
         bool CInterpolatorSpline::fillSituationsArray()
         {
-            // m_s[0] .. oldest -> m_[2] .. latest
+            std::array<bool, 3> fromProvider;
+            const bool hasNewer = this->selectSituations(m_s, fromProvider);
+            m_interpolantKey = this->interpolantKey(m_s, fromProvider); // before elevations are added from the cache
+            if (m_currentSituations.isEmpty()) { return hasNewer; }
+
+            if (CBuildConfig::isLocalDeveloperDebugBuild())
+            {
+                const bool verified = this->verifyInterpolationSituations(m_s[0], m_s[1], m_s[2]); // oldest -> latest, only verify order
+                if (!verified)
+                {
+                    static const QString vm("Unverified situations, m0-2 (oldest latest) %1 %2 %3");
+                    const QString vmValues = vm.arg(m_s[0].getAdjustedMSecsSinceEpoch()).arg(m_s[1].getAdjustedMSecsSinceEpoch()).arg(m_s[2].getAdjustedMSecsSinceEpoch());
+                    CLogMessage(this).warning(vmValues);
+                    Q_UNUSED(vmValues)
+                }
+            }
+            return hasNewer;
+        }
+
+        bool CInterpolatorSpline::selectSituations(std::array<CAircraftSituation, 3> &situations, std::array<bool, 3> &fromProvider) const
+        {
+            // situations[0] .. oldest -> situations[2] .. latest
             // general idea, we interpolate from current situation -> latest situation
+            fromProvider = {{ false, false, false }};
 
             // do we have the last interpolated situation?
             if (m_lastSituation.isNull())
@@ -116,7 +140,7 @@ namespace BlackMisc
                 if (m_currentSituations.isEmpty())
                 {
                     // nothing we can do
-                    m_s[0] = m_s[1] = m_s[2] = CAircraftSituation::null();
+                    situations[0] = situations[1] = situations[2] = CAircraftSituation::null();
                     return false;
                 }
                 else
@@ -124,27 +148,31 @@ namespace BlackMisc
                     // we start with the latest situation just to init the values
                     CAircraftSituation f = m_currentSituations.front();
                     f.setAdjustedMSecsSinceEpoch(m_currentTimeMsSinceEpoch); // adjusted time exactly "now"
-                    m_s[0] = m_s[1] = m_s[2] = f;
+                    situations[0] = situations[1] = situations[2] = f;
+                    fromProvider[1] = true;
                 }
             }
             else
             {
                 // in normal cases init some default values
-                m_s[0] = m_s[1] = m_s[2] = m_lastSituation; // current position
+                situations[0] = situations[1] = situations[2] = m_lastSituation; // current position
             }
 
             // set some default values
             const qint64 defaultValueMs = CFsdSetup::c_interimPositionTimeOffsetMsec; // CLANG cannot use reference in qMax
-            const qint64 os = qMax(defaultValueMs, m_s[2].getTimeOffsetMs());
-            m_s[0].addMsecs(-os); // oldest, Ref T297 default offset time to fill data
-            m_s[2].addMsecs(os);  // latest, Ref T297 default offset time to fill data
+            const qint64 os = qMax(defaultValueMs, situations[2].getTimeOffsetMs());
+            situations[0].addMsecs(-os); // oldest, Ref T297 default offset time to fill data
+            situations[2].addMsecs(os);  // latest, Ref T297 default offset time to fill data
             if (m_currentSituations.isEmpty()) { return false; }
 
             // and use the real values if available
-            // m_s[0] .. oldest -> m_[2] .. latest
-            const CAircraftSituation latest = m_currentSituations.front();
-            if (latest.isNewerThanAdjusted(m_s[1])) { m_s[2] = latest; }
-            const qint64 currentAdjusted = m_s[1].getAdjustedMSecsSinceEpoch();
+            const CAircraftSituation &latest = m_currentSituations.front();
+            if (latest.isNewerThanAdjusted(situations[1]))
+            {
+                situations[2] = latest;
+                fromProvider[2] = true;
+            }
+            const qint64 currentAdjusted = situations[1].getAdjustedMSecsSinceEpoch();
 
             // with https://dev.swift-project.org/T668#15841 avoid 2 very close positions
             // currently done by time, maybe we can also choose distance
@@ -152,32 +180,23 @@ namespace BlackMisc
             const CAircraftSituation older = m_currentSituations.findObjectBeforeAdjustedOrDefault(currentAdjusted - osNotTooClose);
             if (!older.isNull())
             {
-                m_s[0] = older;
+                situations[0] = older;
+                fromProvider[0] = true;
             }
             else
             {
                 const CAircraftSituation closeOlder = m_currentSituations.findObjectBeforeAdjustedOrDefault(currentAdjusted);
-                if (!closeOlder.isNull()) { m_s[0] = closeOlder; }
+                if (!closeOlder.isNull())
+                {
+                    situations[0] = closeOlder;
+                    fromProvider[0] = true;
+                }
             }
-            const qint64 latestAdjusted = m_s[2].getAdjustedMSecsSinceEpoch();
-            const qint64 olderAdjusted  = m_s[0].getAdjustedMSecsSinceEpoch();
 
             // not having a new situation itself is quite normal,
             // only if it persits it is critical.
-            const bool hasNewer = latestAdjusted > m_currentTimeMsSinceEpoch;
-
-            if (CBuildConfig::isLocalDeveloperDebugBuild())
-            {
-                const bool verified = this->verifyInterpolationSituations(m_s[0], m_s[1], m_s[2]); // oldest -> latest, only verify order
-                if (!verified)
-                {
-                    static const QString vm("Unverified situations, m0-2 (oldest latest) %1 %2 %3");
-                    const QString vmValues = vm.arg(olderAdjusted).arg(currentAdjusted).arg(latestAdjusted);
-                    CLogMessage(this).warning(vmValues);
-                    Q_UNUSED(vmValues)
-                }
-            }
-            return hasNewer;
+            const qint64 latestAdjusted = situations[2].getAdjustedMSecsSinceEpoch();
+            return latestAdjusted > m_currentTimeMsSinceEpoch;
         }
 
         // pin vtables to this file
@@ -188,8 +207,15 @@ namespace BlackMisc
         {
             // recalculate derivatives only if they changed
             // m_situationsLastModified updated in initIniterpolationStepData
-            const bool recalculate = (m_currentTimeMsSinceEpoch >= m_nextSampleAdjustedTime) || // new step
-                                     (m_situationsLastModified  >  m_situationsLastModifiedUsed); // modified
+            const bool newStep  = m_currentTimeMsSinceEpoch >= m_nextSampleAdjustedTime;
+            const bool modified = m_situationsLastModified  >  m_situationsLastModifiedUsed;
+            bool recalculate = newStep || modified;
+            if (recalculate && !newStep && m_interpolant.isValid() && this->currentInterpolantKey() == m_interpolantKey)
+            {
+                // modified, but no new situation, elevation or ground flag: the solved coefficients are still valid
+                m_situationsLastModifiedUsed = m_situationsLastModified;
+                recalculate = false;
+            }
 
             if (recalculate)
             {
@@ -210,10 +236,6 @@ namespace BlackMisc
                 pa.z = {{ normals[0][2], normals[1][2], normals[2][2] }}; // latest
                 pa.t = {{ static_cast<double>(m_s[0].getAdjustedMSecsSinceEpoch()), static_cast<double>(m_s[1].getAdjustedMSecsSinceEpoch()), static_cast<double>(m_s[2].getAdjustedMSecsSinceEpoch()) }};
 
-                pa.dx = getDerivatives(pa.t, pa.x);
-                pa.dy = getDerivatives(pa.t, pa.y);
-                pa.dz = getDerivatives(pa.t, pa.z);
-
                 // - altitude unit must be the same for all three, but the unit itself does not matter
                 // - ground elevantion here normally is not available
                 // - some info how fast a plane moves: 100km/h => 1sec 27,7m => 5 secs 136m
@@ -228,6 +250,9 @@ namespace BlackMisc
                 const double a2 = m_s[2].getCorrectedAltitude(cg).value(altUnit); // latest
                 pa.a    = {{ a0, a1, a2 }};
                 pa.gnd  = {{ m_s[0].getOnGroundFactor(), m_s[1].getOnGroundFactor(), m_s[2].getOnGroundFactor() }};
+                pa.dx   = getDerivatives(pa.t, pa.x);
+                pa.dy   = getDerivatives(pa.t, pa.y);
+                pa.dz   = getDerivatives(pa.t, pa.z);
                 pa.da   = getDerivatives(pa.t, pa.a);
                 pa.dgnd = getDerivatives(pa.t, pa.gnd);
 
@@ -239,6 +264,11 @@ namespace BlackMisc
                 Q_ASSERT_X(m_prevSampleAdjustedTime < m_nextSampleAdjustedTime, Q_FUNC_INFO, "Wrong time order");
             }
 
+            if (recalculate) { m_interpolantCacheMisses++; }
+            else { m_interpolantCacheHits++; }
+            m_currentInterpolationStatus.setInterpolantCacheHit(!recalculate);
+            m_currentInterpolationStatus.setInterpolantCacheCounters(m_interpolantCacheHits, m_interpolantCacheMisses);
+
             // Example:
             // prev.sample time 5 (received at 0) , next sample time 10 (received at 5)
             // cur.time 6: dt1=6-5=1, dt2=5 => fraction 1/5
@@ -269,22 +299,56 @@ namespace BlackMisc
             m_interpolant.setTimes(m_currentTimeMsSinceEpoch, timeFraction, interpolatedTime);
             m_interpolant.setRecalculated(recalculate);
 
+            // plain values, also used by the interpolation recorder
+            log.interpolator = 's';
+            log.deltaSampleTimesMs = dt2;
+            log.simTimeFraction = timeFraction;
+            log.tsInterpolated = interpolatedTime; // without offsets
+            log.interpolantRecalc = m_interpolant.isRecalculated();
+
             if (this->doLogging())
             {
                 log.interpolationSituations.clear();
                 log.interpolationSituations.push_back(m_s[0]);
                 log.interpolationSituations.push_back(m_s[1]);
                 log.interpolationSituations.push_back(m_s[2]); // latest at end
-                log.interpolator = 's';
-                log.deltaSampleTimesMs = dt2;
-                log.simTimeFraction = timeFraction;
-                log.tsInterpolated = interpolatedTime; // without offsets
-                log.interpolantRecalc = m_interpolant.isRecalculated();
             }
 
             return m_interpolant;
         }
 
+        bool CInterpolatorSpline::InterpolantKey::operator ==(const InterpolantKey &other) const
+        {
+            return adjustedTimes == other.adjustedTimes && elevationsFt == other.elevationsFt && groundFactors == other.groundFactors &&
+                   cgFt == other.cgFt && sceneryOffsetFt == other.sceneryOffsetFt;
+        }
+
+        CInterpolatorSpline::InterpolantKey CInterpolatorSpline::interpolantKey(const std::array<CAircraftSituation, 3> &situations, const std::array<bool, 3> &fromProvider) const
+        {
+            static const double noValue = std::numeric_limits<double>::lowest();
+            InterpolantKey key;
+            for (size_t i = 0; i < situations.size(); i++)
+            {
+                // values derived from the last interpolated situation move with every step, but do not change the interval
+                if (!fromProvider[i]) { continue; }
+                const CAircraftSituation &s = situations[i];
+                key.adjustedTimes[i] = s.getAdjustedMSecsSinceEpoch();
+                key.elevationsFt[i]  = s.hasGroundElevation() ? s.getGroundElevation().value(CLengthUnit::ft()) : noValue;
+                key.groundFactors[i] = s.getOnGroundFactor();
+            }
+            key.cgFt = this->getModelCG().isNull() ? noValue : this->getModelCG().value(CLengthUnit::ft());
+            key.sceneryOffsetFt = m_currentSceneryOffset.isNull() ? noValue : m_currentSceneryOffset.value(CLengthUnit::ft());
+            return key;
+        }
+
+        CInterpolatorSpline::InterpolantKey CInterpolatorSpline::currentInterpolantKey() const
+        {
+            std::array<CAircraftSituation, 3> situations;
+            std::array<bool, 3> fromProvider;
+            this->selectSituations(situations, fromProvider);
+            return this->interpolantKey(situations, fromProvider);
+        }
+
         bool CInterpolatorSpline::updateElevations(bool canSkip)
         {
             bool updated = false;
@@ -326,24 +390,62 @@ namespace BlackMisc
         }
 
         CAircraftSituation CInterpolatorSpline::CInterpolant::interpolatePositionAndAltitude(const CAircraftSituation &currentSituation, bool interpolateGndFactor) const
+        {
+            if (!this->isValidInterval()) { return CAircraftSituation::null(); }
+
+            // x, y, z, altitude, ground factor
+            const double t1 = m_pa.t[1];
+            const double t2 = m_pa.t[2]; // latest (adjusted)
+            const double x  = static_cast<double>(m_currentTimeMsSinceEpoc);
+            const std::array<double, Channels> values {{
+                    evalSplineInterval(x, t1, t2, m_pa.x[1],   m_pa.x[2],   m_pa.dx[1],   m_pa.dx[2]),
+                    evalSplineInterval(x, t1, t2, m_pa.y[1],   m_pa.y[2],   m_pa.dy[1],   m_pa.dy[2]),
+                    evalSplineInterval(x, t1, t2, m_pa.z[1],   m_pa.z[2],   m_pa.dz[1],   m_pa.dz[2]),
+                    evalSplineInterval(x, t1, t2, m_pa.a[1],   m_pa.a[2],   m_pa.da[1],   m_pa.da[2]),
+                    evalSplineInterval(x, t1, t2, m_pa.gnd[1], m_pa.gnd[2], m_pa.dgnd[1], m_pa.dgnd[2])
+                }
+            };
+            return this->situationFromValues(currentSituation, interpolateGndFactor, values.data());
+        }
+
+        int CInterpolatorSpline::CInterpolant::addLanes(CInterpolationLanes &lanes) const
+        {
+            const std::array<double, Channels> y0 {{ m_pa.x[1], m_pa.y[1], m_pa.z[1], m_pa.a[1], m_pa.gnd[1] }};
+            const std::array<double, Channels> y1 {{ m_pa.x[2], m_pa.y[2], m_pa.z[2], m_pa.a[2], m_pa.gnd[2] }};
+            const std::array<double, Channels> k0 {{ m_pa.dx[1], m_pa.dy[1], m_pa.dz[1], m_pa.da[1], m_pa.dgnd[1] }};
+            const std::array<double, Channels> k1 {{ m_pa.dx[2], m_pa.dy[2], m_pa.dz[2], m_pa.da[2], m_pa.dgnd[2] }};
+            return lanes.addHermite(static_cast<double>(m_currentTimeMsSinceEpoc), m_pa.t[1], m_pa.t[2], y0.data(), y1.data(), k0.data(), k1.data(), Channels);
+        }
+
+        CAircraftSituation CInterpolatorSpline::CInterpolant::interpolatePositionAndAltitude(const CAircraftSituation &currentSituation, bool interpolateGndFactor, const CInterpolationLanes &lanes, int index) const
+        {
+            // lanes of an invalid interval are evaluated, but not used
+            if (!this->isValidInterval()) { return CAircraftSituation::null(); }
+            return this->situationFromValues(currentSituation, interpolateGndFactor, lanes.hermiteValues(index));
+        }
+
+        bool CInterpolatorSpline::CInterpolant::isValidInterval() const
         {
             const double t1 = m_pa.t[1];
             const double t2 = m_pa.t[2]; // latest (adjusted)
 
-            bool valid = (t1 < t2) && (m_currentTimeMsSinceEpoc >= t1) && (m_currentTimeMsSinceEpoc < t2);
+            const bool valid = (t1 < t2) && (m_currentTimeMsSinceEpoc >= t1) && (m_currentTimeMsSinceEpoc < t2);
             if (!valid && CBuildConfig::isLocalDeveloperDebugBuild())
             {
                 Q_ASSERT_X(t1 < t2, Q_FUNC_INFO, "Expect sorted times, latest first"); // that means a bug in our code init the values
                 BLACK_VERIFY_X(m_currentTimeMsSinceEpoc >= t1, Q_FUNC_INFO, "invalid timestamp t1");
                 BLACK_VERIFY_X(m_currentTimeMsSinceEpoc <  t2, Q_FUNC_INFO, "invalid timestamp t2"); // t1==t2 results in div/0
             }
-            if (!valid) { return CAircraftSituation::null(); }
+            return valid;
+        }
 
-            const double newX = evalSplineInterval(m_currentTimeMsSinceEpoc, t1, t2, m_pa.x[1], m_pa.x[2], m_pa.dx[1], m_pa.dx[2]);
-            const double newY = evalSplineInterval(m_currentTimeMsSinceEpoc, t1, t2, m_pa.y[1], m_pa.y[2], m_pa.dy[1], m_pa.dy[2]);
-            const double newZ = evalSplineInterval(m_currentTimeMsSinceEpoc, t1, t2, m_pa.z[1], m_pa.z[2], m_pa.dz[1], m_pa.dz[2]);
+        CAircraftSituation CInterpolatorSpline::CInterpolant::situationFromValues(const CAircraftSituation &currentSituation, bool interpolateGndFactor, const double *values) const
+        {
+            const double newX = values[0];
+            const double newY = values[1];
+            const double newZ = values[2];
 
-            valid = CAircraftSituation::isValidVector(m_pa.x) && CAircraftSituation::isValidVector(m_pa.y) && CAircraftSituation::isValidVector(m_pa.z);
+            bool valid = CAircraftSituation::isValidVector(m_pa.x) && CAircraftSituation::isValidVector(m_pa.y) && CAircraftSituation::isValidVector(m_pa.z);
             if (!valid && CBuildConfig::isLocalDeveloperDebugBuild())
             {
                 BLACK_VERIFY_X(CAircraftSituation::isValidVector(m_pa.x), Q_FUNC_INFO, "invalid X"); // all x values
@@ -365,8 +467,7 @@ namespace BlackMisc
             }
             if (!valid) { return CAircraftSituation::null(); }
 
-            const double newA = evalSplineInterval(m_currentTimeMsSinceEpoc, t1, t2, m_pa.a[1], m_pa.a[2], m_pa.da[1], m_pa.da[2]);
-            const CAltitude alt(newA, m_altitudeUnit);
+            const CAltitude alt(values[3], m_altitudeUnit);
 
             newSituation.setPosition(currentPosition);
             newSituation.setAltitude(alt);
@@ -381,8 +482,7 @@ namespace BlackMisc
                     newSituation.setOnGroundDetails(CAircraftSituation::OnGroundByInterpolation);
                     if (CAircraftSituation::isGfEqualAirborne(gnd1, gnd2)) { newSituation.setOnGround(false); break; }
                     if (CAircraftSituation::isGfEqualOnGround(gnd1, gnd2)) { newSituation.setOnGround(true); break; }
-                    const double newGnd = evalSplineInterval(m_currentTimeMsSinceEpoc, t1, t2, gnd1, gnd2, m_pa.dgnd[1], m_pa.dgnd[2]);
-                    newSituation.setOnGroundFactor(newGnd);
+                    newSituation.setOnGroundFactor(values[4]);
                     newSituation.setOnGroundFromGroundFactorFromInterpolation(groundInterpolationFactor());
                 }
                 while (false);
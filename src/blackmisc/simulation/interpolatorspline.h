@@ -66,6 +66,13 @@ namespace BlackMisc
                 //! Perform the interpolation
                 Aviation::CAircraftSituation interpolatePositionAndAltitude(const Aviation::CAircraftSituation &currentSituation, bool interpolateGndFactor) const;
 
+                //! Add position, altitude and ground factor to the lanes interpolated for many aircraft at once
+                //! \return index of the first lane
+                int addLanes(CInterpolationLanes &lanes) const;
+
+                //! Perform the interpolation with the values evaluated by the lanes
+                Aviation::CAircraftSituation interpolatePositionAndAltitude(const Aviation::CAircraftSituation &currentSituation, bool interpolateGndFactor, const CInterpolationLanes &lanes, int index) const;
+
                 //! Old situation
                 const Aviation::CAircraftSituation &getOldSituation() const { return pbh().getOldSituation(); }
 
@@ -79,6 +86,15 @@ namespace BlackMisc
                 const PosArray &getPa() const { return m_pa; }
 
             private:
+                //! Channels: normal vector x, y, z, altitude and ground factor
+                static constexpr int Channels = 5;
+
+                //! Current time within the interval of the latest 2 situations
+                bool isValidInterval() const;
+
+                //! Situation with the interpolated channel values
+                Aviation::CAircraftSituation situationFromValues(const Aviation::CAircraftSituation &currentSituation, bool interpolateGndFactor, const double *values) const;
+
                 PosArray m_pa; //!< current positions array, latest values last
                 PhysicalQuantities::CLengthUnit m_altitudeUnit;
                 qint64 m_currentTimeMsSinceEpoc { -1 };
@@ -87,6 +103,9 @@ namespace BlackMisc
             //! Strategy used by CInterpolator::getInterpolatedSituation
             CInterpolant getInterpolant(SituationLog &log);
 
+            //! Interpolant of the current step, as returned by getInterpolant
+            const CInterpolant &getCurrentInterpolant() const { return m_interpolant; }
+
         private:
             //! Update the elevations used in CInterpolatorSpline::m_s
             bool updateElevations(bool canSkip);
@@ -97,9 +116,38 @@ namespace BlackMisc
             //! Ground relevant
             bool isAnySituationNearGroundRelevant() const;
 
-            //! Fill the situations array
+            //! Fill the situations array and the key of the interpolant
             bool fillSituationsArray();
 
+            //! Select the situations for CInterpolatorSpline::m_s, oldest -> latest
+            //! \param situations selected situations
+            //! \param fromProvider set for the situations taken from the provider, the others are derived from the last interpolated situation
+            //! \return has a situation newer than the current time
+            bool selectSituations(std::array<Aviation::CAircraftSituation, 3> &situations, std::array<bool, 3> &fromProvider) const;
+
+            //! Values the solved coefficients depend on, besides the last interpolated situation
+            //! \remark the provider situations selected for CInterpolatorSpline::m_s with their ground elevations and ground factors, CG and scenery offset
+            struct InterpolantKey
+            {
+                std::array<qint64, 3> adjustedTimes {{ -1, -1, -1 }}; //!< oldest -> latest, -1 if not from provider
+                std::array<double, 3> elevationsFt {{ 0, 0, 0 }};     //!< ground elevation, lowest() if not available
+                std::array<double, 3> groundFactors {{ 0, 0, 0 }};    //!< on ground factors
+                double cgFt = 0;                                      //!< model CG
+                double sceneryOffsetFt = 0;                           //!< scenery offset
+
+                //! Equal
+                bool operator ==(const InterpolantKey &other) const;
+            };
+
+            //! Key for the given situations
+            InterpolantKey interpolantKey(const std::array<Aviation::CAircraftSituation, 3> &situations, const std::array<bool, 3> &fromProvider) const;
+
+            //! Key for the situations CInterpolatorSpline::m_s would be filled with now
+            InterpolantKey currentInterpolantKey() const;
+
+            qint64 m_interpolantCacheHits   = 0; //!< interpolant re-used
+            qint64 m_interpolantCacheMisses = 0; //!< interpolant recalculated
+            InterpolantKey m_interpolantKey;     //!< key of m_interpolant
             qint64 m_prevSampleAdjustedTime = 0; //!< previous sample time + offset
             qint64 m_nextSampleAdjustedTime = 0; //!< previous sample time + offset
             qint64 m_prevSampleTime = 0; //!< previous sample "real time"
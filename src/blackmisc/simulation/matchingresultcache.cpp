@@ -0,0 +1,120 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/matchingresultcache.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/airlineicaocode.h"
+#include "blackmisc/aviation/livery.h"
+
+#include <QMutexLocker>
+#include <QStringBuilder>
+
+using namespace BlackMisc::Aviation;
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        QString CMatchingResultCache::key(const CAircraftModel &remoteModel)
+        {
+            // everything the reduce and score steps look at
+            const CAircraftIcaoCode &icao = remoteModel.getAircraftIcaoCode();
+            return icao.getDesignator().trimmed().toUpper() % u'|' %
+                   icao.getCombinedType().trimmed().toUpper() % u'|' %
+                   icao.getDbKeyAsString() % u'|' %
+                   remoteModel.getAirlineIcaoCode().getVDesignator().trimmed().toUpper() % u'|' %
+                   remoteModel.getAirlineIcaoCode().getDbKeyAsString() % u'|' %
+                   remoteModel.getLivery().getCombinedCode().trimmed().toUpper() % u'|' %
+                   remoteModel.getModelString().trimmed().toUpper() % u'|' %
+                   (remoteModel.isMilitary() ? u'M' : u'C') %
+                   (remoteModel.isVtol() ? u'V' : u'-');
+        }
+
+        bool CMatchingResultCache::find(const CAircraftModel &remoteModel, uint setupHash, int modelSetRevision, Entry &entry) const
+        {
+            const QString k = CMatchingResultCache::key(remoteModel);
+            bool hit = false;
+            {
+                QMutexLocker lock(&m_mutex);
+                const auto it = m_entries.constFind(k);
+                if (it != m_entries.constEnd() && it->setupHash == setupHash && it->modelSetRevision == modelSetRevision)
+                {
+                    entry = it.value();
+                    hit = true;
+                }
+            }
+            this->count(remoteModel, hit);
+            return hit;
+        }
+
+        void CMatchingResultCache::insert(const CAircraftModel &remoteModel, uint setupHash, int modelSetRevision, const CAircraftModel &model, const CAircraftModelList &candidates)
+        {
+            const QString k = CMatchingResultCache::key(remoteModel);
+            Entry entry;
+            entry.model = model;
+            entry.candidates = candidates;
+            entry.candidates.truncate(MaxCandidates);
+            entry.setupHash = setupHash;
+            entry.modelSetRevision = modelSetRevision;
+
+            QMutexLocker lock(&m_mutex);
+            if (m_entries.size() >= MaxEntries && !m_entries.contains(k)) { m_entries.clear(); } // simple, happens rarely if at all
+            m_entries.insert(k, entry);
+        }
+
+        void CMatchingResultCache::clear()
+        {
+            QMutexLocker lock(&m_mutex);
+            m_entries.clear();
+        }
+
+        int CMatchingResultCache::size() const
+        {
+            QMutexLocker lock(&m_mutex);
+            return m_entries.size();
+        }
+
+        void CMatchingResultCache::count(const CAircraftModel &remoteModel, bool hit) const
+        {
+            (hit ? m_hits : m_misses)++;
+            const Combination combination(remoteModel.getAircraftIcaoCodeDesignator(), remoteModel.getAirlineIcaoCodeVDesignator());
+            QMutexLocker lock(&m_mutex);
+            QPair<int, int> &counts = m_combinationCounts[combination];
+            (hit ? counts.first : counts.second)++;
+        }
+
+        void CMatchingResultCache::clearStatistics()
+        {
+            QMutexLocker lock(&m_mutex);
+            m_combinationCounts.clear();
+            m_hits = 0;
+            m_misses = 0;
+        }
+
+        void CMatchingResultCache::addToStatistics(CMatchingStatistics &statistics, const QString &sessionId, const QString &modelSetId) const
+        {
+            static const QString description("Matching result cache");
+            QMutexLocker lock(&m_mutex);
+            for (auto it = m_combinationCounts.constBegin(); it != m_combinationCounts.constEnd(); ++it)
+            {
+                if (it->first > 0)
+                {
+                    CMatchingStatisticsEntry entry(CMatchingStatisticsEntry::CacheHit, sessionId, modelSetId, description, it.key().first, it.key().second);
+                    entry.setCount(it->first);
+                    statistics.push_back(entry);
+                }
+                if (it->second > 0)
+                {
+                    CMatchingStatisticsEntry entry(CMatchingStatisticsEntry::CacheMiss, sessionId, modelSetId, description, it.key().first, it.key().second);
+                    entry.setCount(it->second);
+                    statistics.push_back(entry);
+                }
+            }
+        }
+    } // namespace
+} // namespace
@@ -0,0 +1,99 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_MATCHINGRESULTCACHE_H
+#define BLACKMISC_SIMULATION_MATCHINGRESULTCACHE_H
+
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/aircraftmodel.h"
+#include "blackmisc/simulation/matchingstatistics.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+#include <atomic>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        //! Cache of matching results
+        //! \details Remote aircraft with the same aircraft ICAO, airline ICAO, livery and model string yield the
+        //!          same candidates for the same matcher setup and model set. Results are stored together
+        //!          with the setup hash and model set revision they were matched with, and are only returned for
+        //!          the same hash and revision. The best candidates are kept, so a random pick is still random.
+        //! \threadsafe
+        class BLACKMISC_EXPORT CMatchingResultCache
+        {
+        public:
+            //! Max. number of candidates kept to pick from (random pick strategy)
+            static constexpr int MaxCandidates = 10;
+
+            //! Max. number of cached results
+            static constexpr int MaxEntries = 5000;
+
+            //! A cached result
+            struct Entry
+            {
+                CAircraftModel     model;            //!< matched model
+                CAircraftModelList candidates;       //!< best candidates the model was picked from
+                uint               setupHash = 0;    //!< hash of the setup used
+                int                modelSetRevision = -1; //!< model set revision used
+            };
+
+            //! Ctor
+            CMatchingResultCache() {}
+
+            //! Normalized key of the remote model (matching input)
+            static QString key(const CAircraftModel &remoteModel);
+
+            //! Find cached result for the remote model
+            //! \remark counted as hit or miss
+            bool find(const CAircraftModel &remoteModel, uint setupHash, int modelSetRevision, Entry &entry) const;
+
+            //! Cache the result for the remote model, only the best CMatchingResultCache::MaxCandidates candidates are kept
+            void insert(const CAircraftModel &remoteModel, uint setupHash, int modelSetRevision, const CAircraftModel &model, const CAircraftModelList &candidates);
+
+            //! Remove all results, statistics are kept
+            void clear();
+
+            //! Number of cached results
+            int size() const;
+
+            //! Hits and misses
+            //! @{
+            int getHits() const { return m_hits; }
+            int getMisses() const { return m_misses; }
+            //! @}
+
+            //! Reset hits and misses
+            void clearStatistics();
+
+            //! Add hits and misses to the statistics, one entry per aircraft/airline combination
+            void addToStatistics(CMatchingStatistics &statistics, const QString &sessionId, const QString &modelSetId) const;
+
+        private:
+            using Combination = QPair<QString, QString>; //!< aircraft, airline
+
+            //! Count hit or miss
+            void count(const CAircraftModel &remoteModel, bool hit) const;
+
+            mutable QMutex m_mutex;
+            QHash<QString, Entry> m_entries;                                  //!< by key
+            mutable QHash<Combination, QPair<int, int>> m_combinationCounts; //!< hits, misses per aircraft/airline
+            mutable std::atomic_int m_hits { 0 };
+            mutable std::atomic_int m_misses { 0 };
+        };
+    } // namespace
+} // namespace
+
+#endif // guard
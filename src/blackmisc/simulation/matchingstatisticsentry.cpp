@@ -66,6 +66,8 @@ namespace BlackMisc
             {
             case Found: return CIcon::iconByIndex(CIcons::StandardIconTick16);
             case Missing: return CIcon::iconByIndex(CIcons::StandardIconCross16);
+            case CacheHit: return CIcon::iconByIndex(CIcons::StandardIconDatabase16);
+            case CacheMiss: return CIcon::iconByIndex(CIcons::StandardIconDatabaseError16);
             default:
                 qFatal("Wrong Type");
                 return CIcon::iconByIndex(CIcons::StandardIconUnknown16);
@@ -76,12 +78,16 @@ namespace BlackMisc
         {
             static const QString f("found");
             static const QString m("missing");
+            static const QString ch("cache hit");
+            static const QString cm("cache miss");
             static const QString x("ups");
 
             switch (type)
             {
             case Found: return f;
             case Missing: return m;
+            case CacheHit: return ch;
+            case CacheMiss: return cm;
             default:
                 qFatal("Wrong Type");
                 return x;
@@ -44,7 +44,9 @@ namespace BlackMisc
             enum EntryType
             {
                 Found,
-                Missing
+                Missing,
+                CacheHit,  //!< matching result taken from the result cache
+                CacheMiss  //!< matching result not yet cached
             };
 
             //! Default constructor.
@@ -98,6 +100,9 @@ namespace BlackMisc
             //! Count increased by one
             void increaseCount();
 
+            //! Set the count
+            void setCount(int count) { m_count = count; }
+
             //! Matches given value?
             bool matches(EntryType type, const QString &sessionId, const QString &aircraftDesignator, const QString &airlineDesignator) const;
 
@@ -0,0 +1,243 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/modelsetchanges.h"
+
+#include <QHash>
+#include <QSet>
+#include <QVector>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        CModelSetChanges CModelSetChanges::diff(const CAircraftModelList &oldSet, const CAircraftModelList &newSet)
+        {
+            // model strings must be unique to identify the models
+            QHash<QString, int> oldIds;
+            oldIds.reserve(oldSet.sizeInt());
+            for (int id = 0; id < oldSet.sizeInt(); id++)
+            {
+                const QString key = oldSet[id].getModelString().toUpper();
+                if (oldIds.contains(key)) { return replacement(newSet); }
+                oldIds.insert(key, id);
+            }
+
+            QSet<QString> newKeys;
+            newKeys.reserve(newSet.sizeInt());
+            for (const CAircraftModel &model : newSet)
+            {
+                const QString key = model.getModelString().toUpper();
+                if (newKeys.contains(key)) { return replacement(newSet); }
+                newKeys.insert(key);
+            }
+
+            CModelSetChanges changes;
+            QVector<bool> kept(oldSet.sizeInt(), false);
+            for (int id = 0; id < oldSet.sizeInt(); id++)
+            {
+                const CAircraftModel &model = oldSet[id];
+                kept[id] = newKeys.contains(model.getModelString().toUpper());
+                if (!kept.at(id)) { changes.m_removed.push_back(model.getModelString()); }
+            }
+
+            // the kept models must be in the same order, followed by the added models
+            int next = 0;
+            for (const CAircraftModel &model : newSet)
+            {
+                const auto it = oldIds.constFind(model.getModelString().toUpper());
+                if (it == oldIds.constEnd())
+                {
+                    changes.m_added.push_back(model);
+                    continue;
+                }
+                if (!changes.m_added.isEmpty()) { return replacement(newSet); }
+
+                while (next < kept.size() && !kept.at(next)) { next++; }
+                if (it.value() != next) { return replacement(newSet); }
+                next++;
+
+                if (!isSameModel(oldSet[it.value()], model)) { changes.m_updated.push_back(model); }
+            }
+            return changes;
+        }
+
+        CModelSetChanges CModelSetChanges::replacement(const CAircraftModelList &models)
+        {
+            CModelSetChanges changes;
+            changes.m_added = models;
+            changes.m_replacement = true;
+            return changes;
+        }
+
+        bool CModelSetChanges::isSameModel(const CAircraftModel &model1, const CAircraftModel &model2)
+        {
+            return model1 == model2 &&
+                   model1.getModelString() == model2.getModelString() &&
+                   model1.getModelStringAlias() == model2.getModelStringAlias() &&
+                   model1.getDescription() == model2.getDescription() &&
+                   model1.getFileName() == model2.getFileName() &&
+                   model1.getIconFile() == model2.getIconFile() &&
+                   model1.getFileTimestamp() == model2.getFileTimestamp();
+        }
+
+        void CModelSetChanges::addModel(const CAircraftModel &model)
+        {
+            if (m_replacement) { m_added.replaceOrAddModelWithString(model, Qt::CaseInsensitive); return; }
+            m_added.push_back(model);
+        }
+
+        void CModelSetChanges::updateModel(const CAircraftModel &model)
+        {
+            CModelSetChanges changes;
+            changes.m_updated.push_back(model);
+            this->append(changes);
+        }
+
+        void CModelSetChanges::removeModel(const QString &modelString)
+        {
+            CModelSetChanges changes;
+            changes.m_removed.push_back(modelString);
+            this->append(changes);
+        }
+
+        void CModelSetChanges::applyTo(CAircraftModelList &models) const
+        {
+            if (m_replacement)
+            {
+                models = m_added;
+                return;
+            }
+
+            if (!m_removed.isEmpty()) { models.removeModelsWithString(m_removed, Qt::CaseInsensitive); }
+            if (!m_updated.isEmpty())
+            {
+                QHash<QString, int> ids;
+                ids.reserve(models.sizeInt());
+                for (int id = models.sizeInt() - 1; id >= 0; id--)
+                {
+                    ids.insert(models[id].getModelString().toUpper(), id);
+                }
+                for (const CAircraftModel &model : m_updated)
+                {
+                    const int id = ids.value(model.getModelString().toUpper(), -1);
+                    if (id >= 0) { models[id] = model; }
+                    else { models.push_back(model); }
+                }
+            }
+            models.push_back(m_added);
+        }
+
+        void CModelSetChanges::append(const CModelSetChanges &later)
+        {
+            if (later.m_replacement)
+            {
+                *this = later;
+                return;
+            }
+            if (m_replacement)
+            {
+                later.applyTo(m_added);
+                if (later.m_revision >= 0) { m_revision = later.m_revision; }
+                return;
+            }
+
+            for (const QString &modelString : later.m_removed)
+            {
+                const int addedIndex = indexOf(m_added, modelString);
+                if (addedIndex >= 0)
+                {
+                    // not in the set before these changes, or already in the removed models
+                    m_added.erase(m_added.begin() + addedIndex);
+                    continue;
+                }
+                const int updatedIndex = indexOf(m_updated, modelString);
+                if (updatedIndex >= 0) { m_updated.erase(m_updated.begin() + updatedIndex); }
+                if (indexOf(m_removed, modelString) < 0) { m_removed.push_back(modelString); }
+            }
+
+            for (const CAircraftModel &model : later.m_updated)
+            {
+                const int addedIndex = indexOf(m_added, model.getModelString());
+                if (addedIndex >= 0)
+                {
+                    m_added[addedIndex] = model;
+                    continue;
+                }
+                const int updatedIndex = indexOf(m_updated, model.getModelString());
+                if (updatedIndex >= 0) { m_updated[updatedIndex] = model; }
+                else { m_updated.push_back(model); }
+            }
+
+            m_added.push_back(later.m_added);
+            if (later.m_revision >= 0) { m_revision = later.m_revision; }
+        }
+
+        QString CModelSetChanges::toQString() const
+        {
+            if (m_replacement)
+            {
+                static const QString r("replacement by %1 models, revision %2");
+                return r.arg(m_added.size()).arg(m_revision);
+            }
+            static const QString c("added: %1 updated: %2 removed: %3, revision %4");
+            return c.arg(m_added.size()).arg(m_updated.size()).arg(m_removed.size()).arg(m_revision);
+        }
+
+        int CModelSetChanges::indexOf(const CAircraftModelList &models, const QString &modelString)
+        {
+            for (int i = 0; i < models.sizeInt(); i++)
+            {
+                if (models[i].getModelString().compare(modelString, Qt::CaseInsensitive) == 0) { return i; }
+            }
+            return -1;
+        }
+
+        int CModelSetChanges::indexOf(const QStringList &modelStrings, const QString &modelString)
+        {
+            for (int i = 0; i < modelStrings.size(); i++)
+            {
+                if (modelStrings.at(i).compare(modelString, Qt::CaseInsensitive) == 0) { return i; }
+            }
+            return -1;
+        }
+
+        int CModelSetJournal::record(const CModelSetChanges &changes)
+        {
+            CModelSetChanges recorded(changes);
+            recorded.setRevision(++m_revision);
+            m_changes.push_back(recorded);
+            while (m_changes.size() > MaxChanges)
+            {
+                m_baseRevision = m_changes.front().getRevision();
+                m_changes.pop_front();
+            }
+            return m_revision;
+        }
+
+        int CModelSetJournal::reset()
+        {
+            m_baseRevision = ++m_revision;
+            m_changes.clear();
+            return m_revision;
+        }
+
+        bool CModelSetJournal::changesSince(int revision, CModelSetChanges &changes) const
+        {
+            if (revision < m_baseRevision || revision > m_revision) { return false; }
+            CModelSetChanges combined;
+            for (const CModelSetChanges &c : m_changes)
+            {
+                if (c.getRevision() > revision) { combined.append(c); }
+            }
+            combined.setRevision(m_revision);
+            changes = combined;
+            return true;
+        }
+    } // namespace
+} // namespace
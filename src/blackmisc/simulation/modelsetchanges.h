@@ -0,0 +1,135 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_MODELSETCHANGES_H
+#define BLACKMISC_SIMULATION_MODELSETCHANGES_H
+
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        //! Changes between two versions of a model set
+        //! \details Models are identified by their model string (case insensitive). Applying the changes removes the
+        //!          removed models, replaces the updated models in place and appends the added models.
+        //!          If the new set cannot be expressed like this (e.g. models were re-ordered), the changes are a replacement
+        //!          of the whole set.
+        class BLACKMISC_EXPORT CModelSetChanges
+        {
+        public:
+            //! Default ctor, no changes
+            CModelSetChanges() {}
+
+            //! Changes turning oldSet into newSet
+            static CModelSetChanges diff(const CAircraftModelList &oldSet, const CAircraftModelList &newSet);
+
+            //! Replacement of the whole set
+            static CModelSetChanges replacement(const CAircraftModelList &models);
+
+            //! Same model, including the attributes not used for comparison?
+            static bool isSameModel(const CAircraftModel &model1, const CAircraftModel &model2);
+
+            //! Add a model
+            void addModel(const CAircraftModel &model);
+
+            //! Update a model
+            void updateModel(const CAircraftModel &model);
+
+            //! Remove a model
+            void removeModel(const QString &modelString);
+
+            //! Added models, in the order they are appended
+            const CAircraftModelList &getAdded() const { return m_added; }
+
+            //! Updated models
+            const CAircraftModelList &getUpdated() const { return m_updated; }
+
+            //! Model strings of the removed models
+            const QStringList &getRemoved() const { return m_removed; }
+
+            //! Whole set replaced?
+            //! \remark the new set is getAdded()
+            bool isReplacement() const { return m_replacement; }
+
+            //! No changes?
+            bool isEmpty() const { return !m_replacement && m_added.isEmpty() && m_updated.isEmpty() && m_removed.isEmpty(); }
+
+            //! Number of changed models
+            int size() const { return m_added.sizeInt() + m_updated.sizeInt() + m_removed.size(); }
+
+            //! Revision of the set after the changes, -1 if not recorded in a journal
+            int getRevision() const { return m_revision; }
+
+            //! Set the revision
+            void setRevision(int revision) { m_revision = revision; }
+
+            //! Apply to a set
+            void applyTo(CAircraftModelList &models) const;
+
+            //! Combine with changes applied after these changes
+            void append(const CModelSetChanges &later);
+
+            //! Info string
+            QString toQString() const;
+
+        private:
+            //! Index of model in list, -1 if not found
+            static int indexOf(const CAircraftModelList &models, const QString &modelString);
+
+            //! Index of model string in list, -1 if not found
+            static int indexOf(const QStringList &modelStrings, const QString &modelString);
+
+            CAircraftModelList m_added;
+            CAircraftModelList m_updated;
+            QStringList        m_removed;
+            bool               m_replacement = false;
+            int                m_revision = -1;
+        };
+
+        //! Recent changes of a model set
+        //! \details Every recorded change increases the revision. A consumer remembering the revision of its
+        //!          copy of the set gets the changes since then, or needs to reload the whole set if the
+        //!          journal does not go back that far.
+        class BLACKMISC_EXPORT CModelSetJournal
+        {
+        public:
+            //! Max. number of changes kept
+            static constexpr int MaxChanges = 100;
+
+            //! Current revision
+            int getRevision() const { return m_revision; }
+
+            //! Record changes
+            //! \return new revision
+            int record(const CModelSetChanges &changes);
+
+            //! The set was replaced by other means, all older revisions need a full reload
+            //! \return new revision
+            int reset();
+
+            //! Combined changes since revision
+            //! \return false if not available, the whole set needs to be reloaded
+            bool changesSince(int revision, CModelSetChanges &changes) const;
+
+        private:
+            int m_revision = 0;     //!< current revision
+            int m_baseRevision = 0; //!< the changes go back to this revision
+            QList<CModelSetChanges> m_changes;
+        };
+    } // namespace
+} // namespace
+
+#endif // guard
@@ -14,6 +14,9 @@
 #include "blackmisc/stringutils.h"
 #include "blackconfig/buildconfig.h"
 
+#include <QMutexLocker>
+#include <QPointer>
+
 using namespace BlackMisc::Aviation;
 using namespace BlackMisc::PhysicalQuantities;
 using namespace BlackMisc::Geo;
@@ -24,6 +27,8 @@ namespace BlackMisc
 {
     namespace Simulation
     {
+        static_assert(CSituationHistoryStore::MaxSituations == IRemoteAircraftProvider::MaxSituationsPerCallsign, "Situation history store needs to keep all situations");
+
         IRemoteAircraftProvider::IRemoteAircraftProvider()
         { }
 
@@ -114,6 +119,16 @@ namespace BlackMisc
             return m_situationsByCallsign[callsign].size();
         }
 
+        int CRemoteAircraftProvider::remoteAircraftSituationHistoryId(const CCallsign &callsign) const
+        {
+            return m_situationHistory.callsignId(callsign);
+        }
+
+        bool CRemoteAircraftProvider::remoteAircraftSituationHistory(int callsignId, CCompactSituationHistory &history) const
+        {
+            return m_situationHistory.snapshot(callsignId, history);
+        }
+
         CAircraftPartsList CRemoteAircraftProvider::remoteAircraftParts(const CCallsign &callsign) const
         {
             static const CAircraftPartsList empty;
@@ -180,6 +195,7 @@ namespace BlackMisc
             {
                 QWriteLocker l(&m_lockSituations);
                 m_situationsByCallsign.clear();
+                m_situationHistory.clear();
                 m_latestSituationByCallsign.clear();
                 m_latestOnGroundProviderElevation.clear();
                 m_situationsAdded = 0;
@@ -198,6 +214,7 @@ namespace BlackMisc
                 m_aircraftInRange.clear();
                 m_dbCGPerCallsign.clear();
             }
+            this->remoteAircraftModified();
 
             for (const CCallsign &cs : callsigns)
             {
@@ -220,6 +237,7 @@ namespace BlackMisc
                 QWriteLocker l(&m_lockAircraft);
                 m_aircraftInRange.insert(aircraft.getCallsign(), aircraft);
             }
+            this->remoteAircraftModified();
             emit this->addedAircraft(aircraft);
             emit this->changedAircraftInRange();
             return true;
@@ -236,6 +254,7 @@ namespace BlackMisc
             }
             if (c > 0)
             {
+                this->remoteAircraftModified();
                 emit this->changedAircraftInRange();
             }
             return c;
@@ -252,6 +271,7 @@ namespace BlackMisc
                 if (!bearing.isNull())  { aircraft.setRelativeBearing(bearing); }
                 if (!distance.isNull()) { aircraft.setRelativeDistance(distance); }
             }
+            this->remoteAircraftModified();
             return true;
         }
 
@@ -283,7 +303,7 @@ namespace BlackMisc
                 const qint64 now = QDateTime::currentMSecsSinceEpoch();
                 QWriteLocker lock(&m_lockSituations);
                 m_situationsAdded++;
-                m_situationsLastModified[cs] = now;
+                setLastModified(m_situationsLastModified, cs, now);
                 CAircraftSituationList &newSituationsList = m_situationsByCallsign[cs];
                 newSituationsList.setAdjustedSortHint(CAircraftSituationList::AdjustedTimestampLatestFirst);
                 const int situations = newSituationsList.size();
@@ -323,6 +343,7 @@ namespace BlackMisc
                     simpleChange.guessOnGround(newSituationsList.front(), aircraftModel);
                 }
                 updatedSituations = m_situationsByCallsign[cs];
+                m_situationHistory.store(cs, updatedSituations);
 
             } // lock
 
@@ -338,10 +359,13 @@ namespace BlackMisc
 
                 QWriteLocker lock(&m_lockSituations);
                 m_latestSituationByCallsign[cs].setSceneryOffset(offset);
-                m_situationsByCallsign[cs].front().setSceneryOffset(offset);
+                CAircraftSituationList &situations = m_situationsByCallsign[cs];
+                situations.front().setSceneryOffset(offset);
+                m_situationHistory.store(cs, situations);
             }
 
             // situation has been added
+            this->remoteAircraftModified();
             emit this->addedAircraftSituation(situationCorrected);
 
             // bye
@@ -359,7 +383,7 @@ namespace BlackMisc
             {
                 QWriteLocker lock(&m_lockParts);
                 m_partsAdded++;
-                m_partsLastModified[callsign] = ts;
+                setLastModified(m_partsLastModified, callsign, ts);
                 CAircraftPartsList &partsList = m_partsByCallsign[callsign];
                 partsList.push_frontKeepLatestFirstAdjustOffset(parts, true, IRemoteAircraftProvider::MaxPartsPerCallsign);
                 partsList.setAdjustedSortHint(CAircraftPartsList::AdjustedTimestampLatestFirst);
@@ -379,7 +403,11 @@ namespace BlackMisc
                 QWriteLocker lock(&m_lockSituations);
                 CAircraftSituationList &situationList = m_situationsByCallsign[callsign];
                 const int c = situationList.adjustGroundFlag(parts);
-                if (c > 0) { m_situationsLastModified[callsign] = ts; }
+                if (c > 0)
+                {
+                    setLastModified(m_situationsLastModified, callsign, ts);
+                    m_situationHistory.store(callsign, situationList);
+                }
             }
 
             // update aircraft
@@ -400,6 +428,7 @@ namespace BlackMisc
                 m_aircraftWithParts.insert(callsign); // mark as callsign which supports parts
             }
 
+            this->remoteAircraftModified();
             emit this->addedAircraftParts(callsign, parts);
         }
 
@@ -516,7 +545,9 @@ namespace BlackMisc
         {
             QWriteLocker l(&m_lockAircraft);
             if (!m_aircraftInRange.contains(callsign)) { return false; }
-            return m_aircraftInRange[callsign].setEnabled(enabledForRendering);
+            const bool changed = m_aircraftInRange[callsign].setEnabled(enabledForRendering);
+            if (changed) { this->remoteAircraftModified(); }
+            return changed;
         }
 
         int CRemoteAircraftProvider::updateMultipleAircraftEnabled(const CCallsignSet &callsigns, bool enabledForRendering)
@@ -529,6 +560,7 @@ namespace BlackMisc
                 if (!m_aircraftInRange.contains(cs)) { continue; }
                 if (m_aircraftInRange[cs].setEnabled(enabledForRendering)) { c++; }
             }
+            if (c > 0) { this->remoteAircraftModified(); }
             return c;
         }
 
@@ -552,14 +584,18 @@ namespace BlackMisc
         {
             QWriteLocker l(&m_lockAircraft);
             if (!m_aircraftInRange.contains(callsign)) { return false; }
-            return m_aircraftInRange[callsign].setFastPositionUpdates(enableFastPositonUpdates);
+            const bool changed = m_aircraftInRange[callsign].setFastPositionUpdates(enableFastPositonUpdates);
+            if (changed) { this->remoteAircraftModified(); }
+            return changed;
         }
 
         bool CRemoteAircraftProvider::updateAircraftRendered(const CCallsign &callsign, bool rendered)
         {
             QWriteLocker l(&m_lockAircraft);
             if (!m_aircraftInRange.contains(callsign)) { return false; }
-            return m_aircraftInRange[callsign].setRendered(rendered);
+            const bool changed = m_aircraftInRange[callsign].setRendered(rendered);
+            if (changed) { this->remoteAircraftModified(); }
+            return changed;
         }
 
         int CRemoteAircraftProvider::updateMultipleAircraftRendered(const CCallsignSet &callsigns, bool rendered)
@@ -571,6 +607,7 @@ namespace BlackMisc
                 if (!m_aircraftInRange.contains(cs)) { continue; }
                 if (m_aircraftInRange[cs].setRendered(rendered)) { c++; }
             }
+            if (c > 0) { this->remoteAircraftModified(); }
             return c;
         }
 
@@ -591,7 +628,8 @@ namespace BlackMisc
                 if (situations.isEmpty()) { return 0; }
                 updated = setGroundElevationCheckedAndGuessGround(situations, elevation, info, model, &change, &setForOnGndPosition);
                 if (updated < 1) { return 0; }
-                m_situationsLastModified[callsign] = now;
+                setLastModified(m_situationsLastModified, callsign, now);
+                m_situationHistory.store(callsign, situations);
                 const CAircraftSituation latestSituation = situations.front();
                 if (info == CAircraftSituation::FromProvider && latestSituation.isOnGround())
                 {
@@ -611,6 +649,7 @@ namespace BlackMisc
             {
                 m_aircraftInRange[callsign].setGroundElevationChecked(elevation, info);
             }
+            this->remoteAircraftModified();
 
             if (setForOnGroundPosition) { *setForOnGroundPosition = setForOnGndPosition; }
             return updated; // updated situations
@@ -621,6 +660,7 @@ namespace BlackMisc
             QWriteLocker l(&m_lockAircraft);
             if (!m_aircraftInRange.contains(callsign)) { return false; }
             m_aircraftInRange[callsign].setCG(cg);
+            this->remoteAircraftModified();
             return true;
         }
 
@@ -631,6 +671,7 @@ namespace BlackMisc
             CSimulatedAircraft &aircraft = m_aircraftInRange[callsign];
             if (!cg.isNull()) { aircraft.setCG(cg); }
             if (!modelString.isEmpty()) { aircraft.setModelString(modelString); }
+            this->remoteAircraftModified();
             return true;
         }
 
@@ -648,6 +689,7 @@ namespace BlackMisc
                     callsigns.push_back(aircraft.getCallsign());
                 }
             }
+            if (!callsigns.isEmpty()) { this->remoteAircraftModified(); }
             return callsigns;
         }
 
@@ -683,6 +725,7 @@ namespace BlackMisc
             {
                 m_aircraftInRange[cs].setRendered(false);
             }
+            this->remoteAircraftModified();
         }
 
         void CRemoteAircraftProvider::enableReverseLookupMessages(ReverseLookupLogging enable)
@@ -841,6 +884,12 @@ namespace BlackMisc
             return m_situationsAdded;
         }
 
+        void CRemoteAircraftProvider::setLastModified(CTimestampPerCallsign &lastModified, const CCallsign &callsign, qint64 now)
+        {
+            qint64 &ts = lastModified[callsign];
+            ts = qMax(now, ts + 1);
+        }
+
         qint64 CRemoteAircraftProvider::situationsLastModified(const CCallsign &callsign) const
         {
             QReadLocker l(&m_lockSituations);
@@ -926,6 +975,7 @@ namespace BlackMisc
             {
                 QWriteLocker l2(&m_lockSituations);
                 m_situationsByCallsign.remove(callsign);
+                m_situationHistory.remove(callsign);
                 m_latestSituationByCallsign.remove(callsign);
                 m_latestOnGroundProviderElevation.remove(callsign);
                 m_situationsLastModified.remove(callsign);
@@ -938,9 +988,67 @@ namespace BlackMisc
                 const int c = m_aircraftInRange.remove(callsign);
                 removedCallsign = c > 0;
             }
+            this->remoteAircraftModified();
             return removedCallsign;
         }
 
+        CRemoteAircraftSnapshotPtr CRemoteAircraftProvider::getRemoteAircraftSnapshot() const
+        {
+            return std::atomic_load(&m_snapshot);
+        }
+
+        void CRemoteAircraftProvider::publishRemoteAircraftSnapshot()
+        {
+            // the data copied below is at least as new as this version
+            const qint64 version = m_snapshotVersion;
+
+            QMutexLocker publishLock(&m_lockSnapshotPublish);
+            const CRemoteAircraftSnapshotPtr current = std::atomic_load(&m_snapshot);
+            if (current && current->getVersion() >= version) { return; }
+
+            // implicitly shared copies, the writers detach on their next modification
+            CSimulatedAircraftPerCallsign aircraft;
+            CAircraftSituationListPerCallsign situations;
+            CTimestampPerCallsign situationsLastModified;
+            CSituationHistories situationHistories;
+            CAircraftPartsListPerCallsign parts;
+            CTimestampPerCallsign partsLastModified;
+            {
+                QReadLocker l(&m_lockAircraft);
+                aircraft = m_aircraftInRange;
+            }
+            {
+                QReadLocker l(&m_lockSituations);
+                situations = m_situationsByCallsign;
+                situationsLastModified = m_situationsLastModified;
+                situationHistories = m_situationHistory.histories();
+            }
+            {
+                QReadLocker l(&m_lockParts);
+                parts = m_partsByCallsign;
+                partsLastModified = m_partsLastModified;
+            }
+
+            const CRemoteAircraftSnapshotPtr snapshot = std::make_shared<const CRemoteAircraftSnapshot>(version, aircraft, situations, situationsLastModified, situationHistories, parts, partsLastModified);
+            std::atomic_store(&m_snapshot, snapshot);
+        }
+
+        void CRemoteAircraftProvider::remoteAircraftModified()
+        {
+            m_snapshotVersion++;
+
+            // one publish per batch of modifications, i.e. per event loop cycle of the provider
+            // explicit publishes do not reset the flag, so at most one event is queued at any time
+            if (m_snapshotPublishScheduled.exchange(true)) { return; }
+            QPointer<CRemoteAircraftProvider> myself(this);
+            QMetaObject::invokeMethod(this, [ = ]
+            {
+                if (!myself) { return; }
+                myself->m_snapshotPublishScheduled = false; // modifications from now on need another publish
+                myself->publishRemoteAircraftSnapshot();
+            }, Qt::QueuedConnection);
+        }
+
         CRemoteAircraftAware::~CRemoteAircraftAware()
         { }
 
@@ -1046,6 +1154,24 @@ namespace BlackMisc
             return this->provider()->remoteAircraftSituationsCount(callsign);
         }
 
+        CRemoteAircraftSnapshotPtr CRemoteAircraftAware::getRemoteAircraftSnapshot() const
+        {
+            Q_ASSERT_X(this->provider(), Q_FUNC_INFO, "No object available");
+            return this->provider()->getRemoteAircraftSnapshot();
+        }
+
+        int CRemoteAircraftAware::remoteAircraftSituationHistoryId(const CCallsign &callsign) const
+        {
+            Q_ASSERT_X(this->provider(), Q_FUNC_INFO, "No object available");
+            return this->provider()->remoteAircraftSituationHistoryId(callsign);
+        }
+
+        bool CRemoteAircraftAware::remoteAircraftSituationHistory(int callsignId, CCompactSituationHistory &history) const
+        {
+            Q_ASSERT_X(this->provider(), Q_FUNC_INFO, "No object available");
+            return this->provider()->remoteAircraftSituationHistory(callsignId, history);
+        }
+
         bool CRemoteAircraftAware::updateAircraftModel(const Aviation::CCallsign &callsign, const CAircraftModel &model, const CIdentifier &originator)
         {
             Q_ASSERT_X(this->provider(), Q_FUNC_INFO, "No object available");
@@ -13,8 +13,10 @@
 
 #include "blackmisc/simulation/aircraftmodel.h"
 #include "blackmisc/simulation/airspaceaircraftsnapshot.h"
+#include "blackmisc/simulation/remoteaircraftsnapshot.h"
 #include "blackmisc/simulation/reverselookup.h"
 #include "blackmisc/simulation/simulatedaircraftlist.h"
+#include "blackmisc/simulation/situationhistorystore.h"
 #include "blackmisc/aviation/aircraftpartslist.h"
 #include "blackmisc/aviation/aircraftsituationlist.h"
 #include "blackmisc/aviation/aircraftsituationchangelist.h"
@@ -31,6 +33,8 @@
 #include <QJsonObject>
 #include <QtGlobal>
 #include <QReadWriteLock>
+#include <QMutex>
+#include <atomic>
 #include <functional>
 
 namespace BlackMisc
@@ -118,6 +122,23 @@ namespace BlackMisc
             //! \threadsafe
             virtual int remoteAircraftSituationsCount(const Aviation::CCallsign &callsign) const = 0;
 
+            //! Id for the compact situation history, stable as long as the aircraft is in range
+            //! \return -1 if there are no situations for the callsign
+            //! \threadsafe
+            virtual int remoteAircraftSituationHistoryId(const Aviation::CCallsign &callsign) const = 0;
+
+            //! Compact situation history (latest first) without any heap allocation
+            //! \remark for the interpolators, avoids copying the full situation list
+            //! \return false if there are no situations for the id
+            //! \threadsafe
+            virtual bool remoteAircraftSituationHistory(int callsignId, CCompactSituationHistory &history) const = 0;
+
+            //! Immutable snapshot of aircraft in range, situations and parts
+            //! \remark lock free, meant for loops running at simulator frame rate
+            //! \remark published after a batch of modifications, so it can lag behind the other getters by one batch
+            //! \threadsafe
+            virtual CRemoteAircraftSnapshotPtr getRemoteAircraftSnapshot() const = 0;
+
             //! All parts (per callsign, time history)
             //! \remark latest parts first
             //! \threadsafe
@@ -319,6 +340,9 @@ namespace BlackMisc
             virtual Aviation::CAircraftSituationList latestRemoteAircraftSituations() const override;
             virtual Aviation::CAircraftSituationList latestOnGroundProviderElevations() const override;
             virtual int remoteAircraftSituationsCount(const Aviation::CCallsign &callsign) const override;
+            virtual int remoteAircraftSituationHistoryId(const Aviation::CCallsign &callsign) const override;
+            virtual bool remoteAircraftSituationHistory(int callsignId, CCompactSituationHistory &history) const override;
+            virtual CRemoteAircraftSnapshotPtr getRemoteAircraftSnapshot() const override;
             virtual Aviation::CAircraftPartsList remoteAircraftParts(const Aviation::CCallsign &callsign) const override;
             virtual int remoteAircraftPartsCount(const Aviation::CCallsign &callsign) const override;
             virtual bool isRemoteAircraftSupportingParts(const Aviation::CCallsign &callsign) const override;
@@ -385,6 +409,12 @@ namespace BlackMisc
             //! Clear all data
             void clear();
 
+            //! Publish a new snapshot of the current data
+            //! \remark done automatically once per batch of modifications, see getRemoteAircraftSnapshot
+            //! \remark an explicit publish does not schedule another one, the pending scheduled publish is kept
+            //! \threadsafe
+            void publishRemoteAircraftSnapshot();
+
             // ------------------- testing ---------------
 
             //! Has test offset value?
@@ -483,7 +513,16 @@ namespace BlackMisc
             //! \threadsafe
             void storeChange(const Aviation::CAircraftSituationChange &change);
 
+            //! Data for the snapshot have been modified, schedules a publish
+            //! \threadsafe
+            void remoteAircraftModified();
+
+            //! Set the modification timestamp of a callsign
+            //! \remark strictly increasing, so a reader notices 2 modifications within the same ms
+            static void setLastModified(Aviation::CTimestampPerCallsign &lastModified, const Aviation::CCallsign &callsign, qint64 now);
+
             Aviation::CAircraftSituationListPerCallsign m_situationsByCallsign;        //!< situations, for performance reasons per callsign, thread safe access required
+            CSituationHistoryStore m_situationHistory;                                 //!< compact copy of m_situationsByCallsign, own lock
             Aviation::CAircraftSituationPerCallsign m_latestSituationByCallsign;       //!< latest situations, for performance reasons per callsign, thread safe access required
             Aviation::CAircraftSituationPerCallsign m_latestOnGroundProviderElevation; //!< situations on ground with elevation from provider
             Aviation::CAircraftPartsListPerCallsign m_partsByCallsign;                 //!< parts, for performance reasons per callsign, thread safe access required
@@ -504,6 +543,11 @@ namespace BlackMisc
 
             bool m_enableAircraftPartsHistory = true;  //!< shall we keep a history of aircraft parts
 
+            // snapshot, only accessed via std::atomic_load/atomic_store
+            CRemoteAircraftSnapshotPtr m_snapshot = CRemoteAircraftSnapshot::empty(); //!< latest published snapshot
+            std::atomic<qint64> m_snapshotVersion { 0 };       //!< incremented with every modification
+            std::atomic_bool m_snapshotPublishScheduled { false }; //!< publish pending
+
             // locks
             mutable QReadWriteLock m_lockSituations;   //!< lock for situations: m_situationsByCallsign
             mutable QReadWriteLock m_lockParts;        //!< lock for parts: m_partsByCallsign, m_aircraftSupportingParts
@@ -511,6 +555,7 @@ namespace BlackMisc
             mutable QReadWriteLock m_lockAircraft;     //!< lock aircraft: m_aircraftInRange, m_dbCGPerCallsign
             mutable QReadWriteLock m_lockMessages;     //!< lock for messages
             mutable QReadWriteLock m_lockPartsHistory; //!< lock for aircraft parts
+            QMutex m_lockSnapshotPublish;              //!< serializes publishers, never taken by readers
         };
 
         //! Class which can be directly used to access an \sa IRemoteAircraftProvider object
@@ -559,6 +604,15 @@ namespace BlackMisc
             //! \copydoc IRemoteAircraftProvider::remoteAircraftSituationsCount
             int remoteAircraftSituationsCount(const Aviation::CCallsign &callsign) const;
 
+            //! \copydoc IRemoteAircraftProvider::remoteAircraftSituationHistoryId
+            int remoteAircraftSituationHistoryId(const Aviation::CCallsign &callsign) const;
+
+            //! \copydoc IRemoteAircraftProvider::remoteAircraftSituationHistory
+            bool remoteAircraftSituationHistory(int callsignId, CCompactSituationHistory &history) const;
+
+            //! \copydoc IRemoteAircraftProvider::getRemoteAircraftSnapshot
+            CRemoteAircraftSnapshotPtr getRemoteAircraftSnapshot() const;
+
             //! \copydoc IRemoteAircraftProvider::remoteAircraftParts
             Aviation::CAircraftPartsList remoteAircraftParts(const Aviation::CCallsign &callsign) const;
 
@@ -29,6 +29,7 @@ namespace BlackMisc
         void CRemoteAircraftProviderDummy::insertNewSituation(const CAircraftSituation &situation)
         {
             this->storeAircraftSituation(situation);
+            this->publishRemoteAircraftSnapshot();
         }
 
         void CRemoteAircraftProviderDummy::insertNewSituations(const CAircraftSituationList &situations)
@@ -37,11 +38,13 @@ namespace BlackMisc
             {
                 this->storeAircraftSituation(situation);
             }
+            this->publishRemoteAircraftSnapshot();
         }
 
         void CRemoteAircraftProviderDummy::insertNewAircraftParts(const CCallsign &callsign, const CAircraftParts &parts, bool removeOutdatedParts)
         {
             this->storeAircraftParts(callsign, parts, removeOutdatedParts);
+            this->publishRemoteAircraftSnapshot();
         }
 
         void CRemoteAircraftProviderDummy::insertNewAircraftParts(const CCallsign &callsign, const CAircraftPartsList &partsList, bool removeOutdatedParts)
@@ -50,6 +53,7 @@ namespace BlackMisc
             {
                 this->storeAircraftParts(callsign, parts, removeOutdatedParts);
             }
+            this->publishRemoteAircraftSnapshot();
         }
 
         CAirspaceAircraftSnapshot CRemoteAircraftProviderDummy::getLatestAirspaceAircraftSnapshot() const
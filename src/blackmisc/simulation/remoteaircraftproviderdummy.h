@@ -35,7 +35,7 @@ namespace BlackMisc
             //! Constructor
             CRemoteAircraftProviderDummy(QObject *parent = nullptr);
 
-            //! For testing, add new situation and fire signals
+            //! For testing, add new situation, fire signals and publish the snapshot immediately
             //! @{
             void insertNewSituation(const Aviation::CAircraftSituation &situation);
             void insertNewSituations(const Aviation::CAircraftSituationList &situations);
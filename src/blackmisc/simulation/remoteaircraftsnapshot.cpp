@@ -0,0 +1,42 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/remoteaircraftsnapshot.h"
+
+using namespace BlackMisc::Aviation;
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        CRemoteAircraftSnapshot::CRemoteAircraftSnapshot(
+            qint64 version,
+            const CSimulatedAircraftPerCallsign &aircraft,
+            const CAircraftSituationListPerCallsign &situations,
+            const CTimestampPerCallsign &situationsLastModified,
+            const CSituationHistories &situationHistories,
+            const CAircraftPartsListPerCallsign &parts,
+            const CTimestampPerCallsign &partsLastModified) :
+            m_version(version), m_aircraft(aircraft),
+            m_situations(situations), m_situationsLastModified(situationsLastModified),
+            m_situationHistories(situationHistories),
+            m_parts(parts), m_partsLastModified(partsLastModified)
+        { }
+
+        const std::shared_ptr<const CRemoteAircraftSnapshot> &CRemoteAircraftSnapshot::empty()
+        {
+            static const std::shared_ptr<const CRemoteAircraftSnapshot> snapshot = std::make_shared<const CRemoteAircraftSnapshot>();
+            return snapshot;
+        }
+
+        CSimulatedAircraftList CRemoteAircraftSnapshot::getAircraftInRange() const
+        {
+            return CSimulatedAircraftList(m_aircraft.values());
+        }
+    } // namespace
+} // namespace
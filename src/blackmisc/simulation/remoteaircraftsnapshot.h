@@ -0,0 +1,102 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_REMOTEAIRCRAFTSNAPSHOT_H
+#define BLACKMISC_SIMULATION_REMOTEAIRCRAFTSNAPSHOT_H
+
+#include "blackmisc/simulation/simulatedaircraftlist.h"
+#include "blackmisc/simulation/situationhistorystore.h"
+#include "blackmisc/aviation/aircraftpartslist.h"
+#include "blackmisc/aviation/aircraftsituationlist.h"
+#include "blackmisc/aviation/percallsign.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QtGlobal>
+#include <memory>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        //! Immutable, versioned copy of the remote aircraft data (aircraft in range, situations, parts)
+        //! \remark published as a whole by CRemoteAircraftProvider, readers hold a shared pointer and never lock
+        //! \remark the containers are implicitly shared with the provider, creating a snapshot does not copy the data
+        class BLACKMISC_EXPORT CRemoteAircraftSnapshot
+        {
+        public:
+            //! Empty snapshot
+            CRemoteAircraftSnapshot() = default;
+
+            //! Ctor
+            CRemoteAircraftSnapshot(qint64 version,
+                                    const CSimulatedAircraftPerCallsign &aircraft,
+                                    const Aviation::CAircraftSituationListPerCallsign &situations,
+                                    const Aviation::CTimestampPerCallsign &situationsLastModified,
+                                    const CSituationHistories &situationHistories,
+                                    const Aviation::CAircraftPartsListPerCallsign &parts,
+                                    const Aviation::CTimestampPerCallsign &partsLastModified);
+
+            //! Shared empty snapshot, used as default before anything is published
+            static const std::shared_ptr<const CRemoteAircraftSnapshot> &empty();
+
+            //! Version, increasing with every modification of the provider's data
+            qint64 getVersion() const { return m_version; }
+
+            //! Number of aircraft in range
+            int getAircraftInRangeCount() const { return m_aircraft.size(); }
+
+            //! Is aircraft in range?
+            bool isAircraftInRange(const Aviation::CCallsign &callsign) const { return m_aircraft.contains(callsign); }
+
+            //! Aircraft in range
+            CSimulatedAircraftList getAircraftInRange() const;
+
+            //! Aircraft for callsign, default aircraft if not in range
+            CSimulatedAircraft getAircraftInRangeForCallsign(const Aviation::CCallsign &callsign) const { return m_aircraft.value(callsign); }
+
+            //! Situations for callsign, latest first
+            Aviation::CAircraftSituationList remoteAircraftSituations(const Aviation::CCallsign &callsign) const { return m_situations.value(callsign); }
+
+            //! Parts for callsign, latest first
+            Aviation::CAircraftPartsList remoteAircraftParts(const Aviation::CCallsign &callsign) const { return m_parts.value(callsign); }
+
+            //! When situations were last modified, -1 if never
+            qint64 situationsLastModified(const Aviation::CCallsign &callsign) const { return m_situationsLastModified.value(callsign, -1); }
+
+            //! Id of the compact situation history, stable as long as the aircraft is in range
+            //! \return -1 if there are no situations for the callsign
+            int situationHistoryId(const Aviation::CCallsign &callsign) const { return m_situationHistories.callsignId(callsign); }
+
+            //! Compact situation history (latest first), nullptr if there are no situations for the id
+            //! \remark no hashing of the callsign, consistent with CRemoteAircraftSnapshot::remoteAircraftSituations
+            const CCompactSituationHistory *situationHistory(int callsignId) const { return m_situationHistories.history(callsignId); }
+
+            //! When parts were last modified, -1 if never
+            qint64 partsLastModified(const Aviation::CCallsign &callsign) const { return m_partsLastModified.value(callsign, -1); }
+
+            //! Aircraft supporting parts, i.e. parts have been received
+            bool isSupportingParts(const Aviation::CCallsign &callsign) const { return m_partsLastModified.contains(callsign); }
+
+        private:
+            qint64 m_version = -1;
+            CSimulatedAircraftPerCallsign m_aircraft;
+            Aviation::CAircraftSituationListPerCallsign m_situations;
+            Aviation::CTimestampPerCallsign m_situationsLastModified;
+            CSituationHistories m_situationHistories;
+            Aviation::CAircraftPartsListPerCallsign m_parts;
+            Aviation::CTimestampPerCallsign m_partsLastModified;
+        };
+
+        //! Shared, immutable snapshot
+        using CRemoteAircraftSnapshotPtr = std::shared_ptr<const CRemoteAircraftSnapshot>;
+    } // namespace
+} // namespace
+
+#endif // guard
@@ -0,0 +1,200 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/situationhistorystore.h"
+#include "blackmisc/pq/units.h"
+
+#include <QReadLocker>
+#include <QWriteLocker>
+#include <algorithm>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::PhysicalQuantities;
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        CCompactSituation CCompactSituation::fromSituation(const CAircraftSituation &situation)
+        {
+            CCompactSituation cs;
+            cs.timestampMs = situation.getMSecsSinceEpoch();
+            cs.adjustedTimestampMs = situation.getAdjustedMSecsSinceEpoch();
+            cs.latitudeRad = situation.latitude().value(CAngleUnit::rad());
+            cs.longitudeRad = situation.longitude().value(CAngleUnit::rad());
+            cs.altitudeM = situation.getAltitude().value(CLengthUnit::m());
+
+            const std::array<double, 3> normal = situation.normalVectorDouble();
+            cs.normalX = normal[0];
+            cs.normalY = normal[1];
+            cs.normalZ = normal[2];
+
+            if (situation.hasGroundElevation()) { cs.groundElevationM = situation.getGroundElevation().value(CLengthUnit::m()); }
+            if (situation.hasCG()) { cs.cgM = situation.getCG().value(CLengthUnit::m()); }
+            if (!situation.getSceneryOffset().isNull()) { cs.sceneryOffsetM = situation.getSceneryOffset().value(CLengthUnit::m()); }
+
+            cs.pitchRad = situation.getPitch().value(CAngleUnit::rad());
+            cs.bankRad = situation.getBank().value(CAngleUnit::rad());
+            cs.headingRad = situation.getHeading().value(CAngleUnit::rad());
+            cs.groundSpeedMps = situation.getGroundSpeed().value(CSpeedUnit::m_s());
+            cs.onGroundFactor = situation.getOnGroundFactor();
+            cs.onGround = static_cast<qint8>(situation.getOnGround());
+            cs.onGroundDetails = static_cast<qint8>(situation.getOnGroundDetails());
+            cs.isInterim = situation.isInterim();
+            return cs;
+        }
+
+        const CCompactSituationHistory *CSituationHistories::history(int callsignId) const
+        {
+            if (callsignId < 0) { return nullptr; }
+            const int slot = callsignId & (CSituationHistoryStore::MaxAircraft - 1);
+            if (slot >= m_slots.size()) { return nullptr; }
+            const CCompactSituationHistory *history = m_slots[slot].get();
+            return (history && history->callsignId == callsignId) ? history : nullptr;
+        }
+
+        int CSituationHistoryStore::callsignId(const CCallsign &callsign) const
+        {
+            QReadLocker l(&m_lock);
+            return m_histories.callsignId(callsign);
+        }
+
+        CCallsign CSituationHistoryStore::callsign(int callsignId) const
+        {
+            QReadLocker l(&m_lock);
+            if (!m_histories.history(callsignId)) { return {}; }
+            return m_callsigns[slot(callsignId)];
+        }
+
+        int CSituationHistoryStore::store(const CCallsign &callsign, const CAircraftSituationList &situationsLatestFirst)
+        {
+            // conversion outside the lock
+            const auto history = std::make_shared<CCompactSituationHistory>();
+            history->count = qMin(MaxSituations, situationsLatestFirst.size());
+            for (int i = 0; i < history->count; i++)
+            {
+                history->situations[static_cast<size_t>(i)] = CCompactSituation::fromSituation(situationsLatestFirst[i]);
+            }
+
+            QWriteLocker l(&m_lock);
+            const int id = this->idForCallsign(callsign);
+            history->callsignId = id;
+            history->revision = ++m_revision;
+            m_histories.m_slots[slot(id)] = history;
+            return id;
+        }
+
+        int CSituationHistoryStore::push(const CCallsign &callsign, const CCompactSituation &situation)
+        {
+            QWriteLocker l(&m_lock);
+            const int id = this->idForCallsign(callsign);
+            CCompactSituationHistoryPtr &current = m_histories.m_slots[slot(id)];
+
+            // published histories are immutable, so always a new one
+            const auto history = current ? std::make_shared<CCompactSituationHistory>(*current) : std::make_shared<CCompactSituationHistory>();
+            std::copy_backward(history->situations.begin(), history->situations.end() - 1, history->situations.end());
+            history->situations[0] = situation;
+            if (history->count < MaxSituations) { history->count++; }
+            history->callsignId = id;
+            history->revision = ++m_revision;
+            current = history;
+            return id;
+        }
+
+        bool CSituationHistoryStore::snapshot(int callsignId, CCompactSituationHistory &history) const
+        {
+            QReadLocker l(&m_lock);
+            const CCompactSituationHistory *h = m_histories.history(callsignId);
+            if (!h) { return false; }
+            history = *h;
+            return true;
+        }
+
+        bool CSituationHistoryStore::snapshot(const CCallsign &callsign, CCompactSituationHistory &history) const
+        {
+            QReadLocker l(&m_lock);
+            const CCompactSituationHistory *h = m_histories.history(m_histories.callsignId(callsign));
+            if (!h) { return false; }
+            history = *h;
+            return true;
+        }
+
+        CSituationHistories CSituationHistoryStore::histories() const
+        {
+            QReadLocker l(&m_lock);
+            return m_histories;
+        }
+
+        qint64 CSituationHistoryStore::revision(int callsignId) const
+        {
+            QReadLocker l(&m_lock);
+            const CCompactSituationHistory *h = m_histories.history(callsignId);
+            return h ? h->revision : -1;
+        }
+
+        bool CSituationHistoryStore::remove(const CCallsign &callsign)
+        {
+            QWriteLocker l(&m_lock);
+            const int id = m_histories.m_ids.value(callsign, -1);
+            if (id < 0) { return false; }
+            const int s = slot(id);
+            m_histories.m_ids.remove(callsign);
+            m_histories.m_slots[s].reset();
+            m_callsigns[s] = CCallsign();
+            m_freeSlots.push_back(s);
+            return true;
+        }
+
+        void CSituationHistoryStore::clear()
+        {
+            QWriteLocker l(&m_lock);
+
+            // keep the generations, so ids handed out before stay invalid
+            m_histories = CSituationHistories();
+            m_freeSlots.clear();
+            for (int s = m_generations.size() - 1; s >= 0; s--)
+            {
+                m_histories.m_slots.push_back(nullptr);
+                m_callsigns[s] = CCallsign();
+                m_freeSlots.push_back(s);
+            }
+        }
+
+        int CSituationHistoryStore::size() const
+        {
+            QReadLocker l(&m_lock);
+            return m_histories.size();
+        }
+
+        int CSituationHistoryStore::idForCallsign(const CCallsign &callsign)
+        {
+            const auto it = m_histories.m_ids.constFind(callsign);
+            if (it != m_histories.m_ids.constEnd()) { return it.value(); }
+
+            int s = -1;
+            if (m_freeSlots.isEmpty())
+            {
+                Q_ASSERT_X(m_generations.size() < MaxAircraft, Q_FUNC_INFO, "Too many aircraft");
+                s = m_generations.size();
+                m_generations.push_back(0);
+                m_callsigns.push_back(callsign);
+                m_histories.m_slots.push_back(nullptr);
+            }
+            else
+            {
+                s = m_freeSlots.takeLast();
+                m_callsigns[s] = callsign;
+                m_generations[s] = (m_generations[s] + 1) % (std::numeric_limits<int>::max() / MaxAircraft);
+            }
+
+            const int id = m_generations[s] * MaxAircraft + s;
+            m_histories.m_ids.insert(callsign, id);
+            return id;
+        }
+    } // namespace
+} // namespace
@@ -0,0 +1,204 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_SITUATIONHISTORYSTORE_H
+#define BLACKMISC_SIMULATION_SITUATIONHISTORYSTORE_H
+
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/aircraftsituationlist.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QVector>
+#include <QtGlobal>
+#include <array>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        //! Compact, trivially copyable version of an aircraft situation
+        //! \remark plain doubles in SI units (rad, m, m/s), no callsign, no strings
+        struct CCompactSituation
+        {
+            qint64 timestampMs = -1;            //!< ms since epoch
+            qint64 adjustedTimestampMs = -1;    //!< ms since epoch + offset, time base for interpolation
+            double latitudeRad = 0.0;           //!< latitude
+            double longitudeRad = 0.0;          //!< longitude
+            double altitudeM = 0.0;             //!< geodetic height
+            double normalX = 0.0;               //!< normal vector x
+            double normalY = 0.0;               //!< normal vector y
+            double normalZ = 0.0;               //!< normal vector z
+            double groundElevationM = std::numeric_limits<double>::quiet_NaN(); //!< ground elevation, NaN if not available
+            double sceneryOffsetM = 0.0;        //!< scenery offset
+            double cgM = std::numeric_limits<double>::quiet_NaN(); //!< CG, NaN if not available
+            double pitchRad = 0.0;              //!< pitch
+            double bankRad = 0.0;               //!< bank
+            double headingRad = 0.0;            //!< heading
+            double groundSpeedMps = 0.0;        //!< ground speed
+            double onGroundFactor = -1.0;       //!< on ground factor 0..1, -1 if unknown
+            qint8 onGround = Aviation::CAircraftSituation::OnGroundSituationUnknown; //!< Aviation::CAircraftSituation::IsOnGround
+            qint8 onGroundDetails = Aviation::CAircraftSituation::NotSetGroundDetails; //!< Aviation::CAircraftSituation::OnGroundDetails
+            bool isInterim = false;             //!< interim position
+
+            //! Ground elevation available?
+            bool hasGroundElevation() const { return groundElevationM == groundElevationM; } // NaN check
+
+            //! CG available?
+            bool hasCG() const { return cgM == cgM; } // NaN check
+
+            //! Valid situation?
+            bool isValid() const { return timestampMs >= 0; }
+
+            //! From the full situation
+            static CCompactSituation fromSituation(const Aviation::CAircraftSituation &situation);
+        };
+
+        static_assert(std::is_trivially_copyable<CCompactSituation>::value, "Needs to be trivially copyable");
+
+        //! Time history of one aircraft, latest situation first
+        //! \remark plain value, copied without any heap allocation
+        struct CCompactSituationHistory
+        {
+            //! Max. number of situations
+            static constexpr int MaxSituations = 6;
+
+            int callsignId = -1;    //!< interned callsign id, see CSituationHistoryStore::callsignId
+            int count = 0;          //!< number of valid situations
+            qint64 revision = 0;    //!< incremented with every change of the aircraft's situations
+            std::array<CCompactSituation, MaxSituations> situations; //!< latest first
+
+            //! Any situation?
+            bool isEmpty() const { return count < 1; }
+
+            //! Latest situation
+            //! \remark only valid if not empty
+            const CCompactSituation &latest() const { return situations[0]; }
+
+            //! Situation by index 0..latest
+            const CCompactSituation &at(int index) const { return situations[static_cast<size_t>(index)]; }
+        };
+
+        static_assert(std::is_trivially_copyable<CCompactSituationHistory>::value, "Needs to be trivially copyable");
+
+        //! Shared, immutable history of one aircraft
+        using CCompactSituationHistoryPtr = std::shared_ptr<const CCompactSituationHistory>;
+
+        //! Immutable copy of the histories of all aircraft
+        //! \remark implicitly shared, a copy only copies the pointers to the histories
+        //! \remark published with CRemoteAircraftSnapshot, so readers in the simulator loops never lock
+        class BLACKMISC_EXPORT CSituationHistories
+        {
+        public:
+            //! Interned id of callsign
+            //! \return -1 if callsign is not stored
+            int callsignId(const Aviation::CCallsign &callsign) const { return m_ids.value(callsign, -1); }
+
+            //! History for id
+            //! \return nullptr if no such aircraft, or if the id belongs to a removed aircraft
+            const CCompactSituationHistory *history(int callsignId) const;
+
+            //! Number of stored aircraft
+            int size() const { return m_ids.size(); }
+
+        private:
+            friend class CSituationHistoryStore;
+
+            QVector<CCompactSituationHistoryPtr> m_slots; //!< indexed by slot of the callsign id
+            QHash<Aviation::CCallsign, int> m_ids;        //!< interned callsigns
+        };
+
+        //! Compact per aircraft ring buffers of situations, for fast reads in the simulator loops
+        //! \remark callsigns are interned, readers can keep the id and read without any string hashing
+        //! \remark ids of removed aircraft are not reused, a slot gets a new generation when it is reused
+        //! \threadsafe
+        class BLACKMISC_EXPORT CSituationHistoryStore
+        {
+        public:
+            //! Max. situations per aircraft
+            static constexpr int MaxSituations = CCompactSituationHistory::MaxSituations;
+
+            //! Max. number of aircraft stored at the same time
+            static constexpr int MaxAircraft = 1 << 16;
+
+            //! Ctor
+            CSituationHistoryStore() = default;
+
+            //! Not copyable
+            CSituationHistoryStore(const CSituationHistoryStore &) = delete;
+
+            //! Not copyable
+            CSituationHistoryStore &operator =(const CSituationHistoryStore &) = delete;
+
+            //! Interned id of callsign
+            //! \return -1 if callsign is not stored
+            int callsignId(const Aviation::CCallsign &callsign) const;
+
+            //! Callsign for id, empty if not stored
+            Aviation::CCallsign callsign(int callsignId) const;
+
+            //! Replace all situations of the callsign
+            //! \param callsign
+            //! \param situationsLatestFirst max. MaxSituations are used
+            //! \return interned callsign id
+            int store(const Aviation::CCallsign &callsign, const Aviation::CAircraftSituationList &situationsLatestFirst);
+
+            //! Add a situation as latest situation, the oldest one is dropped if the buffer is full
+            //! \return interned callsign id
+            int push(const Aviation::CCallsign &callsign, const CCompactSituation &situation);
+
+            //! Copy of the aircraft's history
+            //! \return false if no such aircraft
+            //! @{
+            bool snapshot(int callsignId, CCompactSituationHistory &history) const;
+            bool snapshot(const Aviation::CCallsign &callsign, CCompactSituationHistory &history) const;
+            //! @}
+
+            //! Histories of all aircraft
+            //! \remark cheap, implicitly shared
+            CSituationHistories histories() const;
+
+            //! Revision of the aircraft's history, -1 if not stored
+            //! \remark can be used to detect changes without copying
+            qint64 revision(int callsignId) const;
+
+            //! Remove aircraft, its id is invalid afterwards
+            bool remove(const Aviation::CCallsign &callsign);
+
+            //! Remove all aircraft
+            void clear();
+
+            //! Number of stored aircraft
+            int size() const;
+
+        private:
+            //! Id for callsign, created if needed
+            //! \remark requires write lock
+            int idForCallsign(const Aviation::CCallsign &callsign);
+
+            //! Slot of the id
+            static int slot(int callsignId) { return callsignId & (MaxAircraft - 1); }
+
+            CSituationHistories m_histories;   //!< current histories, detached when published ones are modified
+            QVector<Aviation::CCallsign> m_callsigns; //!< callsign per slot, empty if unused
+            QVector<int> m_generations;        //!< generation of the id per slot
+            QVector<int> m_freeSlots;          //!< slots which can be reused
+            qint64 m_revision = 0;             //!< global revision counter
+            mutable QReadWriteLock m_lock;     //!< lock for all members
+        };
+    } // namespace
+} // namespace
+
+#endif // guard
@@ -10,6 +10,7 @@
 #include "blackmisc/simulation/aircraftmodelutils.h"
 #include "blackmisc/simulation/distributor.h"
 #include "blackmisc/simulation/xplane/aircraftmodelloaderxplane.h"
+#include "blackmisc/simulation/xplane/modelfingerprintcache.h"
 #include "blackmisc/simulation/xplane/xplaneutil.h"
 #include "blackmisc/simulation/xplane/qtfreeutils.h"
 #include "blackmisc/aviation/aircrafticaocode.h"
@@ -17,6 +18,7 @@
 #include "blackmisc/aviation/livery.h"
 #include "blackmisc/worker.h"
 #include "blackmisc/stringutils.h"
+#include "blackmisc/threadutils.h"
 #include "blackmisc/fileutils.h"
 #include "blackmisc/directoryutils.h"
 #include "blackmisc/statusmessage.h"
@@ -26,9 +28,11 @@
 
 #include <string.h>
 #include <QChar>
+#include <QCryptographicHash>
 #include <QDateTime>
 #include <QDir>
 #include <QDirIterator>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
 #include <QFlags>
@@ -36,9 +40,11 @@
 #include <QList>
 #include <QMap>
 #include <QRegularExpression>
+#include <QSet>
 #include <QTextStream>
 #include <QStringBuilder>
 #include <algorithm>
+#include <atomic>
 #include <functional>
 
 using namespace BlackConfig;
@@ -163,46 +169,107 @@ namespace BlackMisc
                 return std::move(modelName).trimmed();
             }
 
+            namespace
+            {
+                //! Content of a CSL package file
+                QString readPackageFile(const QFileInfo &fileInfo)
+                {
+                    QFile file(fileInfo.filePath());
+                    if (!file.open(QIODevice::ReadOnly)) { return {}; }
+                    QTextStream ts(&file);
+                    return ts.readAll();
+                }
+
+                //! The CSL models depend on the names and paths of all packages
+                QByteArray packagesContext(const QStringList &namesAndPaths)
+                {
+                    return QCryptographicHash::hash(namesAndPaths.join('\n').toUtf8(), QCryptographicHash::Md5);
+                }
+            }
+
             CAircraftModelList CAircraftModelLoaderXPlane::performParsing(const QStringList &rootDirectories, const QStringList &excludeDirectories)
             {
+                const QString cacheFile = CModelFingerprintCache::cacheFileName();
+                CModelFingerprintCache previous;
+                previous.load(cacheFile);
+                CModelFingerprintCache current(previous);
+                current.removeInDirectories(rootDirectories);
+
+                ParsingStatistics statistics;
                 CAircraftModelList allModels;
                 for (const QString &rootDirectory : rootDirectories)
                 {
-                    allModels.push_back(parseCslPackages(rootDirectory, excludeDirectories));
-                    allModels.push_back(parseFlyableAirplanes(rootDirectory, excludeDirectories));
+                    allModels.push_back(parseCslPackages(rootDirectory, excludeDirectories, previous, current, statistics));
+                    allModels.push_back(parseFlyableAirplanes(rootDirectory, excludeDirectories, previous, current, statistics));
                 }
+                if (m_cancelLoading) { return allModels; }
+
+                const CStatusMessage saved = current.save(cacheFile);
+                if (saved.isFailure()) { m_loadingMessages.push_back(saved); }
+
+                m_loadingMessages.push_back(CStatusMessage(this).info(u"XPlane CSL packages: %1 unchanged, %2 parsed, %3 headers read, headers %4ms, packages %5ms")
+                                            << statistics.cslUnchanged << statistics.cslParsed << statistics.cslHeadersRead << statistics.cslHeadersMs << statistics.cslPackagesMs);
+                m_loadingMessages.push_back(CStatusMessage(this).info(u"XPlane flyable airplanes: %1 unchanged, %2 parsed, %3ms")
+                                            << statistics.flyableUnchanged << statistics.flyableParsed << statistics.flyableMs);
+                m_loadingMessages.push_back(CStatusMessage(this).info(u"XPlane directory scan %1ms") << statistics.discoveryMs);
                 return allModels;
             }
 
             //! Add model only if there no other model with the same model string
-            void CAircraftModelLoaderXPlane::addUniqueModel(const CAircraftModel &model, CAircraftModelList &models)
+            void CAircraftModelLoaderXPlane::addUniqueModel(const CAircraftModel &model, CAircraftModelList &models, QSet<QString> &modelStrings)
             {
-                if (models.containsModelString(model.getModelString()))
+                const QString modelString = model.getModelString().toUpper();
+                if (modelStrings.contains(modelString))
                 {
                     const CStatusMessage m = CStatusMessage(this).warning(u"XPlane model '%1' exists already! Potential model string conflict! Ignoring it.") << model.getModelString();
                     m_loadingMessages.push_back(m);
                 }
+                modelStrings.insert(modelString);
                 models.push_back(model);
             }
 
-            CAircraftModelList CAircraftModelLoaderXPlane::parseFlyableAirplanes(const QString &rootDirectory, const QStringList &excludeDirectories)
+            CAircraftModelList CAircraftModelLoaderXPlane::parseFlyableAirplanes(const QString &rootDirectory, const QStringList &excludeDirectories,
+                    const CModelFingerprintCache &previous, CModelFingerprintCache &current, ParsingStatistics &statistics)
             {
-                Q_UNUSED(excludeDirectories)
                 if (rootDirectory.isEmpty()) { return {}; }
 
+                QElapsedTimer time;
+                time.start();
+
                 QDir searchPath(rootDirectory, fileFilterFlyable());
                 QDirIterator aircraftIt(searchPath, QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
 
                 emit loadingProgress(this->getSimulator(), QStringLiteral("Parsing flyable airplanes in '%1'").arg(rootDirectory), -1);
 
-                CAircraftModelList installedModels;
+                QVector<QFileInfo> acfFiles;
                 while (aircraftIt.hasNext())
                 {
                     aircraftIt.next();
                     if (CFileUtils::isExcludedDirectory(aircraftIt.fileInfo(), excludeDirectories, Qt::CaseInsensitive)) { continue; }
+                    acfFiles.push_back(aircraftIt.fileInfo());
+                }
+                statistics.discoveryMs += time.restart();
+
+                // the ACF files are large, they are read in parallel and only if changed
+                // the liveries are listed every time, a new livery does not touch the ACF file
+                QVector<CModelFingerprintCache::Entry> results(acfFiles.size());
+                CModelFingerprintCache::Entry *resultData = results.data();
+                std::atomic_int unchanged { 0 };
+                CThreadUtils::parallelFor(acfFiles.size(), MaxParsingThreads, [&](int i)
+                {
+                    if (m_cancelLoading) { return; }
+                    const QFileInfo &acfFile = acfFiles.at(i);
+                    CModelFingerprintCache::Entry &result = resultData[i];
+                    const CModelFingerprintCache::Entry *cached = previous.find(acfFile.absoluteFilePath());
+                    if (cached && !cached->models.isEmpty() && cached->isUnchanged(acfFile, {}))
+                    {
+                        result = *cached;
+                        unchanged++;
+                        return;
+                    }
 
                     using namespace BlackMisc::Simulation::XPlane::QtFreeUtils;
-                    AcfProperties acfProperties = extractAcfProperties(aircraftIt.filePath().toStdString());
+                    AcfProperties acfProperties = extractAcfProperties(acfFile.filePath().toStdString());
 
                     const CDistributor dist({}, QString::fromStdString(acfProperties.author), {}, {}, CSimulatorInfo::XPLANE);
                     CAircraftModel model;
@@ -214,102 +281,204 @@ namespace BlackMisc
                     if (!model.hasDescription()) { model.setDescription(descriptionForFlyableModel(model)); }
                     model.setModelType(CAircraftModel::TypeOwnSimulatorModel);
                     model.setSimulator(CSimulatorInfo::xplane());
-                    model.setFileDetailsAndTimestamp(aircraftIt.fileInfo());
+                    model.setFileDetailsAndTimestamp(acfFile);
                     model.setModelMode(CAircraftModel::Exclude);
-                    addUniqueModel(model, installedModels);
+                    result.models.push_back(model);
+                    result.setFingerprint(acfFile, {});
+                });
+
+                CAircraftModelList installedModels;
+                QSet<QString> modelStrings;
+                for (int i = 0; i < acfFiles.size() && !m_cancelLoading; i++)
+                {
+                    const CModelFingerprintCache::Entry &result = results[i];
+                    if (result.models.isEmpty()) { continue; }
+                    current.insert(acfFiles[i].absoluteFilePath(), result);
+
+                    CAircraftModel model = result.models.front();
+                    addUniqueModel(model, installedModels, modelStrings);
 
                     const QString baseModelString = model.getModelString();
-                    QDirIterator liveryIt(CFileUtils::appendFilePaths(aircraftIt.fileInfo().canonicalPath(), QStringLiteral("liveries")), QDir::Dirs | QDir::NoDotAndDotDot);
-                    emit this->loadingProgress(this->getSimulator(), QStringLiteral("Parsing flyable liveries in '%1'").arg(aircraftIt.fileInfo().canonicalPath()), -1);
+                    QDirIterator liveryIt(CFileUtils::appendFilePaths(acfFiles[i].canonicalPath(), QStringLiteral("liveries")), QDir::Dirs | QDir::NoDotAndDotDot);
                     while (liveryIt.hasNext())
                     {
                         liveryIt.next();
                         model.setModelString(baseModelString % u' ' % liveryIt.fileName());
-                        addUniqueModel(model, installedModels);
+                        addUniqueModel(model, installedModels, modelStrings);
                     }
                 }
+
+                statistics.flyableUnchanged += unchanged;
+                statistics.flyableParsed += acfFiles.size() - unchanged;
+                statistics.flyableMs += time.elapsed();
                 return installedModels;
             }
 
-            CAircraftModelList CAircraftModelLoaderXPlane::parseCslPackages(const QString &rootDirectory, const QStringList &excludeDirectories)
+            CAircraftModelList CAircraftModelLoaderXPlane::parseCslPackages(const QString &rootDirectory, const QStringList &excludeDirectories,
+                    const CModelFingerprintCache &previous, CModelFingerprintCache &current, ParsingStatistics &statistics)
             {
-                Q_UNUSED(excludeDirectories);
                 if (rootDirectory.isEmpty()) { return {}; }
 
                 m_cslPackages.clear();
 
+                QElapsedTimer time;
+                time.start();
+
+                QStringList packageFiles;
                 QDir searchPath(rootDirectory, fileFilterCsl());
                 QDirIterator it(searchPath, QDirIterator::Subdirectories);
                 while (it.hasNext())
                 {
-                    QString packageFile = it.next();
+                    const QString packageFile = it.next();
                     if (CFileUtils::isExcludedDirectory(it.filePath(), excludeDirectories)) { continue; }
+                    packageFiles.push_back(packageFile);
+                }
+                statistics.discoveryMs += time.restart();
 
-                    const QString packageFilePath = it.fileInfo().absolutePath();
-                    QFile file(packageFile);
-                    file.open(QIODevice::ReadOnly);
+                // the package names are needed first, unchanged package files take them from the cache,
+                // only changed package files are read (in parallel) for their header
+                struct PackageFile
+                {
+                    QFileInfo fileInfo;
                     QString content;
+                    bool read = false;
+                    CSLPackage header;
+                };
+                QVector<PackageFile> files(packageFiles.size());
+                PackageFile *fileData = files.data();
+                std::atomic_int headersRead { 0 };
+                CThreadUtils::parallelFor(files.size(), MaxParsingThreads, [&](int i)
+                {
+                    if (m_cancelLoading) { return; }
+                    PackageFile &packageFile = fileData[i];
+                    packageFile.fileInfo = QFileInfo(packageFiles[i]);
+                    const CModelFingerprintCache::Entry *cached = previous.find(packageFile.fileInfo.absoluteFilePath());
+                    if (cached && !cached->packageName.isEmpty() && cached->isFileUnchanged(packageFile.fileInfo))
+                    {
+                        packageFile.header.name = cached->packageName;
+                        packageFile.header.path = packageFile.fileInfo.absolutePath();
+                        return;
+                    }
 
-                    QTextStream ts(&file);
-                    content.append(ts.readAll());
-                    file.close();
-
-                    const auto package = parsePackageHeader(packageFilePath, content);
-                    if (package.hasValidHeader()) m_cslPackages.push_back(package);
-                }
-
-                CAircraftModelList installedModels;
+                    packageFile.content = readPackageFile(packageFile.fileInfo);
+                    packageFile.read = true;
+                    packageFile.header = parsePackageHeader(packageFile.fileInfo.absolutePath(), packageFile.content);
+                    headersRead++;
+                });
+                if (m_cancelLoading) { return {}; }
+                statistics.cslHeadersRead += headersRead;
 
-                // Now we do a full run
-                for (auto &package : m_cslPackages)
+                // package names must be unique, first one wins
+                QVector<int> packageFileIndexes;
+                QStringList namesAndPaths;
+                for (int i = 0; i < files.size(); i++)
                 {
-                    const QString packageFile = CFileUtils::appendFilePaths(package.path, QStringLiteral("xsb_aircraft.txt"));
-                    emit this->loadingProgress(this->getSimulator(), QStringLiteral("Parsing CSL '%1'").arg(packageFile), -1);
+                    CSLPackage &header = files[i].header;
+                    m_loadingMessages.push_back(header.messages);
+                    header.messages.clear();
+                    if (!header.hasValidHeader()) { continue; }
 
-                    QFile file(packageFile);
-                    file.open(QIODevice::ReadOnly);
-                    QString content;
+                    const auto p = std::find_if(m_cslPackages.cbegin(), m_cslPackages.cend(), [&header](const CSLPackage & p) { return p.name == header.name; });
+                    if (p != m_cslPackages.cend())
+                    {
+                        const CStatusMessage m = CStatusMessage(this).error(u"XPlane package name '%1' already in use by '%2' reqested by use by '%3'") << header.name << p->path << header.path;
+                        m_loadingMessages.push_back(m);
+                        continue;
+                    }
+                    m_cslPackages.push_back(header);
+                    packageFileIndexes.push_back(i);
+                    namesAndPaths.push_back(header.name % u' ' % header.path);
+                }
+                const QByteArray context = packagesContext(namesAndPaths);
+                statistics.cslHeadersMs += time.restart();
+
+                // Now we do a full run, the packages only read the list of packages
+                CSLPackage *packages = m_cslPackages.data();
+                QVector<CModelFingerprintCache::Entry> results(m_cslPackages.size());
+                CModelFingerprintCache::Entry *resultData = results.data();
+                std::atomic_int unchanged { 0 };
+                CThreadUtils::parallelFor(m_cslPackages.size(), MaxParsingThreads, [&](int i)
+                {
+                    if (m_cancelLoading) { return; }
+                    const PackageFile &packageFile = files.at(packageFileIndexes.at(i));
+                    CModelFingerprintCache::Entry &result = resultData[i];
+                    const CModelFingerprintCache::Entry *cached = previous.find(packageFile.fileInfo.absoluteFilePath());
+                    if (cached && cached->isUnchanged(packageFile.fileInfo, context))
+                    {
+                        result = *cached;
+                        unchanged++;
+                        return;
+                    }
 
-                    QTextStream ts(&file);
-                    content.append(ts.readAll());
-                    file.close();
+                    // header from the cache, but other packages changed
+                    const QString content = packageFile.read ? packageFile.content : readPackageFile(packageFile.fileInfo);
+
+                    CSLPackage &package = packages[i];
+                    emit this->loadingProgress(this->getSimulator(), QStringLiteral("Parsing CSL '%1'").arg(packageFile.fileInfo.absoluteFilePath()), -1);
                     parseFullPackage(content, package);
+                    result.models = this->cslModels(package);
+                    result.messages = package.messages;
+                    result.packageName = package.name;
+                    result.setFingerprint(packageFile.fileInfo, context);
+                });
 
-                    for (const auto &plane : as_const(package.planes))
+                CAircraftModelList installedModels;
+                QSet<QString> modelStrings;
+                for (int i = 0; i < results.size() && !m_cancelLoading; i++)
+                {
+                    const CModelFingerprintCache::Entry &result = results[i];
+                    current.insert(files[packageFileIndexes[i]].fileInfo.absoluteFilePath(), result);
+                    m_loadingMessages.push_back(result.messages);
+                    for (const CAircraftModel &model : result.models)
                     {
-                        if (installedModels.containsModelString(plane.getModelName()))
+                        const QString modelString = model.getModelString().toUpper();
+                        if (modelStrings.contains(modelString))
                         {
-                            const CStatusMessage msg = CStatusMessage(this).warning(u"XPlane model '%1' exists already! Potential model string conflict! Ignoring it.") << plane.getModelName();
+                            const CStatusMessage msg = CStatusMessage(this).warning(u"XPlane model '%1' exists already! Potential model string conflict! Ignoring it.") << model.getModelString();
                             m_loadingMessages.push_back(msg);
                             continue;
                         }
+                        modelStrings.insert(modelString);
+                        installedModels.push_back(model);
+                    }
+                }
 
-                        CAircraftModel model(plane.getModelName(), CAircraftModel::TypeOwnSimulatorModel);
-                        const CAircraftIcaoCode icao(plane.icao);
-                        const QFileInfo modelFileInfo(plane.filePath);
-                        model.setFileDetailsAndTimestamp(modelFileInfo);
-                        model.setAircraftIcaoCode(icao);
+                statistics.cslUnchanged += unchanged;
+                statistics.cslParsed += results.size() - unchanged;
+                statistics.cslPackagesMs += time.elapsed();
+                return installedModels;
+            }
 
-                        if (CBuildConfig::isLocalDeveloperDebugBuild())
-                        {
-                            BLACK_AUDIT_X(modelFileInfo.exists(), Q_FUNC_INFO, "Model does NOT exist");
-                        }
+            CAircraftModelList CAircraftModelLoaderXPlane::cslModels(const CSLPackage &package) const
+            {
+                CAircraftModelList models;
+                for (const auto &plane : package.planes)
+                {
+                    CAircraftModel model(plane.getModelName(), CAircraftModel::TypeOwnSimulatorModel);
+                    const CAircraftIcaoCode icao(plane.icao);
+                    const QFileInfo modelFileInfo(plane.filePath);
+                    model.setFileDetailsAndTimestamp(modelFileInfo);
+                    model.setAircraftIcaoCode(icao);
 
-                        CLivery livery;
-                        livery.setCombinedCode(plane.livery);
-                        CAirlineIcaoCode airline(plane.airline);
-                        livery.setAirlineIcaoCode(airline);
-                        model.setLivery(livery);
-
-                        model.setSimulator(CSimulatorInfo::xplane());
-                        QString modelDescription("[CSL]");
-                        if (plane.objectVersion == CSLPlane::OBJ7) { modelDescription += "[OBJ7]"; }
-                        else if (plane.objectVersion == CSLPlane::OBJ8) { modelDescription += "[OBJ8]"; }
-                        model.setDescription(modelDescription);
-                        installedModels.push_back(model);
+                    if (CBuildConfig::isLocalDeveloperDebugBuild())
+                    {
+                        BLACK_AUDIT_X(modelFileInfo.exists(), Q_FUNC_INFO, "Model does NOT exist");
                     }
+
+                    CLivery livery;
+                    livery.setCombinedCode(plane.livery);
+                    CAirlineIcaoCode airline(plane.airline);
+                    livery.setAirlineIcaoCode(airline);
+                    model.setLivery(livery);
+
+                    model.setSimulator(CSimulatorInfo::xplane());
+                    QString modelDescription("[CSL]");
+                    if (plane.objectVersion == CSLPlane::OBJ7) { modelDescription += "[OBJ7]"; }
+                    else if (plane.objectVersion == CSLPlane::OBJ8) { modelDescription += "[OBJ8]"; }
+                    model.setDescription(modelDescription);
+                    models.push_back(model);
                 }
-                return installedModels;
+                return models;
             }
 
             bool CAircraftModelLoaderXPlane::doPackageSub(QString &ioPath)
@@ -331,39 +500,29 @@ namespace BlackMisc
                 if (tokens.size() != 2)
                 {
                     const CStatusMessage m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : EXPORT_NAME command requires 1 argument.") << path << lineNum;
-                    m_loadingMessages.push_back(m);
+                    package.messages.push_back(m);
                     return false;
                 }
 
-                auto p = std::find_if(m_cslPackages.cbegin(), m_cslPackages.cend(), [&tokens](const CSLPackage & p) { return p.name == tokens[1]; });
-                if (p == m_cslPackages.cend())
-                {
-                    package.path = path;
-                    package.name = tokens[1];
-                    return true;
-                }
-                else
-                {
-                    const CStatusMessage m = CStatusMessage(this).error(u"XPlane package name '%1' already in use by '%2' reqested by use by '%3'") << tokens[1] << p->path << path;
-                    m_loadingMessages.push_back(m);
-                    return false;
-                }
+                // unique names are checked when all headers are parsed
+                package.path = path;
+                package.name = tokens[1];
+                return true;
             }
 
             bool CAircraftModelLoaderXPlane::parseDependencyCommand(const QStringList &tokens, CSLPackage &package, const QString &path, int lineNum)
             {
-                Q_UNUSED(package);
                 if (tokens.size() != 2)
                 {
                     const CStatusMessage m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : DEPENDENCY command requires 1 argument.") << path << lineNum;
-                    m_loadingMessages.push_back(m);
+                    package.messages.push_back(m);
                     return false;
                 }
 
                 if (std::count_if(m_cslPackages.cbegin(), m_cslPackages.cend(), [&tokens](const CSLPackage & p) { return p.name == tokens[1]; }) == 0)
                 {
                     const CStatusMessage m = CStatusMessage(this).error(u"XPlane required package %1 not found. Aborting processing of this package.") << tokens[1];
-                    m_loadingMessages.push_back(m);
+                    package.messages.push_back(m);
                     return false;
                 }
 
@@ -388,7 +547,7 @@ namespace BlackMisc
                 package.planes.push_back(CSLPlane());
 
                 const auto m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : Unsupported legacy CSL format.") << path << lineNum;
-                m_loadingMessages.push_back(m);
+                package.messages.push_back(m);
                 return false;
             }
 
@@ -397,7 +556,7 @@ namespace BlackMisc
                 if (!package.planes.isEmpty() && !package.planes.back().hasErrors)
                 {
                     const auto m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : Unsupported legacy CSL format.") << path << lineNum;
-                    m_loadingMessages.push_back(m);
+                    package.messages.push_back(m);
                 }
                 return false;
             }
@@ -407,7 +566,7 @@ namespace BlackMisc
                 package.planes.push_back(CSLPlane());
 
                 const auto m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : Unsupported legacy CSL format.") << path << lineNum;
-                m_loadingMessages.push_back(m);
+                package.messages.push_back(m);
                 return false;
             }
 
@@ -419,7 +578,7 @@ namespace BlackMisc
                 if (tokens.size() != 2)
                 {
                     const CStatusMessage m = CStatusMessage(this).warning(u"%1/xsb_aircraft.txt Line %2 : OBJ8_AIRCARFT command requires 1 argument.") << path << lineNum;
-                    m_loadingMessages.push_back(m);
+                    package.messages.push_back(m);
                     if (tokens.size() < 2)
                     {
                         return false;
@@ -439,18 +598,18 @@ namespace BlackMisc
                     if (tokens.size() == 5 || tokens.size() == 6)
                     {
                         const CStatusMessage m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : Unsupported IVAO CSL format - consider using CSL2XSB.") << path << lineNum;
-                        m_loadingMessages.push_back(m);
+                        package.messages.push_back(m);
                     }
                     else
                     {
                         const CStatusMessage m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : OBJ8 command takes 3 arguments.") << path << lineNum;
-                        m_loadingMessages.push_back(m);
+                        package.messages.push_back(m);
                     }
                     return false;
                 }
                 if (package.planes.isEmpty())
                 {
-                    m_loadingMessages.push_back(CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : invalid position for command.") << path << lineNum);
+                    package.messages.push_back(CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : invalid position for command.") << path << lineNum);
                     return false;
                 }
 
@@ -462,7 +621,7 @@ namespace BlackMisc
                 if (!doPackageSub(fullPath))
                 {
                     const CStatusMessage m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : package not found.") << path << lineNum;
-                    m_loadingMessages.push_back(m);
+                    package.messages.push_back(m);
                     return false;
                 }
 
@@ -489,12 +648,12 @@ namespace BlackMisc
                 if (tokens.size() != 2)
                 {
                     const CStatusMessage m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : ICAO command requires 1 argument.") << path << lineNum;
-                    m_loadingMessages.push_back(m);
+                    package.messages.push_back(m);
                     return false;
                 }
                 if (package.planes.isEmpty())
                 {
-                    m_loadingMessages.push_back(CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : invalid position for command.") << path << lineNum);
+                    package.messages.push_back(CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : invalid position for command.") << path << lineNum);
                     return false;
                 }
 
@@ -509,12 +668,12 @@ namespace BlackMisc
                 if (tokens.size() != 3)
                 {
                     const CStatusMessage m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : AIRLINE command requires 2 arguments.") << path << lineNum;
-                    m_loadingMessages.push_back(m);
+                    package.messages.push_back(m);
                     return false;
                 }
                 if (package.planes.isEmpty())
                 {
-                    m_loadingMessages.push_back(CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : invalid position for command.") << path << lineNum);
+                    package.messages.push_back(CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : invalid position for command.") << path << lineNum);
                     return false;
                 }
 
@@ -531,12 +690,12 @@ namespace BlackMisc
                 if (tokens.size() != 4)
                 {
                     const CStatusMessage m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : LIVERY command requires 3 arguments.") << path << lineNum;
-                    m_loadingMessages.push_back(m);
+                    package.messages.push_back(m);
                     return false;
                 }
                 if (package.planes.isEmpty())
                 {
-                    m_loadingMessages.push_back(CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : invalid position for command.") << path << lineNum);
+                    package.messages.push_back(CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : invalid position for command.") << path << lineNum);
                     return false;
                 }
 
@@ -634,7 +793,7 @@ namespace BlackMisc
                         else
                         {
                             const CStatusMessage m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : Unrecognized CSL command: '%3'") << package.path << lineNum << tokens[0];
-                            m_loadingMessages.push_back(m);
+                            package.messages.push_back(m);
                         }
                     }
                 }
@@ -15,9 +15,11 @@
 #include "blackmisc/simulation/aircraftmodellist.h"
 #include "blackmisc/simulation/aircraftmodelloader.h"
 #include "blackmisc/simulation/simulatorinfo.h"
+#include "blackmisc/statusmessagelist.h"
 
 #include <QObject>
 #include <QPointer>
+#include <QSet>
 #include <QString>
 #include <QStringList>
 #include <QVector>
@@ -31,6 +33,8 @@ namespace BlackMisc
     {
         namespace XPlane
         {
+            class CModelFingerprintCache;
+
             /*!
              * XPlane aircraft model loader
              */
@@ -97,11 +101,32 @@ namespace BlackMisc
                     QString name;
                     QString path;
                     QVector<CSLPlane> planes;
+                    CStatusMessageList messages; //!< parsing messages, packages are parsed in parallel
                 };
 
+                //! Files and timings of the parsing phases
+                struct ParsingStatistics
+                {
+                    qint64 discoveryMs = 0;    //!< finding the files
+                    qint64 cslHeadersMs = 0;   //!< package names, from the cache or read from the changed packages
+                    qint64 cslPackagesMs = 0;  //!< parsing the CSL packages
+                    qint64 flyableMs = 0;      //!< parsing the ACF files
+                    int cslUnchanged = 0;      //!< CSL packages from the fingerprint cache
+                    int cslParsed = 0;         //!< CSL packages parsed
+                    int cslHeadersRead = 0;    //!< CSL packages read for their name
+                    int flyableUnchanged = 0;  //!< ACF files from the fingerprint cache
+                    int flyableParsed = 0;     //!< ACF files parsed
+                };
+
+                //! Max. number of threads parsing CSL packages and ACF files
+                static constexpr int MaxParsingThreads = 8;
+
                 CAircraftModelList performParsing(const QStringList &rootDirectories, const QStringList &excludeDirectories);
-                CAircraftModelList parseFlyableAirplanes(const QString &rootDirectory, const QStringList &excludeDirectories);
-                CAircraftModelList parseCslPackages(const QString &rootDirectory, const QStringList &excludeDirectories);
+                CAircraftModelList parseFlyableAirplanes(const QString &rootDirectory, const QStringList &excludeDirectories,
+                        const CModelFingerprintCache &previous, CModelFingerprintCache &current, ParsingStatistics &statistics);
+                CAircraftModelList parseCslPackages(const QString &rootDirectory, const QStringList &excludeDirectories,
+                        const CModelFingerprintCache &previous, CModelFingerprintCache &current, ParsingStatistics &statistics);
+                CAircraftModelList cslModels(const CSLPackage &package) const;
 
                 bool doPackageSub(QString &ioPath);
 
@@ -121,10 +146,10 @@ namespace BlackMisc
                 CSLPackage parsePackageHeader(const QString &path, const QString &content);
                 void parseFullPackage(const QString &content, CSLPackage &package);
 
-                void addUniqueModel(const CAircraftModel &model, CAircraftModelList &models);
+                void addUniqueModel(const CAircraftModel &model, CAircraftModelList &models, QSet<QString> &modelStrings);
 
                 QPointer<CWorker> m_parserWorker;  //!< worker will destroy itself, so weak pointer
-                QVector<CSLPackage> m_cslPackages; //!< Parsed Packages. No lock required since accessed only from one thread
+                QVector<CSLPackage> m_cslPackages; //!< Parsed Packages. Only read while the packages are parsed in parallel
 
                 static const QString &fileFilterFlyable();
                 static const QString &fileFilterCsl();
@@ -0,0 +1,56 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/xplane/modelfingerprintcache.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        namespace XPlane
+        {
+            bool CModelFingerprint::isFileUnchanged(const QFileInfo &fileInfo) const
+            {
+                return this->lastModified == fileInfo.lastModified().toMSecsSinceEpoch() && this->size == fileInfo.size();
+            }
+
+            bool CModelFingerprint::isUnchanged(const QFileInfo &fileInfo, const QByteArray &context) const
+            {
+                return this->isFileUnchanged(fileInfo) && this->context == context;
+            }
+
+            void CModelFingerprint::setFingerprint(const QFileInfo &fileInfo, const QByteArray &context)
+            {
+                this->lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+                this->size = fileInfo.size();
+                this->context = context;
+            }
+
+            QDataStream &operator <<(QDataStream &stream, const CModelFingerprint &entry)
+            {
+                return stream << entry.lastModified << entry.size << entry.context << entry.packageName << entry.models << entry.messages;
+            }
+
+            QDataStream &operator >>(QDataStream &stream, CModelFingerprint &entry)
+            {
+                return stream >> entry.lastModified >> entry.size >> entry.context >> entry.packageName >> entry.models >> entry.messages;
+            }
+
+            CModelFingerprintCache::CModelFingerprintCache() : CFileManifest(0x5357584d, Version) // "SWXM"
+            { }
+
+            QString CModelFingerprintCache::cacheFileName()
+            {
+                return CFileManifestBase::manifestFileName(QStringLiteral("xplanemodels.manifest"));
+            }
+        } // namespace
+    } // namespace
+} // namespace
@@ -0,0 +1,80 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_XPLANE_MODELFINGERPRINTCACHE_H
+#define BLACKMISC_SIMULATION_XPLANE_MODELFINGERPRINTCACHE_H
+
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/filemanifest.h"
+#include "blackmisc/statusmessagelist.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QString>
+#include <QtGlobal>
+
+class QFileInfo;
+
+namespace BlackMisc
+{
+    namespace Simulation
+    {
+        namespace XPlane
+        {
+            //! Models of one X-Plane file
+            struct BLACKMISC_EXPORT CModelFingerprint
+            {
+                qint64 lastModified = -1;    //!< modification time, ms since epoch
+                qint64 size = -1;            //!< file size
+                QByteArray context;          //!< whatever else the models depend on, e.g. the package names
+                QString packageName;         //!< name of a CSL package, so unchanged packages are not read for it
+                CAircraftModelList models;   //!< parsed models
+                CStatusMessageList messages; //!< parsing messages
+
+                //! Same file (modification time and size)?
+                bool isFileUnchanged(const QFileInfo &fileInfo) const;
+
+                //! Same file and context?
+                bool isUnchanged(const QFileInfo &fileInfo, const QByteArray &context) const;
+
+                //! Set the fingerprint
+                void setFingerprint(const QFileInfo &fileInfo, const QByteArray &context);
+            };
+
+            //! Stream operators of the fingerprint
+            //! @{
+            BLACKMISC_EXPORT QDataStream &operator <<(QDataStream &stream, const CModelFingerprint &entry);
+            BLACKMISC_EXPORT QDataStream &operator >>(QDataStream &stream, CModelFingerprint &entry);
+            //! @}
+
+            //! Models parsed from X-Plane files (CSL packages, ACF files) during the last scan
+            //! \details A file with same modification time, size and context has not changed,
+            //!          the models are taken from the cache instead of parsing the file again.
+            class BLACKMISC_EXPORT CModelFingerprintCache : public CFileManifest<CModelFingerprint>
+            {
+            public:
+                //! Format version, files with other versions are ignored
+                static constexpr quint32 Version = 2;
+
+                //! Models of one file
+                using Entry = CModelFingerprint;
+
+                //! Ctor
+                CModelFingerprintCache();
+
+                //! Cache file of the X-Plane models
+                static QString cacheFileName();
+            };
+        } // namespace
+    } // namespace
+} // namespace
+
+#endif // guard
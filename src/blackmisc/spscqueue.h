@@ -0,0 +1,117 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SPSCQUEUE_H
+#define BLACKMISC_SPSCQUEUE_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace BlackMisc
+{
+    /*!
+     * Bounded lock-free queue for exactly one producer and one consumer thread.
+     * \details The slots are allocated in the constructor, pushing and popping never allocates or blocks.
+     *          Several producers are fine as long as they are serialized, e.g. by a mutex on the producer side.
+     * \tparam T default constructible, move assignable value
+     */
+    template <class T>
+    class CSpscQueue
+    {
+    public:
+        //! Ctor, the capacity is rounded up to a power of 2
+        explicit CSpscQueue(int capacity) : m_slots(roundUpToPowerOf2(capacity)), m_mask(static_cast<quint32>(m_slots.size()) - 1) {}
+
+        //! Not copyable
+        //! @{
+        CSpscQueue(const CSpscQueue &) = delete;
+        CSpscQueue &operator =(const CSpscQueue &) = delete;
+        //! @}
+
+        //! Producer: append value
+        //! \return false if the queue is full, the value is not added
+        //! @{
+        bool tryPush(const T &value) { T copy(value); return this->tryPush(std::move(copy)); }
+        bool tryPush(T &&value)
+        {
+            const quint32 tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_head.load(std::memory_order_acquire) > m_mask) { return false; }
+            m_slots[tail & m_mask] = std::move(value);
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+        //! @}
+
+        //! Consumer: oldest value without removing it
+        //! \return nullptr if the queue is empty
+        T *front()
+        {
+            const quint32 head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire)) { return nullptr; }
+            return &m_slots[head & m_mask];
+        }
+
+        //! Consumer: remove the oldest value
+        //! \return false if the queue is empty
+        bool tryPop(T &value)
+        {
+            const quint32 head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire)) { return false; }
+            value = std::move(m_slots[head & m_mask]);
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        //! Consumer: remove the oldest value
+        //! \return false if the queue is empty
+        bool pop()
+        {
+            const quint32 head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire)) { return false; }
+            m_slots[head & m_mask] = T();
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        //! Consumer: remove all values
+        void clear() { while (this->pop()) {} }
+
+        //! Number of values, exact only when called by producer or consumer while the other one is idle
+        int size() const { return static_cast<int>(m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire)); }
+
+        //! Empty?
+        bool isEmpty() const { return this->size() == 0; }
+
+        //! Max. number of values
+        int capacity() const { return static_cast<int>(m_slots.size()); }
+
+    private:
+        //! Capacity as power of 2
+        static size_t roundUpToPowerOf2(int capacity)
+        {
+            size_t size = 1;
+            while (size < static_cast<size_t>(qMax(capacity, 1))) { size *= 2; }
+            return size;
+        }
+
+        static constexpr int CacheLine = 64;
+
+        std::vector<T> m_slots;
+        const quint32 m_mask;
+        Q_DECL_UNUSED_MEMBER char m_padding1[CacheLine]; //!< head and tail are written by different threads, keep them in different cache lines
+        std::atomic<quint32> m_head { 0 }; //!< next value read, written by consumer
+        Q_DECL_UNUSED_MEMBER char m_padding2[CacheLine];
+        std::atomic<quint32> m_tail { 0 }; //!< next value written, written by producer
+    };
+} // namespace
+
+#endif // guard
@@ -13,9 +13,15 @@
 #include <QThread>
 #include <QtGlobal>
 #include <QPointer>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThreadPool>
 #include <QTimer>
+#include <atomic>
+#include <memory>
 #include <thread>
 #include <sstream>
+#include <vector>
 
 namespace BlackMisc
 {
@@ -37,4 +43,60 @@ namespace BlackMisc
         const QString id = QString::fromStdString(oss.str());
         return QStringLiteral("%1 (%2) prio %3").arg(id).arg(thread->objectName()).arg(thread->priority());
     }
+
+    namespace
+    {
+        //! Pool task of CThreadUtils::parallelFor
+        class CParallelForTask : public QRunnable
+        {
+        public:
+            //! Ctor
+            CParallelForTask(const std::function<void()> &work, QSemaphore &done) : m_work(work), m_done(done)
+            {
+                this->setAutoDelete(false);
+            }
+
+            //! QRunnable::run
+            virtual void run() override
+            {
+                m_work();
+                m_done.release();
+            }
+
+        private:
+            const std::function<void()> &m_work;
+            QSemaphore &m_done;
+        };
+    }
+
+    void CThreadUtils::parallelFor(int count, int maxThreads, const std::function<void(int)> &function)
+    {
+        if (count < 1) { return; }
+        if (maxThreads < 1) { maxThreads = QThread::idealThreadCount(); }
+        const int threads = qBound(1, maxThreads, count);
+
+        std::atomic_int next { 0 };
+        const std::function<void()> work = [&]
+        {
+            for (int i = next++; i < count; i = next++) { function(i); }
+        };
+
+        QThreadPool *pool = QThreadPool::globalInstance();
+        QSemaphore done;
+        std::vector<std::unique_ptr<CParallelForTask>> tasks;
+        for (int t = 1; t < threads; t++)
+        {
+            tasks.push_back(std::make_unique<CParallelForTask>(work, done));
+            pool->start(tasks.back().get());
+        }
+        work();
+
+        // all indexes are taken, only wait for the tasks which already started
+        int started = 0;
+        for (const auto &task : tasks)
+        {
+            if (!pool->tryTake(task.get())) { started++; }
+        }
+        done.acquire(started);
+    }
 } // ns
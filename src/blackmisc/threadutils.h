@@ -67,6 +67,13 @@ namespace BlackMisc
 
         //! Info about current thread, for debug messages
         static QString currentThreadInfo();
+
+        //! Call function for all indexes 0..count-1 on the global QThreadPool, the calling thread takes part
+        //! \param maxThreads threads used including the calling thread, -1 ideal thread count
+        //! \remark indexes are handed out one by one, so work items of different size are balanced
+        //! \remark blocks until all indexes are done, pool tasks not started by then are taken back,
+        //!         so it also works from a pool thread or with a busy pool
+        static void parallelFor(int count, int maxThreads, const std::function<void(int)> &function);
     };
 } // ns
 
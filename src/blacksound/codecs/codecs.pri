@@ -1,7 +1,9 @@
 SOURCES += \
     $$files($$PWD/codecs/opusdecoder.cpp) \
+    $$files($$PWD/codecs/opusdecoderpool.cpp) \
     $$files($$PWD/codecs/opusencoder.cpp) \
 
 HEADERS += \
     $$files($$PWD/codecs/opusdecoder.h) \
+    $$files($$PWD/codecs/opusdecoderpool.h) \
     $$files($$PWD/codecs/opusencoder.h) \
@@ -23,25 +23,26 @@ namespace BlackSound
             opus_decoder_destroy(m_opusDecoder);
         }
 
-        int COpusDecoder::frameCount(int bufferSize)
+        int COpusDecoder::decode(const QByteArray &opusData, float *samples, int maxSamples)
         {
-            //  seems like bitrate should be required
-            int bitrate = 16;
-            int bytesPerSample = (bitrate / 8) * m_channels;
-            return bufferSize / bytesPerSample;
+            if (opusData.isEmpty() || !m_opusDecoder) { return 0; }
+            const int decoded = opus_decode_float(m_opusDecoder, reinterpret_cast<const unsigned char *>(opusData.constData()), opusData.size(), samples, maxSamples / m_channels, 0);
+            return qMax(decoded, 0);
         }
 
-        QVector<qint16> COpusDecoder::decode(const QByteArray &opusData, int dataLength, int *decodedLength)
+        int COpusDecoder::decodeLost(float *samples, int frameSamples)
         {
-            QVector<qint16> decoded(MaxDataBytes, 0);
-            int count = frameCount(MaxDataBytes);
+            if (!m_opusDecoder || frameSamples <= 0) { return 0; }
+            const int decoded = opus_decode_float(m_opusDecoder, nullptr, 0, samples, frameSamples, 0);
+            return qMax(decoded, 0);
+        }
 
-            if (!opusData.isEmpty())
-            {
-                *decodedLength = opus_decode(m_opusDecoder, reinterpret_cast<const unsigned char *>(opusData.data()), dataLength, decoded.data(), count, 0);
-            }
-            decoded.resize(*decodedLength);
-            return decoded;
+        int COpusDecoder::decodeFec(const QByteArray &nextPacket, float *samples, int frameSamples)
+        {
+            if (nextPacket.isEmpty()) { return this->decodeLost(samples, frameSamples); }
+            if (!m_opusDecoder || frameSamples <= 0) { return 0; }
+            const int decoded = opus_decode_float(m_opusDecoder, reinterpret_cast<const unsigned char *>(nextPacket.constData()), nextPacket.size(), samples, frameSamples, 1);
+            return qMax(decoded, 0);
         }
 
         void COpusDecoder::resetState()
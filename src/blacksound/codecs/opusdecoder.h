@@ -24,6 +24,9 @@ namespace BlackSound
         class BLACKSOUND_EXPORT COpusDecoder
         {
         public:
+            //! Max. samples of a decoded packet per channel, 120ms at 48kHz
+            static constexpr int MaxFrameSamples = 5760;
+
             //! Ctor
             COpusDecoder(int sampleRate, int channels);
 
@@ -36,11 +39,26 @@ namespace BlackSound
             COpusDecoder& operator=(COpusDecoder const&) = delete;
             //! @}
 
-            //! Frame count
-            int frameCount(int bufferSize);
+            //! Decode into a buffer owned by the caller, without allocating
+            //! \param opusData   one OPUS packet
+            //! \param samples    buffer of at least maxSamples samples
+            //! \param maxSamples size of the buffer, MaxFrameSamples * channels for any packet
+            //! \return number of decoded samples per channel, 0 on errors
+            int decode(const QByteArray &opusData, float *samples, int maxSamples);
+
+            //! Conceal a lost packet from the decoder state (packet loss concealment)
+            //! \param samples      buffer of at least frameSamples * channels samples
+            //! \param frameSamples samples per channel of the lost packet
+            //! \return number of samples per channel, 0 on errors
+            int decodeLost(float *samples, int frameSamples);
 
-            //! Decode
-            QVector<qint16> decode(const QByteArray &opusData, int dataLength, int *decodedLength);
+            //! Recover a lost packet from the forward error correction data of the packet following it
+            //! \remark falls back to packet loss concealment if the next packet carries no FEC data
+            //! \param nextPacket   the OPUS packet following the lost one
+            //! \param samples      buffer of at least frameSamples * channels samples
+            //! \param frameSamples samples per channel of the lost packet
+            //! \return number of samples per channel, 0 on errors
+            int decodeFec(const QByteArray &nextPacket, float *samples, int frameSamples);
 
             //! Reset
             void resetState();
@@ -48,8 +66,6 @@ namespace BlackSound
         private:
             OpusDecoder *m_opusDecoder = nullptr;
             int m_channels;
-
-            static constexpr int MaxDataBytes = 4000;
         };
     } // ns
 } // ns
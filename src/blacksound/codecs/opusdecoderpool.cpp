@@ -0,0 +1,72 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "opusdecoderpool.h"
+#include "blackmisc/threadutils.h"
+
+#include <QThread>
+#include <QtGlobal>
+#include <algorithm>
+
+using namespace BlackMisc;
+
+namespace BlackSound
+{
+    namespace Codecs
+    {
+        int COpusDecoderPool::defaultWorkerThreads()
+        {
+            return qBound(0, QThread::idealThreadCount() - 1, 2);
+        }
+
+        COpusDecoderPool::COpusDecoderPool(int sampleRate, int channels, int workerThreads) :
+            m_sampleRate(sampleRate), m_channels(channels), m_workerThreads(qMax(0, workerThreads))
+        { }
+
+        COpusDecoder *COpusDecoderPool::acquire()
+        {
+            std::lock_guard<std::mutex> lock(m_decodersMutex);
+            if (!m_idleDecoders.empty())
+            {
+                COpusDecoder *decoder = m_idleDecoders.back();
+                m_idleDecoders.pop_back();
+                return decoder;
+            }
+            m_decoders.emplace_back(new COpusDecoder(m_sampleRate, m_channels));
+            return m_decoders.back().get();
+        }
+
+        void COpusDecoderPool::release(COpusDecoder *decoder)
+        {
+            if (!decoder) { return; }
+
+            // reset here, so an acquired decoder is ready to decode a new stream
+            decoder->resetState();
+            std::lock_guard<std::mutex> lock(m_decodersMutex);
+            Q_ASSERT_X(std::find(m_idleDecoders.cbegin(), m_idleDecoders.cend(), decoder) == m_idleDecoders.cend(), Q_FUNC_INFO, "Released twice");
+            m_idleDecoders.push_back(decoder);
+        }
+
+        int COpusDecoderPool::getDecoderCount() const
+        {
+            std::lock_guard<std::mutex> lock(m_decodersMutex);
+            return static_cast<int>(m_decoders.size());
+        }
+
+        int COpusDecoderPool::getIdleDecoderCount() const
+        {
+            std::lock_guard<std::mutex> lock(m_decodersMutex);
+            return static_cast<int>(m_idleDecoders.size());
+        }
+
+        void COpusDecoderPool::run(int count, const std::function<void(int)> &function)
+        {
+            CThreadUtils::parallelFor(count, m_workerThreads + 1, function);
+        }
+    } // ns
+} // ns
@@ -0,0 +1,83 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKSOUND_CODECS_OPUSDECODERPOOL_H
+#define BLACKSOUND_CODECS_OPUSDECODERPOOL_H
+
+#include "blacksound/blacksoundexport.h"
+#include "blacksound/codecs/opusdecoder.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace BlackSound
+{
+    namespace Codecs
+    {
+        //! OPUS decoders shared by several streams, decoding the streams in parallel on the global thread pool
+        //! \details A stream acquires a decoder when it starts and releases it when it ends, so decoder states are
+        //!          only allocated for the max. number of streams at the same time and are reused afterwards.
+        class BLACKSOUND_EXPORT COpusDecoderPool
+        {
+        public:
+            //! Default number of pool threads, at most 2 and leaving a core for the calling thread
+            static int defaultWorkerThreads();
+
+            //! Ctor
+            //! \param sampleRate    sample rate of the decoders
+            //! \param channels      channels of the decoders
+            //! \param workerThreads pool threads decoding in addition to the calling thread, 0 decodes sequentially
+            COpusDecoderPool(int sampleRate, int channels, int workerThreads = defaultWorkerThreads());
+
+            //! Not copyable and assignable
+            //! @{
+            COpusDecoderPool(const COpusDecoderPool &) = delete;
+            COpusDecoderPool &operator =(const COpusDecoderPool &) = delete;
+            //! @}
+
+            //! Decoder with a reset state, owned by the pool
+            //! \threadsafe
+            COpusDecoder *acquire();
+
+            //! Return a decoder
+            //! \threadsafe
+            void release(COpusDecoder *decoder);
+
+            //! Number of decoders created
+            //! \threadsafe
+            int getDecoderCount() const;
+
+            //! Number of decoders not acquired
+            //! \threadsafe
+            int getIdleDecoderCount() const;
+
+            //! Number of pool threads used in addition to the calling thread
+            int getWorkerThreadCount() const { return m_workerThreads; }
+
+            //! Call function(i) for i in [0, count), on the global thread pool and the calling thread if count > 1
+            //! \remark returns when all calls are done, calls not started by a busy pool are done by the calling thread
+            //! \sa BlackMisc::CThreadUtils::parallelFor
+            void run(int count, const std::function<void(int)> &function);
+
+        private:
+            const int m_sampleRate;
+            const int m_channels;
+            const int m_workerThreads;
+
+            mutable std::mutex m_decodersMutex;
+            std::vector<std::unique_ptr<COpusDecoder>> m_decoders;
+            std::vector<COpusDecoder *> m_idleDecoders;
+        };
+    } // ns
+} // ns
+
+#endif // guard
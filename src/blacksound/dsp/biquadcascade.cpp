@@ -0,0 +1,98 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blacksound/dsp/biquadcascade.h"
+
+#include <QtGlobal>
+#include <algorithm>
+
+namespace BlackSound
+{
+    namespace Dsp
+    {
+        void CBiQuadCascade::addStage(const BiQuadFilter &filter)
+        {
+            Q_ASSERT_X(m_stages < MaxStages, Q_FUNC_INFO, "Too many stages");
+            if (m_stages >= MaxStages) { return; }
+
+            // transposed direct form II uses the same normalized coefficients as the direct form of BiQuadFilter
+            double b0, b1, b2, a1, a2;
+            filter.getCoefficients(b0, b1, b2, a1, a2);
+            float *c = m_coefficients + m_stages * CDspKernels::BiQuadCoefficients;
+            c[0] = static_cast<float>(b0);
+            c[1] = static_cast<float>(b1);
+            c[2] = static_cast<float>(b2);
+            c[3] = static_cast<float>(a1);
+            c[4] = static_cast<float>(a2);
+            m_stages++;
+        }
+
+        bool CBiQuadCascade::hasSameCoefficients(const CBiQuadCascade &other) const
+        {
+            return m_stages == other.m_stages && std::equal(m_coefficients, m_coefficients + m_stages * CDspKernels::BiQuadCoefficients, other.m_coefficients);
+        }
+
+        void CBiQuadCascade::process(float *samples, int count)
+        {
+            CDspKernels::biQuadCascade(m_coefficients, m_stages, m_state, samples, 1, count);
+        }
+
+        void CBiQuadCascade::reset()
+        {
+            std::fill(std::begin(m_state), std::end(m_state), 0.0f);
+        }
+
+        CBiQuadCascadeLanes::CBiQuadCascadeLanes(int maxLanes, int maxBlockSize) :
+            m_maxLanes(qMax(1, maxLanes)), m_maxBlockSize(maxBlockSize),
+            m_samples(m_maxLanes * maxBlockSize, 0.0f),
+            m_state(m_maxLanes * CBiQuadCascade::MaxStages * 2, 0.0f)
+        { }
+
+        void CBiQuadCascadeLanes::process(CBiQuadCascade *const *cascades, float *const *blocks, int count, int blockSize)
+        {
+            Q_ASSERT_X(blockSize <= m_maxBlockSize, Q_FUNC_INFO, "Block too large");
+            blockSize = qMin(blockSize, m_maxBlockSize);
+            for (int i = 0; i < count; i += m_maxLanes)
+            {
+                this->processLanes(cascades + i, blocks + i, qMin(m_maxLanes, count - i), blockSize);
+            }
+        }
+
+        void CBiQuadCascadeLanes::processLanes(CBiQuadCascade *const *cascades, float *const *blocks, int lanes, int blockSize)
+        {
+            if (lanes == 1)
+            {
+                cascades[0]->process(blocks[0], blockSize);
+                return;
+            }
+
+            const CBiQuadCascade &first = *cascades[0];
+            const int stateValues = first.m_stages * 2;
+            float *samples = m_samples.data();
+            float *state = m_state.data();
+            for (int lane = 0; lane < lanes; lane++)
+            {
+                const CBiQuadCascade &cascade = *cascades[lane];
+                Q_ASSERT_X(cascade.hasSameCoefficients(first), Q_FUNC_INFO, "Lanes need the same filters");
+                for (int i = 0; i < stateValues; i++) { state[i * lanes + lane] = cascade.m_state[i]; }
+                const float *block = blocks[lane];
+                for (int n = 0; n < blockSize; n++) { samples[n * lanes + lane] = block[n]; }
+            }
+
+            CDspKernels::biQuadCascade(first.m_coefficients, first.m_stages, state, samples, lanes, blockSize);
+
+            for (int lane = 0; lane < lanes; lane++)
+            {
+                CBiQuadCascade &cascade = *cascades[lane];
+                for (int i = 0; i < stateValues; i++) { cascade.m_state[i] = state[i * lanes + lane]; }
+                float *block = blocks[lane];
+                for (int n = 0; n < blockSize; n++) { block[n] = samples[n * lanes + lane]; }
+            }
+        }
+    } // ns
+} // ns
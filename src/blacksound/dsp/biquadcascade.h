@@ -0,0 +1,84 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKSOUND_DSP_BIQUADCASCADE_H
+#define BLACKSOUND_DSP_BIQUADCASCADE_H
+
+#include "blacksound/dsp/biquadfilter.h"
+#include "blacksound/dsp/dspkernels.h"
+#include "blacksound/blacksoundexport.h"
+
+#include <QVector>
+
+namespace BlackSound
+{
+    namespace Dsp
+    {
+        //! Biquad filters in series, single precision transposed direct form II
+        //! \remark the filter state is kept per cascade, so several cascades with the same coefficients
+        //!         can be filtered together, see CBiQuadCascadeLanes
+        class BLACKSOUND_EXPORT CBiQuadCascade
+        {
+        public:
+            //! Max. number of stages
+            static constexpr int MaxStages = 8;
+
+            //! Ctor
+            CBiQuadCascade() = default;
+
+            //! Add a filter as the last stage
+            void addStage(const BiQuadFilter &filter);
+
+            //! Number of stages
+            int stages() const { return m_stages; }
+
+            //! Same filters as other cascade?
+            bool hasSameCoefficients(const CBiQuadCascade &other) const;
+
+            //! Filter samples in place
+            void process(float *samples, int count);
+
+            //! Clear the filter state
+            void reset();
+
+        private:
+            friend class CBiQuadCascadeLanes;
+
+            int   m_stages = 0;
+            float m_coefficients[MaxStages * CDspKernels::BiQuadCoefficients] = {};
+            float m_state[MaxStages * 2] = {};
+        };
+
+        //! Filters the blocks of several cascades with the same coefficients in parallel SIMD lanes
+        //! \remark the buffers are allocated once, filtering does not allocate
+        class BLACKSOUND_EXPORT CBiQuadCascadeLanes
+        {
+        public:
+            //! Ctor
+            //! \param maxLanes     cascades filtered at once, more cascades are filtered in several runs
+            //! \param maxBlockSize max. samples per block
+            CBiQuadCascadeLanes(int maxLanes, int maxBlockSize);
+
+            //! Filter blocks[i] with cascades[i] in place
+            void process(CBiQuadCascade *const *cascades, float *const *blocks, int count, int blockSize);
+
+        private:
+            //! Filter up to m_maxLanes cascades
+            void processLanes(CBiQuadCascade *const *cascades, float *const *blocks, int lanes, int blockSize);
+
+            int m_maxLanes = 1;
+            int m_maxBlockSize = 0;
+            QVector<float> m_samples; //!< interleaved samples
+            QVector<float> m_state;   //!< state of all lanes
+        };
+    } // ns
+} // ns
+
+#endif // guard
@@ -48,6 +48,15 @@ namespace BlackSound
             m_a4 = aa2 / aa0;
         }
 
+        void BiQuadFilter::getCoefficients(double &b0, double &b1, double &b2, double &a1, double &a2) const
+        {
+            b0 = m_a0;
+            b1 = m_a1;
+            b2 = m_a2;
+            a1 = m_a3;
+            a2 = m_a4;
+        }
+
         void BiQuadFilter::setLowPassFilter(float sampleRate, float cutoffFrequency, float q)
         {
             // H(s) = 1 / (s^2 + s/Q + 1)
@@ -42,6 +42,9 @@ namespace BlackSound
             static BiQuadFilter peakingEQ(float sampleRate, float centreFrequency, float q, float dbGain);
             //! @}
 
+            //! Normalized coefficients, y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2
+            void getCoefficients(double &b0, double &b1, double &b2, double &a1, double &a2) const;
+
         private:
             double m_a0 = 0.0;
             double m_a1 = 0.0;
@@ -0,0 +1,326 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blacksound/dsp/dspkernels.h"
+#include "blackmisc/cpufeatures.h"
+
+#include <QtGlobal>
+
+namespace BlackSound
+{
+    namespace Dsp
+    {
+        namespace
+        {
+            //! \private Biquad cascade, reference, lanes from "fromLane" on
+            void biQuadCascadeScalar(const float *coefficients, int stages, float *state, float *samples, int lanes, int fromLane, int count)
+            {
+                for (int lane = fromLane; lane < lanes; lane++)
+                {
+                    for (int stage = 0; stage < stages; stage++)
+                    {
+                        const float *c = coefficients + stage * CDspKernels::BiQuadCoefficients;
+                        const float b0 = c[0], b1 = c[1], b2 = c[2], a1 = c[3], a2 = c[4];
+                        float &s1 = state[(stage * 2) * lanes + lane];
+                        float &s2 = state[(stage * 2 + 1) * lanes + lane];
+                        float *x = samples + lane;
+                        for (int n = 0; n < count; n++, x += lanes)
+                        {
+                            const float in  = *x;
+                            const float out = b0 * in + s1;
+                            s1 = b1 * in - a1 * out + s2;
+                            s2 = b2 * in - a2 * out;
+                            *x = out;
+                        }
+                    }
+                }
+            }
+
+            //! \private Gain, reference
+            void gainScalar(float *samples, int from, int count, float gain)
+            {
+                for (int n = from; n < count; n++) { samples[n] *= gain; }
+            }
+
+            //! \private Mix, reference
+            void mixScalar(float *out, const float *in, int from, int count)
+            {
+                for (int n = from; n < count; n++) { out[n] += in[n]; }
+            }
+
+            //! \private Clip, reference, same as min(max(x, -limit), limit) of the SIMD code
+            void clipScalar(float *samples, int from, int count, float limit)
+            {
+                for (int n = from; n < count; n++)
+                {
+                    const float x = samples[n] > -limit ? samples[n] : -limit;
+                    samples[n] = x < limit ? x : limit;
+                }
+            }
+
+#if defined(BLACK_KERNELS_X86)
+            //! \private 4 lanes at once, from "fromLane" on as long as 4 lanes are left
+            //! \return first lane not filtered
+            BLACK_TARGET_SSE2 int biQuadCascadeSse2(const float *coefficients, int stages, float *state, float *samples, int lanes, int fromLane, int count)
+            {
+                int lane = fromLane;
+                for (; lane + 4 <= lanes; lane += 4)
+                {
+                    for (int stage = 0; stage < stages; stage++)
+                    {
+                        const float *c = coefficients + stage * CDspKernels::BiQuadCoefficients;
+                        const __m128 b0 = _mm_set1_ps(c[0]);
+                        const __m128 b1 = _mm_set1_ps(c[1]);
+                        const __m128 b2 = _mm_set1_ps(c[2]);
+                        const __m128 a1 = _mm_set1_ps(c[3]);
+                        const __m128 a2 = _mm_set1_ps(c[4]);
+                        float *state1 = state + (stage * 2) * lanes + lane;
+                        float *state2 = state + (stage * 2 + 1) * lanes + lane;
+                        __m128 s1 = _mm_loadu_ps(state1);
+                        __m128 s2 = _mm_loadu_ps(state2);
+                        float *x = samples + lane;
+                        for (int n = 0; n < count; n++, x += lanes)
+                        {
+                            const __m128 in  = _mm_loadu_ps(x);
+                            const __m128 out = _mm_add_ps(_mm_mul_ps(b0, in), s1);
+                            s1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, in), _mm_mul_ps(a1, out)), s2);
+                            s2 = _mm_sub_ps(_mm_mul_ps(b2, in), _mm_mul_ps(a2, out));
+                            _mm_storeu_ps(x, out);
+                        }
+                        _mm_storeu_ps(state1, s1);
+                        _mm_storeu_ps(state2, s2);
+                    }
+                }
+                return lane;
+            }
+
+            //! \private 8 lanes at once, from "fromLane" on as long as 8 lanes are left
+            //! \return first lane not filtered
+            BLACK_TARGET_AVX int biQuadCascadeAvx(const float *coefficients, int stages, float *state, float *samples, int lanes, int fromLane, int count)
+            {
+                int lane = fromLane;
+                for (; lane + 8 <= lanes; lane += 8)
+                {
+                    for (int stage = 0; stage < stages; stage++)
+                    {
+                        const float *c = coefficients + stage * CDspKernels::BiQuadCoefficients;
+                        const __m256 b0 = _mm256_set1_ps(c[0]);
+                        const __m256 b1 = _mm256_set1_ps(c[1]);
+                        const __m256 b2 = _mm256_set1_ps(c[2]);
+                        const __m256 a1 = _mm256_set1_ps(c[3]);
+                        const __m256 a2 = _mm256_set1_ps(c[4]);
+                        float *state1 = state + (stage * 2) * lanes + lane;
+                        float *state2 = state + (stage * 2 + 1) * lanes + lane;
+                        __m256 s1 = _mm256_loadu_ps(state1);
+                        __m256 s2 = _mm256_loadu_ps(state2);
+                        float *x = samples + lane;
+                        for (int n = 0; n < count; n++, x += lanes)
+                        {
+                            const __m256 in  = _mm256_loadu_ps(x);
+                            const __m256 out = _mm256_add_ps(_mm256_mul_ps(b0, in), s1);
+                            s1 = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(b1, in), _mm256_mul_ps(a1, out)), s2);
+                            s2 = _mm256_sub_ps(_mm256_mul_ps(b2, in), _mm256_mul_ps(a2, out));
+                            _mm256_storeu_ps(x, out);
+                        }
+                        _mm256_storeu_ps(state1, s1);
+                        _mm256_storeu_ps(state2, s2);
+                    }
+                }
+                return lane;
+            }
+
+            BLACK_TARGET_SSE2 void gainSse2(float *samples, int count, float gain)
+            {
+                const __m128 g = _mm_set1_ps(gain);
+                int n = 0;
+                for (; n + 4 <= count; n += 4)
+                {
+                    _mm_storeu_ps(samples + n, _mm_mul_ps(_mm_loadu_ps(samples + n), g));
+                }
+                gainScalar(samples, n, count, gain);
+            }
+
+            BLACK_TARGET_AVX void gainAvx(float *samples, int count, float gain)
+            {
+                const __m256 g = _mm256_set1_ps(gain);
+                int n = 0;
+                for (; n + 8 <= count; n += 8)
+                {
+                    _mm256_storeu_ps(samples + n, _mm256_mul_ps(_mm256_loadu_ps(samples + n), g));
+                }
+                gainScalar(samples, n, count, gain);
+            }
+
+            BLACK_TARGET_SSE2 void mixSse2(float *out, const float *in, int count)
+            {
+                int n = 0;
+                for (; n + 4 <= count; n += 4)
+                {
+                    _mm_storeu_ps(out + n, _mm_add_ps(_mm_loadu_ps(out + n), _mm_loadu_ps(in + n)));
+                }
+                mixScalar(out, in, n, count);
+            }
+
+            BLACK_TARGET_AVX void mixAvx(float *out, const float *in, int count)
+            {
+                int n = 0;
+                for (; n + 8 <= count; n += 8)
+                {
+                    _mm256_storeu_ps(out + n, _mm256_add_ps(_mm256_loadu_ps(out + n), _mm256_loadu_ps(in + n)));
+                }
+                mixScalar(out, in, n, count);
+            }
+
+            BLACK_TARGET_SSE2 void clipSse2(float *samples, int count, float limit)
+            {
+                const __m128 upper = _mm_set1_ps(limit);
+                const __m128 lower = _mm_set1_ps(-limit);
+                int n = 0;
+                for (; n + 4 <= count; n += 4)
+                {
+                    _mm_storeu_ps(samples + n, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(samples + n), lower), upper));
+                }
+                clipScalar(samples, n, count, limit);
+            }
+
+            BLACK_TARGET_AVX void clipAvx(float *samples, int count, float limit)
+            {
+                const __m256 upper = _mm256_set1_ps(limit);
+                const __m256 lower = _mm256_set1_ps(-limit);
+                int n = 0;
+                for (; n + 8 <= count; n += 8)
+                {
+                    _mm256_storeu_ps(samples + n, _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(samples + n), lower), upper));
+                }
+                clipScalar(samples, n, count, limit);
+            }
+
+            //! \private Flush denormal results to zero (MXCSR FTZ bit), applies to the scalar SSE code as well
+            //! \return previous control/status register
+            BLACK_TARGET_SSE2 unsigned int enterFlushToZero()
+            {
+                const unsigned int csr = _mm_getcsr();
+                _mm_setcsr(csr | 0x8000);
+                return csr;
+            }
+
+            //! \private Restore control/status register
+            BLACK_TARGET_SSE2 void leaveFlushToZero(unsigned int csr)
+            {
+                _mm_setcsr(csr);
+            }
+
+#endif
+
+            //! \private Selected instruction set
+            BlackMisc::CKernelInstructionSet<CDspKernels::InstructionSet> &selectedInstructionSet()
+            {
+                static BlackMisc::CKernelInstructionSet<CDspKernels::InstructionSet> set(CDspKernels::detectedInstructionSet());
+                return set;
+            }
+        }
+
+        CDspKernels::InstructionSet CDspKernels::detectedInstructionSet()
+        {
+            static const InstructionSet detected = BlackMisc::CCpuFeatures::isSupported(BlackMisc::CCpuFeatures::AVX) ? AVX :
+                                                   BlackMisc::CCpuFeatures::isSupported(BlackMisc::CCpuFeatures::SSE2) ? SSE2 : Scalar;
+            return detected;
+        }
+
+        CDspKernels::InstructionSet CDspKernels::instructionSet()
+        {
+            return selectedInstructionSet().get();
+        }
+
+        bool CDspKernels::setInstructionSet(InstructionSet set)
+        {
+            if (!isSupported(set)) { return false; }
+            selectedInstructionSet().set(set);
+            return true;
+        }
+
+        const QString &CDspKernels::instructionSetToString(InstructionSet set)
+        {
+            static const QString scalar("scalar");
+            static const QString sse2("SSE2");
+            static const QString avx("AVX");
+            switch (set)
+            {
+            case SSE2: return sse2;
+            case AVX: return avx;
+            default: break;
+            }
+            return scalar;
+        }
+
+        void CDspKernels::biQuadCascade(const float *coefficients, int stages, float *state, float *samples, int lanes, int count)
+        {
+            if (lanes < 1 || count < 1) { return; }
+            int lane = 0;
+#if defined(BLACK_KERNELS_X86)
+            // FTZ also for the scalar kernel, so all instruction sets yield the same samples
+            const bool ftz = detectedInstructionSet() != Scalar;
+            const unsigned int csr = ftz ? enterFlushToZero() : 0;
+            switch (instructionSet())
+            {
+            case AVX:
+                lane = biQuadCascadeAvx(coefficients, stages, state, samples, lanes, 0, count);
+                lane = biQuadCascadeSse2(coefficients, stages, state, samples, lanes, lane, count);
+                break;
+            case SSE2:
+                lane = biQuadCascadeSse2(coefficients, stages, state, samples, lanes, 0, count);
+                break;
+            default: break;
+            }
+            biQuadCascadeScalar(coefficients, stages, state, samples, lanes, lane, count);
+            if (ftz) { leaveFlushToZero(csr); }
+#else
+            biQuadCascadeScalar(coefficients, stages, state, samples, lanes, lane, count);
+#endif
+        }
+
+        void CDspKernels::gain(float *samples, int count, float gain)
+        {
+#if defined(BLACK_KERNELS_X86)
+            switch (instructionSet())
+            {
+            case AVX: gainAvx(samples, count, gain); return;
+            case SSE2: gainSse2(samples, count, gain); return;
+            default: break;
+            }
+#endif
+            gainScalar(samples, 0, count, gain);
+        }
+
+        void CDspKernels::mix(float *out, const float *in, int count)
+        {
+#if defined(BLACK_KERNELS_X86)
+            switch (instructionSet())
+            {
+            case AVX: mixAvx(out, in, count); return;
+            case SSE2: mixSse2(out, in, count); return;
+            default: break;
+            }
+#endif
+            mixScalar(out, in, 0, count);
+        }
+
+        void CDspKernels::clip(float *samples, int count, float limit)
+        {
+#if defined(BLACK_KERNELS_X86)
+            switch (instructionSet())
+            {
+            case AVX: clipAvx(samples, count, limit); return;
+            case SSE2: clipSse2(samples, count, limit); return;
+            default: break;
+            }
+#endif
+            clipScalar(samples, 0, count, limit);
+        }
+    } // ns
+} // ns
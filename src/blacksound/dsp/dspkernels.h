@@ -0,0 +1,80 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKSOUND_DSP_DSPKERNELS_H
+#define BLACKSOUND_DSP_DSPKERNELS_H
+
+#include "blacksound/blacksoundexport.h"
+
+#include <QString>
+
+namespace BlackSound
+{
+    namespace Dsp
+    {
+        //! DSP kernels working on blocks of float samples
+        //! \remark the instruction set is chosen at runtime, the scalar code is the reference and the fallback
+        //! \remark FMA is not used and the operation order is the same, so all instruction sets yield identical samples
+        class BLACKSOUND_EXPORT CDspKernels
+        {
+        public:
+            //! Instruction sets
+            enum InstructionSet
+            {
+                Scalar,
+                SSE2, //!< 4 floats per register
+                AVX   //!< 8 floats per register
+            };
+
+            //! Number of coefficients per biquad stage: b0, b1, b2, a1, a2
+            static constexpr int BiQuadCoefficients = 5;
+
+            //! No objects, just static
+            CDspKernels() = delete;
+
+            //! Best instruction set supported by CPU and OS
+            static InstructionSet detectedInstructionSet();
+
+            //! Instruction set used by the kernels
+            static InstructionSet instructionSet();
+
+            //! Use given instruction set, mainly for UNIT tests and benchmarks
+            //! \return false if not supported
+            static bool setInstructionSet(InstructionSet set);
+
+            //! Is instruction set supported?
+            static bool isSupported(InstructionSet set) { return set <= detectedInstructionSet(); }
+
+            //! Instruction set as string
+            static const QString &instructionSetToString(InstructionSet set);
+
+            //! Cascade of biquads in transposed direct form II, one SIMD lane per stream
+            //! \param coefficients b0, b1, b2, a1, a2 (a0 normalized to 1) of each stage
+            //! \param stages       number of stages
+            //! \param state        2 values per stage and lane, state[(stage * 2 + i) * lanes + lane]
+            //! \param samples      interleaved samples of all lanes, samples[n * lanes + lane], filtered in place
+            //! \param lanes        number of streams
+            //! \param count        number of samples per lane
+            //! \remark denormals are flushed to zero while filtering, as decaying filters otherwise stall the CPU
+            static void biQuadCascade(const float *coefficients, int stages, float *state, float *samples, int lanes, int count);
+
+            //! samples *= gain
+            static void gain(float *samples, int count, float gain);
+
+            //! out += in
+            static void mix(float *out, const float *in, int count);
+
+            //! Limit the samples to [-limit, limit]
+            static void clip(float *samples, int count, float limit);
+        };
+    } // ns
+} // ns
+
+#endif // guard
@@ -0,0 +1,90 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blacksound/dsp/timestretch.h"
+
+#include <QtGlobal>
+#include <algorithm>
+#include <cmath>
+
+namespace BlackSound
+{
+    namespace Dsp
+    {
+        int CTimeStretch::shrink(const float *input, int count, float *output, int minSamples, int maxSamples, int overlap)
+        {
+            // splice in the middle, the removed part follows the splice position
+            maxSamples = qMin(maxSamples, count - overlap);
+            const int from = (count - overlap - maxSamples) / 2;
+            if (minSamples < 1 || minSamples > maxSamples || from < 0)
+            {
+                std::copy(input, input + count, output);
+                return count;
+            }
+            const int lag = bestLag(input, from, minSamples, maxSamples, overlap, 1);
+            return splice(input, count, output, from, lag, overlap);
+        }
+
+        int CTimeStretch::grow(const float *input, int count, float *output, int minSamples, int maxSamples, int overlap)
+        {
+            // splice in the middle, the repeated part precedes the splice position
+            const int from = count / 2;
+            maxSamples = qMin(maxSamples, from);
+            if (minSamples < 1 || minSamples > maxSamples || from + overlap > count)
+            {
+                std::copy(input, input + count, output);
+                return count;
+            }
+            const int lag = bestLag(input, from, minSamples, maxSamples, overlap, -1);
+            return splice(input, count, output, from, -lag, overlap);
+        }
+
+        int CTimeStretch::bestLag(const float *input, int from, int minLag, int maxLag, int overlap, int sign)
+        {
+            // cross correlation normalized by the energy of the candidate
+            const float *reference = input + from;
+            int best = minLag;
+            double bestScore = -2.0;
+            for (int lag = minLag; lag <= maxLag; lag++)
+            {
+                const float *candidate = reference + sign * lag;
+                double correlation = 0.0;
+                double energy = 0.0;
+                for (int i = 0; i < overlap; i++)
+                {
+                    correlation += static_cast<double>(reference[i]) * candidate[i];
+                    energy += static_cast<double>(candidate[i]) * candidate[i];
+                }
+                const double score = energy > 0.0 ? correlation / std::sqrt(energy) : 0.0;
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    best = lag;
+                }
+            }
+            return best;
+        }
+
+        int CTimeStretch::splice(const float *input, int count, float *output, int splice, int lag, int overlap)
+        {
+            std::copy(input, input + splice, output);
+            const float *fadeOut = input + splice;
+            const float *fadeIn = input + splice + lag;
+            float *out = output + splice;
+            const float step = 1.0f / static_cast<float>(overlap + 1);
+            for (int i = 0; i < overlap; i++)
+            {
+                const float w = static_cast<float>(i + 1) * step;
+                out[i] = fadeOut[i] * (1.0f - w) + fadeIn[i] * w;
+            }
+            const int rest = count - (splice + lag + overlap);
+            std::copy(fadeIn + overlap, fadeIn + overlap + rest, out + overlap);
+            return splice + overlap + rest;
+        }
+    } // ns
+} // ns
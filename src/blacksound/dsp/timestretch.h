@@ -0,0 +1,60 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKSOUND_DSP_TIMESTRETCH_H
+#define BLACKSOUND_DSP_TIMESTRETCH_H
+
+#include "blacksound/blacksoundexport.h"
+
+namespace BlackSound
+{
+    namespace Dsp
+    {
+        //! Shortens or lengthens a block of speech without changing its pitch
+        //! \details Waveform similarity overlap-add with a single splice: the block is cross faded into a copy of itself
+        //!          shifted by the lag most similar to the splice position, so (pitch) periods are removed or repeated.
+        //!          Used by jitter buffers to adapt the latency, changes of a few milliseconds per block are inaudible.
+        class BLACKSOUND_EXPORT CTimeStretch
+        {
+        public:
+            //! No objects, just static
+            CTimeStretch() = delete;
+
+            //! Remove between minSamples and maxSamples samples
+            //! \param input      block of count samples
+            //! \param count      samples in input
+            //! \param output     buffer of at least count samples
+            //! \param minSamples min. samples removed
+            //! \param maxSamples max. samples removed
+            //! \param overlap    samples of the cross fade
+            //! \return number of samples in output, count if the block is too short
+            static int shrink(const float *input, int count, float *output, int minSamples, int maxSamples, int overlap);
+
+            //! Add between minSamples and maxSamples samples
+            //! \param input      block of count samples
+            //! \param count      samples in input
+            //! \param output     buffer of at least count + maxSamples samples
+            //! \param minSamples min. samples added
+            //! \param maxSamples max. samples added
+            //! \param overlap    samples of the cross fade
+            //! \return number of samples in output, count if the block is too short
+            static int grow(const float *input, int count, float *output, int minSamples, int maxSamples, int overlap);
+
+        private:
+            //! Lag in [minLag, maxLag] where input[from + lag ...] is most similar to input[from ...]
+            static int bestLag(const float *input, int from, int minLag, int maxLag, int overlap, int sign);
+
+            //! output = input[0, splice), cross fade of input[splice ...] into input[splice + lag ...], rest
+            static int splice(const float *input, int count, float *output, int splice, int lag, int overlap);
+        };
+    } // ns
+} // ns
+
+#endif // guard
@@ -2,6 +2,7 @@
 #include "blacksound/audioutilities.h"
 
 #include <QDebug>
+#include <algorithm>
 
 namespace BlackSound
 {
@@ -13,32 +14,102 @@ namespace BlackSound
             const QString on = QStringLiteral("%1 format: '%2'").arg(this->metaObject()->className(), BlackSound::toQString(format));
             this->setObjectName(on);
 
-            // Set buffer size to 10 secs
-            m_maxBufferSize = format.bytesForDuration(10 * 1000 * 1000);
+            // 2 secs, longer than any delay of the receivers, allocated once as the buffer is shared by 2 threads
+            const int samplesPerSecond = qMax(format.sampleRate() * format.channelCount(), MaxBlockSize);
+            m_audioBuffer.fill(0.0f, 2 * samplesPerSecond);
         }
 
-        void CBufferedWaveProvider::addSamples(const QVector<float> &samples)
+        void CBufferedWaveProvider::addSamples(const float *samples, int count)
         {
-            int delta = m_audioBuffer.size() + samples.size() - m_maxBufferSize;
-            if (delta > 0)
-            {
-                m_audioBuffer.remove(0, delta);
-            }
-            m_audioBuffer.append(samples);
+            if (count <= 0) { return; }
+            this->write(samples, count);
         }
 
-        int CBufferedWaveProvider::readSamples(QVector<float> &samples, qint64 count)
+        void CBufferedWaveProvider::addSilence(int count)
         {
-            const int len = static_cast<int>(qMin(count, static_cast<qint64>(m_audioBuffer.size())));
-            samples = m_audioBuffer.mid(0, len);
-            // if (len != 0) qDebug() << "Reading" << count << "samples." << m_audioBuffer.size() << "currently in the buffer.";
-            m_audioBuffer.remove(0, len);
-            return len;
+            if (count <= 0) { return; }
+            this->write(nullptr, count);
+        }
+
+        float *CBufferedWaveProvider::writableSamples(int &count)
+        {
+            const quint64 write = m_writePosition.load(std::memory_order_relaxed);
+            const quint64 read = m_readPosition.load(std::memory_order_acquire);
+            const int capacity = m_audioBuffer.size();
+            const int writeIndex = static_cast<int>(write % static_cast<quint64>(capacity));
+            count = qMin(capacity - static_cast<int>(write - read), capacity - writeIndex);
+            return m_audioBuffer.data() + writeIndex;
+        }
+
+        void CBufferedWaveProvider::commitSamples(int count)
+        {
+            if (count <= 0) { return; }
+            const quint64 write = m_writePosition.load(std::memory_order_relaxed);
+            m_writePosition.store(write + static_cast<quint64>(count), std::memory_order_release);
         }
 
         void CBufferedWaveProvider::clearBuffer()
         {
-            m_audioBuffer.clear();
+            // the consumer owns the read position, it skips the samples when reading
+            m_discardPosition.store(m_writePosition.load(std::memory_order_relaxed), std::memory_order_release);
+        }
+
+        int CBufferedWaveProvider::readSamples(float *samples, int count)
+        {
+            const quint64 discard = m_discardPosition.load(std::memory_order_acquire);
+            const quint64 read = qMax(m_readPosition.load(std::memory_order_relaxed), discard);
+            const quint64 write = m_writePosition.load(std::memory_order_acquire);
+
+            const int capacity = m_audioBuffer.size();
+            const int len = static_cast<int>(qMin<quint64>(static_cast<quint64>(count), write - read));
+            const int readIndex = static_cast<int>(read % static_cast<quint64>(capacity));
+            const int first = qMin(len, capacity - readIndex);
+            const float *buffer = m_audioBuffer.constData();
+            std::copy(buffer + readIndex, buffer + readIndex + first, samples);
+            std::copy(buffer, buffer + (len - first), samples + first);
+            m_readPosition.store(read + static_cast<quint64>(len), std::memory_order_release);
+
+            if (len < count && m_lastReadComplete) { m_underruns.fetch_add(1, std::memory_order_relaxed); }
+            m_lastReadComplete = len == count;
+            fillSilence(samples, len, count);
+            return len;
+        }
+
+        int CBufferedWaveProvider::getBufferedSamples() const
+        {
+            const quint64 write = m_writePosition.load(std::memory_order_acquire);
+            const quint64 read = qMax(m_readPosition.load(std::memory_order_acquire), m_discardPosition.load(std::memory_order_acquire));
+            return write > read ? static_cast<int>(write - read) : 0;
+        }
+
+        void CBufferedWaveProvider::write(const float *samples, int count)
+        {
+            // only the consumer may free slots, so samples not fitting are dropped
+            const quint64 write = m_writePosition.load(std::memory_order_relaxed);
+            const quint64 read = m_readPosition.load(std::memory_order_acquire);
+            const int capacity = m_audioBuffer.size();
+            const int free = capacity - static_cast<int>(write - read);
+            if (count > free)
+            {
+                m_droppedSamples.fetch_add(static_cast<quint32>(count - free), std::memory_order_relaxed);
+                count = free;
+            }
+            if (count <= 0) { return; }
+
+            const int writeIndex = static_cast<int>(write % static_cast<quint64>(capacity));
+            const int first = qMin(count, capacity - writeIndex);
+            float *buffer = m_audioBuffer.data();
+            if (samples)
+            {
+                std::copy(samples, samples + first, buffer + writeIndex);
+                std::copy(samples + first, samples + count, buffer);
+            }
+            else
+            {
+                std::fill(buffer + writeIndex, buffer + writeIndex + first, 0.0f);
+                std::fill(buffer, buffer + (count - first), 0.0f);
+            }
+            m_writePosition.store(write + static_cast<quint64>(count), std::memory_order_release);
         }
     } // ns
 } // ns
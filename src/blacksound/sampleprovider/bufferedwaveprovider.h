@@ -17,12 +17,15 @@
 #include <QAudioFormat>
 #include <QByteArray>
 #include <QVector>
+#include <atomic>
 
 namespace BlackSound
 {
     namespace SampleProvider
     {
         //! Buffered wave generator
+        //! \details Ring buffer with a fixed size. One thread adds samples (producer), one thread reads them (consumer),
+        //!          neither of them blocks or allocates.
         class BLACKSOUND_EXPORT CBufferedWaveProvider : public ISampleProvider
         {
             Q_OBJECT
@@ -31,21 +34,53 @@ namespace BlackSound
             //! Ctor
             CBufferedWaveProvider(const QAudioFormat &format, QObject *parent = nullptr);
 
-            //! Add samples
-            void addSamples(const QVector<float> &samples);
+            //! Producer: add samples
+            //! \remark if the buffer is full, the samples not fitting are dropped
+            //! @{
+            void addSamples(const QVector<float> &samples) { this->addSamples(samples.constData(), samples.size()); }
+            void addSamples(const float *samples, int count);
+            //! @}
 
-            //! ISampleProvider::readSamples
-            virtual int readSamples(QVector<float> &samples, qint64 count) override;
+            //! Producer: add silence
+            void addSilence(int count);
 
-            //! Bytes from buffer
-            int getBufferedBytes() const { return m_audioBuffer.size(); }
+            //! Producer: free space following the samples added, to write to directly (e.g. by a decoder)
+            //! \param count contiguous samples which can be written
+            //! \remark the samples become visible to the consumer with commitSamples
+            float *writableSamples(int &count);
 
-            //! Clear the buffer
+            //! Producer: add count samples written to writableSamples
+            void commitSamples(int count);
+
+            //! Producer: clear the buffer, the consumer skips all samples added so far
             void clearBuffer();
 
+            //! Consumer: ISampleProvider::readSamples
+            virtual int readSamples(float *samples, int count) override;
+
+            //! Number of samples in the buffer
+            int getBufferedSamples() const;
+
+            //! Max. number of samples in the buffer
+            int getBufferSize() const { return m_audioBuffer.size(); }
+
+            //! Number of reads running out of samples after samples have been read
+            quint32 getUnderruns() const { return m_underruns.load(std::memory_order_relaxed); }
+
+            //! Number of samples dropped as the buffer was full
+            quint32 getDroppedSamples() const { return m_droppedSamples.load(std::memory_order_relaxed); }
+
         private:
-            QVector<float> m_audioBuffer;
-            qint32 m_maxBufferSize;
+            //! Write to the buffer, silence if samples is nullptr
+            void write(const float *samples, int count);
+
+            QVector<float> m_audioBuffer; //!< ring buffer, never resized
+            std::atomic<quint64> m_writePosition   { 0 }; //!< samples written, written by producer
+            std::atomic<quint64> m_readPosition    { 0 }; //!< samples read, written by consumer
+            std::atomic<quint64> m_discardPosition { 0 }; //!< samples before are skipped, written by producer
+            std::atomic<quint32> m_underruns       { 0 };
+            std::atomic<quint32> m_droppedSamples  { 0 };
+            bool m_lastReadComplete = false; //!< consumer only
         };
     } // ns
 } // ns
@@ -1,6 +1,10 @@
 #include "equalizersampleprovider.h"
 #include "blacksound/audioutilities.h"
+#include "blacksound/dsp/dspkernels.h"
+
 #include <QDebug>
+#include <QVarLengthArray>
+#include <algorithm>
 
 using namespace BlackSound::Dsp;
 
@@ -9,7 +13,8 @@ namespace BlackSound
     namespace SampleProvider
     {
         CEqualizerSampleProvider::CEqualizerSampleProvider(ISampleProvider *sourceProvider, EqualizerPresets preset, QObject *parent) :
-            ISampleProvider(parent)
+            ISampleProvider(parent),
+            m_prefetched(MaxBlockSize, 0.0f)
         {
             Q_ASSERT_X(sourceProvider, Q_FUNC_INFO, "Need provider");
             const QString on = QStringLiteral("%1 of %2").arg(this->metaObject()->className(), sourceProvider->objectName());
@@ -19,20 +24,50 @@ namespace BlackSound
             setupPreset(preset);
         }
 
-        int CEqualizerSampleProvider::readSamples(QVector<float> &samples, qint64 count)
+        int CEqualizerSampleProvider::readSamples(float *samples, int count)
         {
+            if (m_prefetchedBlockSize >= 0)
+            {
+                Q_ASSERT_X(m_prefetchedBlockSize == count, Q_FUNC_INFO, "Prefetched a different block size");
+                const int n = qMin(count, m_prefetchedBlockSize);
+                std::copy(m_prefetched.constData(), m_prefetched.constData() + n, samples);
+                fillSilence(samples, n, count);
+                m_prefetchedBlockSize = -1;
+                return qMin(count, m_prefetchedCount);
+            }
+
             const int samplesRead = m_sourceProvider->readSamples(samples, count);
             if (m_bypass) return samplesRead;
 
-            for (int n = 0; n < samplesRead; n++)
+            // the whole block is filtered, so the filters ring out when the source runs dry
+            m_filters.process(samples, count);
+            CDspKernels::gain(samples, count, static_cast<float>(m_outputGain));
+            return count;
+        }
+
+        void CEqualizerSampleProvider::prefetch(const QVector<CEqualizerSampleProvider *> &equalizers, int count, CBiQuadCascadeLanes &lanes)
+        {
+            Q_ASSERT_X(count <= MaxBlockSize, Q_FUNC_INFO, "Block too large");
+            QVarLengthArray<CBiQuadCascade *, 16> cascades;
+            QVarLengthArray<float *, 16> blocks;
+            for (CEqualizerSampleProvider *equalizer : equalizers)
+            {
+                float *block = equalizer->m_prefetched.data();
+                const int samplesRead = equalizer->m_sourceProvider->readSamples(block, count);
+                equalizer->m_prefetchedCount = equalizer->m_bypass ? samplesRead : count;
+                equalizer->m_prefetchedBlockSize = count;
+                if (equalizer->m_bypass) { continue; }
+                cascades.push_back(&equalizer->m_filters);
+                blocks.push_back(block);
+            }
+            if (cascades.isEmpty()) { return; }
+
+            lanes.process(cascades.data(), blocks.data(), cascades.size(), count);
+            for (CEqualizerSampleProvider *equalizer : equalizers)
             {
-                for (int band = 0; band < m_filters.size(); band++)
-                {
-                    samples[n] = m_filters[band].transform(samples[n]);
-                }
-                samples[n] *= static_cast<float>(m_outputGain);
+                if (equalizer->m_bypass) { continue; }
+                CDspKernels::gain(equalizer->m_prefetched.data(), count, static_cast<float>(equalizer->m_outputGain));
             }
-            return samplesRead;
         }
 
         void CEqualizerSampleProvider::setupPreset(EqualizerPresets preset)
@@ -40,11 +75,11 @@ namespace BlackSound
             switch (preset)
             {
             case VHFEmulation:
-                m_filters.push_back(BiQuadFilter::highPassFilter(44100, 310, 0.25));
-                m_filters.push_back(BiQuadFilter::peakingEQ(44100, 450, 0.75, 17.0));
-                m_filters.push_back(BiQuadFilter::peakingEQ(44100, 1450, 1.0, 25.0));
-                m_filters.push_back(BiQuadFilter::peakingEQ(44100, 2000, 1.0, 25.0));
-                m_filters.push_back(BiQuadFilter::lowPassFilter(44100, 2500, 0.25));
+                m_filters.addStage(BiQuadFilter::highPassFilter(44100, 310, 0.25));
+                m_filters.addStage(BiQuadFilter::peakingEQ(44100, 450, 0.75, 17.0));
+                m_filters.addStage(BiQuadFilter::peakingEQ(44100, 1450, 1.0, 25.0));
+                m_filters.addStage(BiQuadFilter::peakingEQ(44100, 2000, 1.0, 25.0));
+                m_filters.addStage(BiQuadFilter::lowPassFilter(44100, 2500, 0.25));
                 break;
             }
         }
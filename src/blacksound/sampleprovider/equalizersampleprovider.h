@@ -13,9 +13,8 @@
 
 #include "blacksound/blacksoundexport.h"
 #include "blacksound/sampleprovider/sampleprovider.h"
-#include "blacksound/dsp/biquadfilter.h"
+#include "blacksound/dsp/biquadcascade.h"
 
-#include <QSharedPointer>
 #include <QVector>
 
 namespace BlackSound
@@ -38,7 +37,7 @@ namespace BlackSound
             CEqualizerSampleProvider(ISampleProvider *sourceProvider, EqualizerPresets preset, QObject *parent = nullptr);
 
             //! \copydoc ISampleProvider::readSamples
-            virtual int readSamples(QVector<float> &samples, qint64 count) override;
+            virtual int readSamples(float *samples, int count) override;
 
             //! Bypassing?
             void setBypassEffects(bool value) { m_bypass = value; }
@@ -49,14 +48,20 @@ namespace BlackSound
             void setOutputGain(double outputGain);
             //! @}
 
+            //! Read the next block of several equalizers with the same preset and filter them together, one SIMD lane per equalizer
+            //! \remark the following readSamples call of each equalizer returns its block
+            static void prefetch(const QVector<CEqualizerSampleProvider *> &equalizers, int count, Dsp::CBiQuadCascadeLanes &lanes);
+
         private:
             void setupPreset(EqualizerPresets preset);
 
             ISampleProvider *m_sourceProvider = nullptr;
-            int    m_channels   = 1;
             bool   m_bypass     = false;
             double m_outputGain = 1.0;
-            QVector<Dsp::BiQuadFilter> m_filters;
+            Dsp::CBiQuadCascade m_filters;
+            QVector<float> m_prefetched;     //!< block read by prefetch
+            int m_prefetchedCount     = 0;   //!< samples in m_prefetched
+            int m_prefetchedBlockSize = -1;  //!< block size of m_prefetched, -1 if nothing prefetched
         };
     } // ns
 } // ns
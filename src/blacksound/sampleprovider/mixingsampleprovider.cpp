@@ -7,15 +7,18 @@
  */
 
 #include "mixingsampleprovider.h"
+#include "blacksound/dsp/dspkernels.h"
 #include "blackmisc/metadatautils.h"
 
 using namespace BlackMisc;
+using namespace BlackSound::Dsp;
 
 namespace BlackSound
 {
     namespace SampleProvider
     {
-        CMixingSampleProvider::CMixingSampleProvider(QObject *parent) : ISampleProvider(parent)
+        CMixingSampleProvider::CMixingSampleProvider(QObject *parent) : ISampleProvider(parent),
+            m_sourceBuffer(MaxBlockSize, 0.0f)
         {
             const QString on = QStringLiteral("%1").arg(classNameShort(this));
             this->setObjectName(on);
@@ -30,37 +33,37 @@ namespace BlackSound
             this->setObjectName(on);
         }
 
-        int CMixingSampleProvider::readSamples(QVector<float> &samples, qint64 count)
+        int CMixingSampleProvider::readSamples(float *samples, int count)
         {
-            samples.clear();
-            samples.fill(0, static_cast<int>(count));
-            int outputLen = 0;
+            Q_ASSERT_X(count <= MaxBlockSize, Q_FUNC_INFO, "Block too large");
+            if (m_sources.isEmpty())
+            {
+                fillSilence(samples, 0, count);
+                return 0;
+            }
 
-            QVector<ISampleProvider *> finishedProviders;
-            for (int i = 0; i < m_sources.size(); i++)
+            // the first source is read into the output, the other ones are added to it
+            int outputLen = 0;
+            bool first = true;
+            float *sourceBuffer = m_sourceBuffer.data();
+            for (int i = 0; i < m_sources.size();)
             {
                 ISampleProvider *sampleProvider = m_sources.at(i);
-                QVector<float> sourceBuffer;
+                const int len = sampleProvider->readSamples(first ? samples : sourceBuffer, count);
+                if (!first) { CDspKernels::mix(samples, sourceBuffer, len); }
+                first = false;
+                outputLen = qMax(len, outputLen);
 
-                const int len = sampleProvider->readSamples(sourceBuffer, count);
-                for (int n = 0; n < len; n++)
+                if (sampleProvider->isFinished())
                 {
-                    samples[n] += sourceBuffer[n];
+                    m_sources.remove(i);
+                    sampleProvider->deleteLater();
                 }
-
-                outputLen = qMax(len, outputLen);
-                if (sampleProvider->isFinished())
+                else
                 {
-                    finishedProviders.push_back(sampleProvider);
+                    i++;
                 }
             }
-
-            for (ISampleProvider *sampleProvider : finishedProviders)
-            {
-                sampleProvider->deleteLater();
-                m_sources.removeAll(sampleProvider);
-            }
-
             return outputLen;
         }
     } // ns
@@ -31,10 +31,12 @@ namespace BlackSound
             void addMixerInput(ISampleProvider *provider);
 
             //! \copydoc ISampleProvider::readSamples
-            virtual int readSamples(QVector<float> &samples, qint64 count) override;
+            virtual int readSamples(float *samples, int count) override;
 
         private:
             QVector<ISampleProvider *> m_sources;
+            QVector<float> m_sourceBuffer; //!< block of one source, added to the output
+
         };
     } // ns
 } // ns
@@ -14,11 +14,13 @@ namespace BlackSound
 {
     namespace SampleProvider
     {
-        int CPinkNoiseGenerator::readSamples(QVector<float> &samples, qint64 count)
+        int CPinkNoiseGenerator::readSamples(float *samples, int count)
         {
-            const int c = static_cast<int>(count);
-            samples.clear();
-            samples.fill(0, c);
+            if (qFuzzyIsNull(m_gain))
+            {
+                fillSilence(samples, 0, count);
+                return count;
+            }
 
             for (int sampleCount = 0; sampleCount < count; sampleCount++)
             {
@@ -35,7 +37,7 @@ namespace BlackSound
                 const float sampleValue = static_cast<float>(m_gain * (pink / 5));
                 samples[sampleCount] = sampleValue;
             }
-            return c;
+            return count;
         }
     }
 }
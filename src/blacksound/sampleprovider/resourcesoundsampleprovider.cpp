@@ -10,6 +10,7 @@
 #include "blackmisc/metadatautils.h"
 
 #include <QDebug>
+#include <algorithm>
 
 using namespace BlackMisc;
 
@@ -23,49 +24,50 @@ namespace BlackSound
         {
             const QString on = QStringLiteral("%1 %2").arg(classNameShort(this), resourceSound.getFileName());
             this->setObjectName(on);
-            m_tempBuffer.resize(m_tempBufferSize);
         }
 
-        int CResourceSoundSampleProvider::readSamples(QVector<float> &samples, qint64 count)
+        int CResourceSoundSampleProvider::readSamples(float *samples, int count)
         {
-            if (!m_resourceSound.isLoaded()) { return 0; }
-            if (count > m_tempBufferSize)
+            const QVector<float> &audioData = m_resourceSound.audioData();
+            if (!m_resourceSound.isLoaded() || m_isFinished || audioData.isEmpty())
             {
-                qDebug() << "Count too large for temp buffer" << count;
+                fillSilence(samples, 0, count);
                 return 0;
             }
-            const qint64 availableSamples = m_resourceSound.audioData().size() - m_position;
-            const qint64 samplesToCopy    = qMin(availableSamples, count);
-            samples.clear();
-            samples.fill(0, static_cast<int>(samplesToCopy));
 
-            for (int i = 0; i < samplesToCopy; i++)
+            // a looping sound continues from the start within the same block
+            const float gain = static_cast<float>(m_gain);
+            int samplesRead = 0;
+            while (samplesRead < count)
             {
-                m_tempBuffer[i] = m_resourceSound.audioData().at(static_cast<int>(m_position) + i);
-            }
-
-            if (!qFuzzyCompare(m_gain, 1.0))
-            {
-                for (int i = 0; i < samplesToCopy; i++)
+                const int samplesToCopy = qMin(audioData.size() - m_position, count - samplesRead);
+                const float *source = audioData.constData() + m_position;
+                if (qFuzzyCompare(m_gain, 1.0))
                 {
-                    m_tempBuffer[i] = static_cast<float>(m_gain * m_tempBuffer[i]);
+                    std::copy(source, source + samplesToCopy, samples + samplesRead);
                 }
-            }
+                else
+                {
+                    for (int i = 0; i < samplesToCopy; i++) { samples[samplesRead + i] = gain * source[i]; }
+                }
+                samplesRead += samplesToCopy;
+                m_position += samplesToCopy;
 
-            for (int i = 0; i < samplesToCopy; i++)
-            {
-                samples[i] = m_tempBuffer.at(i);
+                if (m_position >= audioData.size())
+                {
+                    if (!m_looping) { m_isFinished = true; break; }
+                    m_position = 0;
+                }
             }
 
-            m_position += samplesToCopy;
-
-            if (m_position > availableSamples - 1)
-            {
-                if (m_looping) { m_position = 0; }
-                else { m_isFinished = true; }
-            }
+            fillSilence(samples, samplesRead, count);
+            return samplesRead;
+        }
 
-            return static_cast<int>(samplesToCopy);
+        void CResourceSoundSampleProvider::restart()
+        {
+            m_position = 0;
+            m_isFinished = false;
         }
     } // ns
 } // ns
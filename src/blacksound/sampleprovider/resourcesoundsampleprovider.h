@@ -27,7 +27,7 @@ namespace BlackSound
             CResourceSoundSampleProvider(const CResourceSound &resourceSound, QObject *parent = nullptr);
 
             //! copydoc ISampleProvider::readSamples
-            virtual int readSamples(QVector<float> &samples, qint64 count) override;
+            virtual int readSamples(float *samples, int count) override;
 
             //! copydoc ISampleProvider::isFinished
             virtual bool isFinished() const override { return m_isFinished; }
@@ -44,14 +44,15 @@ namespace BlackSound
             void setGain(double gain) { m_gain = gain; }
             //! @}
 
+            //! Play again from the start
+            void restart();
+
         private:
             double m_gain    = 1.0;
             bool   m_looping = false;
 
             CResourceSound  m_resourceSound;
-            qint64          m_position = 0;
-            const int       m_tempBufferSize = 24000; //24000 = 500ms (avoid buffer overflow), m_tempBufferSize = 9600; //9600 = 200ms
-            QVector<float>  m_tempBuffer;
+            int             m_position = 0;
             bool            m_isFinished = false;
         };
     } // ns
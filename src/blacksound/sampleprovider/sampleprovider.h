@@ -15,17 +15,23 @@
 #include "blacksound/blacksoundexport.h"
 #include <QObject>
 #include <QVector>
+#include <algorithm>
 
 namespace BlackSound
 {
     namespace SampleProvider
     {
         //! Sample provider interface
+        //! \details Providers are connected to a graph once, reading then processes blocks of samples in a buffer
+        //!          owned by the caller. Providers keep the buffers they need as members, so reading does not allocate.
         class BLACKSOUND_EXPORT ISampleProvider : public QObject
         {
             Q_OBJECT
 
         public:
+            //! Max. number of samples read at once, 100ms at 48kHz
+            static constexpr int MaxBlockSize = 4800;
+
             //! Ctor
             ISampleProvider(QObject *parent = nullptr) : QObject(parent) {}
 
@@ -33,12 +39,21 @@ namespace BlackSound
             virtual ~ISampleProvider() override {}
 
             //! Read samples
-            virtual int readSamples(QVector<float> &samples, qint64 count) = 0;
+            //! \param samples buffer of at least count samples
+            //! \param count   number of samples, at most MaxBlockSize
+            //! \return number of samples read, the remaining samples of the block are set to silence
+            virtual int readSamples(float *samples, int count) = 0;
 
             //! Finished?
             virtual bool isFinished() const { return false; }
 
         protected:
+            //! Set the samples from index "from" up to count to silence
+            static void fillSilence(float *samples, int from, int count)
+            {
+                if (from < count) { std::fill(samples + from, samples + count, 0.0f); }
+            }
+
             //! Verbose logs?
             bool static verbose() { return BlackConfig::CBuildConfig::isLocalDeveloperDebugBuild(); }
         };
@@ -20,20 +20,25 @@ namespace BlackSound
             this->setObjectName("CSawToothGenerator");
         }
 
-        int CSawToothGenerator::readSamples(QVector<float> &samples, qint64 count)
+        int CSawToothGenerator::readSamples(float *samples, int count)
         {
-            samples.clear();
-            samples.fill(0, static_cast<int>(count));
+            if (qFuzzyIsNull(m_gain))
+            {
+                // silent, but keep the phase
+                fillSilence(samples, 0, count);
+                m_nSample += count;
+                return count;
+            }
 
+            const double multiple = 2 * m_frequency / m_sampleRate;
             for (int sampleCount = 0; sampleCount < count; sampleCount++)
             {
-                double multiple = 2 * m_frequency / m_sampleRate;
                 double sampleSaw = std::fmod((m_nSample * multiple), 2) - 1;
                 double sampleValue = m_gain * sampleSaw;
                 samples[sampleCount] = static_cast<float>(sampleValue);
                 m_nSample++;
             }
-            return static_cast<int>(count);
+            return count;
         }
     } // ns
 } // ns
@@ -24,19 +24,24 @@ namespace BlackSound
             this->setObjectName(on);
         }
 
-        int CSinusGenerator::readSamples(QVector<float> &samples, qint64 count)
+        int CSinusGenerator::readSamples(float *samples, int count)
         {
-            samples.clear();
-            samples.fill(0, static_cast<int>(count));
+            if (qFuzzyIsNull(m_gain))
+            {
+                // silent, but keep the phase
+                fillSilence(samples, 0, count);
+                m_nSample += count;
+                return count;
+            }
 
+            const double multiple = s_twoPi * m_frequencyHz / m_sampleRate;
             for (int sampleCount = 0; sampleCount < count; sampleCount++)
             {
-                const double multiple    = s_twoPi * m_frequencyHz / m_sampleRate;
                 const double sampleValue = m_gain * qSin(m_nSample * multiple);
                 samples[sampleCount]     = static_cast<float>(sampleValue);
                 m_nSample++;
             }
-            return static_cast<int>(count);
+            return count;
         }
 
         void CSinusGenerator::setFrequency(double frequencyHz)
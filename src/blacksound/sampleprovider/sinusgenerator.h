@@ -30,7 +30,7 @@ namespace BlackSound
             CSinusGenerator(double frequencyHz, QObject *parent = nullptr);
 
             //! \copydoc ISampleProvider::readSamples
-            virtual int readSamples(QVector<float> &samples, qint64 count) override;
+            virtual int readSamples(float *samples, int count) override;
 
             //! Set the gain
             void setGain(double gain) { m_gain = gain; }
@@ -28,7 +28,7 @@ namespace BlackSound
             CVolumeSampleProvider(ISampleProvider *sourceProvider, QObject *parent = nullptr);
 
             //! \copydoc ISampleProvider::readSamples
-            virtual int readSamples(QVector<float> &samples, qint64 count) override;
+            virtual int readSamples(float *samples, int count) override;
 
             //! Gain ratio, value a amplitude need to be multiplied with
             //! \see http://www.sengpielaudio.com/calculator-amplification.htm
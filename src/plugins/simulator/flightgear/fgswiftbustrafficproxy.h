@@ -16,6 +16,7 @@
 #include "blackmisc/aviation/aircraftparts.h"
 #include "blackmisc/aviation/callsign.h"
 #include "blackmisc/geo/elevationplane.h"
+#include "blackmisc/simulation/interpolator.h"
 
 #include <QObject>
 #include <QString>
@@ -70,6 +71,20 @@ namespace BlackSimPlugin
                 this->groundSpeedKts.push_back(situation.getGroundSpeed().value(BlackMisc::PhysicalQuantities::CSpeedUnit::kts()));
             }
 
+            //! Push back the latest situation from a compact interpolation result
+            void push_back(const BlackMisc::Aviation::CCallsign &callsign, const BlackMisc::Simulation::CCompactInterpolationResult &compact)
+            {
+                this->callsigns.push_back(callsign.asString());
+                this->latitudesDeg.push_back(compact.latitudeDeg);
+                this->longitudesDeg.push_back(compact.longitudeDeg);
+                this->altitudesFt.push_back(compact.altitudeFt);
+                this->pitchesDeg.push_back(compact.pitchDeg);
+                this->rollsDeg.push_back(compact.bankDeg);
+                this->headingsDeg.push_back(compact.headingDeg);
+                this->onGrounds.push_back(compact.isOnGround());
+                this->groundSpeedKts.push_back(compact.groundSpeedKts);
+            }
+
             QStringList   callsigns;       //!< List of callsigns
             QList<double> latitudesDeg;    //!< List of latitudes
             QList<double> longitudesDeg;   //!< List of longitudes
@@ -109,6 +124,29 @@ namespace BlackSimPlugin
                 this->taxiLights.push_back(parts.getLights().isTaxiOn());
             }
 
+            //! Push back the latest parts from a compact interpolation result
+            void push_back(const BlackMisc::Aviation::CCallsign &callsign, const BlackMisc::Simulation::CCompactInterpolationResult &compact)
+            {
+                using BlackMisc::Simulation::CCompactInterpolationResult;
+                this->callsigns.push_back(callsign.asString());
+                this->gears.push_back(compact.testParts(CCompactInterpolationResult::GearDown) ? 1 : 0);
+                this->flaps.push_back(compact.getFlapsRatio());
+                this->spoilers.push_back(compact.testParts(CCompactInterpolationResult::SpoilersOut) ? 1 : 0);
+                this->speedBrakes.push_back(compact.testParts(CCompactInterpolationResult::SpoilersOut) ? 1 : 0);
+                this->slats.push_back(compact.getFlapsRatio());
+                this->wingSweeps.push_back(0.0);
+                this->thrusts.push_back(compact.testParts(CCompactInterpolationResult::AnyEngineOn) ? 0 : 0.75);
+                this->elevators.push_back(0.0);
+                this->rudders.push_back(0.0);
+                this->ailerons.push_back(0.0);
+                this->landLights.push_back(compact.testParts(CCompactInterpolationResult::LandingLights));
+                this->taxiLights.push_back(compact.testParts(CCompactInterpolationResult::TaxiLights));
+                this->beaconLights.push_back(compact.testParts(CCompactInterpolationResult::BeaconLights));
+                this->strobeLights.push_back(compact.testParts(CCompactInterpolationResult::StrobeLights));
+                this->navLights.push_back(compact.testParts(CCompactInterpolationResult::NavLights));
+                this->lightPatterns.push_back(0);
+            }
+
             QStringList callsigns;      //!< List of callsigns
             QList<double> gears;        //!< List of gears
             QList<double> flaps;        //!< List of flaps
@@ -54,6 +54,12 @@ namespace BlackSimPlugin
             return m_interpolator->getInterpolation(currentTimeSinceEpoc, setup, aircraftNumber);
         }
 
+        CCompactInterpolationResult CFlightgearMPAircraft::getInterpolationCompact(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber, const CRemoteAircraftSnapshotPtr &snapshot) const
+        {
+            Q_ASSERT(m_interpolator);
+            return m_interpolator->getInterpolationCompact(currentTimeSinceEpoc, setup, aircraftNumber, snapshot);
+        }
+
         CStatusMessageList CFlightgearMPAircraft::getInterpolationMessages(CInterpolationAndRenderingSetupBase::InterpolatorMode mode) const
         {
             return this->getInterpolator() ? this->getInterpolator()->getInterpolationMessages(mode) : CStatusMessageList();
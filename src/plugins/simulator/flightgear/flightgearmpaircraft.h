@@ -63,6 +63,10 @@ namespace BlackSimPlugin
             //! \copydoc BlackMisc::Simulation::CInterpolator::getInterpolation
             BlackMisc::Simulation::CInterpolationResult getInterpolation(qint64 currentTimeSinceEpoc, const BlackMisc::Simulation::CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber) const;
 
+            //! \copydoc BlackMisc::Simulation::CInterpolator::getInterpolationCompact
+            BlackMisc::Simulation::CCompactInterpolationResult getInterpolationCompact(qint64 currentTimeSinceEpoc, const BlackMisc::Simulation::CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber,
+                    const BlackMisc::Simulation::CRemoteAircraftSnapshotPtr &snapshot = {}) const;
+
             //! \copydoc BlackMisc::Simulation::CInterpolator::getInterpolationMessages
             BlackMisc::CStatusMessageList getInterpolationMessages(BlackMisc::Simulation::CInterpolationAndRenderingSetupBase::InterpolatorMode mode) const;
 
@@ -15,6 +15,7 @@
 #include "plugins/simulator/flightgearconfig/simulatorflightgearconfig.h"
 #include "plugins/simulator/plugincommon/simulatorplugincommon.h"
 #include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/interpolationbatch.h"
 #include "blackmisc/simulation/data/modelcaches.h"
 #include "blackmisc/simulation/settings/simulatorsettings.h"
 #include "blackmisc/simulation/settings/fgswiftbussettings.h"
@@ -38,6 +39,7 @@
 #include <QStringList>
 #include <QHash>
 #include <QPair>
+#include <QVector>
 #include <QTimer>
 
 class QDBusServiceWatcher;
@@ -232,6 +234,8 @@ namespace BlackSimPlugin
             QHash<BlackMisc::Aviation::CCallsign, qint64> m_addingInProgressAircraft; //!< aircraft just adding
             BlackMisc::Simulation::CSimulatedAircraftList m_aircraftAddedFailed; //! aircraft for which adding failed
             CFlightgearMPAircraftObjects m_flightgearAircraftObjects; //!< Flightgear multiplayer aircraft
+            BlackMisc::Simulation::CInterpolationBatch m_interpolationBatch; //!< aircraft interpolated in updateRemoteAircraft
+            QVector<BlackMisc::Simulation::CCompactInterpolationResult> m_interpolationResults; //!< results of m_interpolationBatch, memory re-used frame by frame
             FlightgearData m_flightgearData; //!< Flightgear data
 
             // statistics
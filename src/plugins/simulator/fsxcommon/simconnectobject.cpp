@@ -219,12 +219,24 @@ namespace BlackSimPlugin
             return m_interpolator->getInterpolation(currentTimeSinceEpoc, setup, aircraftNumber);
         }
 
+        CCompactInterpolationResult CSimConnectObject::getInterpolationCompact(qint64 currentTimeSinceEpoc, const CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber, const CRemoteAircraftSnapshotPtr &snapshot) const
+        {
+            if (!m_interpolator) { return CCompactInterpolationResult(); }
+            return m_interpolator->getInterpolationCompact(currentTimeSinceEpoc, setup, aircraftNumber, snapshot);
+        }
+
         const CAircraftSituation &CSimConnectObject::getLastInterpolatedSituation(CInterpolationAndRenderingSetupBase::InterpolatorMode mode) const
         {
             if (!m_interpolator) { return CAircraftSituation::null(); }
             return m_interpolator->getLastInterpolatedSituation(mode);
         }
 
+        const CAircraftParts &CSimConnectObject::getLastInterpolatedParts(CInterpolationAndRenderingSetupBase::InterpolatorMode mode) const
+        {
+            if (!m_interpolator) { return CAircraftParts::null(); }
+            return m_interpolator->getLastInterpolatedParts(mode);
+        }
+
         const CStatusMessageList &CSimConnectObject::getInterpolationMessages(CInterpolationAndRenderingSetupBase::InterpolatorMode mode) const
         {
             static const CStatusMessageList empty;
@@ -277,9 +277,16 @@ namespace BlackSimPlugin
             //! \copydoc BlackMisc::Simulation::CInterpolator::getInterpolation
             BlackMisc::Simulation::CInterpolationResult getInterpolation(qint64 currentTimeSinceEpoc, const BlackMisc::Simulation::CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber) const;
 
+            //! \copydoc BlackMisc::Simulation::CInterpolator::getInterpolationCompact
+            BlackMisc::Simulation::CCompactInterpolationResult getInterpolationCompact(qint64 currentTimeSinceEpoc, const BlackMisc::Simulation::CInterpolationAndRenderingSetupPerCallsign &setup, int aircraftNumber,
+                    const BlackMisc::Simulation::CRemoteAircraftSnapshotPtr &snapshot = {}) const;
+
             //! \copydoc BlackMisc::Simulation::CInterpolator::getLastInterpolatedSituation
             const BlackMisc::Aviation::CAircraftSituation &getLastInterpolatedSituation(BlackMisc::Simulation::CInterpolationAndRenderingSetupBase::InterpolatorMode mode) const;
 
+            //! \copydoc BlackMisc::Simulation::CInterpolator::getLastInterpolatedParts
+            const BlackMisc::Aviation::CAircraftParts &getLastInterpolatedParts(BlackMisc::Simulation::CInterpolationAndRenderingSetupBase::InterpolatorMode mode) const;
+
             //! \copydoc BlackMisc::Simulation::CInterpolator::getInterpolationMessages
             const BlackMisc::CStatusMessageList &getInterpolationMessages(BlackMisc::Simulation::CInterpolationAndRenderingSetupBase::InterpolatorMode mode) const;
 
@@ -1960,9 +1960,11 @@ namespace BlackSimPlugin
             // interpolation for all remote aircraft
             const QList<CSimConnectObject> simObjects(m_simConnectObjects.values());
 
-            int simObjectNumber = 0;
             const bool traceSendId       = this->isTracingSendId();
             const bool updateAllAircraft = this->isUpdateAllRemoteAircraft(currentTimestamp);
+            QVector<const CSimConnectObject *> batchObjects;
+            batchObjects.reserve(simObjects.size());
+            m_interpolationBatch.clear();
             for (const CSimConnectObject &simObject : simObjects)
             {
                 // happening if aircraft is not yet added to simulator or to be deleted
@@ -1975,23 +1977,34 @@ namespace BlackSimPlugin
                 BLACK_VERIFY_X(hasCs, Q_FUNC_INFO, "missing callsign");
                 BLACK_AUDIT_X(hasValidIds, Q_FUNC_INFO, "Missing ids");
                 if (!hasCs || !hasValidIds) { continue; } // not supposed to happen
-                const DWORD objectId = simObject.getObjectId();
 
                 // setup
-                const CInterpolationAndRenderingSetupPerCallsign setup = this->getInterpolationSetupConsolidated(callsign, updateAllAircraft);
+                m_interpolationBatch.add(simObject.getInterpolator(), this->getInterpolationSetupConsolidated(callsign, updateAllAircraft));
+                batchObjects.push_back(&simObject);
+            }
+
+            // interpolated situations of all aircraft, one provider snapshot shared by all aircraft of this frame
+            // compact results, the full situation is only used if it is sent
+            m_interpolationBatch.interpolate(currentTimestamp, this->getRemoteAircraftSnapshot(), m_interpolationResults);
+            for (int simObjectNumber = 0; simObjectNumber < m_interpolationBatch.size(); simObjectNumber++)
+            {
+                const CSimConnectObject &simObject = *batchObjects[simObjectNumber];
+                const DWORD objectId = simObject.getObjectId();
+                const CInterpolationAndRenderingSetupPerCallsign &setup = m_interpolationBatch.setup(simObjectNumber);
                 const bool sendGround = setup.isSendingGndFlagToSimulator();
 
-                // Interpolated situation
-                // simObjectNumber is passed to equally distributed steps like guessing parts
+                // simObjectNumber is used for equally distributed steps like guessing parts
                 const bool slowUpdate = (((m_statsUpdateAircraftRuns + simObjectNumber) % 40) == 0);
-                const CInterpolationResult result = simObject.getInterpolation(currentTimestamp, setup, simObjectNumber++);
+                const CInterpolationAndRenderingSetupBase::InterpolatorMode mode = setup.getInterpolatorMode();
+                const CCompactInterpolationResult &result = m_interpolationResults[simObjectNumber];
                 const bool forceUpdate = slowUpdate || updateAllAircraft || setup.isForcingFullInterpolation();
-                if (result.getInterpolationStatus().hasValidSituation())
+                if (result.hasValidSituation())
                 {
                     // update situation
-                    if (forceUpdate || !this->isEqualLastSent(result.getInterpolatedSituation()))
+                    const CAircraftSituation &interpolatedSituation = simObject.getLastInterpolatedSituation(mode);
+                    if (forceUpdate || !this->isEqualLastSent(interpolatedSituation))
                     {
-                        SIMCONNECT_DATA_INITPOSITION position = this->aircraftSituationToFsxPosition(result, sendGround);
+                        SIMCONNECT_DATA_INITPOSITION position = this->aircraftSituationToFsxPosition(interpolatedSituation, sendGround);
                         const HRESULT hr = this->logAndTraceSendId(
                                                SimConnect_SetDataOnSimObject(
                                                    m_hSimConnect, CSimConnectDefinitions::DataRemoteAircraftSetPosition,
@@ -1999,7 +2012,7 @@ namespace BlackSimPlugin
                                                traceSendId, simObject, "Failed to set position", Q_FUNC_INFO, "SimConnect_SetDataOnSimObject");
                         if (isOk(hr))
                         {
-                            this->rememberLastSent(result); // remember situation
+                            this->rememberLastSent(interpolatedSituation); // remember situation
                         }
                     }
                 }
@@ -2010,7 +2023,7 @@ namespace BlackSimPlugin
                 }
 
                 // Interpolated parts
-                const bool updatedParts = this->updateRemoteAircraftParts(simObject, result, forceUpdate);
+                const bool updatedParts = this->updateRemoteAircraftParts(simObject, result, mode, forceUpdate);
                 Q_UNUSED(updatedParts)
 
             } // all callsigns
@@ -2019,17 +2032,18 @@ namespace BlackSimPlugin
             this->finishUpdateRemoteAircraftAndSetStatistics(currentTimestamp);
         }
 
-        bool CSimulatorFsxCommon::updateRemoteAircraftParts(const CSimConnectObject &simObject, const CInterpolationResult &result, bool forcedUpdate)
+        bool CSimulatorFsxCommon::updateRemoteAircraftParts(const CSimConnectObject &simObject, const CCompactInterpolationResult &result, CInterpolationAndRenderingSetupBase::InterpolatorMode mode, bool forcedUpdate)
         {
             if (!simObject.hasValidRequestAndObjectId()) { return false; }
             if (!simObject.isConfirmedAdded())           { return false; }
 
-            const CAircraftParts parts = result;
-            if (parts.isNull()) { return false; }
-            if (parts.getPartsDetails() != CAircraftParts::GuessedParts && !result.getPartsStatus().isSupportingParts()) { return false; }
+            // not null, guessed or supported
+            if (!result.hasValidParts()) { return false; }
+            if (!forcedUpdate && result.isReusedParts()) { return true; }
 
             const CCallsign cs = simObject.getCallsign();
-            if (!forcedUpdate && (result.getPartsStatus().isReusedParts() || this->isEqualLastSent(parts, cs))) { return true; }
+            const CAircraftParts &parts = simObject.getLastInterpolatedParts(mode);
+            if (!forcedUpdate && this->isEqualLastSent(parts, cs)) { return true; }
 
             const bool ok = this->sendRemoteAircraftPartsToSimulator(simObject, parts);
             if (ok) { this->rememberLastSent(parts, cs); }
@@ -17,6 +17,7 @@
 #include "plugins/simulator/fsxcommon/simconnectwindows.h"
 #include "plugins/simulator/fscommon/simulatorfscommon.h"
 #include "blackcore/simulator.h"
+#include "blackmisc/simulation/interpolationbatch.h"
 #include "blackmisc/simulation/interpolatorlinear.h"
 #include "blackmisc/simulation/simulatorplugininfo.h"
 #include "blackmisc/simulation/settings/simulatorsettings.h"
@@ -33,6 +34,7 @@
 #include <QtPlugin>
 #include <QHash>
 #include <QList>
+#include <QVector>
 #include <QFutureWatcher>
 
 namespace BlackSimPlugin
@@ -332,6 +334,8 @@ namespace BlackSimPlugin
             HANDLE m_hSimConnect = nullptr;                                     //!< handle to SimConnect object
             DispatchProc m_dispatchProc = &CSimulatorFsxCommon::SimConnectProc; //!< called function for dispatch, can be overriden by specialized P3D function
             CSimConnectObjects m_simConnectObjects;                             //!< AI objects and their object and request ids
+            BlackMisc::Simulation::CInterpolationBatch m_interpolationBatch;    //!< aircraft interpolated in updateRemoteAircraft
+            QVector<BlackMisc::Simulation::CCompactInterpolationResult> m_interpolationResults; //!< results of m_interpolationBatch, memory re-used frame by frame
 
             // probes
             bool m_useFsxTerrainProbe = is32bit(); //!< Use FSX Terrain probe?
@@ -436,7 +440,7 @@ namespace BlackSimPlugin
             void updateRemoteAircraft();
 
             //! Update remote aircraft parts (send to FSX)
-            bool updateRemoteAircraftParts(const CSimConnectObject &simObject, const BlackMisc::Simulation::CInterpolationResult &result, bool forcedUpdate);
+            bool updateRemoteAircraftParts(const CSimConnectObject &simObject, const BlackMisc::Simulation::CCompactInterpolationResult &result, BlackMisc::Simulation::CInterpolationAndRenderingSetupBase::InterpolatorMode mode, bool forcedUpdate);
 
             //! Calling CSimulatorFsxCommon::updateAirports
             void triggerUpdateAirports(const BlackMisc::Aviation::CAirportList &airports);
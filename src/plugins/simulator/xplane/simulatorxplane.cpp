@@ -1017,9 +1017,9 @@ namespace BlackSimPlugin
             PlanesSurfaces planesSurfaces;
             PlanesTransponders planesTransponders;
 
-            int aircraftNumber = 0;
             const bool updateAllAircraft = this->isUpdateAllRemoteAircraft(currentTimestamp);
             const CCallsignSet callsignsInRange = this->getAircraftInRangeCallsigns();
+            m_interpolationBatch.clear();
             for (const CXPlaneMPAircraft &xplaneAircraft : m_xplaneAircraftObjects)
             {
                 const CCallsign callsign(xplaneAircraft.getCallsign());
@@ -1041,33 +1041,41 @@ namespace BlackSimPlugin
                 planesTransponders.modeCs.push_back(transponderMode == CTransponder::ModeC);
 
                 // setup
-                const CInterpolationAndRenderingSetupPerCallsign setup = this->getInterpolationSetupConsolidated(callsign, updateAllAircraft);
+                m_interpolationBatch.add(xplaneAircraft.getInterpolator(), this->getInterpolationSetupConsolidated(callsign, updateAllAircraft));
+            }
 
-                // interpolated situation/parts
-                const CInterpolationResult result = xplaneAircraft.getInterpolation(currentTimestamp, setup, aircraftNumber++);
-                if (result.getInterpolationStatus().hasValidSituation())
+            // interpolated situations/parts of all aircraft, one provider snapshot shared by all aircraft of this frame
+            // compact results, the full situation/parts are only needed for the last sent values
+            m_interpolationBatch.interpolate(currentTimestamp, this->getRemoteAircraftSnapshot(), m_interpolationResults);
+            for (int i = 0; i < m_interpolationBatch.size(); i++)
+            {
+                const CCompactInterpolationResult &result = m_interpolationResults[i];
+                const CInterpolatorMulti *interpolator = m_interpolationBatch.interpolator(i);
+                const CCallsign &callsign = m_interpolationBatch.setup(i).getCallsign();
+                const CInterpolationAndRenderingSetupBase::InterpolatorMode mode = m_interpolationBatch.setup(i).getInterpolatorMode();
+                if (result.hasValidSituation())
                 {
-                    const CAircraftSituation interpolatedSituation(result);
+                    const CAircraftSituation &interpolatedSituation = interpolator->getLastInterpolatedSituation(mode);
 
                     // update situation
                     if (updateAllAircraft || !this->isEqualLastSent(interpolatedSituation))
                     {
                         this->rememberLastSent(interpolatedSituation);
-                        planesPositions.push_back(interpolatedSituation);
+                        planesPositions.push_back(callsign, result);
                     }
                 }
                 else
                 {
-                    CLogMessage(this).warning(this->getInvalidSituationLogMessage(callsign, result.getInterpolationStatus()));
+                    CLogMessage(this).warning(this->getInvalidSituationLogMessage(callsign, interpolator->getLastInterpolationStatus(mode)));
                 }
 
-                const CAircraftParts parts(result);
-                if (result.getPartsStatus().isSupportingParts() || parts.getPartsDetails() == CAircraftParts::GuessedParts)
+                if (result.hasValidParts())
                 {
+                    const CAircraftParts &parts = interpolator->getLastInterpolatedParts(mode);
                     if (updateAllAircraft || !this->isEqualLastSent(parts, callsign))
                     {
                         this->rememberLastSent(parts, callsign);
-                        planesSurfaces.push_back(xplaneAircraft.getCallsign(), parts);
+                        planesSurfaces.push_back(callsign, result);
                     }
                 }
 
@@ -15,6 +15,7 @@
 #include "plugins/simulator/xplaneconfig/simulatorxplaneconfig.h"
 #include "plugins/simulator/plugincommon/simulatorplugincommon.h"
 #include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/interpolationbatch.h"
 #include "blackmisc/simulation/data/modelcaches.h"
 #include "blackmisc/simulation/settings/simulatorsettings.h"
 #include "blackmisc/simulation/settings/xswiftbussettings.h"
@@ -38,6 +39,7 @@
 #include <QStringList>
 #include <QHash>
 #include <QPair>
+#include <QVector>
 #include <QTimer>
 
 class QDBusServiceWatcher;
@@ -270,6 +272,8 @@ namespace BlackSimPlugin
 
             BlackMisc::Aviation::CAirportList m_airportsInRange; //!< aiports in range of own aircraft
             CXPlaneMPAircraftObjects m_xplaneAircraftObjects;    //!< XPlane multiplayer aircraft
+            BlackMisc::Simulation::CInterpolationBatch m_interpolationBatch; //!< aircraft interpolated in updateRemoteAircraft
+            QVector<BlackMisc::Simulation::CCompactInterpolationResult> m_interpolationResults; //!< results of m_interpolationBatch, memory re-used frame by frame
 
             BlackMisc::Simulation::CSimulatedAircraftList m_pendingToBeAddedAircraft;      //!< aircraft to be added
             QHash<BlackMisc::Aviation::CCallsign, qint64> m_addingInProgressAircraft;      //!< aircraft just adding
@@ -3,4 +3,6 @@ TEMPLATE = subdirs
 SUBDIRS += \
     context \
     fsd \
+    testaircraftmatchingservice \
     testconnectivity \
+    testjitterbuffer \
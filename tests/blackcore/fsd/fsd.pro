@@ -3,3 +3,5 @@ TEMPLATE = subdirs
 SUBDIRS += \
     testfsdmessages \
     testfsdclient \
+    testfsdlineparser \
+    testfsdqueues \
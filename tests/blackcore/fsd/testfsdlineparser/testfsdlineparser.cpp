@@ -0,0 +1,261 @@
+/* Copyright (C) 2019
+ * swift Project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution and at http://www.swift-project.org/license.html. No part of swift project,
+ * including this file, may be copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+
+/*!
+* \file
+* \ingroup testblackfsd
+*/
+
+#include "blackcore/fsd/lineparser.h"
+#include "test.h"
+
+#include <QObject>
+#include <QTest>
+#include <QTextCodec>
+#include <QElapsedTimer>
+#include <QDebug>
+
+using namespace BlackCore::Fsd;
+
+namespace BlackFsdTest
+{
+    //! Testing the byte level FSD line parser
+    class CTestFsdLineParser : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        //! Constructor
+        explicit CTestFsdLineParser(QObject *parent = nullptr) : QObject(parent) {}
+
+        //! Destructor
+        virtual ~CTestFsdLineParser() {}
+
+    private slots:
+        void testMessageTypes();
+        void testPrefixes();
+        void testTrimmedPayload();
+        void testTokenize();
+        void testTokenizeNonAscii();
+        void testSender();
+        void testReplayPerformance();
+
+    private:
+        //! Line mix as seen on a busy event night
+        static QList<QByteArray> lineMix();
+
+        //! Old QString based parsing, used as reference in the performance test
+        static int parseLikeQString(const QByteArray &line, QTextCodec *codec, int &strings);
+    };
+
+    void CTestFsdLineParser::testMessageTypes()
+    {
+        const QList<QPair<QByteArray, MessageType>> lines =
+        {
+            { "#AAABCD:SERVER:Jon Doe:1234567:1234567:4:100", MessageType::AddAtc },
+            { "#APABCD:SERVER:1234567:1234567:1:100:1:Jon Doe", MessageType::AddPilot },
+            { "%ABCD:12000:3:100:4:48.11028:16.56972:0", MessageType::AtcDataUpdate },
+            { "$ZCSERVER:ABCD:0123456789abcdef", MessageType::AuthChallenge },
+            { "$ZRABCD:SERVER:0123456789abcdef", MessageType::AuthResponse },
+            { "$IDABCD:SERVER:de1e:swift:1:8:1234567:8765:challenge", MessageType::ClientIdentification },
+            { "$CQABCD:@94835:WH:DLH123", MessageType::ClientQuery },
+            { "$CRABCD:DLH123:RN:Jon Doe::1", MessageType::ClientResponse },
+            { "#DAEDDM_OBS:1234567", MessageType::DeleteATC },
+            { "#DPOEHAB:1234567", MessageType::DeletePilot },
+            { "#DLSERVER:*:0:0", MessageType::ServerHeartbeat },
+            { "$FPABCD:SERVER:I:B744:420:EGLL:1530:1535:FL350:KORD:8:15:9:30:KSEA:Unit Test:EGLL.KORD", MessageType::FlightPlan },
+            { "#PCABCD:DLH123:CCP:VER", MessageType::ProController },
+            { "$DISERVER:CLIENT:VATSIM FSD V3.14:21d368e49ab6", MessageType::FsdIdentification },
+            { "$!!SERVER:ABCD:Kicked", MessageType::KillRequest },
+            { "@N:ABCD:1200:1:48.353855:16.311401:12000:123:4261294148:100", MessageType::PilotDataUpdate },
+            { "$PIABCD:DLH123:1234", MessageType::Ping },
+            { "$POABCD:DLH123:1234", MessageType::Pong },
+            { "$ERSERVER:ABCD:009:EGLL:No such weather profile", MessageType::ServerError },
+            { "#TMEDMM_CTR:BER721:Hey how are you doing?", MessageType::TextMessage },
+            { "#SBABCD:DLH123:VI:43.12578:-72.15841:12008:-9.34:1.23:0", MessageType::PilotClientCom },
+            { "!RSERVER:ABCD", MessageType::RegistrationInfo },
+            { "-MDABCD:DLH123:0", MessageType::RevBClientParts },
+            { "-PDABCD:DLH123:0", MessageType::RevBPilotDescription },
+            { "XYZ:foo", MessageType::Unknown },
+            { "#X", MessageType::Unknown },
+            { "", MessageType::Unknown }
+        };
+
+        for (const auto &pair : lines)
+        {
+            const CFsdLineParser::Line parsed = CFsdLineParser::parse(pair.first);
+            QVERIFY2(parsed.type == pair.second, pair.first.constData());
+        }
+    }
+
+    void CTestFsdLineParser::testPrefixes()
+    {
+        // dispatch and prefix strings come from the same table
+        for (const CFsdLineParser::Pdu &pdu : CFsdLineParser::pdus())
+        {
+            const QByteArray line = QByteArray(pdu.prefix) + "ABCD:SERVER";
+            const CFsdLineParser::Line parsed = CFsdLineParser::parse(line);
+            QVERIFY2(parsed.type == pdu.type, pdu.prefix);
+            QCOMPARE(CFsdLineParser::prefix(pdu.type), QString(pdu.prefix));
+            QCOMPARE(parsed.payload.size, line.size() - CFsdLineParser::prefix(pdu.type).size());
+        }
+        QVERIFY(CFsdLineParser::prefix(MessageType::Unknown).isEmpty());
+    }
+
+    void CTestFsdLineParser::testTrimmedPayload()
+    {
+        const QByteArray line("  #TMEDMM_CTR:BER721:Hey \r\n");
+        const CFsdLineParser::Line parsed = CFsdLineParser::parse(line);
+        QVERIFY(parsed.type == MessageType::TextMessage);
+        QCOMPARE(parsed.line.toQString(nullptr), QString("#TMEDMM_CTR:BER721:Hey"));
+        QCOMPARE(parsed.payload.toQString(nullptr), QString("EDMM_CTR:BER721:Hey"));
+
+        const QByteArray emptyLine("#DP  \r\n");
+        const CFsdLineParser::Line empty = CFsdLineParser::parse(emptyLine);
+        QVERIFY(empty.type == MessageType::DeletePilot);
+        QVERIFY(empty.payload.isEmpty());
+    }
+
+    void CTestFsdLineParser::testTokenize()
+    {
+        QTextCodec *codec = QTextCodec::codecForName("utf-8");
+        const QByteArray line("@N:ABCD:1200:1:48.353855:16.311401:12000:123:4261294148:100\r\n");
+        const CFsdLineParser::Line parsed = CFsdLineParser::parse(line);
+        const QStringList tokens = CFsdLineParser::tokenize(parsed.payload, codec);
+        const QStringList expected = QString("N:ABCD:1200:1:48.353855:16.311401:12000:123:4261294148:100").split(':');
+        QCOMPARE(tokens, expected);
+        QCOMPARE(CFsdLineParser::tokenCount(parsed.payload), expected.size());
+
+        // empty tokens are kept, like with QString::split
+        const QByteArray line2("$CRABCD:DLH123:RN:Jon Doe::1:");
+        const CFsdLineParser::Line parsed2 = CFsdLineParser::parse(line2);
+        const QStringList tokens2 = CFsdLineParser::tokenize(parsed2.payload, codec);
+        QCOMPARE(tokens2, QString("ABCD:DLH123:RN:Jon Doe::1:").split(':'));
+    }
+
+    void CTestFsdLineParser::testSender()
+    {
+        const auto sender = [](const QByteArray &line)
+        {
+            const CFsdLineParser::Line parsed = CFsdLineParser::parse(line);
+            const RawLineView view = CFsdLineParser::sender(parsed);
+            return QByteArray(view.data, view.size);
+        };
+        QCOMPARE(sender("@N:ABCD:1200:1:48.353855:16.311401:12000:123:4261294148:100\r\n"), QByteArray("ABCD"));
+        QCOMPARE(sender("#DPABCD:1234567\r\n"), QByteArray("ABCD"));
+        QCOMPARE(sender("#DAEDDM_CTR\r\n"), QByteArray("EDDM_CTR"));
+        QCOMPARE(sender("#TMEDMM_CTR:BER721:Hello"), QByteArray("EDMM_CTR"));
+        QCOMPARE(sender("@N"), QByteArray());
+        QCOMPARE(sender("XYZ:ABC"), QByteArray());
+    }
+
+    void CTestFsdLineParser::testTokenizeNonAscii()
+    {
+        QTextCodec *codec = QTextCodec::codecForName("utf-8");
+        const QString text = QString::fromUtf8("#TMEDMM_CTR:BER721:Grüß Gott, München");
+        const QByteArray line = codec->fromUnicode(text);
+        const CFsdLineParser::Line parsed = CFsdLineParser::parse(line);
+        const QStringList tokens = CFsdLineParser::tokenize(parsed.payload, codec);
+        QCOMPARE(tokens.size(), 3);
+        QCOMPARE(tokens.at(2), QString::fromUtf8("Grüß Gott, München"));
+    }
+
+    void CTestFsdLineParser::testReplayPerformance()
+    {
+        // Pseudo performance test, replays a line mix and compares with the former QString based tokenisation
+        // "allocations" are the QStrings/QStringLists created per line
+        QTextCodec *codec = QTextCodec::codecForName("utf-8");
+        const QList<QByteArray> mix = lineMix();
+        constexpr int Loops = 2000;
+        const int lines = Loops * mix.size();
+
+        int stringsOld = 0;
+        int tokensOld = 0;
+        QElapsedTimer timer;
+        timer.start();
+        for (int l = 0; l < Loops; l++)
+        {
+            for (const QByteArray &line : mix) { tokensOld += parseLikeQString(line, codec, stringsOld); }
+        }
+        const qint64 nsOld = qMax<qint64>(1, timer.nsecsElapsed());
+
+        int stringsNew = 0;
+        int tokensNew = 0;
+        timer.start();
+        for (int l = 0; l < Loops; l++)
+        {
+            for (const QByteArray &line : mix)
+            {
+                const CFsdLineParser::Line parsed = CFsdLineParser::parse(line);
+                if (parsed.type == MessageType::Unknown || parsed.payload.isEmpty()) { continue; }
+                if (CFsdLineParser::isIgnoredMessageType(parsed.type)) { continue; }
+                const QStringList tokens = CFsdLineParser::tokenize(parsed.payload, codec);
+                tokensNew += tokens.size();
+                stringsNew += tokens.size() + 1; // tokens + list
+            }
+        }
+        const qint64 nsNew = qMax<qint64>(1, timer.nsecsElapsed());
+
+        QVERIFY2(tokensNew <= tokensOld, "New parser shall not produce more tokens");
+        qDebug() << "QString parser:" << qRound64(lines * 1.0e9 / nsOld) << "lines/s" << (stringsOld / static_cast<double>(lines)) << "allocations/line";
+        qDebug() << "Byte parser:   " << qRound64(lines * 1.0e9 / nsNew) << "lines/s" << (stringsNew / static_cast<double>(lines)) << "allocations/line";
+    }
+
+    QList<QByteArray> CTestFsdLineParser::lineMix()
+    {
+        // mostly positions, as on a busy event night
+        QList<QByteArray> mix;
+        for (int i = 0; i < 30; i++)
+        {
+            mix.push_back(QByteArray("@N:DLH") + QByteArray::number(100 + i) + ":1200:1:48.353855:16.311401:12000:123:4261294148:100\r\n");
+        }
+        for (int i = 0; i < 10; i++)
+        {
+            mix.push_back(QByteArray("#SBDLH") + QByteArray::number(100 + i) + ":@94835:VI:43.12578:-72.15841:12008:-9.34:1.23:0\r\n");
+        }
+        mix.push_back("%EDDF_TWR:19000:4:100:5:50.03333:8.57056:0\r\n");
+        mix.push_back("%EDDF_APP:20000:5:100:5:50.03333:8.57056:0\r\n");
+        mix.push_back("$CQDLH123:@94835:ACC:{\"config\":{\"gear_down\":true}}\r\n");
+        mix.push_back("$CQBAW1:DLH123:CAPS\r\n");
+        mix.push_back("$CRDLH123:BAW1:CAPS:ATCINFO=1:MODELDESC=1:ACCONFIG=1\r\n");
+        mix.push_back("$CRDLH123:BAW1:RN:Jon Doe::1\r\n");
+        mix.push_back("#TMEDDF_TWR:@21900:DLH123 cleared to land runway 25C\r\n");
+        mix.push_back("#TMEDDF_ATIS:DLH123:Frankfurt information A, time 1550, runway 25C in use\r\n");
+        mix.push_back("#APDLH999:SERVER:1234567::1:100:1:Jon Doe\r\n");
+        mix.push_back("#DPDLH998:1234567\r\n");
+        mix.push_back("#DLSERVER:*:0:0\r\n");
+        return mix;
+    }
+
+    int CTestFsdLineParser::parseLikeQString(const QByteArray &lineEncoded, QTextCodec *codec, int &strings)
+    {
+        static const QStringList prefixes({ "#AA", "#AP", "%", "$ZC", "$ZR", "$ID", "$CQ", "$CR", "#DA", "#DP", "$FP", "#PC", "$DI", "$!!", "@", "$PI", "$PO", "$ER", "#DL", "#TM", "#SB", "!R", "-MD", "-PD" });
+        const QString data = codec->toUnicode(lineEncoded);
+        const QString line = data.trimmed();
+        strings += 2;
+        for (const QString &prefix : prefixes)
+        {
+            if (!line.startsWith(prefix)) { continue; }
+            const QString payload = line.mid(prefix.size()).trimmed();
+            const QStringList tokens = payload.split(':');
+            strings += 2 + tokens.size();
+            return tokens.size();
+        }
+        return 0;
+    }
+}
+
+//! main
+BLACKTEST_APPLESS_MAIN(BlackFsdTest::CTestFsdLineParser);
+
+#include "testfsdlineparser.moc"
+
+//! \endcond
@@ -0,0 +1,202 @@
+/* Copyright (C) 2019
+ * swift Project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution and at http://www.swift-project.org/license.html. No part of swift project,
+ * including this file, may be copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+
+/*!
+* \file
+* \ingroup testblackfsd
+*/
+
+#include "blackcore/fsd/sendqueue.h"
+#include "blackcore/fsd/receivequeue.h"
+#include "test.h"
+
+#include <QObject>
+#include <QTest>
+
+using namespace BlackCore::Fsd;
+
+namespace BlackFsdTest
+{
+    //! Testing the FSD send and receive queues
+    class CTestFsdQueues : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        //! Constructor
+        explicit CTestFsdQueues(QObject *parent = nullptr) : QObject(parent) {}
+
+        //! Destructor
+        virtual ~CTestFsdQueues() {}
+
+    private slots:
+        void testSendPriority();
+        void testSendCoalescing();
+        void testSendRateLimit();
+        void testReceivePriority();
+        void testReceiveDeleteOrder();
+
+    private:
+        //! All lines of the receive queue in parse order
+        static QList<QByteArray> takeAll(CFsdReceiveQueue &queue);
+    };
+
+    void CTestFsdQueues::testSendPriority()
+    {
+        CFsdSendQueue queue;
+        QVERIFY(queue.enqueue("$CQABCD:DLH123:CAPS", CFsdSendQueue::PriorityLow));
+        QVERIFY(queue.enqueue("#TMABCD:DLH123:first", CFsdSendQueue::PriorityNormal));
+        QVERIFY(queue.enqueue("@N:ABCD:1", CFsdSendQueue::PriorityHigh));
+        QVERIFY(queue.enqueue("#TMABCD:DLH123:second", CFsdSendQueue::PriorityNormal));
+        QVERIFY(queue.enqueue("@N:ABCD:2", CFsdSendQueue::PriorityHigh));
+        QVERIFY(!queue.enqueue(QString(), CFsdSendQueue::PriorityHigh));
+        QCOMPARE(queue.size(), 5);
+
+        // high priority first, FIFO within a priority
+        const QStringList expected({ "@N:ABCD:1", "@N:ABCD:2", "#TMABCD:DLH123:first", "#TMABCD:DLH123:second", "$CQABCD:DLH123:CAPS" });
+        QCOMPARE(queue.take(3), expected.mid(0, 3));
+        QCOMPARE(queue.take(10), expected.mid(3));
+        QVERIFY(queue.isEmpty());
+        QVERIFY(queue.take(10).isEmpty());
+        QCOMPARE(queue.getStatistics().sent, 5);
+        QCOMPARE(queue.getStatistics().writes, 2);
+    }
+
+    void CTestFsdQueues::testSendCoalescing()
+    {
+        CFsdSendQueue queue;
+        QVERIFY(queue.enqueue("$CQABCD:DLH123:CAPS", CFsdSendQueue::PriorityLow));
+        QVERIFY(!queue.enqueue("$CQABCD:DLH123:CAPS", CFsdSendQueue::PriorityLow));
+        QVERIFY(queue.enqueue("$CQABCD:DLH123:RN", CFsdSendQueue::PriorityLow));
+
+        // only queries are coalesced
+        QVERIFY(queue.enqueue("#TMABCD:DLH123:hello", CFsdSendQueue::PriorityNormal));
+        QVERIFY(queue.enqueue("#TMABCD:DLH123:hello", CFsdSendQueue::PriorityNormal));
+        QCOMPARE(queue.size(), 4);
+        QCOMPARE(queue.getStatistics().coalesced, 1);
+
+        // once sent, the same query is queued again
+        QCOMPARE(queue.take(10).size(), 4);
+        QVERIFY(queue.enqueue("$CQABCD:DLH123:CAPS", CFsdSendQueue::PriorityLow));
+
+        queue.clear();
+        QVERIFY(queue.isEmpty());
+        QVERIFY(queue.enqueue("$CQABCD:DLH123:CAPS", CFsdSendQueue::PriorityLow));
+    }
+
+    void CTestFsdQueues::testSendRateLimit()
+    {
+        QCOMPARE(CFsdSendQueue::messagesPerSendCycle(0), 1);
+        QCOMPARE(CFsdSendQueue::messagesPerSendCycle(5), 1);
+        QCOMPARE(CFsdSendQueue::messagesPerSendCycle(6), 2);
+        QCOMPARE(CFsdSendQueue::messagesPerSendCycle(CFsdSendQueue::OverloadSize), 5);
+        QCOMPARE(CFsdSendQueue::messagesPerSendCycle(CFsdSendQueue::OverloadSize + 1), 15);
+        QCOMPARE(CFsdSendQueue::messagesPerSendCycle(1000), 35);
+
+        int previous = 0;
+        for (int queued = 0; queued < 200; queued++)
+        {
+            const int sendNo = CFsdSendQueue::messagesPerSendCycle(queued);
+            QVERIFY(sendNo >= previous);
+            previous = sendNo;
+        }
+
+        // a send cycle never takes more than the limit
+        CFsdSendQueue queue;
+        for (int i = 0; i < 20; i++) { queue.enqueue(QString("#TMABCD:DLH123:%1").arg(i), CFsdSendQueue::PriorityNormal); }
+        const QStringList sent = queue.take(CFsdSendQueue::messagesPerSendCycle(queue.size()));
+        QCOMPARE(sent.size(), 3);
+        QCOMPARE(sent.front(), QString("#TMABCD:DLH123:0"));
+        QCOMPARE(queue.size(), 17);
+    }
+
+    void CTestFsdQueues::testReceivePriority()
+    {
+        CFsdReceiveQueue queue;
+        queue.enqueue("#TMEDDM_CTR:ABCD:hello", 1);
+        queue.enqueue("$CQEDDM_CTR:ABCD:CAPS", 2);
+        queue.enqueue("@N:DLH123:1200:1:48.35:16.31:12000:123:4261294148:100", 3);
+        queue.enqueue("#DPBAW1:1234567", 4);
+        queue.enqueue("@N:DLH123:1200:1:48.36:16.32:12000:123:4261294148:100", 5);
+        queue.enqueue(QByteArray(), 6);
+        QCOMPARE(queue.size(), 5);
+
+        // positions and deletes first, then the other lines in their order
+        CFsdReceiveQueue::ReceivedLine line;
+        const QList<qint64> expected({ 3, 4, 5, 1, 2 });
+        for (qint64 receivedUs : expected)
+        {
+            QVERIFY(queue.dequeue(line));
+            QCOMPARE(line.receivedUs, receivedUs);
+        }
+        QVERIFY(!queue.dequeue(line));
+        QVERIFY(queue.isEmpty());
+    }
+
+    void CTestFsdQueues::testReceiveDeleteOrder()
+    {
+        CFsdReceiveQueue queue;
+        queue.enqueue("#TMDLH123:EDDM_CTR:bye", 0);
+        queue.enqueue("#TMEDDM_CTR:ABCD:hello", 0);
+        queue.enqueue("#DPDLH123:1234567", 0);                                        // waits for the text message of DLH123
+        queue.enqueue("@N:DLH123:1200:1:48.35:16.31:12000:123:4261294148:100", 0);    // waits for the delete of DLH123
+        queue.enqueue("@N:BAW1:1200:1:48.35:16.31:12000:123:4261294148:100", 0);
+        queue.enqueue("#DABAW1_OBS", 0);
+        queue.enqueue("#DPBAW1:1234567", 0);
+
+        const QList<QByteArray> expected(
+        {
+            "@N:BAW1:1200:1:48.35:16.31:12000:123:4261294148:100",
+            "#DABAW1_OBS",
+            "#DPBAW1:1234567",
+            "#TMDLH123:EDDM_CTR:bye",
+            "#TMEDDM_CTR:ABCD:hello",
+            "#DPDLH123:1234567",
+            "@N:DLH123:1200:1:48.35:16.31:12000:123:4261294148:100"
+        });
+        QCOMPARE(takeAll(queue), expected);
+
+        // all lines of DLH123 parsed, its positions have priority again
+        queue.enqueue("#TMEDDM_CTR:ABCD:hello", 0);
+        queue.enqueue("@N:DLH123:1200:1:48.36:16.32:12000:123:4261294148:100", 0);
+        QCOMPARE(takeAll(queue).front(), QByteArray("@N:DLH123:1200:1:48.36:16.32:12000:123:4261294148:100"));
+
+        // a later position does not overtake a position waiting for a delete
+        queue.enqueue("#TMDLH123:EDDM_CTR:bye", 0);
+        queue.enqueue("#DPDLH123:1234567", 0);
+        queue.enqueue("@N:DLH123:1", 0);
+        queue.enqueue("@N:DLH123:2", 0);
+        QCOMPARE(takeAll(queue), QList<QByteArray>({ "#TMDLH123:EDDM_CTR:bye", "#DPDLH123:1234567", "@N:DLH123:1", "@N:DLH123:2" }));
+
+        queue.enqueue("#TMDLH123:EDDM_CTR:bye", 0);
+        queue.enqueue("#DPDLH123:1234567", 0);
+        queue.clear();
+        QVERIFY(queue.isEmpty());
+        queue.enqueue("#DPDLH123:1234567", 0);
+        queue.enqueue("#TMEDDM_CTR:ABCD:hello", 0);
+        QCOMPARE(takeAll(queue).front(), QByteArray("#DPDLH123:1234567"));
+    }
+
+    QList<QByteArray> CTestFsdQueues::takeAll(CFsdReceiveQueue &queue)
+    {
+        QList<QByteArray> lines;
+        CFsdReceiveQueue::ReceivedLine line;
+        while (queue.dequeue(line)) { lines.push_back(line.data); }
+        return lines;
+    }
+}
+
+//! main
+BLACKTEST_APPLESS_MAIN(BlackFsdTest::CTestFsdQueues);
+
+#include "testfsdqueues.moc"
+
+//! \endcond
@@ -0,0 +1,28 @@
+load(common_pre)
+
+QT += core dbus testlib
+
+TARGET = testfsdqueues
+CONFIG   -= app_bundle
+CONFIG   += blackconfig
+CONFIG   += blackmisc
+CONFIG   += blackcore
+CONFIG   += testcase
+CONFIG   += no_testcase_installs
+
+TEMPLATE = app
+
+DEPENDPATH += \
+    . \
+    $$SourceRoot/src \
+    $$SourceRoot/tests \
+
+INCLUDEPATH += \
+    $$SourceRoot/src \
+    $$SourceRoot/tests \
+
+SOURCES += testfsdqueues.cpp
+
+DESTDIR = $$DestRoot/bin
+
+load(common_post)
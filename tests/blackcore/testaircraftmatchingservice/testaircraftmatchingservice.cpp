@@ -0,0 +1,224 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+
+/*!
+ * \file
+ * \ingroup testblackcore
+ */
+
+#include "blackcore/aircraftmatchingservice.h"
+#include "blackcore/aircraftmatcher.h"
+#include "blackmisc/simulation/aircraftmatchersetup.h"
+#include "blackmisc/simulation/aircraftmodel.h"
+#include "blackmisc/simulation/simulatedaircraft.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/livery.h"
+#include "blackmisc/range.h"
+#include "blackmisc/statusmessagelist.h"
+#include "test.h"
+
+#include <QObject>
+#include <QSignalSpy>
+#include <QTest>
+#include <QTimer>
+#include <QVector>
+
+using namespace BlackMisc;
+using namespace BlackCore;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation;
+
+namespace BlackCoreTest
+{
+    //! Matching of remote aircraft in the background
+    class CTestAircraftMatchingService : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Init the matcher
+        void init();
+
+        //! Clean up
+        void cleanup();
+
+        //! More aircraft than one batch, all delivered once
+        void batchDelivery();
+
+        //! Same aircraft in a batch are only matched once
+        void deduplication();
+
+        //! Removed while queued
+        void dequeueQueued();
+
+        //! Removed or queued again while in work
+        void dequeueInWork();
+
+    private:
+        //! Result of the service
+        struct Result
+        {
+            CSimulatedAircraft aircraft; //!< as queued
+            CAircraftModel model;        //!< matched model
+            CStatusMessageList messages; //!< matching messages
+        };
+
+        //! Remote aircraft
+        static CSimulatedAircraft aircraft(const QString &callsign, const QString &modelString, const QString &icao = "B738");
+
+        //! Wait until all aircraft are matched
+        static bool waitAllMatched(CAircraftMatchingService &service);
+
+        CAircraftMatcher *m_matcher = nullptr;
+        CAircraftMatchingService *m_service = nullptr;
+        QVector<Result> m_results;
+    };
+
+    void CTestAircraftMatchingService::init()
+    {
+        // no model set, every aircraft gets the default model
+        m_matcher = new CAircraftMatcher(this);
+        m_matcher->setDefaultModel(CAircraftModel("DEFAULT", CAircraftModel::TypeOwnSimulatorModel));
+        m_service = new CAircraftMatchingService(m_matcher, this);
+        m_service->setMaxWorkers(1);
+        m_results.clear();
+        connect(m_service, &CAircraftMatchingService::aircraftMatched, this, [this](const CSimulatedAircraft &remoteAircraft, const CAircraftModel &matchedModel, const CStatusMessageList &matchingMessages)
+        {
+            m_results.push_back({ remoteAircraft, matchedModel, matchingMessages });
+        });
+    }
+
+    void CTestAircraftMatchingService::cleanup()
+    {
+        delete m_service;
+        m_service = nullptr;
+        delete m_matcher;
+        m_matcher = nullptr;
+    }
+
+    void CTestAircraftMatchingService::batchDelivery()
+    {
+        const int count = CAircraftMatchingService::MaxBatchSize + 5;
+        for (int i = 0; i < count; i++)
+        {
+            m_service->enqueue(aircraft(QStringLiteral("DLH%1").arg(i), QStringLiteral("MODEL%1").arg(i)), MatchingLogNothing, false);
+        }
+        QCOMPARE(m_service->getQueuedCount(), count);
+
+        QVERIFY(waitAllMatched(*m_service));
+        QCOMPARE(m_results.size(), count);
+        for (int i = 0; i < count; i++)
+        {
+            // one worker, so the order of queueing
+            const CCallsign callsign(QStringLiteral("DLH%1").arg(i));
+            QCOMPARE(m_results[i].aircraft.getCallsign(), callsign);
+            QCOMPARE(m_results[i].model.getCallsign(), callsign);
+            QCOMPARE(m_results[i].model.getModelString(), QString("DEFAULT"));
+        }
+        QCOMPARE(m_service->getQueuedCount(), 0);
+        QCOMPARE(m_service->getInWorkCount(), 0);
+        QCOMPARE(m_service->getDeduplicatedCount(), 0);
+        QCOMPARE(m_service->getDroppedCount(), 0);
+    }
+
+    void CTestAircraftMatchingService::deduplication()
+    {
+        for (int i = 0; i < 5; i++)
+        {
+            m_service->enqueue(aircraft(QStringLiteral("DLH%1").arg(i), "SAME"), MatchingLogNothing, false);
+        }
+        m_service->enqueue(aircraft("BAW1", "OTHER", "A320"), MatchingLogNothing, false);
+
+        // deduplicated independently of the log, the aircraft gets its own message
+        m_service->enqueue(aircraft("DLH9", "SAME"), MatchingLogSimplified, false);
+
+        QVERIFY(waitAllMatched(*m_service));
+        QCOMPARE(m_results.size(), 7);
+        QCOMPARE(m_service->getDeduplicatedCount(), 5);
+        for (const Result &result : as_const(m_results))
+        {
+            QCOMPARE(result.model.getCallsign(), result.aircraft.getCallsign());
+        }
+        QCOMPARE(m_results.last().messages.size(), 1);
+
+        // random picks are matched for each aircraft
+        CAircraftMatcherSetup setup;
+        setup.setPickStrategy(CAircraftMatcherSetup::PickRandom);
+        m_matcher->setSetup(setup);
+        for (int i = 0; i < 3; i++)
+        {
+            m_service->enqueue(aircraft(QStringLiteral("DLH%1").arg(i), "SAME"), MatchingLogNothing, false);
+        }
+        QVERIFY(waitAllMatched(*m_service));
+        QCOMPARE(m_results.size(), 10);
+        QCOMPARE(m_service->getDeduplicatedCount(), 5);
+    }
+
+    void CTestAircraftMatchingService::dequeueQueued()
+    {
+        m_service->enqueue(aircraft("DLH1", "MODEL1"), MatchingLogNothing, false);
+        m_service->enqueue(aircraft("DLH2", "MODEL2"), MatchingLogNothing, false);
+        QVERIFY(m_service->dequeue(CCallsign("DLH1")));
+        QVERIFY(!m_service->dequeue(CCallsign("DLH1")));
+        QVERIFY(!m_service->dequeue(CCallsign("DLH3")));
+        QCOMPARE(m_service->getQueuedCount(), 1);
+
+        QVERIFY(waitAllMatched(*m_service));
+        QCOMPARE(m_results.size(), 1);
+        QCOMPARE(m_results.front().aircraft.getCallsign(), CCallsign("DLH2"));
+    }
+
+    void CTestAircraftMatchingService::dequeueInWork()
+    {
+        m_service->enqueue(aircraft("DLH1", "MODEL1"), MatchingLogNothing, false);
+        m_service->enqueue(aircraft("DLH2", "MODEL2"), MatchingLogNothing, false);
+
+        // runs right after the batch is started, results are delivered by later events
+        int inWork = -1;
+        bool dequeued = false;
+        QTimer::singleShot(0, this, [&]
+        {
+            inWork = m_service->getInWorkCount();
+
+            // DLH1 removed, DLH2 queued again with another model
+            dequeued = m_service->dequeue(CCallsign("DLH1"));
+            m_service->enqueue(aircraft("DLH2", "MODEL2B"), MatchingLogNothing, false);
+        });
+
+        QVERIFY(waitAllMatched(*m_service));
+        QCOMPARE(inWork, 2);
+        QVERIFY(dequeued);
+        QCOMPARE(m_service->getDroppedCount(), 2);
+        QCOMPARE(m_results.size(), 1);
+        QCOMPARE(m_results.front().aircraft.getCallsign(), CCallsign("DLH2"));
+        QCOMPARE(m_results.front().aircraft.getModelString(), QString("MODEL2B"));
+    }
+
+    CSimulatedAircraft CTestAircraftMatchingService::aircraft(const QString &callsign, const QString &modelString, const QString &icao)
+    {
+        CSimulatedAircraft aircraft(CAircraftModel(modelString, CAircraftModel::TypeQueriedFromNetwork, CAircraftIcaoCode(icao), CLivery()));
+        aircraft.setCallsign(CCallsign(callsign));
+        return aircraft;
+    }
+
+    bool CTestAircraftMatchingService::waitAllMatched(CAircraftMatchingService &service)
+    {
+        QSignalSpy spy(&service, &CAircraftMatchingService::allAircraftMatched);
+        return spy.wait(10000) && service.getQueuedCount() == 0 && service.getInWorkCount() == 0;
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackCoreTest::CTestAircraftMatchingService);
+
+#include "testaircraftmatchingservice.moc"
+
+//! \endcond
@@ -0,0 +1,265 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+
+/*!
+ * \file
+ * \ingroup testblackcore
+ */
+
+#include "blackcore/afv/audio/jitterbuffer.h"
+#include "blacksound/codecs/opusdecoder.h"
+#include "blacksound/codecs/opusencoder.h"
+#include "blacksound/sampleprovider/bufferedwaveprovider.h"
+#include "test.h"
+
+#include <QAudioFormat>
+#include <QByteArray>
+#include <QObject>
+#include <QTest>
+#include <QVector>
+#include <QtMath>
+
+using namespace BlackCore::Afv::Audio;
+using namespace BlackSound::Codecs;
+using namespace BlackSound::SampleProvider;
+
+namespace BlackCoreTest
+{
+    //! Jitter buffer of the AFV receivers
+    class CTestJitterBuffer : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Packets arriving out of order within the window
+        void reordering();
+
+        //! Duplicates and packets arriving after their playout are dropped
+        void duplicateAndLate();
+
+        //! Missing packets recovered by FEC or concealed
+        void recoveryAndConcealment();
+
+        //! Gap of the window size or more starts again
+        void restartAfterGap();
+
+        //! Target delay follows the arrival jitter
+        void targetDelay();
+
+    private:
+        static constexpr int SampleRate = 48000;
+        static constexpr int FrameSamples = SampleRate * CJitterBuffer::FrameMs / 1000;
+
+        //! Encoded frame of a tone
+        QByteArray packet();
+
+        //! Format of the audio buffer
+        static QAudioFormat format();
+
+        COpusEncoder m_encoder { SampleRate, 1 };
+        double m_phase = 0.0;
+    };
+
+    void CTestJitterBuffer::reordering()
+    {
+        CJitterBuffer buffer(SampleRate);
+        buffer.reset(CJitterBuffer::MinDelayMs);
+        COpusDecoder decoder(SampleRate, 1);
+        CBufferedWaveProvider output(format());
+
+        QVERIFY(buffer.insert(10, packet(), false, 0));
+        QVERIFY(buffer.insert(12, packet(), true, 40));
+        QVERIFY(buffer.insert(11, packet(), false, 41));
+
+        QVERIFY2(buffer.playout(decoder, output, 50), "Last packet played");
+        QVERIFY(output.getBufferedSamples() >= 3 * FrameSamples);
+        QCOMPARE(buffer.getRecoveredFrames(), 0);
+        QCOMPARE(buffer.getConcealedFrames(), 0);
+        QCOMPARE(buffer.getLatePackets(), 0);
+        QCOMPARE(buffer.getDuplicatePackets(), 0);
+    }
+
+    void CTestJitterBuffer::duplicateAndLate()
+    {
+        CJitterBuffer buffer(SampleRate);
+        buffer.reset(CJitterBuffer::MinDelayMs);
+        COpusDecoder decoder(SampleRate, 1);
+        CBufferedWaveProvider output(format());
+
+        QVERIFY(buffer.insert(10, packet(), false, 0));
+        QVERIFY(!buffer.insert(10, packet(), false, 1));
+        QCOMPARE(buffer.getDuplicatePackets(), 1);
+        QVERIFY(buffer.insert(11, packet(), false, 20));
+        QVERIFY(!buffer.playout(decoder, output, 30));
+
+        // 10 and 11 have been played
+        QVERIFY(!buffer.insert(11, packet(), false, 40));
+        QVERIFY(!buffer.insert(9, packet(), false, 40));
+        QCOMPARE(buffer.getLatePackets(), 2);
+        QCOMPARE(buffer.getDuplicatePackets(), 1);
+        QVERIFY(buffer.insert(12, packet(), true, 40));
+        QVERIFY(buffer.playout(decoder, output, 50));
+
+        // the tail of the transmission played already
+        QVERIFY(!buffer.insert(12, packet(), false, 60));
+        QCOMPARE(buffer.getLatePackets(), 3);
+        QCOMPARE(buffer.getConcealedFrames(), 0);
+    }
+
+    void CTestJitterBuffer::recoveryAndConcealment()
+    {
+        CJitterBuffer buffer(SampleRate);
+        buffer.reset(CJitterBuffer::MinDelayMs);
+        COpusDecoder decoder(SampleRate, 1);
+        CBufferedWaveProvider output(format());
+
+        // 11 missing, 12 carries its FEC data
+        QVERIFY(buffer.insert(10, packet(), false, 0));
+        QVERIFY(buffer.insert(12, packet(), false, 40));
+        QVERIFY(buffer.insert(13, packet(), false, 60));
+        QVERIFY(!buffer.playout(decoder, output, 70));
+        QCOMPARE(buffer.getRecoveredFrames(), 1);
+        QCOMPARE(buffer.getConcealedFrames(), 0);
+        QVERIFY2(!buffer.insert(11, packet(), false, 80), "Recovered, so late");
+
+        // 15 and 16 missing, 15 concealed, 16 recovered from 17
+        output.clearBuffer();
+        QVERIFY(buffer.insert(14, packet(), false, 80));
+        QVERIFY(buffer.insert(17, packet(), false, 140));
+        buffer.playout(decoder, output, 150);
+        output.clearBuffer();
+        buffer.playout(decoder, output, 160);
+        QCOMPARE(buffer.getConcealedFrames(), 1);
+        QCOMPARE(buffer.getRecoveredFrames(), 2);
+
+        // enough audio buffered, waiting for the missing packet
+        output.clearBuffer();
+        output.addSilence(3 * FrameSamples);
+        QVERIFY(buffer.insert(20, packet(), false, 200));
+        buffer.playout(decoder, output, 210);
+        QCOMPARE(buffer.getConcealedFrames(), 1);
+        QCOMPARE(buffer.getRecoveredFrames(), 2);
+
+        // running low, 18 concealed, 19 recovered from 20
+        output.clearBuffer();
+        buffer.playout(decoder, output, 220);
+        QCOMPARE(buffer.getConcealedFrames(), 2);
+        QCOMPARE(buffer.getRecoveredFrames(), 3);
+    }
+
+    void CTestJitterBuffer::restartAfterGap()
+    {
+        CJitterBuffer buffer(SampleRate);
+        buffer.reset(CJitterBuffer::MinDelayMs);
+        COpusDecoder decoder(SampleRate, 1);
+        CBufferedWaveProvider output(format());
+
+        // gap within the window, the missing packets are concealed
+        QVERIFY(buffer.insert(10, packet(), false, 0));
+        buffer.playout(decoder, output, 10);
+        output.clearBuffer();
+        QVERIFY(buffer.insert(11 + CJitterBuffer::WindowFrames - 1, packet(), false, 20));
+        buffer.playout(decoder, output, 30);
+        QVERIFY(buffer.getConcealedFrames() > 0);
+
+        // gap of the window size, started again with the new packet
+        buffer.reset(CJitterBuffer::MinDelayMs);
+        output.clearBuffer();
+        QVERIFY(buffer.insert(10, packet(), false, 0));
+        buffer.playout(decoder, output, 10);
+        output.clearBuffer();
+        const uint restart = 11 + CJitterBuffer::WindowFrames;
+        QVERIFY(buffer.insert(restart, packet(), false, 20));
+        QVERIFY(buffer.insert(restart + 1, packet(), true, 40));
+        QVERIFY(buffer.playout(decoder, output, 50));
+        QCOMPARE(buffer.getConcealedFrames(), 0);
+        QCOMPARE(buffer.getRecoveredFrames(), 0);
+        QVERIFY(output.getBufferedSamples() >= 2 * FrameSamples);
+
+        // the packets before the restart are late
+        QVERIFY(!buffer.insert(12, packet(), false, 60));
+        QCOMPARE(buffer.getLatePackets(), 1);
+    }
+
+    void CTestJitterBuffer::targetDelay()
+    {
+        // copies, QCOMPARE takes references
+        const int minDelayMs = CJitterBuffer::MinDelayMs;
+        const int maxDelayMs = CJitterBuffer::MaxDelayMs;
+
+        CJitterBuffer buffer(SampleRate);
+        buffer.reset(1000);
+        QCOMPARE(buffer.getTargetDelayMs(), maxDelayMs);
+        buffer.reset(0);
+        QCOMPARE(buffer.getTargetDelayMs(), minDelayMs);
+
+        // regular arrivals, the initial delay is kept until 10 packets are received
+        buffer.reset(100);
+        for (uint sequence = 0; sequence < 9; sequence++)
+        {
+            QVERIFY(buffer.insert(sequence, packet(), false, 1000 + sequence * CJitterBuffer::FrameMs));
+        }
+        QCOMPARE(buffer.getTargetDelayMs(), 100);
+        QVERIFY(buffer.insert(9, packet(), false, 1000 + 9 * CJitterBuffer::FrameMs));
+        QCOMPARE(buffer.getJitterMs(), 0);
+        QCOMPARE(buffer.getTargetDelayMs(), minDelayMs);
+
+        // every 2nd packet 60ms late
+        buffer.reset(CJitterBuffer::MinDelayMs);
+        for (uint sequence = 0; sequence < 12; sequence++)
+        {
+            const qint64 delayMs = sequence % 2 ? 60 : 0;
+            QVERIFY(buffer.insert(sequence, packet(), false, 1000 + sequence * CJitterBuffer::FrameMs + delayMs));
+        }
+        QCOMPARE(buffer.getJitterMs(), 60);
+        QCOMPARE(buffer.getTargetDelayMs(), 60 + CJitterBuffer::FrameMs);
+
+        // one packet 500ms late, limited
+        buffer.reset(CJitterBuffer::MinDelayMs);
+        for (uint sequence = 0; sequence < 12; sequence++)
+        {
+            const qint64 delayMs = sequence == 5 ? 500 : 0;
+            QVERIFY(buffer.insert(sequence, packet(), false, 1000 + sequence * CJitterBuffer::FrameMs + delayMs));
+        }
+        QCOMPARE(buffer.getJitterMs(), 500);
+        QCOMPARE(buffer.getTargetDelayMs(), maxDelayMs);
+    }
+
+    QByteArray CTestJitterBuffer::packet()
+    {
+        QVector<qint16> samples(FrameSamples);
+        for (qint16 &sample : samples)
+        {
+            sample = static_cast<qint16>(8000.0 * qSin(m_phase));
+            m_phase += 2.0 * M_PI * 440.0 / SampleRate;
+        }
+        int length = 0;
+        return m_encoder.encode(samples, FrameSamples, &length);
+    }
+
+    QAudioFormat CTestJitterBuffer::format()
+    {
+        QAudioFormat format;
+        format.setSampleRate(SampleRate);
+        format.setChannelCount(1);
+        format.setSampleSize(32);
+        format.setSampleType(QAudioFormat::Float);
+        format.setByteOrder(QAudioFormat::LittleEndian);
+        format.setCodec("audio/pcm");
+        return format;
+    }
+} // namespace
+
+//! main
+BLACKTEST_APPLESS_MAIN(BlackCoreTest::CTestJitterBuffer);
+
+#include "testjitterbuffer.moc"
+
+//! \endcond
@@ -0,0 +1,29 @@
+load(common_pre)
+
+QT += core dbus network testlib multimedia qml
+
+TARGET = testjitterbuffer
+CONFIG   -= app_bundle
+CONFIG   += blackconfig
+CONFIG   += blackmisc
+CONFIG   += blackcore
+CONFIG   += blacksound
+CONFIG   += testcase
+CONFIG   += no_testcase_installs
+
+TEMPLATE = app
+
+DEPENDPATH += \
+    . \
+    $$SourceRoot/src \
+    $$SourceRoot/tests \
+
+INCLUDEPATH += \
+    $$SourceRoot/src \
+    $$SourceRoot/tests \
+
+SOURCES += testjitterbuffer.cpp
+
+DESTDIR = $$DestRoot/bin
+
+load(common_post)
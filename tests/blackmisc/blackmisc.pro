@@ -19,6 +19,7 @@ SUBDIRS += \
     testsharedstate \
     testsharedstate/sharedstatetestserver \
     testslot \
+    testspscqueue \
     teststatusmessage \
     teststringutils \
     testvaluecache \
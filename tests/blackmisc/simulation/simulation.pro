@@ -1,6 +1,18 @@
 TEMPLATE = subdirs
 SUBDIRS += \
+    testaircraftcfgmanifest \
+    testaircraftmodelinterner \
+    testaircraftmodelscoring \
+    testaircraftmodelsetindex \
+    testfilemanifest \
+    testinterpolationkernels \
+    testinterpolationrecorder \
     testinterpolatorlinear \
     testinterpolatormisc \
     testinterpolatorparts \
+    testmatchingresultcache \
+    testmodelbinarycache \
+    testmodelfingerprintcache \
+    testmodelsetchanges \
+    testsituationhistorystore \
     testxplane \
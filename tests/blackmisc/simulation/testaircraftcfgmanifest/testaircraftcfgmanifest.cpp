@@ -0,0 +1,121 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/fscommon/aircraftcfgmanifest.h"
+#include "blackmisc/simulation/fscommon/aircraftcfgentries.h"
+#include "blackmisc/simulation/fscommon/aircraftcfgentrieslist.h"
+#include "test.h"
+
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace BlackMisc::Simulation::FsCommon;
+
+namespace BlackMiscTest
+{
+    //! Manifest of the parsed aircraft.cfg files
+    class CTestAircraftCfgManifest : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Same modification time and size
+        void unchanged();
+
+        //! Modified files, same or other content
+        void modified();
+
+        //! Entries written and read back, see CTestFileManifest for the file handling
+        void saveAndLoad();
+
+    private:
+        //! Entry of a file with one aircraft
+        static CAircraftCfgManifest::Entry entry(const QString &fileName, const QByteArray &content, qint64 lastModified, const QString &title);
+    };
+
+    void CTestAircraftCfgManifest::unchanged()
+    {
+        CAircraftCfgManifest manifest;
+        const QString file("C:/FSX/SimObjects/Airplanes/B738/aircraft.cfg");
+        manifest.insert(file, entry(file, "[fltsim.0]", 1000, "B738"));
+
+        const CAircraftCfgManifest::Entry *found = manifest.findUnchanged(file, 1000, 10);
+        QVERIFY(found);
+        QCOMPARE(found->entries.size(), 1);
+        QCOMPARE(found->entries.front().getTitle(), QString("B738"));
+
+        // file names are compared case insensitive
+        QVERIFY(manifest.findUnchanged("c:/fsx/simobjects/airplanes/b738/AIRCRAFT.CFG", 1000, 10));
+        QVERIFY(!manifest.findUnchanged("C:/FSX/SimObjects/Airplanes/A320/aircraft.cfg", 1000, 10));
+    }
+
+    void CTestAircraftCfgManifest::modified()
+    {
+        CAircraftCfgManifest manifest;
+        const QString file("C:/FSX/SimObjects/Airplanes/B738/aircraft.cfg");
+        manifest.insert(file, entry(file, "[fltsim.0]", 1000, "B738"));
+
+        // time or size changed, the file has to be read
+        QVERIFY(!manifest.findUnchanged(file, 2000, 10));
+        QVERIFY(!manifest.findUnchanged(file, 1000, 11));
+
+        // touched, same content: no need to parse
+        QVERIFY(manifest.findSameContent(file, CAircraftCfgManifest::contentHash("[fltsim.0]")));
+        QVERIFY(!manifest.findSameContent(file, CAircraftCfgManifest::contentHash("[fltsim.1]")));
+        QVERIFY(!manifest.findSameContent(file, QByteArray()));
+
+        // the parsed file replaces the entry
+        manifest.insert(file, entry(file, "[fltsim.1]", 2000, "B738 new"));
+        QCOMPARE(manifest.size(), 1);
+        QVERIFY(!manifest.findUnchanged(file, 1000, 10));
+        const CAircraftCfgManifest::Entry *found = manifest.findUnchanged(file, 2000, 10);
+        QVERIFY(found);
+        QCOMPARE(found->entries.front().getTitle(), QString("B738 new"));
+    }
+
+    void CTestAircraftCfgManifest::saveAndLoad()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString manifestFile = dir.filePath("sub/aircraftcfg.manifest");
+
+        CAircraftCfgManifest manifest;
+        const QString file("C:/FSX/SimObjects/Airplanes/B738/Aircraft.cfg");
+        manifest.insert(file, entry(file, "[fltsim.0]", 1000, "B738"));
+        QVERIFY(manifest.save(manifestFile).isSuccess());
+
+        CAircraftCfgManifest loaded;
+        QVERIFY(loaded.load(manifestFile));
+        QCOMPARE(loaded.size(), 1);
+        const CAircraftCfgManifest::Entry *found = loaded.findUnchanged(file, 1000, 10);
+        QVERIFY(found);
+        QCOMPARE(found->hash, CAircraftCfgManifest::contentHash("[fltsim.0]"));
+        QCOMPARE(found->entries.front().getTitle(), QString("B738"));
+    }
+
+    CAircraftCfgManifest::Entry CTestAircraftCfgManifest::entry(const QString &fileName, const QByteArray &content, qint64 lastModified, const QString &title)
+    {
+        CAircraftCfgManifest::Entry entry;
+        entry.lastModified = lastModified;
+        entry.size = 10;
+        entry.hash = CAircraftCfgManifest::contentHash(content);
+        entry.entries.push_back(CAircraftCfgEntries(fileName, 0, title, "Boeing", "B738", "", ""));
+        return entry;
+    }
+} // namespace
+
+//! main
+BLACKTEST_APPLESS_MAIN(BlackMiscTest::CTestAircraftCfgManifest);
+
+#include "testaircraftcfgmanifest.moc"
+
+//! \endcond
@@ -0,0 +1,152 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/aircraftmodelinterner.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/distributor.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/airlineicaocode.h"
+#include "blackmisc/aviation/livery.h"
+#include "test.h"
+
+#include <QJsonObject>
+#include <QTest>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! Interning of the shared data of models
+    class CTestAircraftModelInterner : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Interned models are the same models
+        void sameModels();
+
+        //! Identical objects share their data
+        void sharedData();
+
+        //! Objects only equal when ignoring the case are not merged
+        void caseKept();
+
+    private:
+        //! String not sharing data with any other string
+        static QString str(const char *string) { return QString::fromLatin1(string); }
+
+        //! Create a model, all strings are separate copies
+        static CAircraftModel model(const char *modelString, const char *designator, const char *airline, const char *livery, const char *distributor);
+    };
+
+    CAircraftModel CTestAircraftModelInterner::model(const char *modelString, const char *designator, const char *airline, const char *livery, const char *distributor)
+    {
+        const CAircraftIcaoCode icao(str(designator), str("L2J"), str("Manufacturer"), str("Model"), str("M"), false, false, false, 0);
+        const CLivery l(str(livery), CAirlineIcaoCode(str(airline)), str("Livery description"));
+        CAircraftModel m(str(modelString), CAircraftModel::TypeOwnSimulatorModel, icao, l);
+        m.setDistributor(CDistributor(str(distributor)));
+        m.setDescription(str("Description"));
+        m.setFileName(str("C:/SimObjects/aircraft.cfg"));
+        return m;
+    }
+
+    void CTestAircraftModelInterner::sameModels()
+    {
+        const CAircraftModelList models(
+        {
+            model("DLH A320", "A320", "DLH", "DLH.STD", "FSX"),
+            model("DLH A321", "A321", "DLH", "DLH.STD", "FSX"),
+            model("BAW A320", "A320", "BAW", "BAW.STD", "WOAI"),
+            model("C172",     "C172", "",    "",        "FSX")
+        });
+
+        CAircraftModelList interned(models);
+        CAircraftModelInterner interner;
+        interner.intern(interned);
+
+        QCOMPARE(interned, models);
+        for (int i = 0; i < models.sizeInt(); i++)
+        {
+            QCOMPARE(interned[i].getModelString(), models[i].getModelString());
+            QCOMPARE(interned[i].getLivery().getCombinedCode(), models[i].getLivery().getCombinedCode());
+            QCOMPARE(interned[i].getDistributor().getDbKey(), models[i].getDistributor().getDbKey());
+            QCOMPARE(interned[i].getDescription(), models[i].getDescription());
+        }
+
+        QCOMPARE(interner.getAircraftIcaoCodesCount(), 3);
+        QCOMPARE(interner.getAirlineIcaoCodesCount(), 3);
+        QCOMPARE(interner.getLiveriesCount(), 3);
+        QCOMPARE(interner.getDistributorsCount(), 2);
+    }
+
+    void CTestAircraftModelInterner::sharedData()
+    {
+        CAircraftModelList models(
+        {
+            model("DLH A320", "A320", "DLH", "DLH.STD", "FSX"),
+            model("BAW A320", "A320", "BAW", "BAW.STD", "FSX"),
+            model("DLH A321", "A321", "DLH", "DLH.RET", "WOAI")
+        });
+        QVERIFY(models[0].getAircraftIcaoCodeDesignator().constData() != models[1].getAircraftIcaoCodeDesignator().constData());
+
+        CAircraftModelInterner::internModels(models);
+
+        // same aircraft ICAO code
+        QCOMPARE(models[0].getAircraftIcaoCodeDesignator().constData(), models[1].getAircraftIcaoCodeDesignator().constData());
+        QCOMPARE(models[0].getAircraftIcaoCode().getManufacturer().constData(), models[2].getAircraftIcaoCode().getManufacturer().constData());
+
+        // same airline in different liveries
+        QCOMPARE(models[0].getAirlineIcaoCodeDesignator().constData(), models[2].getAirlineIcaoCodeDesignator().constData());
+
+        // same distributor and strings
+        QCOMPARE(models[0].getDistributor().getDbKey().constData(), models[1].getDistributor().getDbKey().constData());
+        QCOMPARE(models[0].getFileName().constData(), models[2].getFileName().constData());
+        QCOMPARE(models[0].getDescription().constData(), models[1].getDescription().constData());
+    }
+
+    void CTestAircraftModelInterner::caseKept()
+    {
+        CAircraftModelList models(
+        {
+            model("DLH A320", "A320", "DLH", "DLH.STD", "FSX"),
+            model("DLH A321", "A321", "DLH", "DLH.STD", "FSX")
+        });
+
+        // the setters use upper case, but loaded data may not
+        CLivery livery(models[1].getLivery());
+        QJsonObject json = livery.toJson();
+        json.insert("combinedCode", "dlh.std");
+        livery.convertFromJson(json);
+        models[1].setLivery(livery);
+        models[1].setDistributor(CDistributor("FSX", "Description", "Alias", "ALIAS"));
+        models[0].setDistributor(CDistributor("FSX", "Description", "ALIAS", "ALIAS"));
+        QCOMPARE(models[0].getLivery(), models[1].getLivery());
+        QCOMPARE(models[0].getDistributor(), models[1].getDistributor());
+
+        CAircraftModelInterner interner;
+        interner.intern(models);
+
+        QCOMPARE(models[0].getLivery().getCombinedCode(), QStringLiteral("DLH.STD"));
+        QCOMPARE(models[1].getLivery().getCombinedCode(), QStringLiteral("dlh.std"));
+        QCOMPARE(models[1].getDistributor().getAlias1(), QStringLiteral("Alias"));
+        QCOMPARE(interner.getLiveriesCount(), 2);
+        QCOMPARE(interner.getDistributorsCount(), 2);
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestAircraftModelInterner);
+
+#include "testaircraftmodelinterner.moc"
+
+//! \endcond
@@ -0,0 +1,219 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/aircraftmodelscoring.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/airlineicaocode.h"
+#include "blackmisc/aviation/livery.h"
+#include "test.h"
+
+#include <QElapsedTimer>
+#include <QTest>
+#include <QtDebug>
+#include <algorithm>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! Parallel and pruned scoring compared with CAircraftModelList::scoreFull
+    class CTestAircraftModelScoring : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Upper bounds are never below the scores
+        void upperBounds();
+
+        //! Same best scores as scoreFull
+        void sameAsScoreFull();
+
+        //! Top K with pruning equals top K without pruning
+        void topK();
+
+        //! Timing of 500 remote aircraft with 30k models
+        void benchmark();
+
+    private:
+        //! Synthetic model set
+        static CAircraftModelList modelSet(int size);
+
+        //! Synthetic remote models
+        static CAircraftModelList remoteModels(int size);
+
+        //! Create a model
+        static CAircraftModel model(int i, bool remote);
+
+        //! Ids of the best scores as in scoreFull, ascending
+        static QVector<int> scoreFullIds(const CAircraftModelList &models, const CAircraftModel &remoteModel, bool preferColorLiveries, bool ignoreZeroScores, int &maxScore);
+    };
+
+    CAircraftModel CTestAircraftModelScoring::model(int i, bool remote)
+    {
+        static const QStringList designators({ "A319", "A320", "A321", "A332", "B737", "B738", "B744", "B77W", "C172", "CRJ9", "E190", "DH8D", "EC35", "C130" });
+        static const QStringList combinedTypes({ "L2J", "L2J", "L2J", "L2J", "L2J", "L2J", "L4J", "L2J", "L1P", "L2J", "L2J", "L2T", "H2T", "L4T" });
+        static const QStringList manufacturers({ "AIRBUS", "AIRBUS", "AIRBUS", "AIRBUS", "BOEING", "BOEING", "BOEING", "BOEING", "CESSNA", "BOMBARDIER", "EMBRAER", "BOMBARDIER", "EUROCOPTER", "LOCKHEED" });
+        static const QStringList families({ "A320", "A320", "A320", "A330", "B737", "B737", "B747", "B777", "", "CRJ", "E190", "DH8", "", "" });
+        static const QStringList airlines({ "DLH", "BAW", "AFR", "KLM", "UAL", "DAL", "EZY", "RYR", "SWR", "AUA", "" });
+
+        // remote aircraft use other combinations than the set
+        const int d = (remote ? i * 5 + 3 : i) % designators.size();
+        const int a = (remote ? i * 3 + 1 : i / 7) % airlines.size();
+        CAircraftIcaoCode icao(designators.at(d), combinedTypes.at(d), manufacturers.at(d), "", "M", true, false, false, i % 11);
+        icao.setFamily(families.at(d));
+        icao.setMilitary(designators.at(d) == "C130");
+        if (!remote) { icao.setDbKey(d + 1); }
+
+        const QString airline = airlines.at(a);
+        const bool color = airline.isEmpty() || (!remote && i % 13 == 0);
+        const CLivery livery = color ?
+                               CLivery(CLivery::colorLiveryMarker() + QStringLiteral("%1").arg(i % 255, 6, 16, QChar('0')), CAirlineIcaoCode(), "") :
+                               CLivery(airline + ".STD", CAirlineIcaoCode(airline), "");
+        return CAircraftModel(QStringLiteral("%1 %2 %3").arg(airline, designators.at(d)).arg(i), CAircraftModel::TypeOwnSimulatorModel, icao, livery);
+    }
+
+    CAircraftModelList CTestAircraftModelScoring::modelSet(int size)
+    {
+        CAircraftModelList models;
+        for (int i = 0; i < size; i++) { models.push_back(model(i, false)); }
+        return models;
+    }
+
+    CAircraftModelList CTestAircraftModelScoring::remoteModels(int size)
+    {
+        CAircraftModelList models;
+        for (int i = 0; i < size; i++) { models.push_back(model(i, true)); }
+        return models;
+    }
+
+    QVector<int> CTestAircraftModelScoring::scoreFullIds(const CAircraftModelList &models, const CAircraftModel &remoteModel, bool preferColorLiveries, bool ignoreZeroScores, int &maxScore)
+    {
+        maxScore = -1;
+        const ScoredModels map = models.scoreFull(remoteModel, preferColorLiveries, ignoreZeroScores);
+        if (map.isEmpty()) { return {}; }
+        maxScore = map.lastKey();
+
+        // model strings are unique, map to ids
+        const QStringList modelStrings = models.getModelStringList(false);
+        QVector<int> ids;
+        for (const CAircraftModel &model : map.values(maxScore)) { ids.push_back(modelStrings.indexOf(model.getModelString())); }
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+    void CTestAircraftModelScoring::upperBounds()
+    {
+        const CAircraftModelList models = modelSet(500);
+        const CAircraftModelList remotes = remoteModels(20);
+        for (const CAircraftModel &remote : remotes)
+        {
+            for (const CAircraftModel &model : models)
+            {
+                for (bool prefer : { false, true })
+                {
+                    QVERIFY2(model.calculateScoreUpperBound(remote, prefer) >= model.calculateScore(remote, prefer), qPrintable(model.getModelString()));
+                }
+            }
+        }
+    }
+
+    void CTestAircraftModelScoring::sameAsScoreFull()
+    {
+        const CAircraftModelList models = modelSet(3000);
+        const CAircraftModelList remotes = remoteModels(15);
+        for (const CAircraftModel &remote : remotes)
+        {
+            for (bool prefer : { false, true })
+            {
+                for (bool ignoreZeros : { true, false })
+                {
+                    int maxScore = -1;
+                    const QVector<int> ids = scoreFullIds(models, remote, prefer, ignoreZeros, maxScore);
+                    for (int threads : { 1, 3 })
+                    {
+                        const CAircraftModelScores scores = CAircraftModelScoring::scoreTopK(models, remote, prefer, ignoreZeros, 0, threads);
+                        QCOMPARE(scores.maxScore, maxScore);
+                        QCOMPARE(scores.maxScoreIds, ids);
+                        QVERIFY(scores.topK.isEmpty());
+                    }
+                }
+            }
+        }
+
+        QVERIFY(CAircraftModelScoring::scoreTopK(CAircraftModelList(), remotes.front(), false).isEmpty());
+    }
+
+    void CTestAircraftModelScoring::topK()
+    {
+        const CAircraftModelList models = modelSet(5000);
+        const CAircraftModelList remotes = remoteModels(10);
+        for (const CAircraftModel &remote : remotes)
+        {
+            const CAircraftModelScores reference = CAircraftModelScoring::scoreTopKNoPruning(models, remote, false, true, 25, 1);
+            QCOMPARE(reference.pruned, 0);
+            QCOMPARE(reference.topK.size(), 25);
+            QCOMPARE(reference.topK.front().score, reference.maxScore);
+            for (int threads : { 1, 4 })
+            {
+                const CAircraftModelScores scores = CAircraftModelScoring::scoreTopK(models, remote, false, true, 25, threads);
+                QCOMPARE(scores.maxScoreIds, reference.maxScoreIds);
+                QCOMPARE(scores.topK.size(), reference.topK.size());
+                for (int i = 0; i < scores.topK.size(); i++)
+                {
+                    QCOMPARE(scores.topK.at(i).id, reference.topK.at(i).id);
+                    QCOMPARE(scores.topK.at(i).score, reference.topK.at(i).score);
+                }
+            }
+        }
+    }
+
+    void CTestAircraftModelScoring::benchmark()
+    {
+        const CAircraftModelList models = modelSet(30000);
+        const CAircraftModelList remotes = remoteModels(500);
+        QElapsedTimer timer;
+
+        // scoreFull copies all models into the map, only a sample of the remote aircraft
+        const int fullSamples = 20;
+        timer.start();
+        int checkFull = 0;
+        for (int i = 0; i < fullSamples; i++)
+        {
+            checkFull += models.scoreFull(remotes[i], false, true).lastKey();
+        }
+        const qint64 fullNs = timer.nsecsElapsed();
+
+        timer.start();
+        int checkTopK = 0;
+        int pruned = 0;
+        for (int i = 0; i < remotes.size(); i++)
+        {
+            const CAircraftModelScores scores = CAircraftModelScoring::scoreTopK(models, remotes[i], false, true, 10);
+            if (i < fullSamples) { checkTopK += scores.maxScore; }
+            pruned += scores.pruned;
+        }
+        const qint64 topKNs = timer.nsecsElapsed();
+        QCOMPARE(checkTopK, checkFull);
+
+        qDebug() << "scoreFull" << (fullNs / fullSamples / 1000000.0) << "ms per aircraft," << models.size() << "models";
+        qDebug() << "scoreTopK" << (topKNs / remotes.size() / 1000000.0) << "ms per aircraft," << remotes.size() << "aircraft, pruned" << (pruned / remotes.size()) << "models per aircraft";
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestAircraftModelScoring);
+
+#include "testaircraftmodelscoring.moc"
+
+//! \endcond
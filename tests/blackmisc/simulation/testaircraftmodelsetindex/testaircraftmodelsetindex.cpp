@@ -0,0 +1,187 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/aircraftmodelsetindex.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/airlineicaocode.h"
+#include "blackmisc/aviation/livery.h"
+#include "test.h"
+
+#include <QTest>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! Indexed model set, results compared with the model list functions
+    class CTestAircraftModelSetIndex : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Index lookups
+        void lookups();
+
+        //! Combined type, manufacturer and livery reductions
+        void reductions();
+
+        //! Flags and id list helpers
+        void flagsAndIds();
+
+    private:
+        //! A small model set
+        static CAircraftModelList modelSet();
+
+        //! Model strings for comparison
+        static QStringList modelStrings(const CAircraftModelList &models) { return models.getModelStringList(false); }
+
+        //! Create a model
+        static CAircraftModel model(const QString &modelString, const QString &designator, const QString &combinedType, const QString &manufacturer, const QString &family, const QString &airline, const QString &livery, int groupId = -1);
+    };
+
+    CAircraftModel CTestAircraftModelSetIndex::model(const QString &modelString, const QString &designator, const QString &combinedType, const QString &manufacturer, const QString &family, const QString &airline, const QString &livery, int groupId)
+    {
+        CAircraftIcaoCode icao(designator, combinedType, manufacturer, "", "M", true, false, false, 0);
+        icao.setFamily(family);
+        CAirlineIcaoCode airlineIcao(airline);
+        airlineIcao.setGroupId(groupId);
+        CAircraftModel m(modelString, CAircraftModel::TypeOwnSimulatorModel, icao, CLivery(livery, airlineIcao, ""));
+        return m;
+    }
+
+    CAircraftModelList CTestAircraftModelSetIndex::modelSet()
+    {
+        CAircraftModelList models;
+        models.push_back(model("DLH A320", "A320", "L2J", "AIRBUS", "A320", "DLH", "DLH.STD", 1));
+        models.push_back(model("EWG A320", "A320", "L2J", "AIRBUS", "A320", "EWG", "EWG.STD", 1));
+        models.push_back(model("DLH A321", "A321", "L2J", "AIRBUS", "A320", "DLH", "DLH.STD", 1));
+        models.push_back(model("BAW B738", "B738", "L2J", "BOEING", "B737", "BAW", "BAW.STD"));
+        models.push_back(model("COLOR B738", "B738", "L2J", "BOEING", "B737", "", CLivery::colorLiveryMarker() + "FFFFFF"));
+        models.push_back(model("C172", "C172", "L1P", "CESSNA", "", "", ""));
+        models.push_back(model("EC35", "EC35", "H2T", "EUROCOPTER", "", "", ""));
+
+        CAircraftModel mil = model("MIL C130", "C130", "L4T", "LOCKHEED", "", "", "");
+        CAircraftIcaoCode milIcao = mil.getAircraftIcaoCode();
+        milIcao.setMilitary(true);
+        mil.setAircraftIcaoCode(milIcao);
+        mil.setModelStringAlias("HERC");
+        models.push_back(mil);
+
+        CAircraftModel excluded = model("EXCLUDED B744", "B744", "L4J", "BOEING", "B747", "BAW", "BAW.STD");
+        excluded.setModelMode(CAircraftModel::Exclude);
+        excluded.setDbKey(4711);
+        models.push_back(excluded);
+        return models;
+    }
+
+    void CTestAircraftModelSetIndex::lookups()
+    {
+        const CAircraftModelList models = modelSet();
+        const CAircraftModelSetIndex index(models);
+        QCOMPARE(index.size(), models.sizeInt());
+        QCOMPARE(modelStrings(index.toModels(index.allIds())), modelStrings(models));
+
+        for (const QString &designator : { "A320", "B738", "C172", "XXXX" })
+        {
+            QCOMPARE(modelStrings(index.toModels(index.findByAircraftDesignator(designator))),
+                     modelStrings(models.findByIcaoDesignators(CAircraftIcaoCode(designator), CAirlineIcaoCode())));
+        }
+        for (const QString &airline : { "DLH", "BAW", "XXX" })
+        {
+            QCOMPARE(modelStrings(index.toModels(index.findByAirlineDesignator(airline))),
+                     modelStrings(models.findByIcaoDesignators(CAircraftIcaoCode(), CAirlineIcaoCode(airline))));
+        }
+        for (const QString &family : { "A320", "b737 ", "", "XXXX" })
+        {
+            QCOMPARE(modelStrings(index.toModels(index.findByFamily(family))), modelStrings(models.findByFamily(family)));
+        }
+        for (const QString &manufacturer : { "AIRBUS", "boeing", "" })
+        {
+            QCOMPARE(modelStrings(index.toModels(index.findByManufacturer(manufacturer))), modelStrings(models.findByManufacturer(manufacturer)));
+        }
+
+        CAirlineIcaoCode group("DLH");
+        group.setGroupId(1);
+        QCOMPARE(modelStrings(index.toModels(index.findByAirlineGroup(1))), modelStrings(models.findByAirlineGroup(group)));
+        QVERIFY(index.findByAirlineGroup(-1).isEmpty());
+
+        QCOMPARE(index.findFirstByModelStringOrAlias("dlh a320"), 0);
+        QCOMPARE(index.findFirstByModelStringOrAlias("herc"), 7);
+        QCOMPARE(index.findFirstByModelStringOrAlias("unknown"), -1);
+        QCOMPARE(index.findFirstByModelStringOrAlias(""), -1);
+    }
+
+    void CTestAircraftModelSetIndex::reductions()
+    {
+        const CAircraftModelList models = modelSet();
+        const CAircraftModelSetIndex index(models);
+        const CAircraftModelSetIndex::Ids all = index.allIds();
+
+        for (const QString &ct : { "L2J", "L*J", "L-P", "H2T", "L2", "" })
+        {
+            QCOMPARE(modelStrings(index.toModels(index.findByCombinedType(all, ct))), modelStrings(models.findByCombinedType(ct)));
+            QCOMPARE(modelStrings(index.toModels(index.findColorLiveries(index.findByCombinedType(all, ct)))), modelStrings(models.findByCombinedTypeWithColorLivery(ct)));
+        }
+
+        const QList<QPair<QString, QString>> cms({ { "L2J", "AIRBUS" }, { "L2J", "boeing" }, { "L2J", "" }, { "", "CESSNA" }, { "L*J", "BOEING" } });
+        for (const auto &cm : cms)
+        {
+            QCOMPARE(modelStrings(index.toModels(index.findByCombinedAndManufacturer(all, cm.first, cm.second))),
+                     modelStrings(models.findByCombinedAndManufacturer(cm.first, cm.second)));
+        }
+
+        QCOMPARE(modelStrings(index.toModels(index.findByAircraftDesignatorAndLiveryCombinedCode(all, "a320", "dlh.std"))),
+                 modelStrings(models.findByAircraftDesignatorAndLiveryCombinedCode("a320", "dlh.std")));
+        QVERIFY(index.findByAircraftDesignatorAndLiveryCombinedCode(all, "", "DLH.STD").isEmpty());
+
+        // reductions keep the order of the input ids
+        const CAircraftModelSetIndex::Ids reversed({ 4, 3, 2, 1, 0 });
+        QCOMPARE(index.findByCombinedType(reversed, "L2J"), reversed);
+        QCOMPARE(CAircraftModelSetIndex::intersect(reversed, index.findByManufacturer("BOEING")), CAircraftModelSetIndex::Ids({ 4, 3 }));
+    }
+
+    void CTestAircraftModelSetIndex::flagsAndIds()
+    {
+        const CAircraftModelList models = modelSet();
+        const CAircraftModelSetIndex index(models);
+        const CAircraftModelSetIndex::Ids all = index.allIds();
+
+        QCOMPARE(modelStrings(index.toModels(index.findByMilitaryFlag(all, true))), modelStrings(models.findByMilitaryFlag(true)));
+        QCOMPARE(modelStrings(index.toModels(index.findByMilitaryFlag(all, false))), modelStrings(models.findByMilitaryFlag(false)));
+        QCOMPARE(modelStrings(index.toModels(index.findByVtolFlag(all, true))), modelStrings(models.findByVtolFlag(true)));
+        QCOMPARE(index.containsVtol(all), models.containsVtol());
+        QVERIFY(!index.containsVtol(index.findByAircraftDesignator("A320")));
+
+        QCOMPARE(index.findWithDbKey(all), CAircraftModelSetIndex::Ids({ 8 }));
+        QCOMPARE(index.findNotExcluded(all).size(), models.sizeInt() - 1);
+        QCOMPARE(index.findWithModelString(all), all);
+
+        const CAircraftModelSetIndex::Ids a({ 1, 2, 3 });
+        const CAircraftModelSetIndex::Ids b({ 3, 4 });
+        QCOMPARE(CAircraftModelSetIndex::appendMissing(a, b), CAircraftModelSetIndex::Ids({ 1, 2, 3, 4 }));
+        QCOMPARE(CAircraftModelSetIndex::replaceOrAdd(a, b), CAircraftModelSetIndex::Ids({ 1, 2, 3, 4 }));
+        QCOMPARE(CAircraftModelSetIndex::replaceOrAdd(b, a), CAircraftModelSetIndex::Ids({ 4, 1, 2, 3 }));
+
+        QCOMPARE(index.toIds(models.findByManufacturer("AIRBUS")), CAircraftModelSetIndex::Ids({ 0, 1, 2 }));
+        QVERIFY(index.toModels({}).isEmpty());
+        QVERIFY(CAircraftModelSetIndex().isEmpty());
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestAircraftModelSetIndex);
+
+#include "testaircraftmodelsetindex.moc"
+
+//! \endcond
@@ -0,0 +1,154 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/filemanifest.h"
+#include "test.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! Entry of the test manifest
+    struct CTestEntry
+    {
+        qint64 size = -1; //!< file size
+        QString title;    //!< parsed value
+    };
+
+    //! Stream operators
+    //! @{
+    QDataStream &operator <<(QDataStream &stream, const CTestEntry &entry) { return stream << entry.size << entry.title; }
+    QDataStream &operator >>(QDataStream &stream, CTestEntry &entry) { return stream >> entry.size >> entry.title; }
+    //! @}
+
+    //! Manifest with the test entries
+    class CTestManifest : public CFileManifest<CTestEntry>
+    {
+    public:
+        //! Ctor
+        CTestManifest(quint32 version = 1) : CFileManifest(0x53575453, version) {} // "SWTS"
+    };
+
+    //! Manifest shared by the model loaders
+    class CTestFileManifest : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Native separators and case do not matter
+        void keys();
+
+        //! Entries of the scanned directories are removed
+        void removeInDirectories();
+
+        //! Written and read back, invalid or missing files
+        void saveAndLoad();
+
+    private:
+        //! Entry
+        static CTestEntry entry(const QString &title);
+    };
+
+    void CTestFileManifest::keys()
+    {
+        CTestManifest manifest;
+        manifest.insert("C:/FSX/SimObjects/Airplanes/B738/aircraft.cfg", entry("B738"));
+        QVERIFY(manifest.find("c:/fsx/simobjects/airplanes/b738/AIRCRAFT.CFG"));
+        QVERIFY(manifest.find(QDir::toNativeSeparators("C:/FSX/SimObjects/Airplanes/B738/aircraft.cfg")));
+        QVERIFY(!manifest.find("C:/FSX/SimObjects/Airplanes/A320/aircraft.cfg"));
+
+        // replaced, not added
+        manifest.insert("c:/fsx/simobjects/airplanes/b738/aircraft.cfg", entry("B738 new"));
+        QCOMPARE(manifest.size(), 1);
+        QCOMPARE(manifest.find("C:/FSX/SimObjects/Airplanes/B738/aircraft.cfg")->title, QString("B738 new"));
+    }
+
+    void CTestFileManifest::removeInDirectories()
+    {
+        CTestManifest manifest;
+        const QString scanned1("C:/FSX/SimObjects/Airplanes/B738/aircraft.cfg");
+        const QString scanned2("C:/FSX/SimObjects/Airplanes/A320/aircraft.cfg");
+        const QString other("D:/Addons/Airplanes/B744/aircraft.cfg");
+        const QString similarPrefix("C:/FSX/SimObjects/AirplanesOld/B737/aircraft.cfg");
+        manifest.insert(scanned1, entry("B738"));
+        manifest.insert(scanned2, entry("A320"));
+        manifest.insert(other, entry("B744"));
+        manifest.insert(similarPrefix, entry("B737"));
+
+        // a scan of the directory re-inserts the files still existing, A320 has been deleted
+        manifest.removeInDirectories({ "c:/fsx/simobjects/airplanes/", "" });
+        manifest.insert(scanned1, entry("B738"));
+
+        QCOMPARE(manifest.size(), 3);
+        QVERIFY(manifest.find(scanned1));
+        QVERIFY(!manifest.find(scanned2));
+        QVERIFY2(manifest.find(other), "Not scanned, kept");
+        QVERIFY2(manifest.find(similarPrefix), "Only files inside the directory are removed");
+    }
+
+    void CTestFileManifest::saveAndLoad()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString manifestFile = dir.filePath("sub/test.manifest");
+
+        CTestManifest manifest;
+        const QString file("C:/FSX/SimObjects/Airplanes/B738/Aircraft.cfg");
+        manifest.insert(file, entry("B738"));
+        QVERIFY(manifest.save(manifestFile).isSuccess());
+
+        CTestManifest loaded;
+        QVERIFY(loaded.load(manifestFile));
+        QCOMPARE(loaded.size(), 1);
+        const CTestEntry *found = loaded.find(file);
+        QVERIFY(found);
+        QCOMPARE(found->size, qint64(10));
+        QCOMPARE(found->title, QString("B738"));
+
+        // other version
+        CTestManifest otherVersion(2);
+        QVERIFY(!otherVersion.load(manifestFile));
+        QVERIFY(otherVersion.isEmpty());
+
+        // invalid or missing files result in an empty manifest
+        QFile invalid(dir.filePath("invalid.manifest"));
+        QVERIFY(invalid.open(QFile::WriteOnly));
+        invalid.write("no manifest");
+        invalid.close();
+        QVERIFY(!loaded.load(invalid.fileName()));
+        QVERIFY(loaded.isEmpty());
+        QVERIFY(loaded.load(manifestFile));
+        QVERIFY(!loaded.load(dir.filePath("missing.manifest")));
+        QVERIFY(loaded.isEmpty());
+    }
+
+    CTestEntry CTestFileManifest::entry(const QString &title)
+    {
+        CTestEntry entry;
+        entry.size = 10;
+        entry.title = title;
+        return entry;
+    }
+} // namespace
+
+//! main
+BLACKTEST_APPLESS_MAIN(BlackMiscTest::CTestFileManifest);
+
+#include "testfilemanifest.moc"
+
+//! \endcond
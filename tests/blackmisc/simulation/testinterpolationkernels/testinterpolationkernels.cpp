@@ -0,0 +1,393 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/interpolationkernels.h"
+#include "blackmisc/simulation/interpolationlogger.h"
+#include "blackmisc/simulation/interpolatorlinear.h"
+#include "blackmisc/simulation/interpolatorspline.h"
+#include "blackmisc/simulation/remoteaircraftproviderdummy.h"
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/altitude.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/heading.h"
+#include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/pq/angle.h"
+#include "blackmisc/pq/speed.h"
+#include "blackmisc/pq/units.h"
+#include "test.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QSharedPointer>
+#include <QTest>
+#include <QVector>
+#include <QtMath>
+#include <array>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Geo;
+using namespace BlackMisc::PhysicalQuantities;
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! Interpolation kernels compared with the interpolators
+    class CTestInterpolationKernels : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Reset to detected instruction set
+        void cleanup();
+
+        //! All instruction sets yield the same values as the scalar kernels
+        void instructionSets();
+
+        //! Spline kernels compared with CInterpolatorSpline
+        void splineKernels();
+
+        //! Linear kernel compared with CInterpolatorLinear
+        void linearKernel();
+
+        //! Lanes of many aircraft yield the same situations as the scalar interpolants
+        void interpolationLanes();
+
+        //! Pseudo performance test, scalar vs. SIMD
+        void kernelPerformance();
+
+    private:
+        static constexpr int NumberOfAircraft = 11; //!< not a multiple of the register sizes, so the tails are tested
+        static constexpr double Tolerance = 1e-9;   //!< absolute tolerance for normal vectors and altitudes in ft
+
+        //! Supported instruction sets
+        static QVector<CInterpolationKernels::InstructionSet> supportedInstructionSets();
+
+        //! Insert situations for aircraft
+        static QVector<CCallsign> insertSituations(CRemoteAircraftProviderDummy &provider, qint64 ts, qint64 deltaT, qint64 offset);
+
+        //! Values equal within tolerance
+        static bool isClose(double v1, double v2) { return qAbs(v1 - v2) <= Tolerance * qMax(1.0, qAbs(v1)); }
+    };
+
+    void CTestInterpolationKernels::cleanup()
+    {
+        CInterpolationKernels::setInstructionSet(CInterpolationKernels::detectedInstructionSet());
+    }
+
+    void CTestInterpolationKernels::instructionSets()
+    {
+        QVERIFY(CInterpolationKernels::isSupported(CInterpolationKernels::Scalar));
+        qDebug() << "Detected" << CInterpolationKernels::instructionSetToString(CInterpolationKernels::detectedInstructionSet());
+
+        constexpr int n = 37;
+        std::array<double, n> t0, t1, t2, y0, y1, y2, x, f;
+        for (int i = 0; i < n; i++)
+        {
+            t0[i] = 1425000000000.0 + i * 7;
+            t1[i] = t0[i] + 5000 + i;
+            t2[i] = t1[i] + 4000 - i;
+            y0[i] = qSin(i * 0.3);
+            y1[i] = qCos(i * 0.7);
+            y2[i] = qSin(i * 1.1) * 2.0;
+            x[i]  = t1[i] + (t2[i] - t1[i]) * (i % 10) / 10.0;
+            f[i]  = (i % 11) / 10.0;
+        }
+
+        std::array<double, n> k0Ref, k1Ref, k2Ref, hermiteRef, linearRef;
+        QVERIFY(CInterpolationKernels::setInstructionSet(CInterpolationKernels::Scalar));
+        CInterpolationKernels::splineDerivatives3(t0.data(), t1.data(), t2.data(), y0.data(), y1.data(), y2.data(), k0Ref.data(), k1Ref.data(), k2Ref.data(), n);
+        CInterpolationKernels::hermite(x.data(), t1.data(), t2.data(), y1.data(), y2.data(), k1Ref.data(), k2Ref.data(), hermiteRef.data(), n);
+        CInterpolationKernels::linear(y0.data(), y1.data(), f.data(), linearRef.data(), n);
+
+        for (CInterpolationKernels::InstructionSet set : supportedInstructionSets())
+        {
+            QVERIFY(CInterpolationKernels::setInstructionSet(set));
+            QCOMPARE(CInterpolationKernels::instructionSet(), set);
+            std::array<double, n> k0, k1, k2, hermite, linear;
+            CInterpolationKernels::splineDerivatives3(t0.data(), t1.data(), t2.data(), y0.data(), y1.data(), y2.data(), k0.data(), k1.data(), k2.data(), n);
+            CInterpolationKernels::hermite(x.data(), t1.data(), t2.data(), y1.data(), y2.data(), k1.data(), k2.data(), hermite.data(), n);
+            CInterpolationKernels::linear(y0.data(), y1.data(), f.data(), linear.data(), n);
+            for (int i = 0; i < n; i++)
+            {
+                QVERIFY2(isClose(k0[i], k0Ref[i]) && isClose(k1[i], k1Ref[i]) && isClose(k2[i], k2Ref[i]), qPrintable("Derivatives " + CInterpolationKernels::instructionSetToString(set)));
+                QVERIFY2(isClose(hermite[i], hermiteRef[i]), qPrintable("Hermite " + CInterpolationKernels::instructionSetToString(set)));
+                QVERIFY2(isClose(linear[i], linearRef[i]), qPrintable("Linear " + CInterpolationKernels::instructionSetToString(set)));
+            }
+        }
+    }
+
+    void CTestInterpolationKernels::splineKernels()
+    {
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 5000;
+        const qint64 offset = 5000;
+        CRemoteAircraftProviderDummy provider;
+        const QVector<CCallsign> callsigns = insertSituations(provider, ts, deltaT, offset);
+
+        const CInterpolationAndRenderingSetupPerCallsign setup;
+        const CLengthUnit altUnit = CAltitude::defaultUnit();
+        for (CInterpolationKernels::InstructionSet set : supportedInstructionSets())
+        {
+            QVERIFY(CInterpolationKernels::setInstructionSet(set));
+
+            // new interpolators for each run, the spline interpolant depends on the previous steps
+            QVector<QSharedPointer<CInterpolatorSpline>> interpolators;
+            for (const CCallsign &cs : callsigns)
+            {
+                interpolators.push_back(QSharedPointer<CInterpolatorSpline>::create(cs, nullptr, nullptr, &provider));
+                interpolators.last()->markAsUnitTest();
+            }
+
+            for (qint64 currentTime = ts - 2 * deltaT + offset; currentTime < ts; currentTime += deltaT / 20)
+            {
+                // structure of arrays filled from the interpolants
+                constexpr int Channels = 4; // x, y, z, altitude
+                const int n = NumberOfAircraft * Channels;
+                QVector<double> x(n, static_cast<double>(currentTime)), t0(n), t1(n), t2(n), y0(n), y1(n), y2(n), k0(n), k1(n), k2(n), out(n);
+                QVector<double> expectedK(n * 3), expected(n);
+                bool allValid = true;
+                for (int a = 0; a < NumberOfAircraft; a++)
+                {
+                    CInterpolatorSpline &interpolator = *interpolators[a];
+                    interpolator.getInterpolation(currentTime, setup);
+                    SituationLog log;
+                    const CInterpolatorSpline::CInterpolant interpolant = interpolator.getInterpolant(log);
+                    if (!interpolant.isValid() || interpolator.getLastInterpolatedSituation().isNull()) { allValid = false; break; }
+                    const CAircraftSituation situation = interpolant.interpolatePositionAndAltitude(interpolator.getLastInterpolatedSituation(), false);
+                    if (situation.isNull()) { allValid = false; break; }
+
+                    const CInterpolatorSpline::PosArray &pa = interpolant.getPa();
+                    const std::array<const std::array<double, 3> *, Channels> values {{ &pa.x, &pa.y, &pa.z, &pa.a }};
+                    const std::array<const std::array<double, 3> *, Channels> derivatives {{ &pa.dx, &pa.dy, &pa.dz, &pa.da }};
+                    const std::array<double, 3> normal = situation.getPosition().normalVectorDouble();
+                    const std::array<double, Channels> interpolated {{ normal[0], normal[1], normal[2], situation.getAltitude().value(altUnit) }};
+                    for (int c = 0; c < Channels; c++)
+                    {
+                        const int i = a * Channels + c;
+                        t0[i] = pa.t[0]; t1[i] = pa.t[1]; t2[i] = pa.t[2];
+                        y0[i] = (*values[c])[0]; y1[i] = (*values[c])[1]; y2[i] = (*values[c])[2];
+                        expectedK[i * 3]     = (*derivatives[c])[0];
+                        expectedK[i * 3 + 1] = (*derivatives[c])[1];
+                        expectedK[i * 3 + 2] = (*derivatives[c])[2];
+                        expected[i] = interpolated[c];
+                    }
+                }
+                QVERIFY2(allValid, "Expect valid interpolants");
+
+                CInterpolationKernels::splineDerivatives3(t0.constData(), t1.constData(), t2.constData(), y0.constData(), y1.constData(), y2.constData(), k0.data(), k1.data(), k2.data(), n);
+                CInterpolationKernels::hermite(x.constData(), t1.constData(), t2.constData(), y1.constData(), y2.constData(), k1.constData(), k2.constData(), out.data(), n);
+                for (int i = 0; i < n; i++)
+                {
+                    QVERIFY2(isClose(k0[i], expectedK[i * 3]) && isClose(k1[i], expectedK[i * 3 + 1]) && isClose(k2[i], expectedK[i * 3 + 2]), "Derivatives differ from spline interpolator");
+                    QVERIFY2(isClose(out[i], expected[i]), "Value differs from spline interpolator");
+                }
+            }
+        }
+    }
+
+    void CTestInterpolationKernels::linearKernel()
+    {
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 5000;
+        const qint64 offset = 5000;
+        CRemoteAircraftProviderDummy provider;
+        const QVector<CCallsign> callsigns = insertSituations(provider, ts, deltaT, offset);
+
+        const CInterpolationAndRenderingSetupPerCallsign setup;
+        for (CInterpolationKernels::InstructionSet set : supportedInstructionSets())
+        {
+            QVERIFY(CInterpolationKernels::setInstructionSet(set));
+            QVector<QSharedPointer<CInterpolatorLinear>> interpolators;
+            for (const CCallsign &cs : callsigns)
+            {
+                interpolators.push_back(QSharedPointer<CInterpolatorLinear>::create(cs, nullptr, nullptr, &provider));
+                interpolators.last()->markAsUnitTest();
+            }
+
+            for (qint64 currentTime = ts - 2 * deltaT + offset; currentTime < ts; currentTime += deltaT / 20)
+            {
+                constexpr int Channels = 3; // x, y, z
+                const int n = NumberOfAircraft * Channels;
+                QVector<double> y0(n), y1(n), fraction(n), out(n), expected(n);
+                for (int a = 0; a < NumberOfAircraft; a++)
+                {
+                    CInterpolatorLinear &interpolator = *interpolators[a];
+                    const CInterpolationResult result = interpolator.getInterpolation(currentTime, setup);
+                    QVERIFY2(result.getInterpolationStatus().isInterpolated(), "Not interpolated");
+                    SituationLog log;
+                    const CInterpolatorLinear::CInterpolant interpolant = interpolator.getInterpolant(log);
+
+                    // same fraction as CInterpolatorLinear::getInterpolant
+                    const CAircraftSituation &oldSituation = interpolant.getOldSituation();
+                    const CAircraftSituation &newSituation = interpolant.getNewSituation();
+                    const double sampleDeltaTimeMs = newSituation.getAdjustedMSecsSinceEpoch() - oldSituation.getAdjustedMSecsSinceEpoch();
+                    const double distanceToSplitTimeMs = newSituation.getAdjustedMSecsSinceEpoch() - currentTime;
+                    const double tf = qMin(qMax(1.0 - (distanceToSplitTimeMs / sampleDeltaTimeMs), 0.0), 1.0);
+
+                    const std::array<double, 3> oldVec = oldSituation.getPosition().normalVectorDouble();
+                    const std::array<double, 3> newVec = newSituation.getPosition().normalVectorDouble();
+                    const std::array<double, 3> interpolated = CAircraftSituation(result).getPosition().normalVectorDouble();
+                    for (int c = 0; c < Channels; c++)
+                    {
+                        const int i = a * Channels + c;
+                        y0[i] = oldVec[c];
+                        y1[i] = newVec[c];
+                        fraction[i] = tf;
+                        expected[i] = interpolated[c];
+                    }
+                }
+
+                CInterpolationKernels::linear(y0.constData(), y1.constData(), fraction.constData(), out.data(), n);
+                for (int i = 0; i < n; i++)
+                {
+                    QVERIFY2(isClose(out[i], expected[i]), "Value differs from linear interpolator");
+                }
+            }
+        }
+    }
+
+    void CTestInterpolationKernels::interpolationLanes()
+    {
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 5000;
+        const qint64 offset = 5000;
+        CRemoteAircraftProviderDummy provider;
+        const QVector<CCallsign> callsigns = insertSituations(provider, ts, deltaT, offset);
+
+        const CInterpolationAndRenderingSetupPerCallsign setup;
+        for (CInterpolationKernels::InstructionSet set : supportedInstructionSets())
+        {
+            QVERIFY(CInterpolationKernels::setInstructionSet(set));
+            QVector<QSharedPointer<CInterpolatorLinear>> linearInterpolators;
+            QVector<QSharedPointer<CInterpolatorSpline>> splineInterpolators;
+            for (const CCallsign &cs : callsigns)
+            {
+                linearInterpolators.push_back(QSharedPointer<CInterpolatorLinear>::create(cs, nullptr, nullptr, &provider));
+                splineInterpolators.push_back(QSharedPointer<CInterpolatorSpline>::create(cs, nullptr, nullptr, &provider));
+                linearInterpolators.last()->markAsUnitTest();
+                splineInterpolators.last()->markAsUnitTest();
+            }
+
+            CInterpolationLanes lanes;
+            for (qint64 currentTime = ts - 2 * deltaT + offset; currentTime < ts; currentTime += deltaT / 20)
+            {
+                QVector<CInterpolatorLinear::CInterpolant> linearInterpolants;
+                QVector<CInterpolatorSpline::CInterpolant> splineInterpolants;
+                QVector<int> linearIndexes;
+                QVector<int> splineIndexes;
+                lanes.clear();
+                for (int a = 0; a < NumberOfAircraft; a++)
+                {
+                    SituationLog log;
+                    linearInterpolators[a]->getInterpolation(currentTime, setup);
+                    linearInterpolants.push_back(linearInterpolators[a]->getInterpolant(log));
+                    linearIndexes.push_back(linearInterpolants.last().addLanes(lanes));
+                    splineInterpolators[a]->getInterpolation(currentTime, setup);
+                    splineInterpolants.push_back(splineInterpolators[a]->getInterpolant(log));
+                    splineIndexes.push_back(splineInterpolants.last().addLanes(lanes));
+                }
+                lanes.evaluate();
+
+                for (int a = 0; a < NumberOfAircraft; a++)
+                {
+                    const CAircraftSituation &linearSituation = linearInterpolators[a]->getLastInterpolatedSituation();
+                    const CAircraftSituation linearExpected = linearInterpolants[a].interpolatePositionAndAltitude(linearSituation, false);
+                    const CAircraftSituation linearLanes = linearInterpolants[a].interpolatePositionAndAltitude(linearSituation, false, lanes, linearIndexes[a]);
+                    QVERIFY2(isClose(linearLanes.latitude().value(CAngleUnit::deg()), linearExpected.latitude().value(CAngleUnit::deg())), "Linear lanes latitude");
+                    QVERIFY2(isClose(linearLanes.longitude().value(CAngleUnit::deg()), linearExpected.longitude().value(CAngleUnit::deg())), "Linear lanes longitude");
+                    QVERIFY2(isClose(linearLanes.getAltitude().value(CLengthUnit::ft()), linearExpected.getAltitude().value(CLengthUnit::ft())), "Linear lanes altitude");
+
+                    const CAircraftSituation &splineSituation = splineInterpolators[a]->getLastInterpolatedSituation();
+                    const CAircraftSituation splineExpected = splineInterpolants[a].interpolatePositionAndAltitude(splineSituation, false);
+                    const CAircraftSituation splineLanes = splineInterpolants[a].interpolatePositionAndAltitude(splineSituation, false, lanes, splineIndexes[a]);
+                    QCOMPARE(splineLanes.isNull(), splineExpected.isNull());
+                    if (splineExpected.isNull()) { continue; }
+                    QVERIFY2(isClose(splineLanes.latitude().value(CAngleUnit::deg()), splineExpected.latitude().value(CAngleUnit::deg())), "Spline lanes latitude");
+                    QVERIFY2(isClose(splineLanes.longitude().value(CAngleUnit::deg()), splineExpected.longitude().value(CAngleUnit::deg())), "Spline lanes longitude");
+                    QVERIFY2(isClose(splineLanes.getAltitude().value(CLengthUnit::ft()), splineExpected.getAltitude().value(CLengthUnit::ft())), "Spline lanes altitude");
+                }
+            }
+        }
+    }
+
+    void CTestInterpolationKernels::kernelPerformance()
+    {
+        // 512 aircraft, x/y/z/altitude
+        constexpr int n = 512 * 4;
+        constexpr int Loops = 2000;
+        QVector<double> t0(n), t1(n), t2(n), y0(n), y1(n), y2(n), x(n), k0(n), k1(n), k2(n), out(n);
+        for (int i = 0; i < n; i++)
+        {
+            t0[i] = 1425000000000.0 + i;
+            t1[i] = t0[i] + 5000;
+            t2[i] = t1[i] + 5000;
+            y0[i] = qSin(i * 0.01);
+            y1[i] = qSin(i * 0.01 + 0.001);
+            y2[i] = qSin(i * 0.01 + 0.002);
+            x[i]  = t1[i] + 2500;
+        }
+
+        for (CInterpolationKernels::InstructionSet set : supportedInstructionSets())
+        {
+            QVERIFY(CInterpolationKernels::setInstructionSet(set));
+            double sum = 0.0;
+            QElapsedTimer timer;
+            timer.start();
+            for (int l = 0; l < Loops; l++)
+            {
+                CInterpolationKernels::splineDerivatives3(t0.constData(), t1.constData(), t2.constData(), y0.constData(), y1.constData(), y2.constData(), k0.data(), k1.data(), k2.data(), n);
+                CInterpolationKernels::hermite(x.constData(), t1.constData(), t2.constData(), y1.constData(), y2.constData(), k1.constData(), k2.constData(), out.data(), n);
+                sum += out[l % n];
+            }
+            const qint64 ns = timer.nsecsElapsed();
+            qDebug() << CInterpolationKernels::instructionSetToString(set) << (ns / Loops / 1000.0) << "us for" << (n / 4) << "aircraft, check" << sum;
+        }
+    }
+
+    QVector<CInterpolationKernels::InstructionSet> CTestInterpolationKernels::supportedInstructionSets()
+    {
+        QVector<CInterpolationKernels::InstructionSet> sets;
+        for (CInterpolationKernels::InstructionSet set : { CInterpolationKernels::Scalar, CInterpolationKernels::SSE2, CInterpolationKernels::AVX2 })
+        {
+            if (CInterpolationKernels::isSupported(set)) { sets.push_back(set); }
+        }
+        return sets;
+    }
+
+    QVector<CCallsign> CTestInterpolationKernels::insertSituations(CRemoteAircraftProviderDummy &provider, qint64 ts, qint64 deltaT, qint64 offset)
+    {
+        QVector<CCallsign> callsigns;
+        for (int a = 0; a < NumberOfAircraft; a++)
+        {
+            const CCallsign cs("SWIFT" + QString::number(a));
+            callsigns.push_back(cs);
+            for (int i = IRemoteAircraftProvider::MaxSituationsPerCallsign - 1; i >= 0; i--)
+            {
+                // curved path, so the spline differs from the linear interpolation
+                const CCoordinateGeodetic position(48.0 + a * 0.1 + i * 0.01, 11.0 + a * 0.1 + i * i * 0.002, 5000.0 + a * 100.0 + i * 50.0);
+                CAircraftSituation s(cs, position, CHeading(90.0 + i, CHeading::True, CAngleUnit::deg()),
+                                     CAngle(1.0, CAngleUnit::deg()), CAngle(i, CAngleUnit::deg()), CSpeed(250.0, CSpeedUnit::kts()));
+                s.setMSecsSinceEpoch(ts - deltaT * i); // values in past
+                s.setTimeOffsetMs(offset);
+                provider.insertNewSituation(s);
+            }
+        }
+        return callsigns;
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestInterpolationKernels);
+
+#include "testinterpolationkernels.moc"
+
+//! \endcond
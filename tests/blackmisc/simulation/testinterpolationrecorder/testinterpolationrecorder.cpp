@@ -0,0 +1,255 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/interpolationrecorder.h"
+#include "blackmisc/simulation/interpolationlogger.h"
+#include "blackmisc/simulation/interpolatorlinear.h"
+#include "blackmisc/simulation/remoteaircraftproviderdummy.h"
+#include "blackmisc/aviation/aircraftparts.h"
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/altitude.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/heading.h"
+#include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/pq/angle.h"
+#include "blackmisc/pq/speed.h"
+#include "blackmisc/pq/units.h"
+#include "test.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+#include <thread>
+#include <vector>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Geo;
+using namespace BlackMisc::PhysicalQuantities;
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! Interpolation recorder (ring buffers and binary dump)
+    class CTestInterpolationRecorder : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Ring keeps the latest records
+        void ringWrapAround();
+
+        //! Concurrent writers wrapping around the ring
+        void ringConcurrentWriters();
+
+        //! Anomalies trigger a dump, but only once per cool down
+        void anomalyDump();
+
+        //! Dump written and read back
+        void dumpRoundTrip();
+
+        //! Sampled recording by the interpolator
+        void interpolatorRecording();
+    };
+
+    void CTestInterpolationRecorder::ringWrapAround()
+    {
+        CInterpolationRecordRing ring(5);
+        QCOMPARE(ring.capacity(), 8);
+        QVERIFY(ring.records().isEmpty());
+
+        for (int i = 0; i < 20; i++)
+        {
+            CInterpolationRecord record;
+            record.tsCurrent = i;
+            ring.append(record);
+        }
+
+        const QVector<CInterpolationRecord> records = ring.records();
+        QCOMPARE(ring.written(), static_cast<qint64>(20));
+        QCOMPARE(records.size(), 8);
+        QCOMPARE(records.front().tsCurrent, static_cast<qint64>(12));
+        QCOMPARE(records.back().tsCurrent, static_cast<qint64>(19));
+
+        ring.clear();
+        QVERIFY(ring.records().isEmpty());
+    }
+
+    void CTestInterpolationRecorder::ringConcurrentWriters()
+    {
+        // small ring, so writers many laps apart hit the same slots
+        CInterpolationRecordRing ring(4);
+        constexpr int Writers = 4;
+        constexpr int PerWriter = 20000;
+
+        std::vector<std::thread> writers;
+        for (int w = 0; w < Writers; w++)
+        {
+            writers.emplace_back([&ring, w]
+            {
+                CInterpolationRecord record;
+                record.callsignId = w;
+                for (int i = 0; i < PerWriter; i++)
+                {
+                    // all values of a record match, a torn record would mix two writes
+                    record.tsCurrent = i;
+                    record.tsInterpolated = i;
+                    record.noNetworkData = i;
+                    ring.append(record);
+                }
+            });
+        }
+        for (std::thread &writer : writers) { writer.join(); }
+
+        QCOMPARE(ring.written(), static_cast<qint64>(Writers * PerWriter));
+        const QVector<CInterpolationRecord> records = ring.records();
+        QVERIFY(records.size() <= ring.capacity());
+        for (const CInterpolationRecord &record : records)
+        {
+            QVERIFY(record.callsignId >= 0 && record.callsignId < Writers);
+            QCOMPARE(record.tsInterpolated, record.tsCurrent);
+            QCOMPARE(static_cast<qint64>(record.noNetworkData), record.tsCurrent);
+        }
+    }
+
+    void CTestInterpolationRecorder::anomalyDump()
+    {
+        CInterpolationRecorder recorder(16, 4);
+        recorder.setAnomalyDumpCooldownMs(1000);
+        const CCallsign cs("DAMBZ");
+        const auto ring = recorder.callsignRing(cs);
+        QCOMPARE(recorder.callsignId(cs), 0);
+        QCOMPARE(recorder.callsign(0), cs);
+
+        CInterpolationRecord record;
+        record.callsignId = 0;
+        record.tsCurrent = 10000;
+        QVERIFY(!recorder.record(ring.get(), record));
+
+        record.setFlag(CInterpolationRecord::JumpDetected, true);
+        QVERIFY(record.isAnomaly());
+        QVERIFY(recorder.record(ring.get(), record));
+
+        record.tsCurrent = 10500;
+        QVERIFY2(!recorder.record(ring.get(), record), "Within cool down");
+
+        record.tsCurrent = 11500;
+        QVERIFY(recorder.record(ring.get(), record));
+
+        QCOMPARE(recorder.records().size(), 4);
+        QCOMPARE(recorder.records(cs).size(), 4);
+        QVERIFY(recorder.records(CCallsign("DLH123")).isEmpty());
+    }
+
+    void CTestInterpolationRecorder::dumpRoundTrip()
+    {
+        CInterpolationRecorder recorder(16, 4);
+        const CCallsign cs("DAMBZ");
+        const CAircraftSituation situation(cs, CCoordinateGeodetic(48.3, 11.7, 1500.0));
+        CAircraftParts parts;
+        parts.setGearDown(true);
+        parts.setFlapsPercent(30);
+
+        CInterpolationRecord record;
+        record.callsignId = recorder.callsignId(cs);
+        record.tsCurrent = 1425000000000;
+        record.current.setSituation(situation);
+        record.setParts(parts);
+        record.setFlag(CInterpolationRecord::AltitudeCorrected, true);
+        recorder.record(recorder.callsignRing(cs).get(), record);
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString file = dir.filePath("test.swiftird");
+        QVERIFY(recorder.writeDump(file));
+
+        QVector<CInterpolationRecord> records;
+        QStringList callsigns;
+        QString error;
+        QVERIFY2(CInterpolationRecorder::readDump(file, records, callsigns, &error), qPrintable(error));
+        QCOMPARE(callsigns, QStringList({ cs.asString() }));
+        QCOMPARE(records.size(), 1);
+        QCOMPARE(records.front().tsCurrent, record.tsCurrent);
+        QVERIFY(records.front().testFlag(CInterpolationRecord::AltitudeCorrected));
+
+        const CAircraftSituation read = records.front().current.toSituation(cs);
+        QVERIFY(qAbs(read.latitude().value(CAngleUnit::deg()) - 48.3) < 1e-9);
+        QVERIFY(qAbs(read.longitude().value(CAngleUnit::deg()) - 11.7) < 1e-9);
+        QVERIFY(qAbs(read.getAltitude().value(CLengthUnit::ft()) - 1500.0) < 1e-6);
+
+        const CAircraftParts readParts = records.front().toParts();
+        QVERIFY(readParts.isFixedGearDown());
+        QCOMPARE(readParts.getFlapsPercent(), 30);
+
+        QVERIFY(!CInterpolationRecorder::readDump(dir.filePath("missing.swiftird"), records, callsigns));
+
+        // announced record not in the file
+        QFile truncated(file);
+        QVERIFY(truncated.resize(truncated.size() - 1));
+        QVERIFY(!CInterpolationRecorder::readDump(file, records, callsigns, &error));
+        QVERIFY(error.startsWith("Truncated"));
+    }
+
+    void CTestInterpolationRecorder::interpolatorRecording()
+    {
+        const CCallsign cs("SWIFT");
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 5000;
+        const qint64 offset = 5000;
+        CRemoteAircraftProviderDummy provider;
+        for (int i = IRemoteAircraftProvider::MaxSituationsPerCallsign - 1; i >= 0; i--)
+        {
+            const CCoordinateGeodetic position(48.0 + i * 0.01, 11.0 + i * 0.01, 5000.0 + i * 100.0);
+            CAircraftSituation s(cs, position, CHeading(90.0, CHeading::True, CAngleUnit::deg()), CAngle(), CAngle(), CSpeed(250.0, CSpeedUnit::kts()));
+            s.setGroundElevation(CAltitude(0, CAltitude::MeanSeaLevel, CLengthUnit::ft()), CAircraftSituation::Test);
+            s.setMSecsSinceEpoch(ts - deltaT * i); // values in past
+            s.setTimeOffsetMs(offset);
+            provider.insertNewSituation(s);
+        }
+
+        CInterpolationLogger logger;
+        logger.recorder().setEnabled(true);
+        logger.recorder().setSampleInterval(2);
+        logger.recorder().setJumpThresholdM(1.0e6); // no anomaly dumps in the test
+
+        CInterpolatorLinear interpolator(cs, nullptr, nullptr, &provider, &logger);
+        interpolator.markAsUnitTest();
+        const CInterpolationAndRenderingSetupPerCallsign setup;
+        int steps = 0;
+        for (qint64 currentTime = ts - 2 * deltaT + offset; currentTime < ts; currentTime += deltaT / 10)
+        {
+            interpolator.getInterpolation(currentTime, setup, 0);
+            steps++;
+        }
+
+        int situationRecords = 0;
+        const QVector<CInterpolationRecord> records = logger.recorder().records(cs);
+        for (const CInterpolationRecord &record : records)
+        {
+            if (record.recordType != CInterpolationRecord::SituationRecord) { continue; }
+            situationRecords++;
+            QCOMPARE(record.interpolator, 'l');
+            QVERIFY(record.current.isValid());
+            QVERIFY(record.oldest.isValid());
+            QVERIFY(record.newest.isValid());
+            QVERIFY(!record.isAnomaly());
+        }
+        QVERIFY(situationRecords > 0);
+        QVERIFY2(situationRecords <= (steps + 1) / 2, "Only every 2nd step recorded");
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestInterpolationRecorder);
+
+#include "testinterpolationrecorder.moc"
+
+//! \endcond
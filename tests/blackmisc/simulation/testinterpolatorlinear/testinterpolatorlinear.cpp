@@ -11,7 +11,9 @@
 //! \ingroup testblackmisc
 
 #include "blackmisc/simulation/interpolator.h"
+#include "blackmisc/simulation/interpolationbatch.h"
 #include "blackmisc/simulation/interpolatorlinear.h"
+#include "blackmisc/simulation/interpolatormulti.h"
 #include "blackmisc/simulation/remoteaircraftproviderdummy.h"
 #include "blackmisc/aviation/aircraftengine.h"
 #include "blackmisc/aviation/aircraftenginelist.h"
@@ -36,9 +38,11 @@
 #include <QDebug>
 #include <QEventLoop>
 #include <QScopedPointer>
+#include <QSharedPointer>
 #include <QTest>
 #include <QTime>
 #include <QtDebug>
+#include <QVector>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Aviation;
@@ -60,6 +64,15 @@ namespace BlackMiscTest
         //! Interpolator PBH
         void pbhInterpolatorTest();
 
+        //! One snapshot shared by several aircraft yields the same values as the per aircraft interpolation
+        void sharedSnapshotInterpolatorTest();
+
+        //! Compact result yields the same values as the full interpolation result
+        void compactInterpolatorTest();
+
+        //! Batch interpolation yields the same values as the per aircraft interpolation
+        void batchInterpolatorTest();
+
     private:
         //! Test situation for testing
         static BlackMisc::Aviation::CAircraftSituation getTestSituation(const BlackMisc::Aviation::CCallsign &callsign, int number, qint64 ts, qint64 deltaT, qint64 offset);
@@ -320,6 +333,164 @@ namespace BlackMiscTest
         }
     }
 
+    void CTestInterpolatorLinear::sharedSnapshotInterpolatorTest()
+    {
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 5000; // ms
+        const qint64 offset = 5000; // ms
+        const QVector<CCallsign> callsigns({ CCallsign("SWIFT1"), CCallsign("SWIFT2"), CCallsign("SWIFT3") });
+        CRemoteAircraftProviderDummy provider;
+        for (const CCallsign &cs : callsigns)
+        {
+            for (int i = IRemoteAircraftProvider::MaxSituationsPerCallsign - 1; i >= 0; i--)
+            {
+                provider.insertNewSituation(getTestSituation(cs, i, ts, deltaT, offset));
+            }
+        }
+
+        QVector<QSharedPointer<CInterpolatorMulti>> interpolators;
+        QVector<QSharedPointer<CInterpolatorMulti>> sharedInterpolators;
+        QVector<CInterpolationAndRenderingSetupPerCallsign> setups;
+        for (const CCallsign &cs : callsigns)
+        {
+            interpolators.push_back(QSharedPointer<CInterpolatorMulti>::create(cs, nullptr, nullptr, &provider));
+            sharedInterpolators.push_back(QSharedPointer<CInterpolatorMulti>::create(cs, nullptr, nullptr, &provider));
+            CInterpolationAndRenderingSetupPerCallsign setup(cs, CInterpolationAndRenderingSetupGlobal());
+            setup.setInterpolatorMode(CInterpolationAndRenderingSetupBase::Linear);
+            setups.push_back(setup);
+        }
+
+        for (qint64 currentTime = ts - 2 * deltaT + offset; currentTime < ts; currentTime += deltaT / 10)
+        {
+            // one snapshot per frame, as the simulator drivers do
+            const CRemoteAircraftSnapshotPtr snapshot = provider.getRemoteAircraftSnapshot();
+            QVERIFY(snapshot);
+            for (int a = 0; a < callsigns.size(); a++)
+            {
+                const CInterpolationResult result = interpolators[a]->getInterpolation(currentTime, setups[a], a);
+                const CCompactInterpolationResult compact = sharedInterpolators[a]->getInterpolationCompact(currentTime, setups[a], a, snapshot);
+                QVERIFY2(compact.hasValidSituation(), "Expect valid situation");
+                QCOMPARE(compact.hasValidSituation(), result.getInterpolationStatus().hasValidSituation());
+
+                const CAircraftSituation &situation = result.getInterpolatedSituation();
+                QVERIFY(qFuzzyCompare(compact.latitudeDeg, situation.latitude().value(CAngleUnit::deg())));
+                QVERIFY(qFuzzyCompare(compact.longitudeDeg, situation.longitude().value(CAngleUnit::deg())));
+                QVERIFY(qFuzzyCompare(compact.altitudeFt, situation.getAltitude().value(CLengthUnit::ft())));
+                QCOMPARE(compact.isOnGround(), situation.isOnGround());
+            }
+        }
+    }
+
+    void CTestInterpolatorLinear::compactInterpolatorTest()
+    {
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 5000; // ms
+        const qint64 offset = 5000; // ms
+        const CCallsign cs("SWIFT");
+        CRemoteAircraftProviderDummy provider;
+        for (int i = IRemoteAircraftProvider::MaxSituationsPerCallsign - 1; i >= 0; i--)
+        {
+            provider.insertNewSituation(getTestSituation(cs, i, ts, deltaT, offset));
+            provider.insertNewAircraftParts(cs, getTestParts(i, ts, deltaT), false);
+        }
+
+        CInterpolationAndRenderingSetupPerCallsign setup(cs, CInterpolationAndRenderingSetupGlobal());
+        setup.setInterpolatorMode(CInterpolationAndRenderingSetupBase::Linear);
+        setup.setEnabledAircraftParts(true);
+
+        CInterpolatorMulti interpolator(cs, nullptr, nullptr, &provider);
+        CInterpolatorMulti compactInterpolator(cs, nullptr, nullptr, &provider);
+        for (qint64 currentTime = ts - 2 * deltaT + offset; currentTime < ts; currentTime += deltaT / 10)
+        {
+            const CInterpolationResult result = interpolator.getInterpolation(currentTime, setup, 0);
+            const CCompactInterpolationResult compact = compactInterpolator.getInterpolationCompact(currentTime, setup, 0);
+            QCOMPARE(compact.hasValidSituation(), result.getInterpolationStatus().hasValidSituation());
+            QCOMPARE(compact.isSupportingParts(), result.getPartsStatus().isSupportingParts());
+            QVERIFY2(compact.hasValidSituation(), "Expect valid situation");
+
+            const CAircraftSituation &situation = result.getInterpolatedSituation();
+            QVERIFY(qFuzzyCompare(compact.latitudeDeg, situation.latitude().value(CAngleUnit::deg())));
+            QVERIFY(qFuzzyCompare(compact.longitudeDeg, situation.longitude().value(CAngleUnit::deg())));
+            QVERIFY(qFuzzyCompare(compact.altitudeFt, situation.getAltitude().value(CLengthUnit::ft())));
+            QVERIFY(qFuzzyCompare(1.0 + compact.headingDeg, 1.0 + situation.getHeading().value(CAngleUnit::deg())));
+            QCOMPARE(compact.isOnGround(), situation.isOnGround());
+            QVERIFY(compactInterpolator.getLastInterpolatedSituation(setup.getInterpolatorMode()) == situation);
+
+            const CAircraftParts &parts = result.getInterpolatedParts();
+            QVERIFY2(compact.hasValidParts(), "Expect valid parts");
+            QCOMPARE(compact.testParts(CCompactInterpolationResult::GearDown), parts.isFixedGearDown());
+            QCOMPARE(compact.testParts(CCompactInterpolationResult::SpoilersOut), parts.isSpoilersOut());
+            QCOMPARE(compact.testParts(CCompactInterpolationResult::LandingLights), parts.getLights().isLandingOn());
+            QCOMPARE(static_cast<int>(compact.flapsPercent), parts.getFlapsPercent());
+            QVERIFY(compactInterpolator.getLastInterpolatedParts(setup.getInterpolatorMode()).equalValues(parts));
+        }
+    }
+
+    void CTestInterpolatorLinear::batchInterpolatorTest()
+    {
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 5000; // ms
+        const qint64 offset = 5000; // ms
+        const QVector<CCallsign> callsigns({ CCallsign("SWIFT1"), CCallsign("SWIFT2"), CCallsign("SWIFT3") });
+        CRemoteAircraftProviderDummy provider;
+        for (const CCallsign &cs : callsigns)
+        {
+            for (int i = IRemoteAircraftProvider::MaxSituationsPerCallsign - 1; i >= 0; i--)
+            {
+                provider.insertNewSituation(getTestSituation(cs, i, ts, deltaT, offset));
+            }
+        }
+
+        QVector<QSharedPointer<CInterpolatorMulti>> interpolators;
+        QVector<QSharedPointer<CInterpolatorMulti>> batchInterpolators;
+        QVector<CInterpolationAndRenderingSetupPerCallsign> setups;
+        for (const CCallsign &cs : callsigns)
+        {
+            interpolators.push_back(QSharedPointer<CInterpolatorMulti>::create(cs, nullptr, nullptr, &provider));
+            batchInterpolators.push_back(QSharedPointer<CInterpolatorMulti>::create(cs, nullptr, nullptr, &provider));
+            // the last aircraft uses the spline lanes
+            CInterpolationAndRenderingSetupPerCallsign setup(cs, CInterpolationAndRenderingSetupGlobal());
+            setup.setInterpolatorMode(cs == callsigns.last() ? CInterpolationAndRenderingSetupBase::Spline : CInterpolationAndRenderingSetupBase::Linear);
+            setups.push_back(setup);
+        }
+
+        CInterpolationBatch batch;
+        QVector<CCompactInterpolationResult> results;
+        for (qint64 currentTime = ts - 2 * deltaT + offset; currentTime < ts; currentTime += deltaT / 10)
+        {
+            // aircraft added per frame, as the simulator drivers do
+            batch.clear();
+            for (int a = 0; a < callsigns.size(); a++) { QCOMPARE(batch.add(batchInterpolators[a].data(), setups[a]), a); }
+            QCOMPARE(batch.size(), callsigns.size());
+
+            const int valid = batch.interpolate(currentTime, provider.getRemoteAircraftSnapshot(), results);
+            QCOMPARE(results.size(), callsigns.size());
+            int expectedValid = 0;
+            for (int a = 0; a < callsigns.size(); a++)
+            {
+                const CInterpolationResult result = interpolators[a]->getInterpolation(currentTime, setups[a], a);
+                const CAircraftSituation &situation = result.getInterpolatedSituation();
+                const CCompactInterpolationResult &compact = results[a];
+                QCOMPARE(compact.hasValidSituation(), result.getInterpolationStatus().hasValidSituation());
+                if (!compact.hasValidSituation()) { continue; }
+                expectedValid++;
+                QVERIFY(qFuzzyCompare(compact.latitudeDeg, situation.latitude().value(CAngleUnit::deg())));
+                QVERIFY(qFuzzyCompare(compact.longitudeDeg, situation.longitude().value(CAngleUnit::deg())));
+                QVERIFY(qFuzzyCompare(compact.altitudeFt, situation.getAltitude().value(CLengthUnit::ft())));
+                QVERIFY(qFuzzyCompare(1.0 + compact.headingDeg, 1.0 + situation.getHeading().value(CAngleUnit::deg())));
+                QCOMPARE(compact.isOnGround(), situation.isOnGround());
+                QVERIFY(batch.interpolator(a)->getLastInterpolatedSituation(setups[a].getInterpolatorMode()) == situation);
+            }
+            QCOMPARE(valid, expectedValid);
+            QVERIFY2(valid >= callsigns.size() - 1, "Expect valid linear situations");
+        }
+
+        batch.clear();
+        QVERIFY(batch.isEmpty());
+        QCOMPARE(batch.interpolate(ts, provider.getRemoteAircraftSnapshot(), results), 0);
+        QVERIFY(results.isEmpty());
+    }
+
     CAircraftSituation CTestInterpolatorLinear::getTestSituation(const CCallsign &callsign, int number, qint64 ts, qint64 deltaT, qint64 offset)
     {
         const CAltitude alt(number, CAltitude::MeanSeaLevel, CLengthUnit::m());
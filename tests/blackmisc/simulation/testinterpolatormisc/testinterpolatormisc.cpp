@@ -12,11 +12,17 @@
 
 #include "blackmisc/aviation/aircraftsituation.h"
 #include "blackmisc/simulation/interpolationrenderingsetup.h"
+#include "blackmisc/simulation/interpolatorspline.h"
+#include "blackmisc/simulation/remoteaircraftproviderdummy.h"
+#include "blackmisc/aviation/heading.h"
+#include "blackmisc/geo/elevationplane.h"
+#include "blackmisc/pq/speed.h"
 #include "test.h"
 
 
 
 #include <QDebug>
+#include <QMap>
 #include <QTest>
 #include <QtDebug>
 
@@ -38,6 +44,9 @@ namespace BlackMiscTest
 
         //! Equal situations
         void equalSituationTests();
+
+        //! Spline coefficients re-used until new situations or elevations arrive
+        void splineInterpolantCache();
     };
 
     void CTestInterpolatorMisc::setupTests()
@@ -125,6 +134,81 @@ namespace BlackMiscTest
             QVERIFY2(!s1.equalPbhVectorAltitude(s2), "Heading test, expect same PHB/Vector/Altitude");
         }
     }
+
+    void CTestInterpolatorMisc::splineInterpolantCache()
+    {
+        const CCallsign cs("DAMBZ");
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 5000;
+        const qint64 offset = 5000;
+        CRemoteAircraftProviderDummy provider;
+        CSimulatedAircraft aircraft;
+        aircraft.setCallsign(cs);
+        provider.addNewAircraftInRange(aircraft);
+
+        // adjusted times: ts + offset, ts, ts - deltaT, ...
+        QMap<int, CAircraftSituation> situations;
+        for (int i = IRemoteAircraftProvider::MaxSituationsPerCallsign - 1; i >= 0; i--)
+        {
+            const CCoordinateGeodetic position(48.0 + i * 0.01, 11.0 + i * i * 0.002, 5000.0 + i * 50.0);
+            CAircraftSituation s(cs, position, CHeading(90.0, CHeading::True, CAngleUnit::deg()),
+                                 CAngle(1.0, CAngleUnit::deg()), CAngle(0.0, CAngleUnit::deg()), CSpeed(250.0, CSpeedUnit::kts()));
+            s.setMSecsSinceEpoch(ts - deltaT * i); // values in past
+            s.setTimeOffsetMs(offset);
+            provider.insertNewSituation(s);
+            situations.insert(i, s);
+        }
+
+        CInterpolatorSpline interpolator(cs, nullptr, nullptr, &provider);
+        interpolator.markAsUnitTest();
+        const CInterpolationAndRenderingSetupPerCallsign setup;
+
+        // ~60fps, new situations every 5secs
+        constexpr qint64 FrameMs = 16;
+        int frames = 0;
+        qint64 currentTime = ts - 2 * deltaT + offset;
+        CInterpolationStatus status;
+        for (; currentTime < ts; currentTime += FrameMs)
+        {
+            const CInterpolationResult result = interpolator.getInterpolation(currentTime, setup);
+            status = result.getInterpolationStatus();
+            QVERIFY2(status.isInterpolated(), "Expect interpolated situation");
+            frames++;
+        }
+        QCOMPARE(status.getInterpolantCacheHits() + status.getInterpolantCacheMisses(), static_cast<qint64>(frames));
+        QVERIFY2(status.getInterpolantCacheMisses() > 0, "Expect calculated interpolants");
+        QVERIFY2(status.getInterpolantCacheHitRate() > 0.9, "Expect coefficients mostly re-used");
+
+        // after the loop the spline uses the situations adjusted at ts - deltaT (oldest, index 2) and ts + offset (latest, index 0)
+        // modifications get strictly increasing timestamps from the provider, so the steps below need no wall clock delay
+        const auto updateElevation = [&](int index)
+        {
+            const CElevationPlane elevation(situations.value(index), 100.0, CLength(100, CLengthUnit::m()));
+            const int updated = provider.updateAircraftGroundElevation(cs, elevation, CAircraftSituation::FromProvider, nullptr);
+            provider.publishRemoteAircraftSnapshot();
+            return updated;
+        };
+        QCOMPARE(situations.value(2).getAdjustedMSecsSinceEpoch(), ts - 2 * deltaT + offset);
+
+        // sync the key with the current step, the last interpolant was calculated at the first step
+        QVERIFY2(updateElevation(4) > 0, "Expect updated elevation");
+        interpolator.getInterpolation(currentTime, setup);
+
+        // elevation of a situation not used by the spline, coefficients re-used
+        QVERIFY2(updateElevation(3) > 0, "Expect updated elevation");
+        CInterpolationResult result = interpolator.getInterpolation(currentTime, setup);
+        QVERIFY2(result.getInterpolationStatus().isInterpolantCacheHit(), "Expect re-used interpolant after elevation change of an unused situation");
+
+        // elevation of the oldest situation, which is not one of the 2 latest situations
+        QVERIFY2(updateElevation(2) > 0, "Expect updated elevation");
+        result = interpolator.getInterpolation(currentTime, setup);
+        QVERIFY2(!result.getInterpolationStatus().isInterpolantCacheHit(), "Expect recalculated interpolant after elevation change of the oldest situation");
+
+        // elevation of the latest situation
+        QVERIFY2(updateElevation(0) > 0, "Expect updated elevation");
+        result = interpolator.getInterpolation(currentTime, setup);
+        QVERIFY2(!result.getInterpolationStatus().isInterpolantCacheHit(), "Expect recalculated interpolant after elevation change of the latest situation");
+    }
 } // namespace
 
 //! main
@@ -0,0 +1,141 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/matchingresultcache.h"
+#include "blackmisc/simulation/matchingstatistics.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/airlineicaocode.h"
+#include "blackmisc/aviation/livery.h"
+#include "test.h"
+
+#include <QTest>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! Matching result cache
+    class CTestMatchingResultCache : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Normalized keys
+        void keys();
+
+        //! Hits only for same setup and model set revision
+        void findAndInvalidate();
+
+        //! Candidates and statistics
+        void candidatesAndStatistics();
+
+    private:
+        //! Create a model
+        static CAircraftModel model(const QString &modelString, const QString &designator, const QString &airline);
+    };
+
+    CAircraftModel CTestMatchingResultCache::model(const QString &modelString, const QString &designator, const QString &airline)
+    {
+        const CAircraftIcaoCode icao(designator, "L2J");
+        const CLivery livery(airline.isEmpty() ? QString() : airline + ".STD", CAirlineIcaoCode(airline), "");
+        return CAircraftModel(modelString, CAircraftModel::TypeOwnSimulatorModel, icao, livery);
+    }
+
+    void CTestMatchingResultCache::keys()
+    {
+        QCOMPARE(CMatchingResultCache::key(model("", "A320", "DLH")), CMatchingResultCache::key(model(" ", "a320", "dlh")));
+        QVERIFY(CMatchingResultCache::key(model("", "A320", "DLH")) != CMatchingResultCache::key(model("", "A320", "BAW")));
+        QVERIFY(CMatchingResultCache::key(model("", "A320", "DLH")) != CMatchingResultCache::key(model("", "A321", "DLH")));
+        QVERIFY(CMatchingResultCache::key(model("", "A320", "DLH")) != CMatchingResultCache::key(model("FOO", "A320", "DLH")));
+    }
+
+    void CTestMatchingResultCache::findAndInvalidate()
+    {
+        CMatchingResultCache cache;
+        const CAircraftModel remote = model("", "A320", "DLH");
+        const CAircraftModel matched = model("DLH A320 1", "A320", "DLH");
+        CMatchingResultCache::Entry entry;
+
+        QVERIFY(!cache.find(remote, 1, 1, entry));
+        cache.insert(remote, 1, 1, matched, CAircraftModelList({ matched }));
+        QCOMPARE(cache.size(), 1);
+
+        QVERIFY(cache.find(remote, 1, 1, entry));
+        QCOMPARE(entry.model.getModelString(), matched.getModelString());
+
+        // other setup or model set
+        QVERIFY(!cache.find(remote, 2, 1, entry));
+        QVERIFY(!cache.find(remote, 1, 2, entry));
+        QVERIFY(!cache.find(model("", "A320", "BAW"), 1, 1, entry));
+
+        QCOMPARE(cache.getHits(), 1);
+        QCOMPARE(cache.getMisses(), 4);
+
+        cache.clear();
+        QCOMPARE(cache.size(), 0);
+        QVERIFY(!cache.find(remote, 1, 1, entry));
+        QCOMPARE(cache.getMisses(), 5);
+    }
+
+    void CTestMatchingResultCache::candidatesAndStatistics()
+    {
+        CMatchingResultCache cache;
+        const CAircraftModel remote = model("", "B738", "BAW");
+        CAircraftModelList candidates;
+        for (int i = 0; i < 2 * CMatchingResultCache::MaxCandidates; i++)
+        {
+            candidates.push_back(model(QStringLiteral("BAW B738 %1").arg(i), "B738", "BAW"));
+        }
+        cache.insert(remote, 7, 3, candidates.front(), candidates);
+
+        CMatchingResultCache::Entry entry;
+        QVERIFY(cache.find(remote, 7, 3, entry));
+        QVERIFY(cache.find(remote, 7, 3, entry));
+        QVERIFY(!cache.find(model("", "A320", "DLH"), 7, 3, entry));
+        QCOMPARE(entry.candidates.size(), CMatchingResultCache::MaxCandidates);
+        QCOMPARE(entry.candidates.front().getModelString(), candidates.front().getModelString());
+
+        CMatchingStatistics statistics;
+        cache.addToStatistics(statistics, "session", "set");
+        QCOMPARE(statistics.size(), 2);
+        for (const CMatchingStatisticsEntry &e : statistics)
+        {
+            if (e.getEntryType() == CMatchingStatisticsEntry::CacheHit)
+            {
+                QCOMPARE(e.getAircraftDesignator(), QString("B738"));
+                QCOMPARE(e.getAirlineDesignator(), QString("BAW"));
+                QCOMPARE(e.getCount(), 2);
+            }
+            else
+            {
+                QCOMPARE(e.getEntryType(), CMatchingStatisticsEntry::CacheMiss);
+                QCOMPARE(e.getAircraftDesignator(), QString("A320"));
+                QCOMPARE(e.getCount(), 1);
+            }
+        }
+
+        cache.clearStatistics();
+        statistics.clear();
+        cache.addToStatistics(statistics, "session", "set");
+        QVERIFY(statistics.isEmpty());
+        QCOMPARE(cache.getHits(), 0);
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestMatchingResultCache);
+
+#include "testmatchingresultcache.moc"
+
+//! \endcond
@@ -0,0 +1,174 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/data/modelbinarycache.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/distributor.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/airlineicaocode.h"
+#include "blackmisc/aviation/livery.h"
+#include "blackmisc/fileutils.h"
+#include "test.h"
+
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation;
+using namespace BlackMisc::Simulation::Data;
+
+namespace BlackMiscTest
+{
+    //! Binary model cache
+    class CTestModelBinaryCache : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Written models are read back unchanged
+        void roundTrip();
+
+        //! Shared strings and objects are stored once
+        void deduplication();
+
+        //! Corrupt files, other versions
+        void invalidFiles();
+
+        //! File name next to the JSON file
+        void fileNames();
+
+    private:
+        //! Test models
+        static CAircraftModelList models(int count);
+    };
+
+    CAircraftModelList CTestModelBinaryCache::models(int count)
+    {
+        CAircraftModelList models;
+        for (int i = 0; i < count; i++)
+        {
+            const QString designator = (i % 2) ? "A320" : "B738";
+            const QString airline = (i % 3) ? "DLH" : "BAW";
+            const CAircraftIcaoCode icao(designator, "L2J");
+            const CLivery livery(airline + ".STD", CAirlineIcaoCode(airline), airline + " standard");
+            CAircraftModel model(QStringLiteral("%1 %2 %3").arg(airline, designator).arg(i), CAircraftModel::TypeOwnSimulatorModel, icao, livery);
+            model.setDistributor(CDistributor("FSX"));
+            model.setSimulator(CSimulatorInfo::P3D);
+            model.setDescription(QStringLiteral("%1 %2 ä").arg(airline, designator));
+            model.setFileName(QStringLiteral("C:/SimObjects/%1/aircraft.cfg").arg(i));
+            model.setFileTimestamp(1500000000000 + i);
+            models.push_back(model);
+        }
+        return models;
+    }
+
+    void CTestModelBinaryCache::roundTrip()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString file = dir.filePath("models.bin");
+        const CAircraftModelList original = models(25);
+        QVERIFY(!CModelBinaryCache::write(original, 12345, file).isFailure());
+
+        CModelBinaryCache cache;
+        QVERIFY(cache.open(file));
+        QCOMPARE(cache.size(), original.size());
+        QCOMPARE(cache.getCacheTimestamp(), qint64(12345));
+
+        for (int i = 0; i < original.size(); i++)
+        {
+            const CAircraftModel &model = original[i];
+            QCOMPARE(cache.getModelString(i), model.getModelString());
+            const CAircraftModel read = cache.at(i);
+            QVERIFY(read == model);
+            QCOMPARE(read.getDescription(), model.getDescription());
+            QCOMPARE(read.getFileName(), model.getFileName());
+            QCOMPARE(read.getFileTimestamp(), model.getFileTimestamp());
+            QCOMPARE(read.getLivery().getCombinedCode(), model.getLivery().getCombinedCode());
+            QCOMPARE(read.getAircraftIcaoCodeDesignator(), model.getAircraftIcaoCodeDesignator());
+            QCOMPARE(read.getDistributor().getDbKey(), model.getDistributor().getDbKey());
+        }
+
+        const CAircraftModelList list = cache.toList();
+        QCOMPARE(list.size(), original.size());
+        QVERIFY(list == original);
+
+        // empty set
+        QVERIFY(!CModelBinaryCache::write(CAircraftModelList(), 1, file).isFailure());
+        CModelBinaryCache empty;
+        QVERIFY(empty.open(file));
+        QCOMPARE(empty.size(), 0);
+        QVERIFY(empty.toList().isEmpty());
+    }
+
+    void CTestModelBinaryCache::deduplication()
+    {
+        const QByteArray one = CModelBinaryCache::toBinary(models(6), 1);
+        const QByteArray many = CModelBinaryCache::toBinary(models(600), 1);
+
+        // the model strings and file names differ, everything else is shared,
+        // a model costs its record and two short strings only
+        const int perModel = (many.size() - one.size()) / 594;
+        QVERIFY2(perModel < 200, qPrintable(QString::number(perModel)));
+    }
+
+    void CTestModelBinaryCache::invalidFiles()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString file = dir.filePath("models.bin");
+        const QByteArray data = CModelBinaryCache::toBinary(models(10), 1);
+
+        CModelBinaryCache missing;
+        QVERIFY(!missing.open(file));
+        QVERIFY(!missing.isOpen());
+
+        // truncated
+        QVERIFY(CFileUtils::writeByteArrayToFile(data.left(data.size() - 16), file));
+        CModelBinaryCache truncated;
+        QVERIFY(!truncated.open(file));
+
+        // wrong magic
+        QByteArray corrupt = data;
+        corrupt[0] = 'X';
+        QVERIFY(CFileUtils::writeByteArrayToFile(corrupt, file));
+        CModelBinaryCache wrongMagic;
+        QVERIFY(!wrongMagic.open(file));
+
+        // other version, directly after the magic
+        QByteArray otherVersion = data;
+        const quint32 version = CModelBinaryCache::Version + 1;
+        otherVersion.replace(4, sizeof(version), reinterpret_cast<const char *>(&version), sizeof(version));
+        QVERIFY(CFileUtils::writeByteArrayToFile(otherVersion, file));
+        CModelBinaryCache wrongVersion;
+        QVERIFY(!wrongVersion.open(file));
+
+        QVERIFY(CFileUtils::writeByteArrayToFile(data, file));
+        CModelBinaryCache valid;
+        QVERIFY(valid.open(file));
+        QCOMPARE(valid.size(), 10);
+    }
+
+    void CTestModelBinaryCache::fileNames()
+    {
+        QCOMPARE(CModelBinaryCache::binaryFileName("/cache/data/modelcachefsx.json"), QString("/cache/data/modelcachefsx.bin"));
+        QVERIFY(CModelBinaryCache::binaryFileName("").isEmpty());
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestModelBinaryCache);
+
+#include "testmodelbinarycache.moc"
+
+//! \endcond
@@ -0,0 +1,119 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/xplane/modelfingerprintcache.h"
+#include "blackmisc/simulation/aircraftmodel.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "test.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace BlackMisc::Simulation;
+using namespace BlackMisc::Simulation::XPlane;
+
+namespace BlackMiscTest
+{
+    //! Fingerprint cache of the X-Plane model loader
+    class CTestModelFingerprintCache : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Modification time, size and context
+        void fingerprint();
+
+        //! Entries written and read back, see CTestFileManifest for the file handling
+        void saveAndLoad();
+
+    private:
+        //! Write a file
+        static bool writeFile(const QString &fileName, const QByteArray &content);
+    };
+
+    void CTestModelFingerprintCache::fingerprint()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString fileName = dir.filePath("xsb_aircraft.txt");
+        QVERIFY(writeFile(fileName, "EXPORT_NAME Bluebell"));
+
+        CModelFingerprintCache::Entry entry;
+        QVERIFY(!entry.isFileUnchanged(QFileInfo(fileName)));
+        entry.setFingerprint(QFileInfo(fileName), "context");
+        QVERIFY(entry.isFileUnchanged(QFileInfo(fileName)));
+        QVERIFY(entry.isUnchanged(QFileInfo(fileName), "context"));
+        QVERIFY2(!entry.isUnchanged(QFileInfo(fileName), "other packages"), "Other context");
+
+        // other size
+        QVERIFY(writeFile(fileName, "EXPORT_NAME Bluebell2"));
+        QVERIFY(!entry.isFileUnchanged(QFileInfo(fileName)));
+        entry.setFingerprint(QFileInfo(fileName), "context");
+        QVERIFY(entry.isUnchanged(QFileInfo(fileName), "context"));
+
+        // same size, other modification time
+        QFile file(fileName);
+        QVERIFY(file.open(QFile::ReadWrite));
+        QVERIFY(file.setFileTime(QFileInfo(fileName).lastModified().addSecs(-60), QFileDevice::FileModificationTime));
+        file.close();
+        QVERIFY(!entry.isFileUnchanged(QFileInfo(fileName)));
+    }
+
+    void CTestModelFingerprintCache::saveAndLoad()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString packageFile = dir.filePath("Bluebell/xsb_aircraft.txt");
+        const QString cacheFile = dir.filePath("cache/xplanemodels.manifest");
+
+        CModelFingerprintCache::Entry entry;
+        entry.lastModified = 1000;
+        entry.size = 42;
+        entry.context = "context";
+        entry.packageName = "Bluebell";
+        entry.models.push_back(CAircraftModel("BB B738 DLH", CAircraftModel::TypeOwnSimulatorModel));
+        entry.models.push_back(CAircraftModel("BB A320 DLH", CAircraftModel::TypeOwnSimulatorModel));
+
+        CModelFingerprintCache cache;
+        cache.insert(packageFile, entry);
+        QVERIFY(cache.save(cacheFile).isSuccess());
+
+        CModelFingerprintCache loaded;
+        QVERIFY(loaded.load(cacheFile));
+        QCOMPARE(loaded.size(), 1);
+        const CModelFingerprintCache::Entry *found = loaded.find(packageFile);
+        QVERIFY(found);
+        QCOMPARE(found->lastModified, entry.lastModified);
+        QCOMPARE(found->size, entry.size);
+        QCOMPARE(found->context, entry.context);
+        QCOMPARE(found->packageName, entry.packageName);
+        QCOMPARE(found->models.size(), 2);
+        QVERIFY(found->models.containsModelString("BB A320 DLH"));
+    }
+
+    bool CTestModelFingerprintCache::writeFile(const QString &fileName, const QByteArray &content)
+    {
+        QFile file(fileName);
+        if (!file.open(QFile::WriteOnly | QFile::Truncate)) { return false; }
+        return file.write(content) == content.size();
+    }
+} // namespace
+
+//! main
+BLACKTEST_APPLESS_MAIN(BlackMiscTest::CTestModelFingerprintCache);
+
+#include "testmodelfingerprintcache.moc"
+
+//! \endcond
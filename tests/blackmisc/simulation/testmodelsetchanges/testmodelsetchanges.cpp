@@ -0,0 +1,273 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/modelsetchanges.h"
+#include "blackmisc/simulation/aircraftmodelsetindex.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/airlineicaocode.h"
+#include "blackmisc/aviation/livery.h"
+#include "test.h"
+
+#include <QTest>
+#include <algorithm>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! Model set changes, journal and incrementally updated index
+    class CTestModelSetChanges : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Diff and apply
+        void diff();
+
+        //! Combined changes
+        void append();
+
+        //! Journal of changes
+        void journal();
+
+        //! Index updated with changes is the same as a new index
+        void indexWithChanges();
+
+    private:
+        //! A model set
+        static CAircraftModelList modelSet();
+
+        //! Create a model
+        static CAircraftModel model(const QString &modelString, const QString &designator, const QString &manufacturer, const QString &airline);
+
+        //! Model strings for comparison
+        static QStringList modelStrings(const CAircraftModelList &models) { return models.getModelStringList(false); }
+
+        //! Compare lookups of both indexes
+        static void compareIndexes(const CAircraftModelSetIndex &index, const CAircraftModelSetIndex &expected);
+    };
+
+    CAircraftModel CTestModelSetChanges::model(const QString &modelString, const QString &designator, const QString &manufacturer, const QString &airline)
+    {
+        const CAircraftIcaoCode icao(designator, "L2J", manufacturer, "", "M", true, false, false, 0);
+        return CAircraftModel(modelString, CAircraftModel::TypeOwnSimulatorModel, icao, CLivery(airline + ".STD", CAirlineIcaoCode(airline), ""));
+    }
+
+    CAircraftModelList CTestModelSetChanges::modelSet()
+    {
+        static const QStringList designators({ "A320", "A321", "B738", "B744", "E190" });
+        static const QStringList manufacturers({ "AIRBUS", "AIRBUS", "BOEING", "BOEING", "EMBRAER" });
+        static const QStringList airlines({ "DLH", "BAW", "AFR", "KLM" });
+
+        CAircraftModelList models;
+        for (int i = 0; i < 48; i++)
+        {
+            const int t = i % designators.size();
+            models.push_back(model(QStringLiteral("MODEL %1").arg(i), designators.at(t), manufacturers.at(t), airlines.at(i % airlines.size())));
+        }
+
+        // alias of a later model string
+        CAircraftModel alias = model("ALIAS A320", "A320", "AIRBUS", "DLH");
+        alias.setModelStringAlias("MODEL 40");
+        models[3] = alias;
+        return models;
+    }
+
+    void CTestModelSetChanges::compareIndexes(const CAircraftModelSetIndex &index, const CAircraftModelSetIndex &expected)
+    {
+        QCOMPARE(modelStrings(index.getModels()), modelStrings(expected.getModels()));
+        QCOMPARE(index.getModels(), expected.getModels());
+
+        for (const CAircraftModel &model : expected.getModels())
+        {
+            const CAircraftIcaoCode &icao = model.getAircraftIcaoCode();
+            QCOMPARE(index.findByAircraftDesignator(icao.getDesignator()), expected.findByAircraftDesignator(icao.getDesignator()));
+            QCOMPARE(index.findByAirlineDesignator(model.getAirlineIcaoCodeDesignator()), expected.findByAirlineDesignator(model.getAirlineIcaoCodeDesignator()));
+            QCOMPARE(index.findByManufacturer(icao.getManufacturer()), expected.findByManufacturer(icao.getManufacturer()));
+            QCOMPARE(index.findFirstByModelStringOrAlias(model.getModelString()), expected.findFirstByModelStringOrAlias(model.getModelString()));
+            QCOMPARE(index.findFirstByModelStringOrAlias(model.getModelStringAlias()), expected.findFirstByModelStringOrAlias(model.getModelStringAlias()));
+        }
+
+        const CAircraftModelSetIndex::Ids all = expected.allIds();
+        QCOMPARE(index.allIds(), all);
+        QCOMPARE(index.findByCombinedType(all, "L2J"), expected.findByCombinedType(all, "L2J"));
+        QCOMPARE(index.findByMilitaryFlag(all, true), expected.findByMilitaryFlag(all, true));
+        QCOMPARE(index.findWithDbKey(all), expected.findWithDbKey(all));
+        QCOMPARE(index.findNotExcluded(all), expected.findNotExcluded(all));
+        QCOMPARE(index.toIds(expected.getModels()), expected.toIds(expected.getModels()));
+    }
+
+    void CTestModelSetChanges::diff()
+    {
+        const CAircraftModelList oldSet = modelSet();
+        QVERIFY(CModelSetChanges::diff(oldSet, oldSet).isEmpty());
+
+        CAircraftModelList newSet(oldSet);
+        newSet.removeModelWithString("MODEL 5", Qt::CaseInsensitive);
+        newSet.removeModelWithString("MODEL 30", Qt::CaseInsensitive);
+        CAircraftModel updated = newSet[10];
+        updated.setDescription("changed description");
+        newSet[10] = updated;
+        newSet.push_back(model("NEW 1", "A320", "AIRBUS", "DLH"));
+        newSet.push_back(model("NEW 2", "B738", "BOEING", "BAW"));
+
+        const CModelSetChanges changes = CModelSetChanges::diff(oldSet, newSet);
+        QVERIFY(!changes.isReplacement());
+        QCOMPARE(changes.getRemoved(), QStringList({ "MODEL 5", "MODEL 30" }));
+        QCOMPARE(modelStrings(changes.getUpdated()), QStringList({ updated.getModelString() }));
+        QCOMPARE(modelStrings(changes.getAdded()), QStringList({ "NEW 1", "NEW 2" }));
+        QCOMPARE(changes.size(), 5);
+
+        CAircraftModelList applied(oldSet);
+        changes.applyTo(applied);
+        QCOMPARE(modelStrings(applied), modelStrings(newSet));
+        QCOMPARE(applied[10].getDescription(), QString("changed description"));
+
+        // re-ordered, a replacement
+        CAircraftModelList reordered(oldSet);
+        std::swap(reordered[0], reordered[1]);
+        const CModelSetChanges replacement = CModelSetChanges::diff(oldSet, reordered);
+        QVERIFY(replacement.isReplacement());
+        applied = oldSet;
+        replacement.applyTo(applied);
+        QCOMPARE(modelStrings(applied), modelStrings(reordered));
+
+        // inserted in the middle, a replacement
+        CAircraftModelList inserted(oldSet);
+        inserted.insert(inserted.begin() + 2, model("NEW 1", "A320", "AIRBUS", "DLH"));
+        QVERIFY(CModelSetChanges::diff(oldSet, inserted).isReplacement());
+    }
+
+    void CTestModelSetChanges::append()
+    {
+        const CAircraftModelList set0 = modelSet();
+        CAircraftModelList set1(set0);
+        set1.removeModelWithString("MODEL 1", Qt::CaseInsensitive);
+        set1.push_back(model("NEW 1", "A320", "AIRBUS", "DLH"));
+
+        CAircraftModelList set2(set1);
+        set2.removeModelWithString("NEW 1", Qt::CaseInsensitive);
+        CAircraftModel updated = set2[20];
+        updated.setModelMode(CAircraftModel::Exclude);
+        set2[20] = updated;
+        set2.push_back(model("NEW 2", "B738", "BOEING", "BAW"));
+
+        CModelSetChanges combined = CModelSetChanges::diff(set0, set1);
+        combined.append(CModelSetChanges::diff(set1, set2));
+        QCOMPARE(modelStrings(combined.getAdded()), QStringList({ "NEW 2" }));
+        QCOMPARE(combined.getRemoved(), QStringList({ "MODEL 1" }));
+        QCOMPARE(combined.getUpdated().size(), 1);
+
+        CAircraftModelList applied(set0);
+        combined.applyTo(applied);
+        QCOMPARE(applied, set2);
+
+        // removed and added again, appended at the end
+        CModelSetChanges readded;
+        readded.removeModel("MODEL 2");
+        readded.addModel(set0[2]);
+        applied = set0;
+        readded.applyTo(applied);
+        QCOMPARE(applied.back().getModelString(), QString("MODEL 2"));
+        QCOMPARE(applied.size(), set0.size());
+    }
+
+    void CTestModelSetChanges::journal()
+    {
+        CModelSetJournal journal;
+        QCOMPARE(journal.getRevision(), 0);
+
+        CModelSetChanges changes;
+        QVERIFY(journal.changesSince(0, changes));
+        QVERIFY(changes.isEmpty());
+
+        CModelSetChanges c1;
+        c1.removeModel("MODEL 1");
+        CModelSetChanges c2;
+        c2.addModel(model("NEW 1", "A320", "AIRBUS", "DLH"));
+        QCOMPARE(journal.record(c1), 1);
+        QCOMPARE(journal.record(c2), 2);
+
+        QVERIFY(journal.changesSince(0, changes));
+        QCOMPARE(changes.getRevision(), 2);
+        QCOMPARE(changes.getRemoved(), QStringList({ "MODEL 1" }));
+        QCOMPARE(modelStrings(changes.getAdded()), QStringList({ "NEW 1" }));
+
+        QVERIFY(journal.changesSince(1, changes));
+        QVERIFY(changes.getRemoved().isEmpty());
+        QVERIFY(journal.changesSince(2, changes));
+        QVERIFY(changes.isEmpty());
+        QVERIFY(!journal.changesSince(3, changes));
+
+        // older revisions need a reload
+        QCOMPARE(journal.reset(), 3);
+        QVERIFY(!journal.changesSince(2, changes));
+        QVERIFY(journal.changesSince(3, changes));
+
+        for (int i = 0; i < CModelSetJournal::MaxChanges + 10; i++) { journal.record(c1); }
+        QVERIFY(!journal.changesSince(3, changes));
+        QVERIFY(journal.changesSince(journal.getRevision() - CModelSetJournal::MaxChanges, changes));
+    }
+
+    void CTestModelSetChanges::indexWithChanges()
+    {
+        const CAircraftModelList set0 = modelSet();
+        const CAircraftModelSetIndex index0(set0);
+
+        // removals, including the model with alias, an update and additions
+        CAircraftModelList set1(set0);
+        set1.removeModelWithString("ALIAS A320", Qt::CaseInsensitive);
+        set1.removeModelWithString("MODEL 7", Qt::CaseInsensitive);
+        CAircraftModel updated = set1[12];
+        updated.setAircraftIcaoCode(CAircraftIcaoCode("C130", "L4T", "LOCKHEED", "", "M", true, false, true, 0));
+        updated.setModelMode(CAircraftModel::Exclude);
+        updated.setDbKey(4711);
+        set1[12] = updated;
+        set1.push_back(model("NEW 1", "A320", "AIRBUS", "DLH"));
+        CAircraftModel alias = model("NEW ALIAS", "B744", "BOEING", "KLM");
+        alias.setModelStringAlias("model 44");
+        set1.push_back(alias);
+
+        const CModelSetChanges changes1 = CModelSetChanges::diff(set0, set1);
+        QVERIFY(!changes1.isReplacement());
+        const CAircraftModelSetIndex index1 = index0.withChanges(changes1);
+        compareIndexes(index1, CAircraftModelSetIndex(set1));
+        QCOMPARE(index1.findFirstByModelStringOrAlias("MODEL 40"), CAircraftModelSetIndex(set1).findFirstByModelStringOrAlias("MODEL 40"));
+
+        // changed alias
+        CAircraftModelList set2(set1);
+        CAircraftModel changedAlias = set2[0];
+        changedAlias.setModelStringAlias("MODEL 45");
+        set2[0] = changedAlias;
+        const CAircraftModelSetIndex index2 = index1.withChanges(CModelSetChanges::diff(set1, set2));
+        compareIndexes(index2, CAircraftModelSetIndex(set2));
+        QCOMPARE(index2.findFirstByModelStringOrAlias("MODEL 45"), 0);
+
+        // replacement and large changes rebuild the index
+        CAircraftModelList reordered(set2);
+        std::reverse(reordered.begin(), reordered.end());
+        compareIndexes(index2.withChanges(CModelSetChanges::diff(set2, reordered)), CAircraftModelSetIndex(reordered));
+
+        CAircraftModelList half(set2);
+        half.truncate(set2.size() / 2);
+        compareIndexes(index2.withChanges(CModelSetChanges::diff(set2, half)), CAircraftModelSetIndex(half));
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestModelSetChanges);
+
+#include "testmodelsetchanges.moc"
+
+//! \endcond
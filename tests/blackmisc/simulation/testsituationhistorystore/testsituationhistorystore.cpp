@@ -0,0 +1,295 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/situationhistorystore.h"
+#include "blackmisc/simulation/remoteaircraftprovider.h"
+#include "blackmisc/aviation/aircraftsituationlist.h"
+#include "blackmisc/pq/units.h"
+#include "test.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QWriteLocker>
+#include <QTest>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Geo;
+using namespace BlackMisc::PhysicalQuantities;
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! Compact situation history store
+    class CTestSituationHistoryStore : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Conversion to compact situation
+        void compactSituation();
+
+        //! Store and snapshot
+        void storeAndSnapshot();
+
+        //! Ring buffer
+        void pushRingBuffer();
+
+        //! Removed ids are not reused
+        void removeAndReuse();
+
+        //! Published histories are not modified by the store
+        void publishedHistories();
+
+        //! Store and read performance compared with the per callsign situation lists
+        void performance();
+
+    private:
+        //! Test situation
+        static CAircraftSituation testSituation(const CCallsign &callsign, int number, qint64 ts);
+
+        //! Situations latest first
+        static CAircraftSituationList testSituations(const CCallsign &callsign, qint64 ts);
+    };
+
+    void CTestSituationHistoryStore::compactSituation()
+    {
+        const CCallsign cs("DAMBZ");
+        CAircraftSituation s = testSituation(cs, 1, 1425000000000);
+        s.setTimeOffsetMs(5000);
+        const CCompactSituation c = CCompactSituation::fromSituation(s);
+
+        QCOMPARE(c.timestampMs, s.getMSecsSinceEpoch());
+        QCOMPARE(c.adjustedTimestampMs, s.getAdjustedMSecsSinceEpoch());
+        QVERIFY(qFuzzyCompare(c.latitudeRad, s.latitude().value(CAngleUnit::rad())));
+        QVERIFY(qFuzzyCompare(c.longitudeRad, s.longitude().value(CAngleUnit::rad())));
+        QVERIFY(qFuzzyCompare(c.altitudeM, s.getAltitude().value(CLengthUnit::m())));
+        QVERIFY(qFuzzyCompare(c.headingRad, s.getHeading().value(CAngleUnit::rad())));
+        QVERIFY(qFuzzyCompare(c.groundSpeedMps, s.getGroundSpeed().value(CSpeedUnit::m_s())));
+        QVERIFY2(!c.hasGroundElevation(), "No elevation expected");
+        QVERIFY2(!c.hasCG(), "No CG expected");
+        QCOMPARE(c.onGround, static_cast<qint8>(s.getOnGround()));
+    }
+
+    void CTestSituationHistoryStore::storeAndSnapshot()
+    {
+        const CCallsign cs("DAMBZ");
+        const qint64 ts = 1425000000000;
+        const CAircraftSituationList situations = testSituations(cs, ts);
+
+        CSituationHistoryStore store;
+        const int id = store.store(cs, situations);
+        QVERIFY(id >= 0);
+        QCOMPARE(store.callsignId(cs), id);
+        QCOMPARE(store.callsign(id), cs);
+        QCOMPARE(store.size(), 1);
+
+        CCompactSituationHistory history;
+        QVERIFY(store.snapshot(id, history));
+        QCOMPARE(history.count, IRemoteAircraftProvider::MaxSituationsPerCallsign);
+        QCOMPARE(history.callsignId, id);
+        for (int i = 0; i < history.count; i++)
+        {
+            QCOMPARE(history.at(i).timestampMs, situations[i].getMSecsSinceEpoch());
+        }
+
+        const qint64 revision = store.revision(id);
+        store.store(cs, situations);
+        QVERIFY2(store.revision(id) > revision, "Expect new revision");
+
+        QVERIFY(!store.snapshot(CCallsign("FOO"), history));
+        QVERIFY(!store.snapshot(-1, history));
+    }
+
+    void CTestSituationHistoryStore::pushRingBuffer()
+    {
+        const CCallsign cs("DAMBZ");
+        const qint64 ts = 1425000000000;
+        CSituationHistoryStore store;
+        const int pushes = CSituationHistoryStore::MaxSituations + 3;
+        for (int i = 0; i < pushes; i++)
+        {
+            CCompactSituation c;
+            c.timestampMs = ts + i * 1000;
+            store.push(cs, c);
+        }
+
+        CCompactSituationHistory history;
+        QVERIFY(store.snapshot(cs, history));
+        QCOMPARE(history.count, CSituationHistoryStore::MaxSituations);
+        for (int i = 0; i < history.count; i++)
+        {
+            // latest first
+            QCOMPARE(history.at(i).timestampMs, ts + (pushes - 1 - i) * 1000);
+        }
+    }
+
+    void CTestSituationHistoryStore::removeAndReuse()
+    {
+        const qint64 ts = 1425000000000;
+        const CCallsign cs1("DAMBZ");
+        const CCallsign cs2("DLH123");
+        CSituationHistoryStore store;
+        const int id1 = store.store(cs1, testSituations(cs1, ts));
+        store.store(cs2, testSituations(cs2, ts));
+        QCOMPARE(store.size(), 2);
+
+        QVERIFY(store.remove(cs1));
+        QVERIFY(!store.remove(cs1));
+        QCOMPARE(store.callsignId(cs1), -1);
+        QCOMPARE(store.revision(id1), -1);
+
+        CCompactSituationHistory history;
+        QVERIFY2(!store.snapshot(id1, history), "Removed id must not be readable");
+
+        // slot is reused, but with a new id
+        const CCallsign cs3("BAW1");
+        const int id3 = store.store(cs3, testSituations(cs3, ts));
+        QVERIFY(id3 != id1);
+        QCOMPARE(store.callsign(id3), cs3);
+        QVERIFY(store.callsign(id1).isEmpty());
+        QVERIFY2(!store.snapshot(id1, history), "Outdated id must not read the new aircraft");
+
+        store.clear();
+        QCOMPARE(store.size(), 0);
+        QVERIFY(!store.snapshot(id3, history));
+        const int id4 = store.store(cs3, testSituations(cs3, ts));
+        QVERIFY2(id4 != id3, "Ids from before clear are invalid");
+    }
+
+    void CTestSituationHistoryStore::publishedHistories()
+    {
+        const CCallsign cs("DAMBZ");
+        const qint64 ts = 1425000000000;
+        CSituationHistoryStore store;
+        const int id = store.store(cs, testSituations(cs, ts));
+        const CSituationHistories published = store.histories();
+        QCOMPARE(published.callsignId(cs), id);
+        QVERIFY(published.history(id));
+        const qint64 revision = published.history(id)->revision;
+
+        CCompactSituation c;
+        c.timestampMs = ts + 5000;
+        store.push(cs, c);
+        store.remove(CCallsign("FOO"));
+        QVERIFY(store.remove(cs));
+
+        // the published copy is unchanged
+        QCOMPARE(published.size(), 1);
+        QVERIFY(published.history(id));
+        QCOMPARE(published.history(id)->revision, revision);
+        QCOMPARE(published.history(id)->latest().timestampMs, ts);
+        QVERIFY(!store.histories().history(id));
+    }
+
+    void CTestSituationHistoryStore::performance()
+    {
+        // Pseudo performance test, stores like the network does and reads like the simulator loop does for many aircraft
+        constexpr int NumberOfAircraft = 1000;
+        constexpr int Loops = 20;
+        const qint64 ts = 1425000000000;
+
+        CSituationHistoryStore store;
+        CAircraftSituationListPerCallsign lists;
+        QReadWriteLock lock;
+        QVector<int> ids;
+        QVector<CCallsign> callsigns;
+        QVector<CAircraftSituationList> situationsPerAircraft;
+        for (int a = 0; a < NumberOfAircraft; a++)
+        {
+            const CCallsign cs("SWIFT" + QString::number(a));
+            situationsPerAircraft.push_back(testSituations(cs, ts));
+            callsigns.push_back(cs);
+        }
+
+        // store, the lists as the provider keeps them, and additionally the compact history
+        QElapsedTimer timer;
+        timer.start();
+        for (int a = 0; a < NumberOfAircraft; a++)
+        {
+            QWriteLocker wl(&lock);
+            lists.insert(callsigns[a], situationsPerAircraft[a]);
+        }
+        const qint64 nsStoreList = qMax<qint64>(1, timer.nsecsElapsed());
+        timer.start();
+        for (int a = 0; a < NumberOfAircraft; a++)
+        {
+            ids.push_back(store.store(callsigns[a], situationsPerAircraft[a]));
+        }
+        const qint64 nsStoreCompact = qMax<qint64>(1, timer.nsecsElapsed());
+
+        // per callsign lists as read by the interpolators so far
+        double sumList = 0.0;
+        timer.start();
+        for (int l = 0; l < Loops; l++)
+        {
+            for (const CCallsign &cs : callsigns)
+            {
+                QReadLocker rl(&lock);
+                const CAircraftSituationList situations = lists.value(cs);
+                rl.unlock();
+                for (const CAircraftSituation &s : situations) { sumList += s.latitude().value(CAngleUnit::rad()); }
+            }
+        }
+        const qint64 nsList = qMax<qint64>(1, timer.nsecsElapsed());
+
+        // compact history, published histories as read from the remote aircraft snapshot
+        double sumCompact = 0.0;
+        timer.start();
+        for (int l = 0; l < Loops; l++)
+        {
+            const CSituationHistories histories = store.histories();
+            for (int id : ids)
+            {
+                const CCompactSituationHistory *history = histories.history(id);
+                if (!history) { continue; }
+                for (int i = 0; i < history->count; i++) { sumCompact += history->at(i).latitudeRad; }
+            }
+        }
+        const qint64 nsCompact = qMax<qint64>(1, timer.nsecsElapsed());
+
+        QVERIFY2(qFuzzyCompare(sumList, sumCompact), "Expect same values");
+        const int reads = NumberOfAircraft * Loops;
+        qDebug() << "Store situation lists:" << (nsStoreList / NumberOfAircraft) << "ns/aircraft";
+        qDebug() << "Store compact history:" << (nsStoreCompact / NumberOfAircraft) << "ns/aircraft";
+        qDebug() << "Read situation lists:" << (nsList / reads) << "ns/aircraft";
+        qDebug() << "Read compact history:" << (nsCompact / reads) << "ns/aircraft" << "ratio" << (static_cast<double>(nsList) / nsCompact);
+    }
+
+    CAircraftSituation CTestSituationHistoryStore::testSituation(const CCallsign &callsign, int number, qint64 ts)
+    {
+        const CCoordinateGeodetic position(48.0 + number * 0.01, 11.0 + number * 0.01, 5000.0 + number * 100.0);
+        CAircraftSituation s(callsign, position, CHeading(90.0 + number, CHeading::True, CAngleUnit::deg()),
+                             CAngle(2.0, CAngleUnit::deg()), CAngle(-1.0, CAngleUnit::deg()), CSpeed(250.0, CSpeedUnit::kts()));
+        s.setMSecsSinceEpoch(ts);
+        return s;
+    }
+
+    CAircraftSituationList CTestSituationHistoryStore::testSituations(const CCallsign &callsign, qint64 ts)
+    {
+        CAircraftSituationList situations;
+        for (int i = 0; i < IRemoteAircraftProvider::MaxSituationsPerCallsign; i++)
+        {
+            // latest first
+            situations.push_back(testSituation(callsign, i, ts - i * 5000));
+        }
+        return situations;
+    }
+} // namespace
+
+//! main
+BLACKTEST_APPLESS_MAIN(BlackMiscTest::CTestSituationHistoryStore);
+
+#include "testsituationhistorystore.moc"
+
+//! \endcond
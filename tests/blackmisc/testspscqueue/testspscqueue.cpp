@@ -0,0 +1,118 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+
+/*!
+ * \file
+ * \ingroup testblackmisc
+ */
+
+#include "blackmisc/spscqueue.h"
+#include "test.h"
+
+#include <QTest>
+#include <QByteArray>
+#include <thread>
+
+using namespace BlackMisc;
+
+namespace BlackMiscTest
+{
+    //! Testing the single producer single consumer queue
+    class CTestSpscQueue : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        void testCapacity();
+        void testPushPop();
+        void testWrapAround();
+        void testProducerConsumerThreads();
+    };
+
+    void CTestSpscQueue::testCapacity()
+    {
+        QCOMPARE(CSpscQueue<int>(0).capacity(), 1);
+        QCOMPARE(CSpscQueue<int>(5).capacity(), 8);
+        QCOMPARE(CSpscQueue<int>(64).capacity(), 64);
+    }
+
+    void CTestSpscQueue::testPushPop()
+    {
+        CSpscQueue<QByteArray> queue(4);
+        QVERIFY(queue.isEmpty());
+        QVERIFY(!queue.front());
+        QVERIFY(!queue.pop());
+
+        for (int i = 0; i < 4; i++) { QVERIFY(queue.tryPush(QByteArray::number(i))); }
+        QVERIFY2(!queue.tryPush(QByteArray("full")), "Full queue rejects values");
+        QCOMPARE(queue.size(), 4);
+        QCOMPARE(*queue.front(), QByteArray("0"));
+
+        QByteArray value;
+        QVERIFY(queue.tryPop(value));
+        QCOMPARE(value, QByteArray("0"));
+        QVERIFY(queue.pop());
+        QCOMPARE(queue.size(), 2);
+
+        queue.clear();
+        QVERIFY(queue.isEmpty());
+        QVERIFY(!queue.tryPop(value));
+    }
+
+    void CTestSpscQueue::testWrapAround()
+    {
+        CSpscQueue<int> queue(4);
+        int expected = 0;
+        for (int i = 0; i < 1000; i++)
+        {
+            QVERIFY(queue.tryPush(i));
+            if (queue.size() < 3) { continue; }
+            int value = -1;
+            QVERIFY(queue.tryPop(value));
+            QCOMPARE(value, expected++);
+        }
+        QCOMPARE(queue.size(), 1000 - expected);
+    }
+
+    void CTestSpscQueue::testProducerConsumerThreads()
+    {
+        constexpr int count = 200000;
+        CSpscQueue<int> queue(16);
+        std::thread producer([&queue]
+        {
+            for (int i = 0; i < count;)
+            {
+                if (queue.tryPush(i)) { i++; }
+                else { std::this_thread::yield(); }
+            }
+        });
+
+        int expected = 0;
+        bool ordered = true;
+        while (expected < count)
+        {
+            int value = -1;
+            if (!queue.tryPop(value)) { std::this_thread::yield(); continue; }
+            if (value != expected) { ordered = false; }
+            expected++;
+        }
+        producer.join();
+
+        QVERIFY2(ordered, "Values arrive in the order pushed");
+        QVERIFY(queue.isEmpty());
+    }
+}
+
+//! main
+BLACKTEST_APPLESS_MAIN(BlackMiscTest::CTestSpscQueue);
+
+#include "testspscqueue.moc"
+
+//! \endcond
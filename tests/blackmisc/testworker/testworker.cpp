@@ -15,8 +15,12 @@
 
 #include "blackmisc/worker.h"
 #include "blackmisc/eventloop.h"
+#include "blackmisc/threadutils.h"
 #include <QObject>
 #include <QTest>
+#include <QThreadPool>
+#include <QVector>
+#include <atomic>
 
 using namespace BlackMisc;
 
@@ -34,6 +38,9 @@ namespace BlackMiscTest
     private slots:
         //! Testing single shot
         void singleShot();
+
+        //! Testing parallel for on the thread pool
+        void parallelFor();
     };
 
     CTestWorker::CTestWorker(QObject *parent) : QObject(parent)
@@ -49,6 +56,26 @@ namespace BlackMiscTest
         QVERIFY2(future.result() == 123, "Future provides access to slot's return value");
     }
 
+    void CTestWorker::parallelFor()
+    {
+        constexpr int Count = 1000;
+        QVector<int> calls(Count, 0);
+        int *data = calls.data();
+        CThreadUtils::parallelFor(Count, 4, [data](int i) { data[i]++; });
+        QVERIFY2(calls == QVector<int>(Count, 1), "Each index called once");
+
+        // pool busy with nested loops, the calling threads do the work
+        std::atomic_int sum { 0 };
+        const int outer = QThreadPool::globalInstance()->maxThreadCount() + 2;
+        CThreadUtils::parallelFor(outer, -1, [&sum](int)
+        {
+            CThreadUtils::parallelFor(10, -1, [&sum](int i) { sum += i; });
+        });
+        QCOMPARE(sum.load(), outer * 45);
+
+        CThreadUtils::parallelFor(0, 4, [](int) { QFAIL("No index"); });
+    }
+
 } // namespace
 
 //! main
@@ -0,0 +1,24 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#ifndef BLACKSOUNDTEST_H
+#define BLACKSOUNDTEST_H
+
+//! \cond PRIVATE_TESTS
+
+/*!
+ * \namespace BlackSoundTest
+ * \defgroup testblacksound BlackSound Unit Tests
+ * \ingroup tests
+ * Unit tests for BlackSound. Unit tests do have their own namespace, so
+ * the regular namespace BlackSound is completely free of unit tests.
+ */
+
+//! \endcond
+
+#endif // guard
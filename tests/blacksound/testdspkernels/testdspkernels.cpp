@@ -0,0 +1,327 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblacksound
+
+#include "blacksound/dsp/biquadcascade.h"
+#include "blacksound/dsp/biquadfilter.h"
+#include "blacksound/dsp/dspkernels.h"
+#include "blacksound/sampleprovider/equalizersampleprovider.h"
+#include "blacksound/sampleprovider/sinusgenerator.h"
+#include "test.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QTest>
+#include <QVector>
+#include <algorithm>
+#include <cstring>
+
+using namespace BlackSound::Dsp;
+using namespace BlackSound::SampleProvider;
+
+namespace BlackSoundTest
+{
+    //! DSP kernels, SIMD vs. scalar reference
+    class CTestDspKernels : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Reset to detected instruction set
+        void cleanup();
+
+        //! All instruction sets yield exactly the samples of the scalar biquad kernel
+        void biQuadInstructionSets();
+
+        //! All instruction sets yield exactly the samples of the scalar gain, mix and clip kernels
+        void blockKernels();
+
+        //! Cascade in lanes yields the same as a single cascade
+        void lanesAndSingle();
+
+        //! Single precision cascade close to the double precision BiQuadFilter
+        void biQuadFilter();
+
+        //! Prefetched equalizers yield the same as reading them one by one
+        void equalizerPrefetch();
+
+        //! Pseudo performance test, scalar vs. SIMD
+        void biQuadPerformance();
+
+    private:
+        static constexpr int Lanes = 11;       //!< not a multiple of the register sizes, so the remaining lanes are tested
+        static constexpr int BlockSize = 960;  //!< 20ms at 48kHz
+        static constexpr int Blocks = 5;
+
+        //! Supported instruction sets
+        static QVector<CDspKernels::InstructionSet> supportedInstructionSets();
+
+        //! Filters of the VHF equalizer preset
+        static QVector<BiQuadFilter> vhfFilters();
+
+        //! Cascade of the VHF equalizer preset
+        static CBiQuadCascade vhfCascade();
+
+        //! Noise like a voice signal
+        static QVector<float> noise(int count, quint32 seed);
+
+        //! Bitwise identical?
+        static bool isIdentical(const QVector<float> &v1, const QVector<float> &v2);
+
+        //! Filter the blocks of all lanes with the VHF cascade
+        static QVector<QVector<float>> filterLanes(const QVector<QVector<float>> &input, int maxLanes);
+    };
+
+    void CTestDspKernels::cleanup()
+    {
+        CDspKernels::setInstructionSet(CDspKernels::detectedInstructionSet());
+    }
+
+    void CTestDspKernels::biQuadInstructionSets()
+    {
+        QVERIFY(CDspKernels::isSupported(CDspKernels::Scalar));
+        qDebug() << "Detected" << CDspKernels::instructionSetToString(CDspKernels::detectedInstructionSet());
+
+        QVector<QVector<float>> input;
+        for (int l = 0; l < Lanes; l++) { input.push_back(noise(Blocks * BlockSize, static_cast<quint32>(l + 1))); }
+
+        QVERIFY(CDspKernels::setInstructionSet(CDspKernels::Scalar));
+        const QVector<QVector<float>> reference = filterLanes(input, Lanes);
+
+        for (CDspKernels::InstructionSet set : supportedInstructionSets())
+        {
+            QVERIFY(CDspKernels::setInstructionSet(set));
+            QCOMPARE(CDspKernels::instructionSet(), set);
+            for (int maxLanes : { 1, 3, 4, 8, Lanes })
+            {
+                const QVector<QVector<float>> filtered = filterLanes(input, maxLanes);
+                for (int l = 0; l < Lanes; l++)
+                {
+                    QVERIFY2(isIdentical(filtered.at(l), reference.at(l)), qPrintable(CDspKernels::instructionSetToString(set) + " lanes " + QString::number(maxLanes)));
+                }
+            }
+        }
+    }
+
+    void CTestDspKernels::blockKernels()
+    {
+        constexpr int n = 37;
+        const QVector<float> in1 = noise(n, 11);
+        const QVector<float> in2 = noise(n, 12);
+
+        QVERIFY(CDspKernels::setInstructionSet(CDspKernels::Scalar));
+        QVector<float> gainRef(in1);
+        QVector<float> mixRef(in1);
+        QVector<float> clipRef(in1);
+        CDspKernels::gain(gainRef.data(), n, 3.5f);
+        CDspKernels::mix(mixRef.data(), in2.constData(), n);
+        CDspKernels::clip(clipRef.data(), n, 0.25f);
+        QVERIFY(std::all_of(clipRef.begin(), clipRef.end(), [](float s) { return s >= -0.25f && s <= 0.25f; }));
+
+        for (CDspKernels::InstructionSet set : supportedInstructionSets())
+        {
+            QVERIFY(CDspKernels::setInstructionSet(set));
+            QVector<float> gain(in1);
+            QVector<float> mix(in1);
+            QVector<float> clip(in1);
+            CDspKernels::gain(gain.data(), n, 3.5f);
+            CDspKernels::mix(mix.data(), in2.constData(), n);
+            CDspKernels::clip(clip.data(), n, 0.25f);
+            QVERIFY2(isIdentical(gain, gainRef), qPrintable("Gain " + CDspKernels::instructionSetToString(set)));
+            QVERIFY2(isIdentical(mix, mixRef), qPrintable("Mix " + CDspKernels::instructionSetToString(set)));
+            QVERIFY2(isIdentical(clip, clipRef), qPrintable("Clip " + CDspKernels::instructionSetToString(set)));
+        }
+    }
+
+    void CTestDspKernels::lanesAndSingle()
+    {
+        QVector<QVector<float>> input;
+        for (int l = 0; l < Lanes; l++) { input.push_back(noise(Blocks * BlockSize, static_cast<quint32>(l + 100))); }
+        const QVector<QVector<float>> filtered = filterLanes(input, Lanes);
+
+        for (int l = 0; l < Lanes; l++)
+        {
+            CBiQuadCascade cascade = vhfCascade();
+            QVector<float> single(input.at(l));
+            for (int b = 0; b < Blocks; b++) { cascade.process(single.data() + b * BlockSize, BlockSize); }
+            QVERIFY2(isIdentical(single, filtered.at(l)), qPrintable("Lane " + QString::number(l)));
+        }
+    }
+
+    void CTestDspKernels::biQuadFilter()
+    {
+        const QVector<float> input = noise(Blocks * BlockSize, 42);
+        QVector<float> filtered(input);
+        CBiQuadCascade cascade = vhfCascade();
+        cascade.process(filtered.data(), filtered.size());
+
+        QVector<BiQuadFilter> filters = vhfFilters();
+        float maxSample = 0.0f;
+        float maxDiff = 0.0f;
+        for (int n = 0; n < input.size(); n++)
+        {
+            float sample = input.at(n);
+            for (BiQuadFilter &filter : filters) { sample = filter.transform(sample); }
+            maxSample = qMax(maxSample, qAbs(sample));
+            maxDiff = qMax(maxDiff, qAbs(sample - filtered.at(n)));
+        }
+
+        // the EQ has a gain of about 25dB, the difference is relative to the peak
+        QVERIFY(maxSample > 1.0f);
+        QVERIFY2(maxDiff <= 1e-4f * maxSample, qPrintable(QStringLiteral("max. difference %1 peak %2").arg(maxDiff).arg(maxSample)));
+    }
+
+    void CTestDspKernels::equalizerPrefetch()
+    {
+        constexpr int Equalizers = 5;
+        QObject parent;
+        QVector<CEqualizerSampleProvider *> single;
+        QVector<CEqualizerSampleProvider *> prefetched;
+        for (int e = 0; e < Equalizers; e++)
+        {
+            for (QVector<CEqualizerSampleProvider *> *equalizers : { &single, &prefetched })
+            {
+                CSinusGenerator *sinus = new CSinusGenerator(200.0 + e * 150.0, &parent);
+                sinus->setGain(0.2);
+                CEqualizerSampleProvider *equalizer = new CEqualizerSampleProvider(sinus, VHFEmulation, &parent);
+                equalizer->setBypassEffects(e == 2); // bypassed equalizers are read, but not filtered
+                equalizers->push_back(equalizer);
+            }
+        }
+
+        CBiQuadCascadeLanes lanes(4, ISampleProvider::MaxBlockSize);
+        QVector<float> expected(BlockSize);
+        QVector<float> samples(BlockSize);
+        for (int b = 0; b < Blocks; b++)
+        {
+            CEqualizerSampleProvider::prefetch(prefetched, BlockSize, lanes);
+            for (int e = 0; e < Equalizers; e++)
+            {
+                QCOMPARE(single[e]->readSamples(expected.data(), BlockSize), prefetched[e]->readSamples(samples.data(), BlockSize));
+                QVERIFY2(isIdentical(samples, expected), qPrintable(QStringLiteral("Equalizer %1 block %2").arg(e).arg(b)));
+            }
+        }
+    }
+
+    void CTestDspKernels::biQuadPerformance()
+    {
+        constexpr int Loops = 500;
+        for (CDspKernels::InstructionSet set : supportedInstructionSets())
+        {
+            QVERIFY(CDspKernels::setInstructionSet(set));
+            for (int lanes : { 1, 4, 8, 16 })
+            {
+                QVector<CBiQuadCascade> cascades(lanes, vhfCascade());
+                QVector<QVector<float>> samples;
+                QVector<CBiQuadCascade *> cascadePointers;
+                QVector<float *> blockPointers;
+                for (int l = 0; l < lanes; l++) { samples.push_back(noise(BlockSize, static_cast<quint32>(l + 1))); }
+                for (int l = 0; l < lanes; l++)
+                {
+                    cascadePointers.push_back(&cascades[l]);
+                    blockPointers.push_back(samples[l].data());
+                }
+
+                CBiQuadCascadeLanes cascadeLanes(lanes, BlockSize);
+                QElapsedTimer timer;
+                timer.start();
+                for (int l = 0; l < Loops; l++)
+                {
+                    cascadeLanes.process(cascadePointers.data(), blockPointers.data(), lanes, BlockSize);
+                }
+                const qint64 ns = timer.nsecsElapsed();
+                qDebug() << CDspKernels::instructionSetToString(set) << (ns / Loops / 1000.0) << "us per block of" << lanes << "streams";
+            }
+        }
+
+        QVector<BiQuadFilter> filters = vhfFilters();
+        QVector<float> samples = noise(BlockSize, 1);
+        QElapsedTimer timer;
+        timer.start();
+        for (int l = 0; l < Loops; l++)
+        {
+            for (BiQuadFilter &filter : filters)
+            {
+                for (float &sample : samples) { sample = filter.transform(sample); }
+            }
+        }
+        const qint64 ns = timer.nsecsElapsed();
+        qDebug() << "BiQuadFilter" << (ns / Loops / 1000.0) << "us per block of 1 stream";
+    }
+
+    QVector<CDspKernels::InstructionSet> CTestDspKernels::supportedInstructionSets()
+    {
+        QVector<CDspKernels::InstructionSet> sets;
+        for (CDspKernels::InstructionSet set : { CDspKernels::Scalar, CDspKernels::SSE2, CDspKernels::AVX })
+        {
+            if (CDspKernels::isSupported(set)) { sets.push_back(set); }
+        }
+        return sets;
+    }
+
+    QVector<BiQuadFilter> CTestDspKernels::vhfFilters()
+    {
+        return
+        {
+            BiQuadFilter::highPassFilter(44100, 310, 0.25),
+            BiQuadFilter::peakingEQ(44100, 450, 0.75, 17.0),
+            BiQuadFilter::peakingEQ(44100, 1450, 1.0, 25.0),
+            BiQuadFilter::peakingEQ(44100, 2000, 1.0, 25.0),
+            BiQuadFilter::lowPassFilter(44100, 2500, 0.25)
+        };
+    }
+
+    CBiQuadCascade CTestDspKernels::vhfCascade()
+    {
+        CBiQuadCascade cascade;
+        for (const BiQuadFilter &filter : vhfFilters()) { cascade.addStage(filter); }
+        return cascade;
+    }
+
+    QVector<float> CTestDspKernels::noise(int count, quint32 seed)
+    {
+        QRandomGenerator random(seed);
+        QVector<float> samples(count);
+        for (float &sample : samples) { sample = static_cast<float>(0.6 * random.generateDouble() - 0.3); }
+        return samples;
+    }
+
+    bool CTestDspKernels::isIdentical(const QVector<float> &v1, const QVector<float> &v2)
+    {
+        return v1.size() == v2.size() && std::memcmp(v1.constData(), v2.constData(), static_cast<size_t>(v1.size()) * sizeof(float)) == 0;
+    }
+
+    QVector<QVector<float>> CTestDspKernels::filterLanes(const QVector<QVector<float>> &input, int maxLanes)
+    {
+        QVector<QVector<float>> output(input);
+        QVector<CBiQuadCascade> cascades(output.size(), vhfCascade());
+        QVector<CBiQuadCascade *> cascadePointers;
+        for (CBiQuadCascade &cascade : cascades) { cascadePointers.push_back(&cascade); }
+
+        CBiQuadCascadeLanes lanes(maxLanes, BlockSize);
+        const int blocks = output.isEmpty() ? 0 : output.front().size() / BlockSize;
+        for (int b = 0; b < blocks; b++)
+        {
+            QVector<float *> blockPointers;
+            for (QVector<float> &samples : output) { blockPointers.push_back(samples.data() + b * BlockSize); }
+            lanes.process(cascadePointers.data(), blockPointers.data(), cascadePointers.size(), BlockSize);
+        }
+        return output;
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackSoundTest::CTestDspKernels);
+
+#include "testdspkernels.moc"
+
+//! \endcond
@@ -0,0 +1,99 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblacksound
+
+#include "blacksound/codecs/opusdecoderpool.h"
+#include "test.h"
+
+#include <QTest>
+#include <QVector>
+#include <algorithm>
+#include <atomic>
+
+using namespace BlackSound::Codecs;
+
+namespace BlackSoundTest
+{
+    //! Decoder pool shared by the callsigns
+    class CTestOpusDecoderPool : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Released decoders are acquired again, no new ones are created
+        void reuseDecoders();
+
+        //! Each job runs exactly once, sequentially and on the thread pool
+        void runJobs();
+
+        //! Jobs running jobs, e.g. with all pool threads busy
+        void nestedJobs();
+    };
+
+    void CTestOpusDecoderPool::reuseDecoders()
+    {
+        COpusDecoderPool pool(48000, 1, 0);
+        COpusDecoder *first = pool.acquire();
+        COpusDecoder *second = pool.acquire();
+        QVERIFY(first && second);
+        QVERIFY(first != second);
+        QCOMPARE(pool.getDecoderCount(), 2);
+        QCOMPARE(pool.getIdleDecoderCount(), 0);
+
+        pool.release(first);
+        pool.release(nullptr);
+        QCOMPARE(pool.getIdleDecoderCount(), 1);
+        QCOMPARE(pool.acquire(), first);
+        QCOMPARE(pool.getDecoderCount(), 2);
+    }
+
+    void CTestOpusDecoderPool::runJobs()
+    {
+        for (int workers : { 0, 2 })
+        {
+            COpusDecoderPool pool(48000, 1, workers);
+            QCOMPARE(pool.getWorkerThreadCount(), workers);
+            for (int count : { 0, 1, 3, 16 })
+            {
+                for (int repeat = 0; repeat < 100; repeat++)
+                {
+                    QVector<int> calls(count, 0);
+                    std::atomic_int total { 0 };
+                    pool.run(count, [&](int i)
+                    {
+                        calls[i]++;
+                        total++;
+                    });
+                    QCOMPARE(total.load(), count);
+                    QVERIFY(std::all_of(calls.cbegin(), calls.cend(), [](int c) { return c == 1; }));
+                }
+            }
+        }
+    }
+
+    void CTestOpusDecoderPool::nestedJobs()
+    {
+        COpusDecoderPool pool(48000, 1, 2);
+        std::atomic_int total { 0 };
+        pool.run(16, [&](int)
+        {
+            pool.run(16, [&](int) { total++; });
+        });
+        QCOMPARE(total.load(), 16 * 16);
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackSoundTest::CTestOpusDecoderPool);
+
+#include "testopusdecoderpool.moc"
+
+//! \endcond
@@ -0,0 +1,106 @@
+/* Copyright (C) 2019
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblacksound
+
+#include "blacksound/dsp/timestretch.h"
+#include "test.h"
+
+#include <QTest>
+#include <QVector>
+#include <QtMath>
+#include <algorithm>
+
+using namespace BlackSound::Dsp;
+
+namespace BlackSoundTest
+{
+    //! Time stretching of the jitter buffer
+    class CTestTimeStretch : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Shrinking removes samples within the limits, without a discontinuity
+        void shrink();
+
+        //! Growing adds samples within the limits, without a discontinuity
+        void grow();
+
+        //! Blocks too short are copied
+        void shortBlock();
+
+    private:
+        static constexpr int SampleRate = 48000;
+        static constexpr int FrameSamples = 960;
+        static constexpr int MinSamples = 120;
+        static constexpr int MaxSamples = 240;
+        static constexpr int Overlap = 120;
+
+        //! 180Hz, a period is 266.7 samples
+        static QVector<float> sine();
+
+        //! Max. difference of subsequent samples
+        static float maxStep(const float *samples, int count);
+    };
+
+    void CTestTimeStretch::shrink()
+    {
+        const QVector<float> input = sine();
+        QVector<float> output(FrameSamples, 0.0f);
+        const int count = CTimeStretch::shrink(input.constData(), input.size(), output.data(), MinSamples, MaxSamples, Overlap);
+        QVERIFY(count >= FrameSamples - MaxSamples);
+        QVERIFY(count <= FrameSamples - MinSamples);
+        QVERIFY2(maxStep(output.constData(), count) < 1.5f * maxStep(input.constData(), input.size()), "No click at the splice");
+    }
+
+    void CTestTimeStretch::grow()
+    {
+        const QVector<float> input = sine();
+        QVector<float> output(FrameSamples + MaxSamples, 0.0f);
+        const int count = CTimeStretch::grow(input.constData(), input.size(), output.data(), MinSamples, MaxSamples, Overlap);
+        QVERIFY(count >= FrameSamples + MinSamples);
+        QVERIFY(count <= FrameSamples + MaxSamples);
+        QVERIFY2(maxStep(output.constData(), count) < 1.5f * maxStep(input.constData(), input.size()), "No click at the splice");
+    }
+
+    void CTestTimeStretch::shortBlock()
+    {
+        const QVector<float> input = sine();
+        QVector<float> output(FrameSamples + MaxSamples, 0.0f);
+        const int count = CTimeStretch::shrink(input.constData(), 200, output.data(), MinSamples, MaxSamples, Overlap);
+        QCOMPARE(count, 200);
+        QVERIFY(std::equal(input.constBegin(), input.constBegin() + count, output.constBegin()));
+    }
+
+    QVector<float> CTestTimeStretch::sine()
+    {
+        QVector<float> samples(FrameSamples, 0.0f);
+        for (int i = 0; i < FrameSamples; i++)
+        {
+            samples[i] = 0.5f * static_cast<float>(qSin(2.0 * M_PI * 180.0 * i / SampleRate));
+        }
+        return samples;
+    }
+
+    float CTestTimeStretch::maxStep(const float *samples, int count)
+    {
+        float step = 0.0f;
+        for (int i = 1; i < count; i++) { step = qMax(step, qAbs(samples[i] - samples[i - 1])); }
+        return step;
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackSoundTest::CTestTimeStretch);
+
+#include "testtimestretch.moc"
+
+//! \endcond
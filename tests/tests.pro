@@ -4,6 +4,7 @@ TEMPLATE = subdirs
 CONFIG += ordered
 
 SUBDIRS += blackmisc
+SUBDIRS += blacksound
 SUBDIRS += blackcore
 SUBDIRS += blackgui
 